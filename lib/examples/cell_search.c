@@ -46,8 +46,9 @@
 
 #define MAX_EARFCN 1000
 
-int band         = -1;
-int earfcn_start = -1, earfcn_end = -1;
+int  band         = -1;
+int  earfcn_start = -1, earfcn_end = -1;
+bool parallel     = false;
 
 cell_search_cfg_t cell_detect_config = {.max_frames_pbch      = SRSRAN_DEFAULT_MAX_FRAMES_PBCH,
                                         .max_frames_pss       = SRSRAN_DEFAULT_MAX_FRAMES_PSS,
@@ -69,20 +70,21 @@ char* rf_dev  = "";
 
 void usage(char* prog)
 {
-  printf("Usage: %s [agsendtvb] -b band\n", prog);
+  printf("Usage: %s [agsendtvbP] -b band\n", prog);
   printf("\t-a RF args [Default %s]\n", rf_args);
   printf("\t-d RF devicename [Default %s]\n", rf_dev);
   printf("\t-g RF gain [Default %.2f dB]\n", rf_gain);
   printf("\t-s earfcn_start [Default All]\n");
   printf("\t-e earfcn_end [Default All]\n");
   printf("\t-n nof_frames_total [Default 100]\n");
+  printf("\t-P search the 3 N_id_2 in parallel on the same samples [Default %s]\n", parallel ? "enabled" : "disabled");
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "agsendvb")) != -1) {
+  while ((opt = getopt(argc, argv, "agsendvbP")) != -1) {
     switch (opt) {
       case 'a':
         rf_args = argv[optind];
@@ -105,6 +107,9 @@ void parse_args(int argc, char** argv)
       case 'g':
         rf_gain = strtof(argv[optind], NULL);
         break;
+      case 'P':
+        parallel = true;
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -150,6 +155,8 @@ int main(int argc, char** argv)
   srsran_earfcn_t               channels[MAX_EARFCN];
   uint32_t                      freq;
   uint32_t                      n_found_cells = 0;
+  struct timeval                t[3];
+  double                        scan_time_ms = 0;
 
   srsran_debug_handle_crash(argc, argv);
 
@@ -195,6 +202,10 @@ int main(int argc, char** argv)
   if (cell_detect_config.max_frames_pss) {
     srsran_ue_cellsearch_set_nof_valid_frames(&cs, cell_detect_config.nof_valid_pss_frames);
   }
+  if (parallel && srsran_ue_cellsearch_enable_parallel(&cs)) {
+    ERROR("Error enabling parallel cell search");
+    exit(-1);
+  }
   if (cell_detect_config.init_agc) {
     srsran_rf_info_t* rf_info = srsran_rf_get_info(&rf);
     srsran_ue_sync_start_agc(&cs.ue_sync,
@@ -224,7 +235,13 @@ int main(int argc, char** argv)
     INFO("Starting receiver...");
     srsran_rf_start_rx_stream(&rf, false);
 
+    gettimeofday(&t[1], NULL);
     n = srsran_ue_cellsearch_scan(&cs, found_cells, NULL);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    double earfcn_scan_time_ms = t[0].tv_sec * 1e3 + t[0].tv_usec * 1e-3;
+    scan_time_ms += earfcn_scan_time_ms;
+    INFO("PSS scan of EARFCN %d took %.1f ms", channels[freq].id, earfcn_scan_time_ms);
     if (n < 0) {
       ERROR("Error searching cell");
       exit(-1);
@@ -254,7 +271,13 @@ int main(int argc, char** argv)
     }
   }
 
-  printf("\n\nFound %d cells\n", n_found_cells);
+  printf("\n\nScanned %d EARFCNs of band %d in %.1f s (%.1f ms per EARFCN, %s PSS search)\n",
+         freq,
+         band,
+         scan_time_ms / 1000,
+         freq ? scan_time_ms / freq : 0,
+         parallel ? "parallel" : "serial");
+  printf("Found %d cells\n", n_found_cells);
   for (int i = 0; i < n_found_cells; i++) {
     printf("Found CELL %.1f MHz, EARFCN=%d, PHYID=%d, %d PRB, %d ports, PSS power=%.1f dBm\n",
            results[i].freq,
@@ -162,7 +162,7 @@ static inline void get_uint_vec_from_hex_str(const std::string& key_str, uint8_t
   return;
 }
 
-static inline std::string hex_string(uint8_t* hex, int size)
+static inline std::string hex_string(const uint8_t* hex, int size)
 {
   std::stringstream ss;
 
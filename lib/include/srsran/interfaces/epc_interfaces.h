@@ -83,14 +83,33 @@ public:
                                                struct sctp_sndrcvinfo enb_sri)               = 0;
 };
 
+// Authentication vector generated asynchronously by the HSS for a NAS procedure
+struct hss_auth_info_answer_t {
+  uint64_t imsi;
+  uint32_t mme_ue_s1ap_id;
+  bool     found;
+  uint8_t  k_asme[32];
+  uint8_t  autn[16];
+  uint8_t  rand[16];
+  uint8_t  xres[16];
+};
+
 class hss_interface_nas // NAS -> HSS
 {
 public:
   virtual bool gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres) = 0;
+  virtual bool request_auth_info(uint64_t imsi, uint32_t mme_ue_s1ap_id)                                         = 0;
   virtual bool gen_update_loc_answer(uint64_t imsi, uint8_t* qci)                                                = 0;
   virtual bool resync_sqn(uint64_t imsi, uint8_t* auts)                                                          = 0;
 };
 
+class hss_interface_mme // MME -> HSS
+{
+public:
+  virtual int  get_auth_info_fd()                                                  = 0;
+  virtual void get_auth_info_answers(std::vector<hss_auth_info_answer_t>& answers) = 0;
+};
+
 class mme_interface_nas // NAS -> MME
 {
 public:
@@ -102,7 +121,8 @@ public:
 class s1ap_interface_mme // MME -> S1AP
 {
 public:
-  virtual bool expire_nas_timer(enum nas_timer_type type, uint64_t imsi) = 0;
+  virtual bool expire_nas_timer(enum nas_timer_type type, uint64_t imsi)   = 0;
+  virtual bool handle_auth_info_answer(const hss_auth_info_answer_t& answer) = 0;
 };
 
 /*******************
@@ -113,6 +133,7 @@ class gtpu_interface_gtpc // GTP-C -> GTP-U
 public:
   virtual in_addr_t get_s1u_addr() = 0;
 
+  virtual bool create_gtpu_tunnel(in_addr_t ue_ipv4, uint32_t up_user_teid)                                       = 0;
   virtual bool modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw_user_fteid, uint32_t up_ctrl_teid) = 0;
   virtual bool delete_gtpu_tunnel(in_addr_t ue_ipv4)                                                              = 0;
   virtual bool delete_gtpc_tunnel(in_addr_t ue_ipv4)                                                              = 0;
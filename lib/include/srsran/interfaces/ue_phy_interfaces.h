@@ -104,8 +104,10 @@ struct phy_args_t {
   uint32_t    intra_freq_meas_period_ms    = 200;
   float       force_ul_amplitude           = 0.0f;
   bool        detect_cp                    = false;
+  bool        cell_search_parallel         = false;
 
-  bool nr_store_pdsch_ko = false;
+  bool     nr_store_pdsch_ko  = false;
+  uint32_t nr_polar_list_size = 0;
 
   float    in_sync_rsrp_dbm_th    = -130.0f;
   float    in_sync_snr_db_th      = 1.0f;
@@ -96,6 +96,8 @@ SRSRAN_API uint32_t srsran_refsignal_dmrs_N_rs(srsran_pucch_format_t format, srs
 
 SRSRAN_API uint32_t srsran_refsignal_dmrs_pucch_symbol(uint32_t m, srsran_pucch_format_t format, srsran_cp_t cp);
 
+SRSRAN_API float srsran_refsignal_dmrs_pucch_format1_w_arg(uint32_t m, uint32_t n_oc, srsran_cp_t cp);
+
 SRSRAN_API int srsran_refsignal_dmrs_pusch_pregen_init(srsran_refsignal_ul_dmrs_pregen_t* pregen, uint32_t max_prb);
 
 SRSRAN_API int srsran_refsignal_dmrs_pusch_pregen(srsran_refsignal_ul_t*             q,
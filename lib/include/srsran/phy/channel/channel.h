@@ -29,8 +29,12 @@
 #include "rlf.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/srslog/srslog.h"
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 namespace srsran {
 
@@ -47,8 +51,10 @@ public:
     float awgn_snr_dB            = 30.0f;
 
     // Fading options
-    bool        fading_enable = false;
-    std::string fading_model  = "none";
+    bool        fading_enable      = false;
+    std::string fading_model       = "none";
+    bool        fading_per_symbol  = false; // Hold the fading response for an OFDM symbol, not a segment
+    bool        fading_multithread = false; // Filter every antenna path in its own thread
 
     // High Speed Train options
     bool  hst_enable      = false;
@@ -76,18 +82,34 @@ public:
   void run(cf_t* in[SRSRAN_MAX_CHANNELS], cf_t* out[SRSRAN_MAX_CHANNELS], uint32_t len, const srsran_timestamp_t& t);
 
 private:
+  int  fading_init(uint32_t ch, uint32_t srate);
+  void fading_run(uint32_t ch, uint32_t len, double t);
+  void fading_worker(uint32_t ch);
+
   srslog::basic_logger&    logger;
-  float                    hst_init_phase              = 0.0f;
-  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS] = {};
-  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]  = {};
-  srsran_channel_awgn_t*   awgn                        = nullptr;
-  srsran_channel_hst_t*    hst                         = nullptr;
-  srsran_channel_rlf_t*    rlf                         = nullptr;
-  cf_t*                    buffer_in                   = nullptr;
-  cf_t*                    buffer_out                  = nullptr;
-  uint32_t                 nof_channels                = 0;
-  uint32_t                 current_srate               = 0;
-  args_t                   args                        = {};
+  float                    hst_init_phase                  = 0.0f;
+  srsran_channel_fading_t* fading[SRSRAN_MAX_CHANNELS]     = {};
+  srsran_channel_delay_t*  delay[SRSRAN_MAX_CHANNELS]      = {};
+  srsran_channel_awgn_t*   awgn                            = nullptr;
+  srsran_channel_hst_t*    hst                             = nullptr;
+  srsran_channel_rlf_t*    rlf                             = nullptr;
+  cf_t*                    buffer_in[SRSRAN_MAX_CHANNELS]  = {};
+  cf_t*                    buffer_out[SRSRAN_MAX_CHANNELS] = {};
+  uint32_t                 nof_channels                    = 0;
+  uint32_t                 current_srate                   = 0;
+  args_t                   args                            = {};
+
+  // Fading threads, the first antenna path is filtered by the caller and every other path by its own thread
+  std::vector<std::thread> fading_threads;
+  std::mutex               fading_mutex;
+  std::condition_variable  fading_cvar;
+  std::condition_variable  fading_done_cvar;
+  uint64_t                 fading_job                         = 0;
+  uint32_t                 fading_pending                     = 0;
+  bool                     fading_quit                        = false;
+  uint32_t                 fading_len                         = 0;
+  double                   fading_time                        = 0.0;
+  bool                     fading_active[SRSRAN_MAX_CHANNELS] = {};
 };
 
 typedef std::unique_ptr<channel> channel_ptr;
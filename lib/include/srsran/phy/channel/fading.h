@@ -31,6 +31,9 @@
 #define SRSRAN_CHANNEL_FADING_MAXTAPS 9
 #define SRSRAN_CHANNEL_FADING_NTERMS 16
 
+// Duration of an OFDM symbol with normal cyclic prefix, period for updating the channel response once per symbol
+#define SRSRAN_CHANNEL_FADING_SYMBOL_PERIOD_S (1e-3 / 14.0)
+
 typedef enum {
   srsran_channel_fading_model_none = 0,
   srsran_channel_fading_model_epa,
@@ -50,9 +53,10 @@ typedef struct {
   uint32_t state_len;  // Length of the impulse response saved in the state
 
   float coeff_alpha[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS]; // Angle of arrival
+  float coeff_w[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Doppler angular rate (rad/s)
   float coeff_a[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
   float coeff_b[SRSRAN_CHANNEL_FADING_MAXTAPS][SRSRAN_CHANNEL_FADING_NTERMS];     // Random phase
-  cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap signal in frequency domain
+  cf_t* h_tap[SRSRAN_CHANNEL_FADING_MAXTAPS]; // Static tap signal in frequency domain, FFT shifted
 
   // Utils
   srsran_dft_plan_t fft;             // DFT to frequency domain
@@ -62,6 +66,11 @@ typedef struct {
   cf_t*             y_freq;          // Intermediate frequency domain buffer
   float             sin_table[1024]; // Table of sinus values
 
+  // Channel response update
+  float  update_period; // Minimum time between channel response updates in seconds, 0 updates every segment
+  double update_time;   // Time of the current channel response
+  bool   h_valid;       // Set if the channel response has been generated
+
   // State variables
   cf_t* state; // To save impulse response of the filter
 } srsran_channel_fading_t;
@@ -74,6 +83,16 @@ SRSRAN_API int srsran_channel_fading_init(srsran_channel_fading_t* q, double sra
 
 SRSRAN_API void srsran_channel_fading_free(srsran_channel_fading_t* q);
 
+/**
+ * Sets the minimum time between channel response updates. By default the response is updated for every filtered
+ * segment; holding it for an OFDM symbol (SRSRAN_CHANNEL_FADING_SYMBOL_PERIOD_S) reduces the cost of the tap
+ * generation at the expense of the Doppler time resolution.
+ *
+ * @param q Fading channel object
+ * @param period_s Update period in seconds, 0 to update for every segment
+ */
+SRSRAN_API void srsran_channel_fading_set_update_period(srsran_channel_fading_t* q, float period_s);
+
 SRSRAN_API double srsran_channel_fading_execute(srsran_channel_fading_t* q,
                                                 const cf_t*              in,
                                                 cf_t*                    out,
@@ -34,6 +34,9 @@
 #include "srsran/config.h"
 #include <stdbool.h>
 
+/* Maximum number of codewords decoded at once by the batch decoding functions */
+#define SRSRAN_VITERBI_MAX_BATCH 4
+
 typedef enum { SRSRAN_VITERBI_27 = 0, SRSRAN_VITERBI_29, SRSRAN_VITERBI_37, SRSRAN_VITERBI_39 } srsran_viterbi_type_t;
 
 typedef struct SRSRAN_API {
@@ -47,6 +50,7 @@ typedef struct SRSRAN_API {
   int (*decode)(void*, uint8_t*, uint8_t*, uint32_t);
   int (*decode_s)(void*, uint16_t*, uint8_t*, uint32_t);
   int (*decode_f)(void*, float*, uint8_t*, uint32_t);
+  int (*decode_s_batch)(void*, uint16_t**, uint8_t**, uint32_t, uint32_t);
   void (*free)(void*);
   uint8_t*  tmp;
   uint16_t* tmp_s;
@@ -74,6 +78,28 @@ SRSRAN_API int srsran_viterbi_decode_us(srsran_viterbi_t* q, uint16_t* symbols,
 
 SRSRAN_API int srsran_viterbi_decode_uc(srsran_viterbi_t* q, uint8_t* symbols, uint8_t* data, uint32_t frame_length);
 
+/**
+ * @brief Decodes several codewords of the same length at once. Implementations without batch support decode them one
+ * after the other.
+ * @param q Viterbi decoder object
+ * @param symbols Real-valued symbols of every codeword
+ * @param data Decoded bits of every codeword
+ * @param nof_cw Number of codewords, up to SRSRAN_VITERBI_MAX_BATCH
+ * @param frame_length Number of bits of every codeword
+ * @return SRSRAN_SUCCESS if the codewords are decoded, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_viterbi_decode_f_batch(srsran_viterbi_t* q,
+                                             float*            symbols[SRSRAN_VITERBI_MAX_BATCH],
+                                             uint8_t*          data[SRSRAN_VITERBI_MAX_BATCH],
+                                             uint32_t          nof_cw,
+                                             uint32_t          frame_length);
+
+SRSRAN_API int srsran_viterbi_decode_us_batch(srsran_viterbi_t* q,
+                                              uint16_t*         symbols[SRSRAN_VITERBI_MAX_BATCH],
+                                              uint8_t*          data[SRSRAN_VITERBI_MAX_BATCH],
+                                              uint32_t          nof_cw,
+                                              uint32_t          frame_length);
+
 SRSRAN_API int srsran_viterbi_init_sse(srsran_viterbi_t*     q,
                                        srsran_viterbi_type_t type,
                                        int                   poly[3],
@@ -92,4 +118,10 @@ SRSRAN_API int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
                                         uint32_t              max_frame_length,
                                         bool                  tail_bitting);
 
+SRSRAN_API int srsran_viterbi_init_avx512(srsran_viterbi_t*     q,
+                                          srsran_viterbi_type_t type,
+                                          int                   poly[3],
+                                          uint32_t              max_frame_length,
+                                          bool                  tail_bitting);
+
 #endif // SRSRAN_VITERBI_H
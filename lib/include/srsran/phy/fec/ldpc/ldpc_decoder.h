@@ -60,6 +60,7 @@ typedef struct {
   uint16_t                   ls;           /*!< \brief The desired lifting size. */
   float                      scaling_fctr; /*!< \brief Scaling factor of the normalized min-sum algorithm.*/
   uint32_t                   max_nof_iter; /*!< \brief Maximum number of iterations, set to 0 for default value. */
+  bool                       early_stop;   /*!< \brief Stop as soon as the hard decisions satisfy all parity checks. */
 } srsran_ldpc_decoder_args_t;
 
 /*!
@@ -77,6 +78,7 @@ typedef struct SRSRAN_API {
   uint8_t            bgK;          /*!< \brief Number of "uncoded bits" in the BG. */
   uint16_t           liftK;        /*!< \brief Number of uncoded bits in the lifted graph. */
   uint16_t*          pcm;          /*!< \brief Pointer to the parity check matrix (compact form). */
+  uint8_t*           hard_bits;    /*!< \brief Hard decisions for the syndrome check (NULL if early stop disabled). */
 
   int8_t (*var_indices)[MAX_CNCT]; /*!< \brief Pointer to lists of variable indices connected to a given check node. */
 
@@ -125,6 +127,7 @@ SRSRAN_API void srsran_ldpc_decoder_free(srsran_ldpc_decoder_t* q);
  * \param[out] message The message (uncoded bits) resulting from the decoding
  *    operation.
  * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
+ * \return -1 if an error occurred, the number of used iterations otherwise.
  */
 SRSRAN_API int
 srsran_ldpc_decoder_decode_f(srsran_ldpc_decoder_t* q, const float* llrs, uint8_t* message, uint32_t cdwd_rm_length);
@@ -140,6 +143,7 @@ srsran_ldpc_decoder_decode_f(srsran_ldpc_decoder_t* q, const float* llrs, uint8_
  * \param[out] message The message (uncoded bits) resulting from the decoding
  *    operation.
  * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
+ * \return -1 if an error occurred, the number of used iterations otherwise.
  */
 SRSRAN_API int
 srsran_ldpc_decoder_decode_s(srsran_ldpc_decoder_t* q, const int16_t* llrs, uint8_t* message, uint32_t cdwd_rm_length);
@@ -155,6 +159,7 @@ srsran_ldpc_decoder_decode_s(srsran_ldpc_decoder_t* q, const int16_t* llrs, uint
  * \param[out] message The message (uncoded bits) resulting from the decoding
  *    operation.
  * \param[in] cdwd_rm_length The number of bits forming the codeword (after rate matching).
+ * \return -1 if an error occurred, the number of used iterations otherwise.
  */
 SRSRAN_API int
 srsran_ldpc_decoder_decode_c(srsran_ldpc_decoder_t* q, const int8_t* llrs, uint8_t* message, uint32_t cdwd_rm_length);
@@ -45,15 +45,30 @@ typedef enum SRSRAN_API {
   SRSRAN_POLAR_DECODER_SSC_S = 1, /*!< \brief Fixed-point (16 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C = 2, /*!< \brief Fixed-point (8 bit) Simplified Successive Cancellation (SSC) decoder. */
   SRSRAN_POLAR_DECODER_SSC_C_AVX2 =
-      3 /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+      3, /*!< \brief Fixed-point (8 bit, avx2) Simplified Successive Cancellation (SSC) decoder. */
+  SRSRAN_POLAR_DECODER_SCL2_C = 4, /*!< \brief Fixed-point (8 bit) Successive Cancellation List (SCL) decoder, L=2. */
+  SRSRAN_POLAR_DECODER_SCL4_C = 5, /*!< \brief Fixed-point (8 bit) Successive Cancellation List (SCL) decoder, L=4. */
+  SRSRAN_POLAR_DECODER_SCL8_C = 6, /*!< \brief Fixed-point (8 bit) Successive Cancellation List (SCL) decoder, L=8. */
 } srsran_polar_decoder_type_t;
 
+/*!
+ * \brief Maximum number of candidates returned by srsran_polar_decoder_decode_list_c().
+ */
+#define SRSRAN_POLAR_DECODER_MAX_LIST_SIZE 8
+
+/*!
+ * \brief Maximum number of codewords decoded at once by srsran_polar_decoder_decode_batch_c().
+ */
+#define SRSRAN_POLAR_DECODER_MAX_BATCH 8
+
 /*!
  * \brief Describes a polar decoder.
  */
 typedef struct SRSRAN_API {
-  void*   ptr;  /*!< \brief Pointer to the actual polar decoder structure. */
-  uint8_t nMax; /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  void*   ptr;       /*!< \brief Pointer to the actual polar decoder structure. */
+  void*   ptr_batch; /*!< \brief Pointer to the batch polar decoder structure (NULL if not supported). */
+  uint8_t nMax;      /*!< \brief Maximum \f$log_2(code_size)\f$. */
+  uint8_t list_size; /*!< \brief Number of candidates produced by the decoder (1 for SSC decoders). */
   int (*decode_f)(void*           ptr,
                   const float*    symbols,
                   uint8_t*        data_decoded,
@@ -72,6 +87,19 @@ typedef struct SRSRAN_API {
                   const uint8_t   n,
                   const uint16_t* frozen_set,
                   const uint16_t  frozen_set_size); /*!< \brief Pointer to the decoder function (8-bit version). */
+  int (*decode_list_c)(void*           ptr,
+                       const int8_t*   symbols,
+                       uint8_t*        data_decoded,
+                       const uint8_t   n,
+                       const uint16_t* frozen_set,
+                       const uint16_t  frozen_set_size); /*!< \brief Pointer to the list decoder function (8-bit). */
+  int (*decode_batch_c)(void*                ptr,
+                        const int8_t* const* symbols,
+                        uint8_t* const*      data_decoded,
+                        const uint32_t       nof_codewords,
+                        const uint8_t        n,
+                        const uint16_t*      frozen_set,
+                        const uint16_t       frozen_set_size); /*!< \brief Pointer to the batch decoder (8-bit). */
   void (*free)(void*);                             /*!< \brief Pointer to a "destructor". */
 } srsran_polar_decoder_t;
 
@@ -145,4 +173,53 @@ SRSRAN_API int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
                                              const uint16_t*         frozen_set,
                                              const uint16_t          frozen_set_size);
 
+/*!
+ * Decodes the input (int8_t) codeword with the specified polar decoder and returns all the candidates of a list
+ * decoder, sorted from the most to the least likely one, so that the caller can select the first one that passes the
+ * CRC check. Decoders that are not list decoders return a single candidate.
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr The decoder LLR input vector.
+ * \param[out] data_decoded The decoder output vectors, with room for q->list_size vectors of
+ * \f$2^{code\_size\_log}\f$ bits.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vector.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return The number of candidates written in data_decoded if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                                  const int8_t*           input_llr,
+                                                  uint8_t*                data_decoded,
+                                                  const uint8_t           code_size_log,
+                                                  const uint16_t*         frozen_set,
+                                                  const uint16_t          frozen_set_size);
+
+/*!
+ * Decodes several input (int8_t) codewords of the same polar code at once with the specified polar decoder. The AVX2
+ * SSC decoder processes all the codewords in a single pass of the decoding tree, the output of every codeword is the
+ * same as the one of srsran_polar_decoder_decode_c(). Other decoders decode the codewords one after the other.
+ * \param[in] q A pointer to the desired polar decoder.
+ * \param[in] input_llr The decoder LLR input vector of every codeword.
+ * \param[out] data_decoded The decoder output vector of every codeword.
+ * \param[in] nof_codewords Number of codewords, up to SRSRAN_POLAR_DECODER_MAX_BATCH.
+ * \param[in] code_size_log The \f$ log_2\f$ of the number of bits of the decoder input/output vectors.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+SRSRAN_API int srsran_polar_decoder_decode_batch_c(srsran_polar_decoder_t* q,
+                                                   const int8_t* const*    input_llr,
+                                                   uint8_t* const*         data_decoded,
+                                                   const uint32_t          nof_codewords,
+                                                   const uint8_t           code_size_log,
+                                                   const uint16_t*         frozen_set,
+                                                   const uint16_t          frozen_set_size);
+
+/*!
+ * Selects the 8-bit polar decoder type for a given list size.
+ * \param[in] list_size Number of paths of the list decoder: 0 or 1 select the SSC decoder, larger values select the
+ * SCL decoder with the smallest supported list size (2, 4 or 8) that is not smaller than list_size (up to 8).
+ * \return The polar decoder type.
+ */
+SRSRAN_API srsran_polar_decoder_type_t srsran_polar_decoder_type_from_list_size(uint32_t list_size);
+
 #endif // SRSRAN_POLARDECODER_H
@@ -0,0 +1,195 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ *  File:         iq_file.h
+ *
+ *  Description:  Streaming IQ recorder and player.
+ *                Stores complex baseband samples in a compact block based
+ *                container. Every block carries its own timestamp and scale,
+ *                so gaps in a transmission are not stored and the player
+ *                restores them as zeros. The file is read and written by a
+ *                dedicated I/O thread, the caller only encodes or decodes.
+ *
+ *                File layout (host byte order):
+ *                  srsran_iq_file_header_t
+ *                  srsran_iq_file_block_t + payload, repeated
+ *
+ *                The block floating point formats follow the O-RAN fronthaul
+ *                compression: groups of 12 complex samples share an exponent
+ *                byte followed by 24 big-endian packed mantissas.
+ *
+ *  Reference:    O-RAN.WG4.CUS.0, Annex A.1 Block Floating Point Compression
+ *****************************************************************************/
+
+#ifndef SRSRAN_IQ_FILE_H
+#define SRSRAN_IQ_FILE_H
+
+#include "srsran/config.h"
+#include "srsran/phy/utils/ringbuffer.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define SRSRAN_IQ_FILE_MAGIC "SRSRANIQ"
+#define SRSRAN_IQ_FILE_VERSION 1
+
+/* Maximum number of samples in a block, longer writes are split */
+#define SRSRAN_IQ_FILE_MAX_BLOCK_LEN (12 * 1024)
+
+/* Size of the buffer between the caller and the I/O thread */
+#define SRSRAN_IQ_FILE_RING_SIZE (64 * 1024 * 1024)
+
+/* Number of complex samples that share an exponent in block floating point */
+#define SRSRAN_IQ_FILE_BFP_GROUP_LEN 12
+
+typedef enum SRSRAN_API {
+  SRSRAN_IQ_FILE_FC32 = 0, // Complex float, 8 bytes per sample
+  SRSRAN_IQ_FILE_SC16,     // Complex short with a scale per block, 4 bytes per sample
+  SRSRAN_IQ_FILE_BFP9,     // Block floating point with 9 bit mantissas, 2.33 bytes per sample
+  SRSRAN_IQ_FILE_BFP12,    // Block floating point with 12 bit mantissas, 3.08 bytes per sample
+  SRSRAN_IQ_FILE_NOF_FORMATS
+} srsran_iq_file_format_t;
+
+typedef struct SRSRAN_API {
+  char     magic[8]; // SRSRAN_IQ_FILE_MAGIC, not null terminated
+  uint32_t version;
+  uint32_t format; // srsran_iq_file_format_t
+  double   srate_hz;
+} srsran_iq_file_header_t;
+
+typedef struct SRSRAN_API {
+  uint32_t nof_samples; // Number of samples in the block
+  uint32_t nof_bytes;   // Payload length in bytes
+  uint64_t timestamp;   // Index of the first sample since the start of the recording
+  float    scale;       // Amplitude of the integer full scale
+  uint32_t reserved;
+} srsran_iq_file_block_t;
+
+/* Recorder */
+typedef struct SRSRAN_API {
+  FILE*                   f;
+  srsran_iq_file_format_t format;
+  srsran_ringbuffer_t     ring;
+  pthread_t               thread;
+  pthread_mutex_t         mutex;
+  bool                    thread_started;
+  bool                    error; // Set by the I/O thread if the file can not be written
+  int16_t*                temp_int;
+  uint8_t*                temp_bytes;  // Block header and payload encoded by the caller
+  uint8_t*                io_buffer;   // Block payload being written by the I/O thread
+  uint64_t                nof_samples; // Samples recorded so far
+  uint64_t                nof_bytes;   // Bytes recorded so far, including headers
+} srsran_iq_recorder_t;
+
+/* Player */
+typedef struct SRSRAN_API {
+  FILE*                   f;
+  srsran_iq_file_header_t header;
+  srsran_ringbuffer_t     ring;
+  pthread_t               thread;
+  pthread_mutex_t         mutex;
+  bool                    thread_started;
+  bool                    running;
+  int16_t*                temp_int;
+  uint8_t*                temp_bytes; // Block payload being decoded by the caller
+  uint8_t*                io_buffer;  // Block header and payload read by the I/O thread
+  cf_t*                   block;      // Samples of the current block
+  uint32_t                block_len;  // Number of samples of the current block
+  uint32_t                block_pos;  // Next sample to play from the current block
+  uint64_t                block_ts;   // Timestamp of the first sample of the current block
+  uint64_t                ts;         // Timestamp of the next sample to play
+  bool                    eof;
+} srsran_iq_player_t;
+
+/**
+ * @brief Parses an IQ file format name: fc32, sc16, bfp9 or bfp12
+ * @return The format, or SRSRAN_IQ_FILE_NOF_FORMATS if the name is unknown
+ */
+SRSRAN_API srsran_iq_file_format_t srsran_iq_file_format_from_string(const char* name);
+
+SRSRAN_API const char* srsran_iq_file_format_to_string(srsran_iq_file_format_t format);
+
+/**
+ * @brief Computes the payload length of a block
+ * @param format Sample format
+ * @param nof_samples Number of samples in the block
+ * @return The number of bytes
+ */
+SRSRAN_API uint32_t srsran_iq_file_nof_bytes(srsran_iq_file_format_t format, uint32_t nof_samples);
+
+/**
+ * @brief Checks whether a file starts with an IQ file header, the file position is restored
+ * @return true if the file is an IQ file, false otherwise
+ */
+SRSRAN_API bool srsran_iq_file_probe(FILE* f);
+
+/**
+ * @brief Writes the file header and starts the I/O thread of the recorder
+ * @param q Recorder object
+ * @param f File opened for writing, it is not closed by the recorder
+ * @param format Sample format
+ * @param srate_hz Sampling rate stored in the header
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int
+srsran_iq_recorder_init(srsran_iq_recorder_t* q, FILE* f, srsran_iq_file_format_t format, double srate_hz);
+
+/**
+ * @brief Encodes the samples and queues them for writing. It only blocks if the I/O thread falls behind by more than
+ * SRSRAN_IQ_FILE_RING_SIZE bytes.
+ * @param q Recorder object
+ * @param samples Samples to record
+ * @param nof_samples Number of samples
+ * @param timestamp Index of the first sample since the start of the recording, skipped samples are played as zeros
+ * @return The number of recorded samples, or SRSRAN_ERROR if the file can not be written
+ */
+SRSRAN_API int
+srsran_iq_recorder_write(srsran_iq_recorder_t* q, const cf_t* samples, uint32_t nof_samples, uint64_t timestamp);
+
+/**
+ * @brief Writes all the queued samples, stops the I/O thread and frees the recorder
+ */
+SRSRAN_API void srsran_iq_recorder_free(srsran_iq_recorder_t* q);
+
+/**
+ * @brief Reads the file header and starts the read-ahead I/O thread of the player
+ * @param q Player object
+ * @param f File opened for reading at the IQ file header, it is not closed by the player
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_iq_player_init(srsran_iq_player_t* q, FILE* f);
+
+/**
+ * @brief Plays the next samples of the recording, the gaps between blocks are filled with zeros
+ * @param q Player object
+ * @param samples Output samples
+ * @param nof_samples Number of samples to play
+ * @return The number of samples played, SRSRAN_ERROR_RX_EOF once the recording has finished
+ */
+SRSRAN_API int srsran_iq_player_read(srsran_iq_player_t* q, cf_t* samples, uint32_t nof_samples);
+
+SRSRAN_API double srsran_iq_player_get_srate(srsran_iq_player_t* q);
+
+SRSRAN_API void srsran_iq_player_free(srsran_iq_player_t* q);
+
+#endif // SRSRAN_IQ_FILE_H
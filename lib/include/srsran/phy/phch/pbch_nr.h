@@ -35,9 +35,10 @@
  * @brief Describes the NR PBCH object initialisation arguments
  */
 typedef struct SRSRAN_API {
-  bool enable_encode; ///< Enable encoder
-  bool enable_decode; ///< Enable decoder
-  bool disable_simd;  ///< Disable SIMD polar encoder/decoder
+  bool     enable_encode;   ///< Enable encoder
+  bool     enable_decode;   ///< Enable decoder
+  bool     disable_simd;    ///< Disable SIMD polar encoder/decoder
+  uint32_t polar_list_size; ///< Polar list decoder size (2, 4 or 8), set to 0 or 1 for the SSC decoder
 } srsran_pbch_nr_args_t;
 
 /**
@@ -47,6 +47,17 @@
 
 typedef enum SRSRAN_API { SEARCH_UE, SEARCH_COMMON } srsran_pdcch_search_mode_t;
 
+/* Maximum number of decoded candidates kept between two srsran_pdcch_extract_llr() calls */
+#define SRSRAN_PDCCH_MAX_DECODED 64
+
+/* Decoded candidate, shared by every RNTI and DCI format with the same size in the same location */
+typedef struct SRSRAN_API {
+  srsran_dci_location_t location;
+  uint32_t              nof_bits;
+  uint16_t              crc_rem;
+  uint8_t               payload[SRSRAN_DCI_MAX_BITS];
+} srsran_pdcch_decoded_t;
+
 /* PDCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t cell;
@@ -64,9 +75,13 @@ typedef struct SRSRAN_API {
   cf_t*    x[SRSRAN_MAX_PORTS];
   cf_t*    d;
   uint8_t* e;
-  float    rm_f[3 * (SRSRAN_DCI_MAX_BITS + 16)];
+  float    rm_f[SRSRAN_VITERBI_MAX_BATCH][3 * (SRSRAN_DCI_MAX_BITS + 16)];
   float*   llr;
 
+  /* candidates decoded from the current LLRs */
+  srsran_pdcch_decoded_t decoded[SRSRAN_PDCCH_MAX_DECODED];
+  uint32_t               nof_decoded;
+
   /* tx & rx objects */
   srsran_modem_table_t mod;
   srsran_sequence_t    seq[SRSRAN_NOF_SF_X_FRAME];
@@ -104,6 +119,26 @@ SRSRAN_API int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
 SRSRAN_API int
 srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dci_cfg_t* dci_cfg, srsran_dci_msg_t* msg);
 
+/**
+ * @brief Decodes the DCI messages of every format in the given locations, several candidates at once. The decoded
+ * candidates are kept in the PDCCH object and srsran_pdcch_decode_msg() does not decode them again.
+ * @param q PDCCH object
+ * @param sf Subframe configuration
+ * @param dci_cfg DCI configuration
+ * @param locations Candidate locations
+ * @param nof_locations Number of candidate locations
+ * @param formats DCI formats
+ * @param nof_formats Number of DCI formats
+ * @return The number of decoded candidates if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_pdcch_decode_candidates(srsran_pdcch_t*            q,
+                                              srsran_dl_sf_cfg_t*        sf,
+                                              srsran_dci_cfg_t*          dci_cfg,
+                                              srsran_dci_location_t*     locations,
+                                              uint32_t                   nof_locations,
+                                              const srsran_dci_format_t* formats,
+                                              uint32_t                   nof_formats);
+
 /**
  * @brief Computes decoded DCI correlation. It encodes the given DCI message and compares it with the received LLRs
  * @param q PDCCH object
@@ -45,9 +45,10 @@
  * @brief PDCCH configuration initialization arguments
  */
 typedef struct {
-  bool disable_simd;
-  bool measure_evm;
-  bool measure_time;
+  bool     disable_simd;
+  bool     measure_evm;
+  bool     measure_time;
+  uint32_t polar_list_size; ///< Polar list decoder size (2, 4 or 8), set to 0 or 1 for the SSC decoder (receiver only)
 } srsran_pdcch_nr_args_t;
 
 /**
@@ -56,6 +57,7 @@ typedef struct {
 typedef struct SRSRAN_API {
   bool                   is_tx;
   srsran_polar_code_t    code;
+  uint32_t               code_E; // Rate-matched bits of the current polar code
   srsran_polar_encoder_t encoder;
   srsran_polar_decoder_t decoder;
   srsran_polar_rm_t      rm;
@@ -63,9 +65,9 @@ typedef struct SRSRAN_API {
   srsran_coreset_t       coreset;
   srsran_crc_t           crc24c;
   uint8_t*               c;         // Message bits with attached CRC
-  uint8_t*               d;         // encoded bits
+  uint8_t*               d;         // encoded bits (one slice per candidate of a decoding batch)
   uint8_t*               f;         // bits at the Rate matching output
-  uint8_t*               allocated; // Allocated polar bit buffer, encoder input, decoder output
+  uint8_t*               allocated; // Allocated polar bit buffer, encoder input, decoder output (all candidates)
   cf_t*                  symbols;
   srsran_modem_table_t   modem_table;
   srsran_evm_buffer_t*   evm_buffer;
@@ -154,6 +156,63 @@ SRSRAN_API int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
                                       srsran_dci_msg_nr_t*    dci_msg,
                                       srsran_pdcch_nr_res_t*  res);
 
+/**
+ * @brief Demodulates the PDCCH candidate in a given location into rate-matched soft bits
+ *
+ * The soft bits are not descrambled, so they do not depend on the DCI size, RNTI or search space and they can be
+ * decoded by srsran_pdcch_nr_decode_llr() for every blind-decoding attempt in the same location.
+ *
+ * @param[in,out] q provides PDCCH encoder/decoder object
+ * @param[in] slot_symbols provides slot resource grid
+ * @param[in] ce provides channel estimated resource elements
+ * @param[in] location Candidate location
+ * @param[out] llr Destination soft bits, it must fit 2 * SRSRAN_PDCCH_MAX_RE values
+ * @param[out] res Provides the EVM measurement
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_demodulate(srsran_pdcch_nr_t*           q,
+                                          cf_t*                        slot_symbols,
+                                          srsran_dmrs_pdcch_ce_t*      ce,
+                                          const srsran_dci_location_t* location,
+                                          int8_t*                      llr,
+                                          srsran_pdcch_nr_res_t*       res);
+
+/**
+ * @brief Decodes a DCI from the soft bits given by srsran_pdcch_nr_demodulate(), the soft bits are not modified
+ *
+ * @param[in,out] q provides PDCCH encoder/decoder object
+ * @param[in] llr provides the candidate soft bits
+ * @param[in,out] dci_msg Provides with the DCI message location, RNTI, RNTI type and so on. Also, the message data
+ * buffer
+ * @param[out] res Provides the CRC result, the EVM is left untouched
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_decode_llr(srsran_pdcch_nr_t*     q,
+                                          const int8_t*          llr,
+                                          srsran_dci_msg_nr_t*   dci_msg,
+                                          srsran_pdcch_nr_res_t* res);
+
+/**
+ * @brief Decodes the DCI of several candidates with the same DCI size and aggregation level at once, as
+ * srsran_pdcch_nr_decode_llr() does for each of them
+ *
+ * The AVX2 SSC polar decoder processes all the candidates in a single pass of the decoding tree. Other decoders decode
+ * the candidates one after the other.
+ *
+ * @param[in,out] q provides PDCCH encoder/decoder object
+ * @param[in] llr provides the soft bits of every candidate
+ * @param[in,out] dci_msg Provides the DCI message of every candidate, all of them with the same size and aggregation
+ * level
+ * @param[out] res Provides the CRC result of every candidate, the EVM is left untouched
+ * @param[in] nof_candidates Number of candidates, up to SRSRAN_POLAR_DECODER_MAX_BATCH
+ * @return SRSRAN_SUCCESS if the configurations are valid, otherwise it returns an SRSRAN_ERROR code
+ */
+SRSRAN_API int srsran_pdcch_nr_decode_llr_batch(srsran_pdcch_nr_t*     q,
+                                                const int8_t*          llr[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                                srsran_dci_msg_nr_t*   dci_msg[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                                srsran_pdcch_nr_res_t* res[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                                uint32_t               nof_candidates);
+
 /**
  * @brief Stringifies NR PDCCH decoding information from the latest encoded/decoded transmission
  *
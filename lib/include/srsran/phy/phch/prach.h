@@ -86,6 +86,10 @@ typedef struct SRSRAN_API {
   uint64_t dft_gen_bitmap;    // Bitmap where each bit Indicates if the dft has been generated for sequence i.
   uint32_t root_seqs_idx[64]; // Indices of root seqs in seqs table
   uint32_t N_roots;           // Number of root sequences used in this configuration
+  uint32_t seqs_rsi;          // Root sequence index of the generated sequences
+  uint32_t seqs_N_zc;         // Length of the generated sequences, 0 if they have not been generated
+  uint32_t seqs_N_cs;         // Cyclic shift of the generated sequences
+  bool     seqs_hs;           // High speed flag of the generated sequences
   cf_t*    td_signals[64];
   // Containers
   cf_t*  ifft_in;
@@ -102,6 +106,12 @@ typedef struct SRSRAN_API {
   srsran_dft_plan_t zc_fft;
   srsran_dft_plan_t zc_ifft;
 
+  // Correlation of the received bins with every root sequence, one row of N_zc per root, all rows are taken to the
+  // delay domain with a single batched IFFT
+  cf_t*             corr_bank;
+  srsran_dft_plan_t zc_ifft_bank;
+  uint32_t          zc_ifft_bank_nof_roots; // Number of rows the bank IFFT is planned for
+
   cf_t* signal_fft;
   float detect_factor;
 
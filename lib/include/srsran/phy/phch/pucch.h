@@ -34,6 +34,7 @@
 #include "srsran/phy/ch_estimation/chest_ul.h"
 #include "srsran/phy/common/phy_common.h"
 #include "srsran/phy/common/sequence.h"
+#include "srsran/phy/dft/dft.h"
 #include "srsran/phy/modem/mod.h"
 #include "srsran/phy/phch/cqi.h"
 #include "srsran/phy/phch/pucch_cfg.h"
@@ -58,6 +59,15 @@
 #define SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT3 (0.5f)
 #define SRSRAN_PUCCH_DEFAULT_THRESHOLD_DMRS (0.4f)
 
+/* Cyclic shift spectrum of one PUCCH Format 1/1a/1b PRB and slot, shared by all the UEs multiplexed on it */
+typedef struct SRSRAN_API {
+  cf_t     bins[SRSRAN_CP_NORM_NSYMB][SRSRAN_NRE]; // DFT of the received REs without the base sequence
+  float    power[SRSRAN_CP_NORM_NSYMB];           // Average RE power
+  float    freq[SRSRAN_CP_NORM_NSYMB];            // Normalised frequency of the REs without the base sequence
+  uint32_t u;                                     // Sequence group the bins were computed with
+  bool     valid;
+} srsran_pucch_bank_t;
+
 /* PUCCH object */
 typedef struct SRSRAN_API {
   srsran_cell_t        cell;
@@ -78,6 +88,12 @@ typedef struct SRSRAN_API {
   cf_t* z_tmp;
   cf_t* ce;
 
+  // Format 1/1a/1b joint detection, eNb only
+  srsran_pucch_bank_t* bank; // One entry per slot and PRB
+  uint32_t             bank_tti;
+  cf_t*                bank_buffer;
+  srsran_dft_plan_t    bank_dft;
+
 } srsran_pucch_t;
 
 typedef struct SRSRAN_API {
@@ -119,6 +135,35 @@ SRSRAN_API int srsran_pucch_decode(srsran_pucch_t*        q,
                                    cf_t*                  sf_symbols,
                                    srsran_pucch_res_t*    data);
 
+/**
+ * Invalidates the Format 1/1a/1b cyclic shift bank. It shall be called every time the resource grid given to
+ * srsran_pucch_decode_joint() changes.
+ *
+ * @param q PUCCH object
+ */
+SRSRAN_API void srsran_pucch_reset_joint(srsran_pucch_t* q);
+
+/**
+ * Detects and decodes a PUCCH Format 1/1a/1b transmission without a dedicated channel estimation. The first UE
+ * looking at a PRB and slot removes the base sequence and transforms every symbol with a 12-point DFT; each bin holds
+ * one cyclic shift, so every UE multiplexed in the same PRB estimates its channel and despreads its orthogonal cover
+ * from a handful of bins. The channel is assumed flat within the PRB.
+ *
+ * The correlation, detection thresholds and measurements have the same meaning as in srsran_pucch_decode().
+ *
+ * @param q PUCCH object
+ * @param sf Uplink subframe configuration
+ * @param cfg PUCCH configuration with the format and n_pucch resource already selected
+ * @param sf_symbols Received resource grid
+ * @param data Decoded UCI, detection result and measurements
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_pucch_decode_joint(srsran_pucch_t*     q,
+                                         srsran_ul_sf_cfg_t* sf,
+                                         srsran_pucch_cfg_t* cfg,
+                                         cf_t*               sf_symbols,
+                                         srsran_pucch_res_t* data);
+
 /* Other utilities. These functions do not modify the state and run in real-time */
 SRSRAN_API float srsran_pucch_alpha_format1(const uint32_t n_cs_cell[SRSRAN_NSLOTS_X_FRAME][SRSRAN_CP_NORM_NSYMB],
                                             const srsran_pucch_cfg_t* cfg,
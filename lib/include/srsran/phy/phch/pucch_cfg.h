@@ -78,6 +78,7 @@ typedef struct SRSRAN_API {
   float threshold_data_valid_format3;
   float threshold_dmrs_detection;
   bool  meas_ta_en;
+  bool  joint_detection_en; ///< Detect Format 1/1a/1b from the per-PRB cyclic shift bank shared by all UEs
 
   // PUCCH configuration generated during a call to encode/decode
   srsran_pucch_format_t format;
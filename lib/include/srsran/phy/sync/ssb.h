@@ -59,6 +59,7 @@ typedef struct SRSRAN_API {
   bool                        enable_encode;      ///< Enables PBCH Encoder
   bool                        enable_decode;      ///< Enables PBCH Decoder
   bool                        disable_polar_simd; ///< Disables polar encoder/decoder SIMD acceleration
+  uint32_t                    polar_list_size;    ///< PBCH polar list decoder size, set to 0 or 1 for SSC decoding
   float                       pbch_dmrs_thr;      ///< NR-PBCH DMRS threshold for blind decoding, set to 0 for default
 } srsran_ssb_args_t;
 
@@ -32,6 +32,10 @@
  *                (SRSRAN_CS_SAMP_FREQ constant) before calling to
  *                srsran_ue_cellsearch_scan() functions.
  *
+ *                In parallel mode, the samples are received once and the three
+ *                N_id_2 hypotheses are searched on them concurrently, each one in
+ *                its own thread.
+ *
  *  Reference:
  *****************************************************************************/
 
@@ -74,6 +78,8 @@ typedef struct SRSRAN_API {
   uint8_t*  mode_counted;
 
   srsran_ue_cellsearch_result_t* candidates;
+
+  void* parallel_ptr; // Parallel scan context, NULL if the N_id_2 hypotheses are scanned one after another
 } srsran_ue_cellsearch_t;
 
 SRSRAN_API int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
@@ -90,6 +96,25 @@ srsran_ue_cellsearch_init_multi(srsran_ue_cellsearch_t* q,
 
 SRSRAN_API void srsran_ue_cellsearch_free(srsran_ue_cellsearch_t* q);
 
+/**
+ * Enables the parallel scan. srsran_ue_cellsearch_scan() receives the samples once and searches the three N_id_2 in
+ * separate threads, so the scan takes the receive time of a single N_id_2 instead of three. The AGC is not run in this
+ * mode.
+ * @param q Cell search object
+ * @return SRSRAN_SUCCESS if no error occurs, SRSRAN_ERROR code otherwise
+ */
+SRSRAN_API int srsran_ue_cellsearch_enable_parallel(srsran_ue_cellsearch_t* q);
+
+SRSRAN_API void srsran_ue_cellsearch_disable_parallel(srsran_ue_cellsearch_t* q);
+
+/**
+ * Gets the synchronization object that searches the given N_id_2 in parallel mode, used for setting its options
+ * @param q Cell search object
+ * @param N_id_2 Cell identity within the group
+ * @return The synchronization object, NULL if the parallel scan is not enabled
+ */
+SRSRAN_API srsran_ue_sync_t* srsran_ue_cellsearch_get_parallel_ue_sync(srsran_ue_cellsearch_t* q, uint32_t N_id_2);
+
 SRSRAN_API int
 srsran_ue_cellsearch_scan_N_id_2(srsran_ue_cellsearch_t* q, uint32_t N_id_2, srsran_ue_cellsearch_result_t* found_cell);
 
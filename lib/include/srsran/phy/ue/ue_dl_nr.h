@@ -54,6 +54,19 @@ typedef struct SRSRAN_API {
   uint32_t                    nof_bits;
 } srsran_ue_dl_nr_pdcch_info_t;
 
+/**
+ * @brief Demodulated PDCCH candidate location, shared by the blind-decoding attempts of every DCI size, search space
+ * and RNTI in the same slot
+ */
+typedef struct SRSRAN_API {
+  uint32_t                    coreset_id;
+  srsran_dci_location_t       location;
+  srsran_dmrs_pdcch_measure_t measure;
+  srsran_pdcch_nr_res_t       result; ///< Demodulation result (EVM)
+  bool                        valid;  ///< Set if the DMRS measurements passed the thresholds and llr is demodulated
+  int8_t*                     llr;    ///< Soft bits before descrambling
+} srsran_ue_dl_nr_pdcch_candidate_t;
+
 typedef struct SRSRAN_API {
   uint32_t max_prb;
   uint32_t nof_rx_antennas;
@@ -78,6 +91,11 @@ typedef struct SRSRAN_API {
   srsran_ue_dl_nr_pdcch_info_t pdcch_info[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
   uint32_t                     pdcch_info_count;
 
+  /// Demodulated candidate locations in the current slot, it is reset by srsran_ue_dl_nr_estimate_fft()
+  srsran_ue_dl_nr_pdcch_candidate_t pdcch_candidates[SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
+  uint32_t                          pdcch_candidates_count;
+  int8_t*                           pdcch_llr;
+
   /// DCI packing/unpacking object
   srsran_dci_nr_t dci;
 
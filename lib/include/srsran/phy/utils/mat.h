@@ -67,6 +67,16 @@ SRSRAN_API void srsran_mat_2x2_mmse_csi_gen(cf_t   y0,
 
 SRSRAN_API int srsran_mat_2x2_cn(cf_t h00, cf_t h01, cf_t h10, cf_t h11, float* cn);
 
+/* Generic implementation of the MMSE solver for up to 4 receive antennas and 4 layers, h is indexed as h[rx][layer].
+ * A zero noise estimate gives the ZF solution. The CSI is skipped if csi is NULL. */
+SRSRAN_API void srsran_mat_4x4_mmse_csi_gen(const cf_t y[4],
+                                            const cf_t h[4][4],
+                                            uint32_t   nof_rx,
+                                            uint32_t   nof_layers,
+                                            cf_t       x[4],
+                                            float*     csi,
+                                            float      noise_estimate);
+
 #ifdef LV_HAVE_SSE
 
 /* SSE implementation for complex reciprocal */
@@ -203,6 +213,100 @@ static inline void srsran_mat_2x2_mmse_simd(simd_cf_t  y0,
   srsran_mat_2x2_mmse_csi_simd(y0, y1, h00, h01, h10, h11, x0, x1, &csi0, &csi1, noise_estimate, norm);
 }
 
+/* Reciprocal refined with one Newton-Raphson iteration, the plain SIMD reciprocal is only accurate to ~12 bits */
+static inline simd_f_t srsran_mat_f_rcp_nr_simd(simd_f_t a)
+{
+  simd_f_t r = srsran_simd_f_rcp(a);
+  return srsran_simd_f_mul(r, srsran_simd_f_sub(srsran_simd_f_set1(2.0f), srsran_simd_f_mul(a, r)));
+}
+
+static inline simd_f_t srsran_mat_cf_abs2_simd(simd_cf_t a)
+{
+  simd_f_t re = srsran_simd_cf_re(a);
+  simd_f_t im = srsran_simd_cf_im(a);
+  return srsran_simd_f_add(srsran_simd_f_mul(re, re), srsran_simd_f_mul(im, im));
+}
+
+/* Generic SIMD implementation of the MMSE solver for up to 4 receive antennas and 4 layers. The channel is given as
+ * h[rx][layer]. It solves (H' x H + No) x = H' x y with a LDL' decomposition, so each layer costs one real reciprocal
+ * instead of a full matrix inversion. With a zero noise estimate it gives the Zero Forcing (ZF) solution. The CSI is
+ * 1 / diag(inv(H' x H + No)), it is skipped if csi is NULL.
+ */
+static inline void srsran_mat_4x4_mmse_csi_simd(const simd_cf_t y[4],
+                                                const simd_cf_t h[4][4],
+                                                uint32_t        nof_rx,
+                                                uint32_t        nof_layers,
+                                                simd_cf_t       x[4],
+                                                simd_f_t*       csi,
+                                                float           noise_estimate)
+{
+  simd_f_t  d[4], d_rcp[4];
+  simd_cf_t a[4][4], l[4][4], z[4];
+
+  /* 1. A = H' x H + No (lower triangle, diagonal in d) and z = H' x y */
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    d[i] = srsran_simd_f_set1(noise_estimate);
+    z[i] = srsran_simd_cf_zero();
+    for (uint32_t r = 0; r < nof_rx; r++) {
+      d[i] = srsran_simd_f_add(d[i], srsran_mat_cf_abs2_simd(h[r][i]));
+      z[i] = srsran_simd_cf_add(z[i], srsran_simd_cf_conjprod(y[r], h[r][i]));
+    }
+    for (uint32_t j = 0; j < i; j++) {
+      a[i][j] = srsran_simd_cf_zero();
+      for (uint32_t r = 0; r < nof_rx; r++) {
+        a[i][j] = srsran_simd_cf_add(a[i][j], srsran_simd_cf_conjprod(h[r][j], h[r][i]));
+      }
+    }
+  }
+
+  /* 2. A = L x D x L', column by column */
+  for (uint32_t j = 0; j < nof_layers; j++) {
+    for (uint32_t k = 0; k < j; k++) {
+      d[j] = srsran_simd_f_sub(d[j], srsran_simd_f_mul(srsran_mat_cf_abs2_simd(l[j][k]), d[k]));
+    }
+    d_rcp[j] = srsran_mat_f_rcp_nr_simd(d[j]);
+    for (uint32_t i = j + 1; i < nof_layers; i++) {
+      simd_cf_t v = a[i][j];
+      for (uint32_t k = 0; k < j; k++) {
+        v = srsran_simd_cf_sub(v, srsran_simd_cf_mul(srsran_simd_cf_conjprod(l[i][k], l[j][k]), d[k]));
+      }
+      l[i][j] = srsran_simd_cf_mul(v, d_rcp[j]);
+    }
+  }
+
+  /* 3. Forward substitution, L x z' = z */
+  for (uint32_t i = 1; i < nof_layers; i++) {
+    for (uint32_t k = 0; k < i; k++) {
+      z[i] = srsran_simd_cf_sub(z[i], srsran_simd_cf_prod(l[i][k], z[k]));
+    }
+  }
+
+  /* 4. Backward substitution, L' x x = inv(D) x z' */
+  for (int32_t i = (int32_t)nof_layers - 1; i >= 0; i--) {
+    x[i] = srsran_simd_cf_mul(z[i], d_rcp[i]);
+    for (uint32_t k = i + 1; k < nof_layers; k++) {
+      x[i] = srsran_simd_cf_sub(x[i], srsran_simd_cf_conjprod(x[k], l[k][i]));
+    }
+  }
+
+  /* 5. CSI, diag(inv(A)) = diag(M' x inv(D) x M) where M = inv(L) is unit lower triangular */
+  if (csi) {
+    simd_cf_t m[4][4];
+    for (uint32_t j = 0; j < nof_layers; j++) {
+      simd_f_t s = d_rcp[j];
+      for (uint32_t i = j + 1; i < nof_layers; i++) {
+        simd_cf_t v = l[i][j];
+        for (uint32_t k = j + 1; k < i; k++) {
+          v = srsran_simd_cf_add(v, srsran_simd_cf_prod(l[i][k], m[k][j]));
+        }
+        m[i][j] = srsran_simd_cf_neg(v);
+        s       = srsran_simd_f_add(s, srsran_simd_f_mul(srsran_mat_cf_abs2_simd(m[i][j]), d_rcp[i]));
+      }
+      csi[j] = srsran_mat_f_rcp_nr_simd(s);
+    }
+  }
+}
+
 #endif /* SRSRAN_SIMD_CF_SIZE != 0 */
 
 typedef struct {
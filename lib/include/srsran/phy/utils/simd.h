@@ -1885,6 +1885,31 @@ static inline simd_s_t srsran_simd_convert_2f_s(simd_f_t a, simd_f_t b)
 #endif /* LV_HAVE_AVX512 */
 }
 
+/* Inverse of srsran_simd_convert_2f_s, a takes the first SRSRAN_SIMD_F_SIZE elements and b the rest */
+static inline void srsran_simd_convert_s_2f(simd_s_t x, simd_f_t* a, simd_f_t* b)
+{
+#ifdef LV_HAVE_AVX512
+  *a = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm512_castsi512_si256(x)));
+  *b = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(_mm512_extracti64x4_epi64(x, 1)));
+#else /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  *a = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_castsi256_si128(x)));
+  *b = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm256_extracti128_si256(x, 1)));
+#else
+#ifdef LV_HAVE_SSE
+  // Sign extension by an arithmetic shift, SSE2 lacks _mm_cvtepi16_epi32
+  *a = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16));
+  *b = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16));
+#else
+#ifdef HAVE_NEON
+  *a = vcvtq_f32_s32(vmovl_s16(vget_low_s16(x)));
+  *b = vcvtq_f32_s32(vmovl_s16(vget_high_s16(x)));
+#endif /* HAVE_NEON */
+#endif /* LV_HAVE_SSE */
+#endif /* LV_HAVE_AVX2 */
+#endif /* LV_HAVE_AVX512 */
+}
+
 #endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_C16_SIZE */
 
 #if SRSRAN_SIMD_B_SIZE
@@ -194,6 +194,20 @@ SRSRAN_API void srsran_vec_convert_conj_cs(const cf_t* x, const float scale, int
 SRSRAN_API void srsran_vec_convert_if(const int16_t* x, const float scale, float* z, const uint32_t len);
 SRSRAN_API void srsran_vec_convert_fb(const float* x, const float scale, int8_t* z, const uint32_t len);
 
+/* Fused conversion and gain of interleaved IQ, every sample is touched once. Unlike srsran_vec_convert_if/fi, the scale
+ * multiplies the samples in both directions and len counts complex samples. The output is zero-padded from len to
+ * out_len; a NULL input produces out_len zeros. Float to int16 saturates. */
+SRSRAN_API void srsran_vec_convert_scale_sc(const int16_t* x,
+                                            const float    scale,
+                                            cf_t*          z,
+                                            const uint32_t len,
+                                            const uint32_t out_len);
+SRSRAN_API void srsran_vec_convert_scale_cs(const cf_t*    x,
+                                            const float    scale,
+                                            int16_t*       z,
+                                            const uint32_t len,
+                                            const uint32_t out_len);
+
 SRSRAN_API void srsran_vec_lut_sss(const short* x, const unsigned short* lut, short* y, const uint32_t len);
 SRSRAN_API void srsran_vec_lut_bbb(const int8_t* x, const unsigned short* lut, int8_t* y, const uint32_t len);
 SRSRAN_API void srsran_vec_lut_sis(const short* x, const unsigned int* lut, short* y, const uint32_t len);
@@ -124,6 +124,12 @@ SRSRAN_API void srsran_vec_convert_if_simd(const int16_t* x, float* z, const flo
 
 SRSRAN_API void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const float scale, const int len);
 
+SRSRAN_API void
+srsran_vec_convert_scale_sc_simd(const int16_t* x, cf_t* z, const float scale, const int len, const int out_len);
+
+SRSRAN_API void
+srsran_vec_convert_scale_cs_simd(const cf_t* x, int16_t* z, const float scale, const int len, const int out_len);
+
 SRSRAN_API void srsran_vec_convert_conj_cs_simd(const cf_t* x, int16_t* z, const float scale, const int len);
 
 SRSRAN_API void srsran_vec_convert_fb_simd(const float* x, int8_t* z, const float scale, const int len);
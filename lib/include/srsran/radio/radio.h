@@ -31,6 +31,7 @@
 #include "srsran/srslog/srslog.h"
 #include "srsran/srsran.h"
 
+#include <chrono>
 #include <list>
 #include <string>
 
@@ -100,6 +101,8 @@ private:
   std::vector<int32_t>                                    rx_offset_n = {};
   rf_metrics_t                                            rf_metrics  = {};
   std::mutex                                              metrics_mutex;
+  std::atomic<uint64_t>                                   rx_time_ns = {0}; ///< Received sample time since last report
+  std::chrono::steady_clock::time_point                   metrics_tp = {};
   srslog::basic_logger&                                   logger = srslog::fetch_basic_logger("RF", false);
   phy_interface_radio*                                    phy    = nullptr;
   std::vector<cf_t>                                       zeros;
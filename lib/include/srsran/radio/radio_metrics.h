@@ -29,6 +29,7 @@ typedef struct {
   uint32_t rf_u;
   uint32_t rf_l;
   bool     rf_error;
+  float    rf_speedup; ///< Received sample time over wall-clock time since the last report, above 1 when not paced
 } rf_metrics_t;
 
 } // namespace srsran
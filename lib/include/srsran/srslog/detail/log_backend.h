@@ -23,6 +23,7 @@
 #define SRSLOG_DETAIL_LOG_BACKEND_H
 
 #include "srsran/srslog/bundled/fmt/printf.h"
+#include "srsran/srslog/detail/support/hex_dump_pool.h"
 #include "srsran/srslog/shared_types.h"
 
 namespace srslog {
@@ -46,6 +47,9 @@ public:
   /// Allocates a dyn_arg_store and returns a pointer to it on success, otherwise returns nullptr.
   virtual fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() = 0;
 
+  /// Captures a copy of the len bytes pointed by data to be carried as the hex dump of a log entry.
+  virtual hex_dump_buffer alloc_hex_dump(const uint8_t* data, size_t len) = 0;
+
   /// Pushes a log entry into the backend. Returns true on success, otherwise
   /// false.
   virtual bool push(log_entry&& entry) = 0;
@@ -22,9 +22,21 @@
 #ifndef SRSLOG_DETAIL_SUPPORT_BACKEND_CAPACITY_H
 #define SRSLOG_DETAIL_SUPPORT_BACKEND_CAPACITY_H
 
-/// Take this default value if users did not specify any custom size.
+/// Take this default value if users did not specify any custom size. This is the default capacity of the log queue of
+/// each producer thread, rounded up to a power of two. It can be changed at runtime with
+/// srslog::set_thread_queue_capacity().
 #ifndef SRSLOG_QUEUE_CAPACITY
 #define SRSLOG_QUEUE_CAPACITY 8192
 #endif
 
+/// Size in bytes of each of the pre-allocated blocks used for capturing hex dumps. Larger hex dumps are heap allocated.
+#ifndef SRSLOG_HEX_DUMP_BLOCK_SIZE
+#define SRSLOG_HEX_DUMP_BLOCK_SIZE 512
+#endif
+
+/// Number of pre-allocated blocks used for capturing hex dumps.
+#ifndef SRSLOG_HEX_DUMP_POOL_CAPACITY
+#define SRSLOG_HEX_DUMP_POOL_CAPACITY 2048
+#endif
+
 #endif // SRSLOG_DETAIL_SUPPORT_BACKEND_CAPACITY_H
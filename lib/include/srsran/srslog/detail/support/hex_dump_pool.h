@@ -0,0 +1,197 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_DETAIL_SUPPORT_HEX_DUMP_POOL_H
+#define SRSLOG_DETAIL_SUPPORT_HEX_DUMP_POOL_H
+
+#include "srsran/srslog/detail/support/backend_capacity.h"
+#include "srsran/srslog/detail/support/thread_utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace srslog {
+
+namespace detail {
+
+class hex_dump_pool;
+
+/// Byte buffer holding the captured bytes of a hex dump. The storage is either a block borrowed from a hex_dump_pool,
+/// which gets returned to the pool on destruction, or a heap allocation for buffers not served by a pool.
+class hex_dump_buffer
+{
+public:
+  hex_dump_buffer() = default;
+
+  explicit hex_dump_buffer(size_t size) { resize(size); }
+
+  hex_dump_buffer(hex_dump_pool& pool, uint8_t* block, size_t size) :
+    pool(&pool), block_ptr(block), nof_bytes(size), capacity(SRSLOG_HEX_DUMP_BLOCK_SIZE)
+  {}
+
+  hex_dump_buffer(const hex_dump_buffer& other) : hex_dump_buffer(other.size())
+  {
+    std::copy(other.cbegin(), other.cend(), begin());
+  }
+
+  hex_dump_buffer(hex_dump_buffer&& other) noexcept :
+    pool(other.pool),
+    block_ptr(other.block_ptr),
+    heap(std::move(other.heap)),
+    nof_bytes(other.nof_bytes),
+    capacity(other.capacity)
+  {
+    other.pool      = nullptr;
+    other.block_ptr = nullptr;
+    other.nof_bytes = 0;
+    other.capacity  = 0;
+  }
+
+  hex_dump_buffer& operator=(hex_dump_buffer other) noexcept
+  {
+    std::swap(pool, other.pool);
+    std::swap(block_ptr, other.block_ptr);
+    std::swap(heap, other.heap);
+    std::swap(nof_bytes, other.nof_bytes);
+    std::swap(capacity, other.capacity);
+    return *this;
+  }
+
+  ~hex_dump_buffer() { release(); }
+
+  /// Resizes the buffer to the specified number of bytes, keeping the current contents.
+  void resize(size_t size)
+  {
+    if (size > capacity) {
+      std::unique_ptr<uint8_t[]> new_heap(new uint8_t[size]());
+      std::copy(cbegin(), cend(), new_heap.get());
+      release();
+      heap     = std::move(new_heap);
+      capacity = size;
+    }
+    nof_bytes = size;
+  }
+
+  uint8_t*       data() { return block_ptr ? block_ptr : heap.get(); }
+  const uint8_t* data() const { return block_ptr ? block_ptr : heap.get(); }
+  size_t         size() const { return nof_bytes; }
+  bool           empty() const { return nof_bytes == 0; }
+
+  uint8_t*       begin() { return data(); }
+  uint8_t*       end() { return data() + nof_bytes; }
+  const uint8_t* begin() const { return data(); }
+  const uint8_t* end() const { return data() + nof_bytes; }
+  const uint8_t* cbegin() const { return data(); }
+  const uint8_t* cend() const { return data() + nof_bytes; }
+
+private:
+  /// Returns the storage to its owner.
+  inline void release();
+
+private:
+  hex_dump_pool*             pool      = nullptr;
+  uint8_t*                   block_ptr = nullptr;
+  std::unique_ptr<uint8_t[]> heap;
+  size_t                     nof_bytes = 0;
+  size_t                     capacity  = 0;
+};
+
+/// Keeps a pool of fixed size memory blocks used to capture hex dumps in the caller thread without allocating memory.
+/// Hex dumps larger than the block size, or captured when the pool is exhausted, fall back to a heap allocation.
+class hex_dump_pool
+{
+public:
+  hex_dump_pool() : storage(new uint8_t[SRSLOG_HEX_DUMP_POOL_CAPACITY * SRSLOG_HEX_DUMP_BLOCK_SIZE])
+  {
+    free_list.reserve(SRSLOG_HEX_DUMP_POOL_CAPACITY);
+    for (size_t i = 0; i != SRSLOG_HEX_DUMP_POOL_CAPACITY; ++i) {
+      free_list.push_back(storage.get() + i * SRSLOG_HEX_DUMP_BLOCK_SIZE);
+    }
+  }
+
+  hex_dump_pool(const hex_dump_pool&) = delete;
+  hex_dump_pool& operator=(const hex_dump_pool&) = delete;
+
+  /// Returns a buffer holding a copy of the len bytes pointed by data.
+  hex_dump_buffer alloc(const uint8_t* data, size_t len)
+  {
+    if (len == 0) {
+      return {};
+    }
+
+    uint8_t* block = nullptr;
+    if (len <= SRSLOG_HEX_DUMP_BLOCK_SIZE) {
+      scoped_lock lock(m);
+      if (!free_list.empty()) {
+        block = free_list.back();
+        free_list.pop_back();
+      }
+    }
+
+    if (!block) {
+      hex_dump_buffer buffer(len);
+      std::memcpy(buffer.data(), data, len);
+      return buffer;
+    }
+
+    std::memcpy(block, data, len);
+    return {*this, block, len};
+  }
+
+  /// Deallocate the given block returning it to the pool.
+  void dealloc(uint8_t* block)
+  {
+    scoped_lock lock(m);
+    free_list.push_back(block);
+  }
+
+  /// Returns the number of blocks currently available in the pool.
+  size_t nof_free_blocks() const
+  {
+    scoped_lock lock(m);
+    return free_list.size();
+  }
+
+private:
+  std::unique_ptr<uint8_t[]> storage;
+  std::vector<uint8_t*>      free_list;
+  mutable mutex              m;
+};
+
+inline void hex_dump_buffer::release()
+{
+  if (block_ptr) {
+    pool->dealloc(block_ptr);
+  }
+  pool      = nullptr;
+  block_ptr = nullptr;
+  heap.reset();
+  nof_bytes = 0;
+  capacity  = 0;
+}
+
+} // namespace detail
+
+} // namespace srslog
+
+#endif // SRSLOG_DETAIL_SUPPORT_HEX_DUMP_POOL_H
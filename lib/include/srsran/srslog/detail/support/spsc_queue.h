@@ -0,0 +1,155 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_DETAIL_SUPPORT_SPSC_QUEUE_H
+#define SRSLOG_DETAIL_SUPPORT_SPSC_QUEUE_H
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+
+namespace srslog {
+
+namespace detail {
+
+/// Bounded lock-free queue for a single producer thread and a single consumer thread. The capacity is rounded up to a
+/// power of two. The storage is allocated by the producer in segments the first time it reaches them, so the memory
+/// of the queue grows up to its high-water mark instead of the full capacity.
+template <typename T>
+class spsc_queue
+{
+  using storage_type = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+  /// Size of the padding that keeps producer and consumer indexes in different cache lines.
+  static constexpr size_t cache_line_size = 64;
+
+  /// Number of elements of a storage segment.
+  static constexpr size_t segment_size = 256;
+
+public:
+  explicit spsc_queue(size_t capacity_) :
+    capacity(round_up_capacity(capacity_)),
+    seg_size(std::min(capacity, segment_size)),
+    segments(new std::unique_ptr<storage_type[]>[capacity / seg_size])
+  {}
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+
+  ~spsc_queue()
+  {
+    for (size_t i = head.load(std::memory_order_relaxed), e = tail.load(std::memory_order_relaxed); i != e; ++i) {
+      slot(i).~T();
+    }
+  }
+
+  /// Inserts a new element into the back of the queue. Returns false when the queue is full, otherwise true.
+  /// NOTE: Only to be called from the producer thread.
+  bool push(T&& value)
+  {
+    size_t t = tail.load(std::memory_order_relaxed);
+    if (t - producer_head == capacity) {
+      producer_head = head.load(std::memory_order_acquire);
+      if (t - producer_head == capacity) {
+        return false;
+      }
+    }
+
+    // The segment is published to the consumer by the release store of the tail.
+    std::unique_ptr<storage_type[]>& segment = segments[(t & (capacity - 1)) / seg_size];
+    if (!segment) {
+      segment.reset(new storage_type[seg_size]);
+      allocated_size.fetch_add(seg_size, std::memory_order_relaxed);
+    }
+
+    new (&slot(t)) T(std::move(value));
+    tail.store(t + 1, std::memory_order_release);
+
+    return true;
+  }
+
+  /// Extracts the top most element from the queue if it exists.
+  /// Returns a pair with a bool indicating if the pop has been successful.
+  /// NOTE: Only to be called from the consumer thread.
+  std::pair<bool, T> try_pop()
+  {
+    size_t h = head.load(std::memory_order_relaxed);
+    if (h == consumer_tail) {
+      consumer_tail = tail.load(std::memory_order_acquire);
+      if (h == consumer_tail) {
+        return {false, T()};
+      }
+    }
+
+    T item = std::move(slot(h));
+    slot(h).~T();
+    head.store(h + 1, std::memory_order_release);
+
+    return {true, std::move(item)};
+  }
+
+  /// Returns true when the queue has no elements. The result is only a hint when called from the producer thread.
+  bool empty() const { return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+
+  /// Capacity of the queue.
+  size_t get_capacity() const { return capacity; }
+
+  /// Number of elements the allocated storage can hold.
+  size_t get_allocated_size() const { return allocated_size.load(std::memory_order_relaxed); }
+
+private:
+  static size_t round_up_capacity(size_t value)
+  {
+    size_t rounded = 1;
+    while (rounded < value) {
+      rounded <<= 1;
+    }
+    return rounded;
+  }
+
+  T& slot(size_t index)
+  {
+    size_t pos = index & (capacity - 1);
+    return *reinterpret_cast<T*>(&segments[pos / seg_size][pos % seg_size]);
+  }
+
+private:
+  const size_t                                       capacity;
+  const size_t                                       seg_size;
+  std::unique_ptr<std::unique_ptr<storage_type[]>[]> segments;
+  std::atomic<size_t>                                allocated_size{0};
+  char                                               pad0[cache_line_size];
+  /// Consumer side state.
+  std::atomic<size_t> head{0};
+  size_t              consumer_tail = 0;
+  char                pad1[cache_line_size];
+  /// Producer side state.
+  std::atomic<size_t> tail{0};
+  size_t              producer_head = 0;
+  char                pad2[cache_line_size];
+};
+
+} // namespace detail
+
+} // namespace srslog
+
+#endif // SRSLOG_DETAIL_SUPPORT_SPSC_QUEUE_H
@@ -0,0 +1,271 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_DETAIL_SUPPORT_THREAD_QUEUE_SET_H
+#define SRSLOG_DETAIL_SUPPORT_THREAD_QUEUE_SET_H
+
+#include "srsran/srslog/detail/support/backend_capacity.h"
+#include "srsran/srslog/detail/support/spsc_queue.h"
+#include "srsran/srslog/detail/support/thread_utils.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace srslog {
+
+namespace detail {
+
+/// Returns a process wide unique identifier for a thread_queue_set instance.
+inline uint64_t get_next_thread_queue_set_id()
+{
+  static std::atomic<uint64_t> next_id{0};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+/// Set of work queues with one single producer single consumer queue for each producer thread. Producers never
+/// contend with each other: each thread pushes into its own lock-free queue, which is created the first time the
+/// thread pushes an element. The consumer thread drains the queues in a round-robin fashion, so that the order of the
+/// elements pushed by a thread is preserved.
+/// NOTE: Only one consumer thread is allowed.
+template <typename T>
+class thread_queue_set
+{
+  /// Queue of a producer thread and its statistics.
+  struct thread_queue {
+    explicit thread_queue(size_t capacity) : queue(capacity) {}
+
+    spsc_queue<T> queue;
+    /// Number of elements discarded because the queue was full.
+    std::atomic<uint64_t> nof_dropped{0};
+    /// Set when the producer thread has exited, the queue is removed once drained.
+    std::atomic<bool> detached{false};
+    /// Set when the owning queue set has been destroyed.
+    std::atomic<bool> orphaned{false};
+    std::string       thread_name;
+    long              thread_id;
+    /// Number of dropped elements already reported by the consumer.
+    uint64_t nof_reported_dropped = 0;
+
+    /// Returns true when the queue is no longer needed by any thread.
+    bool is_disposable() const
+    {
+      return detached.load(std::memory_order_acquire) && queue.empty() &&
+             nof_dropped.load(std::memory_order_relaxed) == nof_reported_dropped;
+    }
+  };
+
+  /// Per thread cache of the queues that the thread owns in each set, marks the queues as detached on thread exit.
+  struct thread_queue_cache {
+    std::vector<std::pair<uint64_t, std::shared_ptr<thread_queue> > > queues;
+
+    ~thread_queue_cache()
+    {
+      for (auto& q : queues) {
+        q.second->detached.store(true, std::memory_order_release);
+      }
+    }
+  };
+
+public:
+  /// Drop statistics of a producer thread.
+  struct drop_report {
+    const std::string& thread_name;
+    long               thread_id;
+    /// Number of dropped elements since the last report.
+    uint64_t nof_new_dropped;
+    /// Total number of dropped elements.
+    uint64_t nof_dropped;
+  };
+
+  explicit thread_queue_set(size_t capacity_ = SRSLOG_QUEUE_CAPACITY) : capacity(capacity_) {}
+
+  /// Destroys the pending elements, producers must not push elements anymore.
+  ~thread_queue_set()
+  {
+    for (auto& q : registry) {
+      while (q->queue.try_pop().first) {
+      }
+      q->orphaned.store(true, std::memory_order_release);
+    }
+  }
+
+  thread_queue_set(const thread_queue_set&) = delete;
+  thread_queue_set& operator=(const thread_queue_set&) = delete;
+
+  /// Inserts a new element into the back of the queue of the calling thread. Returns false when the queue is full,
+  /// otherwise true.
+  bool push(T&& value)
+  {
+    thread_queue& q = get_thread_queue();
+    if (!q.queue.push(std::move(value))) {
+      q.nof_dropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    event.notify();
+
+    return true;
+  }
+
+  /// Visits every producer queue popping up to batch_size elements from each of them, and calls the specified
+  /// function with each popped element. Returns the number of popped elements.
+  /// NOTE: Only to be called from the consumer thread.
+  template <typename Func>
+  size_t pop_round(Func&& func, size_t batch_size)
+  {
+    refresh_consumer_queues();
+
+    // The function may reenter this method, so iterate with a reference to the queue that survives a refresh of the
+    // consumer queues.
+    size_t count = 0;
+    for (size_t idx = 0; idx < consumer_queues.size(); ++idx) {
+      std::shared_ptr<thread_queue> q = consumer_queues[idx];
+      for (size_t i = 0; i != batch_size; ++i) {
+        auto item = q->queue.try_pop();
+        if (!item.first) {
+          break;
+        }
+        func(std::move(item.second));
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  /// Blocks the consumer thread for up to the specified timeout until a producer pushes a new element.
+  /// NOTE: Only to be called from the consumer thread.
+  void wait(unsigned timeout_ms)
+  {
+    uint32_t key = event.prepare_wait();
+    refresh_consumer_queues();
+    for (const auto& q : consumer_queues) {
+      if (!q->queue.empty()) {
+        event.cancel_wait();
+        return;
+      }
+    }
+    event.wait(key, timeout_ms);
+  }
+
+  /// Wakes up the consumer thread if blocked in wait.
+  void wake_up() { event.notify(); }
+
+  /// Calls the specified function with a drop_report for each producer thread that has dropped elements since the
+  /// last call.
+  /// NOTE: Only to be called from the consumer thread.
+  template <typename Func>
+  void report_drops(Func&& func)
+  {
+    refresh_consumer_queues();
+
+    for (auto& q : consumer_queues) {
+      uint64_t nof_dropped = q->nof_dropped.load(std::memory_order_relaxed);
+      if (nof_dropped != q->nof_reported_dropped) {
+        func(drop_report{q->thread_name, q->thread_id, nof_dropped - q->nof_reported_dropped, nof_dropped});
+        q->nof_reported_dropped = nof_dropped;
+      }
+    }
+  }
+
+  /// Capacity of the producer queues created from now on.
+  size_t get_capacity() const { return capacity.load(std::memory_order_relaxed); }
+
+  /// Sets the capacity of the producer queues created from now on, the queues of the threads that have already pushed
+  /// elements keep their capacity.
+  void set_capacity(size_t capacity_) { capacity.store(capacity_, std::memory_order_relaxed); }
+
+private:
+  /// Returns the queue of the calling thread, creating it on the first call.
+  thread_queue& get_thread_queue()
+  {
+    static thread_local thread_queue_cache cache;
+
+    for (auto& q : cache.queues) {
+      if (q.first == id) {
+        return *q.second;
+      }
+    }
+
+    // Forget the queues of destroyed sets before registering a new one.
+    cache.queues.erase(std::remove_if(cache.queues.begin(),
+                                      cache.queues.end(),
+                                      [](const std::pair<uint64_t, std::shared_ptr<thread_queue> >& q) {
+                                        return q.second->orphaned.load(std::memory_order_acquire);
+                                      }),
+                       cache.queues.end());
+
+    auto q = std::make_shared<thread_queue>(capacity.load(std::memory_order_relaxed));
+    char name[16];
+    if (::pthread_getname_np(::pthread_self(), name, sizeof(name)) == 0) {
+      q->thread_name = name;
+    }
+    q->thread_id = ::syscall(SYS_gettid);
+    cache.queues.emplace_back(id, q);
+
+    scoped_lock lock(registry_mutex);
+    registry.push_back(std::move(q));
+    registry_version.fetch_add(1, std::memory_order_release);
+
+    return *cache.queues.back().second;
+  }
+
+  /// Updates the consumer view of the producer queues when threads have been registered, and removes the drained
+  /// queues of exited threads.
+  void refresh_consumer_queues()
+  {
+    bool has_detached = false;
+    for (const auto& q : consumer_queues) {
+      has_detached |= q->is_disposable();
+    }
+
+    uint32_t version = registry_version.load(std::memory_order_acquire);
+    if (version == consumer_version && !has_detached) {
+      return;
+    }
+
+    scoped_lock lock(registry_mutex);
+    if (has_detached) {
+      registry.erase(std::remove_if(registry.begin(),
+                                    registry.end(),
+                                    [](const std::shared_ptr<thread_queue>& q) { return q->is_disposable(); }),
+                     registry.end());
+    }
+    consumer_queues  = registry;
+    consumer_version = registry_version.load(std::memory_order_relaxed);
+  }
+
+private:
+  const uint64_t                              id = get_next_thread_queue_set_id();
+  std::atomic<size_t>                         capacity;
+  futex_event                                 event;
+  mutex                                       registry_mutex;
+  std::vector<std::shared_ptr<thread_queue> > registry;
+  std::atomic<uint32_t>                       registry_version{0};
+  /// Consumer thread copy of the registry.
+  std::vector<std::shared_ptr<thread_queue> > consumer_queues;
+  uint32_t                                    consumer_version = 0;
+};
+
+} // namespace detail
+
+} // namespace srslog
+
+#endif // SRSLOG_DETAIL_SUPPORT_THREAD_QUEUE_SET_H
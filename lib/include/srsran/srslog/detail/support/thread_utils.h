@@ -22,7 +22,12 @@
 #ifndef SRSLOG_DETAIL_SUPPORT_THREAD_UTILS_H
 #define SRSLOG_DETAIL_SUPPORT_THREAD_UTILS_H
 
+#include <atomic>
+#include <cerrno>
+#include <linux/futex.h>
 #include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 namespace srslog {
 
@@ -173,6 +178,49 @@ public:
   ~cond_var_scoped_lock() { cond_var.unlock(); }
 };
 
+/// Lightweight event used by a single consumer thread to sleep until producers signal new work. Producers only pay a
+/// system call when the consumer is actually sleeping, otherwise notifying is a couple of atomic operations.
+class futex_event
+{
+public:
+  futex_event() = default;
+
+  futex_event(const futex_event&) = delete;
+  futex_event& operator=(const futex_event&) = delete;
+
+  /// Announces that the consumer is about to sleep. The returned key has to be passed to wait() after checking once
+  /// more for pending work, so that notifications issued in between are not lost.
+  uint32_t prepare_wait()
+  {
+    waiting.store(true);
+    return seq.load();
+  }
+
+  /// Cancels a previous call to prepare_wait().
+  void cancel_wait() { waiting.store(false, std::memory_order_relaxed); }
+
+  /// Blocks the calling thread until notified or until the specified timeout expires.
+  void wait(uint32_t key, unsigned timeout_ms)
+  {
+    timespec ts{static_cast<time_t>(timeout_ms / 1000), static_cast<long>((timeout_ms % 1000) * 1000000)};
+    ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq), FUTEX_WAIT_PRIVATE, key, &ts, nullptr, 0);
+    cancel_wait();
+  }
+
+  /// Wakes up the consumer thread if it is sleeping.
+  void notify()
+  {
+    seq.fetch_add(1);
+    if (waiting.load()) {
+      ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&seq), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+  }
+
+private:
+  std::atomic<uint32_t> seq{0};
+  std::atomic<bool>     waiting{false};
+};
+
 } // namespace detail
 
 } // namespace srslog
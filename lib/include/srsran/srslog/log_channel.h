@@ -138,9 +138,10 @@ public:
     }
     (void)std::initializer_list<int>{(store->push_back(std::forward<Args>(args)), 0)...};
 
-    // Calculate the length to capture in the buffer.
-    if (hex_max_size >= 0) {
-      len = std::min<size_t>(len, hex_max_size);
+    // Calculate the length to capture in the buffer, only the bytes that will get printed are copied.
+    int max_size = hex_max_size.load(std::memory_order_relaxed);
+    if (max_size >= 0) {
+      len = std::min<size_t>(len, max_size);
     }
 
     // Send the log entry to the backend.
@@ -155,7 +156,7 @@ public:
                                 store,
                                 log_name,
                                 log_tag,
-                                std::vector<uint8_t>(buffer, buffer + len)}};
+                                backend.alloc_hex_dump(buffer, len)}};
     backend.push(std::move(entry));
   }
 
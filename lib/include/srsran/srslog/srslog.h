@@ -25,6 +25,7 @@
 #include "srsran/srslog/detail/support/any.h"
 #include "srsran/srslog/logger.h"
 #include "srsran/srslog/shared_types.h"
+#include <chrono>
 
 namespace srslog {
 
@@ -195,6 +196,27 @@ sink& fetch_file_sink(const std::string&             path,
                       bool                           force_flush = false,
                       std::unique_ptr<log_formatter> f           = get_default_log_formatter());
 
+/// Returns an instance of a sink that writes into a file in the specified path
+/// through memory mappings, so that writes do not block on the disk. The file
+/// grows in preallocated segments that are written back asynchronously.
+/// Specifying a max_size value different to zero will make the sink create a
+/// new file each time the current file exceeds this value. The units of
+/// max_size are bytes. Specifying a rotation_period different to zero will
+/// make the sink create a new file once the current one has been open for
+/// longer than this period.
+sink& fetch_mmap_file_sink(const std::string&             path,
+                           size_t                         max_size        = 0,
+                           std::chrono::seconds           rotation_period = std::chrono::seconds(0),
+                           std::unique_ptr<log_formatter> f               = get_default_log_formatter());
+
+/// Returns an instance of a sink that writes compact binary log records into a
+/// file in the specified path. Records keep the raw format arguments and are
+/// rendered into text offline with the srslog_decode tool. Specifying a
+/// max_size value different to zero will make the sink create a new file each
+/// time the current file exceeds this value. The units of max_size are bytes.
+/// Setting force_flush to true will flush the sink after every write.
+sink& fetch_binary_file_sink(const std::string& path, size_t max_size = 0, bool force_flush = false);
+
 /// Returns an instance of a sink that writes into syslog
 /// preamble: The string  prepended to every message, If ident is "", the program name is used.
 /// log_local: custom unused facilities that syslog provides which can be used by the user
@@ -254,6 +276,13 @@ void flush();
 /// NOTE: This function should be called before init() and is NOT thread safe.
 void set_error_handler(error_handler handler);
 
+/// Sets the capacity in log entries of the queue of each thread that generates log entries, it is rounded up to a
+/// power of two. The memory of a queue grows on demand up to its capacity, with about 160 bytes per entry. Entries
+/// are dropped when the queue of their thread is full.
+/// NOTE: Only the threads that log for the first time after this call get the new capacity, so it should be called
+/// before init().
+void set_thread_queue_capacity(size_t capacity);
+
 } // namespace srslog
 
 #endif // SRSLOG_SRSLOG_H
@@ -22,7 +22,9 @@
 #ifndef SRSRAN_PDCP_ENTITY_LTE_H
 #define SRSRAN_PDCP_ENTITY_LTE_H
 
+#include "srsran/adt/bounded_bitset.h"
 #include "srsran/adt/circular_array.h"
+#include "srsran/adt/circular_buffer.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/common.h"
 #include "srsran/common/security.h"
@@ -39,10 +41,20 @@ class rlc_interface_pdcp;
 
 namespace srsran {
 
+/**
+ * Queue of SDUs pending delivery confirmation from RLC AM, indexed by PDCP SN.
+ *
+ * The discard timers of the stored SDUs are not implemented with one timer per SDU. Since all SDUs of a bearer share
+ * the same discardTimer value and are stored in increasing COUNT order, their expiry times are monotonic. The queue
+ * keeps a FIFO of (SN, expiry) pairs and a single timer armed to the expiry of the FIFO head. When the timer fires, all
+ * SDUs whose discard time has elapsed are handed to the discard callback in one go.
+ */
 class undelivered_sdus_queue
 {
 public:
-  explicit undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod);
+  explicit undelivered_sdus_queue(srsran::task_sched_handle             task_sched,
+                                  uint32_t                              sn_mod,
+                                  srsran::move_callback<void(uint32_t)> discard_callback);
 
   bool            empty() const { return count == 0; }
   bool            is_full() const { return count >= capacity; }
@@ -53,13 +65,10 @@ public:
     assert(sn != invalid_sn && "provided PDCP SN is invalid");
     return sdus[sn].sdu != nullptr and sdus[sn].sdu->md.pdcp_sn == sn;
   }
-  // Getter for the number of discard timers. Used for debugging.
-  size_t nof_discard_timers() const;
+  // Getter for the number of SDUs with a pending discard. Used for debugging.
+  size_t nof_discard_timers() const { return nof_pending_discards; }
 
-  bool add_sdu(uint32_t                              sn,
-               const srsran::unique_byte_buffer_t&   sdu,
-               uint32_t                              discard_timeout,
-               srsran::move_callback<void(uint32_t)> callback);
+  bool add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu, uint32_t discard_timeout);
 
   unique_byte_buffer_t& operator[](uint32_t sn)
   {
@@ -88,14 +97,36 @@ private:
 
   struct sdu_data {
     srsran::unique_byte_buffer_t sdu;
-    srsran::unique_timer         discard_timer;
+    uint32_t                     discard_deadline = 0;
+    bool                         discard_pending  = false;
+  };
+
+  struct discard_entry {
+    uint32_t sn;
+    uint32_t deadline;
   };
 
+  // Discard timer helpers
+  uint32_t discard_now() const;
+  void     push_discard(uint32_t sn, uint32_t deadline);
+  void     purge_stale_discards();
+  void     arm_discard_timer();
+  void     handle_discard_timer_expiry();
+
   uint32_t                                   count = 0;
   uint32_t                                   bytes = 0;
   uint32_t                                   fms   = 0; // SN of the first missing PDCP SDU
   uint32_t                                   lms   = 0;
   srsran::circular_array<sdu_data, capacity> sdus;
+
+  // Discard expiry FIFO. Entries of SDUs that were delivered before expiry are left in place and skipped lazily.
+  srsran::static_circular_buffer<discard_entry, capacity> discard_fifo;
+  srsran::unique_timer                                    discard_timer;
+  srsran::move_callback<void(uint32_t)>                   discard_callback;
+  uint32_t                                                discard_clock        = 0; ///< ms elapsed at timer start
+  uint32_t                                                discard_timer_offset = 0;
+  bool                                                    in_discard_expiry    = false;
+  uint32_t                                                nof_pending_discards = 0;
 };
 
 /****************************************************************************
@@ -179,11 +210,17 @@ private:
   uint32_t                                maximum_allocated_sns_window = 2048;
   std::unique_ptr<undelivered_sdus_queue> undelivered_sdus;
 
-  // Rx info queue
-  uint32_t              fmc              = 0;
-  uint32_t              largest_rx_count = 0;
-  std::vector<uint32_t> rx_counts_info; // Keeps the RX_COUNT for generation of the stauts report
-  void                  update_rx_counts_queue(uint32_t rx_count);
+  // Rx info for generation of the status report. Each bit flags a received COUNT in (FMC, FMC + reordering_window),
+  // indexed by COUNT modulo the reordering window.
+  static const uint32_t                         max_reordering_window = 2048;
+  uint32_t                                      fmc                   = 0;
+  uint32_t                                      largest_rx_count      = 0;
+  uint32_t                                      nof_rx_counts         = 0;
+  srsran::bounded_bitset<max_reordering_window> rx_counts_bitmap;
+  void                                          update_rx_counts_queue(uint32_t rx_count);
+  void                                          set_rx_count_received(uint32_t rx_count, bool received);
+  void                                          advance_fmc();
+  bool rx_count_received(uint32_t rx_count) const { return rx_counts_bitmap.test(rx_count % reordering_window); }
 
   /*
    * Helper function to see if an SN is larger
@@ -206,16 +243,11 @@ private:
 class pdcp_entity_lte::discard_callback
 {
 public:
-  discard_callback(pdcp_entity_lte* parent_, uint32_t sn_)
-  {
-    parent     = parent_;
-    discard_sn = sn_;
-  };
-  void operator()(uint32_t timer_id);
+  explicit discard_callback(pdcp_entity_lte* parent_) : parent(parent_) {}
+  void operator()(uint32_t discard_sn);
 
 private:
   pdcp_entity_lte* parent;
-  uint32_t         discard_sn;
 };
 
 } // namespace srsran
@@ -100,8 +100,11 @@ bool pdcp_entity_lte::configure(const pdcp_config_t& cnfg_)
   logger.info("Status Report Required: %s", cfg.status_report_required ? "True" : "False");
 
   if (is_drb() and not rlc->rb_is_um(lcid)) {
-    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(new undelivered_sdus_queue(task_sched, maximum_pdcp_sn));
-    rx_counts_info.reserve(reordering_window);
+    undelivered_sdus = std::unique_ptr<undelivered_sdus_queue>(
+        new undelivered_sdus_queue(task_sched, maximum_pdcp_sn, discard_callback(this)));
+    rx_counts_bitmap.resize(reordering_window);
+    rx_counts_bitmap.reset();
+    nof_rx_counts = 0;
   }
 
   // Check supported config
@@ -468,51 +471,55 @@ void pdcp_entity_lte::update_rx_counts_queue(uint32_t rx_count)
     largest_rx_count = rx_count;
   }
 
-  // The received COUNT is the first missing COUNT
-  if (rx_count == fmc) {
-    fmc++;
-    // Update the queue for the Status report bitmap, if first missing count changed
-    while (not rx_counts_info.empty() && rx_counts_info.back() == fmc) {
-      rx_counts_info.pop_back();
-      fmc++;
+  // If the RX_COUNT falls outside of the bitmap window, consider the lowest COUNTs as lost and slide the window.
+  if (rx_count - fmc >= reordering_window) {
+    logger.debug("Window too large. Updating. Old FMC=%d, queue_size=%d", fmc, nof_rx_counts);
+    uint32_t new_fmc = rx_count - reordering_window + 1;
+    if (new_fmc - fmc >= reordering_window) {
+      rx_counts_bitmap.reset();
+      nof_rx_counts = 0;
+      fmc           = new_fmc;
+    } else {
+      for (; fmc != new_fmc; fmc++) {
+        set_rx_count_received(fmc, false);
+      }
     }
-  } else {
-    rx_counts_info.push_back(rx_count);
-    std::sort(rx_counts_info.begin(), rx_counts_info.end(), std::greater<uint32_t>());
-  }
-
-  // If the size of the rx_vector_info is getting very large
-  // Consider the FMC as lost and update the vector.
-  if (rx_counts_info.size() > reordering_window) {
-    logger.debug("Queue too large. Updating. Old FMC=%d, Old back=%d, old queue_size=%zu",
-                 fmc,
-                 rx_counts_info.back(),
-                 rx_counts_info.size());
-    fmc = rx_counts_info.back();
-    while (not rx_counts_info.empty() && rx_counts_info.back() == fmc) {
-      rx_counts_info.pop_back();
+    while (nof_rx_counts > 0 and rx_count_received(fmc)) {
+      set_rx_count_received(fmc, false);
       fmc++;
     }
-    if (not rx_counts_info.empty()) {
-      logger.debug("Queue too large. Updating. New FMC=%d, new back=%d, new queue_size=%zu",
-                   fmc,
-                   rx_counts_info.back(),
-                   rx_counts_info.size());
-    } else {
-      logger.debug("Queue too large. Updating. New FMC=%d, new queue_size=%zu", fmc, rx_counts_info.size());
-    }
+    logger.debug("Window too large. Updating. New FMC=%d, new queue_size=%d", fmc, nof_rx_counts);
   }
 
-  if (rx_counts_info.empty()) {
-    logger.info("Updated RX_COUNT info with SDU COUNT=%d, queue_size%zu, FMC=%d", rx_count, rx_counts_info.size(), fmc);
+  if (rx_count == fmc) {
+    // The received COUNT is the first missing COUNT
+    advance_fmc();
   } else {
-    logger.info("Updated RX_COUNT info with SDU COUNT=%d, queue_size=%zu, FMC=%d, back=%d",
-                rx_count,
-                rx_counts_info.size(),
-                fmc,
-                rx_counts_info.back());
+    set_rx_count_received(rx_count, true);
+  }
+
+  logger.info("Updated RX_COUNT info with SDU COUNT=%d, queue_size=%d, FMC=%d", rx_count, nof_rx_counts, fmc);
+}
+
+void pdcp_entity_lte::set_rx_count_received(uint32_t rx_count, bool received)
+{
+  uint32_t idx = rx_count % reordering_window;
+  if (rx_counts_bitmap.test(idx) != received) {
+    rx_counts_bitmap.set(idx, received);
+    nof_rx_counts = received ? nof_rx_counts + 1 : nof_rx_counts - 1;
+  }
+}
+
+void pdcp_entity_lte::advance_fmc()
+{
+  // Update the bitmap for the Status report, skipping all COUNTs that were already received
+  fmc++;
+  while (nof_rx_counts > 0 and rx_count_received(fmc)) {
+    set_rx_count_received(fmc, false);
+    fmc++;
   }
 }
+
 /****************************************************************************
  * Control handler functions (Status Report)
  * Ref: 3GPP TS 36.323 v10.1.0 Section 5.1.3
@@ -542,7 +549,7 @@ void pdcp_entity_lte::send_status_report()
   uint32_t fms = SN(fmc);
 
   // Get Last Missing Segment
-  uint32_t nof_sns_in_bitmap = rx_counts_info.size();
+  uint32_t nof_sns_in_bitmap = nof_rx_counts;
 
   // Allocate Status Report PDU
   unique_byte_buffer_t pdu = make_byte_buffer();
@@ -574,7 +581,7 @@ void pdcp_entity_lte::send_status_report()
   }
 
   // Add bitmap of missing PDUs, if necessary
-  if (not rx_counts_info.empty()) {
+  if (nof_rx_counts > 0) {
     // First check size of bitmap
     int32_t  diff    = largest_rx_count - (fmc - 1);
     uint32_t nof_sns = 1u << cfg.sn_len;
@@ -591,12 +598,23 @@ void pdcp_entity_lte::send_status_report()
         largest_rx_count,
         fms - 1,
         bitmap_sz);
-    for (uint32_t rx_count : rx_counts_info) {
+    // Walk the received COUNTs in (FMC, largest RX_COUNT], skipping empty words of the bitmap
+    uint32_t rx_count = fmc + 1;
+    while (rx_count <= largest_rx_count) {
+      uint32_t start = rx_count % reordering_window;
+      uint32_t len   = std::min(largest_rx_count - rx_count + 1, reordering_window - start);
+      int      pos   = rx_counts_bitmap.find_lowest(start, start + len);
+      if (pos < 0) {
+        rx_count += len;
+        continue;
+      }
+      rx_count += pos - start;
       logger.debug("Setting bitmap for RX_COUNT=%d", rx_count);
       uint32_t offset      = rx_count - (fmc + 1);
       uint32_t bit_offset  = offset % 8;
       uint32_t byte_offset = offset / 8;
       pdu->msg[pdu->N_bytes + byte_offset] |= 1 << (7 - bit_offset);
+      rx_count++;
     }
     pdu->N_bytes += bitmap_sz;
   }
@@ -717,10 +735,9 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
     }
   }
 
-  // Copy PDU contents into queue and start discard timer
-  uint32_t         discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
-  discard_callback discard_fnc(this, sn);
-  bool             ret = undelivered_sdus->add_sdu(sn, sdu, discard_timeout, discard_fnc);
+  // Copy PDU contents into queue and schedule discard
+  uint32_t discard_timeout = static_cast<uint32_t>(cfg.discard_timer);
+  bool     ret             = undelivered_sdus->add_sdu(sn, sdu, discard_timeout);
   if (ret and discard_timeout > 0) {
     logger.debug("Discard Timer set for SN %u. Timeout: %ums", sn, discard_timeout);
   }
@@ -731,7 +748,7 @@ bool pdcp_entity_lte::store_sdu(uint32_t sn, const unique_byte_buffer_t& sdu)
  * Discard functionality
  ***************************************************************************/
 // Discard Timer Callback (discardTimer)
-void pdcp_entity_lte::discard_callback::operator()(uint32_t timer_id)
+void pdcp_entity_lte::discard_callback::operator()(uint32_t discard_sn)
 {
   parent->logger.info("Discard timer for SN=%d expired", discard_sn);
 
@@ -837,6 +854,8 @@ void pdcp_entity_lte::set_bearer_state(const pdcp_lte_state_t& state, bool set_f
   st = state;
   if (set_fmc) {
     fmc = COUNT(st.rx_hfn, st.last_submitted_pdcp_rx_sn);
+    rx_counts_bitmap.reset();
+    nof_rx_counts = 0;
   }
 }
 
@@ -873,17 +892,16 @@ void pdcp_entity_lte::reset_metrics()
 /****************************************************************************
  * Undelivered SDUs queue helpers
  ***************************************************************************/
-undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle task_sched, uint32_t sn_mod) : sn_mod(sn_mod)
+undelivered_sdus_queue::undelivered_sdus_queue(srsran::task_sched_handle             task_sched,
+                                               uint32_t                              sn_mod,
+                                               srsran::move_callback<void(uint32_t)> discard_callback_) :
+  sn_mod(sn_mod), discard_callback(std::move(discard_callback_))
 {
-  for (auto& e : sdus) {
-    e.discard_timer = task_sched.get_unique_timer();
-  }
+  discard_timer = task_sched.get_unique_timer();
+  discard_timer.set(1, [this](uint32_t tid) { handle_discard_timer_expiry(); });
 }
 
-bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
-                                     const srsran::unique_byte_buffer_t&   sdu,
-                                     uint32_t                              discard_timeout,
-                                     srsran::move_callback<void(uint32_t)> callback)
+bool undelivered_sdus_queue::add_sdu(uint32_t sn, const srsran::unique_byte_buffer_t& sdu, uint32_t discard_timeout)
 {
   assert(not has_sdu(sn) && "Cannot add repeated SNs");
 
@@ -921,9 +939,14 @@ bool undelivered_sdus_queue::add_sdu(uint32_t                              sn,
   sdus[sn].sdu->md.pdcp_sn = sn;
   sdus[sn].sdu->N_bytes    = sdu->N_bytes;
   memcpy(sdus[sn].sdu->msg, sdu->msg, sdu->N_bytes);
+  sdus[sn].discard_pending = discard_timeout > 0;
   if (discard_timeout > 0) {
-    sdus[sn].discard_timer.set(discard_timeout, std::move(callback));
-    sdus[sn].discard_timer.run();
+    sdus[sn].discard_deadline = discard_now() + discard_timeout;
+    push_discard(sn, sdus[sn].discard_deadline);
+    nof_pending_discards++;
+    if (not discard_timer.is_running()) {
+      arm_discard_timer();
+    }
   }
   sdus[sn].sdu->set_timestamp(); // Metrics
   bytes += sdu->N_bytes;
@@ -937,7 +960,11 @@ bool undelivered_sdus_queue::clear_sdu(uint32_t sn)
   }
   count--;
   bytes -= sdus[sn].sdu->N_bytes;
-  sdus[sn].discard_timer.stop();
+  if (sdus[sn].discard_pending) {
+    // The FIFO entry is left in place and skipped once it reaches the head
+    sdus[sn].discard_pending = false;
+    nof_pending_discards--;
+  }
   sdus[sn].sdu.reset();
   // Find next FMS, if necessary
   if (sn == fms) {
@@ -952,16 +979,84 @@ void undelivered_sdus_queue::clear()
   bytes = 0;
   fms   = 0;
   for (uint32_t sn = 0; sn < capacity; sn++) {
-    sdus[sn].discard_timer.stop();
+    sdus[sn].discard_pending = false;
     sdus[sn].sdu.reset();
   }
+  discard_clock = discard_now();
+  discard_timer.stop();
+  discard_fifo.clear();
+  nof_pending_discards = 0;
 }
 
-size_t undelivered_sdus_queue::nof_discard_timers() const
+/// Current time of the discard clock in ms. The clock only advances while the discard timer is running.
+uint32_t undelivered_sdus_queue::discard_now() const
 {
-  return std::count_if(sdus.begin(), sdus.end(), [](const sdu_data& s) {
-    return s.sdu != nullptr and s.discard_timer.is_valid() and s.discard_timer.is_running();
-  });
+  if (not discard_timer.is_running()) {
+    return discard_clock;
+  }
+  return discard_clock + std::max(discard_timer.time_elapsed(), discard_timer_offset) - discard_timer_offset;
+}
+
+void undelivered_sdus_queue::push_discard(uint32_t sn, uint32_t deadline)
+{
+  if (discard_fifo.full()) {
+    purge_stale_discards();
+  }
+  if (discard_fifo.full()) {
+    // Delivered SDUs left holes in the FIFO. Compact it in place, preserving the expiry order.
+    for (size_t i = 0, n = discard_fifo.size(); i < n; ++i) {
+      discard_entry e = discard_fifo.top();
+      discard_fifo.pop();
+      if (sdus[e.sn].discard_pending and has_sdu(e.sn) and sdus[e.sn].discard_deadline == e.deadline) {
+        discard_fifo.push(e);
+      }
+    }
+  }
+  discard_fifo.push(discard_entry{sn, deadline});
+}
+
+void undelivered_sdus_queue::purge_stale_discards()
+{
+  while (not discard_fifo.empty()) {
+    const discard_entry& e = discard_fifo.top();
+    if (sdus[e.sn].discard_pending and has_sdu(e.sn) and sdus[e.sn].discard_deadline == e.deadline) {
+      return;
+    }
+    discard_fifo.pop();
+  }
+}
+
+void undelivered_sdus_queue::arm_discard_timer()
+{
+  purge_stale_discards();
+  if (discard_fifo.empty()) {
+    return;
+  }
+  int32_t remaining = static_cast<int32_t>(discard_fifo.top().deadline - discard_now());
+  // When re-armed from its own expiry callback, the timer wheel has not yet advanced to the current tick
+  discard_timer_offset = in_discard_expiry ? 1 : 0;
+  discard_timer.set(std::max(remaining, 1) + discard_timer_offset);
+  discard_timer.run();
+}
+
+void undelivered_sdus_queue::handle_discard_timer_expiry()
+{
+  discard_clock += discard_timer.duration() - discard_timer_offset;
+  in_discard_expiry = true;
+
+  // Discard all SDUs whose discard time has elapsed
+  while (not discard_fifo.empty() and static_cast<int32_t>(discard_fifo.top().deadline - discard_clock) <= 0) {
+    discard_entry e = discard_fifo.top();
+    discard_fifo.pop();
+    if (sdus[e.sn].discard_pending and has_sdu(e.sn) and sdus[e.sn].discard_deadline == e.deadline) {
+      sdus[e.sn].discard_pending = false;
+      nof_pending_discards--;
+      discard_callback(e.sn);
+    }
+  }
+
+  arm_discard_timer();
+  in_discard_expiry = false;
 }
 
 void undelivered_sdus_queue::update_fms()
@@ -387,6 +387,24 @@ uint32_t srsran_refsignal_dmrs_N_rs(srsran_pucch_format_t format, srsran_cp_t cp
 }
 
 /* Table 5.5.2.2.2-1: Demodulation reference signal location for different PUCCH formats. 36.211 */
+/* Returns the complex argument of the m-th element of the Format 1/1a/1b DMRS orthogonal sequence n_oc, Table
+ * 5.5.2.2.1-2 */
+float srsran_refsignal_dmrs_pucch_format1_w_arg(uint32_t m, uint32_t n_oc, srsran_cp_t cp)
+{
+  if (n_oc < 3) {
+    if (SRSRAN_CP_ISNORM(cp)) {
+      if (m < 3) {
+        return w_arg_pucch_format1_cpnorm[n_oc][m];
+      }
+    } else {
+      if (m < 2) {
+        return w_arg_pucch_format1_cpext[n_oc][m];
+      }
+    }
+  }
+  return 0.0f;
+}
+
 uint32_t srsran_refsignal_dmrs_pucch_symbol(uint32_t m, srsran_pucch_format_t format, srsran_cp_t cp)
 {
   switch (format) {
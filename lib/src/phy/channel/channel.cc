@@ -43,20 +43,20 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
   // Copy args
   args = channel_args;
 
-  // Allocate internal buffers
-  buffer_in  = srsran_vec_cf_malloc(buffer_size);
-  buffer_out = srsran_vec_cf_malloc(buffer_size);
-  if (!buffer_out || !buffer_in) {
-    ret = SRSRAN_ERROR;
-  }
-
   nof_channels = _nof_channels;
   for (uint32_t i = 0; i < nof_channels; i++) {
+    // Allocate internal buffers, every antenna path has its own so that they can be filtered concurrently
+    buffer_in[i]  = srsran_vec_cf_malloc(buffer_size);
+    buffer_out[i] = srsran_vec_cf_malloc(buffer_size);
+    if (!buffer_out[i] || !buffer_in[i]) {
+      ret = SRSRAN_ERROR;
+    }
+
     // Create fading channel
     if (channel_args.fading_enable && !channel_args.fading_model.empty() && channel_args.fading_model != "none" &&
         ret == SRSRAN_SUCCESS) {
       fading[i] = (srsran_channel_fading_t*)calloc(sizeof(srsran_channel_fading_t), 1);
-      ret       = srsran_channel_fading_init(fading[i], srate_max, channel_args.fading_model.c_str(), 0x1234 * i);
+      ret       = fading_init(i, srate_max);
     } else {
       fading[i] = nullptr;
     }
@@ -94,6 +94,15 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
     srsran_channel_rlf_init(rlf, channel_args.rlf_t_on_ms, channel_args.rlf_t_off_ms);
   }
 
+  // Create fading threads for the antenna paths other than the first one
+  if (channel_args.fading_multithread && ret == SRSRAN_SUCCESS) {
+    for (uint32_t i = 1; i < nof_channels; i++) {
+      if (fading[i]) {
+        fading_threads.emplace_back(&channel::fading_worker, this, i);
+      }
+    }
+  }
+
   if (ret != SRSRAN_SUCCESS) {
     fprintf(stderr, "Error: Creating channel\n\n");
   }
@@ -101,12 +110,13 @@ channel::channel(const channel::args_t& channel_args, uint32_t _nof_channels, sr
 
 channel::~channel()
 {
-  if (buffer_in) {
-    free(buffer_in);
+  {
+    std::lock_guard<std::mutex> lock(fading_mutex);
+    fading_quit = true;
+    fading_cvar.notify_all();
   }
-
-  if (buffer_out) {
-    free(buffer_out);
+  for (std::thread& t : fading_threads) {
+    t.join();
   }
 
   if (awgn) {
@@ -134,6 +144,54 @@ channel::~channel()
       srsran_channel_delay_free(delay[i]);
       free(delay[i]);
     }
+
+    if (buffer_in[i]) {
+      free(buffer_in[i]);
+    }
+
+    if (buffer_out[i]) {
+      free(buffer_out[i]);
+    }
+  }
+}
+
+int channel::fading_init(uint32_t ch, uint32_t srate)
+{
+  int ret = srsran_channel_fading_init(fading[ch], srate, args.fading_model.c_str(), 0x1234 * ch);
+  if (args.fading_per_symbol) {
+    srsran_channel_fading_set_update_period(fading[ch], SRSRAN_CHANNEL_FADING_SYMBOL_PERIOD_S);
+  }
+  return ret;
+}
+
+void channel::fading_run(uint32_t ch, uint32_t len, double t)
+{
+  srsran_channel_fading_execute(fading[ch], buffer_in[ch], buffer_out[ch], len, t);
+  srsran_vec_cf_copy(buffer_in[ch], buffer_out[ch], len);
+}
+
+void channel::fading_worker(uint32_t ch)
+{
+  uint64_t                     job = 0;
+  std::unique_lock<std::mutex> lock(fading_mutex);
+  while (true) {
+    fading_cvar.wait(lock, [this, job]() { return fading_quit || fading_job != job; });
+    if (fading_quit) {
+      return;
+    }
+    job = fading_job;
+
+    if (fading_active[ch]) {
+      uint32_t len = fading_len;
+      double   t   = fading_time;
+      lock.unlock();
+      fading_run(ch, len, t);
+      lock.lock();
+    }
+
+    if (--fading_pending == 0) {
+      fading_done_cvar.notify_one();
+    }
   }
 }
 
@@ -157,7 +215,9 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
     return;
   }
 
-  // For each channel
+  // Channel stages before the fading, in the antenna path order so that the AWGN is generated in the same order
+  bool   process[SRSRAN_MAX_CHANNELS] = {};
+  double time                         = t.full_secs + t.frac_secs;
   for (uint32_t i = 0; i < nof_channels; i++) {
     // Skip iteration if any buffer is null
     if (in[i] == nullptr || out[i] == nullptr) {
@@ -171,37 +231,67 @@ void channel::run(cf_t*                     in[SRSRAN_MAX_CHANNELS],
       }
       continue;
     }
+    process[i] = true;
 
     // Copy input buffer
-    srsran_vec_cf_copy(buffer_in, in[i], len);
+    srsran_vec_cf_copy(buffer_in[i], in[i], len);
 
     if (hst) {
-      srsran_channel_hst_execute(hst, buffer_in, buffer_out, len, &t);
-      srsran_vec_sc_prod_ccc(buffer_out, local_cexpf(hst_init_phase), buffer_in, len);
+      srsran_channel_hst_execute(hst, buffer_in[i], buffer_out[i], len, &t);
+      srsran_vec_sc_prod_ccc(buffer_out[i], local_cexpf(hst_init_phase), buffer_in[i], len);
     }
 
     if (awgn) {
-      srsran_channel_awgn_run_c(awgn, buffer_in, buffer_out, len);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+      srsran_channel_awgn_run_c(awgn, buffer_in[i], buffer_out[i], len);
+      srsran_vec_cf_copy(buffer_in[i], buffer_out[i], len);
     }
+  }
 
-    if (fading[i]) {
-      srsran_channel_fading_execute(fading[i], buffer_in, buffer_out, len, t.full_secs + t.frac_secs);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+  // Fading, the most expensive stage, runs concurrently for every antenna path when there are fading threads
+  if (not fading_threads.empty()) {
+    std::unique_lock<std::mutex> lock(fading_mutex);
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      fading_active[i] = process[i] && fading[i] != nullptr;
+    }
+    fading_len     = len;
+    fading_time    = time;
+    fading_pending = (uint32_t)fading_threads.size();
+    fading_job++;
+    fading_cvar.notify_all();
+    lock.unlock();
+
+    if (fading_active[0]) {
+      fading_run(0, len, time);
+    }
+
+    lock.lock();
+    fading_done_cvar.wait(lock, [this]() { return fading_pending == 0; });
+  } else {
+    for (uint32_t i = 0; i < nof_channels; i++) {
+      if (process[i] && fading[i]) {
+        fading_run(i, len, time);
+      }
+    }
+  }
+
+  // Channel stages after the fading
+  for (uint32_t i = 0; i < nof_channels; i++) {
+    if (not process[i]) {
+      continue;
     }
 
     if (delay[i]) {
-      srsran_channel_delay_execute(delay[i], buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+      srsran_channel_delay_execute(delay[i], buffer_in[i], buffer_out[i], len, &t);
+      srsran_vec_cf_copy(buffer_in[i], buffer_out[i], len);
     }
 
     if (rlf) {
-      srsran_channel_rlf_execute(rlf, buffer_in, buffer_out, len, &t);
-      srsran_vec_cf_copy(buffer_in, buffer_out, len);
+      srsran_channel_rlf_execute(rlf, buffer_in[i], buffer_out[i], len, &t);
+      srsran_vec_cf_copy(buffer_in[i], buffer_out[i], len);
     }
 
     // Copy output buffer
-    srsran_vec_cf_copy(out[i], buffer_in, len);
+    srsran_vec_cf_copy(out[i], buffer_in[i], len);
   }
 
   if (hst) {
@@ -238,7 +328,7 @@ void channel::set_srate(uint32_t srate)
       if (fading[i]) {
         srsran_channel_fading_free(fading[i]);
 
-        srsran_channel_fading_init(fading[i], srate, args.fading_model.c_str(), 0x1234 * i);
+        fading_init(i, srate);
       }
 
       if (delay[i]) {
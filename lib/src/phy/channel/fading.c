@@ -21,6 +21,7 @@
 
 #include "srsran/phy/channel/fading.h"
 #include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 #include <math.h>
 #include <stdio.h>
@@ -107,27 +108,24 @@ static inline __m128 _cosine(float* table, __m128 arg)
 }
 #endif /*LV_HAVE_SSE*/
 
-static inline cf_t
-get_doppler_dispersion(srsran_channel_fading_t* q, float t, float F_d, float* alpha, float* a, float* b)
+static inline cf_t get_doppler_dispersion(srsran_channel_fading_t* q, float t, float* w, float* a, float* b)
 {
 #ifdef LV_HAVE_SSE
   const float recN   = 1.0f / sqrtf(SRSRAN_CHANNEL_FADING_NTERMS);
   cf_t        ret    = 0;
   __m128      _reacc = _mm_setzero_ps();
   __m128      _imacc = _mm_setzero_ps();
-  __m128      _arg   = _mm_set1_ps((float)M_PI * F_d);
   __m128      _t     = _mm_set1_ps(t);
-  __m128      _arg_  = (_mm_mul_ps(_arg, _t));
 
   for (int i = 0; i < SRSRAN_CHANNEL_FADING_NTERMS; i += 4) {
-    __m128 _alpha = _mm_loadu_ps(&alpha[i]);
-    __m128 _a     = _mm_loadu_ps(&a[i]);
-    __m128 _b     = _mm_loadu_ps(&b[i]);
-    __m128 _arg1  = _mm_mul_ps(_arg_, _cosine(q->sin_table, _alpha));
-    __m128 _re    = _cosine(q->sin_table, _mm_add_ps(_arg1, _a));
-    __m128 _im    = _sine(q->sin_table, _mm_add_ps(_arg1, _b));
-    _reacc        = _mm_add_ps(_reacc, _re);
-    _imacc        = _mm_add_ps(_imacc, _im);
+    __m128 _w    = _mm_loadu_ps(&w[i]);
+    __m128 _a    = _mm_loadu_ps(&a[i]);
+    __m128 _b    = _mm_loadu_ps(&b[i]);
+    __m128 _arg1 = _mm_mul_ps(_t, _w);
+    __m128 _re   = _cosine(q->sin_table, _mm_add_ps(_arg1, _a));
+    __m128 _im   = _sine(q->sin_table, _mm_add_ps(_arg1, _b));
+    _reacc       = _mm_add_ps(_reacc, _re);
+    _imacc       = _mm_add_ps(_imacc, _im);
   }
 
   __m128 _tmp = _mm_hadd_ps(_reacc, _imacc);
@@ -144,7 +142,7 @@ get_doppler_dispersion(srsran_channel_fading_t* q, float t, float F_d, float* al
   cf_t        r    = 0;
 
   for (uint32_t i = 0; i < SRSRAN_CHANNEL_FADING_NTERMS; i++) {
-    float arg = (float)M_PI * F_d * cosf(alpha[i]) * t;
+    float arg = w[i] * t;
     __real__ r += cosf(arg + a[i]);
     __imag__ r += sinf(arg + b[i]);
   }
@@ -162,26 +160,55 @@ static inline void generate_tap(float delay_ns, float power_db, float srate, cf_
   srsran_vec_gen_sine(a0, -O, buf, N);
 }
 
-static inline void generate_taps(srsran_channel_fading_t* q, float time)
+/*
+ * Computes the channel frequency response as the linear combination of the tap responses, h[k] = sum_i a[i] * h_tap[i][k],
+ * in a single pass so that the response is written once regardless the number of taps.
+ */
+static void combine_taps(cf_t* const* h_tap, const cf_t* a, uint32_t nof_taps, cf_t* h, uint32_t N)
 {
-  // Generate taps
-  for (int i = 0; i < nof_taps[q->model]; i++) {
-    // Compute phase for the doppler dispersion
-    cf_t a = get_doppler_dispersion(q, time, q->doppler, q->coeff_alpha[i], q->coeff_a[i], q->coeff_b[i]);
+  uint32_t k = 0;
+
+#if SRSRAN_SIMD_F_SIZE
+  simd_f_t a_re[SRSRAN_CHANNEL_FADING_MAXTAPS];
+  simd_f_t a_im[SRSRAN_CHANNEL_FADING_MAXTAPS];
+  for (uint32_t i = 0; i < nof_taps; i++) {
+    a_re[i] = srsran_simd_f_set1(__real__ a[i]);
+    a_im[i] = srsran_simd_f_set1(__imag__ a[i]);
+  }
 
-    if (i) {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(q->h_tap[i], a, q->temp, q->N);
+  // The tap responses and h are allocated aligned and k advances by a whole register
+  for (; k + SRSRAN_SIMD_F_SIZE / 2 <= N; k += SRSRAN_SIMD_F_SIZE / 2) {
+    simd_f_t acc_re = srsran_simd_f_zero();
+    simd_f_t acc_im = srsran_simd_f_zero();
+    for (uint32_t i = 0; i < nof_taps; i++) {
+      simd_f_t x = srsran_simd_f_load((float*)&h_tap[i][k]);
+      acc_re     = srsran_simd_f_add(acc_re, srsran_simd_f_mul(a_re[i], x));
+      acc_im     = srsran_simd_f_add(acc_im, srsran_simd_f_mul(a_im[i], srsran_simd_f_swap(x)));
+    }
+    srsran_simd_f_store((float*)&h[k], srsran_simd_f_addsub(acc_re, acc_im));
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
 
-      // Add to frequency response, shifts FFT at same time
-      srsran_vec_sum_ccc(q->h_freq, &q->temp[q->N / 2], q->h_freq, q->N / 2);
-      srsran_vec_sum_ccc(&q->h_freq[q->N / 2], q->temp, &q->h_freq[q->N / 2], q->N / 2);
-    } else {
-      // Copy tap frequency response
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][q->N / 2], a, q->h_freq, q->N / 2);
-      srsran_vec_sc_prod_ccc(&q->h_tap[i][0], a, &q->h_freq[q->N / 2], q->N / 2);
+  for (; k < N; k++) {
+    cf_t acc = 0;
+    for (uint32_t i = 0; i < nof_taps; i++) {
+      acc += a[i] * h_tap[i][k];
     }
+    h[k] = acc;
+  }
+}
+
+static inline void generate_taps(srsran_channel_fading_t* q, float time)
+{
+  cf_t a[SRSRAN_CHANNEL_FADING_MAXTAPS];
+
+  // Compute phase for the doppler dispersion of each tap
+  for (int i = 0; i < nof_taps[q->model]; i++) {
+    a[i] = get_doppler_dispersion(q, time, q->coeff_w[i], q->coeff_a[i], q->coeff_b[i]);
   }
+
+  // Add the tap frequency responses, which are already FFT shifted
+  combine_taps(q->h_tap, a, nof_taps[q->model], q->h_freq, q->N);
   // at this stage, q->h_freq should contain the frequency response
 }
 
@@ -242,16 +269,32 @@ int srsran_channel_fading_init(srsran_channel_fading_t* q, double srate, const c
         q->coeff_a[i][j]     = srsran_random_uniform_real_dist(random, 0, 2.0f * (float)M_PI);
         q->coeff_b[i][j]     = srsran_random_uniform_real_dist(random, 0, 2.0f * (float)M_PI);
         q->coeff_alpha[i][j] = ((float)M_PI * ((float)i - (float)0.5f)) / (2.0f * nof_taps[q->model]);
+        q->coeff_w[i][j]     = (float)M_PI * q->doppler * cosf(q->coeff_alpha[i][j]);
       }
 
       // Allocate tap frequency response
       q->h_tap[i] = srsran_vec_cf_malloc(q->N);
+      cf_t* tap   = srsran_vec_cf_malloc(q->N);
+      if (!q->h_tap[i] || !tap) {
+        fprintf(stderr, "Error: allocating h_tap\n");
+        free(tap);
+        srsran_random_free(random);
+        goto clean_exit;
+      }
 
-      // Generate tap frequency response
+      // Generate tap frequency response and store it FFT shifted
       generate_tap(
-          excess_tap_delay_ns[q->model][i], relative_power_db[q->model][i], q->srate, q->h_tap[i], q->N, q->path_delay);
+          excess_tap_delay_ns[q->model][i], relative_power_db[q->model][i], q->srate, tap, q->N, q->path_delay);
+      srsran_vec_cf_copy(q->h_tap[i], &tap[q->N / 2], q->N / 2);
+      srsran_vec_cf_copy(&q->h_tap[i][q->N / 2], tap, q->N / 2);
+      free(tap);
     }
 
+    // The response is generated for the first segment
+    q->update_period = 0.0f;
+    q->update_time   = 0.0;
+    q->h_valid       = false;
+
     // Generate sine Table
     for (uint32_t i = 0; i < 1024; i++) {
       q->sin_table[i] = sinf((float)i * 2.0f * (float)M_PI / 1024);
@@ -335,6 +378,13 @@ void srsran_channel_fading_free(srsran_channel_fading_t* q)
   }
 }
 
+void srsran_channel_fading_set_update_period(srsran_channel_fading_t* q, float period_s)
+{
+  if (q) {
+    q->update_period = SRSRAN_MAX(period_s, 0.0f);
+  }
+}
+
 double srsran_channel_fading_execute(srsran_channel_fading_t* q,
                                      const cf_t*              in,
                                      cf_t*                    out,
@@ -345,8 +395,12 @@ double srsran_channel_fading_execute(srsran_channel_fading_t* q,
 
   if (q) {
     while (counter < nsamples) {
-      // Generate taps
-      generate_taps(q, (float)init_time);
+      // Generate taps, unless the current response is recent enough
+      if (!q->h_valid || fabs(init_time - q->update_time) >= q->update_period) {
+        generate_taps(q, (float)init_time);
+        q->update_time = init_time;
+        q->h_valid     = true;
+      }
 
       // Do not process more than N/2 samples
       uint32_t n = SRSRAN_MIN(q->N / 2, nsamples - counter);
@@ -43,16 +43,22 @@ static uint32_t duration_ms     = 1000;
 static char*    model           = default_model;
 static uint32_t srate           = (uint32_t)30.72e6;
 static uint32_t random_seed     = 0x12345678; // Default seed, deterministic channel
+static bool     per_symbol      = false;
+static bool     benchmark       = false;
+
+static const char* benchmark_models[] = {"epa5", "eva70", "etu300"};
 
 #define INPUT_TYPE 0 /* 0: Dirac Delta; Otherwise: Random*/
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [mts]\n", prog);
+  printf("Usage: %s [mtsrpb]\n", prog);
   printf("\t-m Channel model: epa5, eva70, etu300 [Default %s]\n", model);
   printf("\t-t Simulation time in ms: [Default %d]\n", duration_ms);
   printf("\t-s Sampling rate in Hz: [Default %d]\n", srate);
   printf("\t-r Random generator seed: [Default %d]\n", random_seed);
+  printf("\t-p Update the fading response once per OFDM symbol: [Default %s]\n", per_symbol ? "enabled" : "disabled");
+  printf("\t-b Benchmark all channel models: [Default %s]\n", benchmark ? "enabled" : "disabled");
 #ifdef ENABLE_GUI
   printf("\t-g Enable GUI: [Default %s]\n", enable_gui ? "enabled" : "disabled");
 #endif /* ENABLE_GUI */
@@ -61,7 +67,7 @@ static void usage(char* prog)
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "mtsrg")) != -1) {
+  while ((opt = getopt(argc, argv, "mtsrpbg")) != -1) {
     switch (opt) {
       case 'm':
         model = argv[optind];
@@ -75,6 +81,12 @@ static int parse_args(int argc, char** argv)
       case 'r':
         random_seed = (uint32_t)strtol(argv[optind], NULL, 10);
         break;
+      case 'p':
+        per_symbol = (per_symbol) ? false : true;
+        break;
+      case 'b':
+        benchmark = (benchmark) ? false : true;
+        break;
       case 'g':
 #ifdef ENABLE_GUI
         enable_gui = (enable_gui) ? false : true;
@@ -88,6 +100,34 @@ static int parse_args(int argc, char** argv)
   return SRSRAN_SUCCESS;
 }
 
+/* Runs the given model over the input for the simulation time and returns the throughput in Msamples/s */
+static double run_benchmark(const char* bench_model, bool bench_per_symbol, cf_t* input, cf_t* output)
+{
+  srsran_channel_fading_t q         = {};
+  struct timeval          t[3]      = {};
+  uint64_t                time_usec = 0;
+
+  if (srsran_channel_fading_init(&q, srate, bench_model, random_seed)) {
+    fprintf(stderr, "Error: initialising fading channel. model=%s, srate=%d\n", bench_model, srate);
+    return -1.0;
+  }
+  if (bench_per_symbol) {
+    srsran_channel_fading_set_update_period(&q, SRSRAN_CHANNEL_FADING_SYMBOL_PERIOD_S);
+  }
+
+  for (int i = 0; i < duration_ms; i++) {
+    gettimeofday(&t[1], NULL);
+    srsran_channel_fading_execute(&q, input, output, srate / 1000, (double)i / 1000.0);
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    time_usec += (uint64_t)(t->tv_sec * 1e6 + t->tv_usec);
+  }
+
+  srsran_channel_fading_free(&q);
+
+  return (time_usec) ? duration_ms * (srate / 1000.0) / (double)time_usec : 0.0;
+}
+
 int main(int argc, char** argv)
 {
   int            ret           = SRSRAN_ERROR;
@@ -163,6 +203,9 @@ int main(int argc, char** argv)
     fprintf(stderr, "Error: initialising fading channel. model=%s, srate=%d\n", model, srate);
     goto clean_exit;
   }
+  if (per_symbol) {
+    srsran_channel_fading_set_update_period(&channel_fading, SRSRAN_CHANNEL_FADING_SYMBOL_PERIOD_S);
+  }
 
   // Allocate buffers
   input_buffer = srsran_vec_cf_malloc(srate / 1000);
@@ -187,10 +230,31 @@ int main(int argc, char** argv)
     goto clean_exit;
   }
 
+  if (benchmark) {
+    printf("-- Benchmarking Fading channel models. srate=%.2fMHz; duration=%dms\n", (double)srate / 1e6, duration_ms);
+    ret = SRSRAN_SUCCESS;
+    for (uint32_t m = 0; m < sizeof(benchmark_models) / sizeof(benchmark_models[0]); m++) {
+      double block_msps  = run_benchmark(benchmark_models[m], false, input_buffer, output_buffer);
+      double symbol_msps = run_benchmark(benchmark_models[m], true, input_buffer, output_buffer);
+      if (block_msps <= 0.0 || symbol_msps <= 0.0) {
+        ret = SRSRAN_ERROR;
+        continue;
+      }
+      printf("   model=%-6s; subframe update: %6.1f MSps; symbol update: %6.1f MSps\n",
+             benchmark_models[m],
+             block_msps,
+             symbol_msps);
+    }
+    goto clean_exit;
+  }
+
   printf("-- Starting Fading channel simulator. srate=%.2fMHz; model=%s; duration=%dms\n",
          (double)srate / 1e6,
          model,
          duration_ms);
+  if (per_symbol) {
+    printf("-- Fading response updated once per OFDM symbol\n");
+  }
 
   for (int i = 0; i < duration_ms; i++) {
     gettimeofday(&t[1], NULL);
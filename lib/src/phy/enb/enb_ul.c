@@ -151,6 +151,32 @@ int srsran_enb_ul_set_cell(srsran_enb_ul_t*                   q,
 void srsran_enb_ul_fft(srsran_enb_ul_t* q)
 {
   srsran_ofdm_rx_sf(&q->fft);
+
+  // The PUCCH cyclic shift bank belongs to the previous subframe
+  srsran_pucch_reset_joint(&q->pucch);
+}
+
+static int
+get_pucch_resource(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch_cfg_t* cfg, srsran_pucch_res_t* res)
+{
+  // Format 1/1a/1b UEs share the DFT of the PRB instead of estimating the channel one by one
+  if (cfg->joint_detection_en && cfg->format < SRSRAN_PUCCH_FORMAT_2) {
+    return srsran_pucch_decode_joint(&q->pucch, ul_sf, cfg, q->sf_symbols, res);
+  }
+
+  if (srsran_chest_ul_estimate_pucch(&q->chest, ul_sf, cfg, q->sf_symbols, &q->chest_res)) {
+    ERROR("Error estimating PUCCH DMRS");
+    return SRSRAN_ERROR;
+  }
+  res->snr_db    = q->chest_res.snr_db;
+  res->rssi_dbFs = q->chest_res.epre_dBfs;
+  res->ni_dbFs   = q->chest_res.noise_estimate_dbFs;
+  if (cfg->meas_ta_en) {
+    res->ta_valid = !(isnan(q->chest_res.ta_us) || isinf(q->chest_res.ta_us));
+    res->ta_us    = q->chest_res.ta_us;
+  }
+
+  return srsran_pucch_decode(&q->pucch, ul_sf, cfg, &q->chest_res, q->sf_symbols, res);
 }
 
 static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch_cfg_t* cfg, srsran_pucch_res_t* res)
@@ -188,16 +214,7 @@ static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch
     // Configure resource
     cfg->n_pucch = n_pucch_i[i];
 
-    // Prepare configuration
-    if (srsran_chest_ul_estimate_pucch(&q->chest, ul_sf, cfg, q->sf_symbols, &q->chest_res)) {
-      ERROR("Error estimating PUCCH DMRS");
-      return SRSRAN_ERROR;
-    }
-    pucch_res.snr_db    = q->chest_res.snr_db;
-    pucch_res.rssi_dbFs = q->chest_res.epre_dBfs;
-    pucch_res.ni_dbFs   = q->chest_res.noise_estimate_dbFs;
-
-    ret = srsran_pucch_decode(&q->pucch, ul_sf, cfg, &q->chest_res, q->sf_symbols, &pucch_res);
+    ret = get_pucch_resource(q, ul_sf, cfg, &pucch_res);
     if (ret < SRSRAN_SUCCESS) {
       ERROR("Error decoding PUCCH");
     } else {
@@ -216,12 +233,6 @@ static int get_pucch(srsran_enb_ul_t* q, srsran_ul_sf_cfg_t* ul_sf, srsran_pucch
 
       // Compares correlation value, it stores the PUCCH result with the greatest correlation
       if (i == 0 || pucch_res.correlation > res->correlation) {
-        // Copy measurements only if PUCCH was decoded successfully
-        if (cfg->meas_ta_en) {
-          pucch_res.ta_valid = !(isnan(q->chest_res.ta_us) || isinf(q->chest_res.ta_us));
-          pucch_res.ta_us    = q->chest_res.ta_us;
-        }
-
         *res = pucch_res;
       }
     }
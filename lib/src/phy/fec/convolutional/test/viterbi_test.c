@@ -36,6 +36,7 @@ static int      frame_length = 1000, nof_frames = 256;
 static float    ebno_db     = 100.0;
 static uint32_t seed        = 0;
 static bool     tail_biting = false;
+static bool     throughput  = false;
 
 #define SNR_POINTS 10
 #define SNR_MIN 0.0
@@ -49,12 +50,13 @@ void usage(char* prog)
   printf("\t-e ebno in dB [Default scan]\n");
   printf("\t-s seed [Default 0=time]\n");
   printf("\t-t tail_bitting [Default %s]\n", tail_biting ? "yes" : "no");
+  printf("\t-T measure the single and batch decoding throughput [Default %s]\n", throughput ? "yes" : "no");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nlste")) != -1) {
+  while ((opt = getopt(argc, argv, "nlsteT")) != -1) {
     switch (opt) {
       case 'n':
         nof_frames = (int)strtol(argv[optind], NULL, 10);
@@ -71,6 +73,9 @@ void parse_args(int argc, char** argv)
       case 't':
         tail_biting = true;
         break;
+      case 'T':
+        throughput = true;
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -97,6 +102,100 @@ void parse_args(int argc, char** argv)
     }                                                                                                                  \
   } while (0)
 
+/* Decodes batches of SRSRAN_VITERBI_MAX_BATCH frames one by one and at once, checks that both give the same bits and
+ * prints the throughput of each */
+static int viterbi_throughput(srsran_viterbi_t* dec, srsran_convcoder_t* cod, float var, int coded_length)
+{
+  int             ret                                     = SRSRAN_ERROR;
+  srsran_random_t random_gen                              = srsran_random_init(seed);
+  uint8_t*        data_tx                                 = srsran_vec_u8_malloc(frame_length);
+  uint8_t*        symbols                                 = srsran_vec_u8_malloc(coded_length);
+  float*          llr[SRSRAN_VITERBI_MAX_BATCH]           = {};
+  uint8_t*        data_rx[SRSRAN_VITERBI_MAX_BATCH]       = {};
+  uint8_t*        data_rx_batch[SRSRAN_VITERBI_MAX_BATCH] = {};
+  double          elapsed_us                              = 0;
+  double          elapsed_batch_us                        = 0;
+  int             nof_decoded                             = 0;
+
+  for (uint32_t cw = 0; cw < SRSRAN_VITERBI_MAX_BATCH; cw++) {
+    llr[cw]           = srsran_vec_f_malloc(coded_length);
+    data_rx[cw]       = srsran_vec_u8_malloc(frame_length);
+    data_rx_batch[cw] = srsran_vec_u8_malloc(frame_length);
+    if (!llr[cw] || !data_rx[cw] || !data_rx_batch[cw]) {
+      perror("malloc");
+      goto clean_exit;
+    }
+  }
+  if (!data_tx || !symbols) {
+    perror("malloc");
+    goto clean_exit;
+  }
+
+  while (nof_decoded < nof_frames) {
+    for (uint32_t cw = 0; cw < SRSRAN_VITERBI_MAX_BATCH; cw++) {
+      for (int j = 0; j < frame_length; j++) {
+        data_tx[j] = srsran_random_uniform_int_dist(random_gen, 0, 1);
+      }
+      srsran_convcoder_encode(cod, data_tx, symbols, frame_length);
+      for (int j = 0; j < coded_length; j++) {
+        llr[cw][j] = symbols[j] ? M_SQRT2 : -M_SQRT2;
+      }
+      srsran_ch_awgn_f(llr[cw], llr[cw], var, coded_length);
+    }
+
+    struct timeval t[3] = {};
+    gettimeofday(&t[1], NULL);
+    for (uint32_t cw = 0; cw < SRSRAN_VITERBI_MAX_BATCH; cw++) {
+      if (srsran_viterbi_decode_f(dec, llr[cw], data_rx[cw], frame_length) < SRSRAN_SUCCESS) {
+        ERROR("Error decoding");
+        goto clean_exit;
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_us += t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+    gettimeofday(&t[1], NULL);
+    if (srsran_viterbi_decode_f_batch(dec, llr, data_rx_batch, SRSRAN_VITERBI_MAX_BATCH, frame_length) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error decoding batch");
+      goto clean_exit;
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+    elapsed_batch_us += t[0].tv_sec * 1e6 + t[0].tv_usec;
+
+    for (uint32_t cw = 0; cw < SRSRAN_VITERBI_MAX_BATCH; cw++) {
+      if (memcmp(data_rx[cw], data_rx_batch[cw], frame_length) != 0) {
+        ERROR("Batch decoding does not match single decoding");
+        goto clean_exit;
+      }
+    }
+    nof_decoded += SRSRAN_VITERBI_MAX_BATCH;
+  }
+
+  printf("  single: %.1f us/frame, %.2f Mbps\n",
+         elapsed_us / nof_decoded,
+         (double)nof_decoded * frame_length / elapsed_us);
+  printf("  batch:  %.1f us/frame, %.2f Mbps (%d frames)\n",
+         elapsed_batch_us / nof_decoded,
+         (double)nof_decoded * frame_length / elapsed_batch_us,
+         SRSRAN_VITERBI_MAX_BATCH);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  for (uint32_t cw = 0; cw < SRSRAN_VITERBI_MAX_BATCH; cw++) {
+    free(llr[cw]);
+    free(data_rx[cw]);
+    free(data_rx_batch[cw]);
+  }
+  free(data_tx);
+  free(symbols);
+  srsran_random_free(random_gen);
+  return ret;
+}
+
 //#define TEST_SSE
 
 int main(int argc, char** argv)
@@ -120,6 +219,7 @@ int main(int argc, char** argv)
   srsran_viterbi_t   dec;
   srsran_convcoder_t cod;
   int                coded_length;
+  float              ebno_inc, esno_db;
 
   parse_args(argc, argv);
 
@@ -148,6 +248,13 @@ int main(int argc, char** argv)
     printf("  EbNo: %.2f\n", ebno_db);
   }
 
+  if (throughput) {
+    esno_db = ebno_db + srsran_convert_power_to_dB(1.0f / 3.0f);
+    int ret = viterbi_throughput(&dec, &cod, srsran_convert_dB_to_power(-esno_db), coded_length);
+    srsran_viterbi_free(&dec);
+    exit(ret);
+  }
+
   data_tx = srsran_vec_u8_malloc(frame_length);
   if (!data_tx) {
     perror("malloc");
@@ -186,7 +293,6 @@ int main(int argc, char** argv)
     exit(-1);
   }
 
-  float ebno_inc, esno_db;
   ebno_inc = (SNR_MAX - SNR_MIN) / SNR_POINTS;
   if (ebno_db == 100.0) {
     snr_points = SNR_POINTS;
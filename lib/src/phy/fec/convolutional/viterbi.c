@@ -217,6 +217,99 @@ void free37_avx2(void* o)
 
 #endif
 
+#ifdef LV_HAVE_AVX512
+int decode37_avx512(void* o, uint16_t* symbols, uint8_t* data, uint32_t frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  uint32_t best_state;
+
+  if (frame_length > q->framebits) {
+    fprintf(stderr, "Initialized decoder for max frame length %d bits\n", q->framebits);
+    return -1;
+  }
+
+  /* Initialize Viterbi decoder */
+  init_viterbi37_avx512(q->ptr, q->tail_biting ? -1 : 0);
+
+  /* Decode block */
+  if (q->tail_biting) {
+    for (int i = 0; i < TB_ITER; i++) {
+      memcpy(&q->tmp_s[i * 3 * frame_length], symbols, 3 * frame_length * sizeof(uint16_t));
+    }
+    update_viterbi37_blk_avx512(q->ptr, q->tmp_s, TB_ITER * frame_length, &best_state);
+    /* Only the bits of the middle repetition are traced back */
+    chainback_viterbi37_avx512_batch(
+        q->ptr, &q->tmp, 1, TB_ITER * frame_length, ((int)(TB_ITER / 2)) * frame_length, &best_state);
+    memcpy(data, &q->tmp[((int)(TB_ITER / 2)) * frame_length], frame_length * sizeof(uint8_t));
+  } else {
+    update_viterbi37_blk_avx512(q->ptr, symbols, frame_length + q->K - 1, NULL);
+    chainback_viterbi37_avx512(q->ptr, data, frame_length, 0);
+  }
+
+  return q->framebits;
+}
+
+int decode37_avx512_batch(void* o, uint16_t** symbols, uint8_t** data, uint32_t nof_cw, uint32_t frame_length)
+{
+  srsran_viterbi_t* q = o;
+
+  uint16_t* syms[SRSRAN_VITERBI_MAX_BATCH];
+  uint8_t*  tmp[SRSRAN_VITERBI_MAX_BATCH];
+  uint32_t  state[SRSRAN_VITERBI_MAX_BATCH] = {};
+  uint32_t  stride                          = TB_ITER * 3 * (q->framebits + q->K - 1);
+
+  if (frame_length > q->framebits || nof_cw > SRSRAN_VITERBI_MAX_BATCH) {
+    fprintf(stderr, "Initialized decoder for max frame length %d bits\n", q->framebits);
+    return -1;
+  }
+
+  /* Initialize Viterbi decoder */
+  init_viterbi37_avx512(q->ptr, q->tail_biting ? -1 : 0);
+
+  /* Decode blocks */
+  if (q->tail_biting) {
+    for (uint32_t cw = 0; cw < nof_cw; cw++) {
+      syms[cw] = &q->tmp_s[cw * stride];
+      tmp[cw]  = &q->tmp[cw * stride];
+      for (int i = 0; i < TB_ITER; i++) {
+        memcpy(&syms[cw][i * 3 * frame_length], symbols[cw], 3 * frame_length * sizeof(uint16_t));
+      }
+    }
+    update_viterbi37_blk_avx512_batch(q->ptr, syms, nof_cw, TB_ITER * frame_length, state);
+    chainback_viterbi37_avx512_batch(
+        q->ptr, tmp, nof_cw, TB_ITER * frame_length, ((int)(TB_ITER / 2)) * frame_length, state);
+    for (uint32_t cw = 0; cw < nof_cw; cw++) {
+      memcpy(data[cw], &tmp[cw][((int)(TB_ITER / 2)) * frame_length], frame_length * sizeof(uint8_t));
+    }
+  } else {
+    update_viterbi37_blk_avx512_batch(q->ptr, symbols, nof_cw, frame_length + q->K - 1, NULL);
+    chainback_viterbi37_avx512_batch(q->ptr, data, nof_cw, frame_length, 0, state);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+void free37_avx512(void* o)
+{
+  srsran_viterbi_t* q = o;
+
+  if (q->symbols_uc) {
+    free(q->symbols_uc);
+  }
+  if (q->symbols_us) {
+    free(q->symbols_us);
+  }
+  if (q->tmp) {
+    free(q->tmp);
+  }
+  if (q->tmp_s) {
+    free(q->tmp_s);
+  }
+  delete_viterbi37_avx512(q->ptr);
+}
+#endif
+
 #ifdef HAVE_NEON
 int decode37_neon(void* o, uint8_t* symbols, uint8_t* data, uint32_t frame_length)
 {
@@ -471,6 +564,51 @@ int init37_avx2_16bit(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool
 
 #endif
 
+#ifdef LV_HAVE_AVX512
+int init37_avx512(srsran_viterbi_t* q, int poly[3], uint32_t framebits, bool tail_biting)
+{
+  q->K              = 7;
+  q->R              = 3;
+  q->framebits      = framebits;
+  q->gain_quant_s   = 4;
+  q->gain_quant     = DEFAULT_GAIN_16;
+  q->tail_biting    = tail_biting;
+  q->decode_s       = decode37_avx512;
+  q->decode_s_batch = decode37_avx512_batch;
+  q->free           = free37_avx512;
+  q->decode_f       = NULL;
+
+  /* Every codeword of a batch has its own buffers */
+  uint32_t len  = 3 * (q->framebits + q->K - 1);
+  q->symbols_uc = srsran_vec_u8_malloc(len);
+  q->symbols_us = srsran_vec_u16_malloc(SRSRAN_VITERBI_MAX_BATCH * len);
+  if (!q->symbols_uc || !q->symbols_us) {
+    perror("malloc");
+    free37_avx512(q);
+    return -1;
+  }
+  if (q->tail_biting) {
+    q->tmp   = srsran_vec_u8_malloc(SRSRAN_VITERBI_MAX_BATCH * TB_ITER * len);
+    q->tmp_s = srsran_vec_u16_malloc(SRSRAN_VITERBI_MAX_BATCH * TB_ITER * len);
+    if (!q->tmp || !q->tmp_s) {
+      perror("malloc");
+      free37_avx512(q);
+      return -1;
+    }
+  } else {
+    q->tmp = NULL;
+  }
+
+  if ((q->ptr = create_viterbi37_avx512(poly, TB_ITER * framebits)) == NULL) {
+    ERROR("create_viterbi37 failed");
+    free37_avx512(q);
+    return -1;
+  } else {
+    return 0;
+  }
+}
+#endif
+
 void srsran_viterbi_set_gain_quant(srsran_viterbi_t* q, float gain_quant)
 {
   q->gain_quant = gain_quant;
@@ -492,7 +630,9 @@ int srsran_viterbi_init(srsran_viterbi_t*     q,
     case SRSRAN_VITERBI_37:
 #ifdef LV_HAVE_SSE
 
-#ifdef LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+      return init37_avx512(q, poly, max_frame_length, tail_bitting);
+#elif defined(LV_HAVE_AVX2)
 #ifdef VITERBI_16
       return init37_avx2_16bit(q, poly, max_frame_length, tail_bitting);
 #else
@@ -536,6 +676,18 @@ int srsran_viterbi_init_avx2(srsran_viterbi_t*     q,
 }
 #endif
 
+#ifdef LV_HAVE_AVX512
+int srsran_viterbi_init_avx512(srsran_viterbi_t*     q,
+                               srsran_viterbi_type_t type,
+                               int                   poly[3],
+                               uint32_t              max_frame_length,
+                               bool                  tail_bitting)
+{
+  bzero(q, sizeof(srsran_viterbi_t));
+  return init37_avx512(q, poly, max_frame_length, tail_bitting);
+}
+#endif
+
 void srsran_viterbi_free(srsran_viterbi_t* q)
 {
   if (q->free) {
@@ -625,3 +777,65 @@ int srsran_viterbi_decode_uc(srsran_viterbi_t* q, uint8_t* symbols, uint8_t* dat
 
   return ret;
 }
+
+int srsran_viterbi_decode_us_batch(srsran_viterbi_t* q,
+                                   uint16_t*         symbols[SRSRAN_VITERBI_MAX_BATCH],
+                                   uint8_t*          data[SRSRAN_VITERBI_MAX_BATCH],
+                                   uint32_t          nof_cw,
+                                   uint32_t          frame_length)
+{
+  if (q == NULL || symbols == NULL || data == NULL || nof_cw > SRSRAN_VITERBI_MAX_BATCH) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (q->decode_s_batch) {
+    return q->decode_s_batch(q, symbols, data, nof_cw, frame_length);
+  }
+
+  for (uint32_t cw = 0; cw < nof_cw; cw++) {
+    if (srsran_viterbi_decode_us(q, symbols[cw], data[cw], frame_length) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_viterbi_decode_f_batch(srsran_viterbi_t* q,
+                                  float*            symbols[SRSRAN_VITERBI_MAX_BATCH],
+                                  uint8_t*          data[SRSRAN_VITERBI_MAX_BATCH],
+                                  uint32_t          nof_cw,
+                                  uint32_t          frame_length)
+{
+  if (q == NULL || symbols == NULL || data == NULL || nof_cw > SRSRAN_VITERBI_MAX_BATCH) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+  if (frame_length > q->framebits) {
+    ERROR("Initialized decoder for max frame length %d bits", q->framebits);
+    return SRSRAN_ERROR;
+  }
+
+  // Decode one after the other if the implementation does not support batches
+  if (!q->decode_s_batch) {
+    for (uint32_t cw = 0; cw < nof_cw; cw++) {
+      if (srsran_viterbi_decode_f(q, symbols[cw], data[cw], frame_length) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  uint32_t  len = q->tail_biting ? 3 * frame_length : 3 * (frame_length + q->K - 1);
+  uint16_t* symbols_us[SRSRAN_VITERBI_MAX_BATCH];
+  for (uint32_t cw = 0; cw < nof_cw; cw++) {
+    float    max   = 1e-9;
+    uint32_t max_i = srsran_vec_max_abs_fi(symbols[cw], len);
+    if (max_i < len && isnormal(symbols[cw][max_i])) {
+      max = fabsf(symbols[cw][max_i]);
+    }
+    symbols_us[cw] = &q->symbols_us[cw * 3 * (q->framebits + q->K - 1)];
+    srsran_vec_quant_fus(symbols[cw], symbols_us[cw], q->gain_quant / max, 32767.5, 65535, len);
+  }
+
+  return q->decode_s_batch(q, symbols_us, data, nof_cw, frame_length);
+}
@@ -82,4 +82,23 @@ void delete_viterbi37_avx2_16bit(void* p);
 
 int update_viterbi37_blk_avx2_16bit(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state);
 
+void* create_viterbi37_avx512(int polys[3], uint32_t len);
+
+int init_viterbi37_avx512(void* p, int starting_state);
+
+int chainback_viterbi37_avx512(void* p, uint8_t* data, uint32_t nbits, uint32_t endstate);
+
+int chainback_viterbi37_avx512_batch(void*     p,
+                                     uint8_t** data,
+                                     uint32_t  nof_cw,
+                                     uint32_t  nbits,
+                                     uint32_t  first,
+                                     uint32_t* endstate);
+
+void delete_viterbi37_avx512(void* p);
+
+int update_viterbi37_blk_avx512(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state);
+
+int update_viterbi37_blk_avx512_batch(void* p, uint16_t** syms, uint32_t nof_cw, uint32_t nbits, uint32_t* best_state);
+
 #endif /* SRSRAN_VITERBI37_H_ */
@@ -78,11 +78,11 @@ int init_viterbi37_avx2(void* p, int starting_state)
   uint32_t    i;
   firstGo = 1;
 
+  clear_v37_avx2(vp);
+
   for (i = 0; i < 64; i++)
     vp->metrics1.c[i] = 63;
 
-  clear_v37_avx2(vp);
-
   vp->old_metrics = &vp->metrics1;
   vp->new_metrics = &vp->metrics2;
   vp->dp          = vp->decisions;
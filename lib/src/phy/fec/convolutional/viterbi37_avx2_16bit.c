@@ -80,10 +80,11 @@ int init_viterbi37_avx2_16bit(void* p, int starting_state)
   struct v37* vp = p;
   uint32_t    i;
 
+  clear_v37_avx2_16bit(vp);
+
   for (i = 0; i < 64; i++)
     vp->metrics1.c[i] = 63;
 
-  clear_v37_avx2_16bit(vp);
   vp->old_metrics = &vp->metrics1;
   vp->new_metrics = &vp->metrics2;
   vp->dp          = vp->decisions;
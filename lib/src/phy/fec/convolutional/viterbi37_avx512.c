@@ -0,0 +1,277 @@
+/* Adapted Phil Karn's r=1/3 k=9 viterbi decoder to r=1/3 k=7
+ *
+ * K=15 r=1/6 Viterbi decoder for x86 SSE2
+ * Copyright Mar 2004, Phil Karn, KA9Q
+ * May be used under the terms of the GNU Lesser General Public License (LGPL)
+ *
+ * AVX512 version with 16-bit metrics. The 64 path metrics of a codeword fit in two registers, so all the butterflies
+ * of a bit are computed at once. Up to SRSRAN_VITERBI_MAX_BATCH codewords of the same length are decoded in lockstep
+ * to hide the latency of the add-compare-select recursion.
+ */
+
+#include "parity.h"
+#include "srsran/phy/fec/convolutional/viterbi.h"
+#include "viterbi37.h"
+#include <limits.h>
+#include <memory.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef LV_HAVE_AVX512
+
+#include <immintrin.h>
+
+typedef union {
+  unsigned short c[64];
+  __m512i        v[2];
+} metric_t;
+
+/* Decisions of a bit: the bit j of the lower half is the decision of state 2j and the bit j of the upper half is the
+ * decision of state 2j+1 */
+typedef uint64_t decision_t;
+
+static union {
+  unsigned short c[32];
+  __m512i        v;
+} Branchtab37_avx512[3];
+
+/* Interleaves the survivors of the even and odd states back to the natural state order */
+static const unsigned short interleave_idx[2][32] __attribute__((aligned(64))) = {
+    {0, 32, 1, 33, 2, 34, 3, 35, 4, 36, 5, 37, 6, 38, 7, 39,
+     8, 40, 9, 41, 10, 42, 11, 43, 12, 44, 13, 45, 14, 46, 15, 47},
+    {16, 48, 17, 49, 18, 50, 19, 51, 20, 52, 21, 53, 22, 54, 23, 55,
+     24, 56, 25, 57, 26, 58, 27, 59, 28, 60, 29, 61, 30, 62, 31, 63}};
+
+/* State info for instance of Viterbi decoder */
+struct v37 {
+  metric_t    metrics[SRSRAN_VITERBI_MAX_BATCH];   /* path metrics of every codeword */
+  decision_t* decisions[SRSRAN_VITERBI_MAX_BATCH]; /* Beginning of decisions for block of every codeword */
+  decision_t* dp[SRSRAN_VITERBI_MAX_BATCH];        /* Pointer to current decision of every codeword */
+  uint32_t    len;
+};
+
+static void set_viterbi37_polynomial_avx512(int polys[3])
+{
+  int state;
+  for (state = 0; state < 32; state++) {
+    Branchtab37_avx512[0].c[state] = (polys[0] < 0) ^ parity((2 * state) & polys[0]) ? 65535 : 0;
+    Branchtab37_avx512[1].c[state] = (polys[1] < 0) ^ parity((2 * state) & polys[1]) ? 65535 : 0;
+    Branchtab37_avx512[2].c[state] = (polys[2] < 0) ^ parity((2 * state) & polys[2]) ? 65535 : 0;
+  }
+}
+
+/* Initialize Viterbi decoder for start of new frame */
+int init_viterbi37_avx512(void* p, int starting_state)
+{
+  struct v37* vp = p;
+
+  if (p == NULL)
+    return -1;
+
+  for (uint32_t cw = 0; cw < SRSRAN_VITERBI_MAX_BATCH; cw++) {
+    for (uint32_t i = 0; i < 64; i++)
+      vp->metrics[cw].c[i] = 63;
+
+    if (starting_state != -1) {
+      vp->metrics[cw].c[starting_state & 63] = 0; /* Bias known start state */
+    }
+    vp->dp[cw] = vp->decisions[cw];
+  }
+  return 0;
+}
+
+/* Create a new instance of a Viterbi decoder */
+void* create_viterbi37_avx512(int polys[3], uint32_t len)
+{
+  void*       p;
+  struct v37* vp;
+
+  set_viterbi37_polynomial_avx512(polys);
+
+  if (posix_memalign(&p, sizeof(__m512i), sizeof(struct v37)))
+    return NULL;
+
+  vp = (struct v37*)p;
+
+  /* Every codeword has room for the tail and for the 6 cleared decisions read by the chainback past the block */
+  vp->len = len + 12;
+  if (posix_memalign(&p, sizeof(__m512i), SRSRAN_VITERBI_MAX_BATCH * vp->len * sizeof(decision_t))) {
+    free(vp);
+    return NULL;
+  }
+  for (uint32_t cw = 0; cw < SRSRAN_VITERBI_MAX_BATCH; cw++) {
+    vp->decisions[cw] = (decision_t*)p + cw * vp->len;
+  }
+  init_viterbi37_avx512(vp, 0);
+  return vp;
+}
+
+/* Viterbi chainback of several codewords at once. The chainback stops at the bit first, the data bits before it are
+ * not written */
+int chainback_viterbi37_avx512_batch(void*     p,
+                                     uint8_t** data,     /* Decoded output data of every codeword */
+                                     uint32_t  nof_cw,   /* Number of codewords */
+                                     uint32_t  nbits,    /* Number of data bits */
+                                     uint32_t  first,    /* First data bit to decode */
+                                     uint32_t* endstate) /* Terminal encoder state of every codeword */
+{
+  struct v37* vp = p;
+  uint32_t    state[SRSRAN_VITERBI_MAX_BATCH];
+
+  if (p == NULL || nof_cw > SRSRAN_VITERBI_MAX_BATCH)
+    return -1;
+
+  for (uint32_t cw = 0; cw < nof_cw; cw++) {
+    state[cw] = endstate[cw] % 64;
+  }
+
+  /* The independent chains of all the codewords are interleaved, the latency of each one is hidden by the others */
+  while (nbits-- > first) {
+    for (uint32_t cw = 0; cw < nof_cw; cw++) {
+      /* Look past tail */
+      decision_t d = vp->decisions[cw][nbits + 6];
+      uint32_t   k = (d >> ((state[cw] & 1) * 32 + (state[cw] >> 1))) & 1;
+
+      state[cw]       = (state[cw] >> 1) | (k << 5);
+      data[cw][nbits] = k;
+    }
+  }
+  return 0;
+}
+
+/* Viterbi chainback */
+int chainback_viterbi37_avx512(void*    p,
+                               uint8_t* data,  /* Decoded output data */
+                               uint32_t nbits, /* Number of data bits */
+                               uint32_t endstate)
+{ /* Terminal encoder state */
+  return chainback_viterbi37_avx512_batch(p, &data, 1, nbits, 0, &endstate);
+}
+
+/* Delete instance of a Viterbi decoder */
+void delete_viterbi37_avx512(void* p)
+{
+  struct v37* vp = p;
+
+  if (vp != NULL) {
+    free(vp->decisions[0]);
+    free(vp);
+  }
+}
+
+/* Decodes nbits of nof_cw codewords. It is always inlined with a constant number of codewords so the path metrics of
+ * all of them stay in registers. */
+static inline __attribute__((always_inline)) void
+update_viterbi37_avx512_cw(struct v37* vp, uint16_t** syms, uint32_t nof_cw, uint32_t nbits)
+{
+  __m512i m_lo[SRSRAN_VITERBI_MAX_BATCH];
+  __m512i m_hi[SRSRAN_VITERBI_MAX_BATCH];
+
+  const __m512i branch0 = Branchtab37_avx512[0].v;
+  const __m512i branch1 = Branchtab37_avx512[1].v;
+  const __m512i branch2 = Branchtab37_avx512[2].v;
+  const __m512i idx_lo  = _mm512_load_si512(interleave_idx[0]);
+  const __m512i idx_hi  = _mm512_load_si512(interleave_idx[1]);
+  const __m512i max_bm  = _mm512_set1_epi16(8191);
+  const __m512i zero    = _mm512_setzero_si512();
+
+  for (uint32_t cw = 0; cw < nof_cw; cw++) {
+    m_lo[cw] = vp->metrics[cw].v[0];
+    m_hi[cw] = vp->metrics[cw].v[1];
+  }
+
+  for (uint32_t n = 0; n < nbits; n++) {
+    for (uint32_t cw = 0; cw < nof_cw; cw++) {
+      const uint16_t* s = &syms[cw][3 * n];
+
+      /* Form branch metrics */
+      __m512i metric = _mm512_avg_epu16(_mm512_xor_si512(branch0, _mm512_set1_epi16(s[0])),
+                                        _mm512_xor_si512(branch1, _mm512_set1_epi16(s[1])));
+      metric         = _mm512_avg_epu16(_mm512_xor_si512(branch2, _mm512_set1_epi16(s[2])), metric);
+      metric         = _mm512_srli_epi16(metric, 3);
+
+      __m512i m_metric = _mm512_sub_epi16(max_bm, metric);
+
+      /* Add branch metrics to path metrics */
+      __m512i m0 = _mm512_add_epi16(m_lo[cw], metric);
+      __m512i m1 = _mm512_add_epi16(m_hi[cw], m_metric);
+      __m512i m2 = _mm512_add_epi16(m_lo[cw], m_metric);
+      __m512i m3 = _mm512_add_epi16(m_hi[cw], metric);
+
+      /* Compare and select, using modulo arithmetic */
+      __mmask32 decision0 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m0, m1), zero);
+      __mmask32 decision1 = _mm512_cmpgt_epi16_mask(_mm512_sub_epi16(m2, m3), zero);
+      __m512i   survivor0 = _mm512_mask_blend_epi16(decision0, m0, m1);
+      __m512i   survivor1 = _mm512_mask_blend_epi16(decision1, m2, m3);
+
+      vp->dp[cw][n] = (decision_t)decision0 | ((decision_t)decision1 << 32U);
+
+      /* Store surviving metrics */
+      m_lo[cw] = _mm512_permutex2var_epi16(survivor0, idx_lo, survivor1);
+      m_hi[cw] = _mm512_permutex2var_epi16(survivor0, idx_hi, survivor1);
+    }
+  }
+
+  for (uint32_t cw = 0; cw < nof_cw; cw++) {
+    vp->metrics[cw].v[0] = m_lo[cw];
+    vp->metrics[cw].v[1] = m_hi[cw];
+  }
+}
+
+int update_viterbi37_blk_avx512_batch(void*     p,
+                                      uint16_t** syms,
+                                      uint32_t   nof_cw,
+                                      uint32_t   nbits,
+                                      uint32_t*  best_state)
+{
+  struct v37* vp = p;
+
+  if (p == NULL || nof_cw == 0 || nof_cw > SRSRAN_VITERBI_MAX_BATCH)
+    return -1;
+
+  switch (nof_cw) {
+    case 1:
+      update_viterbi37_avx512_cw(vp, syms, 1, nbits);
+      break;
+    case 2:
+      update_viterbi37_avx512_cw(vp, syms, 2, nbits);
+      break;
+    case 3:
+      update_viterbi37_avx512_cw(vp, syms, 3, nbits);
+      break;
+    default:
+      update_viterbi37_avx512_cw(vp, syms, SRSRAN_VITERBI_MAX_BATCH, nbits);
+      break;
+  }
+
+  for (uint32_t cw = 0; cw < nof_cw; cw++) {
+    vp->dp[cw] += nbits;
+
+    /* The chainback always looks 6 decisions past the end of the block */
+    memset(vp->dp[cw], 0, 6 * sizeof(decision_t));
+
+    /* The metrics are never normalized, they wrap around and are compared relative to the metric of state 0 */
+    if (best_state) {
+      uint32_t i, bst = 0;
+
+      int16_t minmetric = INT16_MAX;
+      for (i = 0; i < 64; i++) {
+        int16_t metric = (int16_t)(vp->metrics[cw].c[i] - vp->metrics[cw].c[0]);
+        if (metric <= minmetric) {
+          bst       = i;
+          minmetric = metric;
+        }
+      }
+      best_state[cw] = bst;
+    }
+  }
+  return 0;
+}
+
+int update_viterbi37_blk_avx512(void* p, uint16_t* syms, uint32_t nbits, uint32_t* best_state)
+{
+  return update_viterbi37_blk_avx512_batch(p, &syms, 1, nbits, best_state);
+}
+
+#endif
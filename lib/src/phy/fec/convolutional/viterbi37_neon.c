@@ -73,10 +73,12 @@ int init_viterbi37_neon(void* p, int starting_state)
 {
   struct v37* vp = p;
   uint32_t    i;
+
+  clear_v37_neon(vp);
+
   for (i = 0; i < 64; i++)
     vp->metrics1.c[i] = 63;
 
-  clear_v37_neon(vp);
   for (int i = 0; i < 8; i++)
     xr[i] = i - 7;
 
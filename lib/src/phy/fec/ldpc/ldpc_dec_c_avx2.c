@@ -392,12 +392,8 @@ int extract_ldpc_message_c_avx2(void* p, uint8_t* message, uint16_t liftK)
 
   struct ldpc_regs_c_avx2* vp = p;
 
-  int j = 0;
-
   for (int i = 0; i < liftK / vp->ls; i++) {
-    for (j = 0; j < vp->ls; j++) {
-      message[i * vp->ls + j] = (vp->soft_bits.c[i * SRSRAN_AVX2_B_SIZE + j] < 0);
-    }
+    fec_avx2_hard_decision_c(&vp->soft_bits.c[i * SRSRAN_AVX2_B_SIZE], &message[i * vp->ls], vp->ls);
   }
 
   return 0;
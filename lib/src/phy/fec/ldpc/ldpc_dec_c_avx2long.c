@@ -459,15 +459,9 @@ int extract_ldpc_message_c_avx2long(void* p, uint8_t* message, uint16_t liftK)
 
   struct ldpc_regs_c_avx2long* vp = p;
 
-  int j = 0;
-  int k = 0;
-
+  // The sub-nodes of a variable node are contiguous in memory
   for (int i = 0; i < liftK / vp->ls; i++) {
-    for (j = 0; j < vp->n_subnodes; j++) {
-      for (k = 0; (k < SRSRAN_AVX2_B_SIZE) && (j * SRSRAN_AVX2_B_SIZE + k < vp->ls); k++) {
-        message[i * vp->ls + j * SRSRAN_AVX2_B_SIZE + k] = (vp->soft_bits[i * vp->n_subnodes + j].c[k] < 0);
-      }
-    }
+    fec_avx2_hard_decision_c(vp->soft_bits[i * vp->n_subnodes].c, &message[i * vp->ls], vp->ls);
   }
 
   return 0;
@@ -41,6 +41,44 @@
 
 #define LDPC_DECODER_DEFAULT_MAX_NOF_ITER 10 /*!< \brief Default maximum number of iterations of the BP algorithm. */
 
+/*!
+ * Checks whether the hard decisions stored in q->hard_bits satisfy the parity checks of the first n_layers layers.
+ * Lifted check node j of a layer combines, for every connected variable node v, the bit (j + shift) % ls of v, which
+ * is computed as two contiguous XOR segments per variable node.
+ */
+static bool ldpc_decoder_syndrome_check(srsran_ldpc_decoder_t* q, uint8_t n_layers)
+{
+  uint16_t ls       = q->ls;
+  uint8_t* syndrome = q->hard_bits + q->liftN;
+
+  for (uint32_t i_layer = 0; i_layer < n_layers; i_layer++) {
+    const uint16_t* this_pcm          = q->pcm + i_layer * q->bgN;
+    const int8_t*   these_var_indices = q->var_indices[i_layer];
+
+    const uint8_t* first = q->hard_bits + these_var_indices[0] * ls;
+    uint16_t       shift = this_pcm[these_var_indices[0]];
+    srsran_vec_u8_copy(syndrome, first + shift, ls - shift);
+    srsran_vec_u8_copy(syndrome + ls - shift, first, shift);
+
+    for (uint32_t i = 1; i < MAX_CNCT && these_var_indices[i] != -1; i++) {
+      const uint8_t* bits = q->hard_bits + these_var_indices[i] * ls;
+      shift               = this_pcm[these_var_indices[i]];
+      srsran_vec_xor_bbb(syndrome, bits + shift, syndrome, ls - shift);
+      srsran_vec_xor_bbb(syndrome + ls - shift, bits, syndrome + ls - shift, shift);
+    }
+
+    uint8_t unsatisfied = 0;
+    for (uint32_t j = 0; j < ls; j++) {
+      unsatisfied |= syndrome[j];
+    }
+    if (unsatisfied) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 #define LDPC_DECODER_TEMPLATE(LLR_TYPE, SUFFIX)                                                                        \
   static int decode_##SUFFIX(                                                                                          \
       void* o, const LLR_TYPE* llrs, uint8_t* message, uint32_t cdwd_rm_length, srsran_crc_t* crc)                     \
@@ -84,7 +122,19 @@
         update_ldpc_soft_bits_##SUFFIX(q->ptr, i_layer, these_var_indices);                                            \
       }                                                                                                                \
                                                                                                                        \
-      if (crc != NULL) {                                                                                               \
+      if (q->hard_bits != NULL) {                                                                                      \
+        extract_ldpc_message_##SUFFIX(q->ptr, q->hard_bits, (q->bgK + n_layers) * q->ls);                              \
+        srsran_vec_u8_copy(message, q->hard_bits, q->liftK);                                                           \
+                                                                                                                       \
+        if (crc != NULL && srsran_crc_match(crc, message, q->liftK - crc->order)) {                                    \
+          return i_iteration + 1;                                                                                      \
+        }                                                                                                              \
+                                                                                                                       \
+        /* A valid codeword that fails the CRC will not be corrected by further iterations */                          \
+        if (ldpc_decoder_syndrome_check(q, n_layers)) {                                                                \
+          return (crc != NULL) ? 0 : i_iteration + 1;                                                                  \
+        }                                                                                                              \
+      } else if (crc != NULL) {                                                                                        \
         extract_ldpc_message_##SUFFIX(q->ptr, message, q->liftK);                                                      \
                                                                                                                        \
         if (srsran_crc_match(crc, message, q->liftK - crc->order)) {                                                   \
@@ -133,6 +183,7 @@
     /* the first two variable nodes from the final codeword.*/                                                         \
     uint8_t n_layers = cdwd_rm_length / q->ls - q->bgK + 2;                                                            \
                                                                                                                        \
+    /* Every iteration is run as two half-iterations, the returned count is in full iterations */                      \
     for (int i_iteration = 0; i_iteration < 2 * q->max_nof_iter; i_iteration++) {                                      \
       for (int i_layer = 0; i_layer < n_layers; i_layer++) {                                                           \
         update_ldpc_var_to_check_##SUFFIX(q->ptr, i_layer);                                                            \
@@ -147,11 +198,23 @@
                                                                                                                        \
       update_ldpc_soft_bits_##SUFFIX(q->ptr, q->var_indices);                                                          \
                                                                                                                        \
-      if (crc != NULL) {                                                                                               \
+      if (q->hard_bits != NULL) {                                                                                      \
+        extract_ldpc_message_##SUFFIX(q->ptr, q->hard_bits, (q->bgK + n_layers) * q->ls);                              \
+        srsran_vec_u8_copy(message, q->hard_bits, q->liftK);                                                           \
+                                                                                                                       \
+        if (crc != NULL && srsran_crc_match(crc, message, q->liftK - crc->order)) {                                    \
+          return (i_iteration + 2) / 2;                                                                                \
+        }                                                                                                              \
+                                                                                                                       \
+        /* A valid codeword that fails the CRC will not be corrected by further iterations */                          \
+        if (ldpc_decoder_syndrome_check(q, n_layers)) {                                                                \
+          return (crc != NULL) ? 0 : (i_iteration + 2) / 2;                                                            \
+        }                                                                                                              \
+      } else if (crc != NULL) {                                                                                        \
         extract_ldpc_message_##SUFFIX(q->ptr, message, q->liftK);                                                      \
                                                                                                                        \
         if (srsran_crc_match(crc, message, q->liftK - crc->order)) {                                                   \
-          return i_iteration + 1;                                                                                      \
+          return (i_iteration + 2) / 2;                                                                                \
         }                                                                                                              \
       }                                                                                                                \
     }                                                                                                                  \
@@ -177,6 +240,9 @@ static void free_dec_f(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_f(q->ptr);
 }
 
@@ -209,6 +275,9 @@ static void free_dec_s(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_s(q->ptr);
 }
 
@@ -241,6 +310,9 @@ static void free_dec_c(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_c(q->ptr);
 }
 
@@ -273,6 +345,9 @@ static void free_dec_c_flood(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_c_flood(q->ptr);
 }
 
@@ -306,6 +381,9 @@ static void free_dec_c_avx2(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_c_avx2(q->ptr);
 }
 
@@ -339,6 +417,9 @@ static void free_dec_c_avx2long(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_c_avx2long(q->ptr);
 }
 
@@ -372,6 +453,9 @@ static void free_dec_c_avx2_flood(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_c_avx2_flood(q->ptr);
 }
 
@@ -405,6 +489,9 @@ static void free_dec_c_avx2long_flood(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_c_avx2long_flood(q->ptr);
 }
 
@@ -445,6 +532,9 @@ static void free_dec_c_avx512(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_c_avx512(q->ptr);
 }
 
@@ -478,6 +568,9 @@ static void free_dec_c_avx512long(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_c_avx512long(q->ptr);
 }
 
@@ -511,6 +604,9 @@ static void free_dec_c_avx512long_flood(void* o)
   if (q->pcm) {
     free(q->pcm);
   }
+  if (q->hard_bits) {
+    free(q->hard_bits);
+  }
   delete_ldpc_dec_c_avx512long_flood(q->ptr);
 }
 
@@ -606,6 +702,18 @@ int srsran_ldpc_decoder_init(srsran_ldpc_decoder_t* q, const srsran_ldpc_decoder
   }
   q->scaling_fctr = scaling_fctr;
 
+  // The hard decisions of all variable nodes are followed by the syndrome of one layer
+  q->hard_bits = NULL;
+  if (args->early_stop) {
+    q->hard_bits = srsran_vec_u8_malloc(q->liftN + q->ls);
+    if (!q->hard_bits) {
+      perror("malloc");
+      free(q->var_indices);
+      free(q->pcm);
+      return -1;
+    }
+  }
+
   switch (type) {
     case SRSRAN_LDPC_DECODER_F:
       return init_f(q);
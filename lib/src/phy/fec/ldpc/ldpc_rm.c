@@ -30,12 +30,14 @@
  */
 
 #include <math.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 
 #include "srsran/phy/fec/ldpc/ldpc_common.h" //FILLER_BIT definition
 #include "srsran/phy/fec/ldpc/ldpc_rm.h"
+#include "srsran/phy/utils/simd.h"
 #include "srsran/phy/utils/vector.h"
 
 #include "srsran/phy/utils/debug.h"
@@ -76,6 +78,12 @@ static const uint32_t BASEK[2] = {22, 10};
  */
 static const uint32_t MAXE = 273 * 13 * 12 * 8 * 4;
 
+/*!
+ * Number of columns of the bit interleaver (modulation symbols) that the rate dematcher processes at once. A block of
+ * LLR of each row is gathered into a small buffer that stays in cache before it is combined into the output.
+ */
+#define LDPC_RM_RX_BLOCK 256
+
 /*!
  * \brief Describes an rate matcher.
  */
@@ -87,24 +95,21 @@ struct pRM_tx {
  * \brief Describes an rate dematcher (float version).
  */
 struct pRM_rx_f {
-  float*    tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  float* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer with a block of deinterleaved LLR. */
 };
 
 /*!
  * \brief Describes an rate dematcher (short version).
  */
 struct pRM_rx_s {
-  int16_t*  tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  int16_t* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer with a block of deinterleaved LLR. */
 };
 
 /*!
  * \brief Describes an rate dematcher (char version).
  */
 struct pRM_rx_c {
-  int8_t*   tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer between bit-selection and interleaver. */
-  uint32_t* indices;       /*!< \brief Pointer to a temporal buffer with the indices for bit-selection. */
+  int8_t* tmp_rm_symbol; /*!< \brief Pointer to a temporal buffer with a block of deinterleaved LLR. */
 };
 
 /*!
@@ -193,49 +198,299 @@ static void bit_selection_rm_tx(const uint8_t* input,
 }
 
 /*!
- * Undoes bit selection for the rate-dematching block.
+ * \brief Describes the bit selection of a rate dematcher.
+ *
+ * The bit selection reads the circular buffer of length Ncb starting at k0 and skipping the filler bits. A
+ * rate-matched LLR with index k (after deinterleaving) is combined in the codeword position given by the k-th
+ * non-filler position of the circular buffer, which is computed directly instead of stored in a table.
+ */
+typedef struct {
+  uint32_t V;     /*!< \brief Number of non-filler positions of the circular buffer. */
+  uint32_t f_ini; /*!< \brief First filler bit position in the circular buffer. */
+  uint32_t nof_f; /*!< \brief Number of filler bits in the circular buffer. */
+  uint32_t s0;    /*!< \brief Non-filler position index corresponding to k0. */
+} rm_rx_map_t;
+
+static void rm_rx_map_init(rm_rx_map_t*   m,
+                           const uint32_t ini_exclude,
+                           const uint32_t end_exclude,
+                           const uint32_t k0,
+                           const uint32_t Ncb)
+{
+  m->f_ini = SRSRAN_MIN(ini_exclude, Ncb);
+  m->nof_f = SRSRAN_MIN(end_exclude, Ncb) - m->f_ini;
+  m->V     = Ncb - m->nof_f;
+  if (k0 < m->f_ini) {
+    m->s0 = k0;
+  } else if (k0 < m->f_ini + m->nof_f) {
+    m->s0 = m->f_ini;
+  } else {
+    m->s0 = k0 - m->nof_f;
+  }
+}
+
+/*!
+ * Adds input to output (float). This is the soft combining of repeated symbols and previous redundancy versions.
+ */
+static inline void rm_rx_combine_f(float* output, const float* input, uint32_t len)
+{
+  uint32_t i = 0;
+#if SRSRAN_SIMD_F_SIZE
+  for (; i + SRSRAN_SIMD_F_SIZE <= len; i += SRSRAN_SIMD_F_SIZE) {
+    simd_f_t a = srsran_simd_f_loadu(output + i);
+    simd_f_t b = srsran_simd_f_loadu(input + i);
+    srsran_simd_f_storeu(output + i, srsran_simd_f_add(a, b));
+  }
+#endif /* SRSRAN_SIMD_F_SIZE */
+  for (; i < len; i++) {
+    output[i] += input[i];
+  }
+}
+
+/*!
+ * Adds input to output (int16_t), saturating to the 15-bit message range. Soft bits use the remaining bit to denote
+ * infinity, which is reserved to filler bits.
+ */
+static inline void rm_rx_combine_s(int16_t* output, const int16_t* input, uint32_t len)
+{
+  const int16_t infinity15 = (1U << 14U) - 1;
+
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX512
+  __m512i max512 = _mm512_set1_epi16(infinity15);
+  __m512i min512 = _mm512_set1_epi16(-infinity15);
+  for (; i + 32 <= len; i += 32) {
+    __m512i a = _mm512_loadu_si512(output + i);
+    __m512i b = _mm512_loadu_si512(input + i);
+    a         = _mm512_max_epi16(_mm512_min_epi16(_mm512_adds_epi16(a, b), max512), min512);
+    _mm512_storeu_si512(output + i, a);
+  }
+#endif /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  __m256i max256 = _mm256_set1_epi16(infinity15);
+  __m256i min256 = _mm256_set1_epi16(-infinity15);
+  for (; i + 16 <= len; i += 16) {
+    __m256i a = _mm256_loadu_si256((__m256i*)(output + i));
+    __m256i b = _mm256_loadu_si256((__m256i*)(input + i));
+    a         = _mm256_max_epi16(_mm256_min_epi16(_mm256_adds_epi16(a, b), max256), min256);
+    _mm256_storeu_si256((__m256i*)(output + i), a);
+  }
+#endif /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  __m128i max128 = _mm_set1_epi16(infinity15);
+  __m128i min128 = _mm_set1_epi16(-infinity15);
+  for (; i + 8 <= len; i += 8) {
+    __m128i a = _mm_loadu_si128((__m128i*)(output + i));
+    __m128i b = _mm_loadu_si128((__m128i*)(input + i));
+    a         = _mm_max_epi16(_mm_min_epi16(_mm_adds_epi16(a, b), max128), min128);
+    _mm_storeu_si128((__m128i*)(output + i), a);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; i < len; i++) {
+    long tmp  = (long)output[i] + input[i];
+    output[i] = (int16_t)SRSRAN_MAX(SRSRAN_MIN(tmp, infinity15), -infinity15);
+  }
+}
+
+/*!
+ * Adds input to output (int8_t), saturating to the 7-bit message range. Soft bits use the remaining bit to denote
+ * infinity, which is reserved to filler bits.
+ */
+static inline void rm_rx_combine_c(int8_t* output, const int8_t* input, uint32_t len)
+{
+  const int8_t infinity7 = (1U << 6U) - 1;
+
+  uint32_t i = 0;
+#ifdef LV_HAVE_AVX512
+  __m512i max512 = _mm512_set1_epi8(infinity7);
+  __m512i min512 = _mm512_set1_epi8(-infinity7);
+  for (; i + 64 <= len; i += 64) {
+    __m512i a = _mm512_loadu_si512(output + i);
+    __m512i b = _mm512_loadu_si512(input + i);
+    a         = _mm512_max_epi8(_mm512_min_epi8(_mm512_adds_epi8(a, b), max512), min512);
+    _mm512_storeu_si512(output + i, a);
+  }
+#endif /* LV_HAVE_AVX512 */
+#ifdef LV_HAVE_AVX2
+  __m256i max256 = _mm256_set1_epi8(infinity7);
+  __m256i min256 = _mm256_set1_epi8(-infinity7);
+  for (; i + 32 <= len; i += 32) {
+    __m256i a = _mm256_loadu_si256((__m256i*)(output + i));
+    __m256i b = _mm256_loadu_si256((__m256i*)(input + i));
+    a         = _mm256_max_epi8(_mm256_min_epi8(_mm256_adds_epi8(a, b), max256), min256);
+    _mm256_storeu_si256((__m256i*)(output + i), a);
+  }
+#endif /* LV_HAVE_AVX2 */
+#ifdef LV_HAVE_SSE
+  __m128i max128 = _mm_set1_epi8(infinity7);
+  __m128i min128 = _mm_set1_epi8(-infinity7);
+  for (; i + 16 <= len; i += 16) {
+    __m128i a = _mm_loadu_si128((__m128i*)(output + i));
+    __m128i b = _mm_loadu_si128((__m128i*)(input + i));
+    a         = _mm_max_epi8(_mm_min_epi8(_mm_adds_epi8(a, b), max128), min128);
+    _mm_storeu_si128((__m128i*)(output + i), a);
+  }
+#endif /* LV_HAVE_SSE */
+  for (; i < len; i++) {
+    long tmp  = (long)output[i] + input[i];
+    output[i] = (int8_t)SRSRAN_MAX(SRSRAN_MIN(tmp, infinity7), -infinity7);
+  }
+}
+
+/*!
+ * Gathers one row of the bit interleaver (float), i.e. every stride-th LLR.
+ */
+static inline void rm_rx_gather_f_n(const float* input, float* output, const uint32_t stride, const uint32_t len)
+{
+  for (uint32_t j = 0; j < len; j++) {
+    output[j] = input[j * stride];
+  }
+}
+
+static void rm_rx_gather_f(const float* input, float* output, const uint32_t stride, const uint32_t len)
+{
+  // The strides of the common modulation orders are constant, so the compiler generates shuffle based code
+  switch (stride) {
+    case 2:
+      rm_rx_gather_f_n(input, output, 2, len);
+      break;
+    case 4:
+      rm_rx_gather_f_n(input, output, 4, len);
+      break;
+    case 6:
+      rm_rx_gather_f_n(input, output, 6, len);
+      break;
+    case 8:
+      rm_rx_gather_f_n(input, output, 8, len);
+      break;
+    default:
+      rm_rx_gather_f_n(input, output, stride, len);
+  }
+}
+
+/*!
+ * Gathers one row of the bit interleaver (int16_t), i.e. every stride-th LLR.
+ */
+static inline void rm_rx_gather_s_n(const int16_t* input, int16_t* output, const uint32_t stride, const uint32_t len)
+{
+  for (uint32_t j = 0; j < len; j++) {
+    output[j] = input[j * stride];
+  }
+}
+
+static void rm_rx_gather_s(const int16_t* input, int16_t* output, const uint32_t stride, const uint32_t len)
+{
+  // The strides of the common modulation orders are constant, so the compiler generates shuffle based code
+  switch (stride) {
+    case 2:
+      rm_rx_gather_s_n(input, output, 2, len);
+      break;
+    case 4:
+      rm_rx_gather_s_n(input, output, 4, len);
+      break;
+    case 6:
+      rm_rx_gather_s_n(input, output, 6, len);
+      break;
+    case 8:
+      rm_rx_gather_s_n(input, output, 8, len);
+      break;
+    default:
+      rm_rx_gather_s_n(input, output, stride, len);
+  }
+}
+
+/*!
+ * Gathers one row of the bit interleaver (int8_t), i.e. every stride-th LLR.
+ */
+static inline void rm_rx_gather_c_n(const int8_t* input, int8_t* output, const uint32_t stride, const uint32_t len)
+{
+  for (uint32_t j = 0; j < len; j++) {
+    output[j] = input[j * stride];
+  }
+}
+
+static void rm_rx_gather_c(const int8_t* input, int8_t* output, const uint32_t stride, const uint32_t len)
+{
+  // The strides of the common modulation orders are constant, so the compiler generates shuffle based code
+  switch (stride) {
+    case 2:
+      rm_rx_gather_c_n(input, output, 2, len);
+      break;
+    case 4:
+      rm_rx_gather_c_n(input, output, 4, len);
+      break;
+    case 6:
+      rm_rx_gather_c_n(input, output, 6, len);
+      break;
+    case 8:
+      rm_rx_gather_c_n(input, output, 8, len);
+      break;
+    default:
+      rm_rx_gather_c_n(input, output, stride, len);
+  }
+}
+
+/*!
+ * Undoes bit selection and bit interleaving for the rate-dematching block (float), in a single pass over the input.
  * The output has the codeword length N. It inserts filler bits as INFINITY symbols
  * (to indicate very reliable 0 bit), and set to 0 (completely unknown bit) all
  * missing symbol. Repeated symbols are added.
  * The input memory *output shall be either initialized to all zeros or to the
  * result of previous redundancy versions is available.
  */
-static void bit_selection_rm_rx(const float*   input,
-                                const uint32_t in_len,
-                                float*         output,
-                                uint32_t*      indices,
-                                const uint32_t ini_exclude,
-                                const uint32_t end_exclude,
-                                const uint32_t k0,
-                                const uint32_t Ncb)
+static void bit_selection_rm_rx_f(const float*   input,
+                                  const uint32_t in_len,
+                                  float*         output,
+                                  float*         tmp,
+                                  const uint32_t mod_order,
+                                  const uint32_t ini_exclude,
+                                  const uint32_t end_exclude,
+                                  const uint32_t k0,
+                                  const uint32_t Ncb)
 {
-  uint32_t E = in_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
+  rm_rx_map_t m = {};
+  rm_rx_map_init(&m, ini_exclude, end_exclude, k0, Ncb);
 
   // set filler bits to INFINITY
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
     output[i] = INFINITY;
   }
 
-  // Add soft bits, in case of repetition
-  for (uint32_t i = 0; i < E; i++) {
-    output[indices[i]] = output[indices[i]] + input[i];
+  // The deinterleaved LLR k = i * cols + j is input[j * rows + i]. The rows are processed in blocks of columns, which
+  // are gathered in tmp. If codeword positions are repeated, the rows go in order so that the LLR are added in the
+  // same order as the bit selection. Otherwise, all rows of a block go together and the input block stays in cache.
+  uint32_t rows     = mod_order;
+  uint32_t cols     = in_len / rows;
+  uint32_t nof_blk  = (cols + LDPC_RM_RX_BLOCK - 1) / LDPC_RM_RX_BLOCK;
+  bool     repeated = in_len > m.V;
+  for (uint32_t n = 0; n < rows * nof_blk; n++) {
+    uint32_t     i   = repeated ? n / nof_blk : n % rows;
+    uint32_t     j   = (repeated ? n % nof_blk : n / rows) * LDPC_RM_RX_BLOCK;
+    uint32_t     len = SRSRAN_MIN(LDPC_RM_RX_BLOCK, cols - j);
+    const float* llr = input + j;
+    if (rows > 1) {
+      rm_rx_gather_f(input + j * rows + i, tmp, rows, len);
+      llr = tmp;
+    }
+
+    // Split the block in runs of consecutive codeword positions
+    uint32_t s = (m.s0 + i * cols + j) % m.V;
+    while (len > 0) {
+      uint32_t pos = (s < m.f_ini) ? s : s + m.nof_f;
+      uint32_t run = SRSRAN_MIN((s < m.f_ini) ? m.f_ini - s : m.V - s, len);
+      rm_rx_combine_f(output + pos, llr, run);
+      llr += run;
+      len -= run;
+      s += run;
+      if (s == m.V) {
+        s = 0;
+      }
+    }
   }
 }
 
 /*!
- * Undoes bit selection for the rate-dematching block.
+ * Undoes bit selection and bit interleaving for the rate-dematching block (int16_t), in a single pass over the input.
  * The output has the codeword length N. It inserts filler bits as INFINITY symbols
  * (to indicate very reliable 0 bit), and set to 0 (completely unknown bit) all
  * missing symbol. Repeated symbols are added.
@@ -245,51 +500,57 @@ static void bit_selection_rm_rx(const float*   input,
 static void bit_selection_rm_rx_s(const int16_t* input,
                                   const uint32_t in_len,
                                   int16_t*       output,
-                                  uint32_t*      indices,
+                                  int16_t*       tmp,
+                                  const uint32_t mod_order,
                                   const uint32_t ini_exclude,
                                   const uint32_t end_exclude,
                                   const uint32_t k0,
                                   const uint32_t Ncb)
 {
-  uint32_t E = in_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
+  rm_rx_map_t m = {};
+  rm_rx_map_init(&m, ini_exclude, end_exclude, k0, Ncb);
 
   // set filler bits to INFINITY
-  const long infinity16 = (1U << 15U) - 1; // Max positive value in 16-bit representation
+  const int16_t infinity16 = (1U << 15U) - 1; // Max positive value in 16-bit representation
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
     output[i] = infinity16;
   }
 
-  // Add soft bits, in case of repetition
-  const int16_t infinity15 =
-      (1U << 14U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
-  // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
-  long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
-    if (tmp > infinity15) {
-      tmp = infinity15;
+  // The deinterleaved LLR k = i * cols + j is input[j * rows + i]. The rows are processed in blocks of columns, which
+  // are gathered in tmp. If codeword positions are repeated, the rows go in order so that the LLR are added in the
+  // same order as the bit selection. Otherwise, all rows of a block go together and the input block stays in cache.
+  uint32_t rows     = mod_order;
+  uint32_t cols     = in_len / rows;
+  uint32_t nof_blk  = (cols + LDPC_RM_RX_BLOCK - 1) / LDPC_RM_RX_BLOCK;
+  bool     repeated = in_len > m.V;
+  for (uint32_t n = 0; n < rows * nof_blk; n++) {
+    uint32_t       i   = repeated ? n / nof_blk : n % rows;
+    uint32_t       j   = (repeated ? n % nof_blk : n / rows) * LDPC_RM_RX_BLOCK;
+    uint32_t       len = SRSRAN_MIN(LDPC_RM_RX_BLOCK, cols - j);
+    const int16_t* llr = input + j;
+    if (rows > 1) {
+      rm_rx_gather_s(input + j * rows + i, tmp, rows, len);
+      llr = tmp;
     }
-    if (tmp < -infinity15) {
-      tmp = -infinity15;
+
+    // Split the block in runs of consecutive codeword positions
+    uint32_t s = (m.s0 + i * cols + j) % m.V;
+    while (len > 0) {
+      uint32_t pos = (s < m.f_ini) ? s : s + m.nof_f;
+      uint32_t run = SRSRAN_MIN((s < m.f_ini) ? m.f_ini - s : m.V - s, len);
+      rm_rx_combine_s(output + pos, llr, run);
+      llr += run;
+      len -= run;
+      s += run;
+      if (s == m.V) {
+        s = 0;
+      }
     }
-    output[indices[i]] = (int16_t)tmp;
   }
 }
 
 /*!
- * Undoes bit selection for the rate-dematching block (int8_t).
+ * Undoes bit selection and bit interleaving for the rate-dematching block (int8_t), in a single pass over the input.
  * The output has the codeword length N. It inserts filler bits as INFINITY symbols
  * (to indicate very reliable 0 bit), and set to 0 (completely unknown bit) all
  * missing symbol. Repeated symbols are added.
@@ -299,46 +560,52 @@ static void bit_selection_rm_rx_s(const int16_t* input,
 static void bit_selection_rm_rx_c(const int8_t*  input,
                                   const uint32_t in_len,
                                   int8_t*        output,
-                                  uint32_t*      indices,
+                                  int8_t*        tmp,
+                                  const uint32_t mod_order,
                                   const uint32_t ini_exclude,
                                   const uint32_t end_exclude,
                                   const uint32_t k0,
                                   const uint32_t Ncb)
 {
-  uint32_t E = in_len;
-
-  uint32_t k    = 0;
-  uint32_t j    = 0;
-  uint32_t icwd = 0;
-  while (k < E) {
-    icwd = (k0 + j) % Ncb;
-    if (!(icwd >= ini_exclude && icwd < end_exclude)) { // avoid filler bits
-      indices[k] = icwd;
-      k          = k + 1;
-    }
-    j = j + 1;
-  } // while
+  rm_rx_map_t m = {};
+  rm_rx_map_init(&m, ini_exclude, end_exclude, k0, Ncb);
 
   // set filler bits to INFINITY
-  const long infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
+  const int8_t infinity8 = (1U << 7U) - 1; // Max positive value in 8-bit representation
   for (uint32_t i = ini_exclude; i < end_exclude; i++) {
     output[i] = infinity8;
   }
 
-  // Add soft bits, in case of repetition
-  const int16_t infinity7 =
-      (1U << 6U) - 1; // Messages use a 15-bit quantization. Soft bits use the remaining bit to denote infinity.
-  // input is assume to be quantized from -infinity15 to infinity15. Only filler bits can be infinity16
-  long tmp = 0;
-  for (uint32_t i = 0; i < E; i++) {
-    tmp = (long)output[indices[i]] + input[i];
-    if (tmp > infinity7) {
-      tmp = infinity7;
+  // The deinterleaved LLR k = i * cols + j is input[j * rows + i]. The rows are processed in blocks of columns, which
+  // are gathered in tmp. If codeword positions are repeated, the rows go in order so that the LLR are added in the
+  // same order as the bit selection. Otherwise, all rows of a block go together and the input block stays in cache.
+  uint32_t rows     = mod_order;
+  uint32_t cols     = in_len / rows;
+  uint32_t nof_blk  = (cols + LDPC_RM_RX_BLOCK - 1) / LDPC_RM_RX_BLOCK;
+  bool     repeated = in_len > m.V;
+  for (uint32_t n = 0; n < rows * nof_blk; n++) {
+    uint32_t      i   = repeated ? n / nof_blk : n % rows;
+    uint32_t      j   = (repeated ? n % nof_blk : n / rows) * LDPC_RM_RX_BLOCK;
+    uint32_t      len = SRSRAN_MIN(LDPC_RM_RX_BLOCK, cols - j);
+    const int8_t* llr = input + j;
+    if (rows > 1) {
+      rm_rx_gather_c(input + j * rows + i, tmp, rows, len);
+      llr = tmp;
     }
-    if (tmp < -infinity7) {
-      tmp = -infinity7;
+
+    // Split the block in runs of consecutive codeword positions
+    uint32_t s = (m.s0 + i * cols + j) % m.V;
+    while (len > 0) {
+      uint32_t pos = (s < m.f_ini) ? s : s + m.nof_f;
+      uint32_t run = SRSRAN_MIN((s < m.f_ini) ? m.f_ini - s : m.V - s, len);
+      rm_rx_combine_c(output + pos, llr, run);
+      llr += run;
+      len -= run;
+      s += run;
+      if (s == m.V) {
+        s = 0;
+      }
     }
-    output[indices[i]] = (int8_t)tmp;
   }
 }
 
@@ -359,57 +626,6 @@ bit_interleaver_rm_tx(const uint8_t* input, uint8_t* output, const uint32_t in_o
   }
 }
 
-/*!
- * Bit deinterleaver (float)
- */
-static void
-bit_interleaver_rm_rx(const float* input, float* output, const uint32_t in_out_len, const uint32_t mod_order)
-{
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
-    }
-  }
-}
-
-/*!
- * Bit deinterleaver (short)
- */
-static void
-bit_interleaver_rm_rx_s(const int16_t* input, int16_t* output, const uint32_t in_out_len, const uint32_t mod_order)
-{
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
-    }
-  }
-}
-
-/*!
- * Bit deinterleaver (short)
- */
-static void
-bit_interleaver_rm_rx_c(const int8_t* input, int8_t* output, const uint32_t in_out_len, const uint32_t mod_order)
-{
-  uint32_t cols = 0;
-  uint32_t rows = 0;
-  rows          = mod_order;
-  cols          = in_out_len / rows;
-  for (uint32_t j = 0; j < cols; j++) {
-    for (uint32_t i = 0; i < rows; i++) {
-      output[i * cols + j] = input[j * rows + i];
-    }
-  }
-}
-
 int srsran_ldpc_rm_tx_init(srsran_ldpc_rm_t* p)
 {
   if (p == NULL) {
@@ -448,13 +664,7 @@ int srsran_ldpc_rm_rx_init_f(srsran_ldpc_rm_t* p)
   p->ptr = pp;
 
   // allocate memory to the temporal buffer
-  if ((pp->tmp_rm_symbol = srsran_vec_f_malloc(MAXE)) == NULL) {
-    free(pp);
-    return -1;
-  }
-
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
+  if ((pp->tmp_rm_symbol = srsran_vec_f_malloc(LDPC_RM_RX_BLOCK)) == NULL) {
     free(pp);
     return -1;
   }
@@ -476,13 +686,7 @@ int srsran_ldpc_rm_rx_init_s(srsran_ldpc_rm_t* p)
   p->ptr = pp;
 
   // allocate memory to the temporal buffer
-  if ((pp->tmp_rm_symbol = srsran_vec_i16_malloc(MAXE)) == NULL) {
-    free(pp);
-    return -1;
-  }
-
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
+  if ((pp->tmp_rm_symbol = srsran_vec_i16_malloc(LDPC_RM_RX_BLOCK)) == NULL) {
     free(pp);
     return -1;
   }
@@ -504,13 +708,7 @@ int srsran_ldpc_rm_rx_init_c(srsran_ldpc_rm_t* p)
   p->ptr = pp;
 
   // allocate memory to the temporal buffer
-  if ((pp->tmp_rm_symbol = srsran_vec_i8_malloc(MAXE)) == NULL) {
-    free(pp);
-    return -1;
-  }
-
-  if ((pp->indices = srsran_vec_u32_malloc(MAXE)) == NULL) {
-    free(pp->tmp_rm_symbol);
+  if ((pp->tmp_rm_symbol = srsran_vec_i8_malloc(LDPC_RM_RX_BLOCK)) == NULL) {
     free(pp);
     return -1;
   }
@@ -539,9 +737,6 @@ void srsran_ldpc_rm_rx_free_f(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -555,9 +750,6 @@ void srsran_ldpc_rm_rx_free_s(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -571,9 +763,6 @@ void srsran_ldpc_rm_rx_free_c(srsran_ldpc_rm_t* q)
       if (qq->tmp_rm_symbol != NULL) {
         free(qq->tmp_rm_symbol);
       }
-      if (qq->indices != NULL) {
-        free(qq->indices);
-      }
       free(qq);
     }
   }
@@ -625,18 +814,11 @@ int srsran_ldpc_rm_rx_f(srsran_ldpc_rm_t*        q,
     exit(-1);
   }
 
-  struct pRM_rx_f* pp            = q->ptr;
-  float*           tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
-  uint32_t         end_exclude   = q->K - 2 * q->ls;
-  uint32_t         ini_exclude   = end_exclude - q->F;
+  struct pRM_rx_f* pp          = q->ptr;
+  uint32_t         end_exclude = q->K - 2 * q->ls;
+  uint32_t         ini_exclude = end_exclude - q->F;
 
-  if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  } else {
-    bit_interleaver_rm_rx(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  }
+  bit_selection_rm_rx_f(input, q->E, output, pp->tmp_rm_symbol, q->mod_order, ini_exclude, end_exclude, q->k0, q->Ncb);
   return 0;
 }
 
@@ -656,18 +838,11 @@ int srsran_ldpc_rm_rx_s(srsran_ldpc_rm_t*        q,
     exit(-1);
   }
 
-  struct pRM_rx_f* pp            = q->ptr;
-  int16_t*         tmp_rm_symbol = (int16_t*)pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
-  uint32_t         end_exclude   = q->K - 2 * q->ls;
-  uint32_t         ini_exclude   = end_exclude - q->F;
+  struct pRM_rx_s* pp          = q->ptr;
+  uint32_t         end_exclude = q->K - 2 * q->ls;
+  uint32_t         ini_exclude = end_exclude - q->F;
 
-  if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_s(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  } else {
-    bit_interleaver_rm_rx_s(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_s(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  }
+  bit_selection_rm_rx_s(input, q->E, output, pp->tmp_rm_symbol, q->mod_order, ini_exclude, end_exclude, q->k0, q->Ncb);
 
   return 0;
 }
@@ -688,18 +863,11 @@ int srsran_ldpc_rm_rx_c(srsran_ldpc_rm_t*        q,
     exit(-1);
   }
 
-  struct pRM_rx_c* pp            = q->ptr;
-  int8_t*          tmp_rm_symbol = pp->tmp_rm_symbol;
-  uint32_t*        indices       = pp->indices;
-  uint32_t         end_exclude   = q->K - 2 * q->ls;
-  uint32_t         ini_exclude   = end_exclude - q->F;
+  struct pRM_rx_c* pp          = q->ptr;
+  uint32_t         end_exclude = q->K - 2 * q->ls;
+  uint32_t         ini_exclude = end_exclude - q->F;
 
-  if (q->mod_order == 1) { // interleaver can be skipped
-    bit_selection_rm_rx_c(input, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  } else {
-    bit_interleaver_rm_rx_c(input, tmp_rm_symbol, q->E, q->mod_order);
-    bit_selection_rm_rx_c(tmp_rm_symbol, q->E, output, indices, ini_exclude, end_exclude, q->k0, q->Ncb);
-  }
+  bit_selection_rm_rx_c(input, q->E, output, pp->tmp_rm_symbol, q->mod_order, ini_exclude, end_exclude, q->k0, q->Ncb);
 
   // Return the number of useful LLR
   return (int)SRSRAN_MIN(q->k0 + q->E, q->Ncb);
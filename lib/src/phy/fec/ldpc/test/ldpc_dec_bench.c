@@ -0,0 +1,338 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_dec_bench.c
+ * \brief Throughput benchmark for the LDPC decoder early stop.
+ *
+ * For every SNR point of a sweep, a batch of random messages is encoded, 2-PAM modulated, sent over an AWGN channel,
+ * quantized to 8-bit LLRs and decoded by all the available 8-bit decoders, both running a fixed number of iterations
+ * and stopping as soon as the hard decisions satisfy the parity checks. The word error rate, the average number of
+ * iterations per code block and the decoded throughput (information bits per second) are reported for both cases.
+ * The test fails if the early stop decodes any word that the fixed-iteration decoder did not, or vice versa, at the
+ * largest SNR of the sweep.
+ *
+ * Synopsis: **ldpc_dec_bench [options]**
+ *
+ * Options:
+ *  - **-b \<number\>** Base Graph (1 or 2. Default 1).
+ *  - **-l \<number\>** Lifting Size (according to 5GNR standard. Default 384).
+ *  - **-e \<number\>** Codeword length after rate matching (set to 0 [default] for full rate).
+ *  - **-i \<number\>** Maximum number of iterations (Default 10).
+ *  - **-s \<number\>** First SNR of the sweep in dB (Default -1 dB).
+ *  - **-S \<number\>** Last SNR of the sweep in dB (Default 4 dB).
+ *  - **-d \<number\>** SNR step in dB (Default 1 dB).
+ *  - **-B \<number\>** Number of codewords per SNR point (Default 20).
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/fec/ldpc/ldpc_common.h"
+#include "srsran/phy/fec/ldpc/ldpc_decoder.h"
+#include "srsran/phy/fec/ldpc/ldpc_encoder.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+static srsran_basegraph_t base_graph   = BG1; /*!< \brief Base Graph (BG1 or BG2). */
+static uint32_t           lift_size    = 384; /*!< \brief Lifting Size. */
+static uint32_t           rm_length    = 0;   /*!< \brief Codeword length after rate matching. */
+static uint32_t           max_nof_iter = 10;  /*!< \brief Maximum number of iterations. */
+static float              snr_min      = -1;  /*!< \brief First SNR of the sweep [dB]. */
+static float              snr_max      = 4;   /*!< \brief Last SNR of the sweep [dB]. */
+static float              snr_step     = 1;   /*!< \brief SNR step [dB]. */
+static uint32_t           batch_size   = 20;  /*!< \brief Number of codewords per SNR point. */
+#define MS_SF 0.75f                           /*!< \brief Scaling factor for the normalized min-sum algorithm. */
+
+/*!
+ * \brief 8-bit decoder types under test.
+ */
+static const struct {
+  srsran_ldpc_decoder_type_t type;
+  const char*                name;
+} decoder_types[] = {
+    {SRSRAN_LDPC_DECODER_C, "C"},
+    {SRSRAN_LDPC_DECODER_C_FLOOD, "C flood"},
+#ifdef LV_HAVE_AVX2
+    {SRSRAN_LDPC_DECODER_C_AVX2, "AVX2"},
+    {SRSRAN_LDPC_DECODER_C_AVX2_FLOOD, "AVX2 flood"},
+#endif // LV_HAVE_AVX2
+#ifdef LV_HAVE_AVX512
+    {SRSRAN_LDPC_DECODER_C_AVX512, "AVX512"},
+    {SRSRAN_LDPC_DECODER_C_AVX512_FLOOD, "AVX512 flood"},
+#endif // LV_HAVE_AVX512
+};
+#define NOF_DECODER_TYPES (sizeof(decoder_types) / sizeof(decoder_types[0]))
+
+/*!
+ * \brief Decoding statistics of one decoder at one SNR point.
+ */
+typedef struct {
+  double   elapsed;       /*!< \brief Decoding time [s]. */
+  uint32_t nof_iter;      /*!< \brief Accumulated number of iterations. */
+  uint32_t nof_errors;    /*!< \brief Number of wrongly decoded words. */
+  uint8_t* error_pattern; /*!< \brief Per-word decoding error flag. */
+} bench_result_t;
+
+/*!
+ * \brief Prints test help when a wrong parameter is passed as input.
+ */
+void usage(char* prog)
+{
+  printf("Usage: %s [-bX] [-lX] [-eX] [-iX] [-sX] [-SX] [-dX] [-BX]\n", prog);
+  printf("\t-b Base Graph [(1 or 2) Default %d]\n", base_graph + 1);
+  printf("\t-l Lifting Size [Default %d]\n", lift_size);
+  printf("\t-e Word length after rate matching [Default %d (no rate matching)]\n", rm_length);
+  printf("\t-i Maximum number of iterations [Default %d]\n", max_nof_iter);
+  printf("\t-s First SNR of the sweep in dB [Default %.1f]\n", snr_min);
+  printf("\t-S Last SNR of the sweep in dB [Default %.1f]\n", snr_max);
+  printf("\t-d SNR step in dB [Default %.1f]\n", snr_step);
+  printf("\t-B Number of codewords per SNR point [Default %d]\n", batch_size);
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "b:l:e:i:s:S:d:B:")) != -1) {
+    switch (opt) {
+      case 'b':
+        base_graph = (uint32_t)strtol(optarg, NULL, 10) - 1;
+        break;
+      case 'l':
+        lift_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'e':
+        rm_length = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'i':
+        max_nof_iter = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr_min = strtof(optarg, NULL);
+        break;
+      case 'S':
+        snr_max = strtof(optarg, NULL);
+        break;
+      case 'd':
+        snr_step = strtof(optarg, NULL);
+        break;
+      case 'B':
+        batch_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*!
+ * \brief Decodes the whole batch with the given decoder and accumulates the statistics.
+ */
+static void decode_batch(srsran_ldpc_decoder_t* decoder,
+                         const int8_t*          llrs,
+                         const uint8_t*         messages_true,
+                         uint8_t*               messages_rx,
+                         uint32_t               finalK,
+                         uint32_t               finalN,
+                         uint32_t               n_useful_symbols,
+                         bench_result_t*        result)
+{
+  struct timeval t[3];
+
+  gettimeofday(&t[1], NULL);
+  for (uint32_t i = 0; i < batch_size; i++) {
+    int ret = srsran_ldpc_decoder_decode_c(decoder, llrs + i * finalN, messages_rx + i * finalK, n_useful_symbols);
+    result->nof_iter += (ret > 0) ? (uint32_t)ret : 0;
+  }
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+  result->elapsed += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+  for (uint32_t i = 0; i < batch_size; i++) {
+    result->error_pattern[i] = 0;
+    for (uint32_t j = 0; j < finalK; j++) {
+      if (messages_rx[i * finalK + j] != (1U & messages_true[i * finalK + j])) {
+        result->error_pattern[i] = 1;
+        result->nof_errors++;
+        break;
+      }
+    }
+  }
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  srsran_ldpc_encoder_t encoder = {};
+  if (srsran_ldpc_encoder_init(&encoder, SRSRAN_LDPC_ENCODER_C, base_graph, lift_size) != 0) {
+    ERROR("Error initialising LDPC encoder");
+    exit(-1);
+  }
+
+  // Every decoder type is instantiated twice: running all iterations and with early stop
+  srsran_ldpc_decoder_t      decoders[NOF_DECODER_TYPES][2] = {};
+  srsran_ldpc_decoder_args_t decoder_args                   = {};
+  decoder_args.bg                                           = base_graph;
+  decoder_args.ls                                           = lift_size;
+  decoder_args.scaling_fctr                                 = MS_SF;
+  decoder_args.max_nof_iter                                 = max_nof_iter;
+  for (uint32_t d = 0; d < NOF_DECODER_TYPES; d++) {
+    for (uint32_t es = 0; es < 2; es++) {
+      decoder_args.type       = decoder_types[d].type;
+      decoder_args.early_stop = (es == 1);
+      if (srsran_ldpc_decoder_init(&decoders[d][es], &decoder_args) != 0) {
+        ERROR("Error initialising LDPC decoder %s", decoder_types[d].name);
+        exit(-1);
+      }
+    }
+  }
+
+  srsran_random_t random_gen = srsran_random_init(0);
+
+  uint32_t F      = encoder.bgK - 5; // This value is arbitrary
+  uint32_t finalK = encoder.liftK;
+  uint32_t finalN = encoder.liftN - 2 * lift_size;
+  if (rm_length == 0) {
+    rm_length = finalN - F;
+  }
+  // Closest multiple of the lifting size larger than rm_length, filler bits included
+  uint32_t n_useful_symbols =
+      (rm_length + F) % lift_size ? ((rm_length + F) / lift_size + 1) * lift_size : (rm_length + F);
+
+  uint8_t* messages_true = srsran_vec_u8_malloc(finalK * batch_size);
+  uint8_t* messages_rx   = srsran_vec_u8_malloc(finalK * batch_size);
+  uint8_t* codewords     = srsran_vec_u8_malloc(finalN * batch_size);
+  float*   symbols_rm    = srsran_vec_f_malloc((rm_length + F) * batch_size);
+  float*   symbols       = srsran_vec_f_malloc(finalN * batch_size);
+  int8_t*  symbols_c     = srsran_vec_i8_malloc(finalN * batch_size);
+  uint8_t* error_pattern = srsran_vec_u8_malloc(2 * batch_size);
+  if (!messages_true || !messages_rx || !codewords || !symbols_rm || !symbols || !symbols_c || !error_pattern) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  printf("LDPC decoding BG%d, LS=%d, K=%d, F=%d, E=%d, rate %.3f, %d iterations max, %d codewords per point\n",
+         base_graph + 1,
+         lift_size,
+         finalK,
+         F,
+         rm_length,
+         (double)(finalK - F) / rm_length,
+         max_nof_iter,
+         batch_size);
+  printf("  SNR (dB) |      Decoder |       WER | avg iter | Mbps fixed | Mbps early |  gain\n");
+
+  bool mismatch = false;
+  for (float snr = snr_min; snr <= snr_max + 1e-3f; snr += snr_step) {
+    float noise_var     = srsran_convert_dB_to_power(-snr);
+    float noise_std_dev = srsran_convert_dB_to_amplitude(-snr);
+
+    int8_t inf7   = (1U << 6U) - 1;
+    float  gain_c = inf7 * noise_std_dev / 8 / (1 / noise_std_dev + 2);
+
+    // Generate, encode and modulate the messages
+    for (uint32_t i = 0; i < batch_size; i++) {
+      for (uint32_t j = 0; j < finalK; j++) {
+        messages_true[i * finalK + j] =
+            (j < finalK - F) ? (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1) : FILLER_BIT;
+      }
+      srsran_ldpc_encoder_encode_rm(
+          &encoder, messages_true + i * finalK, codewords + i * finalN, finalK, n_useful_symbols);
+      for (uint32_t j = 0; j < rm_length + F; j++) {
+        uint8_t bit                         = codewords[i * finalN + j];
+        symbols_rm[i * (rm_length + F) + j] = (bit == FILLER_BIT) ? INFINITY : 1 - 2 * bit;
+      }
+    }
+
+    srsran_ch_awgn_f(symbols_rm, symbols_rm, noise_var, batch_size * (rm_length + F));
+
+    // Convert symbols into 8-bit LLRs, the punctured ones are set to 0
+    for (uint32_t i = 0; i < batch_size; i++) {
+      uint32_t j = 0;
+      for (; j < rm_length + F; j++) {
+        symbols[i * finalN + j] = symbols_rm[i * (rm_length + F) + j] * 2 / noise_var;
+      }
+      for (; j < finalN; j++) {
+        symbols[i * finalN + j] = 0;
+      }
+    }
+    srsran_vec_quant_fc(symbols, symbols_c, gain_c, 0, inf7, batch_size * finalN);
+
+    for (uint32_t d = 0; d < NOF_DECODER_TYPES; d++) {
+      bench_result_t results[2] = {};
+      for (uint32_t es = 0; es < 2; es++) {
+        results[es].error_pattern = error_pattern + es * batch_size;
+        decode_batch(
+            &decoders[d][es], symbols_c, messages_true, messages_rx, finalK, finalN, n_useful_symbols, &results[es]);
+      }
+
+      double nof_bits = (double)batch_size * (finalK - F);
+      printf("  %8.1f | %12s | %4.2f/%4.2f | %3.1f/%4.1f | %10.1f | %10.1f | %4.1fx\n",
+             snr,
+             decoder_types[d].name,
+             (double)results[0].nof_errors / batch_size,
+             (double)results[1].nof_errors / batch_size,
+             (double)results[0].nof_iter / batch_size,
+             (double)results[1].nof_iter / batch_size,
+             nof_bits / results[0].elapsed / 1e6,
+             nof_bits / results[1].elapsed / 1e6,
+             results[0].elapsed / results[1].elapsed);
+
+      // At the largest SNR both decoders must agree on every word
+      if (snr + snr_step > snr_max + 1e-3f && memcmp(results[0].error_pattern, results[1].error_pattern, batch_size)) {
+        ERROR("Early stop changed the decoding outcome of decoder %s", decoder_types[d].name);
+        mismatch = true;
+      }
+    }
+  }
+
+  ret = mismatch ? SRSRAN_ERROR : SRSRAN_SUCCESS;
+
+  free(messages_true);
+  free(messages_rx);
+  free(codewords);
+  free(symbols_rm);
+  free(symbols);
+  free(symbols_c);
+  free(error_pattern);
+  srsran_random_free(random_gen);
+  srsran_ldpc_encoder_free(&encoder);
+  for (uint32_t d = 0; d < NOF_DECODER_TYPES; d++) {
+    srsran_ldpc_decoder_free(&decoders[d][0]);
+    srsran_ldpc_decoder_free(&decoders[d][1]);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
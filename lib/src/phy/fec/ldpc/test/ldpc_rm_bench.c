@@ -0,0 +1,278 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file ldpc_rm_bench.c
+ * \brief Throughput benchmark for the LDPC RateDematcher.
+ *
+ * A codeword is rate-matched with the four redundancy versions and the rate-matched LLR of all of them are soft
+ * combined (HARQ) by the three types of rate dematchers (float, int16_t, int8_t) for every modulation. The combined
+ * codeword signs are checked against the transmitted codeword, and the rate dematching throughput is reported in
+ * millions of LLR per second.
+ *
+ * Synopsis: **ldpc_rm_bench [options]**
+ *
+ * Options:
+ *  - **-b \<number\>** Base Graph (1 or 2. Default 1).
+ *  - **-l \<number\>** Lifting Size (according to 5GNR standard. Default 384).
+ *  - **-e \<number\>** Codeword length after rate matching (set to 0 [default] for half the codeword length).
+ *  - **-f \<number\>** Number of filler bits (Default 100).
+ *  - **-R \<number\>** Number of repetitions (Default 1000).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/fec/ldpc/ldpc_common.h"
+#include "srsran/phy/fec/ldpc/ldpc_encoder.h"
+#include "srsran/phy/fec/ldpc/ldpc_rm.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+#define NOF_RV 4
+
+static srsran_basegraph_t base_graph = BG1;  /*!< \brief Base Graph (BG1 or BG2). */
+static uint32_t           lift_size  = 384;  /*!< \brief Lifting Size. */
+static uint32_t           E          = 0;    /*!< \brief Rate-matched codeword size (0 for N / 2). */
+static uint32_t           F          = 100;  /*!< \brief Number of filler bits. */
+static uint32_t           nof_reps   = 1000; /*!< \brief Number of repetitions. */
+
+/*!
+ * \brief Prints test help when a wrong parameter is passed as input.
+ */
+void usage(char* prog)
+{
+  printf("Usage: %s [-bX] [-lX] [-eX] [-fX] [-RX]\n", prog);
+  printf("\t-b Base Graph [(1 or 2) Default %d]\n", base_graph + 1);
+  printf("\t-l Lifting Size [Default %d]\n", lift_size);
+  printf("\t-e Word length after rate matching [Default %d (half the codeword length)]\n", E);
+  printf("\t-f Filler bits size (F) [Default %d]\n", F);
+  printf("\t-R Number of repetitions [Default %d]\n", nof_reps);
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "b:l:e:f:R:")) != -1) {
+    switch (opt) {
+      case 'b':
+        base_graph = (uint32_t)strtol(optarg, NULL, 10) - 1;
+        break;
+      case 'l':
+        lift_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'e':
+        E = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'f':
+        F = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 'R':
+        nof_reps = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*!
+ * \brief Checks that the combined LLR agree with the codeword: filler bits are positive and any non-zero LLR has the
+ * sign of the codeword bit.
+ */
+static int check_combined(const uint8_t* codeword, uint32_t N, float (*llr)(const void*, uint32_t), const void* buf)
+{
+  for (uint32_t i = 0; i < N; i++) {
+    float v = llr(buf, i);
+    if ((codeword[i] == FILLER_BIT && v <= 0) || (codeword[i] == 1 && v > 0) || (codeword[i] == 0 && v < 0)) {
+      return SRSRAN_ERROR;
+    }
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static float llr_f(const void* buf, uint32_t i)
+{
+  return ((const float*)buf)[i];
+}
+
+static float llr_s(const void* buf, uint32_t i)
+{
+  return ((const int16_t*)buf)[i];
+}
+
+static float llr_c(const void* buf, uint32_t i)
+{
+  return ((const int8_t*)buf)[i];
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  srsran_random_t random_gen = srsran_random_init(0);
+
+  srsran_ldpc_encoder_t encoder = {};
+  srsran_ldpc_rm_t      rm_tx   = {};
+  srsran_ldpc_rm_t      rm_rx_f = {};
+  srsran_ldpc_rm_t      rm_rx_s = {};
+  srsran_ldpc_rm_t      rm_rx_c = {};
+  if (srsran_ldpc_encoder_init(&encoder, SRSRAN_LDPC_ENCODER_C, base_graph, lift_size) != 0 ||
+      srsran_ldpc_rm_tx_init(&rm_tx) != 0 || srsran_ldpc_rm_rx_init_f(&rm_rx_f) != 0 ||
+      srsran_ldpc_rm_rx_init_s(&rm_rx_s) != 0 || srsran_ldpc_rm_rx_init_c(&rm_rx_c) != 0) {
+    ERROR("Error initialising LDPC encoder and rate matchers");
+    exit(-1);
+  }
+
+  uint32_t K = encoder.liftK;
+  uint32_t N = encoder.liftN - 2 * lift_size;
+  if (E == 0) {
+    E = N / 2;
+  }
+
+  uint8_t* codeblock    = srsran_vec_u8_malloc(K);
+  uint8_t* codeword     = srsran_vec_u8_malloc(N);
+  uint8_t* rm_codewords = srsran_vec_u8_malloc(NOF_RV * E);
+  float*   llr_rm_f     = srsran_vec_f_malloc(NOF_RV * E);
+  int16_t* llr_rm_s     = srsran_vec_i16_malloc(NOF_RV * E);
+  int8_t*  llr_rm_c     = srsran_vec_i8_malloc(NOF_RV * E);
+  float*   softbuffer_f = srsran_vec_f_malloc(N);
+  int16_t* softbuffer_s = srsran_vec_i16_malloc(N);
+  int8_t*  softbuffer_c = srsran_vec_i8_malloc(N);
+  if (!codeblock || !codeword || !rm_codewords || !llr_rm_f || !llr_rm_s || !llr_rm_c || !softbuffer_f ||
+      !softbuffer_s || !softbuffer_c) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  for (uint32_t i = 0; i < K; i++) {
+    codeblock[i] = (i < K - F) ? (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1) : FILLER_BIT;
+  }
+  if (srsran_ldpc_encoder_encode(&encoder, codeblock, codeword, K) != 0) {
+    ERROR("Error encoding");
+    goto clean_exit;
+  }
+
+  printf("LDPC rate dematching BG%d, LS=%d, N=%d, E=%d, F=%d, %d RV combined\n",
+         base_graph + 1,
+         lift_size,
+         N,
+         E,
+         F,
+         NOF_RV);
+  printf("  Modulation |    float |  int16_t |   int8_t (MLLR/s)\n");
+
+  for (srsran_mod_t mod = SRSRAN_MOD_BPSK; mod < SRSRAN_MOD_NITEMS; mod++) {
+    uint32_t E_mod = E - E % srsran_mod_bits_x_symbol(mod);
+
+    // Rate match all redundancy versions and modulate as 2-PAM with an amplitude that does not saturate
+    for (uint32_t rv = 0; rv < NOF_RV; rv++) {
+      if (srsran_ldpc_rm_tx(&rm_tx, codeword, rm_codewords + rv * E, E_mod, base_graph, lift_size, rv, mod, N) != 0) {
+        ERROR("Error rate matching");
+        goto clean_exit;
+      }
+      for (uint32_t i = 0; i < E_mod; i++) {
+        int8_t s             = rm_codewords[rv * E + i] ? -1 : 1;
+        llr_rm_f[rv * E + i] = s;
+        llr_rm_s[rv * E + i] = s;
+        llr_rm_c[rv * E + i] = s;
+      }
+    }
+
+    double elapsed[3] = {};
+    for (uint32_t r = 0; r < nof_reps; r++) {
+      struct timeval t[3];
+
+      srsran_vec_f_zero(softbuffer_f, N);
+      gettimeofday(&t[1], NULL);
+      for (uint32_t rv = 0; rv < NOF_RV; rv++) {
+        srsran_ldpc_rm_rx_f(&rm_rx_f, llr_rm_f + rv * E, softbuffer_f, E_mod, F, base_graph, lift_size, rv, mod, N);
+      }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      elapsed[0] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+      srsran_vec_i16_zero(softbuffer_s, N);
+      gettimeofday(&t[1], NULL);
+      for (uint32_t rv = 0; rv < NOF_RV; rv++) {
+        srsran_ldpc_rm_rx_s(&rm_rx_s, llr_rm_s + rv * E, softbuffer_s, E_mod, F, base_graph, lift_size, rv, mod, N);
+      }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      elapsed[1] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+      srsran_vec_i8_zero(softbuffer_c, N);
+      gettimeofday(&t[1], NULL);
+      for (uint32_t rv = 0; rv < NOF_RV; rv++) {
+        srsran_ldpc_rm_rx_c(&rm_rx_c, llr_rm_c + rv * E, softbuffer_c, E_mod, F, base_graph, lift_size, rv, mod, N);
+      }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      elapsed[2] += t[0].tv_sec + 1e-6 * t[0].tv_usec;
+    }
+
+    if (check_combined(codeword, N, llr_f, softbuffer_f) != SRSRAN_SUCCESS ||
+        check_combined(codeword, N, llr_s, softbuffer_s) != SRSRAN_SUCCESS ||
+        check_combined(codeword, N, llr_c, softbuffer_c) != SRSRAN_SUCCESS) {
+      ERROR("Combined LLR do not match the codeword for %s", srsran_mod_string(mod));
+      goto clean_exit;
+    }
+
+    double nof_llr = (double)nof_reps * NOF_RV * E_mod;
+    printf("  %10s | %8.1f | %8.1f | %8.1f\n",
+           srsran_mod_string(mod),
+           nof_llr / elapsed[0] / 1e6,
+           nof_llr / elapsed[1] / 1e6,
+           nof_llr / elapsed[2] / 1e6);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  free(codeblock);
+  free(codeword);
+  free(rm_codewords);
+  free(llr_rm_f);
+  free(llr_rm_s);
+  free(llr_rm_c);
+  free(softbuffer_f);
+  free(softbuffer_s);
+  free(softbuffer_c);
+  srsran_random_free(random_gen);
+  srsran_ldpc_encoder_free(&encoder);
+  srsran_ldpc_rm_tx_free(&rm_tx);
+  srsran_ldpc_rm_rx_free_f(&rm_rx_f);
+  srsran_ldpc_rm_rx_free_s(&rm_rx_s);
+  srsran_ldpc_rm_rx_free_c(&rm_rx_c);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
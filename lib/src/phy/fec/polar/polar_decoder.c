@@ -37,8 +37,10 @@
 #include <math.h>
 #include <string.h>
 
+#include "polar_decoder_scl_c.h"
 #include "polar_decoder_ssc_c.h"
 #include "polar_decoder_ssc_c_avx2.h"
+#include "polar_decoder_ssc_c_batch.h"
 #include "polar_decoder_ssc_f.h"
 #include "polar_decoder_ssc_s.h"
 #include "srsran/phy/fec/polar/polar_decoder.h"
@@ -114,6 +116,52 @@ static int decode_ssc_c_avx2(void*           o,
 }
 #endif // LV_HAVE_AVX2
 
+/*! SCL Polar decoder with int8_t LLR inputs, only the most likely candidate is returned. */
+static int decode_scl_c(void*           o,
+                        const int8_t*   symbols,
+                        uint8_t*        data,
+                        const uint8_t   n,
+                        const uint16_t* frozen_set,
+                        const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  if (polar_decoder_scl_c(q->ptr, symbols, data, n, frozen_set, frozen_set_size, 1) < 1) {
+    return -1;
+  }
+
+  return 0;
+}
+
+/*! SCL Polar decoder with int8_t LLR inputs, all the candidates in the list are returned. */
+static int decode_list_scl_c(void*           o,
+                             const int8_t*   symbols,
+                             uint8_t*        data,
+                             const uint8_t   n,
+                             const uint16_t* frozen_set,
+                             const uint16_t  frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  return polar_decoder_scl_c(q->ptr, symbols, data, n, frozen_set, frozen_set_size, q->list_size);
+}
+
+#ifdef LV_HAVE_AVX2
+/*! Batch SSC Polar decoder AVX2 with int8_t LLR inputs. */
+static int decode_batch_ssc_c_avx2(void*                o,
+                                   const int8_t* const* symbols,
+                                   uint8_t* const*      data,
+                                   const uint32_t       nof_codewords,
+                                   const uint8_t        n,
+                                   const uint16_t*      frozen_set,
+                                   const uint16_t       frozen_set_size)
+{
+  srsran_polar_decoder_t* q = o;
+
+  return polar_decoder_ssc_c_batch(q->ptr_batch, symbols, data, nof_codewords, n, frozen_set, frozen_set_size);
+}
+#endif // LV_HAVE_AVX2
+
 /*! Destructor of a (float) SSC polar decoder. */
 static void free_ssc_f(void* o)
 {
@@ -141,9 +189,17 @@ static void free_ssc_c_avx2(void* o)
 {
   srsran_polar_decoder_t* q = o;
   delete_polar_decoder_ssc_c_avx2(q->ptr);
+  delete_polar_decoder_ssc_c_batch(q->ptr_batch);
 }
 #endif
 
+/*! Destructor of a (int8_t) SCL polar decoder. */
+static void free_scl_c(void* o)
+{
+  srsran_polar_decoder_t* q = o;
+  delete_polar_decoder_scl_c(q->ptr);
+}
+
 /*! Initializes a polar decoder structure to use the SSC polar decoder algorithm with float LLR inputs. */
 static int init_ssc_f(srsran_polar_decoder_t* q)
 {
@@ -191,21 +247,45 @@ static int init_ssc_c(srsran_polar_decoder_t* q)
  * instructions. */
 static int init_ssc_c_avx2(srsran_polar_decoder_t* q)
 {
-  q->decode_c = decode_ssc_c_avx2;
-  q->free     = free_ssc_c_avx2;
+  q->decode_c       = decode_ssc_c_avx2;
+  q->decode_batch_c = decode_batch_ssc_c_avx2;
+  q->free           = free_ssc_c_avx2;
 
   if ((q->ptr = create_polar_decoder_ssc_c_avx2(q->nMax)) == NULL) {
     ERROR("create_polar_decoder_ssc_c failed");
     free_ssc_c_avx2(q);
     return -1;
   }
+  if ((q->ptr_batch = create_polar_decoder_ssc_c_batch(q->nMax)) == NULL) {
+    ERROR("create_polar_decoder_ssc_c_batch failed");
+    return -1;
+  }
   return 0;
 }
 #endif
 
+/*! Initializes a polar decoder structure to use the SCL polar decoder algorithm with uint8_t LLR inputs. */
+static int init_scl_c(srsran_polar_decoder_t* q, uint8_t list_size)
+{
+  q->decode_c      = decode_scl_c;
+  q->decode_list_c = decode_list_scl_c;
+  q->free          = free_scl_c;
+  q->list_size     = list_size;
+
+  if ((q->ptr = create_polar_decoder_scl_c(q->nMax, list_size)) == NULL) {
+    ERROR("create_polar_decoder_scl_c failed");
+    return -1;
+  }
+  return 0;
+}
+
 int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_type_t type, const uint8_t nMax)
 {
-  q->nMax = nMax;
+  q->nMax           = nMax;
+  q->list_size      = 1;
+  q->ptr_batch      = NULL;
+  q->decode_list_c  = NULL;
+  q->decode_batch_c = NULL;
   switch (type) {
     case SRSRAN_POLAR_DECODER_SSC_F:
       return init_ssc_f(q);
@@ -217,6 +297,12 @@ int srsran_polar_decoder_init(srsran_polar_decoder_t* q, srsran_polar_decoder_ty
     case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
       return init_ssc_c_avx2(q);
 #endif
+    case SRSRAN_POLAR_DECODER_SCL2_C:
+      return init_scl_c(q, 2);
+    case SRSRAN_POLAR_DECODER_SCL4_C:
+      return init_scl_c(q, 4);
+    case SRSRAN_POLAR_DECODER_SCL8_C:
+      return init_scl_c(q, 8);
     default:
       ERROR("Decoder not implemented");
       return -1;
@@ -273,3 +359,59 @@ int srsran_polar_decoder_decode_c(srsran_polar_decoder_t* q,
 
   return -1;
 }
+
+int srsran_polar_decoder_decode_list_c(srsran_polar_decoder_t* q,
+                                       const int8_t*           llr,
+                                       uint8_t*                data_decoded,
+                                       const uint8_t           n,
+                                       const uint16_t*         frozen_set,
+                                       const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n) {
+    return -1;
+  }
+
+  if (q->decode_list_c == NULL) {
+    return (q->decode_c(q, llr, data_decoded, n, frozen_set, frozen_set_size) < 0) ? -1 : 1;
+  }
+
+  return q->decode_list_c(q, llr, data_decoded, n, frozen_set, frozen_set_size);
+}
+
+int srsran_polar_decoder_decode_batch_c(srsran_polar_decoder_t* q,
+                                        const int8_t* const*    llr,
+                                        uint8_t* const*         data_decoded,
+                                        const uint32_t          nof_codewords,
+                                        const uint8_t           n,
+                                        const uint16_t*         frozen_set,
+                                        const uint16_t          frozen_set_size)
+{
+  if (q->nMax < n || nof_codewords > SRSRAN_POLAR_DECODER_MAX_BATCH) {
+    return -1;
+  }
+
+  if (q->decode_batch_c == NULL) {
+    for (uint32_t i = 0; i < nof_codewords; i++) {
+      if (q->decode_c(q, llr[i], data_decoded[i], n, frozen_set, frozen_set_size) < 0) {
+        return -1;
+      }
+    }
+    return 0;
+  }
+
+  return q->decode_batch_c(q, llr, data_decoded, nof_codewords, n, frozen_set, frozen_set_size);
+}
+
+srsran_polar_decoder_type_t srsran_polar_decoder_type_from_list_size(uint32_t list_size)
+{
+  if (list_size <= 1) {
+    return SRSRAN_POLAR_DECODER_SSC_C;
+  }
+  if (list_size <= 2) {
+    return SRSRAN_POLAR_DECODER_SCL2_C;
+  }
+  if (list_size <= 4) {
+    return SRSRAN_POLAR_DECODER_SCL4_C;
+  }
+  return SRSRAN_POLAR_DECODER_SCL8_C;
+}
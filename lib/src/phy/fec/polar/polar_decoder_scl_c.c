@@ -0,0 +1,735 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_c.c
+ * \brief Definition of the CRC-aided Successive Cancellation List (SCL) polar decoder inner functions working with
+ * 8-bit integer-valued LLRs.
+ *
+ * The LLR (\f$\alpha\f$) and bit (\f$\beta\f$) buffers of every stage interleave the L paths of the list: row i of
+ * stage s holds the i-th value of L columns, so that the f and g functions, the hard decisions and the path metric
+ * penalties of all the paths are computed at once on contiguous memory. Paths do not own a column, they read their
+ * values through a per-stage column map: cloning a path only copies its map entries, and the rows are shuffled back
+ * to path order whenever a stage is written.
+ *
+ */
+
+#include "polar_decoder_scl_c.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/utils/vector.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+#endif // LV_HAVE_AVX2
+
+#define SCL_MAX_L 8                   /*!< \brief Maximum number of paths in the list. */
+#define SCL_MAX_STAGES (NMAX_LOG + 1) /*!< \brief Maximum number of stages in the decoding tree. */
+#define SCL_PAD 32                    /*!< \brief Slack after each stage buffer, the SIMD kernels work on 32 bytes. */
+
+/*!
+ * \brief Describes a path expansion candidate.
+ */
+typedef struct {
+  int32_t pm;   /*!< \brief Path metric of the candidate. */
+  uint8_t path; /*!< \brief Index of the parent path. */
+  uint8_t bit;  /*!< \brief Decision taken by the candidate. */
+} scl_candidate_t;
+
+/*!
+ * \brief Describes an SCL polar decoder (8-bit version).
+ */
+struct pSCL_c {
+  uint8_t                 nMax;                                 /*!< \brief \f$log_2\f$ of the maximum code size. */
+  uint8_t                 L;                                    /*!< \brief Number of paths in the list. */
+  uint8_t                 code_size_log;                        /*!< \brief \f$log_2\f$ of the current code size. */
+  uint16_t*               info_count;                           /*!< \brief Information bits before each position. */
+  int8_t*                 alpha[SCL_MAX_STAGES];                /*!< \brief LLRs per stage, 2^s rows of L columns. */
+  uint8_t*                beta[SCL_MAX_STAGES];                 /*!< \brief Bits per stage, 2^s rows of L columns. */
+  uint8_t                 alpha_col[SCL_MAX_STAGES][SCL_MAX_L]; /*!< \brief LLR column of each path. */
+  uint8_t                 beta_col[SCL_MAX_STAGES][SCL_MAX_L];  /*!< \brief Bit column of each path. */
+  bool                    active[SCL_MAX_L];                    /*!< \brief Indicates the paths in the list. */
+  int32_t                 pm[SCL_MAX_L];                        /*!< \brief Path metrics (lower is more likely). */
+  uint16_t                flip[SCL_MAX_L][SCL_MAX_L - 1];       /*!< \brief Least reliable bits of the Rate-1 node. */
+  uint8_t                 flipped[SCL_MAX_L];                   /*!< \brief Least reliable bits flipped (bitmap). */
+  uint8_t*                path_bits;                            /*!< \brief Estimated codeword of a single path. */
+  srsran_polar_encoder_t* enc;                                  /*!< \brief Pointer to a srsran_polar_encoder_t. */
+};
+
+static inline void scl_identity(uint8_t* col)
+{
+  for (uint8_t l = 0; l < SCL_MAX_L; l++) {
+    col[l] = l;
+  }
+}
+
+#ifdef LV_HAVE_AVX2
+/*!
+ * Returns the byte shuffle that takes, in every row of \a L bytes, column \a col[l] to column l.
+ */
+static inline __m256i scl_shuffle(const uint8_t* col, const uint8_t L)
+{
+  uint8_t m[16];
+  for (uint8_t b = 0; b < 16; b++) {
+    m[b] = (b & ~(L - 1)) + col[b & (L - 1)];
+  }
+  return _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)m));
+}
+#endif // LV_HAVE_AVX2
+
+/*!
+ * Computes \f$ z = \mathrm{sgn}(x) \mathrm{sgn}(y) \min(|x|, |y|) \f$ on \a len bytes, taking the columns of \a x and
+ * \a y given by \a col.
+ */
+static void scl_f(const int8_t* x, const int8_t* y, int8_t* z, const uint32_t len, const uint8_t L, const uint8_t* col)
+{
+#ifdef LV_HAVE_AVX2
+  __m256i shuf_ = scl_shuffle(col, L);
+  for (uint32_t i = 0; i < len; i += 32) {
+    __m256i x_   = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(x + i)), shuf_);
+    __m256i y_   = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(y + i)), shuf_);
+    __m256i abs_ = _mm256_min_epu8(_mm256_abs_epi8(x_), _mm256_abs_epi8(y_));
+    // Force a non-zero sign operand, otherwise equal inputs would give a zero output
+    __m256i sgn_ = _mm256_or_si256(_mm256_xor_si256(x_, y_), _mm256_set1_epi8(1));
+    _mm256_storeu_si256((__m256i*)(z + i), _mm256_sign_epi8(abs_, sgn_));
+  }
+#else
+  for (uint32_t i = 0; i < len; i += L) {
+    for (uint8_t l = 0; l < L; l++) {
+      int8_t xl    = x[i + col[l]];
+      int8_t yl    = y[i + col[l]];
+      int8_t abs_x = (int8_t)abs(xl);
+      int8_t abs_y = (int8_t)abs(yl);
+      int8_t m     = (abs_x < abs_y) ? abs_x : abs_y;
+      z[i + l]     = ((xl ^ yl) < 0) ? -m : m;
+    }
+  }
+#endif // LV_HAVE_AVX2
+}
+
+/*!
+ * Computes \f$ z = y + (1 - 2b) x \f$, saturated to \f$[-127, 127]\f$, on \a len bytes, taking the columns of \a b
+ * given by \a col_b and the columns of \a x and \a y given by \a col_a.
+ */
+static void scl_g(const uint8_t* b,
+                  const int8_t*  x,
+                  const int8_t*  y,
+                  int8_t*        z,
+                  const uint32_t len,
+                  const uint8_t  L,
+                  const uint8_t* col_b,
+                  const uint8_t* col_a)
+{
+#ifdef LV_HAVE_AVX2
+  __m256i shuf_b_ = scl_shuffle(col_b, L);
+  __m256i shuf_a_ = scl_shuffle(col_a, L);
+  for (uint32_t i = 0; i < len; i += 32) {
+    __m256i b_   = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(b + i)), shuf_b_);
+    __m256i x_   = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(x + i)), shuf_a_);
+    __m256i y_   = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(y + i)), shuf_a_);
+    __m256i m_   = _mm256_sub_epi8(_mm256_setzero_si256(), b_);
+    __m256i bx_  = _mm256_sub_epi8(_mm256_xor_si256(x_, m_), m_);
+    __m256i res_ = _mm256_max_epi8(_mm256_adds_epi8(y_, bx_), _mm256_set1_epi8(-127));
+    _mm256_storeu_si256((__m256i*)(z + i), res_);
+  }
+#else
+  for (uint32_t i = 0; i < len; i += L) {
+    for (uint8_t l = 0; l < L; l++) {
+      int8_t  xl  = x[i + col_a[l]];
+      int16_t tmp = (int16_t)y[i + col_a[l]] + (b[i + col_b[l]] ? -xl : xl);
+      z[i + l]    = (int8_t)((tmp > 127) ? 127 : (tmp < -127) ? -127 : tmp);
+    }
+  }
+#endif // LV_HAVE_AVX2
+}
+
+/*!
+ * Computes \f$ z = x \oplus y \f$ on \a len bytes, taking the columns of \a x given by \a col_x and the columns of \a y
+ * given by \a col_y. The output can overwrite \a x.
+ */
+static void scl_xor(const uint8_t* x,
+                    const uint8_t* y,
+                    uint8_t*       z,
+                    const uint32_t len,
+                    const uint8_t  L,
+                    const uint8_t* col_x,
+                    const uint8_t* col_y)
+{
+#ifdef LV_HAVE_AVX2
+  __m256i shuf_x_ = scl_shuffle(col_x, L);
+  __m256i shuf_y_ = scl_shuffle(col_y, L);
+  for (uint32_t i = 0; i < len; i += 32) {
+    __m256i x_ = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(x + i)), shuf_x_);
+    __m256i y_ = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(y + i)), shuf_y_);
+    _mm256_storeu_si256((__m256i*)(z + i), _mm256_xor_si256(x_, y_));
+  }
+#else
+  uint8_t row[SCL_MAX_L];
+  for (uint32_t i = 0; i < len; i += L) {
+    for (uint8_t l = 0; l < L; l++) {
+      row[l] = x[i + col_x[l]] ^ y[i + col_y[l]];
+    }
+    memcpy(z + i, row, L);
+  }
+#endif // LV_HAVE_AVX2
+}
+
+/*!
+ * Copies \a len bytes of \a x to \a z, taking the columns given by \a col.
+ */
+static void scl_copy(const uint8_t* x, uint8_t* z, const uint32_t len, const uint8_t L, const uint8_t* col)
+{
+#ifdef LV_HAVE_AVX2
+  __m256i shuf_ = scl_shuffle(col, L);
+  for (uint32_t i = 0; i < len; i += 32) {
+    _mm256_storeu_si256((__m256i*)(z + i), _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(x + i)), shuf_));
+  }
+#else
+  for (uint32_t i = 0; i < len; i += L) {
+    for (uint8_t l = 0; l < L; l++) {
+      z[i + l] = x[i + col[l]];
+    }
+  }
+#endif // LV_HAVE_AVX2
+}
+
+/*!
+ * Takes the hard decisions of \a len LLRs, taking the columns of \a x given by \a col.
+ */
+static void scl_hard(const int8_t* x, uint8_t* z, const uint32_t len, const uint8_t L, const uint8_t* col)
+{
+#ifdef LV_HAVE_AVX2
+  __m256i shuf_ = scl_shuffle(col, L);
+  for (uint32_t i = 0; i < len; i += 32) {
+    __m256i x_ = _mm256_shuffle_epi8(_mm256_loadu_si256((__m256i*)(x + i)), shuf_);
+    __m256i z_ = _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_setzero_si256(), x_), _mm256_set1_epi8(1));
+    _mm256_storeu_si256((__m256i*)(z + i), z_);
+  }
+#else
+  for (uint32_t i = 0; i < len; i += L) {
+    for (uint8_t l = 0; l < L; l++) {
+      z[i + l] = (x[i + col[l]] < 0) ? 1 : 0;
+    }
+  }
+#endif // LV_HAVE_AVX2
+}
+
+/*!
+ * Computes, for each of the L columns of \a x, the sum of the magnitudes of the LLRs that disagree with bit 0
+ * (\a pen0) and with bit 1 (\a pen1).
+ */
+static void scl_penalty(const int8_t* x, const uint32_t len, const uint8_t L, int32_t* pen0, int32_t* pen1)
+{
+  uint32_t i = 0;
+
+  memset(pen0, 0, L * sizeof(int32_t));
+  memset(pen1, 0, L * sizeof(int32_t));
+#ifdef LV_HAVE_AVX2
+  if (len >= 32) {
+    // Every 16-bit lane adds at most len / 32 magnitudes of up to 127, which cannot overflow for len <= 8 * 2^10
+    __m256i zero_    = _mm256_setzero_si256();
+    __m256i acc0_lo_ = zero_;
+    __m256i acc0_hi_ = zero_;
+    __m256i acc1_lo_ = zero_;
+    __m256i acc1_hi_ = zero_;
+    for (; i + 32 <= len; i += 32) {
+      __m256i x_   = _mm256_loadu_si256((__m256i*)(x + i));
+      __m256i neg_ = _mm256_max_epi8(_mm256_sub_epi8(zero_, x_), zero_);
+      __m256i pos_ = _mm256_max_epi8(x_, zero_);
+      acc0_lo_     = _mm256_add_epi16(acc0_lo_, _mm256_unpacklo_epi8(neg_, zero_));
+      acc0_hi_     = _mm256_add_epi16(acc0_hi_, _mm256_unpackhi_epi8(neg_, zero_));
+      acc1_lo_     = _mm256_add_epi16(acc1_lo_, _mm256_unpacklo_epi8(pos_, zero_));
+      acc1_hi_     = _mm256_add_epi16(acc1_hi_, _mm256_unpackhi_epi8(pos_, zero_));
+    }
+
+    uint16_t acc[4][16];
+    _mm256_storeu_si256((__m256i*)acc[0], acc0_lo_);
+    _mm256_storeu_si256((__m256i*)acc[1], acc0_hi_);
+    _mm256_storeu_si256((__m256i*)acc[2], acc1_lo_);
+    _mm256_storeu_si256((__m256i*)acc[3], acc1_hi_);
+    for (uint32_t k = 0; k < 16; k++) {
+      // The low (high) unpack takes bytes 0 to 7 (8 to 15) of each 128-bit lane
+      uint32_t c_lo = ((k / 8) * 16 + k % 8) & (L - 1U);
+      uint32_t c_hi = ((k / 8) * 16 + k % 8 + 8) & (L - 1U);
+      pen0[c_lo] += acc[0][k];
+      pen0[c_hi] += acc[1][k];
+      pen1[c_lo] += acc[2][k];
+      pen1[c_hi] += acc[3][k];
+    }
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < len; i++) {
+    pen0[i & (L - 1U)] += (x[i] < 0) ? -x[i] : 0;
+    pen1[i & (L - 1U)] += (x[i] > 0) ? x[i] : 0;
+  }
+}
+
+/*!
+ * Finds the \a nof_pos rows of column \a c of \a x with the smallest magnitude, in increasing order of magnitude.
+ */
+static void scl_least_reliable(const int8_t*  x,
+                               const uint16_t rows,
+                               const uint8_t  L,
+                               const uint8_t  c,
+                               uint16_t*      pos,
+                               const uint32_t nof_pos)
+{
+  uint8_t  mag[SCL_MAX_L];
+  uint32_t count = 0;
+
+  for (uint16_t i = 0; i < rows; i++) {
+    uint8_t m = (uint8_t)abs(x[(uint32_t)i * L + c]);
+    if (count == nof_pos && m >= mag[nof_pos - 1]) {
+      continue;
+    }
+    uint32_t j = (count < nof_pos) ? count++ : nof_pos - 1;
+    for (; j > 0 && mag[j - 1] > m; j--) {
+      mag[j] = mag[j - 1];
+      pos[j] = pos[j - 1];
+    }
+    mag[j] = m;
+    pos[j] = i;
+  }
+}
+
+static void kill_path(struct pSCL_c* pp, const uint8_t l)
+{
+  pp->active[l] = false;
+}
+
+static void clone_path(struct pSCL_c* pp, const uint8_t src, const uint8_t dst)
+{
+  for (uint8_t s = 0; s <= pp->code_size_log; s++) {
+    pp->alpha_col[s][dst] = pp->alpha_col[s][src];
+    pp->beta_col[s][dst]  = pp->beta_col[s][src];
+  }
+  pp->pm[dst] = pp->pm[src];
+  memcpy(pp->flip[dst], pp->flip[src], sizeof(pp->flip[dst]));
+  pp->flipped[dst] = pp->flipped[src];
+  pp->active[dst]  = true;
+}
+
+/*!
+ * Sorts the candidates by increasing path metric, candidates with the same metric keep their order.
+ */
+static void scl_sort(scl_candidate_t* cand, const uint32_t nof_cand)
+{
+#ifdef LV_HAVE_AVX2
+  // The rank of a candidate is the number of candidates with a smaller (metric, index) key. Path metrics are below
+  // 127 * 2^10, so the key does not overflow
+  int32_t key[2 * SCL_MAX_L];
+  int32_t rank[2 * SCL_MAX_L];
+  for (uint32_t i = 0; i < 2 * SCL_MAX_L; i++) {
+    key[i] = (i < nof_cand) ? cand[i].pm * 2 * SCL_MAX_L + (int32_t)i : INT32_MAX;
+  }
+  __m256i key0_  = _mm256_loadu_si256((__m256i*)key);
+  __m256i key1_  = _mm256_loadu_si256((__m256i*)(key + 8));
+  __m256i rank0_ = _mm256_setzero_si256();
+  __m256i rank1_ = _mm256_setzero_si256();
+  for (uint32_t j = 0; j < nof_cand; j++) {
+    __m256i k_ = _mm256_set1_epi32(key[j]);
+    rank0_     = _mm256_sub_epi32(rank0_, _mm256_cmpgt_epi32(key0_, k_));
+    rank1_     = _mm256_sub_epi32(rank1_, _mm256_cmpgt_epi32(key1_, k_));
+  }
+  _mm256_storeu_si256((__m256i*)rank, rank0_);
+  _mm256_storeu_si256((__m256i*)(rank + 8), rank1_);
+
+  scl_candidate_t sorted[2 * SCL_MAX_L];
+  for (uint32_t i = 0; i < nof_cand; i++) {
+    sorted[rank[i]] = cand[i];
+  }
+  memcpy(cand, sorted, nof_cand * sizeof(scl_candidate_t));
+#else
+  for (uint32_t i = 1; i < nof_cand; i++) {
+    scl_candidate_t c = cand[i];
+    uint32_t        j = i;
+    for (; j > 0 && cand[j - 1].pm > c.pm; j--) {
+      cand[j] = cand[j - 1];
+    }
+    cand[j] = c;
+  }
+#endif // LV_HAVE_AVX2
+}
+
+/*!
+ * Keeps the (at most L) most likely candidates. Parent paths without any surviving candidate are removed from the
+ * list and parent paths with two surviving candidates are cloned. The path that follows the i-th kept candidate is
+ * written in \a path[i].
+ *
+ * \return The number of kept candidates.
+ */
+static uint32_t scl_select(struct pSCL_c* pp, scl_candidate_t* cand, const uint32_t nof_cand, uint8_t* path)
+{
+  // Sort candidates by increasing path metric (there are at most 2L), unless all of them are kept
+  if (nof_cand > pp->L) {
+    scl_sort(cand, nof_cand);
+  }
+
+  uint32_t nof_sel                 = (nof_cand < pp->L) ? nof_cand : pp->L;
+  uint8_t  nof_children[SCL_MAX_L] = {};
+  for (uint32_t i = 0; i < nof_sel; i++) {
+    nof_children[cand[i].path]++;
+  }
+  for (uint8_t l = 0; l < pp->L; l++) {
+    if (pp->active[l] && nof_children[l] == 0) {
+      kill_path(pp, l);
+    }
+  }
+
+  bool used[SCL_MAX_L] = {};
+  for (uint32_t i = 0; i < nof_sel; i++) {
+    uint8_t l = cand[i].path;
+    if (!used[l]) {
+      used[l] = true;
+      path[i] = l;
+    } else {
+      uint8_t f = 0;
+      while (pp->active[f]) {
+        f++;
+      }
+      clone_path(pp, l, f);
+      path[i] = f;
+    }
+    pp->pm[path[i]] = cand[i].pm;
+  }
+
+  return nof_sel;
+}
+
+/*!
+ * All the bits below a Rate-0 node are frozen: the paths are penalized by the LLRs that disagree with the all-zero
+ * word.
+ */
+static void rate_0_node(struct pSCL_c* pp, const uint8_t s)
+{
+  uint32_t len = (uint32_t)pp->L << s;
+  int32_t  pen0[SCL_MAX_L];
+  int32_t  pen1[SCL_MAX_L];
+
+  scl_penalty(pp->alpha[s], len, pp->L, pen0, pen1);
+  for (uint8_t l = 0; l < pp->L; l++) {
+    if (pp->active[l]) {
+      pp->pm[l] += pen0[pp->alpha_col[s][l]];
+    }
+  }
+  memset(pp->beta[s], 0, len);
+  scl_identity(pp->beta_col[s]);
+}
+
+/*!
+ * The only information bit below a repetition node is the last one: every path is forked into the all-zero and the
+ * all-one word.
+ */
+static void rep_node(struct pSCL_c* pp, const uint8_t s)
+{
+  uint32_t        len = (uint32_t)pp->L << s;
+  int32_t         pen0[SCL_MAX_L];
+  int32_t         pen1[SCL_MAX_L];
+  scl_candidate_t cand[2 * SCL_MAX_L];
+  uint8_t         path[SCL_MAX_L];
+  uint32_t        nof_cand = 0;
+
+  scl_penalty(pp->alpha[s], len, pp->L, pen0, pen1);
+  for (uint8_t l = 0; l < pp->L; l++) {
+    if (pp->active[l]) {
+      uint8_t c        = pp->alpha_col[s][l];
+      cand[nof_cand++] = (scl_candidate_t){pp->pm[l] + pen0[c], l, 0};
+      cand[nof_cand++] = (scl_candidate_t){pp->pm[l] + pen1[c], l, 1};
+    }
+  }
+
+  uint32_t nof_sel         = scl_select(pp, cand, nof_cand, path);
+  uint8_t  bits[SCL_MAX_L] = {};
+  for (uint32_t i = 0; i < nof_sel; i++) {
+    bits[path[i]] = cand[i].bit;
+  }
+  for (uint32_t i = 0; i < len; i++) {
+    pp->beta[s][i] = bits[i & (pp->L - 1U)];
+  }
+  scl_identity(pp->beta_col[s]);
+}
+
+/*!
+ * All the bits below a Rate-1 node are information bits: the paths take the hard decisions and are then forked by
+ * flipping, one at a time, the min(L - 1, size) least reliable bits.
+ */
+static void rate_1_node(struct pSCL_c* pp, const uint8_t s)
+{
+  uint16_t        size      = 1U << s;
+  uint32_t        nof_flips = (pp->L - 1U < size) ? pp->L - 1U : size;
+  const int8_t*   a         = pp->alpha[s];
+  uint8_t*        b         = pp->beta[s];
+  scl_candidate_t cand[2 * SCL_MAX_L];
+  uint8_t         path[SCL_MAX_L];
+
+  for (uint8_t l = 0; l < pp->L; l++) {
+    if (pp->active[l]) {
+      scl_least_reliable(a, size, pp->L, pp->alpha_col[s][l], pp->flip[l], nof_flips);
+      pp->flipped[l] = 0;
+    }
+  }
+
+  for (uint32_t t = 0; t < nof_flips; t++) {
+    uint32_t nof_cand = 0;
+    for (uint8_t l = 0; l < pp->L; l++) {
+      if (pp->active[l]) {
+        int8_t x         = a[(uint32_t)pp->flip[l][t] * pp->L + pp->alpha_col[s][l]];
+        cand[nof_cand++] = (scl_candidate_t){pp->pm[l], l, 0};
+        cand[nof_cand++] = (scl_candidate_t){pp->pm[l] + abs(x), l, 1};
+      }
+    }
+
+    uint32_t nof_sel = scl_select(pp, cand, nof_cand, path);
+    for (uint32_t i = 0; i < nof_sel; i++) {
+      pp->flipped[path[i]] |= (uint8_t)(cand[i].bit << t);
+    }
+  }
+
+  // The surviving paths take the hard decisions of their LLR column and the flips along their history
+  scl_hard(a, b, (uint32_t)pp->L << s, pp->L, pp->alpha_col[s]);
+  for (uint8_t l = 0; l < pp->L; l++) {
+    for (uint32_t t = 0; t < nof_flips && pp->active[l]; t++) {
+      b[(uint32_t)pp->flip[l][t] * pp->L + l] ^= (pp->flipped[l] >> t) & 1U;
+    }
+  }
+  scl_identity(pp->beta_col[s]);
+}
+
+/*!
+ * Decodes the node of stage \a s whose first bit is \a first: the LLRs of the node are in the stage-\a s LLR buffer
+ * and the estimated bits are returned in the stage-\a s bit buffer.
+ */
+static void scl_node(struct pSCL_c* pp, const uint8_t s, const uint16_t first)
+{
+  uint16_t size     = 1U << s;
+  uint16_t nof_info = pp->info_count[first + size] - pp->info_count[first];
+
+  if (nof_info == 0) {
+    rate_0_node(pp, s);
+    return;
+  }
+  if (nof_info == size) {
+    rate_1_node(pp, s);
+    return;
+  }
+  if (nof_info == 1 && pp->info_count[first + size] != pp->info_count[first + size - 1]) {
+    rep_node(pp, s);
+    return;
+  }
+
+  // Rate-R node: left child
+  uint16_t h   = size / 2;
+  uint32_t len = (uint32_t)pp->L * h;
+  int8_t*  a   = pp->alpha[s];
+  scl_f(a, a + len, pp->alpha[s - 1], len, pp->L, pp->alpha_col[s]);
+  scl_identity(pp->alpha_col[s - 1]);
+  scl_node(pp, s - 1, first);
+
+  // Right child, the bits of the left child are kept in the first half of the stage-s bit buffer
+  scl_g(pp->beta[s - 1], a, a + len, pp->alpha[s - 1], len, pp->L, pp->beta_col[s - 1], pp->alpha_col[s]);
+  scl_identity(pp->alpha_col[s - 1]);
+  scl_copy(pp->beta[s - 1], pp->beta[s], len, pp->L, pp->beta_col[s - 1]);
+  scl_identity(pp->beta_col[s]);
+  scl_node(pp, s - 1, first + h);
+
+  // Combine the estimated bits of both children, the first half before the second one overwrites its overrun
+  scl_xor(pp->beta[s], pp->beta[s - 1], pp->beta[s], len, pp->L, pp->beta_col[s], pp->beta_col[s - 1]);
+  scl_copy(pp->beta[s - 1], pp->beta[s] + len, len, pp->L, pp->beta_col[s - 1]);
+  scl_identity(pp->beta_col[s]);
+}
+
+void delete_polar_decoder_scl_c(void* p)
+{
+  struct pSCL_c* pp = p;
+
+  if (pp == NULL) {
+    return;
+  }
+  if (pp->alpha[0]) {
+    free(pp->alpha[0]);
+  }
+  if (pp->beta[0]) {
+    free(pp->beta[0]);
+  }
+  if (pp->path_bits) {
+    free(pp->path_bits);
+  }
+  if (pp->info_count) {
+    free(pp->info_count);
+  }
+  if (pp->enc) {
+    srsran_polar_encoder_free(pp->enc);
+    free(pp->enc);
+  }
+  free(pp);
+}
+
+void* create_polar_decoder_scl_c(const uint8_t nMax, const uint8_t list_size)
+{
+  struct pSCL_c* pp = NULL;
+
+  // The column maps and the SIMD shuffles need a power-of-two list size
+  if (nMax > NMAX_LOG || list_size < 2 || list_size > SCL_MAX_L || (list_size & (list_size - 1)) != 0) {
+    return NULL;
+  }
+
+  if ((pp = malloc(sizeof(struct pSCL_c))) == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp, struct pSCL_c, 1);
+  pp->nMax = nMax;
+  pp->L    = list_size;
+
+  // Stage s takes L * 2^s bytes, plus the slack overrun by the SIMD kernels
+  uint32_t pool_size = ((uint32_t)list_size << (nMax + 1U)) + (nMax + 1U) * SCL_PAD;
+  int8_t*  alpha     = srsran_vec_i8_malloc(pool_size);
+  uint8_t* beta      = srsran_vec_u8_malloc(pool_size);
+  if (alpha == NULL || beta == NULL) {
+    free(alpha);
+    free(beta);
+    free(pp);
+    return NULL;
+  }
+  srsran_vec_i8_zero(alpha, pool_size);
+  srsran_vec_u8_zero(beta, pool_size);
+  for (uint32_t s = 0, offset = 0; s <= nMax; offset += ((uint32_t)list_size << s) + SCL_PAD, s++) {
+    pp->alpha[s] = alpha + offset;
+    pp->beta[s]  = beta + offset;
+  }
+
+  if ((pp->path_bits = srsran_vec_u8_malloc(1U << nMax)) == NULL) {
+    delete_polar_decoder_scl_c(pp);
+    return NULL;
+  }
+
+  if ((pp->info_count = srsran_vec_u16_malloc((1U << nMax) + 1)) == NULL) {
+    delete_polar_decoder_scl_c(pp);
+    return NULL;
+  }
+
+  if ((pp->enc = SRSRAN_MEM_ALLOC(srsran_polar_encoder_t, 1)) == NULL) {
+    delete_polar_decoder_scl_c(pp);
+    return NULL;
+  }
+#ifdef LV_HAVE_AVX2
+  srsran_polar_encoder_init(pp->enc, SRSRAN_POLAR_ENCODER_AVX2, nMax);
+#else
+  srsran_polar_encoder_init(pp->enc, SRSRAN_POLAR_ENCODER_PIPELINED, nMax);
+#endif // LV_HAVE_AVX2
+
+  return pp;
+}
+
+int polar_decoder_scl_c(void*           p,
+                        const int8_t*   llr,
+                        uint8_t*        data_decoded,
+                        const uint8_t   code_size_log,
+                        const uint16_t* frozen_set,
+                        const uint16_t  frozen_set_size,
+                        const uint8_t   max_nof_paths)
+{
+  struct pSCL_c* pp = p;
+
+  if (pp == NULL || code_size_log > pp->nMax) {
+    return -1;
+  }
+
+  uint8_t  n         = code_size_log;
+  uint16_t code_size = 1U << n;
+  uint8_t  L         = pp->L;
+
+  // Number of information bits before each position
+  pp->info_count[0] = 0;
+  for (uint16_t i = 0, j = 0; i < code_size; i++) {
+    bool frozen = (j < frozen_set_size && frozen_set[j] == i);
+    if (frozen) {
+      j++;
+    }
+    pp->info_count[i + 1] = pp->info_count[i] + (frozen ? 0 : 1);
+  }
+
+  // Start from a single path, every path reads its own column
+  pp->code_size_log = n;
+  for (uint8_t s = 0; s <= n; s++) {
+    scl_identity(pp->alpha_col[s]);
+    scl_identity(pp->beta_col[s]);
+  }
+  memset(pp->active, 0, sizeof(pp->active));
+  memset(pp->pm, 0, sizeof(pp->pm));
+  pp->active[0] = true;
+
+  // All the columns of the root stage take the LLRs, -128 has no opposite in 8 bits
+  int8_t*  a = pp->alpha[n];
+  uint16_t i = 0;
+#ifdef LV_HAVE_AVX2
+  // Every 32-byte block takes 32 / L LLRs, each repeated over a row
+  uint8_t m[32];
+  for (uint8_t b = 0; b < 32; b++) {
+    m[b] = b / L;
+  }
+  __m256i shuf_ = _mm256_loadu_si256((__m256i*)m);
+  for (; i + 16 <= code_size; i += 16) {
+    __m256i x_ = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i*)(llr + i)));
+    x_         = _mm256_max_epi8(x_, _mm256_set1_epi8(-127));
+    for (uint8_t k = 0; k < L / 2; k++) {
+      __m256i rows_ = _mm256_shuffle_epi8(x_, _mm256_add_epi8(shuf_, _mm256_set1_epi8((int8_t)(k * 32 / L))));
+      _mm256_storeu_si256((__m256i*)(a + (uint32_t)(i + k * 32 / L) * L), rows_);
+    }
+  }
+#endif // LV_HAVE_AVX2
+  for (; i < code_size; i++) {
+    int8_t x = (llr[i] < -127) ? -127 : llr[i];
+    memset(a + (uint32_t)i * L, x, L);
+  }
+
+  scl_node(pp, n, 0);
+
+  // Sort the surviving paths by increasing path metric
+  uint8_t  order[SCL_MAX_L];
+  uint32_t nof_paths = 0;
+  for (uint8_t l = 0; l < L; l++) {
+    if (pp->active[l]) {
+      uint32_t j = nof_paths++;
+      for (; j > 0 && pp->pm[order[j - 1]] > pp->pm[l]; j--) {
+        order[j] = order[j - 1];
+      }
+      order[j] = l;
+    }
+  }
+  if (nof_paths > max_nof_paths) {
+    nof_paths = max_nof_paths;
+  }
+
+  // The decoder output is the encoder input, that is, the polar transform of the codeword estimate
+  for (uint32_t i = 0; i < nof_paths; i++) {
+    const uint8_t* b = pp->beta[n] + pp->beta_col[n][order[i]];
+    for (uint16_t j = 0; j < code_size; j++) {
+      pp->path_bits[j] = b[(uint32_t)j * L];
+    }
+    srsran_polar_encoder_encode(pp->enc, pp->path_bits, data_decoded + i * code_size, n);
+  }
+
+  return (int)nof_paths;
+}
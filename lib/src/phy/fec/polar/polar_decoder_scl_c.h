@@ -0,0 +1,74 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_scl_c.h
+ * \brief Declaration of the CRC-aided Successive Cancellation List (SCL) polar decoder inner functions working with
+ * 8-bit integer-valued LLRs.
+ *
+ */
+
+#ifndef POLAR_DECODER_SCL_C_H
+#define POLAR_DECODER_SCL_C_H
+
+#include <stdint.h>
+
+/*!
+ * Creates an SCL polar decoder structure of type pSCL_c, and allocates memory for the decoding buffers of all the
+ * paths in the list.
+ * \param[in] nMax \f$log_2\f$ of the maximum number of bits in the codeword.
+ * \param[in] list_size Number of paths in the list (2, 4 or 8).
+ * \return A pointer to a pSCL_c structure if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_scl_c(const uint8_t nMax, const uint8_t list_size);
+
+/*!
+ * The (8-bit) SCL polar decoder "destructor": it frees all the resources allocated to the decoder.
+ *
+ * \param[in, out] p A pointer to the dismantled decoder.
+ */
+void delete_polar_decoder_scl_c(void* p);
+
+/*!
+ * Decodes a codeword from its (8-bit) LLRs and writes the input vectors of the polar encoder of the surviving paths,
+ * sorted from the most to the least likely one.
+ *
+ * The decoder follows the SCL algorithm with the Rate-0, Rate-1 and repetition node shortcuts of the fast-SSCL
+ * decoder, so that only the information bits of Rate-1 nodes that can change the list are forked.
+ *
+ * \param[in, out] p A pointer to the desired decoder.
+ * \param[in] llr LLRs of the codeword.
+ * \param[out] data_decoded Buffer for up to list_size decoded vectors of \f$2^{code\_size\_log}\f$ bits each.
+ * \param[in] code_size_log \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \param[in] max_nof_paths Maximum number of decoded vectors written in data_decoded.
+ * \return The number of decoded vectors written in data_decoded, -1 if an error occurred.
+ */
+int polar_decoder_scl_c(void*           p,
+                        const int8_t*   llr,
+                        uint8_t*        data_decoded,
+                        const uint8_t   code_size_log,
+                        const uint16_t* frozen_set,
+                        const uint16_t  frozen_set_size,
+                        const uint8_t   max_nof_paths);
+
+#endif // POLAR_DECODER_SCL_C_H
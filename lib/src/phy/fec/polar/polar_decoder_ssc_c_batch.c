@@ -0,0 +1,247 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_ssc_c_batch.c
+ * \brief Definition of the SSC polar decoder inner functions working with 8-bit integer-valued LLRs of several
+ * codewords at once and AVX2 instructions.
+ *
+ * The LLR buffer of stage s holds \f$2^s\f$ rows of B columns, one per codeword, and the estimated bits are stored in
+ * the same way. Since the codewords share the frozen set, they share the decoding tree, and every node processes the B
+ * codewords with the AVX2 vector functions of the single-codeword SSC decoder. The short nodes close to the leaves,
+ * which fill a small part of an AVX2 register with a single codeword, fill B times more with a batch.
+ *
+ */
+
+#include "polar_decoder_ssc_c_batch.h"
+#include "../utils_avx2.h"
+#include "polar_decoder_vector_avx2.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/utils/vector.h"
+
+#ifdef LV_HAVE_AVX2
+
+#define BATCH_MAX_STAGES (NMAX_LOG + 1) /*!< \brief Maximum number of stages in the decoding tree. */
+
+/*!
+ * \brief Describes a batch SSC polar decoder (8-bit version).
+ */
+struct pSSC_c_batch {
+  uint8_t                 nMax;                  /*!< \brief \f$log_2\f$ of the maximum code size. */
+  uint8_t                 stage;                 /*!< \brief Current stage of the decoding algorithm. */
+  uint16_t                bit_pos;               /*!< \brief Position of the next bit to be estimated. */
+  uint16_t                B;                     /*!< \brief Number of codewords of the current batch. */
+  uint16_t*               info_count;            /*!< \brief Information bits before each position. */
+  int8_t*                 llr[BATCH_MAX_STAGES]; /*!< \brief LLRs per stage, 2^s rows of B columns. */
+  uint8_t*                est_bit;               /*!< \brief Estimated bits {0, 128}, 2^n rows of B columns. */
+  uint8_t*                codeword;              /*!< \brief Estimated codeword of a single column. */
+  srsran_polar_encoder_t* enc;                   /*!< \brief Pointer to a srsran_polar_encoder_t. */
+};
+
+/*!
+ * Decodes the node of the current stage and position, for all the codewords. ::RATE_0 nodes leave their estimated
+ * bits to 0, ::RATE_1 nodes make a hard decision on their LLRs and ::RATE_R nodes call the child nodes to the left and
+ * right of the decoding tree and then polar encode (xor) their output, as in the single-codeword SSC decoders.
+ */
+static void simplified_node(struct pSSC_c_batch* pp)
+{
+  pp->stage--; // to child node.
+
+  uint8_t  stage      = pp->stage;
+  uint16_t B          = pp->B;
+  uint16_t stage_size = 1U << stage;
+  uint16_t nof_info   = pp->info_count[pp->bit_pos + stage_size] - pp->info_count[pp->bit_pos];
+
+  if (nof_info == stage_size) {
+    // RATE_1
+    srsran_vec_hard_bit_cc_avx2(pp->llr[stage], pp->est_bit + pp->bit_pos * B, stage_size * B);
+    pp->bit_pos += stage_size;
+  } else if (nof_info == 0) {
+    // RATE_0
+    pp->bit_pos += stage_size;
+  } else {
+    // RATE_R
+    uint16_t stage_half_size = stage_size / 2;
+    int8_t*  llr0            = pp->llr[stage];
+    int8_t*  llr1            = pp->llr[stage] + stage_half_size * B;
+
+    srsran_vec_function_f_ccc_avx2(llr0, llr1, pp->llr[stage - 1], stage_half_size * B);
+
+    // move to the child node to the left (up) of the tree.
+    simplified_node(pp);
+
+    uint8_t* estbits0 = pp->est_bit + (pp->bit_pos - stage_half_size) * B;
+    srsran_vec_function_g_bccc_avx2(estbits0, llr0, llr1, pp->llr[stage - 1], stage_half_size * B);
+
+    // move to the child node to the right (down) of the tree.
+    simplified_node(pp);
+
+    estbits0          = pp->est_bit + (pp->bit_pos - stage_size) * B;
+    uint8_t* estbits1 = estbits0 + stage_half_size * B;
+    srsran_vec_xor_bbb_avx2(estbits0, estbits1, estbits0, stage_half_size * B);
+  }
+
+  pp->stage++; // to parent node.
+}
+
+void delete_polar_decoder_ssc_c_batch(void* p)
+{
+  struct pSSC_c_batch* pp = p;
+
+  if (pp == NULL) {
+    return;
+  }
+  if (pp->llr[0]) {
+    free(pp->llr[0]);
+  }
+  if (pp->est_bit) {
+    free(pp->est_bit);
+  }
+  if (pp->codeword) {
+    free(pp->codeword);
+  }
+  if (pp->info_count) {
+    free(pp->info_count);
+  }
+  if (pp->enc) {
+    srsran_polar_encoder_free(pp->enc);
+    free(pp->enc);
+  }
+  free(pp);
+}
+
+void* create_polar_decoder_ssc_c_batch(const uint8_t nMax)
+{
+  struct pSSC_c_batch* pp = NULL;
+
+  if (nMax > NMAX_LOG) {
+    return NULL;
+  }
+
+  if ((pp = malloc(sizeof(struct pSSC_c_batch))) == NULL) {
+    return NULL;
+  }
+  SRSRAN_MEM_ZERO(pp, struct pSSC_c_batch, 1);
+  pp->nMax = nMax;
+
+  // Stage s takes B * 2^s bytes, plus the SRSRAN_AVX2_B_SIZE bytes overrun by the AVX2 functions
+  uint32_t pool_size = ((uint32_t)SRSRAN_POLAR_DECODER_MAX_BATCH << (nMax + 1U)) + (nMax + 1U) * SRSRAN_AVX2_B_SIZE;
+  if ((pp->llr[0] = srsran_vec_i8_malloc(pool_size)) == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+  for (uint32_t s = 1; s <= nMax; s++) {
+    pp->llr[s] = pp->llr[s - 1] + ((uint32_t)SRSRAN_POLAR_DECODER_MAX_BATCH << (s - 1U)) + SRSRAN_AVX2_B_SIZE;
+  }
+
+  // The AVX2 functions read and clear up to SRSRAN_AVX2_B_SIZE bytes after the estimated bits
+  uint32_t est_bit_size = ((uint32_t)SRSRAN_POLAR_DECODER_MAX_BATCH << nMax) + 2 * SRSRAN_AVX2_B_SIZE;
+  if ((pp->est_bit = srsran_vec_u8_malloc(est_bit_size)) == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+
+  if ((pp->codeword = srsran_vec_u8_malloc(1U << nMax)) == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+
+  if ((pp->info_count = srsran_vec_u16_malloc((1U << nMax) + 1)) == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+
+  if ((pp->enc = SRSRAN_MEM_ALLOC(srsran_polar_encoder_t, 1)) == NULL) {
+    delete_polar_decoder_ssc_c_batch(pp);
+    return NULL;
+  }
+  srsran_polar_encoder_init(pp->enc, SRSRAN_POLAR_ENCODER_AVX2, nMax);
+
+  return pp;
+}
+
+int polar_decoder_ssc_c_batch(void*                p,
+                              const int8_t* const* llr,
+                              uint8_t* const*      data_decoded,
+                              const uint32_t       nof_codewords,
+                              const uint8_t        code_size_log,
+                              const uint16_t*      frozen_set,
+                              const uint16_t       frozen_set_size)
+{
+  struct pSSC_c_batch* pp = p;
+
+  if (pp == NULL || llr == NULL || data_decoded == NULL || nof_codewords > SRSRAN_POLAR_DECODER_MAX_BATCH ||
+      code_size_log == 0 || code_size_log > pp->nMax) {
+    return -1;
+  }
+
+  if (nof_codewords == 0) {
+    return 0;
+  }
+
+  uint8_t  n         = code_size_log;
+  uint16_t code_size = 1U << n;
+  uint16_t B         = (uint16_t)nof_codewords;
+
+  // Number of information bits before each position, the node types follow from it
+  pp->info_count[0] = 0;
+  for (uint16_t i = 0, j = 0; i < code_size; i++) {
+    bool frozen = (j < frozen_set_size && frozen_set[j] == i);
+    if (frozen) {
+      j++;
+    }
+    pp->info_count[i + 1] = pp->info_count[i] + (frozen ? 0 : 1);
+  }
+
+  // Interleave the LLRs of the codewords in the root stage
+  int8_t* root = pp->llr[n];
+  for (uint16_t c = 0; c < B; c++) {
+    const int8_t* x = llr[c];
+    for (uint16_t i = 0; i < code_size; i++) {
+      root[i * B + c] = x[i];
+    }
+  }
+
+  // Rate-0 nodes do not write their estimated bits, and the AVX2 functions expect 0 after the current position
+  memset(pp->est_bit, 0, code_size * B + SRSRAN_AVX2_B_SIZE);
+
+  pp->B       = B;
+  pp->stage   = n + 1; // start from the only one node at the last stage + 1.
+  pp->bit_pos = 0;
+  simplified_node(pp);
+
+  // est_bit contains the coded bits of every codeword. To obtain the message, we call the encoder
+  for (uint16_t c = 0; c < B; c++) {
+    for (uint16_t i = 0; i < code_size; i++) {
+      pp->codeword[i] = pp->est_bit[i * B + c];
+    }
+    srsran_polar_encoder_encode(pp->enc, pp->codeword, data_decoded[c], n);
+
+    // transform {0,-128} into {0, 1}
+    srsran_vec_sign_to_bit_c_avx2(data_decoded[c], code_size);
+  }
+
+  return 0;
+}
+
+#endif // LV_HAVE_AVX2
@@ -0,0 +1,74 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_ssc_c_batch.h
+ * \brief Declaration of the SSC polar decoder inner functions working with 8-bit integer-valued LLRs of several
+ * codewords at once and AVX2 instructions.
+ *
+ */
+
+#ifndef POLAR_DECODER_SSC_C_BATCH_H
+#define POLAR_DECODER_SSC_C_BATCH_H
+
+#include <stdint.h>
+
+/*!
+ * Creates a batch SSC polar decoder structure of type pSSC_c_batch, and allocates memory for the decoding buffers of
+ * up to SRSRAN_POLAR_DECODER_MAX_BATCH codewords.
+ * \param[in] nMax \f$log_2\f$ of the maximum number of bits in the codeword.
+ * \return A pointer to a pSSC_c_batch structure if the function executes correctly, NULL otherwise.
+ */
+void* create_polar_decoder_ssc_c_batch(const uint8_t nMax);
+
+/*!
+ * The (8-bit) batch SSC polar decoder "destructor": it frees all the resources allocated to the decoder.
+ *
+ * \param[in, out] p A pointer to the dismantled decoder.
+ */
+void delete_polar_decoder_ssc_c_batch(void* p);
+
+/*!
+ * Decodes several codewords of the same polar code from their (8-bit) LLRs and writes the input vectors of the polar
+ * encoder.
+ *
+ * The codewords are interleaved, row i of every stage holds the i-th value of all of them, so that every f and g
+ * function, hard decision and XOR of the SSC decoding tree processes all the codewords with a single call. The output
+ * of every codeword is the same as the one of the (AVX2) SSC decoder.
+ *
+ * \param[in, out] p A pointer to the desired decoder.
+ * \param[in] llr LLRs of every codeword.
+ * \param[out] data_decoded Decoded vector of \f$2^{code\_size\_log}\f$ bits of every codeword.
+ * \param[in] nof_codewords Number of codewords, up to SRSRAN_POLAR_DECODER_MAX_BATCH.
+ * \param[in] code_size_log \f$log_2\f$ of the number of bits in the codeword.
+ * \param[in] frozen_set The position of the frozen bits in increasing order.
+ * \param[in] frozen_set_size The size of the frozen_set.
+ * \return An integer: 0 if the function executes correctly, -1 otherwise.
+ */
+int polar_decoder_ssc_c_batch(void*                p,
+                              const int8_t* const* llr,
+                              uint8_t* const*      data_decoded,
+                              const uint32_t       nof_codewords,
+                              const uint8_t        code_size_log,
+                              const uint16_t*      frozen_set,
+                              const uint16_t       frozen_set_size);
+
+#endif // POLAR_DECODER_SSC_C_BATCH_H
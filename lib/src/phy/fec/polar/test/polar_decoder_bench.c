@@ -0,0 +1,376 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file polar_decoder_bench.c
+ * \brief Throughput and BLER benchmark of the 8-bit polar decoders for typical NR DCI sizes.
+ *
+ * A payload of \a A bits with a 24-bit CRC is polar encoded and rate-matched to the number of bits of the PDCCH
+ * aggregation levels 1, 2, 4, 8 and 16 (108 bits per CCE). Every decoder is first checked on noiseless LLR and then
+ * run on the same noisy codewords. List decoders return all their candidates and the first one passing the CRC check
+ * is selected, so the reported decoding rate includes the CRC checks of a blind decoding attempt. The SSC decoders are
+ * also run in batches of SRSRAN_POLAR_DECODER_MAX_BATCH codewords, as the PDCCH candidates of a blind search, and the
+ * batch output is checked against the single-codeword output.
+ *
+ * Synopsis: **polar_decoder_bench [options]**
+ *
+ * Options:
+ *  - **-a \<number\>** Payload size in bits, without CRC (Default 40).
+ *  - **-s \<number\>** SNR in dB (Default 0).
+ *  - **-R \<number\>** Number of codewords per aggregation level (Default 1000).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/common/phy_common.h"
+#include "srsran/phy/fec/crc.h"
+#include "srsran/phy/fec/polar/polar_chanalloc.h"
+#include "srsran/phy/fec/polar/polar_code.h"
+#include "srsran/phy/fec/polar/polar_decoder.h"
+#include "srsran/phy/fec/polar/polar_encoder.h"
+#include "srsran/phy/fec/polar/polar_rm.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/random.h"
+#include "srsran/phy/utils/vector.h"
+
+#define CRC_LEN 24         /*!< \brief Length of the DCI CRC. */
+#define CCE_BITS 108       /*!< \brief Number of coded bits per CCE. */
+#define NOF_AGG_LEVELS 5   /*!< \brief Number of evaluated aggregation levels. */
+#define NMAX_DL 9          /*!< \brief Maximum \f$log_2(N)\f$ in the downlink. */
+#define LLR_GAIN 16.0f     /*!< \brief Quantization gain of the 8-bit LLR. */
+#define NOF_DECODERS (sizeof(decoder_types) / sizeof(decoder_types[0]))
+
+static uint32_t A        = 40;   /*!< \brief Payload size. */
+static float    snr_db   = 0.0f; /*!< \brief SNR in dB. */
+static uint32_t nof_reps = 1000; /*!< \brief Number of codewords per aggregation level. */
+
+static const srsran_polar_decoder_type_t decoder_types[] = {SRSRAN_POLAR_DECODER_SSC_C,
+#ifdef LV_HAVE_AVX2
+                                                            SRSRAN_POLAR_DECODER_SSC_C_AVX2,
+#endif // LV_HAVE_AVX2
+                                                            SRSRAN_POLAR_DECODER_SCL2_C,
+                                                            SRSRAN_POLAR_DECODER_SCL4_C,
+                                                            SRSRAN_POLAR_DECODER_SCL8_C};
+
+static const char* decoder_name(srsran_polar_decoder_type_t type)
+{
+  switch (type) {
+    case SRSRAN_POLAR_DECODER_SSC_C:
+      return "SSC";
+    case SRSRAN_POLAR_DECODER_SSC_C_AVX2:
+      return "SSC-AVX2";
+    case SRSRAN_POLAR_DECODER_SCL2_C:
+      return "SCL-2";
+    case SRSRAN_POLAR_DECODER_SCL4_C:
+      return "SCL-4";
+    case SRSRAN_POLAR_DECODER_SCL8_C:
+      return "SCL-8";
+    default:
+      return "unknown";
+  }
+}
+
+/*!
+ * \brief Prints test help when a wrong parameter is passed as input.
+ */
+void usage(char* prog)
+{
+  printf("Usage: %s [-aX] [-sX] [-RX]\n", prog);
+  printf("\t-a Payload size without CRC [Default %d]\n", A);
+  printf("\t-s SNR in dB [Default %.1f]\n", snr_db);
+  printf("\t-R Number of codewords per aggregation level [Default %d]\n", nof_reps);
+}
+
+/*!
+ * \brief Parses the input line.
+ */
+void parse_args(int argc, char** argv)
+{
+  int opt = 0;
+  while ((opt = getopt(argc, argv, "a:s:R:")) != -1) {
+    switch (opt) {
+      case 'a':
+        A = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      case 's':
+        snr_db = strtof(optarg, NULL);
+        break;
+      case 'R':
+        nof_reps = (uint32_t)strtol(optarg, NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+/*!
+ * \brief Decodes a codeword and returns true if one of the candidates passes the CRC check and matches the payload.
+ */
+static bool decode(srsran_polar_decoder_t*    dec,
+                   const srsran_polar_code_t* code,
+                   srsran_crc_t*              crc,
+                   const int8_t*              llr,
+                   uint8_t*                   candidates,
+                   uint8_t*                   data_rx,
+                   const uint8_t*             data_tx)
+{
+  int nof_cand = srsran_polar_decoder_decode_list_c(dec, llr, candidates, code->n, code->F_set, code->F_set_size);
+
+  for (int i = 0; i < nof_cand; i++) {
+    srsran_polar_chanalloc_rx(candidates + i * code->N, data_rx, code->K, code->nPC, code->K_set, code->PC_set);
+    if (srsran_crc_match(crc, data_rx, code->K - CRC_LEN)) {
+      return memcmp(data_rx, data_tx, code->K) == 0;
+    }
+  }
+
+  return false;
+}
+
+/*!
+ * \brief Decodes all the codewords in batches and returns the number of them that do not pass the CRC check or do not
+ * match the payload, or -1 if an error occurred. The decoded vectors of the last batch are left in \a decoded.
+ */
+static int decode_batch(srsran_polar_decoder_t*    dec,
+                        const srsran_polar_code_t* code,
+                        srsran_crc_t*              crc,
+                        const int8_t*              llr,
+                        uint8_t*                   decoded,
+                        uint8_t*                   data_rx,
+                        const uint8_t*             data_tx)
+{
+  int nof_errors = 0;
+
+  for (uint32_t r = 0; r < nof_reps; r += SRSRAN_POLAR_DECODER_MAX_BATCH) {
+    uint32_t      nof_cw = SRSRAN_MIN(SRSRAN_POLAR_DECODER_MAX_BATCH, nof_reps - r);
+    const int8_t* batch_llr[SRSRAN_POLAR_DECODER_MAX_BATCH];
+    uint8_t*      batch_decoded[SRSRAN_POLAR_DECODER_MAX_BATCH];
+    for (uint32_t i = 0; i < nof_cw; i++) {
+      batch_llr[i]     = llr + (r + i) * code->N;
+      batch_decoded[i] = decoded + i * code->N;
+    }
+    if (srsran_polar_decoder_decode_batch_c(
+            dec, batch_llr, batch_decoded, nof_cw, code->n, code->F_set, code->F_set_size) != 0) {
+      return -1;
+    }
+
+    for (uint32_t i = 0; i < nof_cw; i++) {
+      srsran_polar_chanalloc_rx(batch_decoded[i], data_rx, code->K, code->nPC, code->K_set, code->PC_set);
+      if (!srsran_crc_match(crc, data_rx, code->K - CRC_LEN) ||
+          memcmp(data_rx, data_tx + (r + i) * code->K, code->K) != 0) {
+        nof_errors++;
+      }
+    }
+  }
+
+  return nof_errors;
+}
+
+/*!
+ * \brief Decodes the codewords of the last batch one at a time and returns true if all of them match \a decoded.
+ */
+static bool check_batch(srsran_polar_decoder_t*    dec,
+                        const srsran_polar_code_t* code,
+                        const int8_t*              llr,
+                        const uint8_t*             decoded,
+                        uint8_t*                   single)
+{
+  uint32_t r = ((nof_reps - 1) / SRSRAN_POLAR_DECODER_MAX_BATCH) * SRSRAN_POLAR_DECODER_MAX_BATCH;
+  for (uint32_t i = 0; r + i < nof_reps; i++) {
+    srsran_polar_decoder_decode_c(dec, llr + (r + i) * code->N, single, code->n, code->F_set, code->F_set_size);
+    if (memcmp(single, decoded + i * code->N, code->N) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  parse_args(argc, argv);
+
+  uint32_t K = A + CRC_LEN;
+  uint32_t E = CCE_BITS << (NOF_AGG_LEVELS - 1);
+
+  srsran_random_t        random_gen = srsran_random_init(0);
+  srsran_crc_t           crc        = {};
+  srsran_polar_code_t    code       = {};
+  srsran_polar_encoder_t enc        = {};
+  srsran_polar_rm_t      rm_tx      = {};
+  srsran_polar_rm_t      rm_rx      = {};
+  srsran_polar_decoder_t dec[NOF_DECODERS];
+  SRSRAN_MEM_ZERO(dec, srsran_polar_decoder_t, NOF_DECODERS);
+
+  if (srsran_crc_init(&crc, SRSRAN_LTE_CRC24C, CRC_LEN) < SRSRAN_SUCCESS || srsran_polar_code_init(&code) != 0 ||
+      srsran_polar_encoder_init(&enc, SRSRAN_POLAR_ENCODER_PIPELINED, NMAX_DL) != 0 ||
+      srsran_polar_rm_tx_init(&rm_tx) != 0 || srsran_polar_rm_rx_init_c(&rm_rx) != 0) {
+    ERROR("Error initialising polar chain");
+    exit(-1);
+  }
+  for (uint32_t d = 0; d < NOF_DECODERS; d++) {
+    if (srsran_polar_decoder_init(&dec[d], decoder_types[d], NMAX_DL) != 0) {
+      ERROR("Error initialising %s decoder", decoder_name(decoder_types[d]));
+      exit(-1);
+    }
+  }
+
+  uint8_t* data_tx    = srsran_vec_u8_malloc(K * nof_reps);
+  uint8_t* data_rx    = srsran_vec_u8_malloc(K);
+  uint8_t* input_enc  = srsran_vec_u8_malloc(NMAX);
+  uint8_t* output_enc = srsran_vec_u8_malloc(NMAX);
+  uint8_t* rm_cw      = srsran_vec_u8_malloc(E);
+  float*   rm_llr     = srsran_vec_f_malloc(E);
+  int8_t*  rm_llr_c   = srsran_vec_i8_malloc(E);
+  int8_t*  llr_c      = srsran_vec_i8_malloc(NMAX * nof_reps);
+  int8_t*  llr_clean  = srsran_vec_i8_malloc(NMAX * nof_reps);
+  uint8_t* candidates = srsran_vec_u8_malloc(NMAX * SRSRAN_POLAR_DECODER_MAX_LIST_SIZE);
+  uint8_t* decoded    = srsran_vec_u8_malloc(NMAX * SRSRAN_POLAR_DECODER_MAX_BATCH);
+  if (!data_tx || !data_rx || !input_enc || !output_enc || !rm_cw || !rm_llr || !rm_llr_c || !llr_c || !llr_clean ||
+      !candidates || !decoded) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  printf("Polar decoding A=%d, K=%d, SNR=%.1f dB, %d codewords per aggregation level\n", A, K, snr_db, nof_reps);
+  printf("  AL |    E |   N | Decoder  | Decodes/s |    BLER | Batch decodes/s\n");
+
+  float var = srsran_convert_dB_to_power(-snr_db);
+  for (uint32_t al_idx = 0; al_idx < NOF_AGG_LEVELS; al_idx++) {
+    uint32_t E_al = CCE_BITS << al_idx;
+    if (E_al <= K) {
+      // The aggregation level is too small for the payload
+      continue;
+    }
+    if (srsran_polar_code_get(&code, K, E_al, NMAX_DL) != 0) {
+      ERROR("Error getting polar code K=%d, E=%d", K, E_al);
+      goto clean_exit;
+    }
+
+    // Generate and encode the codewords, the noiseless LLR are kept for the correctness check
+    for (uint32_t r = 0; r < nof_reps; r++) {
+      uint8_t* data = data_tx + r * K;
+      for (uint32_t i = 0; i < A; i++) {
+        data[i] = (uint8_t)srsran_random_uniform_int_dist(random_gen, 0, 1);
+      }
+      srsran_crc_attach(&crc, data, A);
+      srsran_polar_chanalloc_tx(data, input_enc, code.N, code.K, code.nPC, code.K_set, code.PC_set);
+      srsran_polar_encoder_encode(&enc, input_enc, output_enc, code.n);
+      srsran_polar_rm_tx(&rm_tx, output_enc, rm_cw, code.n, E_al, K, 0);
+
+      for (uint32_t i = 0; i < E_al; i++) {
+        rm_llr[i] = rm_cw[i] ? -1.0f : 1.0f;
+      }
+      srsran_vec_quant_fc(rm_llr, rm_llr_c, LLR_GAIN, 0, 127, E_al);
+      srsran_polar_rm_rx_c(&rm_rx, rm_llr_c, llr_clean + r * code.N, E_al, code.n, K, 0);
+
+      srsran_ch_awgn_f(rm_llr, rm_llr, var, E_al);
+      srsran_vec_quant_fc(rm_llr, rm_llr_c, LLR_GAIN, 0, 127, E_al);
+      srsran_polar_rm_rx_c(&rm_rx, rm_llr_c, llr_c + r * code.N, E_al, code.n, K, 0);
+    }
+
+    for (uint32_t d = 0; d < NOF_DECODERS; d++) {
+      for (uint32_t r = 0; r < nof_reps; r++) {
+        if (!decode(&dec[d], &code, &crc, llr_clean + r * code.N, candidates, data_rx, data_tx + r * K)) {
+          ERROR("%s decoder failed without noise (AL=%d, codeword %d)",
+                decoder_name(decoder_types[d]),
+                1U << al_idx,
+                r);
+          goto clean_exit;
+        }
+      }
+
+      uint32_t       nof_errors = 0;
+      struct timeval t[3];
+      gettimeofday(&t[1], NULL);
+      for (uint32_t r = 0; r < nof_reps; r++) {
+        if (!decode(&dec[d], &code, &crc, llr_c + r * code.N, candidates, data_rx, data_tx + r * K)) {
+          nof_errors++;
+        }
+      }
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      double elapsed = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+
+      printf("  %2d | %4d | %3d | %-8s | %9.0f | %7.4f |",
+             1U << al_idx,
+             E_al,
+             code.N,
+             decoder_name(decoder_types[d]),
+             nof_reps / elapsed,
+             (double)nof_errors / nof_reps);
+
+      // List decoders have no batch version
+      if (dec[d].list_size > 1) {
+        printf("               -\n");
+        continue;
+      }
+
+      gettimeofday(&t[1], NULL);
+      int nof_batch_errors = decode_batch(&dec[d], &code, &crc, llr_c, decoded, data_rx, data_tx);
+      gettimeofday(&t[2], NULL);
+      get_time_interval(t);
+      elapsed = t[0].tv_sec + 1e-6 * t[0].tv_usec;
+      printf(" %15.0f\n", nof_reps / elapsed);
+
+      if (nof_batch_errors != (int)nof_errors || !check_batch(&dec[d], &code, llr_c, decoded, candidates)) {
+        ERROR("%s batch decoder output differs from the single-codeword output (AL=%d)",
+              decoder_name(decoder_types[d]),
+              1U << al_idx);
+        goto clean_exit;
+      }
+    }
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  free(data_tx);
+  free(data_rx);
+  free(input_enc);
+  free(output_enc);
+  free(rm_cw);
+  free(rm_llr);
+  free(rm_llr_c);
+  free(llr_c);
+  free(llr_clean);
+  free(candidates);
+  free(decoded);
+  for (uint32_t d = 0; d < NOF_DECODERS; d++) {
+    srsran_polar_decoder_free(&dec[d]);
+  }
+  srsran_polar_rm_rx_free_c(&rm_rx);
+  srsran_polar_rm_tx_free(&rm_tx);
+  srsran_polar_encoder_free(&enc);
+  srsran_polar_code_free(&code);
+  srsran_random_free(random_gen);
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
@@ -35,4 +35,22 @@
 #define SRSRAN_AVX2_B_SIZE 32    /*!< \brief Number of packed bytes in an AVX2 instruction. */
 #define SRSRAN_AVX2_B_SIZE_LOG 5 /*!< \brief \f$\log_2\f$ of \ref SRSRAN_AVX2_B_SIZE. */
 
+#ifdef LV_HAVE_AVX2
+
+#include <immintrin.h>
+#include <stdint.h>
+
+static inline void fec_avx2_hard_decision_c(const int8_t* llr, uint8_t* message, int nof_llr)
+{
+  int k = 0;
+  for (; k < nof_llr - (SRSRAN_AVX2_B_SIZE - 1); k += SRSRAN_AVX2_B_SIZE) {
+    __m256i negative = _mm256_cmpgt_epi8(_mm256_setzero_si256(), _mm256_loadu_si256((__m256i*)&llr[k]));
+    _mm256_storeu_si256((__m256i*)&message[k], _mm256_and_si256(negative, _mm256_set1_epi8(1)));
+  }
+  for (; k < nof_llr; k++) {
+    message[k] = (llr[k] < 0);
+  }
+}
+#endif // LV_HAVE_AVX2
+
 #endif // SRSRAN_UTILS_AVX2_H
@@ -0,0 +1,537 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/phy/io/iq_file.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define IQ_FILE_BFP_GROUP_NOF_VALUES (2 * SRSRAN_IQ_FILE_BFP_GROUP_LEN)
+#define IQ_FILE_NOF_GROUPS(N) (((N) + SRSRAN_IQ_FILE_BFP_GROUP_LEN - 1) / SRSRAN_IQ_FILE_BFP_GROUP_LEN)
+#define IQ_FILE_MAX_NOF_BYTES (SRSRAN_IQ_FILE_MAX_BLOCK_LEN * sizeof(cf_t))
+
+static const char* iq_file_format_names[SRSRAN_IQ_FILE_NOF_FORMATS] = {"fc32", "sc16", "bfp9", "bfp12"};
+
+srsran_iq_file_format_t srsran_iq_file_format_from_string(const char* name)
+{
+  for (uint32_t i = 0; i < SRSRAN_IQ_FILE_NOF_FORMATS; i++) {
+    if (name && strcmp(name, iq_file_format_names[i]) == 0) {
+      return (srsran_iq_file_format_t)i;
+    }
+  }
+  return SRSRAN_IQ_FILE_NOF_FORMATS;
+}
+
+const char* srsran_iq_file_format_to_string(srsran_iq_file_format_t format)
+{
+  if (format < SRSRAN_IQ_FILE_NOF_FORMATS) {
+    return iq_file_format_names[format];
+  }
+  return "invalid";
+}
+
+static uint32_t iq_file_bfp_width(srsran_iq_file_format_t format)
+{
+  return (format == SRSRAN_IQ_FILE_BFP9) ? 9 : 12;
+}
+
+uint32_t srsran_iq_file_nof_bytes(srsran_iq_file_format_t format, uint32_t nof_samples)
+{
+  switch (format) {
+    case SRSRAN_IQ_FILE_FC32:
+      return nof_samples * (uint32_t)sizeof(cf_t);
+    case SRSRAN_IQ_FILE_SC16:
+      return nof_samples * 2 * (uint32_t)sizeof(int16_t);
+    case SRSRAN_IQ_FILE_BFP9:
+    case SRSRAN_IQ_FILE_BFP12:
+      // One exponent byte and the packed mantissas of every group
+      return IQ_FILE_NOF_GROUPS(nof_samples) * (1 + IQ_FILE_BFP_GROUP_NOF_VALUES * iq_file_bfp_width(format) / 8);
+    default:
+      break;
+  }
+  return 0;
+}
+
+bool srsran_iq_file_probe(FILE* f)
+{
+  srsran_iq_file_header_t header = {};
+
+  long pos = ftell(f);
+  bool ret = fread(&header, sizeof(header), 1, f) == 1 &&
+             memcmp(header.magic, SRSRAN_IQ_FILE_MAGIC, sizeof(header.magic)) == 0;
+  if (pos >= 0) {
+    fseek(f, pos, SEEK_SET);
+  }
+  return ret;
+}
+
+/* Compresses a group of 24 integers into an exponent byte followed by the packed big-endian mantissas */
+static void iq_file_bfp_compress(const int16_t* in, uint32_t width, uint8_t* out)
+{
+  // Find the smallest exponent that fits the largest magnitude in the mantissa once rounded
+  const int32_t mant_max = (1 << (width - 1)) - 1;
+  int32_t       max      = 0;
+  for (uint32_t i = 0; i < IQ_FILE_BFP_GROUP_NOF_VALUES; i++) {
+    int32_t v = in[i];
+    max       = SRSRAN_MAX(max, (v < 0) ? -v - 1 : v);
+  }
+  uint32_t exponent = 0;
+  while (((max + ((1 << exponent) >> 1)) >> exponent) > mant_max) {
+    exponent++;
+  }
+
+  const int32_t round    = (1 << exponent) >> 1;
+  uint64_t      acc      = 0;
+  uint32_t      nof_bits = 0;
+
+  *(out++) = (uint8_t)exponent;
+  for (uint32_t i = 0; i < IQ_FILE_BFP_GROUP_NOF_VALUES; i++) {
+    int32_t mantissa = (in[i] + round) >> exponent;
+    acc              = (acc << width) | ((uint32_t)mantissa & ((1U << width) - 1));
+    nof_bits += width;
+    while (nof_bits >= 8) {
+      nof_bits -= 8;
+      *(out++) = (uint8_t)(acc >> nof_bits);
+    }
+  }
+}
+
+/* Expands a group compressed by iq_file_bfp_compress() into 24 integers */
+static void iq_file_bfp_decompress(const uint8_t* in, uint32_t width, int16_t* out)
+{
+  const uint32_t exponent = *(in++) & 0xf;
+  const int32_t  sign     = 1 << (width - 1);
+  uint32_t       acc      = 0;
+  uint32_t       nof_bits = 0;
+
+  for (uint32_t i = 0; i < IQ_FILE_BFP_GROUP_NOF_VALUES; i++) {
+    while (nof_bits < width) {
+      acc = (acc << 8) | *(in++);
+      nof_bits += 8;
+    }
+    nof_bits -= width;
+    int32_t mantissa = (int32_t)((acc >> nof_bits) & ((1U << width) - 1));
+    out[i]           = (int16_t)SRSRAN_MIN(((mantissa ^ sign) - sign) * (1 << exponent), INT16_MAX);
+  }
+}
+
+/* Encodes a block of samples, returns the payload length */
+static uint32_t iq_file_encode(srsran_iq_file_format_t format,
+                               const cf_t*             samples,
+                               uint32_t                nof_samples,
+                               int16_t*                temp,
+                               uint8_t*                payload,
+                               float*                  scale)
+{
+  if (format == SRSRAN_IQ_FILE_FC32) {
+    memcpy(payload, samples, nof_samples * sizeof(cf_t));
+    *scale = 1.0f;
+    return srsran_iq_file_nof_bytes(format, nof_samples);
+  }
+
+  // Normalise the block to the integer full scale
+  const float* x   = (const float*)samples;
+  float        max = fabsf(x[srsran_vec_max_abs_fi(x, 2 * nof_samples)]);
+  *scale           = isnormal(max) ? max / INT16_MAX : 1.0f;
+
+  if (format == SRSRAN_IQ_FILE_SC16) {
+    srsran_vec_convert_fi(x, 1.0f / *scale, (int16_t*)payload, 2 * nof_samples);
+    return srsran_iq_file_nof_bytes(format, nof_samples);
+  }
+
+  // Block floating point, the last group is padded with zeros
+  uint32_t nof_groups = IQ_FILE_NOF_GROUPS(nof_samples);
+  uint32_t width      = iq_file_bfp_width(format);
+  uint32_t group_sz   = 1 + IQ_FILE_BFP_GROUP_NOF_VALUES * width / 8;
+  srsran_vec_convert_fi(x, 1.0f / *scale, temp, 2 * nof_samples);
+  memset(&temp[2 * nof_samples], 0, (nof_groups * IQ_FILE_BFP_GROUP_NOF_VALUES - 2 * nof_samples) * sizeof(int16_t));
+  for (uint32_t i = 0; i < nof_groups; i++) {
+    iq_file_bfp_compress(&temp[i * IQ_FILE_BFP_GROUP_NOF_VALUES], width, &payload[i * group_sz]);
+  }
+  return nof_groups * group_sz;
+}
+
+/* Decodes a block of samples encoded by iq_file_encode() */
+static void iq_file_decode(srsran_iq_file_format_t format,
+                           const uint8_t*          payload,
+                           uint32_t                nof_samples,
+                           float                   scale,
+                           int16_t*                temp,
+                           cf_t*                   samples)
+{
+  float* y = (float*)samples;
+
+  switch (format) {
+    case SRSRAN_IQ_FILE_FC32:
+      memcpy(samples, payload, nof_samples * sizeof(cf_t));
+      break;
+    case SRSRAN_IQ_FILE_SC16:
+      srsran_vec_convert_if((const int16_t*)payload, 1.0f / scale, y, 2 * nof_samples);
+      break;
+    case SRSRAN_IQ_FILE_BFP9:
+    case SRSRAN_IQ_FILE_BFP12: {
+      uint32_t width    = iq_file_bfp_width(format);
+      uint32_t group_sz = 1 + IQ_FILE_BFP_GROUP_NOF_VALUES * width / 8;
+      for (uint32_t i = 0; i < IQ_FILE_NOF_GROUPS(nof_samples); i++) {
+        iq_file_bfp_decompress(&payload[i * group_sz], width, &temp[i * IQ_FILE_BFP_GROUP_NOF_VALUES]);
+      }
+      srsran_vec_convert_if(temp, 1.0f / scale, y, 2 * nof_samples);
+    } break;
+    default:
+      srsran_vec_cf_zero(samples, nof_samples);
+      break;
+  }
+}
+
+/*
+ * Recorder
+ */
+
+/* Drains the ring into the file until the end of stream block, which has no samples */
+static void* iq_recorder_thread(void* arg)
+{
+  srsran_iq_recorder_t*  q     = (srsran_iq_recorder_t*)arg;
+  srsran_iq_file_block_t block = {};
+
+  while (srsran_ringbuffer_read(&q->ring, &block, sizeof(block)) == sizeof(block) && block.nof_samples != 0) {
+    if (srsran_ringbuffer_read(&q->ring, q->io_buffer, (int)block.nof_bytes) != (int)block.nof_bytes) {
+      break;
+    }
+
+    // Keep draining after an error so that the caller never blocks, the error is reported on the next write
+    if (fwrite(&block, sizeof(block), 1, q->f) != 1 ||
+        fwrite(q->io_buffer, 1, block.nof_bytes, q->f) != block.nof_bytes) {
+      pthread_mutex_lock(&q->mutex);
+      q->error = true;
+      pthread_mutex_unlock(&q->mutex);
+    }
+  }
+
+  return NULL;
+}
+
+int srsran_iq_recorder_init(srsran_iq_recorder_t* q, FILE* f, srsran_iq_file_format_t format, double srate_hz)
+{
+  if (q == NULL || f == NULL || format >= SRSRAN_IQ_FILE_NOF_FORMATS) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_iq_recorder_t));
+  q->f      = f;
+  q->format = format;
+
+  q->temp_int = srsran_vec_i16_malloc(IQ_FILE_NOF_GROUPS(SRSRAN_IQ_FILE_MAX_BLOCK_LEN) * IQ_FILE_BFP_GROUP_NOF_VALUES);
+  q->temp_bytes = srsran_vec_u8_malloc(sizeof(srsran_iq_file_block_t) + IQ_FILE_MAX_NOF_BYTES);
+  q->io_buffer  = srsran_vec_u8_malloc(IQ_FILE_MAX_NOF_BYTES);
+  if (!q->temp_int || !q->temp_bytes || !q->io_buffer) {
+    ERROR("Error allocating memory");
+    srsran_iq_recorder_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_ringbuffer_init(&q->ring, SRSRAN_IQ_FILE_RING_SIZE) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising ring buffer");
+    srsran_iq_recorder_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  // Write the file header
+  srsran_iq_file_header_t header = {};
+  memcpy(header.magic, SRSRAN_IQ_FILE_MAGIC, sizeof(header.magic));
+  header.version  = SRSRAN_IQ_FILE_VERSION;
+  header.format   = (uint32_t)format;
+  header.srate_hz = srate_hz;
+  if (fwrite(&header, sizeof(header), 1, f) != 1) {
+    ERROR("Error writing IQ file header");
+    srsran_iq_recorder_free(q);
+    return SRSRAN_ERROR;
+  }
+  q->nof_bytes = sizeof(header);
+
+  pthread_mutex_init(&q->mutex, NULL);
+  if (pthread_create(&q->thread, NULL, iq_recorder_thread, q)) {
+    perror("pthread_create");
+    pthread_mutex_destroy(&q->mutex);
+    srsran_iq_recorder_free(q);
+    return SRSRAN_ERROR;
+  }
+  q->thread_started = true;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_iq_recorder_write(srsran_iq_recorder_t* q, const cf_t* samples, uint32_t nof_samples, uint64_t timestamp)
+{
+  if (q == NULL || samples == NULL || !q->thread_started) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  bool error = q->error;
+  pthread_mutex_unlock(&q->mutex);
+  if (error) {
+    return SRSRAN_ERROR;
+  }
+
+  // Every block is queued at once, header followed by payload
+  srsran_iq_file_block_t* block   = (srsran_iq_file_block_t*)q->temp_bytes;
+  uint8_t*                payload = q->temp_bytes + sizeof(srsran_iq_file_block_t);
+  for (uint32_t count = 0; count < nof_samples;) {
+    uint32_t len = SRSRAN_MIN(nof_samples - count, SRSRAN_IQ_FILE_MAX_BLOCK_LEN);
+
+    memset(block, 0, sizeof(srsran_iq_file_block_t));
+    block->nof_samples = len;
+    block->timestamp   = timestamp + count;
+    block->nof_bytes   = iq_file_encode(q->format, &samples[count], len, q->temp_int, payload, &block->scale);
+
+    int nof_bytes = (int)(sizeof(srsran_iq_file_block_t) + block->nof_bytes);
+    if (srsran_ringbuffer_write_block(&q->ring, q->temp_bytes, nof_bytes) != nof_bytes) {
+      return SRSRAN_ERROR;
+    }
+
+    q->nof_bytes += nof_bytes;
+    count += len;
+  }
+  q->nof_samples += nof_samples;
+
+  return (int)nof_samples;
+}
+
+void srsran_iq_recorder_free(srsran_iq_recorder_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->thread_started) {
+    // The end of stream block lets the I/O thread write everything queued before it
+    srsran_iq_file_block_t end = {};
+    srsran_ringbuffer_write_block(&q->ring, &end, sizeof(end));
+    pthread_join(q->thread, NULL);
+    pthread_mutex_destroy(&q->mutex);
+    fflush(q->f);
+  }
+
+  if (q->ring.buffer) {
+    srsran_ringbuffer_free(&q->ring);
+  }
+  if (q->temp_int) {
+    free(q->temp_int);
+  }
+  if (q->temp_bytes) {
+    free(q->temp_bytes);
+  }
+  if (q->io_buffer) {
+    free(q->io_buffer);
+  }
+  memset(q, 0, sizeof(srsran_iq_recorder_t));
+}
+
+/*
+ * Player
+ */
+
+static bool iq_player_is_running(srsran_iq_player_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  bool running = q->running;
+  pthread_mutex_unlock(&q->mutex);
+  return running;
+}
+
+/* Reads blocks ahead of the caller, an end of stream block is queued when the recording finishes or is corrupted */
+static void* iq_player_thread(void* arg)
+{
+  srsran_iq_player_t*     q     = (srsran_iq_player_t*)arg;
+  srsran_iq_file_block_t* block = (srsran_iq_file_block_t*)q->io_buffer;
+  srsran_iq_file_format_t fmt   = (srsran_iq_file_format_t)q->header.format;
+
+  while (iq_player_is_running(q)) {
+    if (fread(block, sizeof(srsran_iq_file_block_t), 1, q->f) != 1) {
+      break;
+    }
+
+    if (block->nof_samples == 0 || block->nof_samples > SRSRAN_IQ_FILE_MAX_BLOCK_LEN ||
+        block->nof_bytes != srsran_iq_file_nof_bytes(fmt, block->nof_samples)) {
+      ERROR("Corrupted IQ file block (%d samples, %d bytes)", block->nof_samples, block->nof_bytes);
+      break;
+    }
+
+    if (fread(q->io_buffer + sizeof(srsran_iq_file_block_t), 1, block->nof_bytes, q->f) != block->nof_bytes) {
+      break;
+    }
+
+    srsran_ringbuffer_write_block(&q->ring, q->io_buffer, (int)(sizeof(srsran_iq_file_block_t) + block->nof_bytes));
+  }
+
+  srsran_iq_file_block_t end = {};
+  srsran_ringbuffer_write_block(&q->ring, &end, sizeof(end));
+
+  return NULL;
+}
+
+int srsran_iq_player_init(srsran_iq_player_t* q, FILE* f)
+{
+  if (q == NULL || f == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  memset(q, 0, sizeof(srsran_iq_player_t));
+  q->f = f;
+
+  if (fread(&q->header, sizeof(q->header), 1, f) != 1 ||
+      memcmp(q->header.magic, SRSRAN_IQ_FILE_MAGIC, sizeof(q->header.magic)) != 0) {
+    ERROR("Error reading IQ file header");
+    return SRSRAN_ERROR;
+  }
+
+  if (q->header.version != SRSRAN_IQ_FILE_VERSION || q->header.format >= SRSRAN_IQ_FILE_NOF_FORMATS) {
+    ERROR("Unsupported IQ file version %d or format %d", q->header.version, q->header.format);
+    return SRSRAN_ERROR;
+  }
+
+  q->temp_int = srsran_vec_i16_malloc(IQ_FILE_NOF_GROUPS(SRSRAN_IQ_FILE_MAX_BLOCK_LEN) * IQ_FILE_BFP_GROUP_NOF_VALUES);
+  q->temp_bytes = srsran_vec_u8_malloc(IQ_FILE_MAX_NOF_BYTES);
+  q->io_buffer  = srsran_vec_u8_malloc(sizeof(srsran_iq_file_block_t) + IQ_FILE_MAX_NOF_BYTES);
+  q->block      = srsran_vec_cf_malloc(SRSRAN_IQ_FILE_MAX_BLOCK_LEN);
+  if (!q->temp_int || !q->temp_bytes || !q->io_buffer || !q->block) {
+    ERROR("Error allocating memory");
+    srsran_iq_player_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_ringbuffer_init(&q->ring, SRSRAN_IQ_FILE_RING_SIZE) < SRSRAN_SUCCESS) {
+    ERROR("Error initialising ring buffer");
+    srsran_iq_player_free(q);
+    return SRSRAN_ERROR;
+  }
+
+  pthread_mutex_init(&q->mutex, NULL);
+  q->running = true;
+  if (pthread_create(&q->thread, NULL, iq_player_thread, q)) {
+    perror("pthread_create");
+    pthread_mutex_destroy(&q->mutex);
+    srsran_iq_player_free(q);
+    return SRSRAN_ERROR;
+  }
+  q->thread_started = true;
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Decodes the next block queued by the I/O thread */
+static int iq_player_next_block(srsran_iq_player_t* q)
+{
+  srsran_iq_file_block_t block = {};
+  if (srsran_ringbuffer_read(&q->ring, &block, sizeof(block)) != sizeof(block) || block.nof_samples == 0) {
+    return SRSRAN_ERROR_RX_EOF;
+  }
+  if (srsran_ringbuffer_read(&q->ring, q->temp_bytes, (int)block.nof_bytes) != (int)block.nof_bytes) {
+    return SRSRAN_ERROR_RX_EOF;
+  }
+
+  iq_file_decode(
+      (srsran_iq_file_format_t)q->header.format, q->temp_bytes, block.nof_samples, block.scale, q->temp_int, q->block);
+  q->block_len = block.nof_samples;
+  q->block_ts  = block.timestamp;
+
+  // Samples recorded in the past of the playback are skipped
+  q->block_pos = (q->ts > q->block_ts) ? (uint32_t)SRSRAN_MIN(q->ts - q->block_ts, q->block_len) : 0;
+  q->block_ts += q->block_pos;
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_iq_player_read(srsran_iq_player_t* q, cf_t* samples, uint32_t nof_samples)
+{
+  if (q == NULL || samples == NULL || !q->thread_started) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  uint32_t count = 0;
+  while (count < nof_samples) {
+    if (q->block_pos == q->block_len) {
+      if (q->eof || iq_player_next_block(q) < SRSRAN_SUCCESS) {
+        q->eof = true;
+        break;
+      }
+      continue;
+    }
+
+    // Fill the gap until the next recorded sample with zeros
+    uint32_t len = 0;
+    if (q->ts < q->block_ts) {
+      len = (uint32_t)SRSRAN_MIN(nof_samples - count, q->block_ts - q->ts);
+      srsran_vec_cf_zero(&samples[count], len);
+    } else {
+      len = SRSRAN_MIN(nof_samples - count, q->block_len - q->block_pos);
+      srsran_vec_cf_copy(&samples[count], &q->block[q->block_pos], len);
+      q->block_pos += len;
+      q->block_ts += len;
+    }
+    q->ts += len;
+    count += len;
+  }
+
+  return (count > 0) ? (int)count : SRSRAN_ERROR_RX_EOF;
+}
+
+double srsran_iq_player_get_srate(srsran_iq_player_t* q)
+{
+  return (q) ? q->header.srate_hz : 0.0;
+}
+
+void srsran_iq_player_free(srsran_iq_player_t* q)
+{
+  if (q == NULL) {
+    return;
+  }
+
+  if (q->thread_started) {
+    pthread_mutex_lock(&q->mutex);
+    q->running = false;
+    pthread_mutex_unlock(&q->mutex);
+
+    // Unblocks the I/O thread if it is waiting for space
+    srsran_ringbuffer_stop(&q->ring);
+    pthread_join(q->thread, NULL);
+    pthread_mutex_destroy(&q->mutex);
+  }
+
+  if (q->ring.buffer) {
+    srsran_ringbuffer_free(&q->ring);
+  }
+  if (q->temp_int) {
+    free(q->temp_int);
+  }
+  if (q->temp_bytes) {
+    free(q->temp_bytes);
+  }
+  if (q->io_buffer) {
+    free(q->io_buffer);
+  }
+  if (q->block) {
+    free(q->block);
+  }
+  memset(q, 0, sizeof(srsran_iq_player_t));
+}
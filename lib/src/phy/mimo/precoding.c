@@ -1011,6 +1011,338 @@ static int srsran_predecoding_ccd_2x2_zf(cf_t* y[SRSRAN_MAX_PORTS],
   return SRSRAN_SUCCESS;
 }
 
+/* 4-port precoding for spatial multiplexing and large delay CDD, 36.211 v10.3.0 Section 6.3.4.2.
+ *
+ * The precoding matrix of every symbol is taken from a small table indexed by the symbol index modulo its period: 1
+ * for spatial multiplexing and 4 x nof_layers for large delay CDD. The table is extended with SRSRAN_SIMD_CF_SIZE
+ * wrapped entries so the SIMD detector can load one row of matrices from any offset without wrapping.
+ */
+#define PRECODER_4P_MAX_PERIOD 16
+
+typedef struct {
+  uint32_t period;
+  cf_t     w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS][PRECODER_4P_MAX_PERIOD + SRSRAN_SIMD_CF_SIZE];
+} precoder_4p_t;
+
+/* Generating vectors u_n of Table 6.3.4.2.3-2 */
+static const cf_t precoder_4p_u[16][4] = {
+    {1.0f, -1.0f, -1.0f, -1.0f},
+    {1.0f, -_Complex_I, 1.0f, _Complex_I},
+    {1.0f, 1.0f, -1.0f, 1.0f},
+    {1.0f, _Complex_I, 1.0f, -_Complex_I},
+    {1.0f, (-1.0f - _Complex_I) * (float)M_SQRT1_2, -_Complex_I, (1.0f - _Complex_I) * (float)M_SQRT1_2},
+    {1.0f, (1.0f - _Complex_I) * (float)M_SQRT1_2, _Complex_I, (-1.0f - _Complex_I) * (float)M_SQRT1_2},
+    {1.0f, (1.0f + _Complex_I) * (float)M_SQRT1_2, -_Complex_I, (-1.0f + _Complex_I) * (float)M_SQRT1_2},
+    {1.0f, (-1.0f + _Complex_I) * (float)M_SQRT1_2, _Complex_I, (1.0f + _Complex_I) * (float)M_SQRT1_2},
+    {1.0f, -1.0f, 1.0f, 1.0f},
+    {1.0f, -_Complex_I, -1.0f, -_Complex_I},
+    {1.0f, 1.0f, 1.0f, -1.0f},
+    {1.0f, _Complex_I, -1.0f, _Complex_I},
+    {1.0f, -1.0f, -1.0f, 1.0f},
+    {1.0f, -1.0f, 1.0f, -1.0f},
+    {1.0f, 1.0f, -1.0f, -1.0f},
+    {1.0f, 1.0f, 1.0f, 1.0f},
+};
+
+/* Columns of W_n selected for each number of layers, Table 6.3.4.2.3-2 */
+static const uint8_t precoder_4p_columns[16][SRSRAN_MAX_LAYERS][SRSRAN_MAX_LAYERS] = {
+    {{0}, {0, 3}, {0, 1, 3}, {0, 1, 2, 3}},
+    {{0}, {0, 1}, {0, 1, 2}, {0, 1, 2, 3}},
+    {{0}, {0, 1}, {0, 1, 2}, {2, 1, 0, 3}},
+    {{0}, {0, 1}, {0, 1, 2}, {2, 1, 0, 3}},
+    {{0}, {0, 3}, {0, 1, 3}, {0, 1, 2, 3}},
+    {{0}, {0, 3}, {0, 1, 3}, {0, 1, 2, 3}},
+    {{0}, {0, 2}, {0, 2, 3}, {0, 2, 1, 3}},
+    {{0}, {0, 2}, {0, 2, 3}, {0, 2, 1, 3}},
+    {{0}, {0, 1}, {0, 1, 3}, {0, 1, 2, 3}},
+    {{0}, {0, 3}, {0, 2, 3}, {0, 1, 2, 3}},
+    {{0}, {0, 2}, {0, 1, 2}, {0, 2, 1, 3}},
+    {{0}, {0, 2}, {0, 2, 3}, {0, 2, 1, 3}},
+    {{0}, {0, 1}, {0, 1, 2}, {0, 1, 2, 3}},
+    {{0}, {0, 2}, {0, 1, 2}, {0, 2, 1, 3}},
+    {{0}, {0, 2}, {0, 1, 2}, {2, 1, 0, 3}},
+    {{0}, {0, 1}, {0, 1, 2}, {0, 1, 2, 3}},
+};
+
+/* W_n = I - 2 u_n u_n' / (u_n' u_n), columns selected for nof_layers and normalised by scaling / sqrt(nof_layers) */
+static void precoder_4p_codebook(uint32_t codebook_idx,
+                                 uint32_t nof_layers,
+                                 float    scaling,
+                                 cf_t     w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS])
+{
+  const cf_t* u    = precoder_4p_u[codebook_idx];
+  float       norm = scaling / sqrtf((float)nof_layers);
+
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    uint32_t c = precoder_4p_columns[codebook_idx][nof_layers - 1][l];
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      w[p][l] = ((p == c ? 1.0f : 0.0f) - 0.5f * u[p] * conjf(u[c])) * norm;
+    }
+  }
+}
+
+static void precoder_4p_pad(precoder_4p_t* q, uint32_t nof_layers)
+{
+  for (uint32_t k = q->period; k < q->period + SRSRAN_SIMD_CF_SIZE; k++) {
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        q->w[p][l][k] = q->w[p][l][k % q->period];
+      }
+    }
+  }
+}
+
+static int precoder_4p_multiplex_init(precoder_4p_t* q, uint32_t nof_layers, uint32_t codebook_idx, float scaling)
+{
+  if (nof_layers == 0 || nof_layers > SRSRAN_MAX_LAYERS || codebook_idx > 15) {
+    ERROR("Invalid multiplex combination: codebook_idx=%d, nof_layers=%d, nof_ports=4", codebook_idx, nof_layers);
+    return SRSRAN_ERROR;
+  }
+
+  cf_t w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+  precoder_4p_codebook(codebook_idx, nof_layers, scaling, w);
+
+  q->period = 1;
+  for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+    for (uint32_t l = 0; l < nof_layers; l++) {
+      q->w[p][l][0] = w[p][l];
+    }
+  }
+  precoder_4p_pad(q, nof_layers);
+  return SRSRAN_SUCCESS;
+}
+
+/* Large delay CDD, W(i) x D(i) x U where W(i) cycles through the codebook indexes 12 to 15 every nof_layers symbols */
+static int precoder_4p_cdd_init(precoder_4p_t* q, uint32_t nof_layers, float scaling)
+{
+  if (nof_layers < 2 || nof_layers > SRSRAN_MAX_LAYERS) {
+    ERROR("Invalid number of layers %d for 4 ports", nof_layers);
+    return SRSRAN_ERROR;
+  }
+
+  q->period = 4 * nof_layers;
+  for (uint32_t i = 0; i < q->period; i++) {
+    cf_t w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+    precoder_4p_codebook(12 + (i / nof_layers) % 4, nof_layers, scaling / sqrtf((float)nof_layers), w);
+
+    // D(i) x U is a DFT matrix shifted by the symbol index
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        cf_t acc = 0.0f;
+        for (uint32_t m = 0; m < nof_layers; m++) {
+          acc += w[p][m] * cexpf(-_Complex_I * 2.0f * (float)M_PI * (float)((m * (i + l)) % nof_layers) / nof_layers);
+        }
+        q->w[p][l][i] = acc;
+      }
+    }
+  }
+  precoder_4p_pad(q, nof_layers);
+  return SRSRAN_SUCCESS;
+}
+
+static void precoding_4p(const precoder_4p_t* q,
+                         cf_t*                x[SRSRAN_MAX_LAYERS],
+                         cf_t*                y[SRSRAN_MAX_PORTS],
+                         int                  nof_layers,
+                         int                  nof_symbols)
+{
+  for (int i = 0; i < nof_symbols; i++) {
+    uint32_t k = i % q->period;
+    for (int p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      cf_t acc = 0.0f;
+      for (int l = 0; l < nof_layers; l++) {
+        acc += q->w[p][l][k] * x[l][i];
+      }
+      y[p][i] = acc;
+    }
+  }
+}
+
+/* Codeword 0 takes the first max(1, nof_layers / 2) layers, its CSI is interleaved in the layer demapping order */
+static void
+predecoding_4p_csi_map(uint32_t nof_layers, uint32_t layer, uint32_t* cw, uint32_t* cw_nof_layers, uint32_t* idx)
+{
+  uint32_t nof_layers_cw0 = nof_layers < 2 ? nof_layers : nof_layers / 2;
+  if (layer < nof_layers_cw0) {
+    *cw            = 0;
+    *cw_nof_layers = nof_layers_cw0;
+    *idx           = layer;
+  } else {
+    *cw            = 1;
+    *cw_nof_layers = nof_layers - nof_layers_cw0;
+    *idx           = layer - nof_layers_cw0;
+  }
+}
+
+static inline void predecoding_4p_run(const precoder_4p_t* q,
+                                      cf_t*                y[SRSRAN_MAX_PORTS],
+                                      cf_t*                h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                      cf_t*                x[SRSRAN_MAX_LAYERS],
+                                      float*               csi[SRSRAN_MAX_CODEWORDS],
+                                      uint32_t             nof_rxant,
+                                      uint32_t             nof_layers,
+                                      int                  nof_symbols,
+                                      float                noise_estimate)
+{
+  uint32_t csi_cw[SRSRAN_MAX_LAYERS], csi_n[SRSRAN_MAX_LAYERS], csi_idx[SRSRAN_MAX_LAYERS];
+  bool     has_csi = csi != NULL;
+  for (uint32_t l = 0; l < nof_layers; l++) {
+    predecoding_4p_csi_map(nof_layers, l, &csi_cw[l], &csi_n[l], &csi_idx[l]);
+    has_csi = has_csi && csi[csi_cw[l]] != NULL;
+  }
+
+  int i = 0;
+
+#if SRSRAN_SIMD_CF_SIZE != 0
+  for (; i < nof_symbols - SRSRAN_SIMD_CF_SIZE + 1; i += SRSRAN_SIMD_CF_SIZE) {
+    uint32_t  offset = i % q->period;
+    simd_cf_t _y[SRSRAN_MAX_PORTS], _x[SRSRAN_MAX_LAYERS], g[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+    simd_cf_t w[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+    simd_f_t  _csi[SRSRAN_MAX_LAYERS];
+
+    for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        w[p][l] = srsran_simd_cfi_loadu(&q->w[p][l][offset]);
+      }
+    }
+
+    /* Effective channel per layer, G = H x W */
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      _y[r] = srsran_simd_cfi_load(&y[r][i]);
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        g[r][l] = srsran_simd_cf_zero();
+      }
+      for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+        simd_cf_t hp = srsran_simd_cfi_load(&h[p][r][i]);
+        for (uint32_t l = 0; l < nof_layers; l++) {
+          g[r][l] = srsran_simd_cf_add(g[r][l], srsran_simd_cf_prod(hp, w[p][l]));
+        }
+      }
+    }
+
+    srsran_mat_4x4_mmse_csi_simd(_y, g, nof_rxant, nof_layers, _x, has_csi ? _csi : NULL, noise_estimate);
+
+    for (uint32_t l = 0; l < nof_layers; l++) {
+      srsran_simd_cfi_store(&x[l][i], _x[l]);
+      if (has_csi) {
+        float* c = csi[csi_cw[l]];
+        if (csi_n[l] == 1) {
+          srsran_simd_f_storeu(&c[i], _csi[l]);
+        } else {
+          float tmp[SRSRAN_SIMD_F_SIZE];
+          srsran_simd_f_storeu(tmp, _csi[l]);
+          for (uint32_t k = 0; k < SRSRAN_SIMD_F_SIZE; k++) {
+            c[csi_n[l] * (i + k) + csi_idx[l]] = tmp[k];
+          }
+        }
+      }
+    }
+  }
+#endif /* SRSRAN_SIMD_CF_SIZE != 0 */
+
+  for (; i < nof_symbols; i++) {
+    uint32_t k = i % q->period;
+    cf_t     _y[SRSRAN_MAX_PORTS], _x[SRSRAN_MAX_LAYERS], g[SRSRAN_MAX_PORTS][SRSRAN_MAX_LAYERS];
+    float    _csi[SRSRAN_MAX_LAYERS];
+
+    for (uint32_t r = 0; r < nof_rxant; r++) {
+      _y[r] = y[r][i];
+      for (uint32_t l = 0; l < nof_layers; l++) {
+        g[r][l] = 0.0f;
+        for (uint32_t p = 0; p < SRSRAN_MAX_PORTS; p++) {
+          g[r][l] += h[p][r][i] * q->w[p][l][k];
+        }
+      }
+    }
+
+    srsran_mat_4x4_mmse_csi_gen(_y, g, nof_rxant, nof_layers, _x, has_csi ? _csi : NULL, noise_estimate);
+
+    for (uint32_t l = 0; l < nof_layers; l++) {
+      x[l][i] = _x[l];
+      if (has_csi) {
+        csi[csi_cw[l]][csi_n[l] * i + csi_idx[l]] = _csi[l];
+      }
+    }
+  }
+}
+
+/* Joint ZF/MMSE detection of up to 4 layers over up to 4 receive antennas, the precoder is folded into the channel
+ * and the 4x4 solver runs on SRSRAN_SIMD_CF_SIZE resource elements at once. The number of layers is passed as a
+ * constant so the solver loops are fully unrolled. */
+static int predecoding_4p(const precoder_4p_t* q,
+                          cf_t*                y[SRSRAN_MAX_PORTS],
+                          cf_t*                h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                          cf_t*                x[SRSRAN_MAX_LAYERS],
+                          float*               csi[SRSRAN_MAX_CODEWORDS],
+                          int                  nof_rxant,
+                          int                  nof_layers,
+                          int                  nof_symbols,
+                          float                noise_estimate)
+{
+  if (nof_rxant < 1 || nof_rxant > SRSRAN_MAX_PORTS || nof_layers > nof_rxant) {
+    ERROR("Error predecoding 4 ports: Invalid combination of layers %d and rx antennas %d", nof_layers, nof_rxant);
+    return SRSRAN_ERROR;
+  }
+
+  if (mimo_decoder == SRSRAN_MIMO_DECODER_ZF) {
+    noise_estimate = 0.0f;
+  }
+
+  switch (nof_layers) {
+    case 1:
+      predecoding_4p_run(q, y, h, x, csi, nof_rxant, 1, nof_symbols, noise_estimate);
+      break;
+    case 2:
+      predecoding_4p_run(q, y, h, x, csi, nof_rxant, 2, nof_symbols, noise_estimate);
+      break;
+    case 3:
+      predecoding_4p_run(q, y, h, x, csi, nof_rxant, 3, nof_symbols, noise_estimate);
+      break;
+    case 4:
+      predecoding_4p_run(q, y, h, x, csi, nof_rxant, 4, nof_symbols, noise_estimate);
+      break;
+    default:
+      ERROR("Error predecoding 4 ports: Invalid number of layers %d", nof_layers);
+      return SRSRAN_ERROR;
+  }
+  return SRSRAN_SUCCESS;
+}
+
+static int srsran_predecoding_multiplex_4p(cf_t*  y[SRSRAN_MAX_PORTS],
+                                           cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                           cf_t*  x[SRSRAN_MAX_LAYERS],
+                                           float* csi[SRSRAN_MAX_CODEWORDS],
+                                           int    nof_rxant,
+                                           int    nof_layers,
+                                           int    codebook_idx,
+                                           int    nof_symbols,
+                                           float  scaling,
+                                           float  noise_estimate)
+{
+  precoder_4p_t q;
+  if (precoder_4p_multiplex_init(&q, nof_layers, codebook_idx, scaling) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  return predecoding_4p(&q, y, h, x, csi, nof_rxant, nof_layers, nof_symbols, noise_estimate);
+}
+
+static int srsran_predecoding_ccd_4p(cf_t*  y[SRSRAN_MAX_PORTS],
+                                     cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
+                                     cf_t*  x[SRSRAN_MAX_LAYERS],
+                                     float* csi[SRSRAN_MAX_CODEWORDS],
+                                     int    nof_rxant,
+                                     int    nof_layers,
+                                     int    nof_symbols,
+                                     float  scaling,
+                                     float  noise_estimate)
+{
+  precoder_4p_t q;
+  if (precoder_4p_cdd_init(&q, nof_layers, scaling) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  return predecoding_4p(&q, y, h, x, csi, nof_rxant, nof_layers, nof_symbols, noise_estimate);
+}
+
 static int srsran_predecoding_ccd_zf(cf_t*  y[SRSRAN_MAX_PORTS],
                                      cf_t*  h[SRSRAN_MAX_PORTS][SRSRAN_MAX_PORTS],
                                      cf_t*  x[SRSRAN_MAX_LAYERS],
@@ -1033,7 +1365,7 @@ static int srsran_predecoding_ccd_zf(cf_t*  y[SRSRAN_MAX_PORTS],
       return -1;
     }
   } else if (nof_ports == 4) {
-    ERROR("Error predecoding CCD: Only 2 ports supported");
+    return srsran_predecoding_ccd_4p(y, h, x, csi, nof_rxant, nof_layers, nof_symbols, scaling, 0.0f);
   } else {
     ERROR("Error predecoding CCD: Invalid combination of ports %d and rx antennax %d", nof_ports, nof_rxant);
   }
@@ -1216,7 +1548,7 @@ int srsran_predecoding_ccd_mmse(cf_t*  y[SRSRAN_MAX_PORTS],
       return -1;
     }
   } else if (nof_ports == 4) {
-    ERROR("Error predecoding CCD: Only 2 ports supported");
+    return srsran_predecoding_ccd_4p(y, h, x, csi, nof_rxant, nof_layers, nof_symbols, scaling, noise_estimate);
   } else {
     ERROR("Error predecoding CCD: Invalid combination of ports %d and rx antennax %d", nof_ports, nof_rxant);
   }
@@ -1850,7 +2182,8 @@ static int srsran_predecoding_multiplex(cf_t*  y[SRSRAN_MAX_PORTS],
       }
     }
   } else if (nof_ports == 4) {
-    ERROR("Error predecoding multiplex: not implemented for %d Tx ports", nof_ports);
+    return srsran_predecoding_multiplex_4p(
+        y, h, x, csi, nof_rxant, nof_layers, codebook_idx, nof_symbols, scaling, noise_estimate);
   } else {
     ERROR("Error predecoding multiplex: Invalid combination of ports %d and rx antennas %d", nof_ports, nof_rxant);
   }
@@ -1887,7 +2220,7 @@ int srsran_predecoding_type(cf_t*              y[SRSRAN_MAX_PORTS],
 
   switch (type) {
     case SRSRAN_TXSCHEME_CDD:
-      if (nof_layers == 2) {
+      if (nof_layers == 2 || (nof_ports == 4 && nof_layers > 2)) {
         switch (mimo_decoder) {
           case SRSRAN_MIMO_DECODER_ZF:
             return srsran_predecoding_ccd_zf(y, h, x, csi, nof_rxant, nof_ports, nof_layers, nof_symbols, scaling);
@@ -2076,8 +2409,12 @@ int srsran_precoding_cdd(cf_t* x[SRSRAN_MAX_LAYERS],
 #endif /* LV_HAVE_SSE */
 #endif /* LV_HAVE_AVX */
   } else if (nof_ports == 4) {
-    ERROR("Not implemented");
-    return -1;
+    precoder_4p_t q;
+    if (precoder_4p_cdd_init(&q, nof_layers, scaling) < SRSRAN_SUCCESS) {
+      return -1;
+    }
+    precoding_4p(&q, x, y, nof_layers, nof_symbols);
+    return nof_ports * nof_symbols;
   } else {
     ERROR("Number of ports must be 2 or 4 for transmit diversity (nof_ports=%d)", nof_ports);
     return -1;
@@ -2204,6 +2541,12 @@ int srsran_precoding_multiplex(cf_t*    x[SRSRAN_MAX_LAYERS],
     } else {
       ERROR("Not implemented");
     }
+  } else if (nof_ports == 4) {
+    precoder_4p_t q;
+    if (precoder_4p_multiplex_init(&q, nof_layers, codebook_idx, scaling) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    precoding_4p(&q, x, y, nof_layers, nof_symbols);
   } else {
     ERROR("Not implemented");
   }
@@ -35,6 +35,7 @@
 #define MSE_THRESHOLD 0.0005
 
 int                    nof_symbols  = 1000;
+int                    nof_trials   = 1;
 uint32_t               codebook_idx = 0;
 int                    nof_layers = 1, nof_tx_ports = 1, nof_rx_ports = 1, nof_re = 1;
 char*                  mimo_type_name        = NULL;
@@ -57,6 +58,7 @@ void usage(char* prog)
   printf("\t-s SNR in dB [Default %.1fdB]*\n", snr_db);
   printf("\t-g Scaling [Default %.1f]*\n", scaling);
   printf("\t-d decoder type [zf|mmse] [Default %s]\n", decoder_type_name);
+  printf("\t-t nof_trials, repeats the predecoding for measuring throughput [Default %d]\n", nof_trials);
   printf("\n");
   printf("* Performance test example:\n\t for snr in {0..20..1}; do ./precoding_test -m single -s $snr; done; \n\n");
 }
@@ -64,7 +66,7 @@ void usage(char* prog)
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "mplnrcdsg")) != -1) {
+  while ((opt = getopt(argc, argv, "mplnrcdsgt")) != -1) {
     switch (opt) {
       case 'n':
         nof_symbols = (int)strtol(argv[optind], NULL, 10);
@@ -94,6 +96,9 @@ void parse_args(int argc, char** argv)
       case 'g':
         scaling = strtof(argv[optind], NULL);
         break;
+      case 't':
+        nof_trials = (int)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -201,8 +206,8 @@ int main(int argc, char** argv)
       nof_re = nof_symbols;
       break;
     case SRSRAN_TXSCHEME_CDD:
-      nof_re = nof_symbols * nof_tx_ports / nof_layers;
-      if (nof_rx_ports != 2 || nof_tx_ports != 2) {
+      nof_re = nof_symbols;
+      if ((nof_rx_ports != 2 || nof_tx_ports != 2) && (nof_rx_ports != 4 || nof_tx_ports != 4)) {
         ERROR("CDD nof_tx_ports=%d nof_rx_ports=%d is not currently supported", nof_tx_ports, nof_rx_ports);
         exit(-1);
       }
@@ -301,20 +306,27 @@ int main(int argc, char** argv)
   /* predecoding / equalization */
   struct timeval t[3];
   gettimeofday(&t[1], NULL);
-  srsran_predecoding_type(r,
-                          h,
-                          xr,
-                          NULL,
-                          nof_rx_ports,
-                          nof_tx_ports,
-                          nof_layers,
-                          codebook_idx,
-                          nof_re,
-                          type,
-                          scaling,
-                          srsran_convert_dB_to_power(-snr_db));
+  for (i = 0; i < nof_trials; i++) {
+    if (srsran_predecoding_type(r,
+                                h,
+                                xr,
+                                NULL,
+                                nof_rx_ports,
+                                nof_tx_ports,
+                                nof_layers,
+                                codebook_idx,
+                                nof_re,
+                                type,
+                                scaling,
+                                srsran_convert_dB_to_power(-snr_db)) < SRSRAN_SUCCESS) {
+      ERROR("Error predecoding");
+      ret = SRSRAN_ERROR;
+      goto quit;
+    }
+  }
   gettimeofday(&t[2], NULL);
   get_time_interval(t);
+  uint64_t elapsed_us = t[0].tv_sec * 1000000UL + t[0].tv_usec;
 
   /* check errors */
   mse = 0;
@@ -330,11 +342,12 @@ int main(int argc, char** argv)
       }
     }
   }
-  printf("SNR: %5.1fdB;\tExecution time: %5ldus;\tMSE: %.6f;\tBER: %.6f\n",
+  printf("SNR: %5.1fdB;\tExecution time: %5ldus;\tMSE: %.6f;\tBER: %.6f;\tThroughput: %.1f MRE/s\n",
          snr_db,
-         t[0].tv_usec,
+         (long)(elapsed_us / nof_trials),
          mse / nof_layers / nof_symbols,
-         (float)nof_errors / (4.0f * nof_re));
+         (float)nof_errors / (4.0f * nof_re),
+         (double)nof_re * nof_trials / (double)SRSRAN_MAX(elapsed_us, 1));
   if (mse / nof_layers / nof_symbols > MSE_THRESHOLD) {
     ret = SRSRAN_ERROR;
   }
@@ -799,7 +799,17 @@ void demod_256qam_lte(const cf_t* symbols, float* llr, int nsymbols)
   }
 }
 
-void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+/*
+ * 256QAM fixed point kernels. Every LLR level is computed for the real and imaginary parts at once:
+ *   llr0 = -y, llr1 = |llr0| - 8/sqrt(170), llr2 = |llr1| - 4/sqrt(170), llr3 = |llr2| - 2/sqrt(170)
+ * and the (re, im) pairs of the four levels are interleaved to get the 8 LLRs of every symbol. A further constellation
+ * size only adds one abs/sub level and one more interleaved vector.
+ *
+ * Each SIMD kernel processes as many full blocks as possible and returns the number of demodulated symbols, the rest
+ * are left to the next narrower kernel.
+ */
+
+static void demod_256qam_lte_b_generic(const cf_t* symbols, int8_t* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
@@ -821,7 +831,7 @@ void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
   }
 }
 
-void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+static void demod_256qam_lte_s_generic(const cf_t* symbols, short* llr, int nsymbols)
 {
   for (int i = 0; i < nsymbols; i++) {
     float real = -__real__ symbols[i];
@@ -843,6 +853,359 @@ void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
   }
 }
 
+#ifdef LV_HAVE_AVX512
+#include <immintrin.h>
+
+// Transposes the 128-bit lanes of a, b, c and d, each lane holds the complete LLRs of one or two symbols
+#define transpose_4x4_lanes(a, b, c, d, out)                                                                           \
+  do {                                                                                                                 \
+    __m512i t0 = _mm512_shuffle_i64x2(a, b, 0x44);                                                                     \
+    __m512i t1 = _mm512_shuffle_i64x2(c, d, 0x44);                                                                     \
+    __m512i t2 = _mm512_shuffle_i64x2(a, b, 0xee);                                                                     \
+    __m512i t3 = _mm512_shuffle_i64x2(c, d, 0xee);                                                                     \
+    out[0]     = _mm512_shuffle_i64x2(t0, t1, 0x88);                                                                   \
+    out[1]     = _mm512_shuffle_i64x2(t0, t1, 0xdd);                                                                   \
+    out[2]     = _mm512_shuffle_i64x2(t2, t3, 0x88);                                                                   \
+    out[3]     = _mm512_shuffle_i64x2(t2, t3, 0xdd);                                                                   \
+  } while (0)
+
+static int demod_256qam_lte_s_avx512(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float* symbols_ptr = (const float*)symbols;
+  __m512       scale_v     = _mm512_set1_ps(-SCALE_SHORT_CONV_QAM256);
+  __m512i      offset1     = _mm512_set1_epi16(8 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m512i      offset2     = _mm512_set1_epi16(4 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m512i      offset3     = _mm512_set1_epi16(2 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m512i      result[4];
+
+  int i = 0;
+  for (; i + 16 <= nsymbols; i += 16) {
+    __m512  symbol1 = _mm512_loadu_ps(symbols_ptr + 2 * i);
+    __m512  symbol2 = _mm512_loadu_ps(symbols_ptr + 2 * i + 16);
+    __m256i llr_lo  = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(_mm512_mul_ps(symbol1, scale_v)));
+    __m256i llr_hi  = _mm512_cvtsepi32_epi16(_mm512_cvtps_epi32(_mm512_mul_ps(symbol2, scale_v)));
+    __m512i llr0    = _mm512_inserti64x4(_mm512_castsi256_si512(llr_lo), llr_hi, 1);
+    __m512i llr1    = _mm512_sub_epi16(_mm512_abs_epi16(llr0), offset1);
+    __m512i llr2    = _mm512_sub_epi16(_mm512_abs_epi16(llr1), offset2);
+    __m512i llr3    = _mm512_sub_epi16(_mm512_abs_epi16(llr2), offset3);
+
+    // Lane j of llr01_lo holds symbols 4j and 4j + 1, so the unpacked vectors hold symbols {0, 4, 8, 12}, {1, 5, ...}
+    __m512i llr01_lo = _mm512_unpacklo_epi32(llr0, llr1);
+    __m512i llr01_hi = _mm512_unpackhi_epi32(llr0, llr1);
+    __m512i llr23_lo = _mm512_unpacklo_epi32(llr2, llr3);
+    __m512i llr23_hi = _mm512_unpackhi_epi32(llr2, llr3);
+    transpose_4x4_lanes(_mm512_unpacklo_epi64(llr01_lo, llr23_lo),
+                        _mm512_unpackhi_epi64(llr01_lo, llr23_lo),
+                        _mm512_unpacklo_epi64(llr01_hi, llr23_hi),
+                        _mm512_unpackhi_epi64(llr01_hi, llr23_hi),
+                        result);
+
+    for (int j = 0; j < 4; j++) {
+      _mm512_storeu_si512(llr + 8 * i + 32 * j, result[j]);
+    }
+  }
+  return i;
+}
+
+static int demod_256qam_lte_b_avx512(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float* symbols_ptr = (const float*)symbols;
+  __m512       scale_v     = _mm512_set1_ps(-SCALE_BYTE_CONV_QAM256);
+  __m512i      offset1     = _mm512_set1_epi8(8 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m512i      offset2     = _mm512_set1_epi8(4 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m512i      offset3     = _mm512_set1_epi8(2 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m512i      result[4];
+
+  int i = 0;
+  for (; i + 32 <= nsymbols; i += 32) {
+    __m128i llr_q[4];
+    for (int j = 0; j < 4; j++) {
+      __m512 symbol = _mm512_loadu_ps(symbols_ptr + 2 * i + 16 * j);
+      llr_q[j]      = _mm512_cvtsepi32_epi8(_mm512_cvtps_epi32(_mm512_mul_ps(symbol, scale_v)));
+    }
+    __m256i llr_lo = _mm256_inserti128_si256(_mm256_castsi128_si256(llr_q[0]), llr_q[1], 1);
+    __m256i llr_hi = _mm256_inserti128_si256(_mm256_castsi128_si256(llr_q[2]), llr_q[3], 1);
+    __m512i llr0   = _mm512_inserti64x4(_mm512_castsi256_si512(llr_lo), llr_hi, 1);
+    __m512i llr1   = _mm512_sub_epi8(_mm512_abs_epi8(llr0), offset1);
+    __m512i llr2   = _mm512_sub_epi8(_mm512_abs_epi8(llr1), offset2);
+    __m512i llr3   = _mm512_sub_epi8(_mm512_abs_epi8(llr2), offset3);
+
+    // Lane j of llr01_lo holds symbols 8j to 8j + 3, the unpacked vectors hold symbols {0, 1, 8, 9, ...}, {2, 3, ...}
+    __m512i llr01_lo = _mm512_unpacklo_epi16(llr0, llr1);
+    __m512i llr01_hi = _mm512_unpackhi_epi16(llr0, llr1);
+    __m512i llr23_lo = _mm512_unpacklo_epi16(llr2, llr3);
+    __m512i llr23_hi = _mm512_unpackhi_epi16(llr2, llr3);
+    transpose_4x4_lanes(_mm512_unpacklo_epi32(llr01_lo, llr23_lo),
+                        _mm512_unpackhi_epi32(llr01_lo, llr23_lo),
+                        _mm512_unpacklo_epi32(llr01_hi, llr23_hi),
+                        _mm512_unpackhi_epi32(llr01_hi, llr23_hi),
+                        result);
+
+    for (int j = 0; j < 4; j++) {
+      _mm512_storeu_si512(llr + 8 * i + 64 * j, result[j]);
+    }
+  }
+  return i;
+}
+
+#endif /* LV_HAVE_AVX512 */
+
+#ifdef LV_HAVE_AVX2
+#include <immintrin.h>
+
+static int demod_256qam_lte_s_avx2(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float* symbols_ptr = (const float*)symbols;
+  __m256       scale_v     = _mm256_set1_ps(-SCALE_SHORT_CONV_QAM256);
+  __m256i      offset1     = _mm256_set1_epi16(8 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m256i      offset2     = _mm256_set1_epi16(4 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m256i      offset3     = _mm256_set1_epi16(2 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m256i*     result_ptr  = (__m256i*)llr;
+
+  int i = 0;
+  for (; i + 8 <= nsymbols; i += 8) {
+    __m256  symbol1 = _mm256_loadu_ps(symbols_ptr + 2 * i);
+    __m256  symbol2 = _mm256_loadu_ps(symbols_ptr + 2 * i + 8);
+    __m256i llr0    = _mm256_packs_epi32(_mm256_cvtps_epi32(_mm256_mul_ps(symbol1, scale_v)),
+                                      _mm256_cvtps_epi32(_mm256_mul_ps(symbol2, scale_v)));
+    // The pack works in 128-bit lanes, restore the symbol order
+    llr0         = _mm256_permute4x64_epi64(llr0, 0xd8);
+    __m256i llr1 = _mm256_sub_epi16(_mm256_abs_epi16(llr0), offset1);
+    __m256i llr2 = _mm256_sub_epi16(_mm256_abs_epi16(llr1), offset2);
+    __m256i llr3 = _mm256_sub_epi16(_mm256_abs_epi16(llr2), offset3);
+
+    // result04 holds symbol 0 in the first lane and symbol 4 in the second one, and so on
+    __m256i llr01_lo = _mm256_unpacklo_epi32(llr0, llr1);
+    __m256i llr01_hi = _mm256_unpackhi_epi32(llr0, llr1);
+    __m256i llr23_lo = _mm256_unpacklo_epi32(llr2, llr3);
+    __m256i llr23_hi = _mm256_unpackhi_epi32(llr2, llr3);
+    __m256i result04 = _mm256_unpacklo_epi64(llr01_lo, llr23_lo);
+    __m256i result15 = _mm256_unpackhi_epi64(llr01_lo, llr23_lo);
+    __m256i result26 = _mm256_unpacklo_epi64(llr01_hi, llr23_hi);
+    __m256i result37 = _mm256_unpackhi_epi64(llr01_hi, llr23_hi);
+
+    _mm256_storeu_si256(result_ptr++, _mm256_permute2x128_si256(result04, result15, 0x20));
+    _mm256_storeu_si256(result_ptr++, _mm256_permute2x128_si256(result26, result37, 0x20));
+    _mm256_storeu_si256(result_ptr++, _mm256_permute2x128_si256(result04, result15, 0x31));
+    _mm256_storeu_si256(result_ptr++, _mm256_permute2x128_si256(result26, result37, 0x31));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_b_avx2(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float* symbols_ptr = (const float*)symbols;
+  __m256       scale_v     = _mm256_set1_ps(-SCALE_BYTE_CONV_QAM256);
+  __m256i      offset1     = _mm256_set1_epi8(8 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m256i      offset2     = _mm256_set1_epi8(4 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m256i      offset3     = _mm256_set1_epi8(2 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m256i      reorder     = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  __m256i*     result_ptr  = (__m256i*)llr;
+
+  int i = 0;
+  for (; i + 16 <= nsymbols; i += 16) {
+    __m256i symbol_i[4];
+    for (int j = 0; j < 4; j++) {
+      __m256 symbol = _mm256_loadu_ps(symbols_ptr + 2 * i + 8 * j);
+      symbol_i[j]   = _mm256_cvtps_epi32(_mm256_mul_ps(symbol, scale_v));
+    }
+    __m256i llr0 = _mm256_packs_epi16(_mm256_packs_epi32(symbol_i[0], symbol_i[1]),
+                                      _mm256_packs_epi32(symbol_i[2], symbol_i[3]));
+    // The packs work in 128-bit lanes, restore the symbol order
+    llr0         = _mm256_permutevar8x32_epi32(llr0, reorder);
+    __m256i llr1 = _mm256_sub_epi8(_mm256_abs_epi8(llr0), offset1);
+    __m256i llr2 = _mm256_sub_epi8(_mm256_abs_epi8(llr1), offset2);
+    __m256i llr3 = _mm256_sub_epi8(_mm256_abs_epi8(llr2), offset3);
+
+    // result01 holds symbols 0 and 1 in the first lane and symbols 8 and 9 in the second one, and so on
+    __m256i llr01_lo = _mm256_unpacklo_epi16(llr0, llr1);
+    __m256i llr01_hi = _mm256_unpackhi_epi16(llr0, llr1);
+    __m256i llr23_lo = _mm256_unpacklo_epi16(llr2, llr3);
+    __m256i llr23_hi = _mm256_unpackhi_epi16(llr2, llr3);
+    __m256i result01 = _mm256_unpacklo_epi32(llr01_lo, llr23_lo);
+    __m256i result23 = _mm256_unpackhi_epi32(llr01_lo, llr23_lo);
+    __m256i result45 = _mm256_unpacklo_epi32(llr01_hi, llr23_hi);
+    __m256i result67 = _mm256_unpackhi_epi32(llr01_hi, llr23_hi);
+
+    _mm256_storeu_si256(result_ptr++, _mm256_permute2x128_si256(result01, result23, 0x20));
+    _mm256_storeu_si256(result_ptr++, _mm256_permute2x128_si256(result45, result67, 0x20));
+    _mm256_storeu_si256(result_ptr++, _mm256_permute2x128_si256(result01, result23, 0x31));
+    _mm256_storeu_si256(result_ptr++, _mm256_permute2x128_si256(result45, result67, 0x31));
+  }
+  return i;
+}
+
+#endif /* LV_HAVE_AVX2 */
+
+#ifdef LV_HAVE_SSE
+
+static int demod_256qam_lte_s_sse(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float* symbols_ptr = (const float*)symbols;
+  __m128       scale_v     = _mm_set1_ps(-SCALE_SHORT_CONV_QAM256);
+  __m128i      offset1     = _mm_set1_epi16(8 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m128i      offset2     = _mm_set1_epi16(4 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m128i      offset3     = _mm_set1_epi16(2 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  __m128i*     result_ptr  = (__m128i*)llr;
+
+  int i = 0;
+  for (; i + 4 <= nsymbols; i += 4) {
+    __m128  symbol1 = _mm_loadu_ps(symbols_ptr + 2 * i);
+    __m128  symbol2 = _mm_loadu_ps(symbols_ptr + 2 * i + 4);
+    __m128i llr0    = _mm_packs_epi32(_mm_cvtps_epi32(_mm_mul_ps(symbol1, scale_v)),
+                                   _mm_cvtps_epi32(_mm_mul_ps(symbol2, scale_v)));
+    __m128i llr1    = _mm_sub_epi16(_mm_abs_epi16(llr0), offset1);
+    __m128i llr2    = _mm_sub_epi16(_mm_abs_epi16(llr1), offset2);
+    __m128i llr3    = _mm_sub_epi16(_mm_abs_epi16(llr2), offset3);
+
+    __m128i llr01_lo = _mm_unpacklo_epi32(llr0, llr1);
+    __m128i llr01_hi = _mm_unpackhi_epi32(llr0, llr1);
+    __m128i llr23_lo = _mm_unpacklo_epi32(llr2, llr3);
+    __m128i llr23_hi = _mm_unpackhi_epi32(llr2, llr3);
+
+    _mm_storeu_si128(result_ptr++, _mm_unpacklo_epi64(llr01_lo, llr23_lo));
+    _mm_storeu_si128(result_ptr++, _mm_unpackhi_epi64(llr01_lo, llr23_lo));
+    _mm_storeu_si128(result_ptr++, _mm_unpacklo_epi64(llr01_hi, llr23_hi));
+    _mm_storeu_si128(result_ptr++, _mm_unpackhi_epi64(llr01_hi, llr23_hi));
+  }
+  return i;
+}
+
+static int demod_256qam_lte_b_sse(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float* symbols_ptr = (const float*)symbols;
+  __m128       scale_v     = _mm_set1_ps(-SCALE_BYTE_CONV_QAM256);
+  __m128i      offset1     = _mm_set1_epi8(8 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m128i      offset2     = _mm_set1_epi8(4 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m128i      offset3     = _mm_set1_epi8(2 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  __m128i*     result_ptr  = (__m128i*)llr;
+
+  int i = 0;
+  for (; i + 8 <= nsymbols; i += 8) {
+    __m128i symbol_i[4];
+    for (int j = 0; j < 4; j++) {
+      __m128 symbol = _mm_loadu_ps(symbols_ptr + 2 * i + 4 * j);
+      symbol_i[j]   = _mm_cvtps_epi32(_mm_mul_ps(symbol, scale_v));
+    }
+    __m128i llr0 =
+        _mm_packs_epi16(_mm_packs_epi32(symbol_i[0], symbol_i[1]), _mm_packs_epi32(symbol_i[2], symbol_i[3]));
+    __m128i llr1 = _mm_sub_epi8(_mm_abs_epi8(llr0), offset1);
+    __m128i llr2 = _mm_sub_epi8(_mm_abs_epi8(llr1), offset2);
+    __m128i llr3 = _mm_sub_epi8(_mm_abs_epi8(llr2), offset3);
+
+    __m128i llr01_lo = _mm_unpacklo_epi16(llr0, llr1);
+    __m128i llr01_hi = _mm_unpackhi_epi16(llr0, llr1);
+    __m128i llr23_lo = _mm_unpacklo_epi16(llr2, llr3);
+    __m128i llr23_hi = _mm_unpackhi_epi16(llr2, llr3);
+
+    _mm_storeu_si128(result_ptr++, _mm_unpacklo_epi32(llr01_lo, llr23_lo));
+    _mm_storeu_si128(result_ptr++, _mm_unpackhi_epi32(llr01_lo, llr23_lo));
+    _mm_storeu_si128(result_ptr++, _mm_unpacklo_epi32(llr01_hi, llr23_hi));
+    _mm_storeu_si128(result_ptr++, _mm_unpackhi_epi32(llr01_hi, llr23_hi));
+  }
+  return i;
+}
+
+#endif /* LV_HAVE_SSE */
+
+#ifdef HAVE_NEONv8
+
+static int demod_256qam_lte_s_neon(const cf_t* symbols, int16_t* llr, int nsymbols)
+{
+  const float* symbols_ptr = (const float*)symbols;
+  float32x4_t  scale_v     = vdupq_n_f32(-SCALE_SHORT_CONV_QAM256);
+  int16x8_t    offset1     = vdupq_n_s16(8 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  int16x8_t    offset2     = vdupq_n_s16(4 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+  int16x8_t    offset3     = vdupq_n_s16(2 * SCALE_SHORT_CONV_QAM256 / sqrtf(170));
+
+  int i = 0;
+  for (; i + 4 <= nsymbols; i += 4) {
+    int32x4_t symbol_i1 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(symbols_ptr + 2 * i), scale_v));
+    int32x4_t symbol_i2 = vcvtnq_s32_f32(vmulq_f32(vld1q_f32(symbols_ptr + 2 * i + 4), scale_v));
+    int16x8_t llr0      = vcombine_s16(vqmovn_s32(symbol_i1), vqmovn_s32(symbol_i2));
+    int16x8_t llr1      = vsubq_s16(vqabsq_s16(llr0), offset1);
+    int16x8_t llr2      = vsubq_s16(vqabsq_s16(llr1), offset2);
+    int16x8_t llr3      = vsubq_s16(vqabsq_s16(llr2), offset3);
+
+    // Every 32-bit element is the (re, im) pair of one symbol, the interleaving store builds the 8 LLRs of a symbol
+    int32x4x4_t result;
+    result.val[0] = vreinterpretq_s32_s16(llr0);
+    result.val[1] = vreinterpretq_s32_s16(llr1);
+    result.val[2] = vreinterpretq_s32_s16(llr2);
+    result.val[3] = vreinterpretq_s32_s16(llr3);
+    vst4q_s32((int32_t*)(llr + 8 * i), result);
+  }
+  return i;
+}
+
+static int demod_256qam_lte_b_neon(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  const float* symbols_ptr = (const float*)symbols;
+  float32x4_t  scale_v     = vdupq_n_f32(-SCALE_BYTE_CONV_QAM256);
+  int8x16_t    offset1     = vdupq_n_s8(8 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  int8x16_t    offset2     = vdupq_n_s8(4 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+  int8x16_t    offset3     = vdupq_n_s8(2 * SCALE_BYTE_CONV_QAM256 / sqrtf(170));
+
+  int i = 0;
+  for (; i + 8 <= nsymbols; i += 8) {
+    int16x4_t symbol_s[4];
+    for (int j = 0; j < 4; j++) {
+      symbol_s[j] = vqmovn_s32(vcvtnq_s32_f32(vmulq_f32(vld1q_f32(symbols_ptr + 2 * i + 4 * j), scale_v)));
+    }
+    int8x16_t llr0 = vcombine_s8(vqmovn_s16(vcombine_s16(symbol_s[0], symbol_s[1])),
+                                 vqmovn_s16(vcombine_s16(symbol_s[2], symbol_s[3])));
+    int8x16_t llr1 = vsubq_s8(vqabsq_s8(llr0), offset1);
+    int8x16_t llr2 = vsubq_s8(vqabsq_s8(llr1), offset2);
+    int8x16_t llr3 = vsubq_s8(vqabsq_s8(llr2), offset3);
+
+    int16x8x4_t result;
+    result.val[0] = vreinterpretq_s16_s8(llr0);
+    result.val[1] = vreinterpretq_s16_s8(llr1);
+    result.val[2] = vreinterpretq_s16_s8(llr2);
+    result.val[3] = vreinterpretq_s16_s8(llr3);
+    vst4q_s16((int16_t*)(llr + 8 * i), result);
+  }
+  return i;
+}
+
+#endif /* HAVE_NEONv8 */
+
+void demod_256qam_lte_b(const cf_t* symbols, int8_t* llr, int nsymbols)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  i += demod_256qam_lte_b_avx512(symbols, llr, nsymbols);
+#endif
+#ifdef LV_HAVE_AVX2
+  i += demod_256qam_lte_b_avx2(symbols + i, llr + 8 * i, nsymbols - i);
+#endif
+#ifdef LV_HAVE_SSE
+  i += demod_256qam_lte_b_sse(symbols + i, llr + 8 * i, nsymbols - i);
+#endif
+#ifdef HAVE_NEONv8
+  i += demod_256qam_lte_b_neon(symbols + i, llr + 8 * i, nsymbols - i);
+#endif
+  demod_256qam_lte_b_generic(symbols + i, llr + 8 * i, nsymbols - i);
+}
+
+void demod_256qam_lte_s(const cf_t* symbols, short* llr, int nsymbols)
+{
+  int i = 0;
+#ifdef LV_HAVE_AVX512
+  i += demod_256qam_lte_s_avx512(symbols, llr, nsymbols);
+#endif
+#ifdef LV_HAVE_AVX2
+  i += demod_256qam_lte_s_avx2(symbols + i, llr + 8 * i, nsymbols - i);
+#endif
+#ifdef LV_HAVE_SSE
+  i += demod_256qam_lte_s_sse(symbols + i, llr + 8 * i, nsymbols - i);
+#endif
+#ifdef HAVE_NEONv8
+  i += demod_256qam_lte_s_neon(symbols + i, llr + 8 * i, nsymbols - i);
+#endif
+  demod_256qam_lte_s_generic(symbols + i, llr + 8 * i, nsymbols - i);
+}
+
 int srsran_demod_soft_demodulate(srsran_mod_t modulation, const cf_t* symbols, float* llr, int nsymbols)
 {
   switch (modulation) {
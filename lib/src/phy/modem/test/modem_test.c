@@ -35,18 +35,20 @@ struct timeval x, y;
 
 static uint32_t     num_bits   = 1000;
 static srsran_mod_t modulation = SRSRAN_MOD_BPSK;
+static uint32_t     nof_trials = 1000;
 
 void usage(char* prog)
 {
   printf("Usage: %s [nmse]\n", prog);
   printf("\t-n num_bits [Default %d]\n", num_bits);
   printf("\t-m modulation (1: BPSK, 2: QPSK, 4: QAM16, 6: QAM64, 8: QAM256) [Default BPSK]\n");
+  printf("\t-t number of soft demodulation trials [Default %d]\n", nof_trials);
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nm")) != -1) {
+  while ((opt = getopt(argc, argv, "nmt")) != -1) {
     switch (opt) {
       case 'n':
         num_bits = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -75,6 +77,9 @@ void parse_args(int argc, char** argv)
             break;
         }
         break;
+      case 't':
+        nof_trials = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -82,6 +87,60 @@ void parse_args(int argc, char** argv)
   }
 }
 
+/* Measures the soft demodulator throughput of the float, int16 and int8 implementations and checks their hard
+ * decisions */
+static int test_soft_demod_throughput(const uint8_t* input, const cf_t* symbols, uint32_t nof_symbols)
+{
+  const char* impl_names[3] = {"float", "int16", "int8"};
+  int         ret           = SRSRAN_SUCCESS;
+  float*      llr_f         = srsran_vec_f_malloc(num_bits);
+  int16_t*    llr_s         = srsran_vec_i16_malloc(num_bits);
+  int8_t*     llr_b         = srsran_vec_i8_malloc(num_bits);
+  if (!llr_f || !llr_s || !llr_b) {
+    perror("malloc");
+    exit(-1);
+  }
+
+  for (int impl = 0; impl < 3 && ret == SRSRAN_SUCCESS; impl++) {
+    struct timeval t[3];
+    gettimeofday(&t[1], NULL);
+    for (uint32_t j = 0; j < nof_trials; j++) {
+      switch (impl) {
+        case 0:
+          srsran_demod_soft_demodulate(modulation, symbols, llr_f, nof_symbols);
+          break;
+        case 1:
+          srsran_demod_soft_demodulate_s(modulation, symbols, llr_s, nof_symbols);
+          break;
+        default:
+          srsran_demod_soft_demodulate_b(modulation, symbols, llr_b, nof_symbols);
+          break;
+      }
+    }
+    gettimeofday(&t[2], NULL);
+    get_time_interval(t);
+
+    double elapsed_us = t[0].tv_sec * 1e6 + t[0].tv_usec;
+    printf("Soft demodulation %s %s: %.1f Msymbols/s\n",
+           srsran_mod_string(modulation),
+           impl_names[impl],
+           (double)nof_symbols * nof_trials / SRSRAN_MAX(elapsed_us, 1.0));
+
+    for (uint32_t i = 0; i < num_bits && ret == SRSRAN_SUCCESS; i++) {
+      float llr = (impl == 0) ? llr_f[i] : (impl == 1) ? llr_s[i] : llr_b[i];
+      if (input[i] != (llr >= 0 ? 1 : 0)) {
+        ERROR("Error in bit %d of the %s soft demodulator", i, impl_names[impl]);
+        ret = SRSRAN_ERROR;
+      }
+    }
+  }
+
+  free(llr_b);
+  free(llr_s);
+  free(llr_f);
+  return ret;
+}
+
 int main(int argc, char** argv)
 {
   int                  ret = SRSRAN_SUCCESS;
@@ -195,6 +254,10 @@ int main(int argc, char** argv)
     }
   }
 
+  if (ret == SRSRAN_SUCCESS) {
+    ret = test_soft_demod_throughput(input, symbols, num_bits / mod.nbits_x_symbol);
+  }
+
   free(llr);
   free(symbols);
   free(symbols_bytes);
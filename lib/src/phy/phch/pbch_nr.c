@@ -113,10 +113,10 @@ static int pbch_nr_init_decoder(srsran_pbch_nr_t* q, const srsran_pbch_nr_args_t
     return SRSRAN_SUCCESS;
   }
 
-  srsran_polar_decoder_type_t decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
+  srsran_polar_decoder_type_t decoder_type = srsran_polar_decoder_type_from_list_size(args->polar_list_size);
 
 #ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
+  if (!args->disable_simd && decoder_type == SRSRAN_POLAR_DECODER_SSC_C) {
     decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
   }
 #endif /* LV_HAVE_AVX2 */
@@ -347,26 +347,43 @@ static int pbch_nr_polar_encode(srsran_pbch_nr_t* q, const uint8_t c[PBCH_NR_K],
   return SRSRAN_SUCCESS;
 }
 
-static int pbch_nr_polar_decode(srsran_pbch_nr_t* q, const int8_t d[PBCH_NR_N], uint8_t c[PBCH_NR_K])
+static void pbch_nr_polar_chanalloc_rx(srsran_pbch_nr_t* q, const uint8_t allocated[PBCH_NR_N], uint8_t c[PBCH_NR_K])
 {
-  // Decode bits
-  uint8_t allocated[PBCH_NR_N];
-  if (srsran_polar_decoder_decode_c(&q->polar_decoder, d, allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-      SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-
-  if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
-    PBCH_NR_DEBUG_RX("Allocated: ");
-    srsran_vec_fprint_byte(stdout, allocated, PBCH_NR_N);
-  }
-
   // Allocate channel
   uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
   srsran_polar_chanalloc_rx(allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
 
   // Interleave
   srsran_polar_interleaver_run_u8(c_prime, c, PBCH_NR_K, false);
+}
+
+static int pbch_nr_polar_decode(srsran_pbch_nr_t* q, const int8_t d[PBCH_NR_N], uint8_t c[PBCH_NR_K])
+{
+  // Decode bits, a list decoder returns several candidates sorted from the most to the least likely one
+  uint8_t allocated[PBCH_NR_N * SRSRAN_POLAR_DECODER_MAX_LIST_SIZE];
+  int     nof_candidates = srsran_polar_decoder_decode_list_c(
+      &q->polar_decoder, d, allocated, q->code.n, q->code.F_set, q->code.F_set_size);
+  if (nof_candidates < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Select the first candidate that passes the CRC check, the most likely one is kept otherwise
+  for (int i = 0; i < nof_candidates; i++) {
+    if (get_srsran_verbose_level() >= SRSRAN_VERBOSE_DEBUG && !is_handler_registered()) {
+      PBCH_NR_DEBUG_RX("Allocated: ");
+      srsran_vec_fprint_byte(stdout, allocated + i * PBCH_NR_N, PBCH_NR_N);
+    }
+
+    pbch_nr_polar_chanalloc_rx(q, allocated + i * PBCH_NR_N, c);
+
+    if (srsran_crc_match(&q->crc, c, PBCH_NR_A)) {
+      return SRSRAN_SUCCESS;
+    }
+  }
+
+  if (nof_candidates > 1) {
+    pbch_nr_polar_chanalloc_rx(q, allocated, c);
+  }
 
   return SRSRAN_SUCCESS;
 }
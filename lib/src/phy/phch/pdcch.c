@@ -328,6 +328,16 @@ uint32_t srsran_pdcch_common_locations_ncce(uint32_t nof_cce, srsran_dci_locatio
   return k;
 }
 
+/* Returns the XOR between the received parity bits and the CRC of the decoded bits */
+static uint16_t pdcch_dci_crc_rem(srsran_pdcch_t* q, uint8_t* data, uint32_t nof_bits)
+{
+  uint8_t* x       = &data[nof_bits];
+  uint16_t p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
+  uint16_t crc_res = ((uint16_t)srsran_crc_checksum(&q->crc, data, nof_bits) & 0xffff);
+
+  return p_bits ^ crc_res;
+}
+
 /** 36.212 5.3.3.2 to 5.3.3.4
  *
  * Returns XOR between parity and remainder bits
@@ -336,27 +346,20 @@ uint32_t srsran_pdcch_common_locations_ncce(uint32_t nof_cce, srsran_dci_locatio
  */
 int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t E, uint32_t nof_bits, uint16_t* crc)
 {
-  uint16_t p_bits, crc_res;
-  uint8_t* x;
-
   if (q != NULL) {
     if (data != NULL && E <= q->max_bits && nof_bits <= SRSRAN_DCI_MAX_BITS) {
-      srsran_vec_f_zero(q->rm_f, 3 * (SRSRAN_DCI_MAX_BITS + 16));
+      srsran_vec_f_zero(q->rm_f[0], 3 * (SRSRAN_DCI_MAX_BITS + 16));
 
       uint32_t coded_len = 3 * (nof_bits + 16);
 
       /* unrate matching */
-      srsran_rm_conv_rx(e, E, q->rm_f, coded_len);
+      srsran_rm_conv_rx(e, E, q->rm_f[0], coded_len);
 
       /* viterbi decoder */
-      srsran_viterbi_decode_f(&q->decoder, q->rm_f, data, nof_bits + 16);
-
-      x       = &data[nof_bits];
-      p_bits  = (uint16_t)srsran_bit_pack(&x, 16);
-      crc_res = ((uint16_t)srsran_crc_checksum(&q->crc, data, nof_bits) & 0xffff);
+      srsran_viterbi_decode_f(&q->decoder, q->rm_f[0], data, nof_bits + 16);
 
       if (crc) {
-        *crc = p_bits ^ crc_res;
+        *crc = pdcch_dci_crc_rem(q, data, nof_bits);
       }
 
       return SRSRAN_SUCCESS;
@@ -369,6 +372,153 @@ int srsran_pdcch_dci_decode(srsran_pdcch_t* q, float* e, uint8_t* data, uint32_t
   }
 }
 
+/* Returns the candidate decoded in the given location with the given size, NULL if it has not been decoded yet */
+static srsran_pdcch_decoded_t*
+pdcch_decoded_find(srsran_pdcch_t* q, const srsran_dci_location_t* location, uint32_t nof_bits)
+{
+  uint32_t nof_decoded = SRSRAN_MIN(q->nof_decoded, SRSRAN_PDCCH_MAX_DECODED);
+  for (uint32_t i = 0; i < nof_decoded; i++) {
+    srsran_pdcch_decoded_t* decoded = &q->decoded[i];
+    if (decoded->location.ncce == location->ncce && decoded->location.L == location->L &&
+        decoded->nof_bits == nof_bits) {
+      return decoded;
+    }
+  }
+  return NULL;
+}
+
+/* Keeps a decoded candidate, replacing the oldest one if all of them are in use */
+static void pdcch_decoded_add(srsran_pdcch_t*              q,
+                              const srsran_dci_location_t* location,
+                              uint32_t                     nof_bits,
+                              const uint8_t*               payload,
+                              uint16_t                     crc_rem)
+{
+  srsran_pdcch_decoded_t* decoded = &q->decoded[q->nof_decoded % SRSRAN_PDCCH_MAX_DECODED];
+  decoded->location               = *location;
+  decoded->nof_bits               = nof_bits;
+  decoded->crc_rem                = crc_rem;
+  memcpy(decoded->payload, payload, nof_bits);
+  q->nof_decoded++;
+}
+
+/** Decodes the DCI message in the location given by msg reusing the result of a previous decoding of the same
+ * location and size. The blind search tries the same candidates for several formats, search spaces and RNTI and the
+ * decoded payload and CRC remainder do not depend on any of them.
+ */
+static int pdcch_dci_decode_location(srsran_pdcch_t* q, srsran_dci_msg_t* msg, uint32_t e_bits, uint32_t nof_bits)
+{
+  srsran_pdcch_decoded_t* decoded = pdcch_decoded_find(q, &msg->location, nof_bits);
+  if (decoded != NULL) {
+    memcpy(msg->payload, decoded->payload, nof_bits);
+    msg->rnti = decoded->crc_rem;
+    return SRSRAN_SUCCESS;
+  }
+
+  int ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+  if (ret == SRSRAN_SUCCESS) {
+    pdcch_decoded_add(q, &msg->location, nof_bits, msg->payload, msg->rnti);
+  }
+
+  return ret;
+}
+
+/* Decodes up to SRSRAN_VITERBI_MAX_BATCH candidates of the same size at once and keeps them */
+static int
+pdcch_dci_decode_batch(srsran_pdcch_t* q, const srsran_dci_location_t* locations, uint32_t nof_cw, uint32_t nof_bits)
+{
+  float*   rm_f[SRSRAN_VITERBI_MAX_BATCH];
+  uint8_t* data[SRSRAN_VITERBI_MAX_BATCH];
+  uint8_t  payload[SRSRAN_VITERBI_MAX_BATCH][SRSRAN_DCI_MAX_BITS + 16];
+  uint32_t coded_len = 3 * (nof_bits + 16);
+
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    rm_f[i] = q->rm_f[i];
+    data[i] = payload[i];
+
+    /* unrate matching */
+    srsran_vec_f_zero(rm_f[i], coded_len);
+    srsran_rm_conv_rx(&q->llr[locations[i].ncce * 72], PDCCH_FORMAT_NOF_BITS(locations[i].L), rm_f[i], coded_len);
+  }
+
+  /* viterbi decoder */
+  if (srsran_viterbi_decode_f_batch(&q->decoder, rm_f, data, nof_cw, nof_bits + 16) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < nof_cw; i++) {
+    pdcch_decoded_add(q, &locations[i], nof_bits, payload[i], pdcch_dci_crc_rem(q, payload[i], nof_bits));
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/* Computes the absolute mean of the LLRs of a candidate */
+static double pdcch_llr_abs_mean(srsran_pdcch_t* q, const srsran_dci_location_t* location)
+{
+  uint32_t e_bits = PDCCH_FORMAT_NOF_BITS(location->L);
+  double   mean   = 0;
+  for (int i = 0; i < e_bits; i++) {
+    mean += fabsf(q->llr[location->ncce * 72 + i]);
+  }
+  return mean / e_bits;
+}
+
+int srsran_pdcch_decode_candidates(srsran_pdcch_t*            q,
+                                   srsran_dl_sf_cfg_t*        sf,
+                                   srsran_dci_cfg_t*          dci_cfg,
+                                   srsran_dci_location_t*     locations,
+                                   uint32_t                   nof_locations,
+                                   const srsran_dci_format_t* formats,
+                                   uint32_t                   nof_formats)
+{
+  if (q == NULL || sf == NULL || dci_cfg == NULL || (nof_locations > 0 && locations == NULL) ||
+      (nof_formats > 0 && formats == NULL) || !SRSRAN_CFI_ISVALID(sf->cfi)) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  int nof_decoded = 0;
+  for (uint32_t f = 0; f < nof_formats; f++) {
+    uint32_t nof_bits = srsran_dci_format_sizeof(&q->cell, sf, dci_cfg, formats[f]);
+    if (nof_bits == 0 || nof_bits > SRSRAN_DCI_MAX_BITS) {
+      continue;
+    }
+
+    // Collect the candidates that srsran_pdcch_decode_msg() would decode and are not decoded yet. The formats with the
+    // same size as a previous one find all their candidates decoded.
+    srsran_dci_location_t batch[SRSRAN_VITERBI_MAX_BATCH];
+    uint32_t              nof_batch = 0;
+    for (uint32_t l = 0; l < nof_locations; l++) {
+      srsran_dci_location_t* location = &locations[l];
+      if (!srsran_dci_location_isvalid(location) ||
+          location->ncce * 72 + PDCCH_FORMAT_NOF_BITS(location->L) > NOF_CCE(sf->cfi) * 72 ||
+          !(pdcch_llr_abs_mean(q, location) > 0.3f) || pdcch_decoded_find(q, location, nof_bits) != NULL) {
+        continue;
+      }
+
+      batch[nof_batch++] = *location;
+      if (nof_batch == SRSRAN_VITERBI_MAX_BATCH) {
+        if (pdcch_dci_decode_batch(q, batch, nof_batch, nof_bits) < SRSRAN_SUCCESS) {
+          ERROR("Error decoding PDCCH candidates");
+          return SRSRAN_ERROR;
+        }
+        nof_decoded += nof_batch;
+        nof_batch = 0;
+      }
+    }
+
+    if (nof_batch > 0) {
+      if (pdcch_dci_decode_batch(q, batch, nof_batch, nof_bits) < SRSRAN_SUCCESS) {
+        ERROR("Error decoding PDCCH candidates");
+        return SRSRAN_ERROR;
+      }
+      nof_decoded += nof_batch;
+    }
+  }
+
+  return nof_decoded;
+}
+
 /** Tries to decode a DCI message from the LLRs stored in the srsran_pdcch_t structure by the function
  * srsran_pdcch_extract_llr(). This function can be called multiple times.
  * The location to search for is obtained from msg.
@@ -388,14 +538,10 @@ int srsran_pdcch_decode_msg(srsran_pdcch_t* q, srsran_dl_sf_cfg_t* sf, srsran_dc
       uint32_t e_bits   = PDCCH_FORMAT_NOF_BITS(msg->location.L);
 
       // Compute absolute mean of the LLRs
-      double mean = 0;
-      for (int i = 0; i < e_bits; i++) {
-        mean += fabsf(q->llr[msg->location.ncce * 72 + i]);
-      }
-      mean /= e_bits;
+      double mean = pdcch_llr_abs_mean(q, &msg->location);
 
       if (mean > 0.3f) {
-        ret = srsran_pdcch_dci_decode(q, &q->llr[msg->location.ncce * 72], msg->payload, e_bits, nof_bits, &msg->rnti);
+        ret = pdcch_dci_decode_location(q, msg, e_bits, nof_bits);
         if (ret == SRSRAN_SUCCESS) {
           msg->nof_bits = nof_bits;
           // Check format differentiation
@@ -462,6 +608,7 @@ int srsran_pdcch_extract_llr(srsran_pdcch_t*        q,
     nof_symbols     = e_bits / 2;
     ret             = SRSRAN_ERROR;
     srsran_vec_f_zero(q->llr, q->max_bits);
+    q->nof_decoded = 0;
 
     DEBUG("Extracting LLRs: E: %d, SF: %d, CFI: %d", e_bits, sf->tti % 10, sf->cfi);
 
@@ -158,7 +158,8 @@ static int pdcch_nr_init_common(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args
     return SRSRAN_ERROR;
   }
 
-  q->d = srsran_vec_u8_malloc(SRSRAN_PDCCH_MAX_RE * 2);
+  // The receiver un-rate matches every candidate of a batch in its own slice
+  q->d = srsran_vec_u8_malloc(SRSRAN_MAX(SRSRAN_PDCCH_MAX_RE * 2, NMAX * SRSRAN_POLAR_DECODER_MAX_BATCH));
   if (q->d == NULL) {
     return SRSRAN_ERROR;
   }
@@ -173,7 +174,8 @@ static int pdcch_nr_init_common(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args
     return SRSRAN_ERROR;
   }
 
-  q->allocated = srsran_vec_u8_malloc(NMAX);
+  q->allocated =
+      srsran_vec_u8_malloc(NMAX * SRSRAN_MAX(SRSRAN_POLAR_DECODER_MAX_LIST_SIZE, SRSRAN_POLAR_DECODER_MAX_BATCH));
   if (q->allocated == NULL) {
     return SRSRAN_ERROR;
   }
@@ -185,6 +187,8 @@ static int pdcch_nr_init_common(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args
   if (srsran_polar_code_init(&q->code) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
+  q->code.K = 0;
+  q->code_E = 0;
 
   srsran_modem_table_lte(&q->modem_table, SRSRAN_MOD_QPSK);
   if (args->measure_evm) {
@@ -226,10 +230,10 @@ int srsran_pdcch_nr_init_rx(srsran_pdcch_nr_t* q, const srsran_pdcch_nr_args_t*
     return SRSRAN_ERROR;
   }
 
-  srsran_polar_decoder_type_t decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
+  srsran_polar_decoder_type_t decoder_type = srsran_polar_decoder_type_from_list_size(args->polar_list_size);
 
 #ifdef LV_HAVE_AVX2
-  if (!args->disable_simd) {
+  if (!args->disable_simd && decoder_type == SRSRAN_POLAR_DECODER_SSC_C) {
     decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
   }
 #endif // LV_HAVE_AVX2
@@ -458,6 +462,23 @@ static uint32_t pdcch_nr_cp(const srsran_pdcch_nr_t*     q,
   return count;
 }
 
+static int pdcch_nr_polar_code(srsran_pdcch_nr_t* q)
+{
+  // Skip the code construction if it has the same size than the previous one, which is the case for most of the
+  // blind-decoding attempts as they iterate the candidates of each DCI size and aggregation level in a row
+  if (q->code.K == q->K && q->code_E == q->E) {
+    return SRSRAN_SUCCESS;
+  }
+
+  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+    q->code_E = 0;
+    return SRSRAN_ERROR;
+  }
+  q->code_E = q->E;
+
+  return SRSRAN_SUCCESS;
+}
+
 static uint32_t pdcch_nr_c_init(const srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_msg)
 {
   uint32_t n_id   = (dci_msg->ctx.ss_type == srsran_search_space_type_ue && q->coreset.dmrs_scrambling_id_present)
@@ -487,7 +508,7 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   uint32_t cinit = pdcch_nr_c_init(q, dci_msg);                              // Pseudo-random sequence initiation
 
   // Get polar code
-  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
+  if (pdcch_nr_polar_code(q) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
   PDCCH_INFO_TX("K=%d; E=%d; M=%d; n=%d; cinit=%08x;", q->K, q->E, q->M, q->code.n, cinit);
@@ -569,25 +590,20 @@ int srsran_pdcch_nr_encode(srsran_pdcch_nr_t* q, const srsran_dci_msg_nr_t* dci_
   return SRSRAN_SUCCESS;
 }
 
-int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
-                           cf_t*                   slot_symbols,
-                           srsran_dmrs_pdcch_ce_t* ce,
-                           srsran_dci_msg_nr_t*    dci_msg,
-                           srsran_pdcch_nr_res_t*  res)
+int srsran_pdcch_nr_demodulate(srsran_pdcch_nr_t*           q,
+                               cf_t*                        slot_symbols,
+                               srsran_dmrs_pdcch_ce_t*      ce,
+                               const srsran_dci_location_t* location,
+                               int8_t*                      llr,
+                               srsran_pdcch_nr_res_t*       res)
 {
-  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
+  if (q == NULL || slot_symbols == NULL || ce == NULL || location == NULL || llr == NULL || res == NULL) {
     return SRSRAN_ERROR;
   }
 
-  struct timeval t[3];
-  if (q->meas_time_en) {
-    gettimeofday(&t[1], NULL);
-  }
-
   // Calculate...
-  q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
-  q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
-  q->E = q->M * 2;                                                 // Number of Rate-Matched bits
+  q->M = (1U << location->L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
+  q->E = q->M * 2;                                     // Number of Rate-Matched bits
 
   // Check number of estimates is correct
   if (ce->nof_re != q->M) {
@@ -595,14 +611,8 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     return SRSRAN_ERROR;
   }
 
-  // Get polar code
-  if (srsran_polar_code_get(&q->code, q->K, q->E, 9U) < SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
-
   // Get symbols from grid
-  uint32_t m = pdcch_nr_cp(q, &dci_msg->ctx.location, slot_symbols, q->symbols, false);
+  uint32_t m = pdcch_nr_cp(q, location, slot_symbols, q->symbols, false);
   if (q->M != m) {
     ERROR("Unmatch number of RE (%d != %d)", m, q->M);
     return SRSRAN_ERROR;
@@ -624,7 +634,6 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
   }
 
   // Demodulation
-  int8_t* llr = (int8_t*)q->f;
   srsran_demod_soft_demodulate_b(SRSRAN_MOD_QPSK, q->symbols, llr, q->M);
 
   // Measure EVM if configured
@@ -639,12 +648,31 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     llr[i] *= -1;
   }
 
-  // Descrambling
-  srsran_sequence_apply_c(llr, llr, q->E, pdcch_nr_c_init(q, dci_msg));
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Computes the polar code of a DCI size and aggregation level and un-rate matches the soft bits of a candidate
+ */
+static int pdcch_nr_rm_rx(srsran_pdcch_nr_t* q, const int8_t* llr, const srsran_dci_msg_nr_t* dci_msg, int8_t* d)
+{
+  // Calculate...
+  q->K = dci_msg->nof_bits + 24U;                                  // Payload size including CRC
+  q->M = (1U << dci_msg->ctx.location.L) * (SRSRAN_NRE - 3U) * 6U; // Number of RE
+  q->E = q->M * 2;                                                 // Number of Rate-Matched bits
+
+  // Get polar code
+  if (pdcch_nr_polar_code(q) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+  PDCCH_INFO_RX("K=%d; E=%d; M=%d; n=%d;", q->K, q->E, q->M, q->code.n);
+
+  // Descrambling, the input LLR are left untouched so they can be decoded again with other sizes and RNTI
+  int8_t* f = (int8_t*)q->f;
+  srsran_sequence_apply_c(llr, f, q->E, pdcch_nr_c_init(q, dci_msg));
 
   // Un-rate matching
-  int8_t* d = (int8_t*)q->d;
-  if (srsran_polar_rm_rx_c(&q->rm, llr, d, q->E, q->code.n, q->K, PDCCH_NR_POLAR_RM_IBIL) < SRSRAN_SUCCESS) {
+  if (srsran_polar_rm_rx_c(&q->rm, f, d, q->E, q->code.n, q->K, PDCCH_NR_POLAR_RM_IBIL) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
 
@@ -654,44 +682,57 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
     srsran_vec_fprint_bs(stdout, d, q->K);
   }
 
-  // Decode
-  if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-      SRSRAN_SUCCESS) {
-    return SRSRAN_ERROR;
-  }
-
-  // De-allocate channel
-  uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
-  srsran_polar_chanalloc_rx(q->allocated, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
-
-  // Set first L bits to ones, c will have an offset of 24 bits
-  uint8_t* c = q->c;
-  srsran_bit_unpack(UINT32_MAX, &c, 24U);
-
-  // De-interleave
-  srsran_polar_interleaver_run_u8(c_prime, c, q->K, false);
-
-  // Print c
-  if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-    PDCCH_INFO_RX("c_prime=");
-    srsran_vec_fprint_hex(stdout, c_prime, q->K);
-    PDCCH_INFO_RX("c=");
-    srsran_vec_fprint_hex(stdout, c, q->K);
-  }
+  return SRSRAN_SUCCESS;
+}
 
+/**
+ * @brief Selects the first decoded candidate that passes the CRC check and copies its payload into the DCI message
+ */
+static void pdcch_nr_crc_check(srsran_pdcch_nr_t*     q,
+                               const uint8_t*         decoded,
+                               int                    nof_candidates,
+                               srsran_dci_msg_nr_t*   dci_msg,
+                               srsran_pdcch_nr_res_t* res)
+{
   // Unpack RNTI
   uint8_t  unpacked_rnti[16] = {};
   uint8_t* ptr               = unpacked_rnti;
   srsran_bit_unpack(dci_msg->ctx.rnti, &ptr, 16);
 
-  // De-Scramble CRC with RNTI
-  srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
+  // Select the first candidate that passes the CRC check
+  uint8_t* c         = q->c;
+  uint32_t checksum1 = 0;
+  uint32_t checksum2 = 0;
+  res->crc           = false;
+  for (int i = 0; i < nof_candidates && !res->crc; i++) {
+    // De-allocate channel
+    uint8_t c_prime[SRSRAN_POLAR_INTERLEAVER_K_MAX_IL];
+    srsran_polar_chanalloc_rx(decoded + i * q->code.N, c_prime, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+
+    // Set first L bits to ones, c will have an offset of 24 bits
+    c = q->c;
+    srsran_bit_unpack(UINT32_MAX, &c, 24U);
+
+    // De-interleave
+    srsran_polar_interleaver_run_u8(c_prime, c, q->K, false);
+
+    // Print c
+    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+      PDCCH_INFO_RX("c_prime=");
+      srsran_vec_fprint_hex(stdout, c_prime, q->K);
+      PDCCH_INFO_RX("c=");
+      srsran_vec_fprint_hex(stdout, c, q->K);
+    }
 
-  // Check CRC
-  ptr                = &c[q->K - 24];
-  uint32_t checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
-  uint32_t checksum2 = srsran_bit_pack(&ptr, 24);
-  res->crc           = checksum1 == checksum2;
+    // De-Scramble CRC with RNTI
+    srsran_vec_xor_bbb(unpacked_rnti, &c[q->K - 16], &c[q->K - 16], 16);
+
+    // Check CRC
+    ptr       = &c[q->K - 24];
+    checksum1 = srsran_crc_checksum(&q->crc24c, q->c, q->K);
+    checksum2 = srsran_bit_pack(&ptr, 24);
+    res->crc  = checksum1 == checksum2;
+  }
 
   if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
     PDCCH_INFO_RX("CRC={%06x, %06x}; msg=", checksum1, checksum2);
@@ -700,6 +741,112 @@ int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
 
   // Copy DCI message
   srsran_vec_u8_copy(dci_msg->payload, c, dci_msg->nof_bits);
+}
+
+int srsran_pdcch_nr_decode_llr(srsran_pdcch_nr_t*     q,
+                               const int8_t*          llr,
+                               srsran_dci_msg_nr_t*   dci_msg,
+                               srsran_pdcch_nr_res_t* res)
+{
+  if (q == NULL || llr == NULL || dci_msg == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  // Descramble and un-rate match
+  int8_t* d = (int8_t*)q->d;
+  if (pdcch_nr_rm_rx(q, llr, dci_msg, d) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  // Decode, a list decoder returns several candidates sorted from the most to the least likely one
+  int nof_candidates = srsran_polar_decoder_decode_list_c(
+      &q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size);
+  if (nof_candidates < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  pdcch_nr_crc_check(q, q->allocated, nof_candidates, dci_msg, res);
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdcch_nr_decode_llr_batch(srsran_pdcch_nr_t*     q,
+                                     const int8_t*          llr[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                     srsran_dci_msg_nr_t*   dci_msg[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                     srsran_pdcch_nr_res_t* res[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                     uint32_t               nof_candidates)
+{
+  if (q == NULL || llr == NULL || dci_msg == NULL || res == NULL || nof_candidates > SRSRAN_POLAR_DECODER_MAX_BATCH) {
+    return SRSRAN_ERROR;
+  }
+
+  // The candidates of a batch share the polar code
+  for (uint32_t i = 1; i < nof_candidates; i++) {
+    if (dci_msg[i]->nof_bits != dci_msg[0]->nof_bits || dci_msg[i]->ctx.location.L != dci_msg[0]->ctx.location.L) {
+      ERROR("PDCCH candidates of a batch must have the same DCI size and aggregation level");
+      return SRSRAN_ERROR;
+    }
+  }
+
+  // List decoders keep all their paths for the CRC check, they decode the candidates one after the other
+  if (q->decoder.list_size > 1) {
+    for (uint32_t i = 0; i < nof_candidates; i++) {
+      if (srsran_pdcch_nr_decode_llr(q, llr[i], dci_msg[i], res[i]) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+    }
+    return SRSRAN_SUCCESS;
+  }
+
+  // Descramble and un-rate match every candidate in its own slice of the buffers
+  const int8_t* d[SRSRAN_POLAR_DECODER_MAX_BATCH];
+  uint8_t*      decoded[SRSRAN_POLAR_DECODER_MAX_BATCH];
+  for (uint32_t i = 0; i < nof_candidates; i++) {
+    int8_t* d_i = (int8_t*)q->d + i * NMAX;
+    if (pdcch_nr_rm_rx(q, llr[i], dci_msg[i], d_i) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+    d[i]       = d_i;
+    decoded[i] = q->allocated + i * NMAX;
+  }
+
+  // Decode all the candidates at once
+  if (srsran_polar_decoder_decode_batch_c(
+          &q->decoder, d, decoded, nof_candidates, q->code.n, q->code.F_set, q->code.F_set_size) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t i = 0; i < nof_candidates; i++) {
+    pdcch_nr_crc_check(q, decoded[i], 1, dci_msg[i], res[i]);
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+int srsran_pdcch_nr_decode(srsran_pdcch_nr_t*      q,
+                           cf_t*                   slot_symbols,
+                           srsran_dmrs_pdcch_ce_t* ce,
+                           srsran_dci_msg_nr_t*    dci_msg,
+                           srsran_pdcch_nr_res_t*  res)
+{
+  if (q == NULL || dci_msg == NULL || ce == NULL || slot_symbols == NULL || res == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  struct timeval t[3];
+  if (q->meas_time_en) {
+    gettimeofday(&t[1], NULL);
+  }
+
+  // Demodulate into the rate matching buffer, the decoder descrambles it in place
+  int8_t* llr = (int8_t*)q->f;
+  if (srsran_pdcch_nr_demodulate(q, slot_symbols, ce, &dci_msg->ctx.location, llr, res) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_pdcch_nr_decode_llr(q, llr, dci_msg, res) < SRSRAN_SUCCESS) {
+    return SRSRAN_ERROR;
+  }
 
   if (q->meas_time_en) {
     gettimeofday(&t[2], NULL);
@@ -583,6 +583,27 @@ int srsran_prach_init(srsran_prach_t* p, uint32_t max_N_ifft_ul)
     srsran_dft_plan_set_mirror(&p->zc_ifft, false);
     srsran_dft_plan_set_norm(&p->zc_ifft, false);
 
+    // Batched IFFT of the correlation with every root sequence, planned in place for the worst case
+    p->corr_bank = srsran_vec_cf_malloc(N_SEQS * SRSRAN_PRACH_N_ZC_LONG);
+    if (!p->corr_bank) {
+      ERROR("Error allocating memory");
+      return SRSRAN_ERROR;
+    }
+    if (srsran_dft_plan_guru_c(&p->zc_ifft_bank,
+                               SRSRAN_PRACH_N_ZC_LONG,
+                               SRSRAN_DFT_BACKWARD,
+                               p->corr_bank,
+                               p->corr_bank,
+                               1,
+                               1,
+                               N_SEQS,
+                               SRSRAN_PRACH_N_ZC_LONG,
+                               SRSRAN_PRACH_N_ZC_LONG)) {
+      ERROR("Error creating DFT plan");
+      return SRSRAN_ERROR;
+    }
+    p->zc_ifft_bank_nof_roots = N_SEQS;
+
     uint32_t fft_size_alloc = max_N_ifft_ul * DELTA_F / DELTA_F_RA;
 
     p->ifft_in  = srsran_vec_cf_malloc(fft_size_alloc);
@@ -640,7 +661,6 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
     p->detect_factor           = PRACH_DETECT_FACTOR;
     p->num_ra_preambles        = cfg->num_ra_preambles;
     p->successive_cancellation = cfg->enable_successive_cancellation;
-    p->dft_gen_bitmap          = 0;
     if (p->successive_cancellation && cfg->zero_corr_zone != 0) {
       printf("successive cancellation only currently supported with zero_correlation_zone_config of 0 - disabling\n");
       p->successive_cancellation = false;
@@ -688,14 +708,34 @@ int srsran_prach_set_cell_(srsran_prach_t*      p,
       }
     }
 
-    // Generate our 64 sequences
-    p->N_roots = 0;
-    srsran_prach_gen_seqs(p);
+    // Generate our 64 sequences, unless they have already been generated for the same configuration
+    if (p->seqs_N_zc != p->N_zc || p->seqs_N_cs != p->N_cs || p->seqs_rsi != p->rsi || p->seqs_hs != p->hs) {
+      p->N_roots        = 0;
+      p->dft_gen_bitmap = 0;
+      srsran_prach_gen_seqs(p);
+      p->seqs_N_zc = p->N_zc;
+      p->seqs_N_cs = p->N_cs;
+      p->seqs_rsi  = p->rsi;
+      p->seqs_hs   = p->hs;
+    }
     // Ensure num_ra_preambles is valid, if not assign default value
     if (p->num_ra_preambles < 4 || p->num_ra_preambles > p->N_roots) {
       p->num_ra_preambles = p->N_roots;
     }
 
+    // The detector needs the DFT of every root, generate the missing ones now rather than in the first detection
+    for (uint32_t i = 0; i < p->num_ra_preambles; i++) {
+      get_precoded_dft(p, p->root_seqs_idx[i]);
+    }
+    if (p->zc_ifft_bank.size != p->N_zc || p->zc_ifft_bank_nof_roots != p->num_ra_preambles) {
+      if (srsran_dft_replan_guru_c(
+              &p->zc_ifft_bank, p->N_zc, p->corr_bank, p->corr_bank, 1, 1, p->num_ra_preambles, p->N_zc, p->N_zc)) {
+        ERROR("Error creating DFT plan");
+        return SRSRAN_ERROR;
+      }
+      p->zc_ifft_bank_nof_roots = p->num_ra_preambles;
+    }
+
     // Create our FFT objects and buffers
     p->N_ifft_ul = N_ifft_ul;
     if (4 == preamble_format) {
@@ -879,32 +919,29 @@ int srsran_prach_process(srsran_prach_t* p,
 {
   float max_to_cancel = 0;
   cancellation_idx    = -1;
-  int max_idx         = 0;
   srsran_vec_cf_zero(p->cross, p->N_zc);
   srsran_vec_cf_zero(p->corr_freq, p->N_zc);
-  for (int i = 0; i < p->num_ra_preambles; i++) {
-    cf_t* root_spec = get_precoded_dft(p, p->root_seqs_idx[i]);
 
-    srsran_vec_prod_conj_ccc(p->prach_bins, root_spec, p->corr_spec, p->N_zc);
+  uint32_t winsize = 0;
+  if (p->N_cs != 0) {
+    winsize = p->N_cs;
+  } else {
+    winsize = p->N_zc;
+  }
+  uint32_t n_wins = p->N_zc / winsize;
 
-    srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
-    if (p->successive_cancellation) {
-      srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
-    }
-    srsran_dft_run(&p->zc_ifft, p->corr_spec, p->corr_spec);
+  // Correlate the received bins with all the root sequences, then take all of them to the delay domain in one IFFT
+  for (int i = 0; i < p->num_ra_preambles; i++) {
+    srsran_vec_prod_conj_ccc(p->prach_bins, p->dft_seqs[p->root_seqs_idx[i]], &p->corr_bank[i * p->N_zc], p->N_zc);
+  }
+  srsran_dft_run_guru_c(&p->zc_ifft_bank);
 
-    srsran_vec_abs_square_cf(p->corr_spec, p->corr, p->N_zc);
+  for (int i = 0; i < p->num_ra_preambles; i++) {
+    srsran_vec_abs_square_cf(&p->corr_bank[i * p->N_zc], p->corr, p->N_zc);
 
     float corr_ave = srsran_vec_acc_ff(p->corr, p->N_zc) / p->N_zc;
 
-    uint32_t winsize = 0;
-    if (p->N_cs != 0) {
-      winsize = p->N_cs;
-    } else {
-      winsize = p->N_zc;
-    }
-    uint32_t n_wins = p->N_zc / winsize;
-
+    // Power delay profile peak of every cyclic shift window
     float max_peak = 0;
     for (int j = 0; j < n_wins; j++) {
       uint32_t start = (p->N_zc - (j * p->N_cs)) % p->N_zc;
@@ -913,19 +950,18 @@ int srsran_prach_process(srsran_prach_t* p,
         end -= p->deadzone;
       }
       start += p->deadzone;
-      p->peak_values[j] = 0;
-      for (int k = start; k < end; k++) {
-        if (p->corr[k] > p->peak_values[j]) {
-          p->peak_values[j]  = p->corr[k];
-          p->peak_offsets[j] = k - start;
-          if (p->peak_values[j] > max_peak) {
-            max_peak = p->peak_values[j];
-            max_idx  = k;
-          }
-        }
-      }
+      uint32_t k         = start + srsran_vec_max_fi(&p->corr[start], end - start);
+      p->peak_values[j]  = p->corr[k];
+      p->peak_offsets[j] = k - start;
+      max_peak           = SRSRAN_MAX(max_peak, p->peak_values[j]);
     }
     if (max_peak > (p->detect_factor * corr_ave)) {
+      // The frequency domain correlation is only needed for the roots with a detection
+      srsran_vec_prod_conj_ccc(p->prach_bins, p->dft_seqs[p->root_seqs_idx[i]], p->corr_spec, p->N_zc);
+      srsran_vec_prod_conj_ccc(p->corr_spec, &p->corr_spec[1], p->cross, p->N_zc - 1);
+      if (p->successive_cancellation) {
+        srsran_vec_cf_copy(p->corr_freq, p->corr_spec, p->N_zc);
+      }
       for (int j = 0; j < n_wins; j++) {
         if (p->peak_values[j] > p->detect_factor * corr_ave) {
           if (indices) {
@@ -1024,6 +1060,8 @@ int srsran_prach_free(srsran_prach_t* p)
   srsran_dft_plan_free(&p->fft);
   srsran_dft_plan_free(&p->zc_fft);
   srsran_dft_plan_free(&p->zc_ifft);
+  srsran_dft_plan_free(&p->zc_ifft_bank);
+  free(p->corr_bank);
 
   if (p->signal_fft) {
     free(p->signal_fft);
@@ -23,6 +23,7 @@
 #include "srsran/srsran.h"
 #include <assert.h>
 #include <complex.h>
+#include <float.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -69,6 +70,30 @@ int srsran_pucch_init_(srsran_pucch_t* q, bool is_ue)
 
     if (!q->is_ue) {
       q->ce = srsran_vec_cf_malloc(SRSRAN_PUCCH_MAX_SYMBOLS);
+
+      q->bank        = srsran_vec_malloc(sizeof(srsran_pucch_bank_t) * SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_MAX_PRB);
+      q->bank_buffer = srsran_vec_cf_malloc(SRSRAN_CP_NORM_NSYMB * SRSRAN_NRE);
+      if (!q->bank || !q->bank_buffer) {
+        ERROR("Error allocating memory");
+        goto clean_exit;
+      }
+
+      // All the symbols of a PRB and slot are transformed at once
+      if (srsran_dft_plan_guru_c(&q->bank_dft,
+                                 SRSRAN_NRE,
+                                 SRSRAN_DFT_FORWARD,
+                                 q->bank_buffer,
+                                 q->bank_buffer,
+                                 1,
+                                 1,
+                                 SRSRAN_CP_NORM_NSYMB,
+                                 SRSRAN_NRE,
+                                 SRSRAN_NRE)) {
+        ERROR("Error creating DFT plan");
+        goto clean_exit;
+      }
+      srsran_vec_cf_zero(q->bank_buffer, SRSRAN_CP_NORM_NSYMB * SRSRAN_NRE);
+      srsran_pucch_reset_joint(q);
     }
 
     ret = SRSRAN_SUCCESS;
@@ -104,6 +129,13 @@ void srsran_pucch_free(srsran_pucch_t* q)
   if (q->ce) {
     free(q->ce);
   }
+  if (q->bank) {
+    free(q->bank);
+  }
+  if (q->bank_buffer) {
+    free(q->bank_buffer);
+  }
+  srsran_dft_plan_free(&q->bank_dft);
 
   srsran_modem_table_free(&q->mod);
   bzero(q, sizeof(srsran_pucch_t));
@@ -124,6 +156,8 @@ int srsran_pucch_set_cell(srsran_pucch_t* q, srsran_cell_t cell)
       if (srsran_pucch_n_cs_cell(q->cell, q->n_cs_cell)) {
         return SRSRAN_ERROR;
       }
+
+      srsran_pucch_reset_joint(q);
     }
 
     ret = SRSRAN_SUCCESS;
@@ -317,6 +351,52 @@ static uint32_t get_pucch_symbol(uint32_t m, srsran_pucch_format_t format, srsra
   return 0;
 }
 
+/* Cyclic shift of format 1/a/b according to 5.5.2.2.2 (is_dmrs=true) or 5.4.1 (is_dmrs=false) of 36.211, without the
+ * cell specific term n_cs_cell[ns][l]. The orthogonal sequence index and n'(ns) do not depend on the symbol either. */
+static uint32_t pucch_format1_n_cs_offset(const srsran_pucch_cfg_t* cfg,
+                                          srsran_cp_t               cp,
+                                          bool                      is_dmrs,
+                                          uint32_t                  ns,
+                                          uint32_t*                 n_oc_ptr,
+                                          uint32_t*                 n_prime_ns)
+{
+  uint32_t c       = SRSRAN_CP_ISNORM(cp) ? 3 : 2;
+  uint32_t N_prime = (cfg->n_pucch < c * cfg->N_cs / cfg->delta_pucch_shift) ? cfg->N_cs : SRSRAN_NRE;
+
+  uint32_t n_prime = cfg->n_pucch;
+  if (cfg->n_pucch >= c * cfg->N_cs / cfg->delta_pucch_shift) {
+    n_prime = (cfg->n_pucch - c * cfg->N_cs / cfg->delta_pucch_shift) % (c * SRSRAN_NRE / cfg->delta_pucch_shift);
+  }
+  if (ns % 2) {
+    if (cfg->n_pucch >= c * cfg->N_cs / cfg->delta_pucch_shift) {
+      n_prime = (c * (n_prime + 1)) % (c * SRSRAN_NRE / cfg->delta_pucch_shift + 1) - 1;
+    } else {
+      uint32_t d = SRSRAN_CP_ISNORM(cp) ? 2 : 0;
+      uint32_t h = (n_prime + d) % (c * N_prime / cfg->delta_pucch_shift);
+      n_prime    = (h / c) + (h % c) * N_prime / cfg->delta_pucch_shift;
+    }
+  }
+
+  if (n_prime_ns) {
+    *n_prime_ns = n_prime;
+  }
+
+  uint32_t n_oc_div = (!is_dmrs && SRSRAN_CP_ISEXT(cp)) ? 2 : 1;
+
+  uint32_t n_oc = (n_prime * cfg->delta_pucch_shift) / N_prime;
+  if (!is_dmrs && SRSRAN_CP_ISEXT(cp)) {
+    n_oc *= 2;
+  }
+  if (n_oc_ptr) {
+    *n_oc_ptr = n_oc;
+  }
+
+  if (SRSRAN_CP_ISNORM(cp)) {
+    return (n_prime * cfg->delta_pucch_shift + (n_oc % cfg->delta_pucch_shift)) % N_prime;
+  }
+  return (n_prime * cfg->delta_pucch_shift + n_oc / n_oc_div) % N_prime;
+}
+
 /* Map PUCCH symbols to physical resources according to 5.4.3 in 36.211 */
 static int pucch_cp(srsran_pucch_t*     q,
                     srsran_ul_sf_cfg_t* sf,
@@ -871,6 +951,231 @@ int srsran_pucch_decode(srsran_pucch_t*        q,
   return ret;
 }
 
+void srsran_pucch_reset_joint(srsran_pucch_t* q)
+{
+  if (q != NULL && q->bank != NULL) {
+    for (uint32_t i = 0; i < SRSRAN_NOF_SLOTS_PER_SF * SRSRAN_MAX_PRB; i++) {
+      q->bank[i].valid = false;
+    }
+    q->bank_tti = UINT32_MAX;
+  }
+}
+
+/* Returns the cyclic shift spectrum of a PRB and slot, computing it if no other UE did it in this subframe */
+static srsran_pucch_bank_t*
+pucch_bank_get(srsran_pucch_t* q, const cf_t* sf_symbols, uint32_t slot_idx, uint32_t n_prb, uint32_t u)
+{
+  srsran_pucch_bank_t* b = &q->bank[slot_idx * SRSRAN_MAX_PRB + n_prb];
+  if (b->valid && b->u == u) {
+    return b;
+  }
+
+  cf_t r_u[SRSRAN_NRE];
+  if (srsran_zc_sequence_generate_lte(u, 0, 0.0f, 1, r_u) < SRSRAN_SUCCESS) {
+    return NULL;
+  }
+
+  uint32_t nsymbols = SRSRAN_CP_NSYMB(q->cell.cp);
+  for (uint32_t l = 0; l < nsymbols; l++) {
+    const cf_t* y = &sf_symbols[SRSRAN_RE_IDX(q->cell.nof_prb, l + slot_idx * nsymbols, n_prb * SRSRAN_NRE)];
+    cf_t*       x = &q->bank_buffer[l * SRSRAN_NRE];
+
+    srsran_vec_prod_conj_ccc(y, r_u, x, SRSRAN_NRE);
+    b->power[l] = srsran_vec_avg_power_cf(x, SRSRAN_NRE);
+    b->freq[l]  = srsran_vec_estimate_frequency(x, SRSRAN_NRE);
+  }
+
+  // Bin n holds cyclic shift n
+  srsran_dft_run_guru_c(&q->bank_dft);
+  srsran_vec_cf_copy(b->bins[0], q->bank_buffer, nsymbols * SRSRAN_NRE);
+
+  b->u     = u;
+  b->valid = true;
+  return b;
+}
+
+int srsran_pucch_decode_joint(srsran_pucch_t*     q,
+                              srsran_ul_sf_cfg_t* sf,
+                              srsran_pucch_cfg_t* cfg,
+                              cf_t*               sf_symbols,
+                              srsran_pucch_res_t* data)
+{
+  if (q == NULL || q->bank == NULL || sf == NULL || cfg == NULL || sf_symbols == NULL || data == NULL ||
+      cfg->format >= SRSRAN_PUCCH_FORMAT_2) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (sf->tti != q->bank_tti) {
+    srsran_pucch_reset_joint(q);
+    q->bank_tti = sf->tti;
+  }
+
+  uint32_t N_rs                         = srsran_refsignal_dmrs_N_rs(cfg->format, q->cell.cp);
+  uint32_t sf_idx                       = sf->tti % SRSRAN_NOF_SF_X_FRAME;
+  uint32_t nof_re                       = 0;
+  cf_t     h[SRSRAN_NOF_SLOTS_PER_SF]   = {}; // Channel estimate
+  cf_t     acc[SRSRAN_NOF_SLOTS_PER_SF] = {}; // Despread data
+  float    pwr[SRSRAN_NOF_SLOTS_PER_SF] = {}; // Data average RE power
+  float    epre = 0.0f, noise = 0.0f, ta_err = 0.0f, dmrs_own = 0.0f, dmrs_all = 0.0f;
+
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    uint32_t ns    = SRSRAN_NOF_SLOTS_PER_SF * sf_idx + s;
+    uint32_t n_prb = srsran_pucch_n_prb(&q->cell, cfg, s);
+    if (n_prb >= q->cell.nof_prb) {
+      ERROR("Invalid PUCCH n_prb=%d", n_prb);
+      return SRSRAN_ERROR;
+    }
+
+    uint32_t f_gh = 0;
+    if (cfg->group_hopping_en) {
+      f_gh = q->f_gh[ns];
+    }
+    uint32_t             u = (f_gh + (q->cell.id % 30)) % 30;
+    srsran_pucch_bank_t* b = pucch_bank_get(q, sf_symbols, s, n_prb, u);
+    if (b == NULL) {
+      ERROR("Error computing PUCCH cyclic shift bank");
+      return SRSRAN_ERROR;
+    }
+
+    // Despread the DMRS orthogonal cover, C[n] is the spectrum of the slot averaged least-squares estimates
+    uint32_t n_oc          = 0;
+    uint32_t n_cs_rs       = pucch_format1_n_cs_offset(cfg, q->cell.cp, true, ns, &n_oc, NULL);
+    cf_t     C[SRSRAN_NRE] = {};
+    for (uint32_t m = 0; m < N_rs; m++) {
+      uint32_t l    = srsran_refsignal_dmrs_pucch_symbol(m, cfg->format, q->cell.cp);
+      uint32_t n_cs = (q->n_cs_cell[ns][l] + n_cs_rs) % SRSRAN_NRE;
+      cf_t     w    = cexpf(-I * srsran_refsignal_dmrs_pucch_format1_w_arg(m, n_oc % 3, q->cell.cp)) / N_rs;
+      for (uint32_t n = 0; n < SRSRAN_NRE; n++) {
+        C[n] += b->bins[l][(n + n_cs) % SRSRAN_NRE] * w;
+      }
+
+      // The REs not explained by this UE cyclic shift count as noise and interference
+      epre += b->power[l];
+      noise += b->power[l] - SRSRAN_CSQABS(b->bins[l][n_cs]) / (SRSRAN_NRE * SRSRAN_NRE);
+
+      // The cyclic shift is a ramp of n_cs / 12 cycles per subcarrier, since srsran_vec_estimate_frequency() returns
+      // the negated phase increment it is removed by adding n_cs / 12. The result is wrapped into [-0.5, 0.5)
+      float freq = b->freq[l] + (float)n_cs / SRSRAN_NRE;
+      freq -= floorf(freq + 0.5f);
+      ta_err += freq;
+    }
+    h[s] = C[0] / SRSRAN_NRE;
+    dmrs_own += SRSRAN_CSQABS(C[0]);
+    dmrs_all += srsran_vec_avg_power_cf(C, SRSRAN_NRE) * SRSRAN_NRE;
+
+    // Despread the data orthogonal cover, it is the correlation with encode_signal_format12() for d = 1
+    uint32_t N_sf      = get_N_sf(cfg->format, s, sf->shortened);
+    uint32_t N_sf_widx = N_sf == 3 ? 1 : 0;
+    uint32_t n_prime   = 0;
+    uint32_t n_cs_data = pucch_format1_n_cs_offset(cfg, q->cell.cp, true, ns, &n_oc, &n_prime);
+    float    S_ns      = (n_prime % 2) ? M_PI / 2 : 0;
+    for (uint32_t m = 0; m < N_sf; m++) {
+      uint32_t l    = get_pucch_symbol(m, cfg->format, q->cell.cp);
+      uint32_t n_cs = (q->n_cs_cell[ns][l] + n_cs_data) % SRSRAN_NRE;
+      acc[s] += b->bins[l][n_cs] * cexpf(-I * (w_n_oc[N_sf_widx][n_oc % 3][m] + S_ns));
+      pwr[s] += b->power[l];
+    }
+    nof_re += N_sf * SRSRAN_NRE;
+  }
+
+  // Measurements, as in srsran_chest_ul_estimate_pucch()
+  epre /= SRSRAN_NOF_SLOTS_PER_SF * N_rs;
+  noise /= SRSRAN_NOF_SLOTS_PER_SF * N_rs * (SRSRAN_NRE - 1) / (float)SRSRAN_NRE;
+  if (fpclassify(noise) == FP_ZERO || noise < 0.0f) {
+    noise = FLT_MIN;
+  }
+  cf_t  h_avg = (h[0] + h[1]) / 2;
+  float rsrp  = SRSRAN_MIN(SRSRAN_CSQABS(h_avg), epre);
+  float snr   = epre / noise;
+
+  data->rssi_dbFs = srsran_convert_power_to_dB(epre);
+  data->ni_dbFs   = srsran_convert_power_to_dBm(noise);
+  data->snr_db    = isnormal(snr) ? srsran_convert_power_to_dB(snr) : NAN;
+  DEBUG("PUCCH joint: RSRP=%+.1f dBfs, EPRE=%+.1f dBfs, SNR=%+.1f dB",
+        srsran_convert_power_to_dB(rsrp),
+        data->rssi_dbFs,
+        data->snr_db);
+
+  if (cfg->meas_ta_en) {
+    ta_err /= SRSRAN_NOF_SLOTS_PER_SF * N_rs;
+    if (isnormal(ta_err)) {
+      ta_err /= 15e3f;                         // Convert from normalized frequency to seconds
+      ta_err *= 1e6f;                          // Convert to micro-seconds
+      ta_err = roundf(ta_err * 10.0f) / 10.0f; // Round to one tenth of micro-second
+    } else {
+      ta_err = 0.0f;
+    }
+    data->ta_us    = ta_err;
+    data->ta_valid = true;
+  }
+
+  // Keep the received symbols for plotting
+  if (pucch_get(q, sf, cfg, sf_symbols, q->z_tmp) < 0) {
+    ERROR("Error getting PUCCH symbols");
+    return SRSRAN_ERROR;
+  }
+
+  // Perform DMRS Detection, if enabled. Ratio between the DMRS energy in the UE cyclic shift and all of them
+  if (isnormal(cfg->threshold_dmrs_detection)) {
+    data->dmrs_correlation = dmrs_own / dmrs_all;
+
+    // Return not detected if the ratio is 0, NAN, +/- Infinity or below threshold
+    if (!isnormal(data->dmrs_correlation) || data->dmrs_correlation < cfg->threshold_dmrs_detection) {
+      data->correlation = 0.0f;
+      data->detected    = false;
+      return SRSRAN_SUCCESS;
+    }
+  }
+
+  // MMSE equalised correlation with the candidate signals, same metric as srsran_vec_corr_ccc() in decode_signal()
+  cf_t  A   = 0.0f;
+  float s_z = 0.0f;
+  for (uint32_t s = 0; s < SRSRAN_NOF_SLOTS_PER_SF; s++) {
+    cf_t g = conjf(h[s]) / (SRSRAN_CSQABS(h[s]) + noise);
+    A += g * acc[s];
+    s_z += SRSRAN_CSQABS(g) * pwr[s] * SRSRAN_NRE;
+  }
+  float norm = sqrtf(s_z * nof_re);
+
+  uint8_t  pucch_bits[SRSRAN_CQI_MAX_BITS] = {};
+  uint8_t  b_max                           = 0;
+  float    corr_max                        = -1e9;
+  uint32_t nof_hyp                         = 1U << srsran_pucch_nof_ack_format(cfg->format);
+  for (uint8_t i = 0; i < nof_hyp; i++) {
+    uint8_t bits[2] = {i / 2, i % 2};
+    cf_t    d       = uci_encode_format1();
+    if (cfg->format == SRSRAN_PUCCH_FORMAT_1A) {
+      d = uci_encode_format1a(i);
+    } else if (cfg->format == SRSRAN_PUCCH_FORMAT_1B) {
+      d = uci_encode_format1b(bits);
+    }
+    float corr = crealf(conjf(d) * A) / norm;
+    if (corr > corr_max) {
+      corr_max = corr;
+      b_max    = i;
+    }
+  }
+  if (cfg->format == SRSRAN_PUCCH_FORMAT_1A) {
+    pucch_bits[0] = b_max;
+  } else if (cfg->format == SRSRAN_PUCCH_FORMAT_1B) {
+    pucch_bits[0] = b_max / 2;
+    pucch_bits[1] = b_max % 2;
+  }
+  data->correlation = isnormal(corr_max) ? corr_max : 0.0f;
+
+  bool pucch_found = (cfg->format == SRSRAN_PUCCH_FORMAT_1) ? data->correlation >= cfg->threshold_format1
+                                                            : data->correlation > cfg->threshold_format1;
+  decode_bits(cfg, pucch_found, pucch_bits, cfg->pucch2_drs_bits, &data->uci_data);
+  data->detected = pucch_found;
+
+  // Accept ACK only if correlation above threshold
+  if (cfg->format != SRSRAN_PUCCH_FORMAT_1) {
+    data->uci_data.ack.valid = data->correlation > cfg->threshold_data_valid_format1a;
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
 char* srsran_pucch_format_text(srsran_pucch_format_t format)
 {
   char* ret = NULL;
@@ -1156,52 +1461,10 @@ float srsran_pucch_alpha_format1(const uint32_t            n_cs_cell[SRSRAN_NSLO
                                  uint32_t*                 n_oc_ptr,
                                  uint32_t*                 n_prime_ns)
 {
-  uint32_t c       = SRSRAN_CP_ISNORM(cp) ? 3 : 2;
-  uint32_t N_prime = (cfg->n_pucch < c * cfg->N_cs / cfg->delta_pucch_shift) ? cfg->N_cs : SRSRAN_NRE;
-
-  uint32_t n_prime = cfg->n_pucch;
-  if (cfg->n_pucch >= c * cfg->N_cs / cfg->delta_pucch_shift) {
-    n_prime = (cfg->n_pucch - c * cfg->N_cs / cfg->delta_pucch_shift) % (c * SRSRAN_NRE / cfg->delta_pucch_shift);
-  }
-  if (ns % 2) {
-    if (cfg->n_pucch >= c * cfg->N_cs / cfg->delta_pucch_shift) {
-      n_prime = (c * (n_prime + 1)) % (c * SRSRAN_NRE / cfg->delta_pucch_shift + 1) - 1;
-    } else {
-      uint32_t d = SRSRAN_CP_ISNORM(cp) ? 2 : 0;
-      uint32_t h = (n_prime + d) % (c * N_prime / cfg->delta_pucch_shift);
-      n_prime    = (h / c) + (h % c) * N_prime / cfg->delta_pucch_shift;
-    }
-  }
-
-  if (n_prime_ns) {
-    *n_prime_ns = n_prime;
-  }
-
-  uint32_t n_oc_div = (!is_dmrs && SRSRAN_CP_ISEXT(cp)) ? 2 : 1;
-
-  uint32_t n_oc = (n_prime * cfg->delta_pucch_shift) / N_prime;
-  if (!is_dmrs && SRSRAN_CP_ISEXT(cp)) {
-    n_oc *= 2;
-  }
-  if (n_oc_ptr) {
-    *n_oc_ptr = n_oc;
-  }
-  uint32_t n_cs = 0;
-  if (SRSRAN_CP_ISNORM(cp)) {
-    n_cs = (n_cs_cell[ns][l] + (n_prime * cfg->delta_pucch_shift + (n_oc % cfg->delta_pucch_shift)) % N_prime) %
-           SRSRAN_NRE;
-  } else {
-    n_cs = (n_cs_cell[ns][l] + (n_prime * cfg->delta_pucch_shift + n_oc / n_oc_div) % N_prime) % SRSRAN_NRE;
-  }
+  uint32_t n_cs = pucch_format1_n_cs_offset(cfg, cp, is_dmrs, ns, n_oc_ptr, n_prime_ns);
+  n_cs          = (n_cs_cell[ns][l] + n_cs) % SRSRAN_NRE;
 
-  DEBUG("n_cs=%d, N_prime=%d, delta_pucch=%d, n_prime=%d, ns=%d, l=%d, ns_cs_cell=%d",
-        n_cs,
-        N_prime,
-        cfg->delta_pucch_shift,
-        n_prime,
-        ns,
-        l,
-        n_cs_cell[ns][l]);
+  DEBUG("n_cs=%d, delta_pucch=%d, ns=%d, l=%d, ns_cs_cell=%d", n_cs, cfg->delta_pucch_shift, ns, l, n_cs_cell[ns][l]);
 
   return 2 * M_PI * (n_cs) / SRSRAN_NRE;
 }
@@ -29,6 +29,7 @@ static srsran_carrier_nr_t carrier = SRSRAN_DEFAULT_CARRIER_NR;
 static uint16_t rnti        = 0x1234;
 static bool     fast_sweep  = true;
 static bool     interleaved = false;
+static uint32_t list_size   = 0;
 
 typedef struct {
   uint64_t time_us;
@@ -70,17 +71,18 @@ static int test(srsran_pdcch_nr_t*      tx,
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [pFIv] \n", prog);
+  printf("Usage: %s [pFILv] \n", prog);
   printf("\t-p Number of carrier PRB [Default %d]\n", carrier.nof_prb);
   printf("\t-F Fast CORESET frequency resource sweeping [Default %s]\n", fast_sweep ? "Enabled" : "Disabled");
   printf("\t-I Enable interleaved CCE-to-REG [Default %s]\n", interleaved ? "Enabled" : "Disabled");
+  printf("\t-L Polar list decoder size, 0 for SSC decoding [Default %d]\n", list_size);
   printf("\t-v [set srsran_verbose to debug, default none]\n");
 }
 
 static int parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "pFIv")) != -1) {
+  while ((opt = getopt(argc, argv, "pFIL:v")) != -1) {
     switch (opt) {
       case 'p':
         carrier.nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -91,6 +93,9 @@ static int parse_args(int argc, char** argv)
       case 'I':
         interleaved ^= true;
         break;
+      case 'L':
+        list_size = (uint32_t)strtol(optarg, NULL, 10);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -118,6 +123,7 @@ int main(int argc, char** argv)
   if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
     return SRSRAN_ERROR;
   }
+  args.polar_list_size = list_size;
 
   uint32_t                grid_sz  = carrier.nof_prb * SRSRAN_NRE * SRSRAN_NSYMB_PER_SLOT_NR;
   srsran_random_t         rand_gen = srsran_random_init(1234);
@@ -38,6 +38,7 @@ static uint32_t config_idx       = 3;
 static uint32_t root_seq_idx     = 0;
 static uint32_t zero_corr_zone   = 15;
 static uint32_t num_ra_preambles = 0; // use default
+static uint32_t nof_trials       = 1;
 
 static void usage(char* prog)
 {
@@ -47,12 +48,13 @@ static void usage(char* prog)
   printf("\t-r Root sequence index [Default 0]\n");
   printf("\t-z Zero correlation zone config [Default 1]\n");
   printf("\t-N Toggle LTE/NR operation, zero for LTE, non-zero for NR [Default %s]\n", is_nr ? "NR" : "LTE");
+  printf("\t-t Number of detections per preamble, for measuring the detection rate [Default %d]\n", nof_trials);
 }
 
 static void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "nfrzN")) != -1) {
+  while ((opt = getopt(argc, argv, "nfrzNt")) != -1) {
     switch (opt) {
       case 'n':
         nof_prb = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -69,6 +71,9 @@ static void parse_args(int argc, char** argv)
       case 'N':
         is_nr = (uint32_t)strtol(argv[optind], NULL, 10) > 0;
         break;
+      case 't':
+        nof_trials = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
       default:
         usage(argv[0]);
         exit(-1);
@@ -113,6 +118,7 @@ int main(int argc, char** argv)
   uint32_t seq_index = 0;
   uint32_t indices[64];
   uint32_t n_indices = 0;
+  uint64_t total_us  = 0;
   for (int i = 0; i < 64; i++)
     indices[i] = 0;
 
@@ -122,14 +128,25 @@ int main(int argc, char** argv)
     uint32_t prach_len = prach.N_seq;
 
     gettimeofday(&t[1], NULL);
-    srsran_prach_detect(&prach, 0, &preamble[prach.N_cp], prach_len, indices, &n_indices);
+    for (uint32_t trial = 0; trial < nof_trials; trial++) {
+      srsran_prach_detect(&prach, 0, &preamble[prach.N_cp], prach_len, indices, &n_indices);
+    }
     gettimeofday(&t[2], NULL);
     get_time_interval(t);
-    printf("texec=%ld us\n", t[0].tv_usec);
+    uint64_t elapsed_us = t[0].tv_usec + t[0].tv_sec * 1000000UL;
+    total_us += elapsed_us;
+    printf("texec=%ld us\n", (long)(elapsed_us / nof_trials));
     if (n_indices != 1 || indices[0] != seq_index)
       return -1;
   }
 
+  printf("config_idx=%d; zero_corr_zone=%d; nof_prb=%d; nof_roots=%d; %.1f detections/s\n",
+         config_idx,
+         zero_corr_zone,
+         nof_prb,
+         prach.num_ra_preambles,
+         64.0 * nof_trials * 1e6 / (double)SRSRAN_MAX(total_us, 1));
+
   srsran_prach_free(&prach);
 
   printf("Done\n");
@@ -42,22 +42,24 @@ static srsran_cell_t cell = {
 static uint32_t subframe      = 0;
 static bool     test_cqi_only = false;
 static float    snr_db        = 20.0f;
+static float    delay_us      = 0.0f;
 
 static void usage(char* prog)
 {
-  printf("Usage: %s [csNnv]\n", prog);
+  printf("Usage: %s [csNnSdv]\n", prog);
   printf("\t-c cell id [Default %d]\n", cell.id);
   printf("\t-s subframe [Default %d]\n", subframe);
   printf("\t-n nof_prb [Default %d]\n", cell.nof_prb);
   printf("\t-q Test CQI encoding/decoding only [Default %s].\n", test_cqi_only ? "yes" : "no");
   printf("\t-S Signal to Noise Ratio in dB [Default %.2f].\n", snr_db);
+  printf("\t-d Propagation delay in microseconds [Default %.2f].\n", delay_us);
   printf("\t-v [set verbose to debug, default none]\n");
 }
 
 void parse_args(int argc, char** argv)
 {
   int opt;
-  while ((opt = getopt(argc, argv, "csNnqSv")) != -1) {
+  while ((opt = getopt(argc, argv, "csNnqSdv")) != -1) {
     switch (opt) {
       case 's':
         subframe = (uint32_t)strtol(argv[optind], NULL, 10);
@@ -74,6 +76,9 @@ void parse_args(int argc, char** argv)
       case 'S':
         snr_db = strtof(argv[optind], NULL);
         break;
+      case 'd':
+        delay_us = strtof(argv[optind], NULL);
+        break;
       case 'v':
         increase_srsran_verbose_level();
         break;
@@ -224,6 +229,7 @@ int main(int argc, char** argv)
           pucch_cfg.format            = format;
           pucch_cfg.n_pucch           = n_pucch;
           pucch_cfg.rnti              = 11;
+          pucch_cfg.meas_ta_en        = true;
 
           ul_sf.tti = subframe;
 
@@ -253,6 +259,9 @@ int main(int argc, char** argv)
             uci_data.cfg.cqi.data_enable = true;
           }
 
+          // Format 1a/1b modulate the HARQ-ACK bits given in the PUCCH configuration
+          pucch_cfg.uci_cfg.ack[0].nof_acks = (format < SRSRAN_PUCCH_FORMAT_2) ? uci_data.cfg.ack[0].nof_acks : 0;
+
           // Encode PUCCH signals
           gettimeofday(&t[1], NULL);
           if (srsran_pucch_encode(&pucch_ue, &ul_sf, &pucch_cfg, &uci_data.value, sf_symbols)) {
@@ -272,6 +281,17 @@ int main(int argc, char** argv)
           get_time_interval(t);
           uint64_t t_enc = t[0].tv_usec + t[0].tv_sec * 1000000UL;
 
+          // Delay the signal, it is a linear phase across the subcarriers of every PRB. The phase is centred in the PRB
+          // so the delay does not rotate the PRB average, which the channel estimator assumes constant across slots
+          if (isnormal(delay_us)) {
+            for (uint32_t l = 0; l < SRSRAN_CP_NSYMB(cell.cp) * SRSRAN_NOF_SLOTS_PER_SF; l++) {
+              for (uint32_t k = 0; k < SRSRAN_NRE * cell.nof_prb; k++) {
+                float n = (float)(k % SRSRAN_NRE) - (SRSRAN_NRE - 1) / 2.0f;
+                sf_symbols[SRSRAN_RE_IDX(cell.nof_prb, l, k)] *= cexpf(-I * 2 * M_PI * 15e3f * delay_us * 1e-6f * n);
+              }
+            }
+          }
+
           // Run AWGN channel
           srsran_channel_awgn_run_c(&awgn, sf_symbols, sf_symbols, SRSRAN_NOF_RE(cell));
 
@@ -312,6 +332,71 @@ int main(int argc, char** argv)
                chest_res.epre_dBfs,
                chest_res.rsrp_dBfs,
                chest_res.snr_db);
+
+          // Format 1/1a/1b joint detection shall find the UCI in its resource and nothing in the next one
+          if (format < SRSRAN_PUCCH_FORMAT_2) {
+            srsran_pucch_cfg_t joint_cfg                = pucch_cfg;
+            joint_cfg.threshold_format1                 = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1;
+            joint_cfg.threshold_data_valid_format1a     = SRSRAN_PUCCH_DEFAULT_THRESHOLD_FORMAT1A;
+            joint_cfg.threshold_dmrs_detection          = SRSRAN_PUCCH_DEFAULT_THRESHOLD_DMRS;
+            joint_cfg.uci_cfg                           = uci_data.cfg;
+            joint_cfg.uci_cfg.is_scheduling_request_tti = (format == SRSRAN_PUCCH_FORMAT_1);
+
+            srsran_pucch_reset_joint(&pucch_enb);
+            gettimeofday(&t[1], NULL);
+            srsran_pucch_res_t res_joint = {};
+            if (srsran_pucch_decode_joint(&pucch_enb, &ul_sf, &joint_cfg, sf_symbols, &res_joint) < SRSRAN_SUCCESS) {
+              ERROR("Error decoding PUCCH");
+              goto quit;
+            }
+            gettimeofday(&t[2], NULL);
+            get_time_interval(t);
+            uint64_t t_joint = t[0].tv_usec + t[0].tv_sec * 1000000UL;
+
+            bool ack_ok = true;
+            for (uint32_t i = 0; i < srsran_pucch_nof_ack_format(format); i++) {
+              ack_ok &= (res_joint.uci_data.ack.ack_value[i] == uci_data.value.ack.ack_value[i]);
+            }
+            if (!res_joint.detected || !ack_ok || fabsf(res_joint.rssi_dbFs) > 1.0 ||
+                fabsf(res_joint.snr_db - snr_db) > 3.0) {
+              ERROR("Joint detection failed: detected=%d, correlation=%.2f, EPRE=%+.2f, SNR=%+.2f",
+                    res_joint.detected,
+                    res_joint.correlation,
+                    res_joint.rssi_dbFs,
+                    res_joint.snr_db);
+              goto quit;
+            }
+
+            // The time alignment shall match the delay, whatever the cyclic shift of the UE
+            if (!res_joint.ta_valid || fabsf(res_joint.ta_us - delay_us) > 0.15f) {
+              ERROR("Joint detection time alignment %+.1f us, expected %+.1f us (ncs=%d, d=%d, n_pucch=%d)",
+                    res_joint.ta_us,
+                    delay_us,
+                    ncs,
+                    d,
+                    n_pucch);
+              goto quit;
+            }
+
+            joint_cfg.n_pucch++;
+            srsran_pucch_res_t res_other = {};
+            if (srsran_pucch_decode_joint(&pucch_enb, &ul_sf, &joint_cfg, sf_symbols, &res_other) < SRSRAN_SUCCESS) {
+              ERROR("Error decoding PUCCH");
+              goto quit;
+            }
+            if (res_other.detected) {
+              ERROR("Joint detection false alarm: n_pucch=%d, correlation=%.2f",
+                    joint_cfg.n_pucch,
+                    res_other.correlation);
+              goto quit;
+            }
+
+            INFO("format %d, n_pucch: %d, t_joint=%" PRIu64 " us, correlation=%.2f\n",
+                 format,
+                 n_pucch,
+                 t_joint,
+                 res_joint.correlation);
+          }
         }
       }
     }
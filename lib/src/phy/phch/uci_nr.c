@@ -83,11 +83,13 @@ int srsran_uci_nr_init(srsran_uci_nr_t* q, const srsran_uci_nr_args_t* args)
   }
 
   srsran_polar_encoder_type_t polar_encoder_type = SRSRAN_POLAR_ENCODER_PIPELINED;
-  srsran_polar_decoder_type_t polar_decoder_type = SRSRAN_POLAR_DECODER_SSC_C;
+  srsran_polar_decoder_type_t polar_decoder_type = srsran_polar_decoder_type_from_list_size(args->polar_list_size);
 #ifdef LV_HAVE_AVX2
   if (!args->disable_simd) {
     polar_encoder_type = SRSRAN_POLAR_ENCODER_AVX2;
-    polar_decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    if (polar_decoder_type == SRSRAN_POLAR_DECODER_SSC_C) {
+      polar_decoder_type = SRSRAN_POLAR_DECODER_SSC_C_AVX2;
+    }
   }
 #endif // LV_HAVE_AVX2
 
@@ -140,7 +142,7 @@ int srsran_uci_nr_init(srsran_uci_nr_t* q, const srsran_uci_nr_args_t* args)
     return SRSRAN_ERROR;
   }
 
-  q->allocated = srsran_vec_u8_malloc(UCI_NR_POLAR_MAX);
+  q->allocated = srsran_vec_u8_malloc(UCI_NR_POLAR_MAX * SRSRAN_POLAR_DECODER_MAX_LIST_SIZE);
   if (q->allocated == NULL) {
     ERROR("Error malloc");
     return SRSRAN_ERROR;
@@ -808,31 +810,41 @@ static int uci_nr_decode_11_1706_bit(srsran_uci_nr_t*           q,
     int8_t* d = (int8_t*)q->d;
     srsran_polar_rm_rx_c(&q->rm_rx, &llr[E_r * r], d, E_r, q->code.n, K_r, UCI_NR_POLAR_RM_IBIL);
 
-    // Decode bits
-    if (srsran_polar_decoder_decode_c(&q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size) <
-        SRSRAN_SUCCESS) {
+    // Decode bits, a list decoder returns several candidates sorted from the most to the least likely one
+    int nof_candidates = srsran_polar_decoder_decode_list_c(
+        &q->decoder, d, q->allocated, q->code.n, q->code.F_set, q->code.F_set_size);
+    if (nof_candidates < SRSRAN_SUCCESS) {
       return SRSRAN_ERROR;
     }
 
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-      UCI_NR_INFO_RX("Polar alloc %d/%d ", r, C);
-      srsran_vec_fprint_byte(stdout, q->allocated, q->code.N);
-    }
+    // Select the first candidate that passes the CRC check, the most likely one is kept otherwise
+    bool crc_ok = false;
+    for (int i = 0; i < nof_candidates && !crc_ok; i++) {
+      uint8_t* allocated = q->allocated + i * q->code.N;
+      if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+        UCI_NR_INFO_RX("Polar alloc %d/%d ", r, C);
+        srsran_vec_fprint_byte(stdout, allocated, q->code.N);
+      }
 
-    // Undo channel allocation
-    srsran_polar_chanalloc_rx(q->allocated, q->c, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+      // Undo channel allocation
+      srsran_polar_chanalloc_rx(allocated, q->c, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
 
-    if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
-      UCI_NR_INFO_RX("Polar cb %d/%d c=", r, C);
-      srsran_vec_fprint_byte(stdout, q->c, K_r);
-    }
+      if (SRSRAN_DEBUG_ENABLED && get_srsran_verbose_level() >= SRSRAN_VERBOSE_INFO && !is_handler_registered()) {
+        UCI_NR_INFO_RX("Polar cb %d/%d c=", r, C);
+        srsran_vec_fprint_byte(stdout, q->c, K_r);
+      }
 
-    // Calculate checksum
-    uint8_t* ptr       = &q->c[A_prime / C];
-    uint32_t checksum1 = srsran_crc_checksum(crc, q->c, A_prime / C);
-    uint32_t checksum2 = srsran_bit_pack(&ptr, L);
-    (*decoded_ok)      = ((*decoded_ok) && (checksum1 == checksum2));
-    UCI_NR_INFO_RX("Checking %d/%d CRC%d={%02x,%02x}", r, C, L, checksum1, checksum2);
+      // Calculate checksum
+      uint8_t* ptr       = &q->c[A_prime / C];
+      uint32_t checksum1 = srsran_crc_checksum(crc, q->c, A_prime / C);
+      uint32_t checksum2 = srsran_bit_pack(&ptr, L);
+      crc_ok             = (checksum1 == checksum2);
+      UCI_NR_INFO_RX("Checking %d/%d CRC%d={%02x,%02x}", r, C, L, checksum1, checksum2);
+    }
+    if (!crc_ok && nof_candidates > 1) {
+      srsran_polar_chanalloc_rx(q->allocated, q->c, q->code.K, q->code.nPC, q->code.K_set, q->code.PC_set);
+    }
+    (*decoded_ok) = ((*decoded_ok) && crc_ok);
 
     // Prefix (A_prime - A) zeros for the first CB only
     if (r == 0) {
@@ -71,6 +71,13 @@ typedef struct {
 
 static void update_rates(rf_file_handler_t* handler, double srate);
 
+static int open_file(void**                         h,
+                     FILE**                         rx_files,
+                     FILE**                         tx_files,
+                     uint32_t                       nof_channels,
+                     uint32_t                       base_srate,
+                     const srsran_iq_file_format_t* tx_formats);
+
 void rf_file_info(char* id, const char* format, ...)
 {
 #if VERBOSE
@@ -175,16 +182,28 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
 {
   int ret = SRSRAN_ERROR;
 
-  FILE* rx_files[SRSRAN_MAX_CHANNELS] = {NULL};
-  FILE* tx_files[SRSRAN_MAX_CHANNELS] = {NULL};
+  FILE*                   rx_files[SRSRAN_MAX_CHANNELS]   = {NULL};
+  FILE*                   tx_files[SRSRAN_MAX_CHANNELS]   = {NULL};
+  srsran_iq_file_format_t tx_formats[SRSRAN_MAX_CHANNELS] = {};
 
   if (h && nof_channels <= SRSRAN_MAX_CHANNELS) {
-    uint32_t base_srate = FILE_BASERATE_DEFAULT_HZ;
+    uint32_t                base_srate        = FILE_BASERATE_DEFAULT_HZ;
+    srsran_iq_file_format_t default_tx_format = SRSRAN_IQ_FILE_NOF_FORMATS;
 
     // parse args
     if (args && strlen(args)) {
       // base_srate
       parse_uint32(args, "base_srate", -1, &base_srate);
+
+      // tx_format, raw complex float samples unless an IQ recording format is given
+      char tx_format[RF_PARAM_LEN] = {};
+      if (parse_string(args, "tx_format", -1, tx_format) == SRSRAN_SUCCESS) {
+        default_tx_format = srsran_iq_file_format_from_string(tx_format);
+        if (default_tx_format == SRSRAN_IQ_FILE_NOF_FORMATS) {
+          fprintf(stderr, "[file] Error: invalid tx_format: %s (fc32, sc16, bfp9 or bfp12)\n", tx_format);
+          goto clean_exit;
+        }
+      }
     } else {
       fprintf(stderr, "[file] Error: RF device args are required for file-based no-RF module\n");
       goto clean_exit;
@@ -199,6 +218,17 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
       char tx_file[RF_PARAM_LEN] = {};
       parse_string(args, "tx_file", i, tx_file);
 
+      // tx_format of this channel
+      char tx_format[RF_PARAM_LEN] = {};
+      tx_formats[i]                = default_tx_format;
+      if (parse_string(args, "tx_format", i, tx_format) == SRSRAN_SUCCESS) {
+        tx_formats[i] = srsran_iq_file_format_from_string(tx_format);
+        if (tx_formats[i] == SRSRAN_IQ_FILE_NOF_FORMATS) {
+          fprintf(stderr, "[file] Error: invalid tx_format%d: %s (fc32, sc16, bfp9 or bfp12)\n", i, tx_format);
+          goto clean_exit;
+        }
+      }
+
       // initialize transmitter
       if (strlen(tx_file) != 0) {
         tx_files[i] = fopen(tx_file, "wb");
@@ -219,7 +249,7 @@ int rf_file_open_multi(char* args, void** h, uint32_t nof_channels)
     }
 
     // defer further initialization to open_file method
-    ret = rf_file_open_file(h, rx_files, tx_files, nof_channels, base_srate);
+    ret = open_file(h, rx_files, tx_files, nof_channels, base_srate, tx_formats);
     if (ret != SRSRAN_SUCCESS) {
       goto clean_exit;
     }
@@ -243,6 +273,16 @@ clean_exit:
 }
 
 int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_channels, uint32_t base_srate)
+{
+  return open_file(h, rx_files, tx_files, nof_channels, base_srate, NULL);
+}
+
+static int open_file(void**                         h,
+                     FILE**                         rx_files,
+                     FILE**                         tx_files,
+                     uint32_t                       nof_channels,
+                     uint32_t                       base_srate,
+                     const srsran_iq_file_format_t* tx_formats)
 {
   int ret = SRSRAN_ERROR;
 
@@ -293,6 +333,8 @@ int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_c
     // TODO: add other formats
     rx_opts.sample_format = FILERF_TYPE_FC32;
     tx_opts.sample_format = FILERF_TYPE_FC32;
+    rx_opts.srate_hz      = base_srate;
+    tx_opts.srate_hz      = base_srate;
 
     update_rates(handler, 1.92e6);
 
@@ -309,7 +351,9 @@ int rf_file_open_file(void** h, FILE** rx_files, FILE** tx_files, uint32_t nof_c
         fprintf(stdout, "[file] %s rx channel %d not specified. Disabling receiver.\n", handler->id, i);
       }
       if (tx_files != NULL && tx_files[i] != NULL) {
-        tx_opts.file = tx_files[i];
+        tx_opts.file      = tx_files[i];
+        tx_opts.iq_record = tx_formats != NULL && tx_formats[i] < SRSRAN_IQ_FILE_NOF_FORMATS;
+        tx_opts.iq_format = tx_opts.iq_record ? tx_formats[i] : SRSRAN_IQ_FILE_FC32;
         if (rf_file_tx_open(&handler->transmitter[i], tx_opts) != SRSRAN_SUCCESS) {
           fprintf(stderr, "[file] Error: opening transmitter\n");
           goto clean_exit;
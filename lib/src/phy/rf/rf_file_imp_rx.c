@@ -60,6 +60,21 @@ int rf_file_rx_open(rf_file_rx_t* q, rf_file_opts_t opts)
       goto clean_exit;
     }
 
+    // IQ recordings are detected from their header and played back
+    if (srsran_iq_file_probe(q->file)) {
+      if (srsran_iq_player_init(&q->player, q->file)) {
+        fprintf(stderr, "Error: creating IQ player\n");
+        goto clean_exit;
+      }
+      q->playing = true;
+      if (opts.srate_hz != srsran_iq_player_get_srate(&q->player)) {
+        fprintf(stderr,
+                "[file] Warning: IQ recording sampled at %.2f MHz is played at %.2f MHz\n",
+                srsran_iq_player_get_srate(&q->player) / 1e6,
+                opts.srate_hz / 1e6);
+      }
+    }
+
     q->running = true;
 
     ret = SRSRAN_SUCCESS;
@@ -71,6 +86,10 @@ clean_exit:
 
 int rf_file_rx_baseband(rf_file_rx_t* q, cf_t* buffer, uint32_t nsamples)
 {
+  if (q->playing) {
+    return srsran_iq_player_read(&q->player, buffer, nsamples);
+  }
+
   uint32_t sample_sz = sizeof(cf_t);
 
   int ret = fread(buffer, sample_sz, nsamples, q->file);
@@ -95,6 +114,11 @@ void rf_file_rx_close(rf_file_rx_t* q)
   rf_file_info(q->id, "Closing ...\n");
   q->running = false;
 
+  if (q->playing) {
+    srsran_iq_player_free(&q->player);
+    q->playing = false;
+  }
+
   if (q->temp_buffer) {
     free(q->temp_buffer);
   }
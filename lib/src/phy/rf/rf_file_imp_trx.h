@@ -23,6 +23,7 @@
 #define SRSRAN_RF_FILE_IMP_TRX_H
 
 #include "srsran/config.h"
+#include "srsran/phy/io/iq_file.h"
 #include <math.h>
 #include <pthread.h>
 #include <stdbool.h>
@@ -43,36 +44,43 @@
 typedef enum { FILERF_TYPE_FC32 = 0, FILERF_TYPE_SC16 } rf_file_format_t;
 
 typedef struct {
-  char             id[FILE_ID_STRLEN];
-  rf_file_format_t sample_format;
-  FILE*            file;
-  uint64_t         nsamples;
-  bool             running;
-  pthread_mutex_t  mutex;
-  cf_t*            zeros;
-  void*            temp_buffer_convert;
-  uint32_t         frequency_mhz;
-  int32_t          sample_offset;
+  char                 id[FILE_ID_STRLEN];
+  rf_file_format_t     sample_format;
+  FILE*                file;
+  uint64_t             nsamples;
+  bool                 running;
+  pthread_mutex_t      mutex;
+  cf_t*                zeros;
+  void*                temp_buffer_convert;
+  uint32_t             frequency_mhz;
+  int32_t              sample_offset;
+  bool                 recording; // Samples are stored by the IQ recorder instead of written raw
+  srsran_iq_recorder_t recorder;
 } rf_file_tx_t;
 
 typedef struct {
-  char             id[FILE_ID_STRLEN];
-  rf_file_format_t sample_format;
-  FILE*            file;
-  uint64_t         nsamples;
-  bool             running;
-  pthread_t        thread;
-  pthread_mutex_t  mutex;
-  cf_t*            temp_buffer;
-  void*            temp_buffer_convert;
-  uint32_t         frequency_mhz;
+  char               id[FILE_ID_STRLEN];
+  rf_file_format_t   sample_format;
+  FILE*              file;
+  uint64_t           nsamples;
+  bool               running;
+  pthread_t          thread;
+  pthread_mutex_t    mutex;
+  cf_t*              temp_buffer;
+  void*              temp_buffer_convert;
+  uint32_t           frequency_mhz;
+  bool               playing; // The file is an IQ recording, it is read by the IQ player
+  srsran_iq_player_t player;
 } rf_file_rx_t;
 
 typedef struct {
-  const char*      id;
-  rf_file_format_t sample_format;
-  FILE*            file;
-  uint32_t         frequency_mhz;
+  const char*             id;
+  rf_file_format_t        sample_format;
+  FILE*                   file;
+  uint32_t                frequency_mhz;
+  bool                    iq_record; // Transmit into an IQ recording instead of raw samples
+  srsran_iq_file_format_t iq_format; // Sample format of the IQ recording
+  double                  srate_hz;  // Sampling rate of IQ recordings
 } rf_file_opts_t;
 
 /*
@@ -64,6 +64,16 @@ int rf_file_tx_open(rf_file_tx_t* q, rf_file_opts_t opts)
     }
     memset(q->zeros, 0, FILE_MAX_BUFFER_SIZE);
 
+    // Record compressed samples through the IQ recorder
+    if (opts.iq_record) {
+      if (srsran_iq_recorder_init(&q->recorder, q->file, opts.iq_format, opts.srate_hz)) {
+        fprintf(stderr, "Error: creating IQ recorder\n");
+        goto clean_exit;
+      }
+      q->recording = true;
+      rf_file_info(q->id, "Recording %s IQ samples\n", srsran_iq_file_format_to_string(opts.iq_format));
+    }
+
     q->running = true;
 
     ret = SRSRAN_SUCCESS;
@@ -81,6 +91,17 @@ static int _rf_file_tx_baseband(rf_file_tx_t* q, cf_t* buffer, uint32_t nsamples
   void*    buf       = (buffer) ? buffer : q->zeros;
   uint32_t sample_sz = sizeof(cf_t);
 
+  if (q->recording) {
+    // Gaps are not stored in IQ recordings, the player restores them from the block timestamps
+    if (buf != q->zeros && srsran_iq_recorder_write(&q->recorder, buffer, nsamples, q->nsamples) < SRSRAN_SUCCESS) {
+      rf_file_error(q->id, "[file] Error: recording %d samples.\n", nsamples);
+      goto clean_exit;
+    }
+    q->nsamples += nsamples;
+    n = nsamples;
+    goto clean_exit;
+  }
+
   if (q->sample_format == FILERF_TYPE_SC16) {
     buf       = q->temp_buffer_convert;
     sample_sz = 2 * sizeof(short);
@@ -186,6 +207,12 @@ void rf_file_tx_close(rf_file_tx_t* q)
 
   pthread_mutex_destroy(&q->mutex);
 
+  // Writes the pending samples before the file is closed
+  if (q->recording) {
+    srsran_iq_recorder_free(&q->recorder);
+    q->recording = false;
+  }
+
   if (q->zeros) {
     free(q->zeros);
   }
@@ -32,6 +32,9 @@
 #define PRINT_SAMPLES 0
 #define COMPARE_BITS 0
 #define COMPARE_EPSILON (1e-6f)
+#define COMPARE_EPSILON_SC16 (1e-4f)
+#define COMPARE_EPSILON_BFP12 (1e-3f)
+#define COMPARE_EPSILON_BFP9 (5e-3f)
 #define NOF_RX_ANT 4
 #define NUM_SF (500)
 #define SF_LEN (1920)
@@ -149,7 +152,7 @@ void enb_tx_function(const char* tx_args, bool timed_tx)
   srsran_rf_close(&enb_radio);
 }
 
-int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
+int run_test(const char* rx_args, const char* tx_args, bool timed_tx, float epsilon)
 {
   int ret = SRSRAN_ERROR;
 
@@ -200,7 +203,7 @@ int run_test(const char* rx_args, const char* tx_args, bool timed_tx)
                          &ue_rx_buffer[c][sf_offet + i * SF_LEN],
                          SF_LEN);
       uint32_t max_ix = srsran_vec_max_abs_ci(&ue_rx_buffer[c][sf_offet + i * SF_LEN], SF_LEN);
-      if (cabsf(ue_rx_buffer[c][sf_offet + i * SF_LEN + max_ix]) > COMPARE_EPSILON) {
+      if (cabsf(ue_rx_buffer[c][sf_offet + i * SF_LEN + max_ix]) > epsilon) {
         fprintf(stderr, "data mismatch in subframe %d\n", i);
         goto exit;
       }
@@ -290,7 +293,8 @@ int main()
 
 #if NOF_RX_ANT == 1
   // single tx, single rx with continuous transmissions (no decimation, no timed tx)
-  if (run_test("rx_file=tx_file0,base_srate=1.92e6", "tx_file=tx_file0,base_srate=1.92e6", false) != SRSRAN_SUCCESS) {
+  if (run_test("rx_file=tx_file0,base_srate=1.92e6", "tx_file=tx_file0,base_srate=1.92e6", false, COMPARE_EPSILON) !=
+      SRSRAN_SUCCESS) {
     fprintf(stderr, "Single tx, single rx test failed (no decimation, no timed tx)!\n");
     return -1;
   }
@@ -299,7 +303,8 @@ int main()
   // up to 4 trx radios with continous tx (no decimation, no timed tx)
   if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,base_srate=1.92e6",
                "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,base_srate=1.92e6",
-               false) != SRSRAN_SUCCESS) {
+               false,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Multi TRx radio test failed (no decimation, no timed tx)!\n");
     return -1;
   }
@@ -307,7 +312,8 @@ int main()
   // up to 4 trx radios with continous tx (with decimation, no timed tx)
   if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3",
                "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3",
-               false) != SRSRAN_SUCCESS) {
+               false,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Multi TRx radio test failed (with decimation, no timed tx)!\n");
     return -1;
   }
@@ -315,11 +321,40 @@ int main()
   // up to 4 trx radios with continous tx (with decimation, timed tx)
   if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3",
                "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3",
-               true) != SRSRAN_SUCCESS) {
+               true,
+               COMPARE_EPSILON) != SRSRAN_SUCCESS) {
     fprintf(stderr, "Two TRx radio test failed (with decimation, timed tx)!\n");
     return -1;
   }
 
+  // up to 4 trx radios recording compressed IQ samples (no decimation, no timed tx)
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3,base_srate=1.92e6",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,base_srate=1.92e6,tx_format=sc16",
+               false,
+               COMPARE_EPSILON_SC16) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (sc16 recording)!\n");
+    return -1;
+  }
+
+  // up to 4 trx radios recording block floating point IQ samples, the timed tx gaps are not stored in the file
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,tx_format=bfp12",
+               true,
+               COMPARE_EPSILON_BFP12) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (bfp12 recording, timed tx)!\n");
+    return -1;
+  }
+
+  // per channel recording formats
+  if (run_test("rx_file=tx_file0,rx_file=tx_file1,rx_file=tx_file2,rx_file=tx_file3",
+               "tx_file=tx_file0,tx_file=tx_file1,tx_file=tx_file2,tx_file=tx_file3,tx_format0=bfp9,tx_format1=bfp9,"
+               "tx_format2=bfp9,tx_format3=bfp9",
+               true,
+               COMPARE_EPSILON_BFP9) != SRSRAN_SUCCESS) {
+    fprintf(stderr, "Multi TRx radio test failed (bfp9 recording, timed tx)!\n");
+    return -1;
+  }
+
   // clean workspace
   remove_file("rx_file0");
   remove_file("rx_file1");
@@ -0,0 +1,271 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t get_time_ms(void)
+{
+  struct timespec ts = {};
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static bool process_is_alive(pid_t pid)
+{
+  return kill(pid, 0) == 0 || errno != ESRCH;
+}
+
+/// Waits until the sequence counter changes from the given value or the timeout expires. The futex lives in memory
+/// shared between processes, so the non-private operations are required.
+static void futex_wait(uint32_t* seq, uint32_t value, uint32_t timeout_ms)
+{
+  struct timespec ts = {timeout_ms / 1000, (timeout_ms % 1000) * 1000000L};
+  syscall(SYS_futex, seq, FUTEX_WAIT, value, &ts, NULL, 0);
+}
+
+/// Bumps the sequence counter and wakes up the other end of the ring, skipping the system call if it is not waiting
+static void notify(uint32_t* seq, uint32_t* waiting)
+{
+  __atomic_add_fetch(seq, 1, __ATOMIC_SEQ_CST);
+  if (__atomic_load_n(waiting, __ATOMIC_SEQ_CST)) {
+    syscall(SYS_futex, seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+  }
+}
+
+/// Blocks until the number of samples available to the caller, as computed by the given function, is not zero or the
+/// timeout expires. Returns the number of available samples.
+static uint32_t wait_available(rf_shm_link_t* link,
+                               uint32_t (*available)(rf_shm_link_t*),
+                               uint32_t* seq,
+                               uint32_t* waiting,
+                               uint32_t  timeout_ms)
+{
+  uint32_t n = available(link);
+  if (n) {
+    return n;
+  }
+
+  uint64_t deadline = get_time_ms() + timeout_ms;
+  uint64_t now      = 0;
+  while ((now = get_time_ms()) < deadline) {
+    uint32_t value = __atomic_load_n(seq, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(waiting, 1, __ATOMIC_SEQ_CST);
+    n = available(link);
+    if (n == 0) {
+      futex_wait(seq, value, (uint32_t)(deadline - now));
+      n = available(link);
+    }
+    __atomic_sub_fetch(waiting, 1, __ATOMIC_SEQ_CST);
+    if (n) {
+      break;
+    }
+  }
+
+  return n;
+}
+
+static uint32_t write_space(rf_shm_link_t* link)
+{
+  uint64_t read_ts = __atomic_load_n(&link->ring->read_ts, __ATOMIC_ACQUIRE);
+  return link->ring->capacity - (uint32_t)(link->ring->write_ts - read_ts);
+}
+
+static uint32_t read_space(rf_shm_link_t* link)
+{
+  uint64_t write_ts = __atomic_load_n(&link->ring->write_ts, __ATOMIC_ACQUIRE);
+  return (uint32_t)(write_ts - link->ring->read_ts);
+}
+
+int rf_shm_link_open(rf_shm_link_t* link, const char* name, rf_shm_role_t role, rf_shm_opts_t opts)
+{
+  int ret = SRSRAN_ERROR;
+  int fd  = -1;
+
+  bzero(link, sizeof(rf_shm_link_t));
+  link->role = role;
+
+  if (opts.ring_size == 0 || (opts.ring_size & (opts.ring_size - 1)) != 0) {
+    fprintf(stderr, "[shm] Error: ring size %d is not a power of two\n", opts.ring_size);
+    return SRSRAN_ERROR;
+  }
+
+  // POSIX shared memory object names start with a slash
+  snprintf(link->name, SHM_NAME_STRLEN, "%s%s", (name[0] == '/') ? "" : "/", name);
+  link->size = sizeof(rf_shm_ring_t) + (size_t)opts.ring_size * sizeof(cf_t);
+  link->mask = opts.ring_size - 1;
+
+  fd = shm_open(link->name, O_RDWR | O_CREAT, 0600);
+  if (fd < 0) {
+    fprintf(stderr, "[shm] Error: opening %s: %s\n", link->name, strerror(errno));
+    goto clean_exit;
+  }
+
+  // Both ends may race to create the object, only grow it so that the first one wins
+  struct stat st = {};
+  if (fstat(fd, &st) < 0 || ((size_t)st.st_size < link->size && ftruncate(fd, (off_t)link->size) < 0)) {
+    fprintf(stderr, "[shm] Error: allocating %zu B for %s: %s\n", link->size, link->name, strerror(errno));
+    goto clean_exit;
+  }
+
+  void* ptr = mmap(NULL, link->size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (ptr == MAP_FAILED) {
+    fprintf(stderr, "[shm] Error: mapping %s: %s\n", link->name, strerror(errno));
+    goto clean_exit;
+  }
+  link->ring = (rf_shm_ring_t*)ptr;
+
+  // The first process claiming the capacity field initialises the ring, the other one waits for it
+  uint32_t capacity = 0;
+  if (__atomic_compare_exchange_n(
+          &link->ring->capacity, &capacity, opts.ring_size, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    link->ring->base_srate = opts.base_srate;
+    __atomic_store_n(&link->ring->magic, SHM_MAGIC, __ATOMIC_RELEASE);
+  } else {
+    uint64_t deadline = get_time_ms() + opts.trx_timeout_ms;
+    while (__atomic_load_n(&link->ring->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC && get_time_ms() < deadline) {
+      usleep(1000);
+    }
+  }
+
+  if (__atomic_load_n(&link->ring->magic, __ATOMIC_ACQUIRE) != SHM_MAGIC || link->ring->capacity != opts.ring_size ||
+      link->ring->base_srate != opts.base_srate) {
+    fprintf(stderr,
+            "[shm] Error: %s was created with ring_size=%d and base_srate=%d, expected %d and %d. Remove "
+            "/dev/shm%s if it was left behind by a previous run.\n",
+            link->name,
+            link->ring->capacity,
+            link->ring->base_srate,
+            opts.ring_size,
+            opts.base_srate,
+            link->name);
+    goto clean_exit;
+  }
+
+  // Attach to the ring, taking over the slot of a process that terminated without detaching
+  pid_t* slot = (role == SHM_ROLE_WRITER) ? &link->ring->writer_pid : &link->ring->reader_pid;
+  pid_t  pid  = __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+  if ((pid != 0 && process_is_alive(pid)) ||
+      !__atomic_compare_exchange_n(slot, &pid, getpid(), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+    fprintf(stderr, "[shm] Error: %s is already in use by process %d\n", link->name, pid);
+    goto clean_exit;
+  }
+  link->attached = true;
+
+  // A new writer starts with an empty ring, whatever was left behind by a previous writer is dropped
+  if (role == SHM_ROLE_WRITER) {
+    __atomic_store_n(&link->ring->write_ts, __atomic_load_n(&link->ring->read_ts, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (fd >= 0) {
+    close(fd);
+  }
+  if (ret != SRSRAN_SUCCESS && link->ring) {
+    munmap(link->ring, link->size);
+    link->ring = NULL;
+  }
+  return ret;
+}
+
+int rf_shm_link_write(rf_shm_link_t* link, const cf_t* buffer, uint32_t nsamples, uint32_t timeout_ms)
+{
+  rf_shm_ring_t* ring = link->ring;
+
+  uint32_t space = wait_available(link, write_space, &ring->read_seq, &ring->writer_waiting, timeout_ms);
+  if (space == 0) {
+    return SRSRAN_ERROR_TIMEOUT;
+  }
+
+  // Copy samples in up to two chunks, NULL buffer transmits zeros
+  uint32_t n      = SRSRAN_MIN(space, nsamples);
+  uint32_t offset = (uint32_t)ring->write_ts & link->mask;
+  uint32_t n1     = SRSRAN_MIN(n, ring->capacity - offset);
+  if (buffer) {
+    memcpy(&ring->samples[offset], buffer, NSAMPLES2NBYTES(n1));
+    memcpy(&ring->samples[0], &buffer[n1], NSAMPLES2NBYTES(n - n1));
+  } else {
+    srsran_vec_cf_zero(&ring->samples[offset], n1);
+    srsran_vec_cf_zero(&ring->samples[0], n - n1);
+  }
+
+  __atomic_store_n(&ring->write_ts, ring->write_ts + n, __ATOMIC_RELEASE);
+  notify(&ring->write_seq, &ring->reader_waiting);
+
+  return (int)n;
+}
+
+int rf_shm_link_read(rf_shm_link_t* link, cf_t* buffer, uint32_t nsamples, uint32_t timeout_ms)
+{
+  rf_shm_ring_t* ring = link->ring;
+
+  uint32_t available = wait_available(link, read_space, &ring->write_seq, &ring->reader_waiting, timeout_ms);
+  if (available == 0) {
+    return SRSRAN_ERROR_TIMEOUT;
+  }
+
+  // Copy samples in up to two chunks
+  uint32_t n      = SRSRAN_MIN(available, nsamples);
+  uint32_t offset = (uint32_t)ring->read_ts & link->mask;
+  uint32_t n1     = SRSRAN_MIN(n, ring->capacity - offset);
+  memcpy(buffer, &ring->samples[offset], NSAMPLES2NBYTES(n1));
+  memcpy(&buffer[n1], &ring->samples[0], NSAMPLES2NBYTES(n - n1));
+
+  __atomic_store_n(&ring->read_ts, ring->read_ts + n, __ATOMIC_RELEASE);
+  notify(&ring->read_seq, &ring->writer_waiting);
+
+  return (int)n;
+}
+
+void rf_shm_link_close(rf_shm_link_t* link)
+{
+  if (link->ring == NULL) {
+    return;
+  }
+
+  if (link->attached) {
+    pid_t* slot = (link->role == SHM_ROLE_WRITER) ? &link->ring->writer_pid : &link->ring->reader_pid;
+    pid_t* peer = (link->role == SHM_ROLE_WRITER) ? &link->ring->reader_pid : &link->ring->writer_pid;
+    __atomic_store_n(slot, 0, __ATOMIC_SEQ_CST);
+
+    // The last process leaving the ring removes it
+    if (__atomic_load_n(peer, __ATOMIC_SEQ_CST) == 0) {
+      shm_unlink(link->name);
+    }
+    link->attached = false;
+  }
+
+  munmap(link->ring, link->size);
+  link->ring = NULL;
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSRAN_RF_SHM_IMP_TRX_H
+#define SRSRAN_RF_SHM_IMP_TRX_H
+
+#include "srsran/config.h"
+#include "srsran/phy/utils/vector.h"
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+/* Definitions */
+#define VERBOSE (0)
+#define NSAMPLES2NBYTES(X) (((uint32_t)(X)) * sizeof(cf_t))
+#define NBYTES2NSAMPLES(X) ((X) / sizeof(cf_t))
+#define SHM_MAX_BUFFER_SIZE (NSAMPLES2NBYTES(3072000)) // 10 subframes at 20 MHz
+#define SHM_TIMEOUT_MS (2000)
+#define SHM_BASERATE_DEFAULT_HZ (23040000)
+#define SHM_RING_SIZE_DEFAULT (1U << 21) // Samples, 17 ms at 122.88 MHz
+#define SHM_ID_STRLEN 16
+#define SHM_NAME_STRLEN 64
+#define SHM_MAX_GAIN_DB (30.0f)
+#define SHM_MIN_GAIN_DB (0.0f)
+#define SHM_MAGIC (0x5352534dU) // "SRSM"
+#define SHM_CACHE_LINE (64)
+
+/**
+ * Layout of the shared memory object holding a single-producer single-consumer ring of complex float samples. The
+ * writer owns the write position and the reader owns the read position, both count samples since the beginning of the
+ * stream so they are also the timestamp of the next sample to be written or read. Each side signals the other one
+ * through a futex sequence counter, the system call is skipped when nobody is waiting on it.
+ */
+typedef struct {
+  // Ring description, set once by the process creating the object
+  uint32_t magic;
+  uint32_t capacity; // Number of samples, power of two
+  uint32_t base_srate;
+  uint8_t  reserved0[SHM_CACHE_LINE - 3 * sizeof(uint32_t)];
+
+  // Writer state
+  uint64_t write_ts;
+  uint32_t write_seq;
+  uint32_t writer_waiting;
+  pid_t    writer_pid;
+  uint8_t  reserved1[SHM_CACHE_LINE - sizeof(uint64_t) - 2 * sizeof(uint32_t) - sizeof(pid_t)];
+
+  // Reader state
+  uint64_t read_ts;
+  uint32_t read_seq;
+  uint32_t reader_waiting;
+  pid_t    reader_pid;
+  uint8_t  reserved2[SHM_CACHE_LINE - sizeof(uint64_t) - 2 * sizeof(uint32_t) - sizeof(pid_t)];
+
+  // Samples follow
+  cf_t samples[];
+} rf_shm_ring_t;
+
+typedef enum { SHM_ROLE_WRITER = 0, SHM_ROLE_READER } rf_shm_role_t;
+
+/// Process local view of a shared memory ring
+typedef struct {
+  char           name[SHM_NAME_STRLEN];
+  rf_shm_role_t  role;
+  rf_shm_ring_t* ring;
+  size_t         size;
+  uint32_t       mask;
+  bool           attached;
+} rf_shm_link_t;
+
+typedef struct {
+  char            id[SHM_ID_STRLEN];
+  rf_shm_link_t   link;
+  uint64_t        nsamples;
+  bool            running;
+  pthread_mutex_t mutex;
+  uint32_t        frequency_mhz;
+  uint32_t        trx_timeout_ms;
+  bool            log_trx_timeout;
+} rf_shm_tx_t;
+
+typedef struct {
+  char            id[SHM_ID_STRLEN];
+  rf_shm_link_t   link;
+  uint64_t        nsamples;
+  bool            running;
+  pthread_mutex_t mutex;
+  uint32_t        frequency_mhz;
+  uint32_t        trx_timeout_ms;
+  bool            log_trx_timeout;
+} rf_shm_rx_t;
+
+typedef struct {
+  const char* id;
+  uint32_t    frequency_mhz;
+  uint32_t    ring_size;
+  uint32_t    base_srate;
+  uint32_t    trx_timeout_ms;
+  bool        log_trx_timeout;
+} rf_shm_opts_t;
+
+/*
+ * Common functions
+ */
+SRSRAN_API void rf_shm_info(char* id, const char* format, ...);
+
+SRSRAN_API void rf_shm_error(char* id, const char* format, ...);
+
+/*
+ * Shared memory ring functions
+ */
+SRSRAN_API int rf_shm_link_open(rf_shm_link_t* link, const char* name, rf_shm_role_t role, rf_shm_opts_t opts);
+
+SRSRAN_API int rf_shm_link_write(rf_shm_link_t* link, const cf_t* buffer, uint32_t nsamples, uint32_t timeout_ms);
+
+SRSRAN_API int rf_shm_link_read(rf_shm_link_t* link, cf_t* buffer, uint32_t nsamples, uint32_t timeout_ms);
+
+SRSRAN_API void rf_shm_link_close(rf_shm_link_t* link);
+
+/*
+ * Transmitter functions
+ */
+SRSRAN_API int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name);
+
+SRSRAN_API int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts);
+
+SRSRAN_API int rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples);
+
+SRSRAN_API uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q);
+
+SRSRAN_API int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_tx_close(rf_shm_tx_t* q);
+
+SRSRAN_API bool rf_shm_tx_is_running(rf_shm_tx_t* q);
+
+/*
+ * Receiver functions
+ */
+SRSRAN_API int rf_shm_rx_open(rf_shm_rx_t* q, rf_shm_opts_t opts, const char* name);
+
+SRSRAN_API int rf_shm_rx_baseband(rf_shm_rx_t* q, cf_t* buffer, uint32_t nsamples);
+
+SRSRAN_API bool rf_shm_rx_match_freq(rf_shm_rx_t* q, uint32_t freq_hz);
+
+SRSRAN_API void rf_shm_rx_close(rf_shm_rx_t* q);
+
+SRSRAN_API bool rf_shm_rx_is_running(rf_shm_rx_t* q);
+
+#endif // SRSRAN_RF_SHM_IMP_TRX_H
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "rf_shm_imp_trx.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+int rf_shm_tx_open(rf_shm_tx_t* q, rf_shm_opts_t opts, const char* name)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (q) {
+    // Zero object
+    bzero(q, sizeof(rf_shm_tx_t));
+
+    // Copy id
+    strncpy(q->id, opts.id, SHM_ID_STRLEN - 1);
+    q->id[SHM_ID_STRLEN - 1] = '\0';
+
+    q->frequency_mhz   = opts.frequency_mhz;
+    q->trx_timeout_ms  = opts.trx_timeout_ms;
+    q->log_trx_timeout = opts.log_trx_timeout;
+
+    rf_shm_info(q->id, "Opening transmitter: %s\n", name);
+
+    if (rf_shm_link_open(&q->link, name, SHM_ROLE_WRITER, opts) != SRSRAN_SUCCESS) {
+      goto clean_exit;
+    }
+
+    if (pthread_mutex_init(&q->mutex, NULL)) {
+      fprintf(stderr, "Error: creating mutex\n");
+      goto clean_exit;
+    }
+
+    q->running = true;
+
+    ret = SRSRAN_SUCCESS;
+  }
+
+clean_exit:
+  return ret;
+}
+
+static int _rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  uint32_t count = 0;
+
+  while (count < nsamples && q->running) {
+    // A NULL buffer writes zeros straight into the ring
+    int n = rf_shm_link_write(&q->link, (buffer) ? &buffer[count] : NULL, nsamples - count, q->trx_timeout_ms);
+    if (n == SRSRAN_ERROR_TIMEOUT) {
+      // The receiver is not consuming samples, keep trying
+      if (q->log_trx_timeout) {
+        fprintf(stderr, "Error: timeout transmitting samples after %dms\n", q->trx_timeout_ms);
+      }
+    } else if (n < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    } else {
+      count += n;
+    }
+  }
+
+  // Increment sample counter
+  q->nsamples += nsamples;
+
+  return (int)nsamples;
+}
+
+int rf_shm_tx_align(rf_shm_tx_t* q, uint64_t ts)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  int64_t nsamples = (int64_t)ts - (int64_t)q->nsamples;
+
+  if (nsamples > 0) {
+    rf_shm_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
+    _rf_shm_tx_baseband(q, NULL, (uint32_t)nsamples);
+  }
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+int rf_shm_tx_baseband(rf_shm_tx_t* q, cf_t* buffer, uint32_t nsamples)
+{
+  pthread_mutex_lock(&q->mutex);
+  int n = _rf_shm_tx_baseband(q, buffer, nsamples);
+  pthread_mutex_unlock(&q->mutex);
+
+  return n;
+}
+
+uint64_t rf_shm_tx_get_nsamples(rf_shm_tx_t* q)
+{
+  pthread_mutex_lock(&q->mutex);
+  uint64_t ret = q->nsamples;
+  pthread_mutex_unlock(&q->mutex);
+  return ret;
+}
+
+int rf_shm_tx_zeros(rf_shm_tx_t* q, uint32_t nsamples)
+{
+  pthread_mutex_lock(&q->mutex);
+
+  rf_shm_info(q->id, " - Tx %d Zeros.\n", nsamples);
+  _rf_shm_tx_baseband(q, NULL, nsamples);
+
+  pthread_mutex_unlock(&q->mutex);
+
+  return (int)nsamples;
+}
+
+bool rf_shm_tx_match_freq(rf_shm_tx_t* q, uint32_t freq_hz)
+{
+  bool ret = false;
+  if (q) {
+    ret = (q->frequency_mhz == 0 || q->frequency_mhz == freq_hz);
+  }
+  return ret;
+}
+
+void rf_shm_tx_close(rf_shm_tx_t* q)
+{
+  if (!q->running) {
+    rf_shm_link_close(&q->link);
+    return;
+  }
+
+  pthread_mutex_lock(&q->mutex);
+  q->running = false;
+  pthread_mutex_unlock(&q->mutex);
+
+  pthread_mutex_destroy(&q->mutex);
+
+  rf_shm_link_close(&q->link);
+}
+
+bool rf_shm_tx_is_running(rf_shm_tx_t* q)
+{
+  if (!q) {
+    return false;
+  }
+
+  bool ret = false;
+  pthread_mutex_lock(&q->mutex);
+  ret = q->running;
+  pthread_mutex_unlock(&q->mutex);
+
+  return ret;
+}
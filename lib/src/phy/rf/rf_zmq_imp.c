@@ -42,6 +42,7 @@ typedef struct {
   uint32_t srate; // radio rate configured by upper layers
   uint32_t base_srate;
   uint32_t decim_factor; // decimation factor between base_srate used on transport on radio's rate
+  double   pacing;       // stream rate relative to real time, 0 lets the peers run in lockstep as fast as possible
   double   rx_gain;
   double   tx_gain;
   uint32_t tx_freq_mhz[SRSRAN_MAX_CHANNELS];
@@ -208,6 +209,7 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
     bzero(handler, sizeof(rf_zmq_handler_t));
     *h                  = handler;
     handler->base_srate = ZMQ_BASERATE_DEFAULT_HZ; // Sample rate for 100 PRB cell
+    handler->pacing     = 1.0;
     pthread_mutex_lock(&handler->rx_gain_mutex);
     handler->rx_gain = 0.0;
     pthread_mutex_unlock(&handler->rx_gain_mutex);
@@ -246,6 +248,13 @@ int rf_zmq_open_multi(char* args, void** h, uint32_t nof_channels)
       // id
       parse_string(args, "id", -1, handler->id);
 
+      // pacing
+      parse_double(args, "pacing", -1, &handler->pacing);
+      if (handler->pacing < 0.0) {
+        fprintf(stderr, "[zmq] Error: pacing must be positive or 0 for an unpaced stream\n");
+        goto clean_exit;
+      }
+
       // rx_type
       char tmp[RF_PARAM_LEN] = {0};
       if (parse_string(args, "rx_type", -1, tmp) == SRSRAN_SUCCESS) {
@@ -664,7 +673,7 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
 
       // If no matching frequency found; set data to zeros
       if (unmatched) {
-        srsran_vec_zero(data[logical], nsamples);
+        srsran_vec_cf_zero(data[logical], nsamples);
       }
     }
     pthread_mutex_unlock(&handler->rx_config_mutex);
@@ -710,8 +719,10 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
     rf_zmq_info(handler->id, " - next rx time: %d + %.3f\n", ts_rx.full_secs, ts_rx.frac_secs);
     rf_zmq_info(handler->id, " - next tx time: %d + %.3f\n", ts_tx.full_secs, ts_tx.frac_secs);
 
-    // Leave time for the Tx to transmit
-    usleep((1000000UL * nsamples_baserate) / handler->base_srate);
+    // Leave time for the Tx to transmit, unless unpaced where the requests to the peer already keep the lockstep
+    if (handler->pacing > 0.0) {
+      usleep((useconds_t)((1000000.0 * nsamples_baserate) / (handler->base_srate * handler->pacing)));
+    }
 
     // check for tx gap if we're also transmitting on this radio
     for (int i = 0; i < handler->nof_channels; i++) {
@@ -720,6 +731,14 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
       }
     }
 
+    // Set gain, it is applied while converting the received samples. The scale also incorporates decim_factor
+    pthread_mutex_lock(&handler->rx_gain_mutex);
+    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
+    pthread_mutex_unlock(&handler->rx_gain_mutex);
+    if (decim_factor > 0) {
+      scale = scale / decim_factor;
+    }
+
     // copy from rx buffer as many samples as requested into provided buffer
     bool    completed                  = false;
     int32_t count[SRSRAN_MAX_CHANNELS] = {};
@@ -733,7 +752,7 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
         // Completed condition
         if (count[i] < nsamples_baserate && rf_zmq_rx_is_running(&handler->receiver[i])) {
           // Keep receiving
-          int32_t n = rf_zmq_rx_baseband(&handler->receiver[i], &ptr[count[i]], nsamples_baserate);
+          int32_t n = rf_zmq_rx_baseband(&handler->receiver[i], &ptr[count[i]], nsamples_baserate, scale);
 #if ZMQ_MONITOR
           // handle socket events
           int event = rf_zmq_rx_get_monitor_event(handler->receiver[i].socket_monitor, NULL, NULL);
@@ -795,7 +814,7 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
             for (int j = 0; j < decim_factor; j++, n++) {
               avg += ptr[n];
             }
-            dst[i] = avg; // divide by decim_factor later via scale
+            dst[i] = avg; // already divided by decim_factor via scale
           }
 
           rf_zmq_info(handler->id,
@@ -807,20 +826,6 @@ int rf_zmq_recv_with_time_multi(void* h, void** data, uint32_t nsamples, bool bl
       }
     }
 
-    // Set gain
-    pthread_mutex_lock(&handler->rx_gain_mutex);
-    float scale = srsran_convert_dB_to_amplitude(handler->rx_gain);
-    pthread_mutex_unlock(&handler->rx_gain_mutex);
-    // scale shall also incorporate decim_factor
-    if (decim_factor > 0) {
-      scale = scale / decim_factor;
-    }
-    for (uint32_t c = 0; c < handler->nof_channels; c++) {
-      if (buffers[c]) {
-        srsran_vec_sc_prod_cfc(buffers[c], scale, buffers[c], nsamples);
-      }
-    }
-
     // update rx time
     update_ts(handler, &handler->next_rx_ts, nsamples_baserate, "rx");
   }
@@ -970,11 +975,8 @@ int rf_zmq_send_timed_multi(void*  h,
           }
         }
 
-        // Scale according to current gain
-        srsran_vec_sc_prod_cfc(buf, tx_gain, buf, nsamples_baseband);
-
-        // Finally, transmit baseband
-        int n = rf_zmq_tx_baseband(&handler->transmitter[i], buf, nsamples_baseband);
+        // Finally, transmit baseband scaled according to current gain
+        int n = rf_zmq_tx_baseband(&handler->transmitter[i], buf, nsamples_baseband, tx_gain);
         if (n == SRSRAN_ERROR) {
           goto clean_exit;
         }
@@ -207,7 +207,7 @@ clean_exit:
   return ret;
 }
 
-int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
+int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples, float scale)
 {
   void*    dst_buffer = buffer;
   uint32_t sample_sz  = sizeof(cf_t);
@@ -244,7 +244,9 @@ int rf_zmq_rx_baseband(rf_zmq_rx_t* q, cf_t* buffer, uint32_t nsamples)
   }
 
   if (q->sample_format == ZMQ_TYPE_SC16) {
-    srsran_vec_convert_if(dst_buffer, INT16_MAX, (float*)buffer, 2 * nsamples);
+    srsran_vec_convert_scale_sc(dst_buffer, scale / INT16_MAX, buffer, nsamples, nsamples);
+  } else if (scale != 1.0f) {
+    srsran_vec_sc_prod_cfc(buffer, scale, buffer, nsamples);
   }
 
   return n;
@@ -104,10 +104,22 @@ clean_exit:
   return ret;
 }
 
-static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples, float scale)
 {
   int n = SRSRAN_ERROR;
 
+  // Convert and scale the samples in a single pass, a NULL buffer transmits zeros
+  void*    buf       = (buffer) ? buffer : q->zeros;
+  uint32_t sample_sz = sizeof(cf_t);
+  if (q->sample_format == ZMQ_TYPE_SC16) {
+    buf       = q->temp_buffer_convert;
+    sample_sz = 2 * sizeof(short);
+    srsran_vec_convert_scale_cs(buffer, scale * INT16_MAX, (int16_t*)buf, nsamples, nsamples);
+  } else if (buffer && scale != 1.0f) {
+    buf = q->temp_buffer_convert;
+    srsran_vec_sc_prod_cfc(buffer, scale, (cf_t*)buf, nsamples);
+  }
+
   while (n < 0 && q->running) {
     // Receive Transmit request is socket type is REPLY
     if (q->socket_type == ZMQ_REP) {
@@ -127,16 +139,6 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
       n = 1;
     }
 
-    // convert samples if necessary
-    void*    buf       = (buffer) ? buffer : q->zeros;
-    uint32_t sample_sz = sizeof(cf_t);
-
-    if (q->sample_format == ZMQ_TYPE_SC16) {
-      buf       = q->temp_buffer_convert;
-      sample_sz = 2 * sizeof(short);
-      srsran_vec_convert_fi((float*)buffer, INT16_MAX, (short*)q->temp_buffer_convert, 2 * nsamples);
-    }
-
     // Send base-band if request was received
     if (n > 0) {
       n = zmq_send(q->sock, buf, (size_t)sample_sz * nsamples, 0);
@@ -145,10 +147,10 @@ static int _rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
           n = SRSRAN_ERROR;
           goto clean_exit;
         }
-      } else if (n != NSAMPLES2NBYTES(nsamples)) {
+      } else if (n != (int)(sample_sz * nsamples)) {
         rf_zmq_error(q->id,
                      "[zmq] Error: transmitter expected %d bytes and sent %d. %s.\n",
-                     NSAMPLES2NBYTES(nsamples),
+                     sample_sz * nsamples,
                      n,
                      strerror(zmq_errno()));
         n = SRSRAN_ERROR;
@@ -175,7 +177,7 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
 
   if (nsamples > 0) {
     rf_zmq_info(q->id, " - Detected Tx gap of %d samples.\n", nsamples);
-    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+    _rf_zmq_tx_baseband(q, NULL, (uint32_t)nsamples, 1.0f);
   }
 
   pthread_mutex_unlock(&q->mutex);
@@ -183,14 +185,14 @@ int rf_zmq_tx_align(rf_zmq_tx_t* q, uint64_t ts)
   return (int)nsamples;
 }
 
-int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
+int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples, float scale)
 {
   int n;
 
   pthread_mutex_lock(&q->mutex);
 
   if (q->sample_offset > 0) {
-    _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)q->sample_offset);
+    _rf_zmq_tx_baseband(q, NULL, (uint32_t)q->sample_offset, 1.0f);
     q->sample_offset = 0;
   } else if (q->sample_offset < 0) {
     n = SRSRAN_MIN(-q->sample_offset, nsamples);
@@ -202,7 +204,7 @@ int rf_zmq_tx_baseband(rf_zmq_tx_t* q, cf_t* buffer, uint32_t nsamples)
     }
   }
 
-  n = _rf_zmq_tx_baseband(q, buffer, nsamples);
+  n = _rf_zmq_tx_baseband(q, buffer, nsamples, scale);
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -222,7 +224,7 @@ int rf_zmq_tx_zeros(rf_zmq_tx_t* q, uint32_t nsamples)
   pthread_mutex_lock(&q->mutex);
 
   rf_zmq_info(q->id, " - Tx %d Zeros.\n", nsamples);
-  _rf_zmq_tx_baseband(q, q->zeros, (uint32_t)nsamples);
+  _rf_zmq_tx_baseband(q, NULL, (uint32_t)nsamples, 1.0f);
 
   pthread_mutex_unlock(&q->mutex);
 
@@ -81,6 +81,7 @@ static int ssb_init_pbch(srsran_ssb_t* q)
   args.enable_encode         = q->args.enable_encode;
   args.enable_decode         = q->args.enable_decode;
   args.disable_simd          = q->args.disable_polar_simd;
+  args.polar_list_size       = q->args.polar_list_size;
 
   if (!args.enable_encode && !args.enable_decode) {
     return SRSRAN_SUCCESS;
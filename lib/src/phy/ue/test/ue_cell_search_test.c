@@ -0,0 +1,278 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+
+#include "srsran/common/test_common.h"
+#include "srsran/phy/channel/ch_awgn.h"
+#include "srsran/phy/dft/ofdm.h"
+#include "srsran/phy/ue/ue_cell_search.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// Cell parameters
+static uint32_t    pci     = 301; // Physical Cell Identifier
+static srsran_cp_t cp      = SRSRAN_CP_NORM;
+static uint32_t    nof_prb = SRSRAN_CS_NOF_PRB;
+
+// Test and channel parameters
+static uint32_t max_frames = 8;      // Maximum number of frames scanned per N_id_2
+static float    n0_dB      = -15.0f; // Noise floor in dB relative to full-scale
+static bool     real_time  = false;  // Receive the samples at the cell search sampling rate
+
+// Test context
+static uint32_t sf_len = 0;    // Subframe length
+static cf_t*    grid   = NULL; // Resource grid
+static cf_t*    buffer = NULL; // Base-band buffer
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [cnrv]\n", prog);
+  printf("\t-c PCI [Default %d]\n", pci);
+  printf("\t-n Noise floor in dB relative to full-scale [Default %.1f]\n", n0_dB);
+  printf("\t-f Maximum number of frames scanned per N_id_2 [Default %d]\n", max_frames);
+  printf("\t-r Receive the samples in real time [Default %s]\n", real_time ? "enabled" : "disabled");
+  printf("\t-v [set srsran_verbose to debug, default none]\n");
+}
+
+static void parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "cnfrv")) != -1) {
+    switch (opt) {
+      case 'c':
+        pci = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        n0_dB = strtof(argv[optind], NULL);
+        break;
+      case 'f':
+        max_frames = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'r':
+        real_time = true;
+        break;
+      case 'v':
+        increase_srsran_verbose_level();
+        break;
+      default:
+        usage(argv[0]);
+        exit(-1);
+    }
+  }
+}
+
+typedef struct {
+  uint32_t              sf_idx;
+  uint32_t              sf_offset;
+  uint64_t              nof_samples;
+  srsran_ofdm_t         ifft;
+  srsran_channel_awgn_t awgn;
+  cf_t                  pss_signal[SRSRAN_PSS_LEN];
+  float                 sss_signal0[SRSRAN_SSS_LEN];
+  float                 sss_signal5[SRSRAN_SSS_LEN];
+} test_context_t;
+
+static int test_context_init(test_context_t* ctx)
+{
+  if (ctx == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  SRSRAN_MEM_ZERO(ctx, test_context_t, 1);
+
+  if (srsran_ofdm_tx_init(&ctx->ifft, cp, grid, buffer, nof_prb) < SRSRAN_SUCCESS) {
+    ERROR("Init");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_channel_awgn_init(&ctx->awgn, 0x0) < SRSRAN_SUCCESS) {
+    ERROR("Init");
+    return SRSRAN_ERROR;
+  }
+
+  if (srsran_channel_awgn_set_n0(&ctx->awgn, n0_dB) < SRSRAN_SUCCESS) {
+    ERROR("Init");
+    return SRSRAN_ERROR;
+  }
+
+  srsran_pss_generate(ctx->pss_signal, pci % SRSRAN_NOF_NID_2);
+  srsran_sss_generate(ctx->sss_signal0, ctx->sss_signal5, pci);
+
+  return SRSRAN_SUCCESS;
+}
+
+static void test_context_free(test_context_t* ctx)
+{
+  if (ctx == NULL) {
+    return;
+  }
+
+  srsran_ofdm_tx_free(&ctx->ifft);
+  srsran_channel_awgn_free(&ctx->awgn);
+}
+
+static void run_subframe(test_context_t* ctx)
+{
+  // Put PSS and SSS in subframes 0 and 5
+  srsran_vec_cf_zero(grid, SRSRAN_SF_LEN_RE(nof_prb, cp));
+  if (ctx->sf_idx % (SRSRAN_NOF_SF_X_FRAME / 2) == 0) {
+    srsran_pss_put_slot(ctx->pss_signal, grid, nof_prb, cp);
+    srsran_sss_put_slot(ctx->sf_idx ? ctx->sss_signal5 : ctx->sss_signal0, grid, nof_prb, cp);
+  }
+  srsran_ofdm_tx_sf(&ctx->ifft);
+
+  // AWGN
+  srsran_channel_awgn_run_c(&ctx->awgn, buffer, buffer, sf_len);
+
+  ctx->sf_idx = (ctx->sf_idx + 1) % SRSRAN_NOF_SF_X_FRAME;
+}
+
+static int recv_callback(void* ptr, cf_t* data[SRSRAN_MAX_CHANNELS], uint32_t nof_samples, srsran_timestamp_t* t)
+{
+  test_context_t* ctx = (test_context_t*)ptr;
+
+  // Check inputs
+  if (ctx == NULL || data == NULL || data[0] == NULL) {
+    return SRSRAN_ERROR;
+  }
+
+  for (uint32_t count = 0; count < nof_samples;) {
+    if (ctx->sf_offset == 0) {
+      run_subframe(ctx);
+    }
+    uint32_t n = SRSRAN_MIN(nof_samples - count, sf_len - ctx->sf_offset);
+    srsran_vec_cf_copy(&data[0][count], &buffer[ctx->sf_offset], n);
+    ctx->sf_offset = (ctx->sf_offset + n) % sf_len;
+    count += n;
+  }
+  ctx->nof_samples += nof_samples;
+
+  // Emulate the radio
+  if (real_time) {
+    usleep((useconds_t)(1e6 * nof_samples / SRSRAN_CS_SAMP_FREQ));
+  }
+
+  return nof_samples;
+}
+
+static int test_scan(srsran_ue_cellsearch_t* cs, test_context_t* ctx, uint64_t* nof_samples)
+{
+  srsran_ue_cellsearch_result_t found_cells[SRSRAN_NOF_NID_2] = {};
+  uint32_t                      max_N_id_2                    = 0;
+  struct timeval                t[3];
+
+  ctx->nof_samples = 0;
+
+  gettimeofday(&t[1], NULL);
+  int ret = srsran_ue_cellsearch_scan(cs, found_cells, &max_N_id_2);
+  gettimeofday(&t[2], NULL);
+  get_time_interval(t);
+
+  TESTASSERT(ret > 0);
+  TESTASSERT(max_N_id_2 == pci % SRSRAN_NOF_NID_2);
+  TESTASSERT(found_cells[max_N_id_2].cell_id == pci);
+  TESTASSERT(found_cells[max_N_id_2].cp == cp);
+
+  printf("%s scan: found PCI=%d, received %.1f ms of samples in %.1f ms\n",
+         cs->parallel_ptr ? "Parallel" : "Serial",
+         found_cells[max_N_id_2].cell_id,
+         1000.0 * ctx->nof_samples / SRSRAN_CS_SAMP_FREQ,
+         t[0].tv_sec * 1e3 + t[0].tv_usec * 1e-3);
+
+  *nof_samples = ctx->nof_samples;
+
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+  parse_args(argc, argv);
+
+  sf_len = SRSRAN_SF_LEN_PRB(nof_prb);
+  grid   = srsran_vec_cf_malloc(SRSRAN_SF_LEN_RE(nof_prb, cp));
+  buffer = srsran_vec_cf_malloc(sf_len);
+
+  test_context_t         ctx                  = {};
+  srsran_ue_cellsearch_t cs                   = {};
+  uint64_t               serial_nof_samples   = 0;
+  uint64_t               parallel_nof_samples = 0;
+
+  if (grid == NULL || buffer == NULL) {
+    ERROR("Malloc");
+    goto clean_exit;
+  }
+
+  if (test_context_init(&ctx) < SRSRAN_SUCCESS) {
+    ERROR("Init");
+    goto clean_exit;
+  }
+
+  if (srsran_ue_cellsearch_init_multi(&cs, max_frames, recv_callback, 1, &ctx) < SRSRAN_SUCCESS) {
+    ERROR("Init");
+    goto clean_exit;
+  }
+  srsran_ue_cellsearch_set_nof_valid_frames(&cs, max_frames / 2);
+
+  // Search the N_id_2 one after another
+  if (test_scan(&cs, &ctx, &serial_nof_samples) < SRSRAN_SUCCESS) {
+    ERROR("Serial scan failed");
+    goto clean_exit;
+  }
+
+  // Search all the N_id_2 on the same samples
+  if (srsran_ue_cellsearch_enable_parallel(&cs) < SRSRAN_SUCCESS) {
+    ERROR("Enabling parallel scan");
+    goto clean_exit;
+  }
+  if (test_scan(&cs, &ctx, &parallel_nof_samples) < SRSRAN_SUCCESS) {
+    ERROR("Parallel scan failed");
+    goto clean_exit;
+  }
+
+  // The parallel scan must not receive more samples than the slowest N_id_2 of the serial scan
+  if (parallel_nof_samples >= serial_nof_samples) {
+    ERROR("Parallel scan received %" PRIu64 " samples, serial %" PRIu64, parallel_nof_samples, serial_nof_samples);
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_ue_cellsearch_free(&cs);
+  test_context_free(&ctx);
+
+  if (grid) {
+    free(grid);
+  }
+
+  if (buffer) {
+    free(buffer);
+  }
+
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+
+  return ret;
+}
@@ -21,6 +21,8 @@
 
 #include "srsran/srsran.h"
 #include <assert.h>
+#include <pthread.h>
+#include <semaphore.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
@@ -33,6 +35,52 @@
 
 #define CELL_SEARCH_BUFFER_MAX_SAMPLES (3 * SRSRAN_SF_LEN_MAX)
 
+/* Every frame scanned in find state receives at most a frame, a realignment of up to a frame and a PSS offset */
+#define CELL_SEARCH_CAPTURE_FRAMES_PER_FRAME 3
+
+typedef struct {
+  /* Thread identifier: they must be set before thread creation */
+  pthread_t pthread;
+  uint32_t  N_id_2;
+  void*     parallel_ptr;
+
+  /* Cell search of this N_id_2, it receives the samples from the shared capture */
+  srsran_ue_cellsearch_t cs;
+  uint32_t               read_idx;
+
+  /* Result pointer: it must be set before posting start semaphore */
+  srsran_ue_cellsearch_result_t* found_cell;
+
+  /* Execution status */
+  int ret_status;
+
+  /* Semaphores */
+  sem_t start;
+  sem_t finish;
+
+  /* Thread flags */
+  bool started;
+  bool quit;
+} srsran_ue_cellsearch_worker_t;
+
+typedef struct {
+  srsran_ue_cellsearch_worker_t worker[SRSRAN_NOF_NID_2];
+
+  /* Samples received for the current scan, shared by all the workers */
+  cf_t*              buffer[SRSRAN_MAX_CHANNELS];
+  uint32_t           buffer_len;
+  uint32_t           nof_samples;
+  srsran_timestamp_t timestamp;
+
+  /* Capture state, protected by the mutex */
+  pthread_mutex_t mutex;
+  pthread_cond_t  cvar;
+  uint32_t        max_read_idx;
+  uint32_t        nof_running;
+  bool            capture_done;
+  bool            capture_error;
+} srsran_ue_cellsearch_parallel_t;
+
 int srsran_ue_cellsearch_init(srsran_ue_cellsearch_t* q,
                               uint32_t                max_frames,
                               int(recv_callback)(void*, void*, uint32_t, srsran_timestamp_t*),
@@ -159,6 +207,8 @@ clean_exit:
 
 void srsran_ue_cellsearch_free(srsran_ue_cellsearch_t* q)
 {
+  srsran_ue_cellsearch_disable_parallel(q);
+
   for (int i = 0; i < q->nof_rx_antennas; i++) {
     if (q->sf_buffer[i]) {
       free(q->sf_buffer[i]);
@@ -191,6 +241,191 @@ int srsran_ue_cellsearch_set_nof_valid_frames(srsran_ue_cellsearch_t* q, uint32_
 void srsran_set_detect_cp(srsran_ue_cellsearch_t* q, bool enable)
 {
   srsran_ue_sync_cp_en(&q->ue_sync, enable);
+
+  srsran_ue_cellsearch_parallel_t* h = (srsran_ue_cellsearch_parallel_t*)q->parallel_ptr;
+  if (h) {
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      srsran_ue_sync_cp_en(&h->worker[N_id_2].cs.ue_sync, enable);
+    }
+  }
+}
+
+/* Receive callback of the workers: copies the captured samples, waiting for them if they are not received yet */
+static int cellsearch_capture_recv(void* obj, cf_t* data[SRSRAN_MAX_CHANNELS], uint32_t nsamples, srsran_timestamp_t* t)
+{
+  srsran_ue_cellsearch_worker_t*   w   = (srsran_ue_cellsearch_worker_t*)obj;
+  srsran_ue_cellsearch_parallel_t* h   = (srsran_ue_cellsearch_parallel_t*)w->parallel_ptr;
+  int                              ret = SRSRAN_SUCCESS;
+
+  pthread_mutex_lock(&h->mutex);
+  if (w->read_idx + nsamples > h->max_read_idx) {
+    h->max_read_idx = w->read_idx + nsamples;
+    pthread_cond_broadcast(&h->cvar);
+  }
+  while (w->read_idx + nsamples > h->nof_samples && !h->capture_done) {
+    pthread_cond_wait(&h->cvar, &h->mutex);
+  }
+  if (w->read_idx + nsamples > h->nof_samples) {
+    ret = SRSRAN_ERROR;
+  }
+  pthread_mutex_unlock(&h->mutex);
+
+  if (ret < SRSRAN_SUCCESS) {
+    ERROR("Cell search capture exhausted (%d samples)", h->nof_samples);
+    return ret;
+  }
+
+  for (uint32_t i = 0; i < w->cs.nof_rx_antennas; i++) {
+    if (data[i]) {
+      srsran_vec_cf_copy(data[i], &h->buffer[i][w->read_idx], nsamples);
+    }
+  }
+
+  if (t) {
+    srsran_timestamp_copy(t, &h->timestamp);
+    srsran_timestamp_add(t, 0, (double)w->read_idx / SRSRAN_CS_SAMP_FREQ);
+  }
+  w->read_idx += nsamples;
+
+  return nsamples;
+}
+
+static void* cellsearch_worker_thread(void* arg)
+{
+  srsran_ue_cellsearch_worker_t*   w = (srsran_ue_cellsearch_worker_t*)arg;
+  srsran_ue_cellsearch_parallel_t* h = (srsran_ue_cellsearch_parallel_t*)w->parallel_ptr;
+
+  sem_wait(&w->start);
+  while (!w->quit) {
+    w->ret_status = srsran_ue_cellsearch_scan_N_id_2(&w->cs, w->N_id_2, w->found_cell);
+
+    /* Let the capture stop once every worker is done */
+    pthread_mutex_lock(&h->mutex);
+    h->nof_running--;
+    pthread_cond_broadcast(&h->cvar);
+    pthread_mutex_unlock(&h->mutex);
+
+    /* Post finish semaphore */
+    sem_post(&w->finish);
+
+    /* Wait for next scan */
+    sem_wait(&w->start);
+  }
+  sem_post(&w->finish);
+
+  pthread_exit(NULL);
+  return w;
+}
+
+void srsran_ue_cellsearch_disable_parallel(srsran_ue_cellsearch_t* q)
+{
+  srsran_ue_cellsearch_parallel_t* h = (srsran_ue_cellsearch_parallel_t*)q->parallel_ptr;
+  if (h) {
+    /* Stop threads */
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      srsran_ue_cellsearch_worker_t* w = &h->worker[N_id_2];
+      if (w->started) {
+        w->quit = true;
+        sem_post(&w->start);
+        pthread_join(w->pthread, NULL);
+      }
+      sem_destroy(&w->start);
+      sem_destroy(&w->finish);
+      srsran_ue_cellsearch_free(&w->cs);
+    }
+
+    for (uint32_t i = 0; i < SRSRAN_MAX_CHANNELS; i++) {
+      if (h->buffer[i]) {
+        free(h->buffer[i]);
+      }
+    }
+    pthread_cond_destroy(&h->cvar);
+    pthread_mutex_destroy(&h->mutex);
+
+    free(h);
+
+    q->parallel_ptr = NULL;
+  }
+}
+
+int srsran_ue_cellsearch_enable_parallel(srsran_ue_cellsearch_t* q)
+{
+  int ret = SRSRAN_SUCCESS;
+
+  if (q == NULL) {
+    return SRSRAN_ERROR_INVALID_INPUTS;
+  }
+
+  if (!q->parallel_ptr) {
+    srsran_ue_cellsearch_parallel_t* h = calloc(sizeof(srsran_ue_cellsearch_parallel_t), 1);
+
+    if (!h) {
+      ERROR("Allocating parallel cell search");
+      return SRSRAN_ERROR;
+    }
+    q->parallel_ptr = h;
+
+    pthread_mutex_init(&h->mutex, NULL);
+    pthread_cond_init(&h->cvar, NULL);
+
+    h->buffer_len = CELL_SEARCH_CAPTURE_FRAMES_PER_FRAME * q->max_frames * srsran_ue_sync_sf_len(&q->ue_sync);
+    for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
+      h->buffer[i] = srsran_vec_cf_malloc(h->buffer_len);
+      if (!h->buffer[i]) {
+        ERROR("Allocating parallel cell search buffer");
+        ret = SRSRAN_ERROR;
+        goto clean;
+      }
+    }
+
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      srsran_ue_cellsearch_worker_t* w = &h->worker[N_id_2];
+
+      w->N_id_2       = N_id_2;
+      w->parallel_ptr = h;
+
+      if (sem_init(&w->start, 0, 0)) {
+        ERROR("Creating semaphore");
+        ret = SRSRAN_ERROR;
+        goto clean;
+      }
+      if (sem_init(&w->finish, 0, 0)) {
+        ERROR("Creating semaphore");
+        ret = SRSRAN_ERROR;
+        goto clean;
+      }
+
+      if (srsran_ue_cellsearch_init_multi(
+              &w->cs, q->max_frames, cellsearch_capture_recv, q->nof_rx_antennas, (void*)w)) {
+        ERROR("Initiating cell search of N_id_2=%d", N_id_2);
+        ret = SRSRAN_ERROR;
+        goto clean;
+      }
+      srsran_ue_sync_cp_en(&w->cs.ue_sync, q->ue_sync.sfind.detect_cp);
+
+      if (pthread_create(&w->pthread, NULL, cellsearch_worker_thread, (void*)w)) {
+        ERROR("Creating cell search thread");
+        ret = SRSRAN_ERROR;
+        goto clean;
+      }
+      w->started = true;
+    }
+  }
+
+clean:
+  if (ret) {
+    srsran_ue_cellsearch_disable_parallel(q);
+  }
+  return ret;
+}
+
+srsran_ue_sync_t* srsran_ue_cellsearch_get_parallel_ue_sync(srsran_ue_cellsearch_t* q, uint32_t N_id_2)
+{
+  srsran_ue_cellsearch_parallel_t* h = (srsran_ue_cellsearch_parallel_t*)q->parallel_ptr;
+  if (h == NULL || N_id_2 >= SRSRAN_NOF_NID_2) {
+    return NULL;
+  }
+  return &h->worker[N_id_2].cs.ue_sync;
 }
 
 /* Decide the most likely cell based on the mode */
@@ -257,6 +492,98 @@ static void get_cell(srsran_ue_cellsearch_t* q, uint32_t nof_detected_frames, sr
   found_cell->cfo = q->candidates[nof_detected_frames - 1].cfo;
 }
 
+/* Receives the samples for all the workers while they search their N_id_2 on them. Returns the same as
+ * srsran_ue_cellsearch_scan()
+ */
+static int cellsearch_scan_parallel(srsran_ue_cellsearch_t*       q,
+                                    srsran_ue_cellsearch_result_t found_cells[3],
+                                    uint32_t*                     max_N_id_2)
+{
+  srsran_ue_cellsearch_parallel_t* h                  = (srsran_ue_cellsearch_parallel_t*)q->parallel_ptr;
+  int                              ret                = 0;
+  float                            max_peak_value     = -1.0;
+  uint32_t                         nof_detected_cells = 0;
+  uint32_t                         chunk_len          = srsran_ue_sync_sf_len(&q->ue_sync);
+
+  h->nof_samples   = 0;
+  h->max_read_idx  = 0;
+  h->nof_running   = SRSRAN_NOF_NID_2;
+  h->capture_done  = false;
+  h->capture_error = false;
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    srsran_ue_cellsearch_worker_t* w = &h->worker[N_id_2];
+    INFO("CELL SEARCH: Starting parallel scan for N_id_2=%d", N_id_2);
+    srsran_ue_cellsearch_set_nof_valid_frames(&w->cs, q->nof_valid_frames);
+    w->read_idx   = 0;
+    w->found_cell = &found_cells[N_id_2];
+    sem_post(&w->start);
+  }
+
+  /* Receive frames until every worker has finished or the capture is full, staying at most a frame ahead of the
+   * furthest worker so no more samples are received than the slowest N_id_2 needs */
+  pthread_mutex_lock(&h->mutex);
+  while (h->nof_running > 0 && h->nof_samples + chunk_len <= h->buffer_len) {
+    if (h->nof_samples >= h->max_read_idx + chunk_len) {
+      pthread_cond_wait(&h->cvar, &h->mutex);
+      continue;
+    }
+    pthread_mutex_unlock(&h->mutex);
+
+    cf_t*              ptr[SRSRAN_MAX_CHANNELS] = {NULL};
+    srsran_timestamp_t timestamp                = {};
+    for (uint32_t i = 0; i < q->nof_rx_antennas; i++) {
+      ptr[i] = &h->buffer[i][h->nof_samples];
+    }
+    int n = q->ue_sync.recv_callback(q->ue_sync.stream, ptr, chunk_len, &timestamp);
+
+    pthread_mutex_lock(&h->mutex);
+    if (n < 0) {
+      h->capture_error = true;
+      break;
+    }
+    if (h->nof_samples == 0) {
+      srsran_timestamp_copy(&h->timestamp, &timestamp);
+    }
+    h->nof_samples += chunk_len;
+    pthread_cond_broadcast(&h->cvar);
+  }
+  h->capture_done = true;
+  pthread_cond_broadcast(&h->cvar);
+  pthread_mutex_unlock(&h->mutex);
+
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    srsran_ue_cellsearch_worker_t* w = &h->worker[N_id_2];
+    sem_wait(&w->finish);
+    if (w->ret_status < 0) {
+      ret = w->ret_status;
+    } else {
+      nof_detected_cells += w->ret_status;
+    }
+  }
+
+  if (h->capture_error) {
+    ERROR("Error receiving samples");
+    return SRSRAN_ERROR;
+  }
+  if (ret < 0) {
+    ERROR("Error searching cell");
+    return ret;
+  }
+
+  if (max_N_id_2) {
+    for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+      if (found_cells[N_id_2].peak > max_peak_value) {
+        max_peak_value = found_cells[N_id_2].peak;
+        *max_N_id_2    = N_id_2;
+      }
+    }
+  }
+  INFO("CELL SEARCH: Parallel scan received %d samples", h->nof_samples);
+
+  return nof_detected_cells;
+}
+
 /** Finds up to 3 cells, one per each N_id_2=0,1,2 and stores ID and CP in the structure pointed by found_cell.
  * Each position in found_cell corresponds to a different N_id_2.
  * Saves in the pointer max_N_id_2 the N_id_2 index of the cell with the highest PSR
@@ -270,6 +597,10 @@ int srsran_ue_cellsearch_scan(srsran_ue_cellsearch_t*       q,
   float    max_peak_value     = -1.0;
   uint32_t nof_detected_cells = 0;
 
+  if (q->parallel_ptr) {
+    return cellsearch_scan_parallel(q, found_cells, max_N_id_2);
+  }
+
   for (uint32_t N_id_2 = 0; N_id_2 < 3; N_id_2++) {
     INFO("CELL SEARCH: Starting scan for N_id_2=%d", N_id_2);
     ret = srsran_ue_cellsearch_scan_N_id_2(q, N_id_2, &found_cells[N_id_2]);
@@ -423,6 +423,21 @@ static int dci_blind_search(srsran_ue_dl_t*     q,
 {
   uint32_t nof_dci = 0;
   if (rnti) {
+    // Decode the candidates of all the formats at once, the search below finds them already decoded
+    srsran_dci_location_t locations[SRSRAN_MAX_CANDIDATES];
+    uint32_t              nof_locations = 0;
+    for (int l = 0; l < search_space->nof_locations; l++) {
+      if (!dci_location_is_allocated(q, search_space->loc[l])) {
+        locations[nof_locations++] = search_space->loc[l];
+      }
+    }
+    if (srsran_pdcch_decode_candidates(
+            &q->pdcch, sf, dci_cfg, locations, nof_locations, search_space->formats, search_space->nof_formats) <
+        SRSRAN_SUCCESS) {
+      ERROR("Error decoding DCI candidates");
+      return SRSRAN_ERROR;
+    }
+
     for (int l = 0; l < search_space->nof_locations; l++) {
       if (nof_dci >= SRSRAN_MAX_DCI_MSG) {
         ERROR("Can't store more DCIs in buffer");
@@ -117,6 +117,16 @@ int srsran_ue_dl_nr_init(srsran_ue_dl_nr_t* q, cf_t* input[SRSRAN_MAX_PORTS], co
     return SRSRAN_ERROR;
   }
 
+  q->pdcch_llr = srsran_vec_i8_malloc(SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR * SRSRAN_PDCCH_MAX_RE * 2);
+  if (q->pdcch_llr == NULL) {
+    ERROR("Error alloc");
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR; i++) {
+    q->pdcch_candidates[i].llr = &q->pdcch_llr[i * SRSRAN_PDCCH_MAX_RE * 2];
+  }
+  q->pdcch_candidates_count = 0;
+
   return SRSRAN_SUCCESS;
 }
 
@@ -147,6 +157,10 @@ void srsran_ue_dl_nr_free(srsran_ue_dl_nr_t* q)
     free(q->pdcch_ce);
   }
 
+  if (q->pdcch_llr) {
+    free(q->pdcch_llr);
+  }
+
   SRSRAN_MEM_ZERO(q, srsran_ue_dl_nr_t, 1);
 }
 
@@ -196,6 +210,9 @@ int srsran_ue_dl_nr_set_pdcch_config(srsran_ue_dl_nr_t*           q,
   // Copy new configuration
   q->cfg = *cfg;
 
+  // Discard the demodulated candidates, the CORESET might have changed
+  q->pdcch_candidates_count = 0;
+
   // iterate over all possible CORESET and initialise/update the present ones
   for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_CORESET; i++) {
     // Skip CORESET if not present
@@ -228,6 +245,9 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
     srsran_ofdm_rx_sf(&q->fft[i]);
   }
 
+  // Discard the candidates demodulated in the previous slot
+  q->pdcch_candidates_count = 0;
+
   // Estimate PDCCH channel for every configured CORESET
   for (uint32_t i = 0; i < SRSRAN_UE_DL_NR_MAX_NOF_CORESET; i++) {
     if (q->cfg.coreset_present[i]) {
@@ -236,43 +256,31 @@ void srsran_ue_dl_nr_estimate_fft(srsran_ue_dl_nr_t* q, const srsran_slot_cfg_t*
   }
 }
 
-static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
-                                  srsran_dci_msg_nr_t*   dci_msg,
-                                  srsran_pdcch_nr_res_t* pdcch_res,
-                                  uint32_t               coreset_id)
+static int ue_dl_nr_pdcch_demodulate(srsran_ue_dl_nr_t*                 q,
+                                     uint32_t                           coreset_id,
+                                     const srsran_dci_location_t*       location,
+                                     srsran_ue_dl_nr_pdcch_candidate_t* candidate)
 {
-  // Select debug information
-  srsran_ue_dl_nr_pdcch_info_t* pdcch_info = NULL;
-  if (q->pdcch_info_count < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
-    pdcch_info = &q->pdcch_info[q->pdcch_info_count];
-    q->pdcch_info_count++;
-  } else {
-    ERROR("The UE does not expect more than %d candidates in this serving cell", SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR);
-    return SRSRAN_ERROR;
-  }
-  SRSRAN_MEM_ZERO(pdcch_info, srsran_ue_dl_nr_pdcch_info_t, 1);
-  pdcch_info->dci_ctx            = dci_msg->ctx;
-  pdcch_info->nof_bits           = dci_msg->nof_bits;
-  srsran_dmrs_pdcch_measure_t* m = &pdcch_info->measure;
+  srsran_dmrs_pdcch_measure_t* m = &candidate->measure;
+  candidate->valid               = false;
 
   // Measures the PDCCH transmission DMRS
-  srsran_dci_location_t location = dci_msg->ctx.location;
-  if (srsran_dmrs_pdcch_get_measure(&q->dmrs_pdcch[coreset_id], &location, m) < SRSRAN_SUCCESS) {
-    ERROR("Error getting measure location L=%d, ncce=%d", location.L, location.ncce);
+  if (srsran_dmrs_pdcch_get_measure(&q->dmrs_pdcch[coreset_id], location, m) < SRSRAN_SUCCESS) {
+    ERROR("Error getting measure location L=%d, ncce=%d", location->L, location->ncce);
     return SRSRAN_ERROR;
   }
 
   // If measured correlation is invalid, early return
   if (!isnormal(m->norm_corr)) {
-    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Invalid measurement;", location.L, location.ncce);
+    INFO("Discarded PDCCH candidate L=%d;ncce=%d; Invalid measurement;", location->L, location->ncce);
     return SRSRAN_SUCCESS;
   }
 
   // Compare EPRE with threshold
   if (m->epre_dBfs < q->pdcch_dmrs_epre_thr) {
     INFO("Discarded PDCCH candidate L=%d;ncce=%d; EPRE is too weak (%.1f<%.1f);",
-         location.L,
-         location.ncce,
+         location->L,
+         location->ncce,
          m->epre_dBfs,
          q->pdcch_dmrs_epre_thr);
     return SRSRAN_SUCCESS;
@@ -281,8 +289,8 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
   // Compare DMRS correlation with threshold
   if (m->norm_corr < q->pdcch_dmrs_corr_thr) {
     INFO("Discarded PDCCH candidate L=%d;ncce=%d; Correlation is too low (%.1f<%.1f); EPRE=%+.2f; RSRP=%+.2f;",
-         location.L,
-         location.ncce,
+         location->L,
+         location->ncce,
          m->norm_corr,
          q->pdcch_dmrs_corr_thr,
          m->epre_dBfs,
@@ -291,14 +299,15 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
   }
 
   // Extract PDCCH channel estimates
-  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[coreset_id], &location, q->pdcch_ce) < SRSRAN_SUCCESS) {
+  if (srsran_dmrs_pdcch_get_ce(&q->dmrs_pdcch[coreset_id], location, q->pdcch_ce) < SRSRAN_SUCCESS) {
     ERROR("Error extracting PDCCH DMRS");
     return SRSRAN_ERROR;
   }
 
-  // Decode PDCCH
-  if (srsran_pdcch_nr_decode(&q->pdcch, q->sf_symbols[0], q->pdcch_ce, dci_msg, pdcch_res) < SRSRAN_SUCCESS) {
-    ERROR("Error decoding PDCCH");
+  // Demodulate PDCCH
+  if (srsran_pdcch_nr_demodulate(
+          &q->pdcch, q->sf_symbols[0], q->pdcch_ce, location, candidate->llr, &candidate->result) < SRSRAN_SUCCESS) {
+    ERROR("Error demodulating PDCCH");
     return SRSRAN_ERROR;
   }
 
@@ -312,8 +321,126 @@ static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
   num_pdcch++;
 #endif
 
+  candidate->valid = true;
+
+  return SRSRAN_SUCCESS;
+}
+
+static srsran_ue_dl_nr_pdcch_candidate_t*
+ue_dl_nr_pdcch_candidate(srsran_ue_dl_nr_t* q, uint32_t coreset_id, const srsran_dci_location_t* location)
+{
+  // Search spaces and DCI sizes overlap in the same CCE, look for the location demodulated earlier in the slot
+  uint32_t count = SRSRAN_MIN(q->pdcch_candidates_count, SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR);
+  for (uint32_t i = 0; i < count; i++) {
+    srsran_ue_dl_nr_pdcch_candidate_t* candidate = &q->pdcch_candidates[i];
+    if (candidate->coreset_id == coreset_id && candidate->location.L == location->L &&
+        candidate->location.ncce == location->ncce) {
+      return candidate;
+    }
+  }
+
+  // Otherwise, demodulate it replacing the oldest entry if all of them are in use
+  srsran_ue_dl_nr_pdcch_candidate_t* candidate =
+      &q->pdcch_candidates[q->pdcch_candidates_count % SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR];
+  if (ue_dl_nr_pdcch_demodulate(q, coreset_id, location, candidate) < SRSRAN_SUCCESS) {
+    return NULL;
+  }
+  candidate->coreset_id = coreset_id;
+  candidate->location   = *location;
+  q->pdcch_candidates_count++;
+
+  return candidate;
+}
+
+/**
+ * @brief Decodes the PDCCH candidates gathered in a batch and saves their results in the debug information
+ */
+static int ue_dl_nr_decode_dci_batch(srsran_ue_dl_nr_t*            q,
+                                     const int8_t*                 llr[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                     srsran_dci_msg_nr_t*          dci_msg[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                     srsran_pdcch_nr_res_t*        pdcch_res[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                     srsran_ue_dl_nr_pdcch_info_t* pdcch_info[SRSRAN_POLAR_DECODER_MAX_BATCH],
+                                     uint32_t                      nof_batch)
+{
+  if (srsran_pdcch_nr_decode_llr_batch(&q->pdcch, llr, dci_msg, pdcch_res, nof_batch) < SRSRAN_SUCCESS) {
+    ERROR("Error decoding PDCCH");
+    return SRSRAN_ERROR;
+  }
+
   // Save information
-  pdcch_info->result = *pdcch_res;
+  for (uint32_t i = 0; i < nof_batch; i++) {
+    pdcch_info[i]->result = *pdcch_res[i];
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+/**
+ * @brief Finds and decodes the PDCCH transmissions of the given candidates, which share the DCI size and aggregation
+ * level, so that the valid ones are decoded together
+ */
+static int ue_dl_nr_find_dci_ncce(srsran_ue_dl_nr_t*     q,
+                                  srsran_dci_msg_nr_t*   dci_msg,
+                                  srsran_pdcch_nr_res_t* pdcch_res,
+                                  uint32_t               nof_candidates,
+                                  uint32_t               coreset_id)
+{
+  const int8_t*                 batch_llr[SRSRAN_POLAR_DECODER_MAX_BATCH];
+  srsran_dci_msg_nr_t*          batch_dci_msg[SRSRAN_POLAR_DECODER_MAX_BATCH];
+  srsran_pdcch_nr_res_t*        batch_res[SRSRAN_POLAR_DECODER_MAX_BATCH];
+  srsran_ue_dl_nr_pdcch_info_t* batch_info[SRSRAN_POLAR_DECODER_MAX_BATCH];
+  uint32_t                      nof_batch = 0;
+
+  for (uint32_t i = 0; i < nof_candidates; i++) {
+    // Select debug information
+    srsran_ue_dl_nr_pdcch_info_t* pdcch_info = NULL;
+    if (q->pdcch_info_count < SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR) {
+      pdcch_info = &q->pdcch_info[q->pdcch_info_count];
+      q->pdcch_info_count++;
+    } else {
+      ERROR("The UE does not expect more than %d candidates in this serving cell", SRSRAN_MAX_NOF_CANDIDATES_SLOT_NR);
+      return SRSRAN_ERROR;
+    }
+    SRSRAN_MEM_ZERO(pdcch_info, srsran_ue_dl_nr_pdcch_info_t, 1);
+    pdcch_info->dci_ctx  = dci_msg[i].ctx;
+    pdcch_info->nof_bits = dci_msg[i].nof_bits;
+
+    // Measure and demodulate the location, only the first search in the slot does it
+    const srsran_ue_dl_nr_pdcch_candidate_t* candidate =
+        ue_dl_nr_pdcch_candidate(q, coreset_id, &dci_msg[i].ctx.location);
+    if (candidate == NULL) {
+      return SRSRAN_ERROR;
+    }
+    pdcch_info->measure = candidate->measure;
+
+    // Skip the candidate if the DMRS measurements were discarded
+    if (!candidate->valid) {
+      continue;
+    }
+
+    // Add the candidate to the decoding batch
+    pdcch_res[i]             = candidate->result;
+    batch_llr[nof_batch]     = candidate->llr;
+    batch_dci_msg[nof_batch] = &dci_msg[i];
+    batch_res[nof_batch]     = &pdcch_res[i];
+    batch_info[nof_batch]    = pdcch_info;
+    nof_batch++;
+
+    // Decode PDCCH
+    if (nof_batch == SRSRAN_POLAR_DECODER_MAX_BATCH) {
+      if (ue_dl_nr_decode_dci_batch(q, batch_llr, batch_dci_msg, batch_res, batch_info, nof_batch) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+      nof_batch = 0;
+    }
+  }
+
+  // Decode the remaining candidates
+  if (nof_batch > 0) {
+    if (ue_dl_nr_decode_dci_batch(q, batch_llr, batch_dci_msg, batch_res, batch_info, nof_batch) < SRSRAN_SUCCESS) {
+      return SRSRAN_ERROR;
+    }
+  }
 
   return SRSRAN_SUCCESS;
 }
@@ -400,8 +527,9 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
         return SRSRAN_ERROR;
       }
 
-      // Iterate over the candidates
-      for (int ncce_idx = 0; ncce_idx < nof_candidates && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR; ncce_idx++) {
+      // Build the DCI messages of all the candidates
+      srsran_dci_msg_nr_t dci_msgs[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+      for (int ncce_idx = 0; ncce_idx < nof_candidates; ncce_idx++) {
         // Build DCI context
         srsran_dci_ctx_t ctx = {};
         ctx.location.L       = L;
@@ -414,18 +542,22 @@ static int ue_dl_nr_find_dci_ss(srsran_ue_dl_nr_t*           q,
         ctx.format           = dci_format;
 
         // Build DCI message
-        srsran_dci_msg_nr_t dci_msg = {};
-        dci_msg.ctx                 = ctx;
-        dci_msg.nof_bits            = (uint32_t)dci_nof_bits;
-
-        // Find and decode PDCCH transmission in the given ncce
-        srsran_pdcch_nr_res_t res = {};
-        if (ue_dl_nr_find_dci_ncce(q, &dci_msg, &res, coreset_id) < SRSRAN_SUCCESS) {
-          return SRSRAN_ERROR;
-        }
+        dci_msgs[ncce_idx].ctx      = ctx;
+        dci_msgs[ncce_idx].nof_bits = (uint32_t)dci_nof_bits;
+      }
+
+      // Find and decode PDCCH transmissions in the candidates, all of them have the same DCI size
+      srsran_pdcch_nr_res_t res[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+      if (ue_dl_nr_find_dci_ncce(q, dci_msgs, res, (uint32_t)nof_candidates, coreset_id) < SRSRAN_SUCCESS) {
+        return SRSRAN_ERROR;
+      }
+
+      // Iterate over the candidates
+      for (int ncce_idx = 0; ncce_idx < nof_candidates && q->dl_dci_msg_count < SRSRAN_MAX_DCI_MSG_NR; ncce_idx++) {
+        srsran_dci_msg_nr_t dci_msg = dci_msgs[ncce_idx];
 
         // If the CRC was not match, move to next candidate
-        if (!res.crc) {
+        if (!res[ncce_idx].crc) {
           continue;
         }
 
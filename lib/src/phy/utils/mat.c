@@ -158,6 +158,86 @@ int srsran_mat_2x2_cn(cf_t h00, cf_t h01, cf_t h10, cf_t h11, float* cn)
   return SRSRAN_SUCCESS;
 }
 
+static inline float mat_cf_abs2(cf_t a)
+{
+  return crealf(a) * crealf(a) + cimagf(a) * cimagf(a);
+}
+
+void srsran_mat_4x4_mmse_csi_gen(const cf_t y[4],
+                                 const cf_t h[4][4],
+                                 uint32_t   nof_rx,
+                                 uint32_t   nof_layers,
+                                 cf_t       x[4],
+                                 float*     csi,
+                                 float      noise_estimate)
+{
+  float d[4], d_rcp[4];
+  cf_t  a[4][4], l[4][4], z[4];
+
+  // 1. A = H' x H + No (lower triangle, diagonal in d) and z = H' x y
+  for (uint32_t i = 0; i < nof_layers; i++) {
+    d[i] = noise_estimate;
+    z[i] = 0.0f;
+    for (uint32_t r = 0; r < nof_rx; r++) {
+      d[i] += mat_cf_abs2(h[r][i]);
+      z[i] += conjf(h[r][i]) * y[r];
+    }
+    for (uint32_t j = 0; j < i; j++) {
+      a[i][j] = 0.0f;
+      for (uint32_t r = 0; r < nof_rx; r++) {
+        a[i][j] += conjf(h[r][i]) * h[r][j];
+      }
+    }
+  }
+
+  // 2. A = L x D x L'
+  for (uint32_t j = 0; j < nof_layers; j++) {
+    for (uint32_t k = 0; k < j; k++) {
+      d[j] -= mat_cf_abs2(l[j][k]) * d[k];
+    }
+    d_rcp[j] = 1.0f / d[j];
+    for (uint32_t i = j + 1; i < nof_layers; i++) {
+      cf_t v = a[i][j];
+      for (uint32_t k = 0; k < j; k++) {
+        v -= l[i][k] * conjf(l[j][k]) * d[k];
+      }
+      l[i][j] = v * d_rcp[j];
+    }
+  }
+
+  // 3. Forward substitution, L x z' = z
+  for (uint32_t i = 1; i < nof_layers; i++) {
+    for (uint32_t k = 0; k < i; k++) {
+      z[i] -= l[i][k] * z[k];
+    }
+  }
+
+  // 4. Backward substitution, L' x x = inv(D) x z'
+  for (int32_t i = (int32_t)nof_layers - 1; i >= 0; i--) {
+    x[i] = z[i] * d_rcp[i];
+    for (uint32_t k = i + 1; k < nof_layers; k++) {
+      x[i] -= conjf(l[k][i]) * x[k];
+    }
+  }
+
+  // 5. CSI, diag(inv(A)) = diag(M' x inv(D) x M) where M = inv(L)
+  if (csi) {
+    cf_t m[4][4];
+    for (uint32_t j = 0; j < nof_layers; j++) {
+      float s = d_rcp[j];
+      for (uint32_t i = j + 1; i < nof_layers; i++) {
+        cf_t v = l[i][j];
+        for (uint32_t k = j + 1; k < i; k++) {
+          v += l[i][k] * m[k][j];
+        }
+        m[i][j] = -v;
+        s += mat_cf_abs2(m[i][j]) * d_rcp[i];
+      }
+      csi[j] = 1.0f / s;
+    }
+  }
+}
+
 #ifdef LV_HAVE_SSE
 #include <smmintrin.h>
 
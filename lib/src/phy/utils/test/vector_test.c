@@ -502,6 +502,52 @@ TEST(
     free(x);
     free(z);)
 
+TEST(
+    srsran_vec_convert_scale_sc, int16_t* x = srsran_vec_i16_malloc(block_size * 2); MALLOC(cf_t, z);
+    float    scale   = 1.0f / 1000.0f;
+    uint32_t nof_pad = block_size / 4;
+
+    for (int i = 0; i < block_size * 2; i++) { x[i] = (int16_t)RANDOM_S(); }
+
+    TEST_CALL(srsran_vec_convert_scale_sc(x, scale, z, block_size - nof_pad, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          cf_t gold = 0.0f;
+          if (i < block_size - nof_pad) {
+            gold = (float)x[2 * i] * scale + I * (float)x[2 * i + 1] * scale;
+          }
+          double err = cabsf(gold - z[i]);
+          if (err > mse) {
+            mse = err;
+          }
+        }
+
+    free(x);
+    free(z);)
+
+TEST(
+    srsran_vec_convert_scale_cs, MALLOC(cf_t, x); int16_t* z = srsran_vec_i16_malloc(block_size * 2);
+    float    scale   = 1000.0f;
+    uint32_t nof_pad = block_size / 4;
+
+    for (int i = 0; i < block_size; i++) { x[i] = RANDOM_CF(); }
+
+    TEST_CALL(srsran_vec_convert_scale_cs(x, scale, z, block_size - nof_pad, block_size))
+
+        for (int i = 0; i < block_size; i++) {
+          cf_t gold = 0.0f;
+          if (i < block_size - nof_pad) {
+            gold = (float)(short)(crealf(x[i]) * scale) + I * (float)(short)(cimagf(x[i]) * scale);
+          }
+          double err = cabsf(gold - ((float)z[2 * i] + I * (float)z[2 * i + 1]));
+          if (err > mse) {
+            mse = err;
+          }
+        }
+
+    free(x);
+    free(z);)
+
 TEST(
     srsran_vec_prod_fff, MALLOC(float, x); MALLOC(float, y); MALLOC(float, z);
 
@@ -877,6 +923,79 @@ TEST(
     free(x_abs);
     free(env);)
 
+/* Compares the two pass radio sample path, format conversion followed by a gain product, with the fused kernels. One
+ * subframe at 122.88 MHz, the sampling rate of a 100 MHz NR carrier, is processed in each direction. */
+#define RADIO_PATH_SRATE_HZ (122.88e6)
+#define RADIO_PATH_SF_LEN ((uint32_t)(RADIO_PATH_SRATE_HZ / 1000))
+
+static void radio_path_print(const char* name, double two_pass_us, double fused_us)
+{
+  double two_pass_msps = (double)RADIO_PATH_SF_LEN * nof_repetitions / two_pass_us;
+  double fused_msps    = (double)RADIO_PATH_SF_LEN * nof_repetitions / fused_us;
+  printf("%32s ... two-pass %7.1f MSamp/s (%5.1f%% of a core) ... fused %7.1f MSamp/s (%5.1f%% of a core)\n",
+         name,
+         two_pass_msps,
+         100.0 * RADIO_PATH_SRATE_HZ / 1e6 / two_pass_msps,
+         fused_msps,
+         100.0 * RADIO_PATH_SRATE_HZ / 1e6 / fused_msps);
+}
+
+static bool radio_path_benchmark(void)
+{
+  struct timeval start, end;
+  double         two_pass_us = 0.0;
+  double         fused_us    = 0.0;
+  double*        timing      = NULL;
+  uint32_t       len         = RADIO_PATH_SF_LEN;
+  float          gain        = srsran_convert_dB_to_amplitude(-3.0f);
+  int16_t*       s           = srsran_vec_i16_malloc(2 * len);
+  cf_t*          cf          = srsran_vec_cf_malloc(len);
+  cf_t*          cf_ref      = srsran_vec_cf_malloc(len);
+  int16_t*       s_ref       = srsran_vec_i16_malloc(2 * len);
+  bool           passed      = true;
+
+  if (!s || !cf || !cf_ref || !s_ref) {
+    return false;
+  }
+
+  printf("\nRadio sample path at %.2f MSamp/s, %d samples:\n", RADIO_PATH_SRATE_HZ / 1e6, len);
+
+  // Receive: int16 from the wire to complex float with the Rx gain
+  for (uint32_t i = 0; i < 2 * len; i++) {
+    s[i] = (int16_t)srsran_random_uniform_int_dist(random_h, INT16_MIN, INT16_MAX);
+  }
+  timing = &two_pass_us;
+  TEST_CALL(srsran_vec_convert_if(s, INT16_MAX, (float*)cf_ref, 2 * len);
+            srsran_vec_sc_prod_cfc(cf_ref, gain, cf_ref, len))
+  timing = &fused_us;
+  TEST_CALL(srsran_vec_convert_scale_sc(s, gain / INT16_MAX, cf, len, len))
+  for (uint32_t i = 0; i < len; i++) {
+    passed = passed && cabsf(cf[i] - cf_ref[i]) < 1e-6f;
+  }
+  radio_path_print("rx sc16 to fc32 with gain", two_pass_us, fused_us);
+
+  // Transmit: complex float with the Tx gain to int16 for the wire, the input must not be modified
+  for (uint32_t i = 0; i < len; i++) {
+    cf_ref[i] = RANDOM_CF();
+  }
+  timing = &two_pass_us;
+  TEST_CALL(srsran_vec_sc_prod_cfc(cf_ref, gain, cf, len);
+            srsran_vec_convert_fi((float*)cf, INT16_MAX, s_ref, 2 * len))
+  timing = &fused_us;
+  TEST_CALL(srsran_vec_convert_scale_cs(cf_ref, gain * INT16_MAX, s, len, len))
+  for (uint32_t i = 0; i < 2 * len; i++) {
+    passed = passed && abs(s[i] - s_ref[i]) <= 1;
+  }
+  radio_path_print("tx fc32 with gain to sc16", two_pass_us, fused_us);
+
+  free(s);
+  free(cf);
+  free(cf_ref);
+  free(s_ref);
+
+  return passed;
+}
+
 int main(int argc, char** argv)
 {
   char     func_names[MAX_FUNCTIONS][32];
@@ -963,6 +1082,14 @@ int main(int argc, char** argv)
         test_srsran_vec_convert_if(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
 
+    passed[func_count][size_count] =
+        test_srsran_vec_convert_scale_sc(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
+    passed[func_count][size_count] =
+        test_srsran_vec_convert_scale_cs(func_names[func_count], &timmings[func_count][size_count], block_size);
+    func_count++;
+
     passed[func_count][size_count] =
         test_srsran_vec_prod_fff(func_names[func_count], &timmings[func_count][size_count], block_size);
     func_count++;
@@ -1119,6 +1246,8 @@ int main(int argc, char** argv)
 
   if (f)
     fclose(f);
+
+  all_passed &= radio_path_benchmark();
   srsran_random_free(random_h);
 
   return (all_passed) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
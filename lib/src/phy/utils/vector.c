@@ -129,6 +129,24 @@ void srsran_vec_convert_conj_cs(const cf_t* x, const float scale, int16_t* z, co
   srsran_vec_convert_conj_cs_simd(x, z, scale, len);
 }
 
+void srsran_vec_convert_scale_sc(const int16_t* x,
+                                 const float    scale,
+                                 cf_t*          z,
+                                 const uint32_t len,
+                                 const uint32_t out_len)
+{
+  srsran_vec_convert_scale_sc_simd(x, z, scale, len, out_len);
+}
+
+void srsran_vec_convert_scale_cs(const cf_t*    x,
+                                 const float    scale,
+                                 int16_t*       z,
+                                 const uint32_t len,
+                                 const uint32_t out_len)
+{
+  srsran_vec_convert_scale_cs_simd(x, z, scale, len, out_len);
+}
+
 void srsran_vec_convert_fb(const float* x, const float scale, int8_t* z, const uint32_t len)
 {
   srsran_vec_convert_fb_simd(x, z, scale, len);
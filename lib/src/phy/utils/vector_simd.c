@@ -471,6 +471,79 @@ void srsran_vec_convert_fi_simd(const float* x, int16_t* z, const float scale, c
   }
 }
 
+void srsran_vec_convert_scale_sc_simd(const int16_t* x, cf_t* z_, const float scale, const int len_, const int out_len_)
+{
+  int       i       = 0;
+  float*    z       = (float*)z_;
+  const int len     = (x) ? len_ * 2 : 0;
+  const int out_len = out_len_ * 2;
+
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
+  simd_f_t s = srsran_simd_f_set1(scale);
+  simd_f_t a, b;
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      srsran_simd_convert_s_2f(srsran_simd_s_load(&x[i]), &a, &b);
+
+      srsran_simd_f_store(&z[i], srsran_simd_f_mul(a, s));
+      srsran_simd_f_store(&z[i + SRSRAN_SIMD_F_SIZE], srsran_simd_f_mul(b, s));
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      srsran_simd_convert_s_2f(srsran_simd_s_loadu(&x[i]), &a, &b);
+
+      srsran_simd_f_storeu(&z[i], srsran_simd_f_mul(a, s));
+      srsran_simd_f_storeu(&z[i + SRSRAN_SIMD_F_SIZE], srsran_simd_f_mul(b, s));
+    }
+  }
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
+
+  for (; i < len; i++) {
+    z[i] = (float)x[i] * scale;
+  }
+
+  if (out_len > len) {
+    memset(&z[len], 0, sizeof(float) * (out_len - len));
+  }
+}
+
+void srsran_vec_convert_scale_cs_simd(const cf_t* x_, int16_t* z, const float scale, const int len_, const int out_len_)
+{
+  int          i       = 0;
+  const float* x       = (const float*)x_;
+  const int    len     = (x) ? len_ * 2 : 0;
+  const int    out_len = out_len_ * 2;
+
+#if SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE
+  simd_f_t s = srsran_simd_f_set1(scale);
+  if (SRSRAN_IS_ALIGNED(x) && SRSRAN_IS_ALIGNED(z)) {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a = srsran_simd_f_mul(srsran_simd_f_load(&x[i]), s);
+      simd_f_t b = srsran_simd_f_mul(srsran_simd_f_load(&x[i + SRSRAN_SIMD_F_SIZE]), s);
+
+      srsran_simd_s_store(&z[i], srsran_simd_convert_2f_s(a, b));
+    }
+  } else {
+    for (; i < len - SRSRAN_SIMD_S_SIZE + 1; i += SRSRAN_SIMD_S_SIZE) {
+      simd_f_t a = srsran_simd_f_mul(srsran_simd_f_loadu(&x[i]), s);
+      simd_f_t b = srsran_simd_f_mul(srsran_simd_f_loadu(&x[i + SRSRAN_SIMD_F_SIZE]), s);
+
+      srsran_simd_s_storeu(&z[i], srsran_simd_convert_2f_s(a, b));
+    }
+  }
+#endif /* SRSRAN_SIMD_F_SIZE && SRSRAN_SIMD_S_SIZE */
+
+  // Saturate as the SIMD conversion does
+  for (; i < len; i++) {
+    float v = x[i] * scale;
+    z[i]    = (int16_t)((v > INT16_MAX) ? INT16_MAX : ((v < INT16_MIN) ? INT16_MIN : v));
+  }
+
+  if (out_len > len) {
+    memset(&z[len], 0, sizeof(int16_t) * (out_len - len));
+  }
+}
+
 void srsran_vec_convert_conj_cs_simd(const cf_t* x_, int16_t* z, const float scale, const int len_)
 {
   int i = 0;
@@ -348,6 +348,11 @@ bool radio::rx_now(rf_buffer_interface& buffer, rf_timestamp_interface& rxd_time
     ret &= rx_dev(device_idx, buffer_rx, rxd_time.get_ptr(device_idx));
   }
 
+  // Account the received sample time, compared against the wall-clock time to report the speed-up
+  if (std::isnormal(cur_rx_srate)) {
+    rx_time_ns += (uint64_t)(nof_samples * 1e9 / cur_rx_srate);
+  }
+
   // Perform decimation
   if (ratio > 1) {
     for (uint32_t ch = 0; ch < nof_channels; ch++) {
@@ -1040,6 +1045,16 @@ srsran_rf_info_t* radio::get_info()
 bool radio::get_metrics(rf_metrics_t* metrics)
 {
   std::lock_guard<std::mutex> lock(metrics_mutex);
+
+  // Speed-up of the sample time over the wall-clock time, only meaningful from the second report onwards
+  auto     now        = std::chrono::steady_clock::now();
+  uint64_t sample_ns  = rx_time_ns.exchange(0);
+  uint64_t elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - metrics_tp).count();
+  if (metrics_tp != std::chrono::steady_clock::time_point{} && elapsed_ns > 0) {
+    rf_metrics.rf_speedup = (float)sample_ns / (float)elapsed_ns;
+  }
+  metrics_tp = now;
+
   *metrics   = rf_metrics;
   rf_metrics = {};
   return true;
@@ -21,6 +21,7 @@
 
 #include "backend_worker.h"
 #include "srsran/srslog/sink.h"
+#include <limits>
 
 using namespace srslog;
 
@@ -28,6 +29,7 @@ void backend_worker::stop()
 {
   // Signal the worker thread to stop.
   running_flag = false;
+  queue.wake_up();
   if (worker_thread.joinable()) {
     worker_thread.join();
   }
@@ -94,27 +96,35 @@ void backend_worker::start(backend_priority priority)
 
 void backend_worker::do_work()
 {
-  /// This period defines the time the worker will sleep while waiting for new entries. This is required to check the
-  /// termination variable periodically.
-  constexpr std::chrono::microseconds sleep_period{100};
-
+  /// Maximum time the worker will block while waiting for new entries. Producers wake up the worker as soon as an entry
+  /// is pushed, the timeout only bounds the time to check the termination variable.
+  constexpr unsigned wait_timeout_ms = 100;
+  /// Maximum number of entries processed from a thread queue before moving to the next one.
+  constexpr size_t batch_size = 32;
+  /// Interval between reports of discarded entries.
+  constexpr std::chrono::seconds report_interval(1);
+
+  auto process     = [this](detail::log_entry&& entry) { process_log_entry(std::move(entry)); };
+  auto next_report = std::chrono::steady_clock::now() + report_interval;
   while (running_flag) {
-    auto item = queue.try_pop();
+    size_t count = queue.pop_round(process, batch_size);
 
-    // Spin while there are no new entries to process.
-    if (!item.first) {
-      std::this_thread::sleep_for(sleep_period);
-      continue;
+    auto now = std::chrono::steady_clock::now();
+    if (now >= next_report) {
+      report_dropped_entries();
+      next_report = now + report_interval;
     }
 
-    report_queue_on_full_once();
-
-    process_log_entry(std::move(item.second));
+    // Go back to sleep while there are no new entries to process.
+    if (count == 0) {
+      queue.wait(wait_timeout_ms);
+    }
   }
 
   // When we reach here, the thread is about to terminate, last chance to
   // process the last log entries.
   process_outstanding_entries();
+  report_dropped_entries();
 }
 
 /// Executes the flush command over all registered sinks.
@@ -130,8 +140,10 @@ static void process_flush_command(const detail::flush_backend_cmd& cmd)
 
 void backend_worker::process_log_entry(detail::log_entry&& entry)
 {
-  // Check first for flush commands.
+  // Check first for flush commands. Entries pushed by other threads before the flush request may still be waiting in
+  // their queues, process them before flushing the sinks.
   if (entry.flush_cmd) {
+    drain_queues();
     process_flush_command(*entry.flush_cmd);
     return;
   }
@@ -151,18 +163,16 @@ void backend_worker::process_log_entry(detail::log_entry&& entry)
   }
 }
 
+void backend_worker::drain_queues()
+{
+  while (queue.pop_round([this](detail::log_entry&& entry) { process_log_entry(std::move(entry)); },
+                         std::numeric_limits<size_t>::max())) {
+  }
+}
+
 void backend_worker::process_outstanding_entries()
 {
   assert(!running_flag && "Cannot process outstanding entries while thread is running");
 
-  while (true) {
-    auto item = queue.try_pop();
-
-    // Check if the queue is empty.
-    if (!item.first) {
-      break;
-    }
-
-    process_log_entry(std::move(item.second));
-  }
+  drain_queues();
 }
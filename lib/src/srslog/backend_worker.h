@@ -24,7 +24,7 @@
 
 #include "srsran/srslog/detail/log_entry.h"
 #include "srsran/srslog/detail/support/dyn_arg_store_pool.h"
-#include "srsran/srslog/detail/support/work_queue.h"
+#include "srsran/srslog/detail/support/thread_queue_set.h"
 #include "srsran/srslog/shared_types.h"
 #include <mutex>
 #include <thread>
@@ -32,11 +32,12 @@
 namespace srslog {
 
 /// The backend worker runs in a secondary thread a routine that endlessly pops
-/// log entries from a work queue and dispatches them to the selected sinks.
+/// log entries from the per thread work queues and dispatches them to the
+/// selected sinks.
 class backend_worker
 {
 public:
-  backend_worker(detail::work_queue<detail::log_entry>& queue, detail::dyn_arg_store_pool& arg_pool) :
+  backend_worker(detail::thread_queue_set<detail::log_entry>& queue, detail::dyn_arg_store_pool& arg_pool) :
     queue(queue), arg_pool(arg_pool), running_flag(false)
   {}
 
@@ -90,30 +91,35 @@ private:
   /// Processes the log entry.
   void process_log_entry(detail::log_entry&& entry);
 
-  /// Processes outstanding entries in the queue until it gets empty.
+  /// Processes entries from all the queues until they get empty.
+  void drain_queues();
+
+  /// Processes outstanding entries in the queues until they get empty.
   void process_outstanding_entries();
 
-  /// Checks the current size of the queue reporting an error message if it is
-  /// about to reach its maximum capacity.
-  /// Error message is only reported once to avoid spamming.
-  void report_queue_on_full_once()
+  /// Reports the number of log entries discarded by each producer thread since
+  /// the last report because its queue was full.
+  void report_dropped_entries()
   {
-    if (queue.is_almost_full()) {
-      err_handler(fmt::format("The backend queue size is about to reach its maximum "
-                              "capacity of {} elements, new log entries will get "
-                              "discarded.\nConsider increasing the queue capacity.",
-                              queue.get_capacity()));
-      err_handler = [](const std::string&) {};
-    }
+    queue.report_drops([this](const detail::thread_queue_set<detail::log_entry>::drop_report& report) {
+      err_handler(fmt::format("The log queue of thread \"{}\" (tid {}) reached its maximum capacity of {} "
+                              "elements, {} new log entries have been discarded ({} in total).\nConsider "
+                              "increasing the queue capacity.",
+                              report.thread_name,
+                              report.thread_id,
+                              queue.get_capacity(),
+                              report.nof_new_dropped,
+                              report.nof_dropped));
+    });
   }
 
   /// Establishes the specified thread priority for the calling thread.
   void set_thread_priority(backend_priority priority) const;
 
 private:
-  detail::work_queue<detail::log_entry>& queue;
-  detail::dyn_arg_store_pool&            arg_pool;
-  detail::shared_variable<bool>          running_flag;
+  detail::thread_queue_set<detail::log_entry>& queue;
+  detail::dyn_arg_store_pool&                  arg_pool;
+  detail::shared_variable<bool>                running_flag;
   error_handler      err_handler = [](const std::string& error) { fmt::print(stderr, "srsLog error - {}\n", error); };
   std::once_flag     start_once_flag;
   std::thread        worker_thread;
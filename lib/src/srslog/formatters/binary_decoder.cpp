@@ -0,0 +1,270 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "binary_decoder.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include <cstring>
+
+using namespace srslog;
+
+detail::error_string binary_decoder::read_header()
+{
+  char     magic[sizeof(binary_log::magic)];
+  uint32_t version;
+  uint32_t byte_order_mark;
+
+  if (!read(magic) || !read(version) || !read(byte_order_mark)) {
+    return "Truncated binary log file header";
+  }
+  if (std::memcmp(magic, binary_log::magic, sizeof(magic)) != 0) {
+    return "Not a binary log file";
+  }
+  if (version != binary_log::version) {
+    return fmt::format("Unsupported binary log file version {}", version);
+  }
+  if (byte_order_mark != binary_log::byte_order_mark) {
+    return "Binary log file byte order does not match the host";
+  }
+
+  return {};
+}
+
+bool binary_decoder::read_string(std::string& str)
+{
+  uint32_t length;
+  if (!read(length)) {
+    return false;
+  }
+  str.resize(length);
+  return read(&str[0], length);
+}
+
+detail::error_string binary_decoder::decode_next(fmt::memory_buffer& buffer, bool& finished)
+{
+  finished = false;
+  while (true) {
+    char type;
+    if (!read(type)) {
+      finished = true;
+      return {};
+    }
+
+    switch (type) {
+      case binary_log::string_record:
+        if (auto err = decode_string_record(finished)) {
+          return err;
+        }
+        if (finished) {
+          return {};
+        }
+        break;
+      case binary_log::entry_record:
+        return decode_entry_record(buffer, finished);
+      case binary_log::text_record:
+        return decode_text_record(buffer, finished);
+      default:
+        return fmt::format(
+            "Invalid record type 0x{:02x} at offset {}", static_cast<uint8_t>(type), std::ftell(file) - 1);
+    }
+  }
+}
+
+detail::error_string binary_decoder::decode_string_record(bool& finished)
+{
+  uint32_t    id;
+  std::string str;
+  if (!read(id) || !read_string(str)) {
+    finished = true;
+    return {};
+  }
+
+  if (id == binary_log::no_string) {
+    return "Invalid string record id";
+  }
+  if (id >= strings.size()) {
+    strings.resize(id + 1);
+  }
+  strings[id] = {true, std::move(str)};
+
+  return {};
+}
+
+detail::error_string binary_decoder::decode_text_record(fmt::memory_buffer& buffer, bool& finished)
+{
+  std::string str;
+  if (!read_string(str)) {
+    finished = true;
+    return {};
+  }
+  buffer.append(str.data(), str.data() + str.size());
+
+  return {};
+}
+
+detail::error_string binary_decoder::decode_arg(bool& finished)
+{
+  binary_log::arg_type type;
+  if (!read(type)) {
+    finished = true;
+    return {};
+  }
+
+  // Arguments are pushed with the exact type seen by the original format call, so that printf conversions behave
+  // the same way.
+  bool success = false;
+  switch (type) {
+    case binary_log::arg_type::int32:
+      success = read_arg<int>();
+      break;
+    case binary_log::arg_type::uint32:
+      success = read_arg<unsigned>();
+      break;
+    case binary_log::arg_type::int64:
+      success = read_arg<long long>();
+      break;
+    case binary_log::arg_type::uint64:
+      success = read_arg<unsigned long long>();
+      break;
+    case binary_log::arg_type::character:
+      success = read_arg<char>();
+      break;
+    case binary_log::arg_type::f32:
+      success = read_arg<float>();
+      break;
+    case binary_log::arg_type::f64:
+      success = read_arg<double>();
+      break;
+    case binary_log::arg_type::f80:
+      success = read_arg<long double>();
+      break;
+    case binary_log::arg_type::boolean: {
+      uint8_t value;
+      if ((success = read(value))) {
+        store.push_back(static_cast<bool>(value));
+      }
+      break;
+    }
+    case binary_log::arg_type::ptr: {
+      uint64_t value;
+      if ((success = read(value))) {
+        store.push_back(reinterpret_cast<const void*>(value));
+      }
+      break;
+    }
+    case binary_log::arg_type::cstring:
+      cstring_args.emplace_back();
+      if ((success = read_string(cstring_args.back()))) {
+        store.push_back(cstring_args.back().c_str());
+      }
+      break;
+    case binary_log::arg_type::string: {
+      std::string value;
+      if ((success = read_string(value))) {
+        store.push_back(std::move(value));
+      }
+      break;
+    }
+    default:
+      return fmt::format("Invalid argument type {}", static_cast<unsigned>(type));
+  }
+
+  finished = !success;
+  return {};
+}
+
+detail::error_string binary_decoder::decode_entry_record(fmt::memory_buffer& buffer, bool& finished)
+{
+  uint64_t timestamp_ns;
+  uint32_t name_id;
+  uint8_t  flags;
+
+  detail::log_entry_metadata metadata = {};
+  if (!read(timestamp_ns) || !read(name_id) || !read(metadata.log_tag) || !read(flags)) {
+    finished = true;
+    return {};
+  }
+
+  metadata.tp = std::chrono::high_resolution_clock::time_point(
+      std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(std::chrono::nanoseconds(timestamp_ns)));
+
+  if (name_id != binary_log::no_string) {
+    const std::string* name = find_string(name_id);
+    if (!name) {
+      return fmt::format("Unknown log name id {}", name_id);
+    }
+    metadata.log_name = *name;
+  }
+
+  if (flags & binary_log::flag_context) {
+    metadata.context.enabled = true;
+    if (!read(metadata.context.value)) {
+      finished = true;
+      return {};
+    }
+  }
+
+  if (flags & binary_log::flag_fmtstr) {
+    uint32_t fmtstr_id;
+    if (!read(fmtstr_id)) {
+      finished = true;
+      return {};
+    }
+    const std::string* fmtstr = find_string(fmtstr_id);
+    if (!fmtstr) {
+      return fmt::format("Unknown format string id {}", fmtstr_id);
+    }
+    metadata.fmtstring = fmtstr->c_str();
+  }
+
+  store.clear();
+  cstring_args.clear();
+  if (flags & binary_log::flag_args) {
+    uint8_t nof_args;
+    if (!read(nof_args)) {
+      finished = true;
+      return {};
+    }
+    for (unsigned i = 0; i != nof_args; ++i) {
+      auto err = decode_arg(finished);
+      if (err || finished) {
+        return err;
+      }
+    }
+    metadata.store = &store;
+  }
+
+  if (flags & binary_log::flag_hex_dump) {
+    uint32_t length;
+    if (!read(length)) {
+      finished = true;
+      return {};
+    }
+    metadata.hex_dump.resize(length);
+    if (!read(metadata.hex_dump.data(), length)) {
+      finished = true;
+      return {};
+    }
+  }
+
+  formatter.format(std::move(metadata), buffer);
+
+  return {};
+}
@@ -0,0 +1,106 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_BINARY_DECODER_H
+#define SRSLOG_BINARY_DECODER_H
+
+#include "binary_formatter.h"
+#include "srsran/srslog/bundled/fmt/printf.h"
+#include "srsran/srslog/detail/support/error_string.h"
+#include <cstdio>
+#include <deque>
+
+namespace srslog {
+
+/// Decodes the records of a binary log file written by the binary formatter, rendering each log entry in the same
+/// text format produced by the text formatter.
+class binary_decoder
+{
+public:
+  /// Builds a decoder that reads records from the specified file, which should be positioned at the file header.
+  explicit binary_decoder(std::FILE* file) : file(file) {}
+
+  binary_decoder(const binary_decoder& other) = delete;
+  binary_decoder& operator=(const binary_decoder& other) = delete;
+
+  /// Reads and validates the file header.
+  detail::error_string read_header();
+
+  /// Decodes the next log entry, appending its text representation to the buffer. Sets finished to true when the end
+  /// of the file has been reached, a file cut in the middle of a record is treated as finished.
+  detail::error_string decode_next(fmt::memory_buffer& buffer, bool& finished);
+
+private:
+  /// Reads the specified number of bytes, returns false on end of file.
+  bool read(void* dst, size_t size) { return std::fread(dst, 1, size, file) == size; }
+
+  template <typename T>
+  bool read(T& value)
+  {
+    return read(&value, sizeof(T));
+  }
+
+  /// Reads an argument of type T and pushes it into the argument store.
+  template <typename T>
+  bool read_arg()
+  {
+    T value;
+    if (!read(value)) {
+      return false;
+    }
+    store.push_back(value);
+    return true;
+  }
+
+  /// Reads a length prefixed string.
+  bool read_string(std::string& str);
+
+  /// Decodes a string record.
+  detail::error_string decode_string_record(bool& finished);
+
+  /// Decodes an entry record.
+  detail::error_string decode_entry_record(fmt::memory_buffer& buffer, bool& finished);
+
+  /// Decodes a text record.
+  detail::error_string decode_text_record(fmt::memory_buffer& buffer, bool& finished);
+
+  /// Decodes the next argument of an entry record into the argument store.
+  detail::error_string decode_arg(bool& finished);
+
+  /// Returns the interned string with the specified id, or nullptr if it is unknown.
+  const std::string* find_string(uint32_t id) const
+  {
+    return (id < strings.size() && strings[id].first) ? &strings[id].second : nullptr;
+  }
+
+private:
+  std::FILE*                                         file;
+  text_formatter                                     formatter;
+  std::vector<std::pair<bool, std::string> >         strings;
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+
+  /// Storage of the C string arguments of the current entry, the argument store only keeps pointers to them.
+  std::deque<std::string> cstring_args;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_DECODER_H
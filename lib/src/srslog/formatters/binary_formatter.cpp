@@ -0,0 +1,223 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "binary_formatter.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include <cstring>
+#include <limits>
+
+using namespace srslog;
+
+std::unique_ptr<log_formatter> binary_formatter::clone() const
+{
+  // Interned strings belong to the output of this instance, clones always start with an empty table.
+  return std::unique_ptr<log_formatter>(new binary_formatter);
+}
+
+/// Appends the raw bytes of the input value to the buffer.
+template <typename T>
+static void put(T value, fmt::memory_buffer& buffer)
+{
+  const char* p = reinterpret_cast<const char*>(&value);
+  buffer.append(p, p + sizeof(T));
+}
+
+/// Appends a length prefixed string to the buffer.
+static void put_string(fmt::string_view str, fmt::memory_buffer& buffer)
+{
+  put(static_cast<uint32_t>(str.size()), buffer);
+  buffer.append(str.data(), str.data() + str.size());
+}
+
+namespace {
+
+/// Format argument visitor that appends the type and raw value of the argument to the buffer. Returns false for
+/// argument types without a binary encoding.
+class arg_encoder
+{
+  fmt::memory_buffer& buffer;
+
+  template <typename T>
+  bool encode(binary_log::arg_type type, T value)
+  {
+    put(type, buffer);
+    put(value, buffer);
+    return true;
+  }
+
+public:
+  explicit arg_encoder(fmt::memory_buffer& buffer) : buffer(buffer) {}
+
+  bool operator()(int v) { return encode(binary_log::arg_type::int32, v); }
+  bool operator()(unsigned v) { return encode(binary_log::arg_type::uint32, v); }
+  bool operator()(long long v) { return encode(binary_log::arg_type::int64, v); }
+  bool operator()(unsigned long long v) { return encode(binary_log::arg_type::uint64, v); }
+  bool operator()(bool v) { return encode(binary_log::arg_type::boolean, static_cast<uint8_t>(v)); }
+  bool operator()(char v) { return encode(binary_log::arg_type::character, v); }
+  bool operator()(float v) { return encode(binary_log::arg_type::f32, v); }
+  bool operator()(double v) { return encode(binary_log::arg_type::f64, v); }
+  bool operator()(long double v) { return encode(binary_log::arg_type::f80, v); }
+  bool operator()(const void* v) { return encode(binary_log::arg_type::ptr, reinterpret_cast<uint64_t>(v)); }
+  bool operator()(const char* v)
+  {
+    put(binary_log::arg_type::cstring, buffer);
+    put_string(v, buffer);
+    return true;
+  }
+  bool operator()(fmt::string_view v)
+  {
+    put(binary_log::arg_type::string, buffer);
+    put_string(v, buffer);
+    return true;
+  }
+
+  /// Custom types and 128 bit integers are not supported.
+  template <typename T>
+  bool operator()(T)
+  {
+    return false;
+  }
+};
+
+} // namespace
+
+uint32_t binary_formatter::intern_fmtstr(const char* fmtstr, fmt::memory_buffer& buffer)
+{
+  auto it = fmtstr_table.find(fmtstr);
+  if (it != fmtstr_table.end() && it->second.str == fmtstr) {
+    return it->second.id;
+  }
+
+  interned_fmtstr& entry = fmtstr_table[fmtstr];
+  entry.id               = next_string_id++;
+  entry.str              = fmtstr;
+
+  put(binary_log::string_record, buffer);
+  put(entry.id, buffer);
+  put_string(entry.str, buffer);
+  return entry.id;
+}
+
+uint32_t binary_formatter::intern_name(const std::string& name, fmt::memory_buffer& buffer)
+{
+  if (name.empty()) {
+    return binary_log::no_string;
+  }
+
+  auto it = name_table.find(name);
+  if (it != name_table.end()) {
+    return it->second;
+  }
+
+  uint32_t id = next_string_id++;
+  name_table.emplace(name, id);
+
+  put(binary_log::string_record, buffer);
+  put(id, buffer);
+  put_string(name, buffer);
+  return id;
+}
+
+size_t binary_formatter::begin_text_record(fmt::memory_buffer& buffer)
+{
+  put(binary_log::text_record, buffer);
+  size_t length_offset = buffer.size();
+  put(uint32_t(0), buffer);
+  return length_offset;
+}
+
+void binary_formatter::end_text_record(size_t length_offset, fmt::memory_buffer& buffer)
+{
+  auto length = static_cast<uint32_t>(buffer.size() - length_offset - sizeof(uint32_t));
+  std::memcpy(buffer.data() + length_offset, &length, sizeof(length));
+}
+
+void binary_formatter::format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer)
+{
+  // String records go first so that they precede the entry that references them.
+  uint32_t name_id   = intern_name(metadata.log_name, buffer);
+  uint32_t fmtstr_id = (metadata.fmtstring) ? intern_fmtstr(metadata.fmtstring, buffer) : binary_log::no_string;
+
+  size_t entry_offset = buffer.size();
+
+  uint8_t flags = 0;
+  flags |= (metadata.context.enabled) ? binary_log::flag_context : 0;
+  flags |= (metadata.fmtstring) ? binary_log::flag_fmtstr : 0;
+  flags |= (metadata.fmtstring && metadata.store) ? binary_log::flag_args : 0;
+  flags |= (!metadata.hex_dump.empty()) ? binary_log::flag_hex_dump : 0;
+
+  auto timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(metadata.tp.time_since_epoch()).count();
+
+  put(binary_log::entry_record, buffer);
+  put(static_cast<uint64_t>(timestamp_ns), buffer);
+  put(name_id, buffer);
+  put(metadata.log_tag, buffer);
+  put(flags, buffer);
+  if (flags & binary_log::flag_context) {
+    put(metadata.context.value, buffer);
+  }
+  if (flags & binary_log::flag_fmtstr) {
+    put(fmtstr_id, buffer);
+  }
+
+  if (flags & binary_log::flag_args) {
+    fmt::basic_format_args<fmt::basic_printf_context_t<char> > args(*metadata.store);
+    size_t                                                     nof_args_offset = buffer.size();
+    put(uint8_t(0), buffer);
+
+    arg_encoder encoder(buffer);
+    unsigned    nof_args = 0;
+    for (auto arg = args.get(0); arg; arg = args.get(++nof_args)) {
+      if (nof_args == std::numeric_limits<uint8_t>::max() || !fmt::visit_format_arg(encoder, arg)) {
+        // Fall back to the text representation of the entry.
+        buffer.resize(entry_offset);
+        size_t length_offset = begin_text_record(buffer);
+        text_formatter::format(std::move(metadata), buffer);
+        end_text_record(length_offset, buffer);
+        return;
+      }
+    }
+    buffer.data()[nof_args_offset] = static_cast<char>(nof_args);
+  }
+
+  if (flags & binary_log::flag_hex_dump) {
+    put(static_cast<uint32_t>(metadata.hex_dump.size()), buffer);
+    const char* p = reinterpret_cast<const char*>(metadata.hex_dump.data());
+    buffer.append(p, p + metadata.hex_dump.size());
+  }
+}
+
+void binary_formatter::format_context_begin(const detail::log_entry_metadata& md,
+                                            fmt::string_view                  ctx_name,
+                                            unsigned                          size,
+                                            fmt::memory_buffer&               buffer)
+{
+  ctx_length_offset = begin_text_record(buffer);
+  text_formatter::format_context_begin(md, ctx_name, size, buffer);
+}
+
+void binary_formatter::format_context_end(const detail::log_entry_metadata& md,
+                                          fmt::string_view                  ctx_name,
+                                          fmt::memory_buffer&               buffer)
+{
+  text_formatter::format_context_end(md, ctx_name, buffer);
+  end_text_record(ctx_length_offset, buffer);
+}
@@ -0,0 +1,124 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_BINARY_FORMATTER_H
+#define SRSLOG_BINARY_FORMATTER_H
+
+#include "text_formatter.h"
+#include <unordered_map>
+
+namespace srslog {
+
+/// Binary log file layout shared by the binary formatter and decoder. All fields are stored in host byte order, the
+/// file header carries a byte order mark so that the decoder can reject files coming from a different architecture.
+///
+/// File header:  magic[8] | u32 version | u32 byte order mark
+/// String record: 'S' | u32 id | u32 length | bytes
+/// Entry record:  'E' | u64 timestamp ns | u32 name id | u8 tag | u8 flags | [u32 context value] | [u32 format id]
+///                    | [u8 nof args | args...] | [u32 hex dump length | bytes]
+/// Text record:   'T' | u32 length | bytes (entry already rendered in text format)
+///
+/// Each argument is encoded as its type followed by its raw value, strings are prefixed by a u32 length.
+namespace binary_log {
+
+constexpr char     magic[8]        = {'S', 'R', 'S', 'L', 'O', 'G', 'B', 'N'};
+constexpr uint32_t version         = 1;
+constexpr uint32_t byte_order_mark = 0x01020304;
+constexpr size_t   header_size     = sizeof(magic) + 2 * sizeof(uint32_t);
+
+/// Record types.
+constexpr char string_record = 'S';
+constexpr char entry_record  = 'E';
+constexpr char text_record   = 'T';
+
+/// Entry record flags.
+constexpr uint8_t flag_context  = 1u << 0;
+constexpr uint8_t flag_fmtstr   = 1u << 1;
+constexpr uint8_t flag_args     = 1u << 2;
+constexpr uint8_t flag_hex_dump = 1u << 3;
+
+/// Argument types.
+enum class arg_type : uint8_t { int32, uint32, int64, uint64, boolean, character, f32, f64, f80, cstring, string, ptr };
+
+/// String id used for entries without a log name.
+constexpr uint32_t no_string = 0;
+
+} // namespace binary_log
+
+/// Binary formatter implementation class.
+/// Log entries are encoded as compact binary records holding the timestamp, the interned log name and format string
+/// and the raw format arguments, deferring the text rendering to the offline decoder. Interned strings are emitted
+/// inline as string records the first time they are used. Entries that can not be represented in binary form
+/// (contexts, custom argument types) are stored as text records rendered with the text formatter.
+class binary_formatter : public text_formatter
+{
+public:
+  std::unique_ptr<log_formatter> clone() const override;
+
+  void format(detail::log_entry_metadata&& metadata, fmt::memory_buffer& buffer) override;
+
+  /// Forgets all the interned strings, so that they get emitted again on their next use. Must be called whenever the
+  /// output starts a new file.
+  void reset_string_table()
+  {
+    fmtstr_table.clear();
+    name_table.clear();
+    next_string_id = binary_log::no_string + 1;
+  }
+
+private:
+  void format_context_begin(const detail::log_entry_metadata& md,
+                            fmt::string_view                  ctx_name,
+                            unsigned                          size,
+                            fmt::memory_buffer&               buffer) override;
+
+  void format_context_end(const detail::log_entry_metadata& md,
+                          fmt::string_view                  ctx_name,
+                          fmt::memory_buffer&               buffer) override;
+
+  /// Returns the id of the specified format string, emitting its string record if it is new.
+  uint32_t intern_fmtstr(const char* fmtstr, fmt::memory_buffer& buffer);
+
+  /// Returns the id of the specified log name, emitting its string record if it is new.
+  uint32_t intern_name(const std::string& name, fmt::memory_buffer& buffer);
+
+  /// Starts a text record, returning the offset of its length field in the buffer.
+  static size_t begin_text_record(fmt::memory_buffer& buffer);
+
+  /// Finishes the text record started at the specified length field offset.
+  static void end_text_record(size_t length_offset, fmt::memory_buffer& buffer);
+
+private:
+  struct interned_fmtstr {
+    uint32_t    id;
+    std::string str;
+  };
+
+  /// Format strings are keyed by address, the cached copy guards against different strings sharing an address.
+  std::unordered_map<const char*, interned_fmtstr> fmtstr_table;
+  std::unordered_map<std::string, uint32_t>        name_table;
+  uint32_t                                         next_string_id    = binary_log::no_string + 1;
+  size_t                                           ctx_length_offset = 0;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FORMATTER_H
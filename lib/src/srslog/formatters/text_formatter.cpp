@@ -32,7 +32,7 @@ std::unique_ptr<log_formatter> text_formatter::clone() const
 
 /// Formats into a hex dump a range of elements, storing the result in the input
 /// buffer.
-static void format_hex_dump(const std::vector<uint8_t>& v, fmt::memory_buffer& buffer)
+static void format_hex_dump(const detail::hex_dump_buffer& v, fmt::memory_buffer& buffer)
 {
   const size_t elements_per_line = 16;
 
@@ -52,18 +52,25 @@ public:
 
   fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() override { return arg_pool.alloc(); }
 
+  detail::hex_dump_buffer alloc_hex_dump(const uint8_t* data, size_t len) override { return hex_pool.alloc(data, len); }
+
   bool is_running() const override { return worker.is_running(); }
 
   /// Installs the specified error handler into the backend worker.
   void set_error_handler(error_handler err_handler) { worker.set_error_handler(std::move(err_handler)); }
 
+  /// Sets the capacity of the log queues of the threads that log for the first time from now on.
+  void set_thread_queue_capacity(size_t capacity) { queue.set_capacity(capacity); }
+
   /// Stops the backend worker thread.
   void stop() { worker.stop(); }
 
 private:
-  detail::work_queue<detail::log_entry> queue;
-  detail::dyn_arg_store_pool            arg_pool;
-  backend_worker                        worker{queue, arg_pool};
+  // The hex dump pool has to outlive any entry left in the queue.
+  detail::hex_dump_pool                       hex_pool;
+  detail::thread_queue_set<detail::log_entry> queue;
+  detail::dyn_arg_store_pool                  arg_pool;
+  backend_worker                              worker{queue, arg_pool};
 };
 
 } // namespace srslog
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_BINARY_FILE_SINK_H
+#define SRSLOG_BINARY_FILE_SINK_H
+
+#include "../formatters/binary_formatter.h"
+#include "file_utils.h"
+#include "srsran/srslog/sink.h"
+#include <cstring>
+
+namespace srslog {
+
+/// This sink implementation writes binary log records into files, see the binary_formatter class for the record
+/// layout. Each file starts with a binary log file header. Includes the optional feature of file rotation: a new file
+/// is created when file size exceeds an established threshold. Rotation takes place between entries and resets the
+/// string table of the formatter, so that every file can be decoded on its own.
+class binary_file_sink : public sink
+{
+public:
+  binary_file_sink(std::string name, size_t max_size, bool force_flush) :
+    sink(std::unique_ptr<log_formatter>(new binary_formatter)),
+    max_size((max_size == 0) ? 0 : std::max<size_t>(max_size, 4 * 1024)),
+    force_flush(force_flush),
+    base_filename(std::move(name))
+  {}
+
+  binary_file_sink(const binary_file_sink& other) = delete;
+  binary_file_sink& operator=(const binary_file_sink& other) = delete;
+
+  detail::error_string write(detail::memory_buffer buffer) override
+  {
+    // Create a new file the first time we hit this method.
+    if (file_index == 0) {
+      assert(!handler && "No handler should be created yet");
+      if (auto err_str = create_file()) {
+        return err_str;
+      }
+    }
+
+    // Do not bother doing any work when the file was closed on a previous error.
+    if (!handler) {
+      return {};
+    }
+
+    if (auto err_str = handler.write(buffer)) {
+      return err_str;
+    }
+    current_size += buffer.size();
+
+    if (force_flush) {
+      if (auto err_str = handler.flush()) {
+        return err_str;
+      }
+    }
+
+    // Rotate once the entry has been completely written, as it may reference strings defined in the current file.
+    if (max_size && current_size >= max_size) {
+      return create_file();
+    }
+
+    return {};
+  }
+
+  detail::error_string flush() override { return handler.flush(); }
+
+private:
+  /// Creates a new file, writes the file header and increments the file index counter.
+  detail::error_string create_file()
+  {
+    if (auto err_str = handler.create(file_utils::build_filename_with_index(base_filename, file_index++))) {
+      return err_str;
+    }
+
+    // Strings interned in the previous file have to be emitted again.
+    static_cast<binary_formatter&>(get_formatter()).reset_string_table();
+
+    char header[binary_log::header_size];
+    std::memcpy(header, binary_log::magic, sizeof(binary_log::magic));
+    std::memcpy(header + sizeof(binary_log::magic), &binary_log::version, sizeof(uint32_t));
+    std::memcpy(header + sizeof(binary_log::magic) + sizeof(uint32_t), &binary_log::byte_order_mark, sizeof(uint32_t));
+    current_size = sizeof(header);
+
+    return handler.write(detail::memory_buffer(header, sizeof(header)));
+  }
+
+private:
+  const size_t      max_size;
+  const bool        force_flush;
+  const std::string base_filename;
+  file_utils::file  handler;
+  size_t            current_size = 0;
+  uint32_t          file_index   = 0;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_BINARY_FILE_SINK_H
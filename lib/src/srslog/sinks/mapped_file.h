@@ -0,0 +1,362 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_MAPPED_FILE_H
+#define SRSLOG_MAPPED_FILE_H
+
+#include "file_utils.h"
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+namespace srslog {
+
+namespace file_utils {
+
+/// This class writes sequentially into a file through a memory mapped window, disabling itself when it encounters an
+/// error. The file grows in preallocated segments of a fixed size, and only the segment being written is mapped, so
+/// that writing is a plain memory copy.
+/// Everything that may block on the disk is offloaded to a helper thread: the next segment is extended, preallocated
+/// and prefaulted ahead of time, completed segments are unmapped after starting their writeback asynchronously, and
+/// segments that have already been written back are dropped from the page cache so that log data does not pile up in
+/// memory. Closed files are trimmed to their written size by the helper thread as well.
+class mapped_file
+{
+public:
+  explicit mapped_file(size_t segment_size)
+  {
+    size_t page_size   = ::sysconf(_SC_PAGESIZE);
+    this->segment_size = std::max<size_t>(page_size, (segment_size + page_size - 1) / page_size * page_size);
+    helper_thread      = std::thread([this]() { run_helper(); });
+  }
+
+  mapped_file(const mapped_file& other) = delete;
+  mapped_file& operator=(const mapped_file& other) = delete;
+
+  ~mapped_file()
+  {
+    close();
+    {
+      std::lock_guard<std::mutex> lock(m);
+      stop_helper = true;
+    }
+    cvar.notify_all();
+    helper_thread.join();
+  }
+
+  explicit operator bool() const { return fd != -1; }
+
+  /// Returns the path of the file.
+  const std::string& get_path() const { return path; }
+
+  /// Returns the number of bytes written into the file.
+  size_t get_size() const { return size; }
+
+  /// Returns the error that closed the last file, if any.
+  const detail::error_string& get_error() const { return error; }
+
+  /// Creates a new file in the specified path by previously closing any opened file.
+  detail::error_string create(const std::string& new_path)
+  {
+    close();
+    error = {};
+
+    fd = ::open(new_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd == -1) {
+      return format_error(fmt::format("Unable to create log file \"{}\"", new_path), errno);
+    }
+    path = new_path;
+
+    // The first segment is mapped here, the following ones are prepared in advance by the helper thread.
+    segment_info first = prepare_segment(fd, 0);
+    if (first.error) {
+      ::close(fd);
+      fd = -1;
+      path.clear();
+      error = first.error;
+      return error;
+    }
+    segment        = first.ptr;
+    segment_index  = 0;
+    segment_offset = 0;
+    request_next_segment();
+
+    return {};
+  }
+
+  /// Writes the provided memory buffer into an open file, otherwise returns the error that closed the file, if any.
+  detail::error_string write(detail::memory_buffer buffer)
+  {
+    if (fd == -1) {
+      return error;
+    }
+
+    const char* data      = buffer.data();
+    size_t      remaining = buffer.size();
+
+    while (remaining) {
+      if (segment_offset == segment_size) {
+        if (auto err_str = switch_segment()) {
+          return err_str;
+        }
+      }
+
+      size_t nof_bytes = std::min(remaining, segment_size - segment_offset);
+      std::memcpy(segment + segment_offset, data, nof_bytes);
+      segment_offset += nof_bytes;
+      size += nof_bytes;
+      data += nof_bytes;
+      remaining -= nof_bytes;
+    }
+
+    return {};
+  }
+
+  /// Schedules the writeback of the contents written so far, without waiting for its completion. Returns the error that
+  /// closed the file, if any.
+  detail::error_string flush()
+  {
+    if (fd == -1) {
+      return error;
+    }
+    if (segment_offset) {
+      push_task({task_type::writeback, fd, nullptr, segment_index, segment_offset});
+    }
+    return {};
+  }
+
+  /// Closes an open file, otherwise does nothing. The preallocated space after the written contents is trimmed
+  /// asynchronously.
+  void close()
+  {
+    if (fd == -1) {
+      return;
+    }
+
+    push_task({task_type::retire, fd, segment, segment_index, segment_offset});
+    segment = nullptr;
+
+    // Drop the segment prepared in advance.
+    segment_info next = wait_next_segment();
+    if (next.ptr) {
+      ::munmap(next.ptr, segment_size);
+    }
+
+    push_task({task_type::close, fd, nullptr, segment_index, size});
+
+    fd             = -1;
+    size           = 0;
+    segment_index  = 0;
+    segment_offset = 0;
+    path.clear();
+  }
+
+private:
+  /// Result of preparing a file segment.
+  struct segment_info {
+    char*                ptr = nullptr;
+    detail::error_string error;
+  };
+
+  enum class task_type { prepare, retire, writeback, close };
+
+  /// Work item for the helper thread.
+  struct task {
+    task_type type;
+    int       fd;
+    /// Mapped segment to be released.
+    char* ptr;
+    /// Index of the segment the task refers to.
+    size_t index;
+    /// Number of bytes written into the segment, or into the file for close tasks.
+    size_t length;
+  };
+
+  /// Extends the file with the specified segment and maps it.
+  segment_info prepare_segment(int file_fd, size_t index) const
+  {
+    off_t        offset = index * segment_size;
+    segment_info info;
+
+    // Reserve the disk blocks upfront, writing into a mapped page without backing blocks raises SIGBUS.
+    if (::ftruncate(file_fd, offset + segment_size) == -1) {
+      info.error = format_error("Unable to extend log file", errno);
+      return info;
+    }
+    int ret = ::posix_fallocate(file_fd, offset, segment_size);
+    if (ret != 0) {
+      info.error = format_error("Unable to preallocate log file segment", ret);
+      return info;
+    }
+
+    void* p = ::mmap(nullptr, segment_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, file_fd, offset);
+    if (p == MAP_FAILED) {
+      info.error = format_error("Unable to map log file segment", errno);
+      return info;
+    }
+    ::madvise(p, segment_size, MADV_SEQUENTIAL);
+    info.ptr = static_cast<char*>(p);
+
+    return info;
+  }
+
+  /// Asks the helper thread to prepare the segment following the current one.
+  void request_next_segment()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m);
+      next_segment_ready = false;
+    }
+    push_task({task_type::prepare, fd, nullptr, segment_index + 1, 0});
+  }
+
+  /// Blocks until the helper thread has prepared the next segment.
+  segment_info wait_next_segment()
+  {
+    std::unique_lock<std::mutex> lock(m);
+    cvar.wait(lock, [this]() { return next_segment_ready; });
+    return std::move(next_segment);
+  }
+
+  /// Hands the completed segment to the helper thread and continues writing in the next one. The file is closed when
+  /// the next segment could not be prepared.
+  detail::error_string switch_segment()
+  {
+    push_task({task_type::retire, fd, segment, segment_index, segment_offset});
+    segment = nullptr;
+
+    segment_info next = wait_next_segment();
+    if (next.error) {
+      push_task({task_type::close, fd, nullptr, segment_index, size});
+      fd             = -1;
+      size           = 0;
+      segment_index  = 0;
+      segment_offset = 0;
+      path.clear();
+      error = next.error;
+      return error;
+    }
+
+    segment = next.ptr;
+    ++segment_index;
+    segment_offset = 0;
+    request_next_segment();
+
+    return {};
+  }
+
+  void push_task(const task& t)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m);
+      tasks.push_back(t);
+    }
+    cvar.notify_all();
+  }
+
+  /// Entry function of the helper thread.
+  void run_helper()
+  {
+    std::unique_lock<std::mutex> lock(m);
+    while (true) {
+      cvar.wait(lock, [this]() { return stop_helper || !tasks.empty(); });
+      if (tasks.empty()) {
+        return;
+      }
+
+      task t = tasks.front();
+      tasks.pop_front();
+      lock.unlock();
+      run_task(t);
+      lock.lock();
+    }
+  }
+
+  /// Executes a helper thread task.
+  void run_task(const task& t)
+  {
+    off_t offset = t.index * segment_size;
+
+    switch (t.type) {
+      case task_type::prepare: {
+        segment_info info = prepare_segment(t.fd, t.index);
+        {
+          std::lock_guard<std::mutex> lock(m);
+          next_segment       = std::move(info);
+          next_segment_ready = true;
+        }
+        cvar.notify_all();
+        break;
+      }
+      case task_type::retire:
+        ::sync_file_range(t.fd, offset, t.length, SYNC_FILE_RANGE_WRITE);
+        ::munmap(t.ptr, segment_size);
+        // Writeback of the segment before the previous one should be done by now.
+        if (t.index > 1) {
+          ::posix_fadvise(t.fd, offset - 2 * segment_size, segment_size, POSIX_FADV_DONTNEED);
+        }
+        break;
+      case task_type::writeback:
+        ::sync_file_range(t.fd, offset, t.length, SYNC_FILE_RANGE_WRITE);
+        break;
+      case task_type::close:
+        // Wait for the writeback of the file to drop all its pages from the page cache.
+        ::sync_file_range(t.fd, 0, 0, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+        ::posix_fadvise(t.fd, 0, 0, POSIX_FADV_DONTNEED);
+        if (::ftruncate(t.fd, t.length) == -1) {
+          fmt::print(stderr, "srsLog error - Unable to trim log file to {} bytes\n", t.length);
+        }
+        ::close(t.fd);
+        break;
+    }
+  }
+
+private:
+  std::string path;
+  int         fd             = -1;
+  size_t      segment_size   = 0;
+  char*       segment        = nullptr;
+  size_t      segment_index  = 0;
+  size_t      segment_offset = 0;
+  size_t      size           = 0;
+  /// Error that closed the last file.
+  detail::error_string error;
+
+  /// State shared with the helper thread.
+  std::mutex              m;
+  std::condition_variable cvar;
+  std::deque<task>        tasks;
+  segment_info            next_segment;
+  bool                    next_segment_ready = true;
+  bool                    stop_helper        = false;
+  std::thread             helper_thread;
+};
+
+} // namespace file_utils
+
+} // namespace srslog
+
+#endif // SRSLOG_MAPPED_FILE_H
@@ -0,0 +1,124 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#ifndef SRSLOG_MMAP_FILE_SINK_H
+#define SRSLOG_MMAP_FILE_SINK_H
+
+#include "mapped_file.h"
+#include "srsran/srslog/sink.h"
+#include <chrono>
+
+namespace srslog {
+
+/// This sink implementation writes to files through memory mappings, so that writing an entry is a plain memory copy
+/// that does not block on the disk, see the mapped_file class. Includes the optional feature of file rotation: a new
+/// file is created when the file size exceeds an established threshold or when the file has been open for longer than
+/// the rotation period.
+/// NOTE: Preallocated space is trimmed asynchronously after the file is closed, until then readers will see the file
+/// padded with zeros up to the end of the current segment.
+class mmap_file_sink : public sink
+{
+public:
+  /// Default size of the file segments.
+  static constexpr size_t default_segment_size = 4 * 1024 * 1024;
+
+  mmap_file_sink(std::string                    name,
+                 size_t                         max_size,
+                 std::chrono::milliseconds      rotation_period,
+                 std::unique_ptr<log_formatter> f,
+                 size_t                         segment_size = default_segment_size) :
+    sink(std::move(f)),
+    max_size((max_size == 0) ? 0 : std::max<size_t>(max_size, 4 * 1024)),
+    rotation_period(rotation_period),
+    base_filename(std::move(name)),
+    handler(segment_size)
+  {}
+
+  mmap_file_sink(const mmap_file_sink& other) = delete;
+  mmap_file_sink& operator=(const mmap_file_sink& other) = delete;
+
+  detail::error_string write(detail::memory_buffer buffer) override
+  {
+    // Create a new file the first time we hit this method.
+    if (is_first_write()) {
+      assert(!handler && "No handler should be created yet");
+      if (auto err_str = create_file()) {
+        return err_str;
+      }
+    }
+
+    // Do not touch the file when it was closed on a previous error, report
+    // the error instead.
+    if (!handler) {
+      return handler.get_error();
+    }
+
+    if (auto err_str = handle_rotation(buffer.size())) {
+      return err_str;
+    }
+
+    return handler.write(buffer);
+  }
+
+  detail::error_string flush() override { return handler.flush(); }
+
+protected:
+  /// Returns the current file index.
+  uint32_t get_file_index() const { return file_index; }
+
+private:
+  /// Returns true when the sink has never written data to a file, otherwise
+  /// returns false.
+  bool is_first_write() const { return file_index == 0; }
+
+  /// Creates a new file and increments the file index counter.
+  detail::error_string create_file()
+  {
+    file_creation_time = std::chrono::steady_clock::now();
+    return handler.create(file_utils::build_filename_with_index(base_filename, file_index++));
+  }
+
+  /// Handles the file rotation feature when it is activated.
+  /// NOTE: The file handler must be valid.
+  detail::error_string handle_rotation(size_t size)
+  {
+    assert(handler && "Expected a valid file handle");
+    if (max_size && handler.get_size() + size >= max_size && handler.get_size() != 0) {
+      return create_file();
+    }
+    if (rotation_period.count() && std::chrono::steady_clock::now() - file_creation_time >= rotation_period) {
+      return create_file();
+    }
+    return {};
+  }
+
+private:
+  const size_t                          max_size;
+  const std::chrono::milliseconds       rotation_period;
+  const std::string                     base_filename;
+  file_utils::mapped_file               handler;
+  std::chrono::steady_clock::time_point file_creation_time;
+  uint32_t                              file_index = 0;
+};
+
+} // namespace srslog
+
+#endif // SRSLOG_MMAP_FILE_SINK_H
@@ -21,7 +21,9 @@
 
 #include "srsran/srslog/srslog.h"
 #include "formatters/json_formatter.h"
+#include "sinks/binary_file_sink.h"
 #include "sinks/file_sink.h"
+#include "sinks/mmap_file_sink.h"
 #include "sinks/syslog_sink.h"
 #include "srslog_instance.h"
 
@@ -178,6 +180,45 @@ sink& srslog::fetch_file_sink(const std::string&             path,
   return *s;
 }
 
+sink& srslog::fetch_mmap_file_sink(const std::string&             path,
+                                   size_t                         max_size,
+                                   std::chrono::seconds           rotation_period,
+                                   std::unique_ptr<log_formatter> f)
+{
+  assert(!path.empty() && "Empty path string");
+
+  if (auto* s = find_sink(path)) {
+    return *s;
+  }
+
+  //: TODO: GCC5 or lower versions emits an error if we use the new() expression
+  // directly, use redundant piecewise_construct instead.
+  auto& s = srslog_instance::get().get_sink_repo().emplace(
+      std::piecewise_construct,
+      std::forward_as_tuple(path),
+      std::forward_as_tuple(new mmap_file_sink(path, max_size, rotation_period, std::move(f))));
+
+  return *s;
+}
+
+sink& srslog::fetch_binary_file_sink(const std::string& path, size_t max_size, bool force_flush)
+{
+  assert(!path.empty() && "Empty path string");
+
+  if (auto* s = find_sink(path)) {
+    return *s;
+  }
+
+  //: TODO: GCC5 or lower versions emits an error if we use the new() expression
+  // directly, use redundant piecewise_construct instead.
+  auto& s = srslog_instance::get().get_sink_repo().emplace(
+      std::piecewise_construct,
+      std::forward_as_tuple(path),
+      std::forward_as_tuple(new binary_file_sink(path, max_size, force_flush)));
+
+  return *s;
+}
+
 sink& srslog::fetch_syslog_sink(const std::string&             preamble_,
                                 syslog_local_type              log_local_,
                                 std::unique_ptr<log_formatter> f)
@@ -258,6 +299,11 @@ void srslog::set_error_handler(error_handler handler)
   srslog_instance::get().set_error_handler(std::move(handler));
 }
 
+void srslog::set_thread_queue_capacity(size_t capacity)
+{
+  srslog_instance::get().set_thread_queue_capacity(capacity);
+}
+
 ///
 /// Logger management function implementations.
 ///
@@ -88,6 +88,9 @@ public:
   /// Installs the specified error handler into the backend.
   void set_error_handler(error_handler callback) { backend.set_error_handler(std::move(callback)); }
 
+  /// Sets the capacity of the log queue of each producer thread.
+  void set_thread_queue_capacity(size_t capacity) { backend.set_thread_queue_capacity(capacity); }
+
   /// Set the specified sink as the default one.
   void set_default_sink(sink& s) { default_sink = &s; }
 
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/// Offline decoder of the binary log files written by the srslog binary file sink. Prints every log entry in the
+/// text format of the text formatter, so that existing log tooling can be used on the output.
+
+#include "../formatters/binary_decoder.h"
+
+using namespace srslog;
+
+/// Decodes the specified binary log file into the output stream. Returns false on error.
+static bool decode_file(const char* path, std::FILE* out)
+{
+  std::FILE* file = std::fopen(path, "rb");
+  if (!file) {
+    fmt::print(stderr, "srslog_decode: unable to open file \"{}\"\n", path);
+    return false;
+  }
+
+  binary_decoder decoder(file);
+  if (auto err = decoder.read_header()) {
+    fmt::print(stderr, "srslog_decode: {}: {}\n", path, err.get_error());
+    std::fclose(file);
+    return false;
+  }
+
+  fmt::memory_buffer buffer;
+  bool               finished = false;
+  while (!finished) {
+    if (auto err = decoder.decode_next(buffer, finished)) {
+      fmt::print(stderr, "srslog_decode: {}: {}\n", path, err.get_error());
+      std::fclose(file);
+      return false;
+    }
+
+    // Write the decoded text in large chunks.
+    if (buffer.size() >= 64 * 1024 || finished) {
+      std::fwrite(buffer.data(), sizeof(char), buffer.size(), out);
+      buffer.clear();
+    }
+  }
+
+  std::fclose(file);
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    fmt::print(stderr, "Usage: {} <binary log file> [<binary log file> ...]\n", argv[0]);
+    fmt::print(stderr, "Rotated log files are self contained and are decoded in the specified order.\n");
+    return 1;
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    if (!decode_file(argv[i], stdout)) {
+      return 1;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "pdcp_lte_test.h"
+#include <chrono>
+
+/*
+ * Benchmark of the PDCP LTE AM TX path: SDU write followed by RLC delivery notification.
+ * Delivery notifications are batched every nof_sdus_per_tti SDUs and the timer wheel is stepped once per TTI, which
+ * is the pattern seen by an AM DRB at high rates.
+ */
+int run_write_notify_benchmark(uint32_t nof_sdus, uint32_t nof_sdus_per_tti, srslog::basic_logger& logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_18,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::ms100,
+                               true,
+                               srsran::srsran_rat_t::lte};
+
+  pdcp_lte_test_helper     pdcp_hlp(cfg, sec_cfg, logger);
+  srsran::pdcp_entity_lte* pdcp  = &pdcp_hlp.pdcp;
+  rlc_dummy*               rlc   = &pdcp_hlp.rlc;
+  srsue::stack_test_dummy* stack = &pdcp_hlp.stack;
+  pdcp_hlp.set_pdcp_initial_state(normal_init_state);
+
+  uint8_t                  payload[1500] = {};
+  srsran::pdcp_sn_vector_t sns_notified;
+  uint32_t                 next_sn = 0;
+
+  auto t_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    sdu->append_bytes(payload, sizeof(payload));
+    pdcp->write_sdu(std::move(sdu));
+
+    sns_notified.push_back(next_sn);
+    next_sn = (next_sn + 1) % (1u << cfg.sn_len);
+    if (sns_notified.full() or sns_notified.size() == nof_sdus_per_tti) {
+      pdcp->notify_delivery(sns_notified);
+      sns_notified.clear();
+      stack->run_tti();
+    }
+  }
+  if (not sns_notified.empty()) {
+    pdcp->notify_delivery(sns_notified);
+  }
+  auto t_end = std::chrono::steady_clock::now();
+
+  TESTASSERT(pdcp->nof_discard_timers() == 0);
+  TESTASSERT(rlc->discard_count == 0);
+
+  double elapsed_s = std::chrono::duration_cast<std::chrono::duration<double> >(t_end - t_start).count();
+  fmt::print("write_sdu + notify_delivery: {} SDUs, {} SDUs/TTI, {:.3f} s, {:.2f} kSDU/s\n",
+             nof_sdus,
+             nof_sdus_per_tti,
+             elapsed_s,
+             nof_sdus / elapsed_s / 1e3);
+  return SRSRAN_SUCCESS;
+}
+
+/*
+ * Benchmark of the discard path: SDUs are written but never acknowledged, so every one of them goes through the
+ * discardTimer expiry.
+ */
+int run_discard_benchmark(uint32_t nof_sdus, uint32_t nof_sdus_per_tti, srslog::basic_logger& logger)
+{
+  srsran::pdcp_config_t cfg = {1,
+                               srsran::PDCP_RB_IS_DRB,
+                               srsran::SECURITY_DIRECTION_UPLINK,
+                               srsran::SECURITY_DIRECTION_DOWNLINK,
+                               srsran::PDCP_SN_LEN_18,
+                               srsran::pdcp_t_reordering_t::ms500,
+                               srsran::pdcp_discard_timer_t::ms50,
+                               true,
+                               srsran::srsran_rat_t::lte};
+
+  pdcp_lte_test_helper     pdcp_hlp(cfg, sec_cfg, logger);
+  srsran::pdcp_entity_lte* pdcp  = &pdcp_hlp.pdcp;
+  rlc_dummy*               rlc   = &pdcp_hlp.rlc;
+  srsue::stack_test_dummy* stack = &pdcp_hlp.stack;
+  pdcp_hlp.set_pdcp_initial_state(normal_init_state);
+
+  uint8_t payload[1500] = {};
+
+  auto t_start = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < nof_sdus; i++) {
+    srsran::unique_byte_buffer_t sdu = srsran::make_byte_buffer();
+    TESTASSERT(sdu != nullptr);
+    sdu->append_bytes(payload, sizeof(payload));
+    pdcp->write_sdu(std::move(sdu));
+    if ((i + 1) % nof_sdus_per_tti == 0) {
+      stack->run_tti();
+    }
+  }
+  for (uint32_t i = 0; i < static_cast<uint32_t>(cfg.discard_timer); i++) {
+    stack->run_tti();
+  }
+  auto t_end = std::chrono::steady_clock::now();
+
+  TESTASSERT(pdcp->nof_discard_timers() == 0);
+
+  double elapsed_s = std::chrono::duration_cast<std::chrono::duration<double> >(t_end - t_start).count();
+  fmt::print("write_sdu + discard expiry: {} SDUs, {} discarded, {:.3f} s, {:.2f} kSDU/s\n",
+             nof_sdus,
+             rlc->discard_count,
+             elapsed_s,
+             nof_sdus / elapsed_s / 1e3);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  // Keep logging out of the measurement
+  auto& logger = srslog::fetch_basic_logger("PDCP", false);
+  logger.set_level(srslog::basic_levels::error);
+
+  uint32_t nof_sdus = 100000;
+  if (argc > 1) {
+    nof_sdus = std::strtoul(argv[1], nullptr, 10);
+  }
+
+  for (uint32_t nof_sdus_per_tti : {1, 16, 64}) {
+    TESTASSERT(run_write_notify_benchmark(nof_sdus, nof_sdus_per_tti, logger) == SRSRAN_SUCCESS);
+  }
+  TESTASSERT(run_discard_benchmark(nof_sdus, 16, logger) == SRSRAN_SUCCESS);
+
+  return SRSRAN_SUCCESS;
+}
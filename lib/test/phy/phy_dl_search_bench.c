@@ -0,0 +1,453 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/*!
+ * \file phy_dl_search_bench.c
+ * \brief Throughput benchmark for the UE PDCCH blind search.
+ *
+ * The base station fills every CCE of the control region with DCI messages for other RNTIs and transmits one DCI for
+ * the UE. The UE blind search is then timed:
+ *  - LTE: C-RNTI search in the UE-specific and common search spaces followed by a SI-RNTI search in the common search
+ *    space, as in the subframes carrying SIB.
+ *  - NR: C-RNTI search in a common search space (formats 0_0/1_0) and in a UE-specific search space (formats 0_0/1_0
+ *    and 0_1/1_1) sharing the same CORESET.
+ *
+ * The DCI for the UE must be found in every subframe/slot. The number of decoded candidates per millisecond of search
+ * is reported.
+ *
+ * Synopsis: **phy_dl_search_bench [options]**
+ *
+ * Options:
+ *  - **-t \<lte|nr|all\>** Radio access technology to benchmark (Default all).
+ *  - **-p \<number\>** LTE cell bandwidth in PRB (Default 50).
+ *  - **-P \<number\>** NR carrier bandwidth in PRB (Default 52).
+ *  - **-n \<number\>** Number of subframes/slots (Default 1000).
+ */
+
+#include "srsran/phy/enb/enb_dl.h"
+#include "srsran/phy/gnb/gnb_dl.h"
+#include "srsran/phy/phch/ra.h"
+#include "srsran/phy/ue/ue_dl.h"
+#include "srsran/phy/ue/ue_dl_nr.h"
+#include "srsran/phy/utils/debug.h"
+#include "srsran/phy/utils/vector.h"
+#include <getopt.h>
+#include <string.h>
+#include <sys/time.h>
+
+#define RNTI 0x4601
+#define RNTI_OTHER 0x1000
+
+static bool     run_lte   = true;
+static bool     run_nr    = true;
+static uint32_t lte_prb   = 50;
+static uint32_t nr_prb    = 52;
+static uint32_t nof_iters = 1000;
+
+static void usage(char* prog)
+{
+  printf("Usage: %s [tpPn]\n", prog);
+  printf("\t-t Radio access technology (lte, nr or all) [Default all]\n");
+  printf("\t-p LTE cell bandwidth in PRB [Default %d]\n", lte_prb);
+  printf("\t-P NR carrier bandwidth in PRB [Default %d]\n", nr_prb);
+  printf("\t-n Number of subframes/slots [Default %d]\n", nof_iters);
+}
+
+static int parse_args(int argc, char** argv)
+{
+  int opt;
+  while ((opt = getopt(argc, argv, "tpPn")) != -1) {
+    switch (opt) {
+      case 't':
+        run_lte = strcmp(argv[optind], "nr") != 0;
+        run_nr  = strcmp(argv[optind], "lte") != 0;
+        break;
+      case 'p':
+        lte_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'P':
+        nr_prb = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      case 'n':
+        nof_iters = (uint32_t)strtol(argv[optind], NULL, 10);
+        break;
+      default:
+        usage(argv[0]);
+        return SRSRAN_ERROR;
+    }
+  }
+
+  return SRSRAN_SUCCESS;
+}
+
+static double elapsed_us(struct timeval t[3])
+{
+  get_time_interval(t);
+  return t[0].tv_sec * 1e6 + t[0].tv_usec;
+}
+
+static void print_result(const char* rat, uint64_t nof_candidates, uint64_t nof_searches, double search_us)
+{
+  printf("%s: %.1f candidates/search; %.1f us/search; %.1f candidates/ms\n",
+         rat,
+         (double)nof_candidates / nof_searches,
+         search_us / nof_searches,
+         1e3 * nof_candidates / search_us);
+}
+
+static int bench_lte()
+{
+  int              ret                           = SRSRAN_ERROR;
+  cf_t*            buffer[SRSRAN_MAX_PORTS]      = {};
+  srsran_enb_dl_t* enb_dl                        = srsran_vec_malloc(sizeof(srsran_enb_dl_t));
+  srsran_ue_dl_t*  ue_dl                         = srsran_vec_malloc(sizeof(srsran_ue_dl_t));
+  srsran_dci_dl_t  dci_dl_rx[SRSRAN_MAX_DCI_MSG] = {};
+  uint64_t         nof_candidates                = 0;
+  double           search_us                     = 0;
+  struct timeval   t[3]                          = {};
+
+  srsran_cell_t cell   = {};
+  cell.nof_prb         = lte_prb;
+  cell.nof_ports       = 1;
+  cell.id              = 1;
+  cell.cp              = SRSRAN_CP_NORM;
+  cell.phich_resources = SRSRAN_PHICH_R_1;
+  cell.phich_length    = SRSRAN_PHICH_NORM;
+
+  buffer[0] = srsran_vec_cf_malloc(SRSRAN_SF_LEN_PRB(cell.nof_prb));
+  if (enb_dl == NULL || ue_dl == NULL || buffer[0] == NULL) {
+    ERROR("Error malloc");
+    goto clean_exit;
+  }
+
+  if (srsran_enb_dl_init(enb_dl, buffer, cell.nof_prb) || srsran_enb_dl_set_cell(enb_dl, cell)) {
+    ERROR("Error initiating eNb downlink");
+    goto clean_exit;
+  }
+
+  if (srsran_ue_dl_init(ue_dl, buffer, cell.nof_prb, 1) || srsran_ue_dl_set_cell(ue_dl, cell)) {
+    ERROR("Error initiating UE downlink");
+    goto clean_exit;
+  }
+
+  srsran_dci_cfg_t dci_cfg = {};
+
+  srsran_ue_dl_cfg_t ue_dl_cfg       = {};
+  ue_dl_cfg.cfg.tm                   = SRSRAN_TM1;
+  ue_dl_cfg.cfg.dci                  = dci_cfg;
+  ue_dl_cfg.cfg.dci_common_ss        = true;
+  ue_dl_cfg.chest_cfg.filter_coef[0] = 4;
+  ue_dl_cfg.chest_cfg.filter_coef[1] = 1;
+  ue_dl_cfg.chest_cfg.filter_type    = SRSRAN_CHEST_FILTER_GAUSS;
+  ue_dl_cfg.chest_cfg.noise_alg      = SRSRAN_NOISE_ALG_REFS;
+  ue_dl_cfg.chest_cfg.estimator_alg  = SRSRAN_ESTIMATOR_ALG_AVERAGE;
+
+  // Every DCI is a Format 1A with a single PRB allocation
+  srsran_dci_dl_t dci  = {};
+  dci.format           = SRSRAN_DCI_FORMAT1A;
+  dci.alloc_type       = SRSRAN_RA_ALLOC_TYPE2;
+  dci.type2_alloc.mode = SRSRAN_RA_TYPE2_LOC;
+  dci.type2_alloc.riv  = srsran_ra_type2_to_riv(1, 0, cell.nof_prb);
+  dci.tb[0].mcs_idx    = 0;
+  dci.tb[0].rv         = 0;
+  dci.tb[0].ndi        = 0;
+  dci.tb[0].cw_idx     = 0;
+  dci.tb[1].mcs_idx    = 0;
+  dci.tb[1].rv         = 1;
+
+  for (uint32_t sf_idx = 0; sf_idx < nof_iters; sf_idx++) {
+    srsran_dl_sf_cfg_t sf_cfg = {};
+    sf_cfg.tti                = sf_idx % SRSRAN_NOF_SF_X_FRAME;
+    sf_cfg.cfi                = 3;
+    sf_cfg.sf_type            = SRSRAN_SF_NORM;
+
+    // Select a UE-specific location for the UE DCI
+    srsran_dci_location_t locations[SRSRAN_MAX_CANDIDATES_UE] = {};
+    uint32_t              nof_locations =
+        srsran_pdcch_ue_locations(&enb_dl->pdcch, &sf_cfg, locations, SRSRAN_MAX_CANDIDATES_UE, RNTI);
+    if (nof_locations == 0) {
+      ERROR("No UE-specific locations");
+      goto clean_exit;
+    }
+    srsran_dci_location_t location = locations[(sf_idx / SRSRAN_NOF_SF_X_FRAME) % nof_locations];
+
+    srsran_enb_dl_put_base(enb_dl, &sf_cfg);
+
+    // Put the UE DCI and a DCI for another RNTI in every other CCE
+    uint32_t nof_cce = enb_dl->pdcch.nof_cce[sf_cfg.cfi - 1];
+    for (uint32_t ncce = 0; ncce < nof_cce; ncce++) {
+      bool is_ue = ncce >= location.ncce && ncce < location.ncce + (1U << location.L);
+      if (is_ue && ncce != location.ncce) {
+        continue;
+      }
+      dci.rnti          = is_ue ? RNTI : (uint16_t)(RNTI_OTHER + ncce);
+      dci.location.L    = is_ue ? location.L : 0;
+      dci.location.ncce = ncce;
+      if (srsran_enb_dl_put_pdcch_dl(enb_dl, &dci_cfg, &dci)) {
+        ERROR("Error putting PDCCH");
+        goto clean_exit;
+      }
+    }
+    srsran_enb_dl_gen_signal(enb_dl);
+
+    if (srsran_ue_dl_decode_fft_estimate(ue_dl, &sf_cfg, &ue_dl_cfg) < SRSRAN_SUCCESS) {
+      ERROR("Error estimating PDCCH");
+      goto clean_exit;
+    }
+
+    gettimeofday(&t[1], NULL);
+    int nof_dci = srsran_ue_dl_find_dl_dci(ue_dl, &sf_cfg, &ue_dl_cfg, RNTI, dci_dl_rx);
+    int nof_si  = srsran_ue_dl_find_dl_dci(ue_dl, &sf_cfg, &ue_dl_cfg, SRSRAN_SIRNTI, dci_dl_rx);
+    gettimeofday(&t[2], NULL);
+    search_us += elapsed_us(t);
+
+    if (nof_dci < SRSRAN_SUCCESS || nof_si < SRSRAN_SUCCESS) {
+      ERROR("Error searching DCI");
+      goto clean_exit;
+    }
+    if (nof_dci < 1) {
+      ERROR("DCI not found in sf_idx=%d L=%d ncce=%d", sf_idx, location.L, location.ncce);
+      goto clean_exit;
+    }
+
+    // UE-specific (1A and 1) and common (1A) search spaces for C-RNTI, common (1A and 1C) for SI-RNTI
+    uint32_t nof_common = ue_dl->current_ss_common.nof_locations;
+    nof_candidates += nof_locations * 2 + nof_common + nof_common * 2;
+  }
+
+  print_result("LTE", nof_candidates, nof_iters, search_us);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  if (enb_dl) {
+    srsran_enb_dl_free(enb_dl);
+    free(enb_dl);
+  }
+  if (ue_dl) {
+    srsran_ue_dl_free(ue_dl);
+    free(ue_dl);
+  }
+  if (buffer[0]) {
+    free(buffer[0]);
+  }
+
+  return ret;
+}
+
+static int bench_nr()
+{
+  int                 ret                              = SRSRAN_ERROR;
+  srsran_gnb_dl_t     gnb_dl                           = {};
+  srsran_ue_dl_nr_t   ue_dl                            = {};
+  cf_t*               buffer_gnb[SRSRAN_MAX_PORTS]     = {};
+  cf_t*               buffer_ue[SRSRAN_MAX_PORTS]      = {};
+  srsran_dci_dl_nr_t  dci_dl_rx[SRSRAN_MAX_DCI_MSG_NR] = {};
+  srsran_carrier_nr_t carrier                          = SRSRAN_DEFAULT_CARRIER_NR;
+  uint64_t            nof_candidates                   = 0;
+  double              search_us                        = 0;
+  struct timeval      t[3]                             = {};
+
+  carrier.nof_prb = nr_prb;
+
+  uint32_t sf_len = SRSRAN_SF_LEN_PRB_NR(carrier.nof_prb);
+  buffer_gnb[0]   = srsran_vec_cf_malloc(sf_len);
+  buffer_ue[0]    = srsran_vec_cf_malloc(sf_len);
+  if (buffer_gnb[0] == NULL || buffer_ue[0] == NULL) {
+    ERROR("Error malloc");
+    goto clean_exit;
+  }
+
+  srsran_ue_dl_nr_args_t ue_dl_args = {};
+  ue_dl_args.nof_rx_antennas        = 1;
+  ue_dl_args.nof_max_prb            = carrier.nof_prb;
+
+  srsran_gnb_dl_args_t gnb_dl_args = {};
+  gnb_dl_args.nof_tx_antennas      = 1;
+  gnb_dl_args.nof_max_prb          = carrier.nof_prb;
+  gnb_dl_args.srate_hz             = SRSRAN_SUBC_SPACING_NR(carrier.scs) * srsran_min_symbol_sz_rb(carrier.nof_prb);
+
+  // Two symbols CORESET spanning the whole carrier
+  srsran_pdcch_cfg_nr_t pdcch_cfg = {};
+  srsran_coreset_t*     coreset   = &pdcch_cfg.coreset[1];
+  pdcch_cfg.coreset_present[1]    = true;
+  coreset->duration               = 2;
+  for (uint32_t i = 0; i < SRSRAN_CORESET_FREQ_DOMAIN_RES_SIZE; i++) {
+    coreset->freq_resources[i] = i < carrier.nof_prb / 6;
+  }
+
+  // Common and UE-specific search spaces in the same CORESET
+  srsran_search_space_t* ss_common  = &pdcch_cfg.search_space[0];
+  pdcch_cfg.search_space_present[0] = true;
+  ss_common->id                     = 0;
+  ss_common->coreset_id             = 1;
+  ss_common->type                   = srsran_search_space_type_common_3;
+  ss_common->formats[0]             = srsran_dci_format_nr_0_0;
+  ss_common->formats[1]             = srsran_dci_format_nr_1_0;
+  ss_common->nof_formats            = 2;
+
+  srsran_search_space_t* ss_ue      = &pdcch_cfg.search_space[1];
+  pdcch_cfg.search_space_present[1] = true;
+  ss_ue->id                         = 1;
+  ss_ue->coreset_id                 = 1;
+  ss_ue->type                       = srsran_search_space_type_ue;
+  ss_ue->formats[0]                 = srsran_dci_format_nr_0_0;
+  ss_ue->formats[1]                 = srsran_dci_format_nr_1_0;
+  ss_ue->formats[2]                 = srsran_dci_format_nr_0_1;
+  ss_ue->formats[3]                 = srsran_dci_format_nr_1_1;
+  ss_ue->nof_formats                = 4;
+
+  const uint32_t nof_candidates_ss[SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR] = {4, 2, 2, 1, 0};
+  for (uint32_t L = 0; L < SRSRAN_SEARCH_SPACE_NOF_AGGREGATION_LEVELS_NR; L++) {
+    uint32_t max_candidates      = (uint32_t)srsran_pdcch_nr_max_candidates_coreset(coreset, L);
+    ss_common->nof_candidates[L] = SRSRAN_MIN(nof_candidates_ss[L], max_candidates);
+    ss_ue->nof_candidates[L]     = SRSRAN_MIN(nof_candidates_ss[L], max_candidates);
+  }
+
+  srsran_dci_cfg_nr_t dci_cfg = {};
+  dci_cfg.bwp_dl_initial_bw   = carrier.nof_prb;
+  dci_cfg.bwp_dl_active_bw    = carrier.nof_prb;
+  dci_cfg.bwp_ul_initial_bw   = carrier.nof_prb;
+  dci_cfg.bwp_ul_active_bw    = carrier.nof_prb;
+  dci_cfg.monitor_common_0_0  = true;
+  dci_cfg.monitor_0_0_and_1_0 = true;
+  dci_cfg.monitor_0_1_and_1_1 = true;
+  dci_cfg.nof_ul_layers       = 1;
+
+  if (srsran_ue_dl_nr_init(&ue_dl, buffer_ue, &ue_dl_args) || srsran_ue_dl_nr_set_carrier(&ue_dl, &carrier) ||
+      srsran_ue_dl_nr_set_pdcch_config(&ue_dl, &pdcch_cfg, &dci_cfg)) {
+    ERROR("Error initiating UE DL");
+    goto clean_exit;
+  }
+
+  if (srsran_gnb_dl_init(&gnb_dl, buffer_gnb, &gnb_dl_args) || srsran_gnb_dl_set_carrier(&gnb_dl, &carrier) ||
+      srsran_gnb_dl_set_pdcch_config(&gnb_dl, &pdcch_cfg, &dci_cfg)) {
+    ERROR("Error initiating gNb DL");
+    goto clean_exit;
+  }
+
+  // Every DCI is a Format 1_0 in the common search space
+  srsran_dci_dl_nr_t dci    = {};
+  dci.ctx.rnti_type         = srsran_rnti_type_c;
+  dci.ctx.format            = srsran_dci_format_nr_1_0;
+  dci.ctx.ss_type           = ss_common->type;
+  dci.ctx.coreset_id        = 1;
+  dci.freq_domain_assigment = 0;
+  dci.time_domain_assigment = 0;
+  dci.mcs                   = 0;
+
+  uint32_t nof_cce = srsran_coreset_get_bw(coreset) * coreset->duration / 6;
+  for (uint32_t slot_idx = 0; slot_idx < nof_iters; slot_idx++) {
+    srsran_slot_cfg_t slot = {};
+    slot.idx               = slot_idx;
+
+    // Select a common search space location for the UE DCI
+    uint32_t L                                                    = 1;
+    uint32_t locations[SRSRAN_SEARCH_SPACE_MAX_NOF_CANDIDATES_NR] = {};
+    int      nof_locations                                        = srsran_pdcch_nr_locations_coreset(
+        coreset, ss_common, RNTI, L, SRSRAN_SLOT_NR_MOD(carrier.scs, slot.idx), locations);
+    if (nof_locations < 1) {
+      ERROR("Error getting PDCCH candidates");
+      goto clean_exit;
+    }
+    uint32_t ue_ncce = locations[slot_idx % (uint32_t)nof_locations];
+
+    if (srsran_gnb_dl_base_zero(&gnb_dl) < SRSRAN_SUCCESS) {
+      ERROR("Error setting base to zero");
+      goto clean_exit;
+    }
+
+    // Put the UE DCI and a DCI for another RNTI in every other CCE
+    for (uint32_t ncce = 0; ncce < nof_cce; ncce++) {
+      bool is_ue = ncce >= ue_ncce && ncce < ue_ncce + (1U << L);
+      if (is_ue && ncce != ue_ncce) {
+        continue;
+      }
+      dci.ctx.rnti          = is_ue ? RNTI : (uint16_t)(RNTI_OTHER + ncce);
+      dci.ctx.location.L    = is_ue ? L : 0;
+      dci.ctx.location.ncce = ncce;
+      if (srsran_gnb_dl_pdcch_put_dl(&gnb_dl, &slot, &dci) < SRSRAN_SUCCESS) {
+        ERROR("Error putting PDCCH");
+        goto clean_exit;
+      }
+    }
+    srsran_gnb_dl_gen_signal(&gnb_dl);
+    srsran_vec_cf_copy(buffer_ue[0], buffer_gnb[0], sf_len);
+
+    srsran_ue_dl_nr_estimate_fft(&ue_dl, &slot);
+
+    gettimeofday(&t[1], NULL);
+    int nof_dci =
+        srsran_ue_dl_nr_find_dl_dci(&ue_dl, &slot, RNTI, srsran_rnti_type_c, dci_dl_rx, SRSRAN_MAX_DCI_MSG_NR);
+    gettimeofday(&t[2], NULL);
+    search_us += elapsed_us(t);
+
+    if (nof_dci < SRSRAN_SUCCESS) {
+      ERROR("Error searching DCI");
+      goto clean_exit;
+    }
+    if (nof_dci < 1) {
+      ERROR("DCI not found in slot=%d L=%d ncce=%d", slot_idx, L, ue_ncce);
+      goto clean_exit;
+    }
+
+    nof_candidates += ue_dl.pdcch_info_count;
+  }
+
+  print_result("NR", nof_candidates, nof_iters, search_us);
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  srsran_gnb_dl_free(&gnb_dl);
+  srsran_ue_dl_nr_free(&ue_dl);
+  if (buffer_gnb[0]) {
+    free(buffer_gnb[0]);
+  }
+  if (buffer_ue[0]) {
+    free(buffer_ue[0]);
+  }
+
+  return ret;
+}
+
+int main(int argc, char** argv)
+{
+  int ret = SRSRAN_ERROR;
+
+  if (parse_args(argc, argv) < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (run_lte && bench_lte() < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  if (run_nr && bench_nr() < SRSRAN_SUCCESS) {
+    goto clean_exit;
+  }
+
+  ret = SRSRAN_SUCCESS;
+
+clean_exit:
+  printf("%s\n", ret == SRSRAN_SUCCESS ? "Ok" : "Error");
+  return ret;
+}
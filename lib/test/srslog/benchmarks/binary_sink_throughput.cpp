@@ -0,0 +1,155 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "src/srslog/formatters/binary_decoder.h"
+#include "src/srslog/sinks/binary_file_sink.h"
+#include "src/srslog/sinks/file_sink.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include <numeric>
+
+using namespace srslog;
+
+static constexpr unsigned num_entries = 1000000;
+
+static constexpr char text_filename[]   = "binary_sink_throughput.log";
+static constexpr char binary_filename[] = "binary_sink_throughput.bin";
+
+namespace {
+
+/// Describes the kind of log entries generated in a benchmark run.
+struct benchmark_scenario {
+  /// Scenario name.
+  const char* name;
+  /// Number of bytes passed as a hex dump for each entry, zero for no hex dump.
+  unsigned hex_dump_len;
+};
+
+/// Results of a benchmark run.
+struct benchmark_result {
+  double entries_per_sec;
+  double bytes_per_entry;
+};
+
+} // namespace
+
+/// Builds the log entry with the specified index, mimicking a typical MAC/RLC debug entry.
+static detail::log_entry_metadata
+build_log_entry_metadata(unsigned i, unsigned hex_dump_len, fmt::dynamic_format_arg_store<fmt::printf_context>& store)
+{
+  store.push_back(i % 10240);
+  store.push_back(0x46 + i % 8);
+  store.push_back(i % 100 * 0.5);
+  store.push_back("SCHED");
+
+  detail::log_entry_metadata entry = {std::chrono::high_resolution_clock::now(),
+                                      {i % 1024, true},
+                                      "tti=%d, rnti=0x%x, snr=%.1f dB, src=%s",
+                                      &store,
+                                      "MAC",
+                                      'D'};
+  if (hex_dump_len) {
+    entry.hex_dump.resize(hex_dump_len);
+    std::iota(entry.hex_dump.begin(), entry.hex_dump.end(), uint8_t(i));
+  }
+  return entry;
+}
+
+/// Runs the backend side of the logging path (formatting and file write) for every entry, returning the measured
+/// throughput and the average number of bytes written per entry.
+static benchmark_result run_backend(sink& s, const std::string& filename, const benchmark_scenario& scenario)
+{
+  fmt::memory_buffer                                 buffer;
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+
+  auto begin = std::chrono::steady_clock::now();
+  for (unsigned i = 0; i != num_entries; ++i) {
+    store.clear();
+    buffer.clear();
+    s.get_formatter().format(build_log_entry_metadata(i, scenario.hex_dump_len, store), buffer);
+    s.write(detail::memory_buffer(buffer.data(), buffer.size()));
+  }
+  s.flush();
+  auto end = std::chrono::steady_clock::now();
+
+  double elapsed = std::chrono::duration_cast<std::chrono::duration<double> >(end - begin).count();
+
+  std::FILE* file = std::fopen(filename.c_str(), "rb");
+  std::fseek(file, 0, SEEK_END);
+  long file_size = std::ftell(file);
+  std::fclose(file);
+
+  return {num_entries / elapsed, double(file_size) / num_entries};
+}
+
+/// Decodes the binary log file written by the benchmark, returning the number of decoded entries per second.
+static double run_decoder(const std::string& filename)
+{
+  std::FILE* file = std::fopen(filename.c_str(), "rb");
+
+  auto               begin = std::chrono::steady_clock::now();
+  binary_decoder     decoder(file);
+  fmt::memory_buffer buffer;
+  bool               finished = false;
+  unsigned           count    = 0;
+  decoder.read_header();
+  while (!finished && !decoder.decode_next(buffer, finished)) {
+    count += !finished;
+    buffer.clear();
+  }
+  auto end = std::chrono::steady_clock::now();
+  std::fclose(file);
+
+  return count / std::chrono::duration_cast<std::chrono::duration<double> >(end - begin).count();
+}
+
+int main()
+{
+  const benchmark_scenario scenarios[] = {{"no hex dump", 0}, {"64 byte hex dump", 64}};
+
+  for (const auto& scenario : scenarios) {
+    benchmark_result text_result;
+    benchmark_result binary_result;
+    double           decoder_rate;
+    {
+      file_sink text(text_filename, 0, false, std::unique_ptr<log_formatter>(new text_formatter));
+      text_result = run_backend(text, text_filename, scenario);
+    }
+    {
+      binary_file_sink binary(binary_filename, 0, false);
+      binary_result = run_backend(binary, binary_filename, scenario);
+    }
+    decoder_rate = run_decoder(binary_filename);
+
+    fmt::print("Scenario: {}, {} entries\n", scenario.name, num_entries);
+    fmt::print("  text:    {:.2f} Mentries/s, {:.1f} bytes/entry\n",
+               text_result.entries_per_sec / 1e6,
+               text_result.bytes_per_entry);
+    fmt::print("  binary:  {:.2f} Mentries/s, {:.1f} bytes/entry\n",
+               binary_result.entries_per_sec / 1e6,
+               binary_result.bytes_per_entry);
+    fmt::print("  decoder: {:.2f} Mentries/s\n", decoder_rate / 1e6);
+
+    ::remove(text_filename);
+    ::remove(binary_filename);
+  }
+
+  return 0;
+}
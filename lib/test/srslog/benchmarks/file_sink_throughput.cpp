@@ -0,0 +1,151 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "src/srslog/sinks/file_sink.h"
+#include "src/srslog/sinks/mmap_file_sink.h"
+#include "test/srslog/test_dummies.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+using namespace srslog;
+
+/// Target logging rate in bytes per second.
+static constexpr size_t target_rate = 50 * 1024 * 1024;
+/// Size of each log entry.
+static constexpr size_t entry_size = 256;
+/// Files get rotated once they reach this size.
+static constexpr size_t max_file_size = 128 * 1024 * 1024;
+
+static constexpr char file_sink_filename[] = "file_sink_throughput.log";
+static constexpr char mmap_sink_filename[] = "mmap_file_sink_throughput.log";
+
+/// Builds the formatter of the sinks, which is never used as the benchmark writes pre-formatted entries.
+static std::unique_ptr<log_formatter> make_formatter()
+{
+  return std::unique_ptr<log_formatter>(new test_dummies::log_formatter_dummy);
+}
+
+/// Removes the files written by a sink.
+static void remove_files(const std::string& basename)
+{
+  for (unsigned i = 0; i != 64; ++i) {
+    ::remove(file_utils::build_filename_with_index(basename, i).c_str());
+  }
+}
+
+/// Writes entries into the sink at the target rate for the specified duration, printing the latency distribution of
+/// the write calls, which is the time the backend thread would be stalled by the sink.
+static void run_sustained_rate(sink& s, const char* name, std::chrono::seconds duration)
+{
+  // Entries are written in bursts every millisecond.
+  constexpr std::chrono::milliseconds tick(1);
+  constexpr size_t                    entries_per_tick = target_rate / entry_size / 1000;
+
+  std::string entry(entry_size - 1, 'a');
+  entry.push_back('\n');
+
+  std::vector<uint64_t> latencies;
+  latencies.reserve(duration / tick * entries_per_tick);
+
+  auto begin     = std::chrono::steady_clock::now();
+  auto next_tick = begin;
+  while (next_tick - begin < duration) {
+    for (size_t i = 0; i != entries_per_tick; ++i) {
+      auto t0 = std::chrono::steady_clock::now();
+      s.write(detail::memory_buffer(entry));
+      auto t1 = std::chrono::steady_clock::now();
+      latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+    next_tick += tick;
+    std::this_thread::sleep_until(next_tick);
+  }
+  s.flush();
+  double elapsed =
+      std::chrono::duration_cast<std::chrono::duration<double> >(std::chrono::steady_clock::now() - begin).count();
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&latencies](double p) { return latencies[size_t(p * (latencies.size() - 1))]; };
+
+  fmt::print("{:<15} sustained {:.1f} MB/s | write latency (ns) 50th: {}, 99th: {}, 99.9th: {}, 99.99th: {}, max: {}\n",
+             name,
+             latencies.size() * entry_size / elapsed / (1024 * 1024),
+             percentile(0.5),
+             percentile(0.99),
+             percentile(0.999),
+             percentile(0.9999),
+             latencies.back());
+}
+
+/// Writes entries into the sink as fast as possible, printing the achieved rate.
+static void run_max_rate(sink& s, const char* name, size_t nof_bytes)
+{
+  std::string entry(entry_size - 1, 'a');
+  entry.push_back('\n');
+
+  auto begin = std::chrono::steady_clock::now();
+  for (size_t i = 0, e = nof_bytes / entry_size; i != e; ++i) {
+    s.write(detail::memory_buffer(entry));
+  }
+  s.flush();
+  double elapsed =
+      std::chrono::duration_cast<std::chrono::duration<double> >(std::chrono::steady_clock::now() - begin).count();
+
+  fmt::print("{:<15} unpaced {:.1f} MB/s\n", name, nof_bytes / elapsed / (1024 * 1024));
+}
+
+int main(int argc, char** argv)
+{
+  std::chrono::seconds duration(10);
+  if (argc > 1) {
+    duration = std::chrono::seconds(std::strtoul(argv[1], nullptr, 10));
+  }
+
+  fmt::print("Writing {} byte entries at {} MB/s for {} s, rotating files every {} MB\n",
+             entry_size,
+             target_rate / (1024 * 1024),
+             duration.count(),
+             max_file_size / (1024 * 1024));
+
+  {
+    file_sink s(file_sink_filename, max_file_size, false, make_formatter());
+    run_sustained_rate(s, "file_sink", duration);
+  }
+  remove_files(file_sink_filename);
+  {
+    mmap_file_sink s(mmap_sink_filename, max_file_size, std::chrono::milliseconds(0), make_formatter());
+    run_sustained_rate(s, "mmap_file_sink", duration);
+  }
+  remove_files(mmap_sink_filename);
+
+  {
+    file_sink s(file_sink_filename, max_file_size, false, make_formatter());
+    run_max_rate(s, "file_sink", target_rate * duration.count());
+  }
+  remove_files(file_sink_filename);
+  {
+    mmap_file_sink s(mmap_sink_filename, max_file_size, std::chrono::milliseconds(0), make_formatter());
+    run_max_rate(s, "mmap_file_sink", target_rate * duration.count());
+  }
+  remove_files(mmap_sink_filename);
+
+  return 0;
+}
@@ -21,6 +21,7 @@
 
 #include "srsran/srslog/srslog.h"
 #include <atomic>
+#include <numeric>
 #include <sys/resource.h>
 #include <thread>
 
@@ -56,6 +57,16 @@ private:
   std::atomic<unsigned>& counter;
 };
 
+/// Describes the kind of log entries generated in a benchmark run.
+struct benchmark_scenario {
+  /// Scenario name.
+  const char* name;
+  /// Number of bytes passed as a hex dump for each entry, zero for no hex dump.
+  unsigned hex_dump_len;
+  /// Maximum number of hex dump bytes to be printed, -1 for no limit.
+  int hex_max_size;
+};
+
 } // namespace
 
 /// Busy waits in the calling thread for the specified amount of time.
@@ -69,15 +80,25 @@ static void busy_wait(std::chrono::milliseconds interval)
 }
 
 /// Worker function used for each thread of the benchmark to generate and measure the time taken for each log entry.
-static void run_thread(log_channel& c, std::vector<uint64_t>& results, std::atomic<unsigned>& ctx_counter)
+static void run_thread(log_channel&              c,
+                       const benchmark_scenario& scenario,
+                       std::vector<uint64_t>&    results,
+                       std::atomic<unsigned>&    ctx_counter)
 {
+  std::vector<uint8_t> payload(scenario.hex_dump_len);
+  std::iota(payload.begin(), payload.end(), 0);
+
   for (unsigned iter = 0; iter != num_iterations; ++iter) {
     context_switch_checker ctx_checker(ctx_counter);
 
     auto begin = std::chrono::steady_clock::now();
     for (unsigned entry_num = 0; entry_num != num_entries_per_iter; ++entry_num) {
       double d = entry_num;
-      c("SRSLOG latency benchmark: int: %u, double: %f, string: %s", iter, d, "test");
+      if (payload.empty()) {
+        c("SRSLOG latency benchmark: int: %u, double: %f, string: %s", iter, d, "test");
+      } else {
+        c(payload.data(), payload.size(), "SRSLOG latency benchmark: int: %u, double: %f, string: %s", iter, d, "test");
+      }
     }
     auto end = std::chrono::steady_clock::now();
 
@@ -88,7 +109,7 @@ static void run_thread(log_channel& c, std::vector<uint64_t>& results, std::atom
 }
 
 /// This function runs the latency benchmark generating log entries using the specified number of threads.
-static void benchmark(unsigned num_threads)
+static void benchmark(unsigned num_threads, const benchmark_scenario& scenario)
 {
   std::vector<std::vector<uint64_t> > thread_results;
   thread_results.resize(num_threads);
@@ -97,7 +118,8 @@ static void benchmark(unsigned num_threads)
   }
 
   auto& s       = srslog::fetch_file_sink("srslog_latency_benchmark.txt");
-  auto& channel = srslog::fetch_log_channel("bench", s, {});
+  auto& channel = srslog::fetch_log_channel(fmt::format("bench_{}", scenario.name), s, {});
+  channel.set_hex_dump_max_size(scenario.hex_max_size);
 
   srslog::init();
 
@@ -106,7 +128,8 @@ static void benchmark(unsigned num_threads)
 
   std::atomic<unsigned> ctx_counter(0);
   for (unsigned i = 0; i != num_threads; ++i) {
-    workers.emplace_back(run_thread, std::ref(channel), std::ref(thread_results[i]), std::ref(ctx_counter));
+    workers.emplace_back(
+        run_thread, std::ref(channel), std::cref(scenario), std::ref(thread_results[i]), std::ref(ctx_counter));
   }
   for (auto& w : workers) {
     w.join();
@@ -119,11 +142,12 @@ static void benchmark(unsigned num_threads)
   }
   std::sort(results.begin(), results.end());
 
-  fmt::print("SRSLOG Frontend Latency Benchmark - logging with {} thread{}\n"
+  fmt::print("SRSLOG Frontend Latency Benchmark - {} - logging with {} thread{}\n"
              "All values in nanoseconds\n"
              "Percentiles: | 50th | 75th | 90th | 99th | 99.9th | Worst |\n"
              "             |{:6}|{:6}|{:6}|{:6}|{:8}|{:7}|\n"
              "Context switches: {} in {} of generated entries\n\n",
+             scenario.name,
              num_threads,
              (num_threads > 1) ? "s" : "",
              results[static_cast<size_t>(results.size() * 0.5)],
@@ -138,8 +162,15 @@ static void benchmark(unsigned num_threads)
 
 int main()
 {
-  for (auto n : {1, 2, 4}) {
-    benchmark(n);
+  const benchmark_scenario scenarios[] = {{"no hex dump", 0, -1},
+                                          {"64B hex dump", 64, -1},
+                                          {"1500B hex dump limited to 128B", 1500, 128},
+                                          {"1500B hex dump", 1500, -1}};
+
+  for (const auto& scenario : scenarios) {
+    for (auto n : {1, 2, 4}) {
+      benchmark(n, scenario);
+    }
   }
 
   return 0;
@@ -0,0 +1,214 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "file_test_utils.h"
+#include "src/srslog/formatters/binary_decoder.h"
+#include "src/srslog/sinks/binary_file_sink.h"
+#include "srsran/srslog/detail/log_entry_metadata.h"
+#include "testing_helpers.h"
+#include <numeric>
+
+using namespace srslog;
+
+static constexpr char log_filename[] = "binary_formatter_test.bin";
+
+static const char* const cstring_arg = "cstr";
+
+/// Helper to build the log entry with the specified index, filling in the argument store.
+static detail::log_entry_metadata build_log_entry_metadata(unsigned                                            i,
+                                                           fmt::dynamic_format_arg_store<fmt::printf_context>& store)
+{
+  using tp_ty = std::chrono::time_point<std::chrono::high_resolution_clock>;
+  tp_ty tp(std::chrono::microseconds(50000 + 1234567 * i));
+
+  switch (i % 4) {
+    case 0:
+      store.push_back(88);
+      return {tp, {10, true}, "Text %d", &store, "ABC", 'Z'};
+    case 1:
+      store.push_back(static_cast<unsigned>(i));
+      store.push_back(-5000000000LL);
+      store.push_back(18000000000000000000ULL);
+      store.push_back(true);
+      store.push_back('c');
+      return {tp, {0, false}, "u=%u ll=%lld ull=%llu b=%s c=%c", &store, "LONG_NAME", '\0'};
+    case 2: {
+      store.push_back(1.5f);
+      store.push_back(-2.25);
+      store.push_back(cstring_arg);
+      store.push_back(std::string("string"));
+      detail::log_entry_metadata entry = {tp, {i, true}, "f=%.2f d=%g s=%s %s", &store, "", 'D'};
+      entry.hex_dump.resize(20);
+      std::iota(entry.hex_dump.begin(), entry.hex_dump.end(), i);
+      return entry;
+    }
+    default:
+      return {tp, {0, false}, "Without args", nullptr, "ABC", 'I'};
+  }
+}
+
+/// Decodes the binary log file in the specified path, returns an empty string on error.
+static std::string decode_file(const std::string& path)
+{
+  std::FILE* file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    return {};
+  }
+
+  binary_decoder     decoder(file);
+  fmt::memory_buffer buffer;
+  bool               finished = false;
+  bool               success  = !decoder.read_header();
+  while (success && !finished) {
+    success = !decoder.decode_next(buffer, finished);
+  }
+  std::fclose(file);
+
+  return (success) ? fmt::to_string(buffer) : std::string();
+}
+
+static bool when_entries_are_decoded_then_output_matches_text_formatter()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  binary_file_sink                     sink(log_filename, 0, false);
+  text_formatter                       text;
+  fmt::memory_buffer                   expected;
+
+  for (unsigned i = 0; i != 16; ++i) {
+    fmt::dynamic_format_arg_store<fmt::printf_context> store;
+    fmt::memory_buffer                                 buffer;
+    sink.get_formatter().format(build_log_entry_metadata(i, store), buffer);
+    sink.write(detail::memory_buffer(buffer.data(), buffer.size()));
+
+    fmt::dynamic_format_arg_store<fmt::printf_context> text_store;
+    text.format(build_log_entry_metadata(i, text_store), expected);
+  }
+  sink.flush();
+
+  ASSERT_EQ(decode_file(log_filename), fmt::to_string(expected));
+
+  return true;
+}
+
+static bool when_format_string_is_repeated_then_it_is_not_emitted_again()
+{
+  binary_formatter   formatter;
+  fmt::memory_buffer first;
+  fmt::memory_buffer second;
+
+  fmt::dynamic_format_arg_store<fmt::printf_context> store;
+  formatter.format(build_log_entry_metadata(0, store), first);
+  store.clear();
+  formatter.format(build_log_entry_metadata(0, store), second);
+
+  // The first entry carries the string records of the log name and the format string.
+  ASSERT_EQ(first.size(), second.size() + 2 * (1 + 2 * sizeof(uint32_t)) + std::strlen("ABC") + std::strlen("Text %d"));
+
+  return true;
+}
+
+namespace {
+DECLARE_METRIC("SNR", snr_t, float, "dB");
+DECLARE_METRIC_SET("RF", rf_set, snr_t);
+using ctx_t = srslog::build_context_type<rf_set>;
+} // namespace
+
+static bool when_context_is_decoded_then_output_matches_text_formatter()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  binary_file_sink                     sink(log_filename, 0, false);
+  text_formatter                       text;
+  fmt::memory_buffer                   expected;
+
+  ctx_t ctx("Context");
+  ctx.get<rf_set>().write<snr_t>(5.1);
+
+  for (bool with_message : {false, true}) {
+    fmt::dynamic_format_arg_store<fmt::printf_context> store;
+    auto                                               entry = build_log_entry_metadata(0, store);
+    entry.fmtstring                                          = (with_message) ? entry.fmtstring : nullptr;
+    fmt::memory_buffer buffer;
+    sink.get_formatter().format_ctx(ctx, std::move(entry), buffer);
+    sink.write(detail::memory_buffer(buffer.data(), buffer.size()));
+
+    fmt::dynamic_format_arg_store<fmt::printf_context> text_store;
+    auto                                               text_entry = build_log_entry_metadata(0, text_store);
+    text_entry.fmtstring                                          = (with_message) ? text_entry.fmtstring : nullptr;
+    text.format_ctx(ctx, std::move(text_entry), expected);
+  }
+  sink.flush();
+
+  ASSERT_EQ(decode_file(log_filename), fmt::to_string(expected));
+
+  return true;
+}
+
+static bool when_file_is_rotated_then_each_file_is_decoded_on_its_own()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(log_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(log_filename, 1);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1};
+
+  // Write entries until the first file gets rotated.
+  binary_file_sink   sink(log_filename, 4 * 1024, false);
+  text_formatter     text;
+  fmt::memory_buffer expected_file0;
+  fmt::memory_buffer expected_file1;
+  size_t             written = binary_log::header_size;
+
+  for (unsigned i = 0; i != 256 && !file_test_utils::file_exists(filename1); ++i) {
+    fmt::dynamic_format_arg_store<fmt::printf_context> store;
+    fmt::memory_buffer                                 buffer;
+    sink.get_formatter().format(build_log_entry_metadata(i, store), buffer);
+    sink.write(detail::memory_buffer(buffer.data(), buffer.size()));
+    written += buffer.size();
+
+    fmt::dynamic_format_arg_store<fmt::printf_context> text_store;
+    text.format(build_log_entry_metadata(i, text_store), expected_file0);
+  }
+  ASSERT_EQ(written >= 4 * 1024, true);
+
+  for (unsigned i = 0; i != 4; ++i) {
+    fmt::dynamic_format_arg_store<fmt::printf_context> store;
+    fmt::memory_buffer                                 buffer;
+    sink.get_formatter().format(build_log_entry_metadata(i, store), buffer);
+    sink.write(detail::memory_buffer(buffer.data(), buffer.size()));
+
+    fmt::dynamic_format_arg_store<fmt::printf_context> text_store;
+    text.format(build_log_entry_metadata(i, text_store), expected_file1);
+  }
+  sink.flush();
+
+  ASSERT_EQ(decode_file(filename0), fmt::to_string(expected_file0));
+  ASSERT_EQ(decode_file(filename1), fmt::to_string(expected_file1));
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_entries_are_decoded_then_output_matches_text_formatter);
+  TEST_FUNCTION(when_format_string_is_repeated_then_it_is_not_emitted_again);
+  TEST_FUNCTION(when_context_is_decoded_then_output_matches_text_formatter);
+  TEST_FUNCTION(when_file_is_rotated_then_each_file_is_decoded_on_its_own);
+
+  return 0;
+}
@@ -44,6 +44,13 @@ public:
 
   fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() override { return &store; }
 
+  detail::hex_dump_buffer alloc_hex_dump(const uint8_t* data, size_t len) override
+  {
+    detail::hex_dump_buffer buffer(len);
+    std::copy(data, data + len, buffer.begin());
+    return buffer;
+  }
+
   bool is_running() const override { return true; }
 
   void reset() { count = 0; }
@@ -0,0 +1,195 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "file_test_utils.h"
+#include "src/srslog/sinks/mmap_file_sink.h"
+#include "test_dummies.h"
+#include "testing_helpers.h"
+#include <csignal>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <thread>
+
+using namespace srslog;
+
+static constexpr char log_filename[] = "mmap_file_sink_test.log";
+
+/// Returns the size of the file in the specified path.
+static size_t get_file_size(const std::string& path)
+{
+  struct stat st = {};
+  ::stat(path.c_str(), &st);
+  return st.st_size;
+}
+
+/// A Test-Specific Subclass of mmap_file_sink. This subclass provides public
+/// access to the data members of the parent class.
+class mmap_file_sink_subclass : public mmap_file_sink
+{
+public:
+  mmap_file_sink_subclass(std::string name, size_t max_size, std::chrono::milliseconds rotation_period) :
+    mmap_file_sink(std::move(name),
+                   max_size,
+                   rotation_period,
+                   std::unique_ptr<log_formatter>(new test_dummies::log_formatter_dummy),
+                   8 * 1024)
+  {}
+
+  uint32_t get_num_of_files() const { return get_file_index(); }
+};
+
+static bool when_data_is_written_to_file_then_contents_are_valid()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+  std::vector<std::string>             entries;
+  {
+    // Use small segments to write across several of them.
+    mmap_file_sink_subclass file(log_filename, 0, std::chrono::milliseconds(0));
+
+    for (unsigned i = 0; i != 2000; ++i) {
+      std::string entry = "Test log entry - " + std::to_string(i) + '\n';
+      file.write(detail::memory_buffer(entry));
+      entries.push_back(entry);
+    }
+    file.flush();
+
+    ASSERT_EQ(file.get_num_of_files(), 1);
+  }
+
+  // Preallocated space is trimmed on close.
+  size_t expected_size = 0;
+  for (const auto& entry : entries) {
+    expected_size += entry.size();
+  }
+  ASSERT_EQ(get_file_size(log_filename), expected_size);
+  ASSERT_EQ(file_test_utils::compare_file_contents(log_filename, entries), true);
+
+  return true;
+}
+
+static bool when_data_written_exceeds_size_threshold_then_new_file_is_created()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(log_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(log_filename, 1);
+  std::string                          filename2 = file_utils::build_filename_with_index(log_filename, 2);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1, filename2};
+
+  {
+    mmap_file_sink_subclass file(log_filename, 5001, std::chrono::milliseconds(0));
+
+    // Build a 1000 byte entry.
+    std::string entry(1000, 'a');
+
+    // Fill in the file with 5000 bytes, one byte less than the threshold.
+    for (unsigned i = 0; i != 5; ++i) {
+      file.write(detail::memory_buffer(entry));
+    }
+    ASSERT_EQ(file.get_num_of_files(), 1);
+
+    // Trigger a file rotation.
+    file.write(detail::memory_buffer(entry));
+    ASSERT_EQ(file.get_num_of_files(), 2);
+
+    // Fill in the second file with 5000 bytes and trigger a new rotation.
+    for (unsigned i = 0; i != 5; ++i) {
+      file.write(detail::memory_buffer(entry));
+    }
+    ASSERT_EQ(file.get_num_of_files(), 3);
+  }
+
+  // Closed files are trimmed once the sink has finished with them.
+  ASSERT_EQ(get_file_size(filename0), 5000);
+  ASSERT_EQ(get_file_size(filename1), 5000);
+  ASSERT_EQ(get_file_size(filename2), 1000);
+
+  return true;
+}
+
+static bool when_rotation_period_expires_then_new_file_is_created()
+{
+  std::string                          filename0 = file_utils::build_filename_with_index(log_filename, 0);
+  std::string                          filename1 = file_utils::build_filename_with_index(log_filename, 1);
+  file_test_utils::scoped_file_deleter deleter   = {filename0, filename1};
+
+  std::string entry = "Test log entry\n";
+  {
+    mmap_file_sink_subclass file(log_filename, 0, std::chrono::milliseconds(50));
+
+    file.write(detail::memory_buffer(entry));
+    file.write(detail::memory_buffer(entry));
+    ASSERT_EQ(file.get_num_of_files(), 1);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+    file.write(detail::memory_buffer(entry));
+    ASSERT_EQ(file.get_num_of_files(), 2);
+  }
+
+  ASSERT_EQ(file_test_utils::compare_file_contents(filename0, {entry, entry}), true);
+  ASSERT_EQ(file_test_utils::compare_file_contents(filename1, {entry}), true);
+
+  return true;
+}
+
+static bool when_file_cannot_grow_then_write_returns_error()
+{
+  file_test_utils::scoped_file_deleter deleter(log_filename);
+
+  // Limit the file size to two segments, so that the third one can not be reserved.
+  struct rlimit old_limit = {};
+  ::getrlimit(RLIMIT_FSIZE, &old_limit);
+  struct rlimit limit = old_limit;
+  limit.rlim_cur      = 16 * 1024;
+  ::setrlimit(RLIMIT_FSIZE, &limit);
+  auto old_handler = std::signal(SIGXFSZ, SIG_IGN);
+
+  bool error_reported = false;
+  {
+    mmap_file_sink_subclass file(log_filename, 0, std::chrono::milliseconds(0));
+
+    std::string entry(1000, 'a');
+    for (unsigned i = 0; i != 32 && !error_reported; ++i) {
+      error_reported = static_cast<bool>(file.write(detail::memory_buffer(entry)));
+    }
+
+    // The file stays closed and keeps reporting the error.
+    ASSERT_EQ(static_cast<bool>(file.write(detail::memory_buffer(entry))), true);
+    ASSERT_EQ(static_cast<bool>(file.flush()), true);
+  }
+
+  ::setrlimit(RLIMIT_FSIZE, &old_limit);
+  std::signal(SIGXFSZ, old_handler);
+
+  ASSERT_EQ(error_reported, true);
+  ASSERT_EQ(get_file_size(log_filename), 16 * 1024);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_data_is_written_to_file_then_contents_are_valid);
+  TEST_FUNCTION(when_data_written_exceeds_size_threshold_then_new_file_is_created);
+  TEST_FUNCTION(when_rotation_period_expires_then_new_file_is_created);
+  TEST_FUNCTION(when_file_cannot_grow_then_write_returns_error);
+
+  return 0;
+}
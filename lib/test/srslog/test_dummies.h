@@ -84,6 +84,8 @@ public:
   bool is_running() const override { return true; }
 
   fmt::dynamic_format_arg_store<fmt::printf_context>* alloc_arg_store() override { return nullptr; }
+
+  srslog::detail::hex_dump_buffer alloc_hex_dump(const uint8_t* data, size_t len) override { return {}; }
 };
 
 } // namespace test_dummies
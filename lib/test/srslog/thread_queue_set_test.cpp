@@ -0,0 +1,170 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/srslog/detail/support/thread_queue_set.h"
+#include "testing_helpers.h"
+#include <thread>
+
+using namespace srslog;
+
+namespace {
+
+/// Element pushed by the producer threads.
+struct item {
+  unsigned producer;
+  unsigned seq;
+};
+
+} // namespace
+
+static bool when_threads_push_elements_then_order_is_preserved_per_thread()
+{
+  constexpr unsigned nof_producers = 4;
+  constexpr unsigned nof_items     = 100000;
+
+  detail::thread_queue_set<item> queues(1024);
+  std::atomic<unsigned>                nof_finished{0};
+
+  std::vector<std::thread> producers;
+  for (unsigned p = 0; p != nof_producers; ++p) {
+    producers.emplace_back([&queues, &nof_finished, p]() {
+      for (unsigned i = 0; i != nof_items;) {
+        // Retry on full queue so that every element gets through.
+        if (queues.push({p, i})) {
+          ++i;
+        }
+      }
+      ++nof_finished;
+    });
+  }
+
+  std::vector<unsigned> next_seq(nof_producers, 0);
+  bool                  in_order = true;
+  unsigned              count    = 0;
+  while (count != nof_producers * nof_items) {
+    size_t n = queues.pop_round(
+        [&](item&& elem) {
+          in_order &= (elem.seq == next_seq[elem.producer]);
+          next_seq[elem.producer] = elem.seq + 1;
+        },
+        32);
+    count += n;
+    if (n == 0) {
+      queues.wait(10);
+    }
+  }
+
+  for (auto& t : producers) {
+    t.join();
+  }
+
+  ASSERT_EQ(in_order, true);
+  ASSERT_EQ(nof_finished.load(), nof_producers);
+
+  return true;
+}
+
+static bool when_queue_is_full_then_drops_are_reported_per_thread()
+{
+  detail::thread_queue_set<item> queues(16);
+
+  std::thread producer([&queues]() {
+    ::pthread_setname_np(::pthread_self(), "producer");
+    for (unsigned i = 0; i != 20; ++i) {
+      queues.push({0, i});
+    }
+  });
+  producer.join();
+
+  unsigned nof_reports = 0;
+  queues.report_drops([&nof_reports](const detail::thread_queue_set<item>::drop_report& report) {
+    ++nof_reports;
+    if (report.thread_name == "producer" && report.nof_new_dropped == 4 && report.nof_dropped == 4) {
+      ++nof_reports;
+    }
+  });
+  ASSERT_EQ(nof_reports, 2);
+
+  // Drops are only reported once.
+  queues.report_drops([&nof_reports](const detail::thread_queue_set<item>::drop_report& report) { ++nof_reports; });
+  ASSERT_EQ(nof_reports, 2);
+
+  // The queue of the exited thread still holds its elements.
+  unsigned count = queues.pop_round([](item&& elem) {}, 32);
+  ASSERT_EQ(count, 16);
+
+  return true;
+}
+
+static bool when_queue_is_created_then_storage_grows_on_demand()
+{
+  detail::spsc_queue<item> queue(1000);
+  ASSERT_EQ(queue.get_capacity(), 1024);
+  ASSERT_EQ(queue.get_allocated_size(), 0);
+
+  // Pushing a few elements only allocates the first segment.
+  for (unsigned i = 0; i != 10; ++i) {
+    queue.push({0, i});
+  }
+  size_t first_segment = queue.get_allocated_size();
+  ASSERT_NE(first_segment, 0);
+  ASSERT_EQ(first_segment < queue.get_capacity(), true);
+
+  // Going round the whole queue allocates all of it once and keeps the order.
+  for (unsigned i = 10; i != 3000; ++i) {
+    if (!queue.push({0, i})) {
+      break;
+    }
+    ASSERT_EQ(queue.try_pop().second.seq, i - 10);
+  }
+  ASSERT_EQ(queue.get_allocated_size(), queue.get_capacity());
+
+  return true;
+}
+
+static bool when_capacity_is_changed_then_new_threads_get_it()
+{
+  detail::thread_queue_set<item> queues(16);
+  queues.set_capacity(32);
+  ASSERT_EQ(queues.get_capacity(), 32);
+
+  std::thread producer([&queues]() {
+    for (unsigned i = 0; i != 40; ++i) {
+      queues.push({0, i});
+    }
+  });
+  producer.join();
+
+  unsigned count = queues.pop_round([](item&& elem) {}, 64);
+  ASSERT_EQ(count, 32);
+
+  return true;
+}
+
+int main()
+{
+  TEST_FUNCTION(when_threads_push_elements_then_order_is_preserved_per_thread);
+  TEST_FUNCTION(when_queue_is_full_then_drops_are_reported_per_thread);
+  TEST_FUNCTION(when_queue_is_created_then_storage_grows_on_demand);
+  TEST_FUNCTION(when_capacity_is_changed_then_new_threads_get_it);
+
+  return 0;
+}
@@ -67,6 +67,7 @@ public:
     srsran_subcarrier_spacing_t scs              = srsran_subcarrier_spacing_15kHz;
     uint32_t                    pusch_max_its    = 10;
     float                       pusch_min_snr_dB = -10.0f;
+    uint32_t                    polar_list_size  = 0; ///< UCI polar list decoder size, 0 or 1 for the SSC decoder
     double                      srate_hz         = 0.0;
   };
 
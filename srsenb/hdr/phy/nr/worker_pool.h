@@ -107,6 +107,7 @@ public:
     uint32_t               prio              = 52;
     uint32_t               pusch_max_its     = 10;
     float                  pusch_min_snr_dB  = -10;
+    uint32_t               polar_list_size   = 0; ///< UCI polar list decoder size, 0 or 1 for the SSC decoder
     srsran::phy_log_args_t log               = {};
   };
   slot_worker* operator[](std::size_t pos) { return workers.at(pos).get(); }
@@ -63,6 +63,7 @@ struct phy_args_t {
   float                   max_prach_offset_us = 10;
   uint32_t                pusch_max_its       = 10;
   uint32_t                nr_pusch_max_its    = 10;
+  uint32_t                nr_polar_list_size  = 0;
   bool                    pusch_8bit_decoder  = false;
   float                   tx_amplitude        = 1.0f;
   uint32_t                nof_phy_threads     = 1;
@@ -72,6 +73,7 @@ struct phy_args_t {
   bool                    pusch_meas_evm      = false;
   bool                    pusch_meas_ta       = true;
   bool                    pucch_meas_ta       = true;
+  bool                    pucch_joint_det     = false;
   uint32_t                nof_prach_threads   = 1;
   bool                    extended_cp         = false;
   srsran::channel::args_t dl_channel_args;
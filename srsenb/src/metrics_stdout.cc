@@ -173,6 +173,13 @@ void metrics_stdout::set_metrics_helper(uint32_t                          num_ue
     } else {
       fmt::print(" {:>3}%", 0);
     }
+    // Average number of decoder iterations per code block
+    float fec_iters = (is_nr) ? mac.ues[i].fec_iters : phy[i].ul.turbo_iters;
+    if (not isnan(fec_iters) and not iszero(fec_iters)) {
+      fmt::print(" {:>4.1f}", fec_iters);
+    } else {
+      fmt::print(" {:>4.4}", "n/a");
+    }
     fmt::print(" {:>6.6}", float_to_eng_string(mac.ues[i].ul_buffer, 2));
     fmt::print("\n");
   }
@@ -188,6 +195,11 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  // Only unpaced virtual radios run faster than real time
+  if (metrics.rf.rf_speedup > 1.1f) {
+    fmt::print("RF speed-up: {:.1f}x\n", metrics.rf.rf_speedup);
+  }
+
   if (metrics.stack.rrc.ues.size() == 0 && metrics.nr_stack.mac.ues.size() == 0) {
     return;
   }
@@ -196,9 +208,9 @@ void metrics_stdout::set_metrics(const enb_metrics_t& metrics, const uint32_t pe
     n_reports = 0;
     fmt::print("\n");
     fmt::print(
-        "               -----------------DL----------------|-------------------------UL-------------------------\n");
+        "               -----------------DL----------------|---------------------------UL----------------------------\n");
     fmt::print(
-        "rat  pci rnti  cqi  ri  mcs  brate   ok  nok  (%) | pusch  pucch  phr  mcs  brate   ok  nok  (%)    bsr\n");
+        "rat  pci rnti  cqi  ri  mcs  brate   ok  nok  (%) | pusch  pucch  phr  mcs  brate   ok  nok  (%) iter    bsr\n");
   }
 
   set_metrics_helper(metrics.stack.rrc.ues.size(), metrics.stack.mac, metrics.phy, false);
@@ -62,10 +62,11 @@ public:
     metrics[0].stack.mac.ues[0].dl_pmi    = 1.0;
     metrics[0].stack.mac.ues[0].phr       = 12.0;
     metrics[0].phy.resize(2);
-    metrics[0].phy[0].dl.mcs        = 28.0;
-    metrics[0].phy[0].ul.mcs        = 20.2;
-    metrics[0].phy[0].ul.pucch_sinr = 14.2;
-    metrics[0].phy[0].ul.pusch_sinr = 14.2;
+    metrics[0].phy[0].dl.mcs         = 28.0;
+    metrics[0].phy[0].ul.mcs         = 20.2;
+    metrics[0].phy[0].ul.pucch_sinr  = 14.2;
+    metrics[0].phy[0].ul.pusch_sinr  = 14.2;
+    metrics[0].phy[0].ul.turbo_iters = 2.5;
 
     metrics[0].rf.rf_o = 10;
     metrics[0].nr_stack.mac.ues.resize(1);
@@ -86,6 +87,7 @@ public:
     metrics[0].nr_stack.mac.ues[0].ul_mcs     = 22;
     metrics[0].nr_stack.mac.ues[0].pusch_sinr = 14;
     metrics[0].nr_stack.mac.ues[0].pucch_sinr = 14.7;
+    metrics[0].nr_stack.mac.ues[0].fec_iters  = 3.2;
 
     // second
     metrics[1].rf.rf_o = 10;
@@ -26,6 +26,7 @@
 #include <boost/program_options.hpp>
 #include <boost/program_options/options_description.hpp>
 #include <boost/program_options/parsers.hpp>
+#include <chrono>
 #include <iostream>
 #include <mutex>
 #include <srsenb/hdr/phy/phy.h>
@@ -286,6 +287,8 @@ private:
   uint8_t*                                          data                                                    = nullptr;
   uint16_t                                          ue_rnti                                                 = 0;
   srsran_random_t                                   random_gen                                              = nullptr;
+  uint32_t                                          nof_false_sr                                            = 0;
+  bool                                              false_sr_check                                          = true;
 
   CALLBACK(sr_detected);
   CALLBACK(rach_detected);
@@ -421,10 +424,23 @@ public:
     active_cell_list = active_cell_list_;
   }
 
+  void set_false_sr_check(bool enable)
+  {
+    std::lock_guard<std::mutex> lock(phy_mac_mutex);
+    false_sr_check = enable;
+  }
+
   int sr_detected(uint32_t tti, uint16_t rnti) override
   {
     std::lock_guard<std::mutex> lock(phy_mac_mutex);
 
+    // Only the test UE transmits, any other UE sharing the PUCCH is silent
+    if (rnti != ue_rnti) {
+      logger.error("Received false SR tti=%d; rnti=0x%x", tti, rnti);
+      nof_false_sr++;
+      return SRSRAN_SUCCESS;
+    }
+
     tti_sr_info_t tti_sr_info = {};
     tti_sr_info.tti           = tti;
     tti_sr_info_queue.push(tti_sr_info);
@@ -762,6 +778,7 @@ public:
     }
 
     //  Check SR match with TTI
+    TESTASSERT(not false_sr_check or nof_false_sr == 0);
     size_t req_queue_size = (enable_assert) ? 1 : 0;
     while (tti_sr_info_queue.size() > req_queue_size) {
       tti_sr_info_t tti_sr_info1 = tti_sr_info_queue.front();
@@ -1175,6 +1192,8 @@ public:
     uint32_t              period_pcell_rotate = 0;
     srsran_tm_t           tm                  = SRSRAN_TM1;
     bool                  extended_cp         = false;
+    uint32_t              pucch_load          = 0;     ///< Silent UEs with SR on the same PUCCH Format 1 PRBs
+    bool                  pucch_joint_det     = false; ///< Joint PUCCH Format 1 detection of the UEs of a PRB
     args_t()
     {
       cell.nof_prb   = 6;
@@ -1208,7 +1227,7 @@ public:
 private:
   // Test constants
   static const uint32_t delta_pucch = 1;
-  static const uint32_t N_pucch_1   = 12;
+  uint32_t              N_pucch_1   = 12; ///< Extended past the SR resources of the load UEs
 
   // Private classes
   unique_dummy_radio_t  radio;
@@ -1243,6 +1262,7 @@ public:
     // PHY arguments
     phy_args.log.phy_level   = args.log_level;
     phy_args.nof_phy_threads = 1; ///< Set number of phy threads to 1 for avoiding concurrency issues
+    phy_args.pucch_joint_det = args.pucch_joint_det;
 
     // Create cell configuration
     phy_cfg.phy_cell_cfg.resize(args.nof_enb_cells);
@@ -1271,6 +1291,9 @@ public:
 
   int init()
   {
+    // Leave n_pucch 1 to pucch_load for the load UEs SR
+    N_pucch_1 = SRSRAN_MAX(N_pucch_1, args.pucch_load + 1);
+
     // Create base UE dedicated configuration
     srsran::phy_cfg_t dedicated = {};
 
@@ -1336,6 +1359,10 @@ public:
     stack = unique_dummy_stack_t(new dummy_stack(phy_cfg, phy_rrc_cfg, args.log_level, args.rnti));
     stack->set_active_cell_list(args.ue_cell_list);
 
+    // The per-UE detector correlates the leakage of the test UE into the silent load UEs resources on the ideal
+    // channel, only the joint detector is expected to reject them
+    stack->set_false_sr_check(args.pucch_load == 0 or args.pucch_joint_det);
+
     /// Initiate eNb PHY with the given RNTI
     if (enb_phy->init(phy_args, phy_cfg, radio.get(), stack.get(), this) < 0) {
       return SRSRAN_ERROR;
@@ -1344,6 +1371,17 @@ public:
     enb_phy->complete_config(args.rnti);
     enb_phy->set_activation_deactivation_scell(args.rnti, activation);
 
+    /// Load UEs: PCell only, no CQI, SR in the same TTI as the test UE, different cyclic shift or cover
+    for (uint32_t i = 0; i < args.pucch_load; i++) {
+      srsenb::phy_interface_rrc_lte::phy_rrc_cfg_list_t load_cfg = {phy_rrc_cfg[0]};
+      load_cfg[0].phy_cfg.dl_cfg.cqi_report.periodic_configured = false;
+      load_cfg[0].phy_cfg.ul_cfg.pucch.n_pucch_sr               = i + 1;
+
+      uint16_t load_rnti = args.rnti + i + 1;
+      enb_phy->set_config(load_rnti, load_cfg);
+      enb_phy->complete_config(load_rnti);
+    }
+
     /// Create dummy UE instance
     ue_phy = unique_dummy_ue_phy_t(new dummy_ue(radio.get(), phy_cfg.phy_cell_cfg, args.log_level, args.rnti));
 
@@ -1462,6 +1500,8 @@ int parse_args(int argc, char** argv, phy_test_bench::args_t& args)
       ("cell.cp",        bpo::value<bool>(&args.extended_cp)->default_value(false),                      "use extended CP")
       ("tm", bpo::value<uint32_t>(&args.tm_u32)->default_value(args.tm_u32),                             "Transmission mode")
       ("rotation", bpo::value<uint32_t>(&args.period_pcell_rotate),                      "Serving cells rotation period in ms, set to zero to disable")
+      ("pucch_load", bpo::value<uint32_t>(&args.pucch_load),                             "Number of silent UEs with SR sharing the PUCCH Format 1 PRBs")
+      ("pucch_joint_det", bpo::value<bool>(&args.pucch_joint_det)->default_value(false), "Detect the PUCCH Format 1 of the UEs sharing a PRB jointly")
       ;
   options.add(common).add_options()("help", "Show this message");
   // clang-format on
@@ -1520,12 +1560,20 @@ int main(int argc, char** argv)
   }
 
   // Run Simulation
+  auto t_start = std::chrono::steady_clock::now();
   for (uint32_t i = 0; i < test_args.duration and err_code >= SRSRAN_SUCCESS; i++) {
     err_code = test_bench->run_tti();
   }
+  auto t_end = std::chrono::steady_clock::now();
 
   test_bench->stop();
 
+  if (test_args.pucch_load > 0) {
+    double elapsed_us = std::chrono::duration<double, std::micro>(t_end - t_start).count();
+    std::cout << "PUCCH load: " << test_args.pucch_load + 1 << " UEs; " << elapsed_us / test_args.duration
+              << " us/TTI" << std::endl;
+  }
+
   srslog::flush();
 
   if (err_code >= SRSRAN_SUCCESS) {
@@ -28,13 +28,18 @@
 #ifndef SRSEPC_HSS_H
 #define SRSEPC_HSS_H
 
+#include "hss_milenage.h"
+#include "hss_ue_db.h"
 #include "srsran/common/buffer_pool.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <cstddef>
 
+#include <deque>
 #include <map>
+#include <mutex>
 
 #define LTE_FDD_ENB_IND_HE_N_BITS 5
 #define LTE_FDD_ENB_IND_HE_MASK 0x1FUL
@@ -45,34 +50,13 @@ namespace srsepc {
 
 struct hss_args_t {
   std::string db_file;
+  std::string db_snapshot; // Binary snapshot of db_file, empty to rewrite db_file on exit instead
+  uint32_t    auth_workers; // Threads generating the authentication vectors requested by the MME
   uint16_t    mcc;
   uint16_t    mnc;
 };
 
-enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
-
-struct hss_ue_ctx_t {
-  // Members
-  std::string        name;
-  uint64_t           imsi;
-  enum hss_auth_algo algo;
-  uint8_t            key[16];
-  bool               op_configured;
-  uint8_t            op[16];
-  uint8_t            opc[16];
-  uint8_t            amf[2];
-  uint8_t            sqn[6];
-  uint16_t           qci;
-  uint8_t            last_rand[16];
-  std::string        static_ip_addr;
-
-  // Helper getters/setters
-  void set_sqn(const uint8_t* sqn_);
-  void set_last_rand(const uint8_t* rand_);
-  void get_last_rand(uint8_t* rand_);
-};
-
-class hss : public hss_interface_nas
+class hss : public hss_interface_nas, public hss_interface_mme
 {
 public:
   static hss* get_instance(void);
@@ -81,10 +65,15 @@ public:
   void        stop(void);
 
   virtual bool gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres);
+  virtual bool request_auth_info(uint64_t imsi, uint32_t mme_ue_s1ap_id);
   virtual bool gen_update_loc_answer(uint64_t imsi, uint8_t* qci);
 
   virtual bool resync_sqn(uint64_t imsi, uint8_t* auts);
 
+  // Asynchronous authentication vectors, the fd becomes readable when answers are ready
+  virtual int  get_auth_info_fd();
+  virtual void get_auth_info_answers(std::vector<hss_auth_info_answer_t>& answers);
+
   std::map<std::string, uint64_t> get_ip_to_imsi() const;
 
 private:
@@ -92,12 +81,22 @@ private:
   virtual ~hss();
   static hss* m_instance;
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > m_imsi_to_ue_ctx;
+  hss_ue_db m_ue_db;
+
+  // Maximum number of authentication vectors generated together by a worker
+  constexpr static uint32_t max_auth_batch = 16;
+
+  struct auth_request_t {
+    uint64_t imsi;
+    uint32_t mme_ue_s1ap_id;
+  };
 
   void gen_rand(uint8_t rand_[16]);
 
-  void
-       gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres);
+  void gen_auth_info_answers(hss_auth_info_answer_t* answers, uint32_t nof_answers);
+  void process_auth_requests();
+
+  void gen_auth_info_answer_milenage(const milenage_vector_t& vec, uint8_t* k_asme, uint8_t* autn, uint8_t* xres);
   void gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres);
 
   void resync_sqn_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* auts);
@@ -109,14 +108,17 @@ private:
   void increment_seq_after_resync(hss_ue_ctx_t* ue_ctx);
   void increment_sqn(uint8_t* sqn, uint8_t* next_sqn);
 
-  bool          set_auth_algo(std::string auth_algo);
-  bool          read_db_file(std::string db_file);
-  bool          write_db_file(std::string db_file);
-  hss_ue_ctx_t* get_ue_ctx(uint64_t imsi);
+  bool set_auth_algo(std::string auth_algo);
+  bool read_db_file(std::string db_file);
+  bool write_db_file(std::string db_file);
+  bool read_db_snapshot(const std::string& db_filename, const std::string& snapshot_filename);
+  bool get_db_source(const std::string& db_filename, hss_db_source_t* source);
 
   std::string hex_string(uint8_t* hex, int size);
 
-  std::string db_file;
+  std::string     db_file;
+  std::string     db_snapshot;
+  hss_db_source_t db_source;
 
   /*Logs*/
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("HSS");
@@ -125,21 +127,14 @@ private:
   uint16_t mnc;
 
   std::map<std::string, uint64_t> m_ip_to_imsi;
-};
-
-inline void hss_ue_ctx_t::set_sqn(const uint8_t* sqn_)
-{
-  memcpy(sqn, sqn_, 6);
-}
 
-inline void hss_ue_ctx_t::set_last_rand(const uint8_t* last_rand_)
-{
-  memcpy(last_rand, last_rand_, 16);
-}
+  // Authentication vectors requested by the MME, generated in batches by the workers
+  std::mutex                          auth_mutex;
+  std::deque<auth_request_t>          auth_requests;
+  std::vector<hss_auth_info_answer_t> auth_answers;
+  int                                 auth_event_fd = -1;
+  srsran::task_thread_pool            auth_workers;
+};
 
-inline void hss_ue_ctx_t::get_last_rand(uint8_t* last_rand_)
-{
-  memcpy(last_rand_, last_rand, 16);
-}
 } // namespace srsepc
 #endif // SRSEPC_HSS_H
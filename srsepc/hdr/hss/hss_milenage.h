@@ -0,0 +1,63 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        hss_milenage.h
+ * Description: Milenage functions f1 to f5 (TS 35.206) computed for several
+ *              authentication vectors at once.
+ *****************************************************************************/
+
+#ifndef SRSEPC_HSS_MILENAGE_H
+#define SRSEPC_HSS_MILENAGE_H
+
+#include <cstdint>
+
+namespace srsepc {
+
+/// Inputs and outputs of Milenage for one authentication vector
+struct milenage_vector_t {
+  // Inputs
+  uint8_t k[16];
+  uint8_t opc[16];
+  uint8_t rand[16];
+  uint8_t sqn[6];
+  uint8_t amf[2];
+
+  // Outputs
+  uint8_t mac_a[8]; // f1
+  uint8_t res[8];   // f2
+  uint8_t ck[16];   // f3
+  uint8_t ik[16];   // f4
+  uint8_t ak[6];    // f5
+};
+
+/**
+ * Computes f1, f2, f3, f4 and f5 for a batch of vectors.
+ *
+ * When the CPU supports AES-NI, the key schedule and the six AES encryptions of several vectors are interleaved so the
+ * latency of each AESENC is hidden behind the others. Otherwise it falls back to the generic implementation, one vector
+ * at a time.
+ */
+void milenage_f12345(milenage_vector_t* vectors, uint32_t nof_vectors);
+
+} // namespace srsepc
+
+#endif // SRSEPC_HSS_MILENAGE_H
@@ -0,0 +1,182 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        hss_ue_db.h
+ * Description: HSS subscriber store. Hash table of UE contexts split in
+ *              shards with their own lock, persisted in a memory-mapped
+ *              binary snapshot and an append-only journal of SQN updates.
+ *****************************************************************************/
+
+#ifndef SRSEPC_HSS_UE_DB_H
+#define SRSEPC_HSS_UE_DB_H
+
+#include "srsran/srslog/srslog.h"
+#include <array>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace srsepc {
+
+enum hss_auth_algo { HSS_ALGO_XOR, HSS_ALGO_MILENAGE };
+
+struct hss_ue_ctx_t {
+  // Members
+  std::string        name;
+  uint64_t           imsi;
+  enum hss_auth_algo algo;
+  uint8_t            key[16];
+  bool               op_configured;
+  uint8_t            op[16];
+  uint8_t            opc[16];
+  uint8_t            amf[2];
+  uint8_t            sqn[6];
+  uint16_t           qci;
+  uint8_t            last_rand[16];
+  std::string        static_ip_addr;
+
+  // Helper getters/setters
+  void set_sqn(const uint8_t* sqn_);
+  void set_last_rand(const uint8_t* rand_);
+  void get_last_rand(uint8_t* rand_);
+};
+
+/// Identifies the version of the CSV file a snapshot was generated from
+struct hss_db_source_t {
+  uint64_t mtime_ns = 0;
+  uint64_t size     = 0;
+
+  bool operator==(const hss_db_source_t& other) const { return mtime_ns == other.mtime_ns and size == other.size; }
+};
+
+/**
+ * Subscriber store of the HSS.
+ *
+ * The contexts are spread over a fixed number of hash tables, each protected by its own mutex, so requests for
+ * different subscribers do not contend. A context is only accessed through apply(), with its shard locked.
+ *
+ * The store can be saved in a binary snapshot of fixed size records, which is loaded with mmap and does not need any
+ * parsing or OPc derivation. Between snapshots, every SQN update is appended to a journal, so the SQNs survive an
+ * abrupt termination without rewriting the whole database. Loading a snapshot replays its journal.
+ */
+class hss_ue_db
+{
+public:
+  hss_ue_db() = default;
+  ~hss_ue_db();
+
+  hss_ue_db(const hss_ue_db&) = delete;
+  hss_ue_db& operator=(const hss_ue_db&) = delete;
+
+  /// Adds a context, it fails if the IMSI already exists
+  bool insert(std::unique_ptr<hss_ue_ctx_t> ue_ctx);
+
+  /// Calls f(hss_ue_ctx_t&) with the shard of the IMSI locked, returns false if the IMSI does not exist
+  template <typename F>
+  bool apply(uint64_t imsi, F&& f)
+  {
+    shard_t&                    s    = get_shard(imsi);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto                        it = s.ue_ctx.find(imsi);
+    if (it == s.ue_ctx.end()) {
+      return false;
+    }
+    f(*it->second);
+    return true;
+  }
+
+  /// Calls f(const hss_ue_ctx_t&) for every context in IMSI order, the whole store is locked during the iteration
+  template <typename F>
+  void for_each(F&& f)
+  {
+    std::vector<std::unique_lock<std::mutex> > locks = lock_all();
+    for (const hss_ue_ctx_t* ue_ctx : sorted()) {
+      f(*ue_ctx);
+    }
+  }
+
+  void   reserve(size_t nof_ue);
+  size_t size();
+  void   clear();
+
+  /**
+   * Loads a snapshot and replays its journal, the current contexts are replaced
+   * @param source Returns the version of the CSV file the snapshot was generated from
+   * @return true on success, false if the snapshot does not exist or is not valid
+   */
+  bool read_snapshot(const std::string& filename, hss_db_source_t* source);
+
+  /**
+   * Writes a snapshot of all the contexts, atomically replacing the previous one, and empties its journal
+   * @param source Version of the CSV file the contexts were read from
+   */
+  bool write_snapshot(const std::string& filename, const hss_db_source_t& source);
+
+  /// Opens the journal of a snapshot, SQN updates are appended from now on
+  bool open_journal(const std::string& snapshot_filename);
+  void close_journal();
+
+  /// Appends the SQN of a context to the journal, to be called from apply() after updating the SQN
+  void journal_sqn(const hss_ue_ctx_t& ue_ctx);
+
+  static std::string journal_filename(const std::string& snapshot_filename) { return snapshot_filename + ".journal"; }
+
+private:
+  constexpr static uint32_t nof_shards = 64;
+
+  struct shard_t {
+    std::mutex                                                 mutex;
+    std::unordered_map<uint64_t, std::unique_ptr<hss_ue_ctx_t> > ue_ctx;
+  };
+
+  shard_t& get_shard(uint64_t imsi) { return shards[(imsi * 0x9E3779B97F4A7C15ULL) >> 58U]; }
+
+  std::vector<std::unique_lock<std::mutex> > lock_all();
+  std::vector<const hss_ue_ctx_t*>           sorted();
+  int                                        replay_journal(const std::string& filename);
+
+  std::array<shard_t, nof_shards> shards;
+  int                             journal_fd = -1;
+  srslog::basic_logger&           logger     = srslog::fetch_basic_logger("HSS");
+};
+
+inline void hss_ue_ctx_t::set_sqn(const uint8_t* sqn_)
+{
+  memcpy(sqn, sqn_, 6);
+}
+
+inline void hss_ue_ctx_t::set_last_rand(const uint8_t* last_rand_)
+{
+  memcpy(last_rand, last_rand_, 16);
+}
+
+inline void hss_ue_ctx_t::get_last_rand(uint8_t* last_rand_)
+{
+  memcpy(last_rand_, last_rand, 16);
+}
+
+} // namespace srsepc
+
+#endif // SRSEPC_HSS_UE_DB_H
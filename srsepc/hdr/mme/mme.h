@@ -33,6 +33,7 @@
 #include "srsran/common/standard_streams.h"
 #include "srsran/common/threads.h"
 #include <cstddef>
+#include <mutex>
 
 namespace srsepc {
 
@@ -67,18 +68,30 @@ public:
 private:
   mme();
   virtual ~mme();
-  static mme* m_instance;
-  s1ap*       m_s1ap;
-  mme_gtpc*   m_mme_gtpc;
+  static mme*        m_instance;
+  s1ap*              m_s1ap;
+  mme_gtpc*          m_mme_gtpc;
+  hss_interface_mme* m_hss;
 
   bool   m_running;
   fd_set m_set;
 
-  // Timer map
+  // Timer map, modified by the S1AP workers. They signal the new timers to the MME thread with timers_event_fd
+  std::mutex               timers_mutex;
   std::vector<mme_timer_t> timers;
+  int                      timers_event_fd = -1;
+
+  // Authentication vectors received from the HSS
+  std::vector<hss_auth_info_answer_t> auth_answers;
 
   // Timer Methods
   void handle_timer_expire(int timer_fd);
+  void notify_timers_changed();
+
+  // Events of the UEs, processed by the worker of the UE when the S1AP workers are enabled
+  void handle_s11_pdu(srsran::byte_buffer_t* pdu);
+  void handle_auth_info_answer(const hss_auth_info_answer_t& answer);
+  void expire_nas_timer(enum nas_timer_type type, uint64_t imsi);
 
   // Logs
   srslog::basic_logger& m_s1ap_logger = srslog::fetch_basic_logger("S1AP");
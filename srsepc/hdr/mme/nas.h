@@ -236,6 +236,9 @@ public:
   bool handle_authentication_failure(srsran::byte_buffer_t* nas_rx);
   bool handle_detach_request(srsran::byte_buffer_t* nas_rx);
 
+  /* HSS answers */
+  bool handle_auth_info_answer(const hss_auth_info_answer_t& answer);
+
   /* Downlink NAS messages packing */
   bool pack_authentication_request(srsran::byte_buffer_t* nas_buffer);
   bool pack_authentication_reject(srsran::byte_buffer_t* nas_buffer);
@@ -28,6 +28,7 @@
 #include "s1ap_mngmt_proc.h"
 #include "s1ap_nas_transport.h"
 #include "s1ap_paging.h"
+#include "ue_ctx_table.h"
 #include "srsepc/hdr/hss/hss.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/asn1/liblte_mme.h"
@@ -35,16 +36,21 @@
 #include "srsran/common/common.h"
 #include "srsran/common/s1ap_pcap.h"
 #include "srsran/common/standard_streams.h"
+#include "srsran/common/thread_pool.h"
 #include "srsran/interfaces/epc_interfaces.h"
 #include "srsran/srslog/srslog.h"
 #include <arpa/inet.h>
+#include <atomic>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <netinet/sctp.h>
 #include <set>
 #include <strings.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <vector>
 
 namespace srsepc {
 
@@ -52,6 +58,9 @@ const uint16_t S1MME_PORT = 36412;
 
 using s1ap_pdu_t = asn1::s1ap::s1ap_pdu_c;
 
+/// Task processing an event of one UE in the S1AP workers
+using s1ap_ue_task_t = srsran::move_callback<void(), srsran::default_move_callback_buffer_size, true>;
+
 class s1ap : public s1ap_interface_nas, public s1ap_interface_gtpc, public s1ap_interface_mme
 {
 public:
@@ -73,6 +82,18 @@ public:
 
   void activate_eps_bearer(uint64_t imsi, uint8_t ebi);
 
+  /*
+   * S1AP workers. The events of a UE (S1AP messages, GTP-C messages, HSS answers and NAS timers) are always processed
+   * by the same worker, in order. The MME-UE-S1AP-IDs allocated by a worker identify it, and the worker of an IMSI is
+   * the one that created its context. The events that are not associated to a UE are processed by the MME thread once
+   * all the workers are idle.
+   */
+  bool     workers_enabled() const { return not m_workers.empty(); }
+  uint32_t get_worker_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id) const;
+  uint32_t get_worker_from_imsi(uint64_t imsi);
+  void     push_ue_task(uint32_t worker_idx, s1ap_ue_task_t task);
+  void     wait_workers_idle();
+
   void print_enb_ctx_info(const std::string& prefix, const enb_ctx_t& enb_ctx);
 
   uint32_t   get_plmn();
@@ -105,8 +126,8 @@ public:
   s1ap_erab_mngmt_proc* m_s1ap_erab_mngmt_proc;
   s1ap_paging*          m_s1ap_paging;
 
-  std::map<uint32_t, uint64_t>   m_tmsi_to_imsi;
-  std::map<uint16_t, enb_ctx_t*> m_active_enbs;
+  ue_ctx_table<uint32_t, uint64_t> m_tmsi_to_imsi;
+  std::map<uint16_t, enb_ctx_t*>   m_active_enbs;
 
   // Interfaces
   virtual bool send_initial_context_setup_request(uint64_t imsi, uint16_t erab_to_setup);
@@ -127,6 +148,7 @@ public:
   virtual bool send_paging(uint64_t imsi, uint16_t erab_to_setup);
 
   virtual bool expire_nas_timer(enum nas_timer_type type, uint64_t imsi);
+  virtual bool handle_auth_info_answer(const hss_auth_info_answer_t& answer);
 
 private:
   s1ap();
@@ -136,22 +158,44 @@ private:
 
   uint32_t m_plmn;
 
-  hss_interface_nas*                     m_hss;
-  int                                    m_s1mme;
-  std::map<int32_t, uint16_t>            m_sctp_to_enb_id;
-  std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
+  hss_interface_nas*          m_hss;
+  int                         m_s1mme;
+  std::map<int32_t, uint16_t> m_sctp_to_enb_id;
 
-  std::map<uint64_t, nas*> m_imsi_to_nas_ctx;
-  std::map<uint32_t, nas*> m_mme_ue_s1ap_id_to_nas_ctx;
+  // The UEs of each eNB, modified by all the workers
+  std::mutex                             m_enb_ues_mutex;
+  std::map<int32_t, std::set<uint32_t> > m_enb_assoc_to_ue_ids;
 
-  uint32_t m_next_mme_ue_s1ap_id;
-  uint32_t m_next_m_tmsi;
+  // Context of the IMSI and worker processing its events
+  struct imsi_entry_t {
+    nas*     nas_ctx;
+    uint32_t worker_idx;
+  };
+  ue_ctx_table<uint64_t, imsi_entry_t> m_imsi_to_nas_ctx;
+  ue_ctx_table<uint32_t, nas*>         m_mme_ue_s1ap_id_to_nas_ctx;
+
+  // Next MME-UE-S1AP-ID of each worker
+  std::vector<std::atomic<uint32_t> > m_next_mme_ue_s1ap_id;
+  std::atomic<uint32_t>               m_next_m_tmsi;
+
+  // S1AP workers, empty when the messages are processed by the MME thread
+  std::vector<std::unique_ptr<srsran::task_worker> > m_workers;
+
+  // Received S1AP message, waiting in the queue of a worker
+  struct s1ap_rx_msg_t {
+    s1ap_pdu_t             pdu;
+    struct sctp_sndrcvinfo enb_sri;
+  };
+  void handle_s1ap_rx_msg(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri);
+  int  get_worker_from_s1ap_pdu(const s1ap_pdu_t& rx_pdu, const struct sctp_sndrcvinfo* enb_sri);
+  int  get_worker_from_init_ue_msg(const asn1::s1ap::init_ue_msg_s& init_ue, const struct sctp_sndrcvinfo* enb_sri);
 
   // GTP-C Interface
   mme_gtpc* m_mme_gtpc;
 
-  // PCAP
+  // PCAP, written by all the workers
   bool              m_pcap_enable;
+  std::mutex        m_pcap_mutex;
   srsran::s1ap_pcap m_pcap;
 };
 
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        ue_ctx_table.h
+ * Description: Hash table of UE context references, split in shards with
+ *              their own lock so the S1AP workers do not contend.
+ *****************************************************************************/
+
+#ifndef SRSEPC_UE_CTX_TABLE_H
+#define SRSEPC_UE_CTX_TABLE_H
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace srsepc {
+
+/**
+ * Maps a UE identifier (IMSI, MME-UE-S1AP-ID, M-TMSI) to a small value, usually a pointer to the NAS context.
+ *
+ * Each shard is a hash table protected by its own mutex. The values are copied out of the table, the table does not
+ * own what they point to.
+ */
+template <typename Key, typename T>
+class ue_ctx_table
+{
+public:
+  /// Adds an entry, it fails if the key already exists
+  bool insert(Key key, const T& value)
+  {
+    shard_t&                    s = get_shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.entries.emplace(key, value).second;
+  }
+
+  /// Returns true and copies the value to *value if the key exists
+  bool find(Key key, T* value)
+  {
+    shard_t&                    s = get_shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto                        it = s.entries.find(key);
+    if (it == s.entries.end()) {
+      return false;
+    }
+    *value = it->second;
+    return true;
+  }
+
+  /// Calls f(T&) with the shard of the key locked, returns false if the key does not exist
+  template <typename F>
+  bool apply(Key key, F&& f)
+  {
+    shard_t&                    s = get_shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    auto                        it = s.entries.find(key);
+    if (it == s.entries.end()) {
+      return false;
+    }
+    f(it->second);
+    return true;
+  }
+
+  /// Returns false if the key does not exist
+  bool erase(Key key)
+  {
+    shard_t&                    s = get_shard(key);
+    std::lock_guard<std::mutex> lock(s.mutex);
+    return s.entries.erase(key) > 0;
+  }
+
+  /// Calls f(Key, const T&) for every entry, one shard locked at a time
+  template <typename F>
+  void for_each(F&& f)
+  {
+    for (shard_t& s : shards) {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      for (const auto& entry : s.entries) {
+        f(entry.first, entry.second);
+      }
+    }
+  }
+
+  void clear()
+  {
+    for (shard_t& s : shards) {
+      std::lock_guard<std::mutex> lock(s.mutex);
+      s.entries.clear();
+    }
+  }
+
+private:
+  constexpr static uint32_t nof_shards = 64;
+
+  struct shard_t {
+    std::mutex                 mutex;
+    std::unordered_map<Key, T> entries;
+  };
+
+  // Consecutive identifiers, as MME-UE-S1AP-IDs and M-TMSIs are allocated, are spread over all the shards
+  shard_t& get_shard(Key key) { return shards[((uint64_t)key * 0x9E3779B97F4A7C15ULL) >> 58U]; }
+
+  std::array<shard_t, nof_shards> shards;
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_UE_CTX_TABLE_H
@@ -22,6 +22,7 @@
 #ifndef SRSEPC_GTPU_H
 #define SRSEPC_GTPU_H
 
+#include "srsepc/hdr/spgw/gtpu_data_path.h"
 #include "srsepc/hdr/spgw/spgw.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/buffer_pool.h"
@@ -46,12 +47,18 @@ public:
   int get_sgi();
   int get_s1u();
 
+  // SGi packets that the user-plane thread could not forward
+  int  get_slow_path_fd();
+  void handle_slow_path_pdus();
   void handle_sgi_pdu(srsran::unique_byte_buffer_t msg);
-  void handle_s1u_pdu(srsran::byte_buffer_t* msg);
   void send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg);
 
+  // Publishes the tunnel changes to the user-plane thread
+  void publish_tunnels();
+
   virtual in_addr_t get_s1u_addr();
 
+  virtual bool create_gtpu_tunnel(in_addr_t ue_ipv4, uint32_t up_user_teid);
   virtual bool modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtp_fteid_t dw_user_fteid, uint32_t up_ctr_fteid);
   virtual bool delete_gtpu_tunnel(in_addr_t ue_ipv4);
   virtual bool delete_gtpc_tunnel(in_addr_t ue_ipv4);
@@ -72,6 +79,12 @@ public:
   std::map<in_addr_t, uint32_t>            m_ip_to_ctr_teid; // IP to control TEID map. Important to check if
                                                              // UE is attached without an active user-plane
                                                              // for downlink notifications.
+  std::map<in_addr_t, uint32_t>            m_ip_to_up_user_teid; // IP to S-GW user TEID for uplink traffic
+  bool                                     m_tunnels_changed = false;
+
+  // User-plane thread, forwards the packets with a snapshot of the maps above
+  gtpu_data_path                            m_data_path;
+  std::vector<srsran::unique_byte_buffer_t> m_slow_path_pdus;
 
   srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
 };
@@ -86,6 +99,11 @@ inline int spgw::gtpu::get_s1u()
   return m_s1u;
 }
 
+inline int spgw::gtpu::get_slow_path_fd()
+{
+  return m_data_path.get_slow_path_fd();
+}
+
 inline in_addr_t spgw::gtpu::get_s1u_addr()
 {
   return m_s1u_addr.sin_addr.s_addr;
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+/******************************************************************************
+ * File:        gtpu_data_path.h
+ * Description: SP-GW user-plane fast path. Forwards packets between the SGi
+ *              and S1-U interfaces on a dedicated thread, using tunnel tables
+ *              published by the GTP-C thread.
+ *****************************************************************************/
+
+#ifndef SRSEPC_GTPU_DATA_PATH_H
+#define SRSEPC_GTPU_DATA_PATH_H
+
+#include "srsran/asn1/gtpc_ies.h"
+#include "srsran/common/buffer_pool.h"
+#include "srsran/common/threads.h"
+#include "srsran/srslog/srslog.h"
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <vector>
+
+namespace srsepc {
+
+struct gtpu_tunnel_t {
+  in_addr_t           ue_ipv4;
+  uint32_t            up_user_teid;   // S-GW S1-U TEID, uplink packets are only accepted for known TEIDs
+  uint32_t            up_ctrl_teid;   // S-GW control TEID, 0 if there is no control tunnel
+  bool                dw_user_active; // Downlink user tunnel is set up, the UE is ECM connected
+  srsran::gtp_fteid_t dw_user_fteid;
+};
+
+/**
+ * Immutable snapshot of the GTP-U tunnels, indexed by UE IP (downlink) and by S-GW user TEID (uplink).
+ *
+ * Both indexes are open addressed hash tables with linear probing, sized to a power of two at least twice the
+ * number of tunnels, so a lookup touches one or two cache lines. The GTP-C thread builds a new table on every
+ * change and publishes it; the data path never sees a table being modified.
+ */
+class gtpu_tunnel_table
+{
+public:
+  explicit gtpu_tunnel_table(std::vector<gtpu_tunnel_t> tunnels_);
+
+  const gtpu_tunnel_t* find_by_ip(in_addr_t ue_ipv4) const { return find(ip_index, ue_ipv4); }
+  const gtpu_tunnel_t* find_by_teid(uint32_t up_user_teid) const { return find(teid_index, up_user_teid); }
+  size_t               size() const { return tunnels.size(); }
+
+private:
+  struct slot_t {
+    uint32_t key;
+    uint32_t tunnel_idx;
+  };
+  static const uint32_t empty_slot = UINT32_MAX;
+
+  static uint32_t hash(uint32_t key) { return (key * 0x9E3779B1U) ^ (key >> 16U); }
+  void            insert(std::vector<slot_t>& index, uint32_t key, uint32_t tunnel_idx);
+
+  const gtpu_tunnel_t* find(const std::vector<slot_t>& index, uint32_t key) const
+  {
+    for (uint32_t i = hash(key) & mask;; i = (i + 1) & mask) {
+      const slot_t& slot = index[i];
+      if (slot.tunnel_idx == empty_slot) {
+        return nullptr;
+      }
+      if (slot.key == key) {
+        return &tunnels[slot.tunnel_idx];
+      }
+    }
+  }
+
+  std::vector<gtpu_tunnel_t> tunnels;
+  std::vector<slot_t>        ip_index;
+  std::vector<slot_t>        teid_index;
+  uint32_t                   mask = 0;
+};
+
+/**
+ * Forwards the user-plane packets between the SGi (TUN) and the S1-U (UDP) file descriptors on its own thread.
+ *
+ * Packets are read and sent in batches. Downlink packets for UEs without an active user tunnel (paging) are handed
+ * to the GTP-C thread through the slow path queue, which is signalled with an eventfd.
+ */
+class gtpu_data_path : public srsran::thread
+{
+public:
+  struct metrics_t {
+    uint64_t dl_pkts;
+    uint64_t dl_bytes;
+    uint64_t ul_pkts;
+    uint64_t ul_bytes;
+    uint64_t dropped_pkts;
+    uint64_t slow_path_pkts;
+  };
+
+  gtpu_data_path();
+  ~gtpu_data_path();
+
+  int  init(int sgi_fd, int s1u_fd);
+  void stop();
+
+  /// Called by the GTP-C thread, the data path uses the new table from its next batch
+  void publish_tunnels(std::shared_ptr<const gtpu_tunnel_table> table);
+
+  int  get_slow_path_fd() const { return slow_path_fd; }
+  void get_slow_path_pdus(std::vector<srsran::unique_byte_buffer_t>& pdus);
+
+  metrics_t get_metrics() const;
+
+private:
+  static const uint32_t batch_size = 32;
+
+  void                   run_thread() override;
+  void                   handle_sgi_batch(const gtpu_tunnel_table* table);
+  void                   handle_s1u_batch(const gtpu_tunnel_table* table);
+  void                   push_slow_path(srsran::unique_byte_buffer_t pdu);
+  srsran::byte_buffer_t* get_rx_buffer(uint32_t idx);
+
+  int sgi_fd       = -1;
+  int s1u_fd       = -1;
+  int slow_path_fd = -1;
+  int stop_fd      = -1;
+
+  std::atomic<bool>                        running{false};
+  std::shared_ptr<const gtpu_tunnel_table> tunnels;
+
+  std::vector<srsran::unique_byte_buffer_t> rx_buffers;
+
+  std::mutex                               slow_path_mutex;
+  std::deque<srsran::unique_byte_buffer_t> slow_path_queue;
+
+  std::atomic<uint64_t> dl_pkts{0}, dl_bytes{0}, ul_pkts{0}, ul_bytes{0}, dropped_pkts{0}, slow_path_pkts{0};
+
+  srslog::basic_logger& m_logger = srslog::fetch_basic_logger("GTPU");
+};
+
+} // namespace srsepc
+
+#endif // SRSEPC_GTPU_DATA_PATH_H
@@ -24,23 +24,29 @@
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <iomanip>
+#include <random>
 #include <sstream>
-#include <stdlib.h> /* srand, rand */
 #include <string>
-#include <time.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace srsepc {
 
 hss*            hss::m_instance    = NULL;
 pthread_mutex_t hss_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-hss::hss()
+hss::hss() : auth_workers(1, true)
 {
   return;
 }
 
 hss::~hss()
 {
+  auth_workers.stop();
+  if (auth_event_fd >= 0) {
+    close(auth_event_fd);
+  }
   return;
 }
 
@@ -66,10 +72,10 @@ void hss::cleanup()
 
 int hss::init(hss_args_t* hss_args)
 {
-  srand(time(NULL));
-
   /*Read user information from DB*/
-  if (read_db_file(hss_args->db_file) == false) {
+  bool db_read = hss_args->db_snapshot.empty() ? read_db_file(hss_args->db_file)
+                                               : read_db_snapshot(hss_args->db_file, hss_args->db_snapshot);
+  if (db_read == false) {
     srsran::console("Error reading user database file %s\n", hss_args->db_file.c_str());
     return -1;
   }
@@ -77,7 +83,17 @@ int hss::init(hss_args_t* hss_args)
   mcc = hss_args->mcc;
   mnc = hss_args->mnc;
 
-  db_file = hss_args->db_file;
+  db_file     = hss_args->db_file;
+  db_snapshot = hss_args->db_snapshot;
+
+  /*Start the workers generating authentication vectors*/
+  auth_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (auth_event_fd < 0) {
+    srsran::console("Error creating HSS event fd: %s\n", strerror(errno));
+    return -1;
+  }
+  auth_workers.set_nof_workers(std::max(1u, hss_args->auth_workers));
+  auth_workers.start();
 
   m_logger.info("HSS Initialized. DB file %s, MCC: %d, MNC: %d", hss_args->db_file.c_str(), mcc, mnc);
   srsran::console("HSS Initialized.\n");
@@ -86,10 +102,66 @@ int hss::init(hss_args_t* hss_args)
 
 void hss::stop()
 {
-  write_db_file(db_file);
+  // No SQN may change while the database is saved
+  auth_workers.stop();
+
+  if (db_snapshot.empty()) {
+    write_db_file(db_file);
+  } else {
+    m_ue_db.write_snapshot(db_snapshot, db_source);
+    m_ue_db.close_journal();
+  }
   return;
 }
 
+bool hss::get_db_source(const std::string& db_filename, hss_db_source_t* source)
+{
+  struct stat st = {};
+  if (stat(db_filename.c_str(), &st) < 0) {
+    return false;
+  }
+  source->mtime_ns = (uint64_t)st.st_mtim.tv_sec * 1000000000ULL + (uint64_t)st.st_mtim.tv_nsec;
+  source->size     = (uint64_t)st.st_size;
+  return true;
+}
+
+bool hss::read_db_snapshot(const std::string& db_filename, const std::string& snapshot_filename)
+{
+  if (not get_db_source(db_filename, &db_source)) {
+    return false;
+  }
+
+  hss_db_source_t snapshot_source = {};
+  bool            snapshot_read   = m_ue_db.read_snapshot(snapshot_filename, &snapshot_source);
+  if (snapshot_read and snapshot_source == db_source) {
+    m_ue_db.for_each([this](const hss_ue_ctx_t& ue_ctx) {
+      if (ue_ctx.static_ip_addr != "0.0.0.0") {
+        m_ip_to_imsi.insert(std::make_pair(ue_ctx.static_ip_addr, ue_ctx.imsi));
+      }
+    });
+  } else {
+    // The CSV file changed since the snapshot was taken, read it again keeping the SQN of the known users
+    std::unordered_map<uint64_t, std::array<uint8_t, 6> > known_sqn;
+    if (snapshot_read) {
+      m_ue_db.for_each([&known_sqn](const hss_ue_ctx_t& ue_ctx) {
+        std::array<uint8_t, 6>& sqn = known_sqn[ue_ctx.imsi];
+        memcpy(sqn.data(), ue_ctx.sqn, sqn.size());
+      });
+      m_ue_db.clear();
+    }
+    if (not read_db_file(db_filename)) {
+      return false;
+    }
+    for (const auto& it : known_sqn) {
+      m_ue_db.apply(it.first, [&it](hss_ue_ctx_t& ue_ctx) { ue_ctx.set_sqn(it.second.data()); });
+    }
+    m_logger.info("HSS snapshot %s regenerated from %s", snapshot_filename.c_str(), db_filename.c_str());
+  }
+
+  // Compact the journal into a fresh snapshot and journal the SQN updates from now on
+  return m_ue_db.write_snapshot(snapshot_filename, db_source) and m_ue_db.open_journal(snapshot_filename);
+}
+
 bool hss::read_db_file(std::string db_filename)
 {
   std::ifstream m_db_file;
@@ -168,7 +240,10 @@ bool hss::read_db_file(std::string db_filename)
           return false;
         }
       }
-      m_imsi_to_ue_ctx.insert(std::make_pair(ue_ctx->imsi, std::move(ue_ctx)));
+      uint64_t imsi = ue_ctx->imsi;
+      if (not m_ue_db.insert(std::move(ue_ctx))) {
+        m_logger.warning("Duplicated IMSI %015" PRIu64 " in user database, ignoring it", imsi);
+      }
     }
   }
 
@@ -216,38 +291,36 @@ bool hss::write_db_file(std::string db_filename)
             << "#                                                                                           \n"
             << "# Note: Lines starting by '#' are ignored and will be overwritten                           \n";
 
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator it = m_imsi_to_ue_ctx.begin();
-  while (it != m_imsi_to_ue_ctx.end()) {
-    m_db_file << it->second->name;
+  m_ue_db.for_each([&m_db_file](const hss_ue_ctx_t& ue_ctx) {
+    m_db_file << ue_ctx.name;
     m_db_file << ",";
-    m_db_file << (it->second->algo == HSS_ALGO_XOR ? "xor" : "mil");
+    m_db_file << (ue_ctx.algo == HSS_ALGO_XOR ? "xor" : "mil");
     m_db_file << ",";
-    m_db_file << std::setfill('0') << std::setw(15) << it->second->imsi;
+    m_db_file << std::setfill('0') << std::setw(15) << ue_ctx.imsi;
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->key, 16);
+    m_db_file << srsran::hex_string(ue_ctx.key, 16);
     m_db_file << ",";
-    if (it->second->op_configured) {
+    if (ue_ctx.op_configured) {
       m_db_file << "op,";
-      m_db_file << srsran::hex_string(it->second->op, 16);
+      m_db_file << srsran::hex_string(ue_ctx.op, 16);
     } else {
       m_db_file << "opc,";
-      m_db_file << srsran::hex_string(it->second->opc, 16);
+      m_db_file << srsran::hex_string(ue_ctx.opc, 16);
     }
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->amf, 2);
+    m_db_file << srsran::hex_string(ue_ctx.amf, 2);
     m_db_file << ",";
-    m_db_file << srsran::hex_string(it->second->sqn, 6);
+    m_db_file << srsran::hex_string(ue_ctx.sqn, 6);
     m_db_file << ",";
-    m_db_file << it->second->qci;
-    if (it->second->static_ip_addr != "0.0.0.0") {
+    m_db_file << ue_ctx.qci;
+    if (ue_ctx.static_ip_addr != "0.0.0.0") {
       m_db_file << ",";
-      m_db_file << it->second->static_ip_addr;
+      m_db_file << ue_ctx.static_ip_addr;
     } else {
       m_db_file << ",dynamic";
     }
     m_db_file << std::endl;
-    it++;
-  }
+  });
   if (m_db_file.is_open()) {
     m_db_file.close();
   }
@@ -256,87 +329,164 @@ bool hss::write_db_file(std::string db_filename)
 
 bool hss::gen_auth_info_answer(uint64_t imsi, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
 {
-
-  m_logger.debug("Generating AUTH info answer");
-  hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
-  if (ue_ctx == nullptr) {
-    srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
-    m_logger.error("User not found at HSS. IMSI: %015" PRIu64 "", imsi);
+  hss_auth_info_answer_t answer = {};
+  answer.imsi                   = imsi;
+  gen_auth_info_answers(&answer, 1);
+  if (not answer.found) {
     return false;
   }
+  memcpy(k_asme, answer.k_asme, sizeof(answer.k_asme));
+  memcpy(autn, answer.autn, sizeof(answer.autn));
+  memcpy(rand, answer.rand, sizeof(answer.rand));
+  memcpy(xres, answer.xres, sizeof(answer.xres));
+  return true;
+}
 
-  switch (ue_ctx->algo) {
-    case HSS_ALGO_XOR:
-      gen_auth_info_answer_xor(ue_ctx, k_asme, autn, rand, xres);
-      break;
-    case HSS_ALGO_MILENAGE:
-      gen_auth_info_answer_milenage(ue_ctx, k_asme, autn, rand, xres);
-      break;
+bool hss::request_auth_info(uint64_t imsi, uint32_t mme_ue_s1ap_id)
+{
+  bool new_batch = false;
+  {
+    std::lock_guard<std::mutex> lock(auth_mutex);
+    auth_requests.push_back({imsi, mme_ue_s1ap_id});
+    // Each task takes up to max_auth_batch requests, one task per started batch is enough to drain the queue
+    new_batch = auth_requests.size() % max_auth_batch == 1;
+  }
+  if (new_batch) {
+    auth_workers.push_task([this]() { process_auth_requests(); });
   }
-  increment_ue_sqn(ue_ctx);
   return true;
 }
 
-void hss::gen_auth_info_answer_milenage(hss_ue_ctx_t* ue_ctx,
-                                        uint8_t*      k_asme,
-                                        uint8_t*      autn,
-                                        uint8_t*      rand,
-                                        uint8_t*      xres)
+void hss::process_auth_requests()
 {
-  // Get K, AMF, OPC and SQN
-  uint8_t* k   = ue_ctx->key;
-  uint8_t* amf = ue_ctx->amf;
-  uint8_t* opc = ue_ctx->opc;
-  uint8_t* sqn = ue_ctx->sqn;
+  std::array<hss_auth_info_answer_t, max_auth_batch> answers;
+  uint32_t                                           nof_answers = 0;
+  {
+    std::lock_guard<std::mutex> lock(auth_mutex);
+    while (nof_answers < max_auth_batch and not auth_requests.empty()) {
+      answers[nof_answers]                = {};
+      answers[nof_answers].imsi           = auth_requests.front().imsi;
+      answers[nof_answers].mme_ue_s1ap_id = auth_requests.front().mme_ue_s1ap_id;
+      auth_requests.pop_front();
+      nof_answers++;
+    }
+  }
+  if (nof_answers == 0) {
+    return;
+  }
 
-  // Temp variables
-  uint8_t ck[16];
-  uint8_t ik[16];
-  uint8_t ak[6];
-  uint8_t mac[8];
+  gen_auth_info_answers(answers.data(), nof_answers);
 
-  gen_rand(rand);
+  {
+    std::lock_guard<std::mutex> lock(auth_mutex);
+    auth_answers.insert(auth_answers.end(), answers.begin(), answers.begin() + nof_answers);
+  }
 
-  srsran::security_milenage_f2345(k, opc, rand, xres, ck, ik, ak);
+  // Wake up the MME
+  uint64_t event = 1;
+  if (write(auth_event_fd, &event, sizeof(event)) < 0) {
+    m_logger.error("Error notifying authentication vectors: %s", strerror(errno));
+  }
+}
 
-  m_logger.debug(k, 16, "User Key : ");
-  m_logger.debug(opc, 16, "User OPc : ");
-  m_logger.debug(rand, 16, "User Rand : ");
-  m_logger.debug(xres, 8, "User XRES: ");
-  m_logger.debug(ck, 16, "User CK: ");
-  m_logger.debug(ik, 16, "User IK: ");
-  m_logger.debug(ak, 6, "User AK: ");
+int hss::get_auth_info_fd()
+{
+  return auth_event_fd;
+}
+
+void hss::get_auth_info_answers(std::vector<hss_auth_info_answer_t>& answers)
+{
+  // Clear the notification before taking the answers, so answers added afterwards notify again
+  uint64_t nof_events = 0;
+  if (read(auth_event_fd, &nof_events, sizeof(nof_events)) < 0 and errno != EAGAIN) {
+    m_logger.error("Error reading authentication vector notifications: %s", strerror(errno));
+  }
 
-  srsran::security_milenage_f1(k, opc, rand, sqn, amf, mac);
+  answers.clear();
+  std::lock_guard<std::mutex> lock(auth_mutex);
+  answers.swap(auth_answers);
+}
 
-  m_logger.debug(sqn, 6, "User SQN : ");
-  m_logger.debug(mac, 8, "User MAC : ");
+/// Generates the vectors of up to max_auth_batch answers. The UE context is only locked to take the inputs and update
+/// the SQN, the Milenage vectors of the whole batch are then computed together.
+void hss::gen_auth_info_answers(hss_auth_info_answer_t* answers, uint32_t nof_answers)
+{
+  std::array<milenage_vector_t, max_auth_batch>       vectors;
+  std::array<hss_auth_info_answer_t*, max_auth_batch> milenage_answers;
+  uint32_t                                            nof_vectors = 0;
+
+  m_logger.debug("Generating %d AUTH info answers", nof_answers);
+  for (uint32_t i = 0; i < nof_answers; i++) {
+    hss_auth_info_answer_t& answer = answers[i];
+
+    answer.found = m_ue_db.apply(answer.imsi, [&](hss_ue_ctx_t& ue_ctx) {
+      switch (ue_ctx.algo) {
+        case HSS_ALGO_XOR:
+          gen_auth_info_answer_xor(&ue_ctx, answer.k_asme, answer.autn, answer.rand, answer.xres);
+          break;
+        case HSS_ALGO_MILENAGE: {
+          milenage_vector_t& vec = vectors[nof_vectors];
+          memcpy(vec.k, ue_ctx.key, sizeof(vec.k));
+          memcpy(vec.opc, ue_ctx.opc, sizeof(vec.opc));
+          memcpy(vec.sqn, ue_ctx.sqn, sizeof(vec.sqn));
+          memcpy(vec.amf, ue_ctx.amf, sizeof(vec.amf));
+          gen_rand(vec.rand);
+          memcpy(answer.rand, vec.rand, sizeof(answer.rand));
+          ue_ctx.set_last_rand(vec.rand);
+          milenage_answers[nof_vectors++] = &answer;
+          break;
+        }
+      }
+      increment_ue_sqn(&ue_ctx);
+    });
+    if (not answer.found) {
+      srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", answer.imsi);
+      m_logger.error("User not found at HSS. IMSI: %015" PRIu64 "", answer.imsi);
+    }
+  }
+
+  milenage_f12345(vectors.data(), nof_vectors);
+  for (uint32_t i = 0; i < nof_vectors; i++) {
+    gen_auth_info_answer_milenage(
+        vectors[i], milenage_answers[i]->k_asme, milenage_answers[i]->autn, milenage_answers[i]->xres);
+  }
+}
+
+void hss::gen_auth_info_answer_milenage(const milenage_vector_t& vec, uint8_t* k_asme, uint8_t* autn, uint8_t* xres)
+{
+  memcpy(xres, vec.res, sizeof(vec.res));
+
+  m_logger.debug(vec.k, 16, "User Key : ");
+  m_logger.debug(vec.opc, 16, "User OPc : ");
+  m_logger.debug(vec.rand, 16, "User Rand : ");
+  m_logger.debug(xres, 8, "User XRES: ");
+  m_logger.debug(vec.ck, 16, "User CK: ");
+  m_logger.debug(vec.ik, 16, "User IK: ");
+  m_logger.debug(vec.ak, 6, "User AK: ");
+  m_logger.debug(vec.sqn, 6, "User SQN : ");
+  m_logger.debug(vec.mac_a, 8, "User MAC : ");
 
   uint8_t ak_xor_sqn[6];
   for (int i = 0; i < 6; i++) {
-    ak_xor_sqn[i] = sqn[i] ^ ak[i];
+    ak_xor_sqn[i] = vec.sqn[i] ^ vec.ak[i];
   }
   // Generate K_asme
-  srsran::security_generate_k_asme(ck, ik, ak_xor_sqn, mcc, mnc, k_asme);
+  srsran::security_generate_k_asme(vec.ck, vec.ik, ak_xor_sqn, mcc, mnc, k_asme);
 
   m_logger.debug("User MCC : %x  MNC : %x ", mcc, mnc);
   m_logger.debug(k_asme, 32, "User k_asme : ");
 
   // Generate AUTN (autn = sqn ^ ak |+| amf |+| mac)
   for (int i = 0; i < 6; i++) {
-    autn[i] = sqn[i] ^ ak[i];
+    autn[i] = ak_xor_sqn[i];
   }
   for (int i = 0; i < 2; i++) {
-    autn[6 + i] = amf[i];
+    autn[6 + i] = vec.amf[i];
   }
   for (int i = 0; i < 8; i++) {
-    autn[8 + i] = mac[i];
+    autn[8 + i] = vec.mac_a[i];
   }
   m_logger.debug(autn, 16, "User AUTN: ");
-
-  // Set last RAND
-  ue_ctx->set_last_rand(rand);
-  return;
 }
 
 void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_t* autn, uint8_t* rand, uint8_t* xres)
@@ -440,38 +590,34 @@ void hss::gen_auth_info_answer_xor(hss_ue_ctx_t* ue_ctx, uint8_t* k_asme, uint8_
 
 bool hss::gen_update_loc_answer(uint64_t imsi, uint8_t* qci)
 {
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
+  if (not m_ue_db.apply(imsi, [qci](hss_ue_ctx_t& ue_ctx) { *qci = ue_ctx.qci; })) {
     m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
     return false;
   }
-  const std::unique_ptr<hss_ue_ctx_t>& ue_ctx = ue_ctx_it->second;
   m_logger.info("Found User %015" PRIu64 "", imsi);
-  *qci = ue_ctx->qci;
   return true;
 }
 
 bool hss::resync_sqn(uint64_t imsi, uint8_t* auts)
 {
   m_logger.debug("Re-syncing SQN");
-  hss_ue_ctx_t* ue_ctx = get_ue_ctx(imsi);
-  if (ue_ctx == nullptr) {
+  bool found = m_ue_db.apply(imsi, [&](hss_ue_ctx_t& ue_ctx) {
+    switch (ue_ctx.algo) {
+      case HSS_ALGO_XOR:
+        resync_sqn_xor(&ue_ctx, auts);
+        break;
+      case HSS_ALGO_MILENAGE:
+        resync_sqn_milenage(&ue_ctx, auts);
+        break;
+    }
+    increment_seq_after_resync(&ue_ctx);
+  });
+  if (not found) {
     srsran::console("User not found at HSS. IMSI: %015" PRIu64 "\n", imsi);
     m_logger.error("User not found at HSS. IMSI: %015" PRIu64 "", imsi);
     return false;
   }
-
-  switch (ue_ctx->algo) {
-    case HSS_ALGO_XOR:
-      resync_sqn_xor(ue_ctx, auts);
-      break;
-    case HSS_ALGO_MILENAGE:
-      resync_sqn_milenage(ue_ctx, auts);
-      break;
-  }
-
-  increment_seq_after_resync(ue_ctx);
   return true;
 }
 
@@ -538,6 +684,7 @@ void hss::resync_sqn_milenage(hss_ue_ctx_t* ue_ctx, uint8_t* auts)
 void hss::increment_ue_sqn(hss_ue_ctx_t* ue_ctx)
 {
   increment_sqn(ue_ctx->sqn, ue_ctx->sqn);
+  m_ue_db.journal_sqn(*ue_ctx);
   m_logger.debug("Incremented SQN  -- IMSI: %015" PRIu64 "", ue_ctx->imsi);
   m_logger.debug(ue_ctx->sqn, 6, "SQN: ");
 }
@@ -599,28 +746,21 @@ void hss::increment_seq_after_resync(hss_ue_ctx_t* ue_ctx)
   for (int i = 0; i < 6; i++) {
     sqn[i] = (nextsqn >> (5 - i) * 8) & 0xFF;
   }
+  m_ue_db.journal_sqn(*ue_ctx);
   return;
 }
 
 void hss::gen_rand(uint8_t rand_[16])
 {
-  for (int i = 0; i < 16; i++) {
-    rand_[i] = rand() % 256; // Pulls on byte at a time. It's slow, but does not depend on RAND_MAX.
+  // One generator per thread, authentication requests for different users run concurrently
+  thread_local std::mt19937_64 generator(std::random_device{}());
+  for (int i = 0; i < 16; i += 8) {
+    uint64_t r = generator();
+    memcpy(&rand_[i], &r, sizeof(r));
   }
   return;
 }
 
-hss_ue_ctx_t* hss::get_ue_ctx(uint64_t imsi)
-{
-  std::map<uint64_t, std::unique_ptr<hss_ue_ctx_t> >::iterator ue_ctx_it = m_imsi_to_ue_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_ue_ctx.end()) {
-    m_logger.info("User not found. IMSI: %015" PRIu64 "", imsi);
-    return nullptr;
-  }
-
-  return ue_ctx_it->second.get();
-}
-
 std::map<std::string, uint64_t> hss::get_ip_to_imsi(void) const
 {
   return m_ip_to_imsi;
@@ -0,0 +1,171 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsepc/hdr/hss/hss_milenage.h"
+#include "srsran/common/security.h"
+#include <cstring>
+
+#ifdef __AES__
+#include <wmmintrin.h>
+#endif // __AES__
+
+namespace srsepc {
+
+#ifdef __AES__
+
+namespace {
+
+/// Number of vectors computed together, 4 vectors make 16 independent AES blocks for OUT1 to OUT4
+const uint32_t milenage_batch_size = 4;
+
+template <int rcon>
+inline __m128i aes128_next_round_key(__m128i key)
+{
+  __m128i t = _mm_shuffle_epi32(_mm_aeskeygenassist_si128(key, rcon), _MM_SHUFFLE(3, 3, 3, 3));
+  key       = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key       = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  key       = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+  return _mm_xor_si128(key, t);
+}
+
+inline void aes128_key_schedule(const uint8_t* key, __m128i rk[11])
+{
+  rk[0]  = _mm_loadu_si128((const __m128i*)key);
+  rk[1]  = aes128_next_round_key<0x01>(rk[0]);
+  rk[2]  = aes128_next_round_key<0x02>(rk[1]);
+  rk[3]  = aes128_next_round_key<0x04>(rk[2]);
+  rk[4]  = aes128_next_round_key<0x08>(rk[3]);
+  rk[5]  = aes128_next_round_key<0x10>(rk[4]);
+  rk[6]  = aes128_next_round_key<0x20>(rk[5]);
+  rk[7]  = aes128_next_round_key<0x40>(rk[6]);
+  rk[8]  = aes128_next_round_key<0x80>(rk[7]);
+  rk[9]  = aes128_next_round_key<0x1b>(rk[8]);
+  rk[10] = aes128_next_round_key<0x36>(rk[9]);
+}
+
+/// Encrypts N blocks, block i with the round keys rk[i / (N / milenage_batch_size)], round by round so that the
+/// AESENC of the different blocks overlap in the pipeline
+template <uint32_t N>
+inline void aes128_encrypt_interleaved(const __m128i rk[milenage_batch_size][11], __m128i x[N])
+{
+  const uint32_t blocks_per_key = N / milenage_batch_size;
+  for (uint32_t i = 0; i < N; i++) {
+    x[i] = _mm_xor_si128(x[i], rk[i / blocks_per_key][0]);
+  }
+  for (uint32_t r = 1; r < 10; r++) {
+    for (uint32_t i = 0; i < N; i++) {
+      x[i] = _mm_aesenc_si128(x[i], rk[i / blocks_per_key][r]);
+    }
+  }
+  for (uint32_t i = 0; i < N; i++) {
+    x[i] = _mm_aesenclast_si128(x[i], rk[i / blocks_per_key][10]);
+  }
+}
+
+/// Cyclic rotation to the left by a multiple of 32 bits, rot(x, r) in TS 35.206
+inline __m128i milenage_rot32(__m128i x)
+{
+  return _mm_shuffle_epi32(x, _MM_SHUFFLE(0, 3, 2, 1));
+}
+
+inline __m128i milenage_rot64(__m128i x)
+{
+  return _mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+/// Computes up to milenage_batch_size vectors, the unused slots repeat the first vector
+void milenage_f12345_batch(milenage_vector_t* v, uint32_t nof_vectors)
+{
+  // Constants c2, c3 and c4, c1 is zero
+  const __m128i c2 = _mm_set_epi8(1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i c3 = _mm_set_epi8(2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+  const __m128i c4 = _mm_set_epi8(4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+  __m128i rk[milenage_batch_size][11];
+  __m128i opc[milenage_batch_size];
+  __m128i temp[milenage_batch_size];
+  __m128i out[4 * milenage_batch_size];
+
+  // TEMP = E_K(RAND xor OPc)
+  for (uint32_t u = 0; u < milenage_batch_size; u++) {
+    const milenage_vector_t& vec = v[u < nof_vectors ? u : 0];
+    aes128_key_schedule(vec.k, rk[u]);
+    opc[u]  = _mm_loadu_si128((const __m128i*)vec.opc);
+    temp[u] = _mm_xor_si128(_mm_loadu_si128((const __m128i*)vec.rand), opc[u]);
+  }
+  aes128_encrypt_interleaved<milenage_batch_size>(rk, temp);
+
+  // Inputs of OUT1 to OUT4
+  for (uint32_t u = 0; u < milenage_batch_size; u++) {
+    const milenage_vector_t& vec = v[u < nof_vectors ? u : 0];
+
+    // IN1 = SQN || AMF || SQN || AMF
+    uint8_t in1_half[8];
+    memcpy(&in1_half[0], vec.sqn, 6);
+    memcpy(&in1_half[6], vec.amf, 2);
+    __m128i in1 = _mm_loadl_epi64((const __m128i*)in1_half);
+    in1         = _mm_unpacklo_epi64(in1, in1);
+
+    __m128i t      = _mm_xor_si128(temp[u], opc[u]);
+    out[4 * u + 0] = _mm_xor_si128(temp[u], milenage_rot64(_mm_xor_si128(in1, opc[u])));
+    out[4 * u + 1] = _mm_xor_si128(t, c2);
+    out[4 * u + 2] = _mm_xor_si128(milenage_rot32(t), c3);
+    out[4 * u + 3] = _mm_xor_si128(milenage_rot64(t), c4);
+  }
+  aes128_encrypt_interleaved<4 * milenage_batch_size>(rk, out);
+
+  for (uint32_t u = 0; u < nof_vectors; u++) {
+    milenage_vector_t& vec = v[u];
+    uint8_t            out1[16];
+    uint8_t            out2[16];
+    _mm_storeu_si128((__m128i*)out1, _mm_xor_si128(out[4 * u + 0], opc[u]));
+    _mm_storeu_si128((__m128i*)out2, _mm_xor_si128(out[4 * u + 1], opc[u]));
+    _mm_storeu_si128((__m128i*)vec.ck, _mm_xor_si128(out[4 * u + 2], opc[u]));
+    _mm_storeu_si128((__m128i*)vec.ik, _mm_xor_si128(out[4 * u + 3], opc[u]));
+    memcpy(vec.mac_a, &out1[0], 8);
+    memcpy(vec.res, &out2[8], 8);
+    memcpy(vec.ak, &out2[0], 6);
+  }
+}
+
+} // namespace
+
+void milenage_f12345(milenage_vector_t* vectors, uint32_t nof_vectors)
+{
+  for (uint32_t i = 0; i < nof_vectors; i += milenage_batch_size) {
+    uint32_t n = nof_vectors - i < milenage_batch_size ? nof_vectors - i : milenage_batch_size;
+    milenage_f12345_batch(&vectors[i], n);
+  }
+}
+
+#else // __AES__
+
+void milenage_f12345(milenage_vector_t* vectors, uint32_t nof_vectors)
+{
+  for (uint32_t i = 0; i < nof_vectors; i++) {
+    milenage_vector_t& v = vectors[i];
+    srsran::security_milenage_f2345(v.k, v.opc, v.rand, v.res, v.ck, v.ik, v.ak);
+    srsran::security_milenage_f1(v.k, v.opc, v.rand, v.sqn, v.amf, v.mac_a);
+  }
+}
+
+#endif // __AES__
+
+} // namespace srsepc
@@ -0,0 +1,351 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+#include "srsepc/hdr/hss/hss_ue_db.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace srsepc {
+
+namespace {
+
+const char     snapshot_magic[8] = {'S', 'R', 'S', 'H', 'S', 'S', 'D', 'B'};
+const uint32_t snapshot_version  = 1;
+
+/// Snapshot layout (host byte order): header followed by nof_records records sorted by IMSI
+struct snapshot_header_t {
+  char     magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t nof_records;
+  uint64_t source_mtime_ns;
+  uint64_t source_size;
+};
+
+struct snapshot_record_t {
+  uint64_t imsi;
+  uint8_t  algo;
+  uint8_t  op_configured;
+  uint16_t qci;
+  uint32_t static_ip; // IPv4 address in network byte order, 0 if dynamic
+  uint8_t  key[16];
+  uint8_t  op[16];
+  uint8_t  opc[16];
+  uint8_t  amf[2];
+  uint8_t  sqn[6];
+  uint8_t  last_rand[16];
+  char     name[48]; // Not null terminated if it uses the whole field
+};
+
+/// Journal record, the check detects a record torn by an abrupt termination
+struct journal_record_t {
+  uint64_t imsi;
+  uint8_t  sqn[6];
+  uint16_t check;
+};
+
+static_assert(sizeof(snapshot_header_t) == 40, "Unexpected snapshot header size");
+static_assert(sizeof(snapshot_record_t) == 136, "Unexpected snapshot record size");
+static_assert(sizeof(journal_record_t) == 16, "Unexpected journal record size");
+
+uint16_t journal_check(const journal_record_t& r)
+{
+  uint16_t check = 0xA55A;
+  for (uint32_t i = 0; i < 4; i++) {
+    check ^= (uint16_t)(r.imsi >> (16 * i));
+  }
+  for (uint32_t i = 0; i < 3; i++) {
+    check ^= (uint16_t)(r.sqn[2 * i] << 8U | r.sqn[2 * i + 1]);
+  }
+  return check;
+}
+
+} // namespace
+
+hss_ue_db::~hss_ue_db()
+{
+  close_journal();
+}
+
+bool hss_ue_db::insert(std::unique_ptr<hss_ue_ctx_t> ue_ctx)
+{
+  uint64_t                    imsi = ue_ctx->imsi;
+  shard_t&                    s    = get_shard(imsi);
+  std::lock_guard<std::mutex> lock(s.mutex);
+  return s.ue_ctx.insert(std::make_pair(imsi, std::move(ue_ctx))).second;
+}
+
+void hss_ue_db::reserve(size_t nof_ue)
+{
+  for (shard_t& s : shards) {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.ue_ctx.reserve(nof_ue / nof_shards + 1);
+  }
+}
+
+size_t hss_ue_db::size()
+{
+  size_t ret = 0;
+  for (shard_t& s : shards) {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    ret += s.ue_ctx.size();
+  }
+  return ret;
+}
+
+void hss_ue_db::clear()
+{
+  for (shard_t& s : shards) {
+    std::lock_guard<std::mutex> lock(s.mutex);
+    s.ue_ctx.clear();
+  }
+}
+
+std::vector<std::unique_lock<std::mutex> > hss_ue_db::lock_all()
+{
+  std::vector<std::unique_lock<std::mutex> > locks;
+  locks.reserve(nof_shards);
+  for (shard_t& s : shards) {
+    locks.emplace_back(s.mutex);
+  }
+  return locks;
+}
+
+std::vector<const hss_ue_ctx_t*> hss_ue_db::sorted()
+{
+  std::vector<const hss_ue_ctx_t*> ret;
+  for (shard_t& s : shards) {
+    for (const auto& it : s.ue_ctx) {
+      ret.push_back(it.second.get());
+    }
+  }
+  std::sort(ret.begin(), ret.end(), [](const hss_ue_ctx_t* a, const hss_ue_ctx_t* b) { return a->imsi < b->imsi; });
+  return ret;
+}
+
+bool hss_ue_db::read_snapshot(const std::string& filename, hss_db_source_t* source)
+{
+  int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    logger.info("No HSS snapshot %s", filename.c_str());
+    return false;
+  }
+
+  struct stat st = {};
+  if (fstat(fd, &st) < 0 or (size_t)st.st_size < sizeof(snapshot_header_t)) {
+    logger.error("Invalid HSS snapshot %s", filename.c_str());
+    close(fd);
+    return false;
+  }
+  size_t len = (size_t)st.st_size;
+  void*  ptr = mmap(nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    logger.error("Error mapping HSS snapshot %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  madvise(ptr, len, MADV_SEQUENTIAL);
+
+  const snapshot_header_t* header = (const snapshot_header_t*)ptr;
+  if (memcmp(header->magic, snapshot_magic, sizeof(snapshot_magic)) != 0 or header->version != snapshot_version or
+      header->record_size != sizeof(snapshot_record_t) or
+      len != sizeof(snapshot_header_t) + header->nof_records * sizeof(snapshot_record_t)) {
+    logger.error("Invalid HSS snapshot %s", filename.c_str());
+    munmap(ptr, len);
+    return false;
+  }
+
+  clear();
+  reserve(header->nof_records);
+  const snapshot_record_t* records = (const snapshot_record_t*)((const uint8_t*)ptr + sizeof(snapshot_header_t));
+  for (uint64_t i = 0; i < header->nof_records; i++) {
+    const snapshot_record_t&      r      = records[i];
+    std::unique_ptr<hss_ue_ctx_t> ue_ctx = std::unique_ptr<hss_ue_ctx_t>(new hss_ue_ctx_t);
+    ue_ctx->name                         = std::string(r.name, strnlen(r.name, sizeof(r.name)));
+    ue_ctx->imsi                         = r.imsi;
+    ue_ctx->algo                         = (r.algo == HSS_ALGO_XOR) ? HSS_ALGO_XOR : HSS_ALGO_MILENAGE;
+    ue_ctx->op_configured                = r.op_configured != 0;
+    ue_ctx->qci                          = r.qci;
+    memcpy(ue_ctx->key, r.key, sizeof(r.key));
+    memcpy(ue_ctx->op, r.op, sizeof(r.op));
+    memcpy(ue_ctx->opc, r.opc, sizeof(r.opc));
+    memcpy(ue_ctx->amf, r.amf, sizeof(r.amf));
+    ue_ctx->set_sqn(r.sqn);
+    ue_ctx->set_last_rand(r.last_rand);
+    if (r.static_ip == 0) {
+      ue_ctx->static_ip_addr = "0.0.0.0";
+    } else {
+      char addr[INET_ADDRSTRLEN] = {};
+      inet_ntop(AF_INET, &r.static_ip, addr, sizeof(addr));
+      ue_ctx->static_ip_addr = addr;
+    }
+    if (not insert(std::move(ue_ctx))) {
+      logger.error("Duplicated IMSI %015" PRIu64 " in HSS snapshot %s", r.imsi, filename.c_str());
+      munmap(ptr, len);
+      clear();
+      return false;
+    }
+  }
+
+  source->mtime_ns = header->source_mtime_ns;
+  source->size     = header->source_size;
+  uint64_t nof_ue  = header->nof_records;
+  munmap(ptr, len);
+
+  int nof_updates = replay_journal(journal_filename(filename));
+  logger.info("Loaded %" PRIu64 " users from HSS snapshot %s and %d SQN updates from its journal",
+              nof_ue,
+              filename.c_str(),
+              nof_updates);
+  return true;
+}
+
+bool hss_ue_db::write_snapshot(const std::string& filename, const hss_db_source_t& source)
+{
+  // Hold every shard until the journal is emptied, so no SQN update falls between the snapshot and the journal
+  std::vector<std::unique_lock<std::mutex> > locks  = lock_all();
+  std::vector<const hss_ue_ctx_t*>           ue_ctx = sorted();
+
+  std::string tmp_filename = filename + ".tmp";
+  FILE*       f            = fopen(tmp_filename.c_str(), "wb");
+  if (f == nullptr) {
+    logger.error("Error opening HSS snapshot %s: %s", tmp_filename.c_str(), strerror(errno));
+    return false;
+  }
+
+  snapshot_header_t header = {};
+  memcpy(header.magic, snapshot_magic, sizeof(snapshot_magic));
+  header.version         = snapshot_version;
+  header.record_size     = sizeof(snapshot_record_t);
+  header.nof_records     = ue_ctx.size();
+  header.source_mtime_ns = source.mtime_ns;
+  header.source_size     = source.size;
+  bool ok                = fwrite(&header, sizeof(header), 1, f) == 1;
+
+  for (const hss_ue_ctx_t* ctx : ue_ctx) {
+    snapshot_record_t r = {};
+    r.imsi              = ctx->imsi;
+    r.algo              = (uint8_t)ctx->algo;
+    r.op_configured     = ctx->op_configured ? 1 : 0;
+    r.qci               = ctx->qci;
+    if (ctx->static_ip_addr != "0.0.0.0") {
+      inet_pton(AF_INET, ctx->static_ip_addr.c_str(), &r.static_ip);
+    }
+    memcpy(r.key, ctx->key, sizeof(r.key));
+    memcpy(r.op, ctx->op, sizeof(r.op));
+    memcpy(r.opc, ctx->opc, sizeof(r.opc));
+    memcpy(r.amf, ctx->amf, sizeof(r.amf));
+    memcpy(r.sqn, ctx->sqn, sizeof(r.sqn));
+    memcpy(r.last_rand, ctx->last_rand, sizeof(r.last_rand));
+    if (ctx->name.size() > sizeof(r.name)) {
+      logger.warning("Name of user %015" PRIu64 " truncated in the HSS snapshot", ctx->imsi);
+    }
+    memcpy(r.name, ctx->name.data(), std::min(ctx->name.size(), sizeof(r.name)));
+    ok = ok and fwrite(&r, sizeof(r), 1, f) == 1;
+  }
+
+  ok = ok and fflush(f) == 0 and fsync(fileno(f)) == 0;
+  ok = (fclose(f) == 0) and ok;
+  if (not ok or rename(tmp_filename.c_str(), filename.c_str()) < 0) {
+    logger.error("Error writing HSS snapshot %s: %s", filename.c_str(), strerror(errno));
+    unlink(tmp_filename.c_str());
+    return false;
+  }
+
+  // The snapshot includes all the SQN updates, empty the journal
+  if (journal_fd >= 0) {
+    if (ftruncate(journal_fd, 0) < 0) {
+      logger.error("Error emptying HSS journal: %s", strerror(errno));
+    }
+  } else {
+    unlink(journal_filename(filename).c_str());
+  }
+
+  logger.info("Saved %zd users in HSS snapshot %s", ue_ctx.size(), filename.c_str());
+  return true;
+}
+
+bool hss_ue_db::open_journal(const std::string& snapshot_filename)
+{
+  close_journal();
+  std::string filename = journal_filename(snapshot_filename);
+  journal_fd           = open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+  if (journal_fd < 0) {
+    logger.error("Error opening HSS journal %s: %s", filename.c_str(), strerror(errno));
+    return false;
+  }
+  return true;
+}
+
+void hss_ue_db::close_journal()
+{
+  if (journal_fd >= 0) {
+    close(journal_fd);
+    journal_fd = -1;
+  }
+}
+
+void hss_ue_db::journal_sqn(const hss_ue_ctx_t& ue_ctx)
+{
+  if (journal_fd < 0) {
+    return;
+  }
+
+  journal_record_t r = {};
+  r.imsi             = ue_ctx.imsi;
+  memcpy(r.sqn, ue_ctx.sqn, sizeof(r.sqn));
+  r.check = journal_check(r);
+
+  // Appends of a single record are atomic, concurrent updates from different shards do not interleave
+  if (write(journal_fd, &r, sizeof(r)) != (ssize_t)sizeof(r)) {
+    logger.error("Error writing HSS journal: %s", strerror(errno));
+  }
+}
+
+int hss_ue_db::replay_journal(const std::string& filename)
+{
+  FILE* f = fopen(filename.c_str(), "rb");
+  if (f == nullptr) {
+    return 0;
+  }
+
+  int              nof_updates = 0;
+  journal_record_t r           = {};
+  while (fread(&r, sizeof(r), 1, f) == 1) {
+    if (r.check != journal_check(r)) {
+      logger.warning("Ignoring corrupted records at the end of HSS journal %s", filename.c_str());
+      break;
+    }
+    if (apply(r.imsi, [&r](hss_ue_ctx_t& ue_ctx) { ue_ctx.set_sqn(r.sqn); })) {
+      nof_updates++;
+    }
+  }
+  fclose(f);
+  return nof_updates;
+}
+
+} // namespace srsepc
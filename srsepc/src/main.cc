@@ -95,6 +95,9 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   string   short_net_name;
   bool     request_imeisv;
   string   hss_db_file;
+  string   hss_db_snapshot;
+  uint32_t hss_auth_workers = 0;
+  uint32_t s1ap_workers     = 0;
   string   hss_auth_algo;
   string   log_filename;
   string   lac;
@@ -126,7 +129,10 @@ void parse_args(all_args_t* args, int argc, char* argv[])
     ("mme.paging_timer",    bpo::value<uint16_t>(&paging_timer)->default_value(2),           "Set paging timer value in seconds (T3413)")
     ("mme.request_imeisv",  bpo::value<bool>(&request_imeisv)->default_value(false),         "Enable IMEISV request in Security mode command")
     ("mme.lac",             bpo::value<string>(&lac)->default_value("0x01"),                 "Location Area Code")
+    ("mme.s1ap_workers",    bpo::value<uint32_t>(&s1ap_workers)->default_value(0),           "Number of threads processing S1AP and NAS messages (0 processes them on the MME thread)")
     ("hss.db_file",         bpo::value<string>(&hss_db_file)->default_value("ue_db.csv"),    ".csv file that stores UE's keys")
+    ("hss.db_snapshot",     bpo::value<string>(&hss_db_snapshot)->default_value(""),          "Binary snapshot of the .csv file with a journal of SQN updates, the .csv file is then only read")
+    ("hss.auth_workers",    bpo::value<uint32_t>(&hss_auth_workers)->default_value(2),        "Number of threads generating authentication vectors")
     ("spgw.gtpu_bind_addr", bpo::value<string>(&spgw_bind_addr)->default_value("127.0.0.1"), "IP address of SP-GW for the S1-U connection")
     ("spgw.sgi_if_addr",    bpo::value<string>(&sgi_if_addr)->default_value("176.16.0.1"),   "IP address of TUN interface for the SGi connection")
     ("spgw.sgi_if_name",    bpo::value<string>(&sgi_if_name)->default_value("srs_spgw_sgi"), "Name of TUN interface for the SGi connection")
@@ -283,11 +289,14 @@ void parse_args(all_args_t* args, int argc, char* argv[])
   args->mme_args.s1ap_args.mme_apn        = mme_apn;
   args->mme_args.s1ap_args.paging_timer   = paging_timer;
   args->mme_args.s1ap_args.request_imeisv = request_imeisv;
+  args->mme_args.s1ap_args.nof_workers    = s1ap_workers;
   args->spgw_args.gtpu_bind_addr          = spgw_bind_addr;
   args->spgw_args.sgi_if_addr             = sgi_if_addr;
   args->spgw_args.sgi_if_name             = sgi_if_name;
   args->spgw_args.max_paging_queue        = max_paging_queue;
   args->hss_args.db_file                  = hss_db_file;
+  args->hss_args.db_snapshot              = hss_db_snapshot;
+  args->hss_args.auth_workers             = hss_auth_workers;
 
   // Apply all_level to any unset layers
   if (vm.count("log.all_level")) {
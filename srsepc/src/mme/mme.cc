@@ -23,6 +23,7 @@
 #include <arpa/inet.h>
 #include <inttypes.h> // for printing uint64_t
 #include <netinet/sctp.h>
+#include <sys/eventfd.h>
 #include <sys/socket.h>
 #include <sys/types.h>
 
@@ -77,6 +78,16 @@ int mme::init(mme_args_t* args)
     exit(-1);
   }
 
+  /*Authentication vectors are generated by the HSS workers*/
+  m_hss = hss::get_instance();
+
+  /*Wakes up the MME thread when the timers change*/
+  timers_event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (timers_event_fd < 0) {
+    srsran::console("Error creating timers event fd\n");
+    exit(-1);
+  }
+
   /*Log successful initialization*/
   m_s1ap_logger.info("MME Initialized. MCC: 0x%x, MNC: 0x%x", args->s1ap_args.mcc, args->s1ap_args.mnc);
   srsran::console("MME Initialized. MCC: 0x%x, MNC: 0x%x\n", args->s1ap_args.mcc, args->s1ap_args.mnc);
@@ -92,6 +103,10 @@ void mme::stop()
     thread_cancel();
     wait_thread_finish();
   }
+  if (timers_event_fd >= 0) {
+    close(timers_event_fd);
+    timers_event_fd = -1;
+  }
   return;
 }
 
@@ -114,20 +129,28 @@ void mme::run_thread()
   // Mark the thread as running
   m_running = true;
 
-  // Get S1-MME and S11 sockets
-  int s1mme = m_s1ap->get_s1_mme();
-  int s11   = m_mme_gtpc->get_s11();
+  // Get S1-MME and S11 sockets, and the HSS authentication vector notifications
+  int s1mme   = m_s1ap->get_s1_mme();
+  int s11     = m_mme_gtpc->get_s11();
+  int hss_avs = m_hss->get_auth_info_fd();
 
   while (m_running) {
     pdu->clear();
-    int max_fd = std::max(s1mme, s11);
+    int max_fd = std::max(std::max(s1mme, s11), std::max(hss_avs, timers_event_fd));
 
     FD_ZERO(&m_set);
     FD_SET(s1mme, &m_set);
     FD_SET(s11, &m_set);
+    FD_SET(hss_avs, &m_set);
+    FD_SET(timers_event_fd, &m_set);
 
     // Add timers to select
-    for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end(); ++it) {
+    std::vector<mme_timer_t> select_timers;
+    {
+      std::lock_guard<std::mutex> lock(timers_mutex);
+      select_timers = timers;
+    }
+    for (std::vector<mme_timer_t>::iterator it = select_timers.begin(); it != select_timers.end(); ++it) {
       FD_SET(it->fd, &m_set);
       max_fd = std::max(max_fd, it->fd);
       m_s1ap_logger.debug("Adding Timer fd %d to fd_set", it->fd);
@@ -153,6 +176,9 @@ void mme::run_thread()
             if (notification->sn_header.sn_type == SCTP_SHUTDOWN_EVENT) {
               m_s1ap_logger.info("SCTP Association Shutdown. Association: %d", sri.sinfo_assoc_id);
               srsran::console("SCTP Association Shutdown. Association: %d\n", sri.sinfo_assoc_id);
+              if (m_s1ap->workers_enabled()) {
+                m_s1ap->wait_workers_idle();
+              }
               m_s1ap->delete_enb_ctx(sri.sinfo_assoc_id);
             }
           } else {
@@ -166,20 +192,42 @@ void mme::run_thread()
       // Handle S11
       if (FD_ISSET(s11, &m_set)) {
         pdu->N_bytes = recvfrom(s11, pdu->msg, sz, 0, NULL, NULL);
-        m_mme_gtpc->handle_s11_pdu(pdu.get());
+        handle_s11_pdu(pdu.get());
+      }
+      // Handle authentication vectors
+      if (FD_ISSET(hss_avs, &m_set)) {
+        m_hss->get_auth_info_answers(auth_answers);
+        for (const hss_auth_info_answer_t& answer : auth_answers) {
+          handle_auth_info_answer(answer);
+        }
       }
-      // Handle NAS Timers
-      for (std::vector<mme_timer_t>::iterator it = timers.begin(); it != timers.end();) {
-        if (FD_ISSET(it->fd, &m_set)) {
+      // The timers changed, select again with the new ones
+      if (FD_ISSET(timers_event_fd, &m_set)) {
+        uint64_t nof_events;
+        rd_sz = read(timers_event_fd, &nof_events, sizeof(nof_events));
+      }
+      // Handle NAS Timers. The ones removed or replaced while waiting are skipped
+      for (const mme_timer_t& select_timer : select_timers) {
+        if (not FD_ISSET(select_timer.fd, &m_set)) {
+          continue;
+        }
+        {
+          std::lock_guard<std::mutex>        lock(timers_mutex);
+          std::vector<mme_timer_t>::iterator it = timers.begin();
+          while (it != timers.end() and
+                 (it->fd != select_timer.fd or it->type != select_timer.type or it->imsi != select_timer.imsi)) {
+            ++it;
+          }
+          if (it == timers.end()) {
+            continue;
+          }
           m_s1ap_logger.info("Timer expired");
           uint64_t exp;
           rd_sz = read(it->fd, &exp, sizeof(uint64_t));
-          m_s1ap->expire_nas_timer(it->type, it->imsi);
           close(it->fd);
           timers.erase(it);
-        } else {
-          ++it;
         }
+        expire_nas_timer(select_timer.type, select_timer.imsi);
       }
     } else {
       m_s1ap_logger.debug("No data from select.");
@@ -188,6 +236,51 @@ void mme::run_thread()
   return;
 }
 
+/*
+ * UE events
+ */
+void mme::handle_s11_pdu(srsran::byte_buffer_t* pdu)
+{
+  if (not m_s1ap->workers_enabled()) {
+    m_mme_gtpc->handle_s11_pdu(pdu);
+    return;
+  }
+
+  // The UE is identified by the MME control TEID of the message
+  srsran::unique_byte_buffer_t s11_pdu = srsran::make_byte_buffer();
+  if (s11_pdu == nullptr or pdu->N_bytes > s11_pdu->get_tailroom()) {
+    m_s1ap_logger.error("Couldn't copy S11 PDU of %d bytes", pdu->N_bytes);
+    return;
+  }
+  memcpy(s11_pdu->msg, pdu->msg, pdu->N_bytes);
+  s11_pdu->N_bytes = pdu->N_bytes;
+
+  uint64_t imsi = m_mme_gtpc->find_imsi_from_ctrl_teid(((srsran::gtpc_pdu*)s11_pdu->msg)->header.teid);
+  m_s1ap->push_ue_task(m_s1ap->get_worker_from_imsi(imsi),
+                       [this, msg = std::move(s11_pdu)]() { m_mme_gtpc->handle_s11_pdu(msg.get()); });
+}
+
+void mme::handle_auth_info_answer(const hss_auth_info_answer_t& answer)
+{
+  if (not m_s1ap->workers_enabled()) {
+    m_s1ap->handle_auth_info_answer(answer);
+    return;
+  }
+  std::unique_ptr<hss_auth_info_answer_t> worker_answer(new hss_auth_info_answer_t(answer));
+  m_s1ap->push_ue_task(m_s1ap->get_worker_from_mme_ue_s1ap_id(answer.mme_ue_s1ap_id),
+                       [this, a = std::move(worker_answer)]() { m_s1ap->handle_auth_info_answer(*a); });
+}
+
+void mme::expire_nas_timer(enum nas_timer_type type, uint64_t imsi)
+{
+  if (not m_s1ap->workers_enabled()) {
+    m_s1ap->expire_nas_timer(type, imsi);
+    return;
+  }
+  m_s1ap->push_ue_task(m_s1ap->get_worker_from_imsi(imsi),
+                       [this, type, imsi]() { m_s1ap->expire_nas_timer(type, imsi); });
+}
+
 /*
  * Timer Handling
  */
@@ -200,12 +293,17 @@ bool mme::add_nas_timer(int timer_fd, nas_timer_type type, uint64_t imsi)
   timer.type = type;
   timer.imsi = imsi;
 
-  timers.push_back(timer);
+  {
+    std::lock_guard<std::mutex> lock(timers_mutex);
+    timers.push_back(timer);
+  }
+  notify_timers_changed();
   return true;
 }
 
 bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 {
+  std::lock_guard<std::mutex>        lock(timers_mutex);
   std::vector<mme_timer_t>::iterator it;
   for (it = timers.begin(); it != timers.end(); ++it) {
     if (it->type == type && it->imsi == imsi) {
@@ -217,6 +315,7 @@ bool mme::is_nas_timer_running(nas_timer_type type, uint64_t imsi)
 
 bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 {
+  std::unique_lock<std::mutex>       lock(timers_mutex);
   std::vector<mme_timer_t>::iterator it;
   for (it = timers.begin(); it != timers.end(); ++it) {
     if (it->type == type && it->imsi == imsi) {
@@ -230,10 +329,19 @@ bool mme::remove_nas_timer(nas_timer_type type, uint64_t imsi)
 
   // removing timer
   m_s1ap_logger.debug("Removing NAS timer from MME. IMSI %" PRIu64 ", Type %d, Fd: %d", imsi, type, it->fd);
-  FD_CLR(it->fd, &m_set);
   close(it->fd);
   timers.erase(it);
+  lock.unlock();
+  notify_timers_changed();
   return true;
 }
 
+void mme::notify_timers_changed()
+{
+  uint64_t one = 1;
+  if (write(timers_event_fd, &one, sizeof(one)) < 0) {
+    m_s1ap_logger.warning("Could not notify the MME thread of a timer change");
+  }
+}
+
 } // namespace srsepc
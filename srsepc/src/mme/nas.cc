@@ -209,9 +209,7 @@ bool nas::handle_imsi_attach_request_unknown_ue(uint32_t
                                                 const nas_init_t&                                     args,
                                                 const nas_if_t&                                       itf)
 {
-  nas*                         nas_ctx;
-  srsran::unique_byte_buffer_t nas_tx;
-  auto&                        nas_logger = srslog::fetch_basic_logger("NAS");
+  nas* nas_ctx;
 
   // Interfaces
   s1ap_interface_nas* s1ap = itf.s1ap;
@@ -265,17 +263,6 @@ bool nas::handle_imsi_attach_request_unknown_ue(uint32_t
   // Save attach request type
   nas_ctx->m_emm_ctx.attach_type = attach_req.eps_attach_type;
 
-  // Get Authentication Vectors from HSS
-  if (!hss->gen_auth_info_answer(nas_ctx->m_emm_ctx.imsi,
-                                 nas_ctx->m_sec_ctx.k_asme,
-                                 nas_ctx->m_sec_ctx.autn,
-                                 nas_ctx->m_sec_ctx.rand,
-                                 nas_ctx->m_sec_ctx.xres)) {
-    srsran::console("User not found. IMSI %015" PRIu64 "\n", nas_ctx->m_emm_ctx.imsi);
-    nas_logger.info("User not found. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
-    return false;
-  }
-
   // Allocate eKSI for this authentication vector
   // Here we assume a new security context thus a new eKSI
   nas_ctx->m_sec_ctx.eksi = 0;
@@ -285,21 +272,8 @@ bool nas::handle_imsi_attach_request_unknown_ue(uint32_t
   s1ap->add_nas_ctx_to_mme_ue_s1ap_id_map(nas_ctx);
   s1ap->add_ue_to_enb_set(enb_sri->sinfo_assoc_id, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
 
-  // Pack NAS Authentication Request in Downlink NAS Transport msg
-  nas_tx = srsran::make_byte_buffer();
-  if (nas_tx == nullptr) {
-    nas_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return false;
-  }
-  nas_ctx->pack_authentication_request(nas_tx.get());
-
-  // Send reply to eNB
-  s1ap->send_downlink_nas_transport(
-      nas_ctx->m_ecm_ctx.enb_ue_s1ap_id, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, nas_tx.get(), nas_ctx->m_ecm_ctx.enb_sri);
-
-  nas_logger.info("Downlink NAS: Sending Authentication Request");
-  srsran::console("Downlink NAS: Sending Authentication Request\n");
-  return true;
+  // Get Authentication Vectors from HSS, the Authentication Request is sent when the answer arrives
+  return hss->request_auth_info(nas_ctx->m_emm_ctx.imsi, nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
 }
 
 bool nas::handle_imsi_attach_request_known_ue(nas*                                                  nas_ctx,
@@ -547,27 +521,11 @@ bool nas::handle_guti_attach_request_known_ue(nas*
     srsran::console("GUTI Attach request NAS integrity failed.\n");
     srsran::console("RE-starting authentication procedure.\n");
 
-    // Get Authentication Vectors from HSS
-    if (!hss->gen_auth_info_answer(emm_ctx->imsi, sec_ctx->k_asme, sec_ctx->autn, sec_ctx->rand, sec_ctx->xres)) {
-      srsran::console("User not found. IMSI %015" PRIu64 "\n", emm_ctx->imsi);
-      nas_logger.info("User not found. IMSI %015" PRIu64 "", emm_ctx->imsi);
-      return false;
-    }
-
     // Restarting security context. Reseting eKSI to 0.
     sec_ctx->eksi = 0;
-    nas_tx        = srsran::make_byte_buffer();
-    if (nas_tx == nullptr) {
-      nas_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-      return false;
-    }
-    nas_ctx->pack_authentication_request(nas_tx.get());
 
-    // Send reply to eNB
-    s1ap->send_downlink_nas_transport(ecm_ctx->enb_ue_s1ap_id, ecm_ctx->mme_ue_s1ap_id, nas_tx.get(), *enb_sri);
-    nas_logger.info("Downlink NAS: Sent Authentication Request");
-    srsran::console("Downlink NAS: Sent Authentication Request\n");
-    return true;
+    // Get Authentication Vectors from HSS, the Authentication Request is sent when the answer arrives
+    return hss->request_auth_info(emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
   }
 }
 
@@ -935,14 +893,6 @@ bool nas::handle_attach_request(srsran::byte_buffer_t* nas_rx)
     // Save attach request type
     m_emm_ctx.attach_type = attach_req.eps_attach_type;
 
-    // Get Authentication Vectors from HSS
-    if (!m_hss->gen_auth_info_answer(
-            m_emm_ctx.imsi, m_sec_ctx.k_asme, m_sec_ctx.autn, m_sec_ctx.rand, m_sec_ctx.xres)) {
-      srsran::console("User not found. IMSI %015" PRIu64 "\n", m_emm_ctx.imsi);
-      m_logger.info("User not found. IMSI %015" PRIu64 "", m_emm_ctx.imsi);
-      return false;
-    }
-
     // Allocate eKSI for this authentication vector
     // Here we assume a new security context thus a new eKSI
     m_sec_ctx.eksi = 0;
@@ -950,21 +900,8 @@ bool nas::handle_attach_request(srsran::byte_buffer_t* nas_rx)
     // Save the UE context
     m_s1ap->add_nas_ctx_to_imsi_map(this);
 
-    // Pack NAS Authentication Request in Downlink NAS Transport msg
-    srsran::unique_byte_buffer_t nas_tx = srsran::make_byte_buffer();
-    if (nas_tx == nullptr) {
-      m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-      return false;
-    }
-    pack_authentication_request(nas_tx.get());
-
-    // Send reply to eNB
-    m_s1ap->send_downlink_nas_transport(
-        m_ecm_ctx.enb_ue_s1ap_id, m_ecm_ctx.mme_ue_s1ap_id, nas_tx.get(), m_ecm_ctx.enb_sri);
-
-    m_logger.info("DL NAS: Sending Authentication Request");
-    srsran::console("DL NAS: Sending Authentication Request\n");
-    return true;
+    // Get Authentication Vectors from HSS, the Authentication Request is sent when the answer arrives
+    return m_hss->request_auth_info(m_emm_ctx.imsi, m_ecm_ctx.mme_ue_s1ap_id);
   } else {
     m_logger.error("Attach request from known UE");
   }
@@ -1196,7 +1133,6 @@ bool nas::handle_esm_information_response(srsran::byte_buffer_t* nas_rx)
 
 bool nas::handle_identity_response(srsran::byte_buffer_t* nas_rx)
 {
-  srsran::unique_byte_buffer_t      nas_tx;
   LIBLTE_MME_ID_RESPONSE_MSG_STRUCT id_resp;
 
   LIBLTE_ERROR_ENUM err = liblte_mme_unpack_identity_response_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_rx, &id_resp);
@@ -1216,12 +1152,6 @@ bool nas::handle_identity_response(srsran::byte_buffer_t* nas_rx)
   // Set UE's IMSI
   m_emm_ctx.imsi = imsi;
 
-  // Get Authentication Vectors from HSS
-  if (!m_hss->gen_auth_info_answer(imsi, m_sec_ctx.k_asme, m_sec_ctx.autn, m_sec_ctx.rand, m_sec_ctx.xres)) {
-    srsran::console("User not found. IMSI %015" PRIu64 "\n", imsi);
-    m_logger.info("User not found. IMSI %015" PRIu64 "", imsi);
-    return false;
-  }
   // Identity reponse from unknown GUTI atach. Assigning new eKSI.
   m_sec_ctx.eksi = 0;
 
@@ -1235,21 +1165,8 @@ bool nas::handle_identity_response(srsran::byte_buffer_t* nas_rx)
   // Store UE context im IMSI map
   m_s1ap->add_nas_ctx_to_imsi_map(this);
 
-  // Pack NAS Authentication Request in Downlink NAS Transport msg
-  nas_tx = srsran::make_byte_buffer();
-  if (nas_tx == nullptr) {
-    m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
-    return false;
-  }
-  pack_authentication_request(nas_tx.get());
-
-  // Send reply to eNB
-  m_s1ap->send_downlink_nas_transport(
-      m_ecm_ctx.enb_ue_s1ap_id, m_ecm_ctx.mme_ue_s1ap_id, nas_tx.get(), m_ecm_ctx.enb_sri);
-
-  m_logger.info("Downlink NAS: Sent Authentication Request");
-  srsran::console("Downlink NAS: Sent Authentication Request\n");
-  return true;
+  // Get Authentication Vectors from HSS, the Authentication Request is sent when the answer arrives
+  return m_hss->request_auth_info(imsi, m_ecm_ctx.mme_ue_s1ap_id);
 }
 
 bool nas::handle_tracking_area_update_request(srsran::byte_buffer_t* nas_rx)
@@ -1279,7 +1196,6 @@ bool nas::handle_authentication_failure(srsran::byte_buffer_t* nas_rx)
 {
   m_logger.info("Received Authentication Failure");
 
-  srsran::unique_byte_buffer_t                 nas_tx;
   LIBLTE_MME_AUTHENTICATION_FAILURE_MSG_STRUCT auth_fail;
   LIBLTE_ERROR_ENUM                            err;
 
@@ -1310,31 +1226,13 @@ bool nas::handle_authentication_failure(srsran::byte_buffer_t* nas_rx)
         m_logger.info("Resynchronization failed. IMSI %015" PRIu64 "", m_emm_ctx.imsi);
         return false;
       }
-      // Get Authentication Vectors from HSS
-      if (!m_hss->gen_auth_info_answer(
-              m_emm_ctx.imsi, m_sec_ctx.k_asme, m_sec_ctx.autn, m_sec_ctx.rand, m_sec_ctx.xres)) {
-        srsran::console("User not found. IMSI %015" PRIu64 "\n", m_emm_ctx.imsi);
-        m_logger.info("User not found. IMSI %015" PRIu64 "", m_emm_ctx.imsi);
-        return false;
-      }
-
       // Making sure eKSI is different from previous eKSI.
       m_sec_ctx.eksi = (m_sec_ctx.eksi + 1) % 6;
 
-      // Pack NAS Authentication Request in Downlink NAS Transport msg
-      nas_tx = srsran::make_byte_buffer();
-      if (nas_tx == nullptr) {
-        m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+      // Get Authentication Vectors from HSS, the Authentication Request is sent when the answer arrives
+      if (!m_hss->request_auth_info(m_emm_ctx.imsi, m_ecm_ctx.mme_ue_s1ap_id)) {
         return false;
       }
-      pack_authentication_request(nas_tx.get());
-
-      // Send reply to eNB
-      m_s1ap->send_downlink_nas_transport(
-          m_ecm_ctx.enb_ue_s1ap_id, m_ecm_ctx.mme_ue_s1ap_id, nas_tx.get(), m_ecm_ctx.enb_sri);
-
-      m_logger.info("Downlink NAS: Sent Authentication Request");
-      srsran::console("Downlink NAS: Sent Authentication Request\n");
       // TODO Start T3460 Timer!
       break;
   }
@@ -1367,6 +1265,38 @@ bool nas::handle_detach_request(srsran::byte_buffer_t* nas_msg)
   return true;
 }
 
+/*HSS answers*/
+bool nas::handle_auth_info_answer(const hss_auth_info_answer_t& answer)
+{
+  if (!answer.found) {
+    srsran::console("User not found. IMSI %015" PRIu64 "\n", answer.imsi);
+    m_logger.info("User not found. IMSI %015" PRIu64 "", answer.imsi);
+    return false;
+  }
+
+  // Save Authentication Vector
+  memcpy(m_sec_ctx.k_asme, answer.k_asme, sizeof(m_sec_ctx.k_asme));
+  memcpy(m_sec_ctx.autn, answer.autn, sizeof(m_sec_ctx.autn));
+  memcpy(m_sec_ctx.rand, answer.rand, sizeof(m_sec_ctx.rand));
+  memcpy(m_sec_ctx.xres, answer.xres, sizeof(m_sec_ctx.xres));
+
+  // Pack NAS Authentication Request in Downlink NAS Transport msg
+  srsran::unique_byte_buffer_t nas_tx = srsran::make_byte_buffer();
+  if (nas_tx == nullptr) {
+    m_logger.error("Couldn't allocate PDU in %s().", __FUNCTION__);
+    return false;
+  }
+  pack_authentication_request(nas_tx.get());
+
+  // Send reply to eNB
+  m_s1ap->send_downlink_nas_transport(
+      m_ecm_ctx.enb_ue_s1ap_id, m_ecm_ctx.mme_ue_s1ap_id, nas_tx.get(), m_ecm_ctx.enb_sri);
+
+  m_logger.info("Downlink NAS: Sent Authentication Request");
+  srsran::console("Downlink NAS: Sent Authentication Request\n");
+  return true;
+}
+
 /*Packing/Unpacking helper functions*/
 bool nas::pack_authentication_request(srsran::byte_buffer_t* nas_buffer)
 {
@@ -22,9 +22,11 @@
 #include "srsepc/hdr/mme/s1ap.h"
 #include "srsran/asn1/gtpc.h"
 #include "srsran/common/bcd_helpers.h"
+#include "srsran/common/int_helpers.h"
 #include "srsran/common/liblte_security.h"
 #include "srsran/common/network_utils.h"
 #include <cmath>
+#include <condition_variable>
 #include <inttypes.h> // for printing uint64_t
 #include <random>
 
@@ -33,7 +35,13 @@ namespace srsepc {
 s1ap*           s1ap::m_instance    = NULL;
 pthread_mutex_t s1ap_instance_mutex = PTHREAD_MUTEX_INITIALIZER;
 
-s1ap::s1ap() : m_s1mme(-1), m_next_mme_ue_s1ap_id(1), m_mme_gtpc(NULL) {}
+// Maximum number of events waiting in the queue of each S1AP worker
+const uint32_t s1ap_worker_queue_size = 16384;
+
+// Index of the S1AP worker running in this thread, 0 for the MME thread
+static thread_local uint32_t current_worker = 0;
+
+s1ap::s1ap() : m_s1mme(-1), m_mme_gtpc(NULL) {}
 
 s1ap::~s1ap()
 {
@@ -88,6 +96,19 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
   // Get pointer to GTP-C class
   m_mme_gtpc = mme_gtpc::get_instance();
 
+  // Start the S1AP workers, each one allocating its own MME-UE-S1AP-IDs
+  m_next_mme_ue_s1ap_id = std::vector<std::atomic<uint32_t> >(std::max(1U, s1ap_args.nof_workers));
+  for (std::atomic<uint32_t>& next_id : m_next_mme_ue_s1ap_id) {
+    next_id = 0;
+  }
+  for (uint32_t i = 0; i < s1ap_args.nof_workers; i++) {
+    m_workers.emplace_back(new srsran::task_worker("S1AP_WORKER" + std::to_string(i), s1ap_worker_queue_size));
+    m_workers.back()->push_task([i]() { current_worker = i; });
+  }
+  if (not m_workers.empty()) {
+    m_logger.info("Processing S1AP messages in %zd workers", m_workers.size());
+  }
+
   // Initialize S1-MME
   m_s1mme = enb_listen();
   if (m_s1mme == SRSRAN_ERROR) {
@@ -105,6 +126,12 @@ int s1ap::init(const s1ap_args_t& s1ap_args)
 
 void s1ap::stop()
 {
+  // Finish the events being processed before deleting the contexts
+  for (std::unique_ptr<srsran::task_worker>& worker : m_workers) {
+    worker->stop();
+  }
+  m_workers.clear();
+
   if (m_s1mme != -1) {
     close(m_s1mme);
   }
@@ -116,13 +143,13 @@ void s1ap::stop()
     m_active_enbs.erase(enb_it++);
   }
 
-  std::map<uint64_t, nas*>::iterator ue_it = m_imsi_to_nas_ctx.begin();
-  while (ue_it != m_imsi_to_nas_ctx.end()) {
-    m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", ue_it->first);
-    srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", ue_it->first);
-    delete ue_it->second;
-    m_imsi_to_nas_ctx.erase(ue_it++);
-  }
+  m_imsi_to_nas_ctx.for_each([this](uint64_t imsi, const imsi_entry_t& entry) {
+    m_logger.info("Deleting UE EMM context. IMSI: %015" PRIu64 "", imsi);
+    srsran::console("Deleting UE EMM context. IMSI: %015" PRIu64 "\n", imsi);
+    delete entry.nas_ctx;
+  });
+  m_imsi_to_nas_ctx.clear();
+  m_mme_ue_s1ap_id_to_nas_ctx.clear();
 
   // Cleanup message handlers
   s1ap_mngmt_proc::cleanup();
@@ -143,7 +170,10 @@ int s1ap::get_s1_mme()
 
 uint32_t s1ap::get_next_mme_ue_s1ap_id()
 {
-  return m_next_mme_ue_s1ap_id++;
+  // The IDs of worker w are w + 1 modulo the number of workers. The MME thread shares the counter of worker 0
+  uint32_t nof_workers = m_next_mme_ue_s1ap_id.size();
+  uint32_t next_id     = m_next_mme_ue_s1ap_id[current_worker].fetch_add(1, std::memory_order_relaxed);
+  return 1 + current_worker + nof_workers * next_id;
 }
 
 int s1ap::enb_listen()
@@ -223,6 +253,7 @@ bool s1ap::s1ap_tx_pdu(const asn1::s1ap::s1ap_pdu_c& pdu, struct sctp_sndrcvinfo
   }
 
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(buf->msg, buf->N_bytes);
   }
 
@@ -233,17 +264,36 @@ void s1ap::handle_s1ap_rx_pdu(srsran::byte_buffer_t* pdu, struct sctp_sndrcvinfo
 {
   // Save PCAP
   if (m_pcap_enable) {
+    std::lock_guard<std::mutex> lock(m_pcap_mutex);
     m_pcap.write_s1ap(pdu->msg, pdu->N_bytes);
   }
 
   // Get PDU type
-  s1ap_pdu_t     rx_pdu;
-  asn1::cbit_ref bref(pdu->msg, pdu->N_bytes);
-  if (rx_pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+  std::unique_ptr<s1ap_rx_msg_t> rx_msg(new s1ap_rx_msg_t);
+  asn1::cbit_ref                 bref(pdu->msg, pdu->N_bytes);
+  if (rx_msg->pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
     m_logger.error("Failed to unpack received PDU");
     return;
   }
+  rx_msg->enb_sri = *enb_sri;
 
+  if (not workers_enabled()) {
+    handle_s1ap_rx_msg(rx_msg->pdu, &rx_msg->enb_sri);
+    return;
+  }
+
+  int worker_idx = get_worker_from_s1ap_pdu(rx_msg->pdu, enb_sri);
+  if (worker_idx < 0) {
+    // Messages not associated to a UE, as the S1 Setup, modify the eNB contexts the workers are reading
+    wait_workers_idle();
+    handle_s1ap_rx_msg(rx_msg->pdu, &rx_msg->enb_sri);
+    return;
+  }
+  push_ue_task(worker_idx, [this, msg = std::move(rx_msg)]() { handle_s1ap_rx_msg(msg->pdu, &msg->enb_sri); });
+}
+
+void s1ap::handle_s1ap_rx_msg(const s1ap_pdu_t& rx_pdu, struct sctp_sndrcvinfo* enb_sri)
+{
   switch (rx_pdu.type().value) {
     case s1ap_pdu_t::types_opts::init_msg:
       m_logger.info("Received Initiating PDU");
@@ -310,6 +360,120 @@ void s1ap::handle_successful_outcome(const asn1::s1ap::successful_outcome_s& msg
   }
 }
 
+// S1AP workers
+int s1ap::get_worker_from_s1ap_pdu(const s1ap_pdu_t& rx_pdu, const struct sctp_sndrcvinfo* enb_sri)
+{
+  using init_msg_type_opts_t           = asn1::s1ap::s1ap_elem_procs_o::init_msg_c::types_opts;
+  using successful_outcome_type_opts_t = asn1::s1ap::s1ap_elem_procs_o::successful_outcome_c::types_opts;
+
+  if (rx_pdu.type().value == s1ap_pdu_t::types_opts::init_msg) {
+    const asn1::s1ap::s1ap_elem_procs_o::init_msg_c& msg = rx_pdu.init_msg().value;
+    switch (msg.type().value) {
+      case init_msg_type_opts_t::init_ue_msg:
+        return get_worker_from_init_ue_msg(msg.init_ue_msg(), enb_sri);
+      case init_msg_type_opts_t::ul_nas_transport:
+        return get_worker_from_mme_ue_s1ap_id(msg.ul_nas_transport()->mme_ue_s1ap_id.value.value);
+      case init_msg_type_opts_t::ue_context_release_request:
+        return get_worker_from_mme_ue_s1ap_id(msg.ue_context_release_request()->mme_ue_s1ap_id.value.value);
+      case init_msg_type_opts_t::ue_cap_info_ind:
+        return get_worker_from_mme_ue_s1ap_id(msg.ue_cap_info_ind()->mme_ue_s1ap_id.value.value);
+      default:
+        return -1;
+    }
+  }
+  if (rx_pdu.type().value == s1ap_pdu_t::types_opts::successful_outcome) {
+    const asn1::s1ap::s1ap_elem_procs_o::successful_outcome_c& msg = rx_pdu.successful_outcome().value;
+    switch (msg.type().value) {
+      case successful_outcome_type_opts_t::init_context_setup_resp:
+        return get_worker_from_mme_ue_s1ap_id(msg.init_context_setup_resp()->mme_ue_s1ap_id.value.value);
+      case successful_outcome_type_opts_t::ue_context_release_complete:
+        return get_worker_from_mme_ue_s1ap_id(msg.ue_context_release_complete()->mme_ue_s1ap_id.value.value);
+      default:
+        return -1;
+    }
+  }
+  return -1;
+}
+
+int s1ap::get_worker_from_init_ue_msg(const asn1::s1ap::init_ue_msg_s& init_ue, const struct sctp_sndrcvinfo* enb_sri)
+{
+  // A known UE is identified by its S-TMSI or by the mobile identity of the attach request
+  uint64_t imsi = 0;
+  if (init_ue->s_tmsi_present) {
+    uint32_t m_tmsi = 0;
+    srsran::uint8_to_uint32(init_ue->s_tmsi.value.m_tmsi.data(), &m_tmsi);
+    imsi = find_imsi_from_m_tmsi(m_tmsi);
+  } else {
+    srsran::unique_byte_buffer_t nas_msg = srsran::make_byte_buffer();
+    if (nas_msg == nullptr or init_ue->nas_pdu.value.size() > nas_msg->get_tailroom()) {
+      return 0;
+    }
+    memcpy(nas_msg->msg, init_ue->nas_pdu.value.data(), init_ue->nas_pdu.value.size());
+    nas_msg->N_bytes = init_ue->nas_pdu.value.size();
+
+    uint8_t pd, msg_type;
+    liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &pd, &msg_type);
+    LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+    if (msg_type == LIBLTE_MME_MSG_TYPE_ATTACH_REQUEST and
+        liblte_mme_unpack_attach_request_msg((LIBLTE_BYTE_MSG_STRUCT*)nas_msg.get(), &attach_req) == LIBLTE_SUCCESS) {
+      if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI) {
+        for (int i = 0; i <= 14; i++) {
+          imsi = imsi * 10 + attach_req.eps_mobile_id.imsi[i];
+        }
+      } else if (attach_req.eps_mobile_id.type_of_id == LIBLTE_MME_EPS_MOBILE_ID_TYPE_GUTI) {
+        imsi = find_imsi_from_m_tmsi(attach_req.eps_mobile_id.guti.m_tmsi);
+      }
+    }
+  }
+
+  imsi_entry_t entry = {};
+  if (imsi != 0 and m_imsi_to_nas_ctx.find(imsi, &entry)) {
+    return entry.worker_idx;
+  }
+
+  // A new UE, its context will be created by the worker
+  uint32_t enb_ue_s1ap_id = init_ue->enb_ue_s1ap_id.value.value;
+  return (enb_ue_s1ap_id + (uint32_t)enb_sri->sinfo_assoc_id * 0x9E3779B1U) % m_workers.size();
+}
+
+uint32_t s1ap::get_worker_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id) const
+{
+  return (mme_ue_s1ap_id - 1) % m_workers.size();
+}
+
+uint32_t s1ap::get_worker_from_imsi(uint64_t imsi)
+{
+  imsi_entry_t entry = {};
+  if (m_imsi_to_nas_ctx.find(imsi, &entry)) {
+    return entry.worker_idx;
+  }
+  // The UE does not exist, any worker will discard the event
+  return imsi % m_workers.size();
+}
+
+void s1ap::push_ue_task(uint32_t worker_idx, s1ap_ue_task_t task)
+{
+  m_workers[worker_idx]->push_task(std::move(task));
+}
+
+void s1ap::wait_workers_idle()
+{
+  // The workers are only fed by the MME thread, so once they all reach this point they stay idle until it pushes again
+  std::mutex              mutex;
+  std::condition_variable cvar;
+  uint32_t                nof_pending = m_workers.size();
+  for (std::unique_ptr<srsran::task_worker>& worker : m_workers) {
+    worker->push_task([&mutex, &cvar, &nof_pending]() {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (--nof_pending == 0) {
+        cvar.notify_one();
+      }
+    });
+  }
+  std::unique_lock<std::mutex> lock(mutex);
+  cvar.wait(lock, [&nof_pending]() { return nof_pending == 0; });
+}
+
 // eNB Context Managment
 void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinfo* enb_sri)
 {
@@ -319,6 +483,7 @@ void s1ap::add_new_enb_ctx(const enb_ctx_t& enb_ctx, const struct sctp_sndrcvinf
   *enb_ptr                   = enb_ctx;
   m_active_enbs.emplace(enb_ptr->enb_id, enb_ptr);
   m_sctp_to_enb_id.emplace(enb_sri->sinfo_assoc_id, enb_ptr->enb_id);
+  std::lock_guard<std::mutex> lock(m_enb_ues_mutex);
   m_enb_assoc_to_ue_ids.emplace(enb_sri->sinfo_assoc_id, ue_set);
 }
 
@@ -359,19 +524,17 @@ void s1ap::delete_enb_ctx(int32_t assoc_id)
 // UE Context Management
 bool s1ap::add_nas_ctx_to_imsi_map(nas* nas_ctx)
 {
-  std::map<uint64_t, nas*>::iterator ctx_it = m_imsi_to_nas_ctx.find(nas_ctx->m_emm_ctx.imsi);
-  if (ctx_it != m_imsi_to_nas_ctx.end()) {
-    m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
+  nas* ctx2 = nullptr;
+  if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0 &&
+      m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, &ctx2) && ctx2 != nas_ctx) {
+    m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
     return false;
   }
-  if (nas_ctx->m_ecm_ctx.mme_ue_s1ap_id != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-    if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
-      m_logger.error("Context identified with IMSI does not match context identified by MME UE S1AP Id.");
-      return false;
-    }
+  // The events of the IMSI are processed by the worker creating its context
+  if (not m_imsi_to_nas_ctx.insert(nas_ctx->m_emm_ctx.imsi, {nas_ctx, current_worker})) {
+    m_logger.error("UE Context already exists. IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
+    return false;
   }
-  m_imsi_to_nas_ctx.emplace(nas_ctx->m_emm_ctx.imsi, nas_ctx);
   m_logger.debug("Saved UE context corresponding to IMSI %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
   return true;
 }
@@ -382,25 +545,17 @@ bool s1ap::add_nas_ctx_to_mme_ue_s1ap_id_map(nas* nas_ctx)
     m_logger.error("Could not add UE context to MME UE S1AP map. MME UE S1AP ID 0 is not valid.");
     return false;
   }
-  std::map<uint32_t, nas*>::iterator ctx_it = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-  if (ctx_it != m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  if (not m_mme_ue_s1ap_id_to_nas_ctx.insert(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, nas_ctx)) {
     m_logger.error("UE Context already exists. MME UE S1AP Id %015" PRIu64 "", nas_ctx->m_emm_ctx.imsi);
     return false;
   }
-  if (nas_ctx->m_emm_ctx.imsi != 0) {
-    std::map<uint32_t, nas*>::iterator ctx_it2 = m_mme_ue_s1ap_id_to_nas_ctx.find(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
-    if (ctx_it2 != m_mme_ue_s1ap_id_to_nas_ctx.end() && ctx_it2->second != nas_ctx) {
-      m_logger.error("Context identified with MME UE S1AP Id does not match context identified by IMSI.");
-      return false;
-    }
-  }
-  m_mme_ue_s1ap_id_to_nas_ctx.emplace(nas_ctx->m_ecm_ctx.mme_ue_s1ap_id, nas_ctx);
   m_logger.debug("Saved UE context corresponding to MME UE S1AP Id %d", nas_ctx->m_ecm_ctx.mme_ue_s1ap_id);
   return true;
 }
 
 bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 {
+  std::lock_guard<std::mutex>                      lock(m_enb_ues_mutex);
   std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   if (ues_in_enb == m_enb_assoc_to_ue_ids.end()) {
     m_logger.error("Could not find eNB from eNB SCTP association %d", enb_assoc);
@@ -418,36 +573,36 @@ bool s1ap::add_ue_to_enb_set(int32_t enb_assoc, uint32_t mme_ue_s1ap_id)
 
 nas* s1ap::find_nas_ctx_from_mme_ue_s1ap_id(uint32_t mme_ue_s1ap_id)
 {
-  std::map<uint32_t, nas*>::iterator it = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
-    return NULL;
-  } else {
-    return it->second;
-  }
+  nas* nas_ctx = NULL;
+  m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id, &nas_ctx);
+  return nas_ctx;
 }
 
 nas* s1ap::find_nas_ctx_from_imsi(uint64_t imsi)
 {
-  std::map<uint64_t, nas*>::iterator it = m_imsi_to_nas_ctx.find(imsi);
-  if (it == m_imsi_to_nas_ctx.end()) {
-    return NULL;
-  } else {
-    return it->second;
-  }
+  imsi_entry_t entry = {};
+  m_imsi_to_nas_ctx.find(imsi, &entry);
+  return entry.nas_ctx;
 }
 
 void s1ap::release_ues_ecm_ctx_in_enb(int32_t enb_assoc)
 {
   srsran::console("Releasing UEs context\n");
+  std::lock_guard<std::mutex>                      lock(m_enb_ues_mutex);
   std::map<int32_t, std::set<uint32_t> >::iterator ues_in_enb = m_enb_assoc_to_ue_ids.find(enb_assoc);
   std::set<uint32_t>::iterator                     ue_id      = ues_in_enb->second.begin();
   if (ue_id == ues_in_enb->second.end()) {
     srsran::console("No UEs to be released\n");
   } else {
     while (ue_id != ues_in_enb->second.end()) {
-      std::map<uint32_t, nas*>::iterator nas_ctx = m_mme_ue_s1ap_id_to_nas_ctx.find(*ue_id);
-      emm_ctx_t*                         emm_ctx = &nas_ctx->second->m_emm_ctx;
-      ecm_ctx_t*                         ecm_ctx = &nas_ctx->second->m_ecm_ctx;
+      nas* nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(*ue_id);
+      if (nas_ctx == NULL) {
+        m_logger.error("Could not find UE context to release. MME-UE S1AP Id: %d", *ue_id);
+        ues_in_enb->second.erase(ue_id++);
+        continue;
+      }
+      emm_ctx_t* emm_ctx = &nas_ctx->m_emm_ctx;
+      ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
 
       m_logger.info(
           "Releasing UE context. IMSI: %015" PRIu64 ", UE-MME S1AP Id: %d", emm_ctx->imsi, ecm_ctx->mme_ue_s1ap_id);
@@ -479,13 +634,17 @@ bool s1ap::release_ue_ecm_ctx(uint32_t mme_ue_s1ap_id)
     m_logger.error("Could not find eNB for UE release request.");
     return false;
   }
-  uint16_t                                         enb_id = it->second;
-  std::map<int32_t, std::set<uint32_t> >::iterator ue_set = m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
-  if (ue_set == m_enb_assoc_to_ue_ids.end()) {
-    m_logger.error("Could not find the eNB's UEs.");
-    return false;
+  uint16_t enb_id = it->second;
+  {
+    std::lock_guard<std::mutex>                      lock(m_enb_ues_mutex);
+    std::map<int32_t, std::set<uint32_t> >::iterator ue_set =
+        m_enb_assoc_to_ue_ids.find(ecm_ctx->enb_sri.sinfo_assoc_id);
+    if (ue_set == m_enb_assoc_to_ue_ids.end()) {
+      m_logger.error("Could not find the eNB's UEs.");
+      return false;
+    }
+    ue_set->second.erase(mme_ue_s1ap_id);
   }
-  ue_set->second.erase(mme_ue_s1ap_id);
 
   // Release UE ECM context
   m_mme_ue_s1ap_id_to_nas_ctx.erase(mme_ue_s1ap_id);
@@ -520,21 +679,20 @@ bool s1ap::delete_ue_ctx(uint64_t imsi)
 // UE Bearer Managment
 void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 {
-  std::map<uint64_t, nas*>::iterator ue_ctx_it = m_imsi_to_nas_ctx.find(imsi);
-  if (ue_ctx_it == m_imsi_to_nas_ctx.end()) {
+  nas* nas_ctx = find_nas_ctx_from_imsi(imsi);
+  if (nas_ctx == NULL) {
     m_logger.error("Could not activate EPS bearer: Could not find UE context");
     return;
   }
   // Make sure NAS is active
-  uint32_t                           mme_ue_s1ap_id = ue_ctx_it->second->m_ecm_ctx.mme_ue_s1ap_id;
-  std::map<uint32_t, nas*>::iterator it             = m_mme_ue_s1ap_id_to_nas_ctx.find(mme_ue_s1ap_id);
-  if (it == m_mme_ue_s1ap_id_to_nas_ctx.end()) {
+  uint32_t mme_ue_s1ap_id = nas_ctx->m_ecm_ctx.mme_ue_s1ap_id;
+  if (find_nas_ctx_from_mme_ue_s1ap_id(mme_ue_s1ap_id) == NULL) {
     m_logger.error("Could not activate EPS bearer: ECM context seems to be missing");
     return;
   }
 
-  ecm_ctx_t* ecm_ctx = &ue_ctx_it->second->m_ecm_ctx;
-  esm_ctx_t* esm_ctx = &ue_ctx_it->second->m_esm_ctx[ebi];
+  ecm_ctx_t* ecm_ctx = &nas_ctx->m_ecm_ctx;
+  esm_ctx_t* esm_ctx = &nas_ctx->m_esm_ctx[ebi];
   if (esm_ctx->state != ERAB_CTX_SETUP) {
     m_logger.error(
         "Could not be activate EPS Bearer, bearer in wrong state: MME S1AP Id %d, EPS Bearer id %d, state %d",
@@ -557,20 +715,19 @@ void s1ap::activate_eps_bearer(uint64_t imsi, uint8_t ebi)
 
 uint32_t s1ap::allocate_m_tmsi(uint64_t imsi)
 {
-  uint32_t m_tmsi = m_next_m_tmsi;
-  m_next_m_tmsi   = (m_next_m_tmsi + 1) % UINT32_MAX;
+  uint32_t m_tmsi = m_next_m_tmsi++;
 
-  m_tmsi_to_imsi.emplace(m_tmsi, imsi);
+  m_tmsi_to_imsi.insert(m_tmsi, imsi);
   m_logger.debug("Allocated M-TMSI 0x%x to IMSI %015" PRIu64 ",", m_tmsi, imsi);
   return m_tmsi;
 }
 
 uint64_t s1ap::find_imsi_from_m_tmsi(uint32_t m_tmsi)
 {
-  std::map<uint32_t, uint64_t>::iterator it = m_tmsi_to_imsi.find(m_tmsi);
-  if (it != m_tmsi_to_imsi.end()) {
-    m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", it->second, m_tmsi);
-    return it->second;
+  uint64_t imsi = 0;
+  if (m_tmsi_to_imsi.find(m_tmsi, &imsi)) {
+    m_logger.debug("Found IMSI %015" PRIu64 " from M-TMSI 0x%x", imsi, m_tmsi);
+    return imsi;
   } else {
     m_logger.debug("Could not find IMSI from M-TMSI 0x%x", m_tmsi);
     return SRSRAN_SUCCESS;
@@ -675,4 +832,26 @@ bool s1ap::expire_nas_timer(enum nas_timer_type type, uint64_t imsi)
   return err;
 }
 
+bool s1ap::handle_auth_info_answer(const hss_auth_info_answer_t& answer)
+{
+  // The UE may have been released while the HSS was generating the vector
+  nas* nas_ctx = find_nas_ctx_from_mme_ue_s1ap_id(answer.mme_ue_s1ap_id);
+  if (nas_ctx == nullptr || nas_ctx->m_emm_ctx.imsi != answer.imsi) {
+    m_logger.warning("Discarding authentication vector of IMSI %015" PRIu64 ", UE context not found", answer.imsi);
+    return false;
+  }
+  if (not answer.found) {
+    // Unknown subscriber, drop the context that was registered while waiting for the HSS
+    nas_ctx->handle_auth_info_answer(answer);
+    if (find_nas_ctx_from_imsi(answer.imsi) == nas_ctx) {
+      delete_ue_ctx(answer.imsi);
+    } else {
+      release_ue_ecm_ctx(answer.mme_ue_s1ap_id);
+      delete nas_ctx;
+    }
+    return false;
+  }
+  return nas_ctx->handle_auth_info_answer(answer);
+}
+
 } // namespace srsepc
@@ -466,6 +466,9 @@ spgw_tunnel_ctx_t* spgw::gtpc::create_gtpc_ctx(const struct srsran::gtpc_create_
 
   m_teid_to_tunnel_ctx.emplace(spgw_uplink_ctrl_teid, tunnel_ctx);
   m_imsi_to_ctr_teid.emplace(cs_req.imsi, spgw_uplink_ctrl_teid);
+
+  // Uplink packets are accepted as soon as the eNB knows the S-GW user TEID
+  m_gtpu->create_gtpu_tunnel(ue_ip, spgw_uplink_user_teid);
   return tunnel_ctx;
 }
 
@@ -76,6 +76,13 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
     return err;
   }
 
+  // Start the user-plane thread
+  err = m_data_path.init(m_sgi, m_s1u);
+  if (err != SRSRAN_SUCCESS) {
+    srsran::console("Could not start the user-plane thread.\n");
+    return err;
+  }
+
   m_logger.info("SPGW GTP-U Initialized.");
   srsran::console("SPGW GTP-U Initialized.\n");
   return SRSRAN_SUCCESS;
@@ -83,6 +90,8 @@ int spgw::gtpu::init(spgw_args_t* args, spgw* spgw, gtpc_interface_gtpu* gtpc)
 
 void spgw::gtpu::stop()
 {
+  m_data_path.stop();
+
   // Clean up SGi interface
   if (m_sgi_up) {
     close(m_sgi);
@@ -203,6 +212,19 @@ int spgw::gtpu::init_s1u(spgw_args_t* args)
   return SRSRAN_SUCCESS;
 }
 
+void spgw::gtpu::handle_slow_path_pdus()
+{
+  m_data_path.get_slow_path_pdus(m_slow_path_pdus);
+  for (srsran::unique_byte_buffer_t& msg : m_slow_path_pdus) {
+    handle_sgi_pdu(std::move(msg));
+  }
+  m_slow_path_pdus.clear();
+}
+
+/*
+ * Slow path of the SGi packets, run on the GTP-C thread with the up-to-date tunnel maps. The user-plane thread may
+ * have used a table older than a tunnel modification, so packets for ECM connected UEs are still forwarded here.
+ */
 void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
 {
   bool usr_found = false;
@@ -261,22 +283,6 @@ void spgw::gtpu::handle_sgi_pdu(srsran::unique_byte_buffer_t msg)
   }
 }
 
-void spgw::gtpu::handle_s1u_pdu(srsran::byte_buffer_t* msg)
-{
-  srsran::gtpu_header_t header;
-  srsran::gtpu_read_header(msg, &header, m_logger);
-
-  m_logger.debug("Received PDU from S1-U. Bytes=%d", msg->N_bytes);
-  m_logger.debug("TEID 0x%x. Bytes=%d", header.teid, msg->N_bytes);
-  int n = write(m_sgi, msg->msg, msg->N_bytes);
-  if (n < 0) {
-    m_logger.error("Could not write to TUN interface.");
-  } else {
-    m_logger.debug("Forwarded packet to TUN interface. Bytes= %d/%d", n, msg->N_bytes);
-  }
-  return;
-}
-
 void spgw::gtpu::send_s1u_pdu(srsran::gtp_fteid_t enb_fteid, srsran::byte_buffer_t* msg)
 {
   // Set eNB destination address
@@ -330,6 +336,42 @@ void spgw::gtpu::send_all_queued_packets(srsran::gtp_fteid_t
 /*
  * Tunnel managment
  */
+void spgw::gtpu::publish_tunnels()
+{
+  if (not m_tunnels_changed) {
+    return;
+  }
+  m_tunnels_changed = false;
+
+  std::map<in_addr_t, gtpu_tunnel_t> tunnels;
+  for (const auto& it : m_ip_to_up_user_teid) {
+    tunnels[it.first].up_user_teid = it.second;
+  }
+  for (const auto& it : m_ip_to_ctr_teid) {
+    tunnels[it.first].up_ctrl_teid = it.second;
+  }
+  for (const auto& it : m_ip_to_usr_teid) {
+    tunnels[it.first].dw_user_active = true;
+    tunnels[it.first].dw_user_fteid  = it.second;
+  }
+
+  std::vector<gtpu_tunnel_t> tunnel_list;
+  tunnel_list.reserve(tunnels.size());
+  for (auto& it : tunnels) {
+    it.second.ue_ipv4 = it.first;
+    tunnel_list.push_back(it.second);
+  }
+  m_data_path.publish_tunnels(std::make_shared<const gtpu_tunnel_table>(std::move(tunnel_list)));
+  m_logger.debug("Published %zd GTP-U tunnels to the user-plane thread", tunnels.size());
+}
+
+bool spgw::gtpu::create_gtpu_tunnel(in_addr_t ue_ipv4, uint32_t up_user_teid)
+{
+  m_ip_to_up_user_teid[ue_ipv4] = up_user_teid;
+  m_tunnels_changed             = true;
+  return true;
+}
+
 bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw_user_fteid, uint32_t up_ctrl_teid)
 {
   m_logger.info("Modifying GTP-U Tunnel.");
@@ -342,6 +384,7 @@ bool spgw::gtpu::modify_gtpu_tunnel(in_addr_t ue_ipv4, srsran::gtpc_f_teid_ie dw
   m_logger.info("Uplink C-TEID: 0x%x", up_ctrl_teid);
   m_ip_to_usr_teid[ue_ipv4] = dw_user_fteid;
   m_ip_to_ctr_teid[ue_ipv4] = up_ctrl_teid;
+  m_tunnels_changed         = true;
   return true;
 }
 
@@ -350,6 +393,7 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
   // Remove GTP-U connections, if any.
   if (m_ip_to_usr_teid.count(ue_ipv4)) {
     m_ip_to_usr_teid.erase(ue_ipv4);
+    m_tunnels_changed = true;
   } else {
     m_logger.error("Could not find GTP-U Tunnel to delete.");
     return false;
@@ -360,6 +404,8 @@ bool spgw::gtpu::delete_gtpu_tunnel(in_addr_t ue_ipv4)
 bool spgw::gtpu::delete_gtpc_tunnel(in_addr_t ue_ipv4)
 {
   // Remove Ctrl TEID from IP mapping.
+  m_ip_to_up_user_teid.erase(ue_ipv4);
+  m_tunnels_changed = true;
   if (m_ip_to_ctr_teid.count(ue_ipv4)) {
     m_ip_to_ctr_teid.erase(ue_ipv4);
   } else {
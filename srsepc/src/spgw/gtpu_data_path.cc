@@ -0,0 +1,346 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/gtpu_data_path.h"
+#include "srsepc/hdr/spgw/spgw.h"
+#include "srsran/upper/gtpu.h"
+#include <fcntl.h>
+#include <linux/ip.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace srsepc {
+
+/**************************************
+ *
+ * Tunnel table snapshot
+ *
+ **************************************/
+
+gtpu_tunnel_table::gtpu_tunnel_table(std::vector<gtpu_tunnel_t> tunnels_) : tunnels(std::move(tunnels_))
+{
+  uint32_t nof_slots = 16;
+  while (nof_slots < 2 * tunnels.size()) {
+    nof_slots *= 2;
+  }
+  mask = nof_slots - 1;
+  ip_index.assign(nof_slots, slot_t{0, empty_slot});
+  teid_index.assign(nof_slots, slot_t{0, empty_slot});
+
+  for (uint32_t i = 0; i < tunnels.size(); i++) {
+    insert(ip_index, tunnels[i].ue_ipv4, i);
+    if (tunnels[i].up_user_teid != 0) {
+      insert(teid_index, tunnels[i].up_user_teid, i);
+    }
+  }
+}
+
+void gtpu_tunnel_table::insert(std::vector<slot_t>& index, uint32_t key, uint32_t tunnel_idx)
+{
+  uint32_t i = hash(key) & mask;
+  while (index[i].tunnel_idx != empty_slot and index[i].key != key) {
+    i = (i + 1) & mask;
+  }
+  index[i] = slot_t{key, tunnel_idx};
+}
+
+/**************************************
+ *
+ * User-plane thread
+ *
+ **************************************/
+
+gtpu_data_path::gtpu_data_path() : thread("SPGW_DATA") {}
+
+gtpu_data_path::~gtpu_data_path()
+{
+  stop();
+  if (slow_path_fd >= 0) {
+    close(slow_path_fd);
+  }
+  if (stop_fd >= 0) {
+    close(stop_fd);
+  }
+}
+
+int gtpu_data_path::init(int sgi_fd_, int s1u_fd_)
+{
+  sgi_fd = sgi_fd_;
+  s1u_fd = s1u_fd_;
+
+  // The SGi fd is only read by this thread, a batch is read until it would block
+  int flags = fcntl(sgi_fd, F_GETFL, 0);
+  if (flags < 0 or fcntl(sgi_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    m_logger.error("Failed to set the SGi interface as non-blocking: %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
+
+  slow_path_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  stop_fd      = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (slow_path_fd < 0 or stop_fd < 0) {
+    m_logger.error("Failed to create the user-plane eventfds: %s", strerror(errno));
+    return SRSRAN_ERROR_CANT_START;
+  }
+
+  rx_buffers.resize(batch_size);
+
+  publish_tunnels(std::make_shared<const gtpu_tunnel_table>(std::vector<gtpu_tunnel_t>{}));
+  running = true;
+  start();
+  return SRSRAN_SUCCESS;
+}
+
+void gtpu_data_path::stop()
+{
+  if (running) {
+    running     = false;
+    uint64_t tx = 1;
+    if (write(stop_fd, &tx, sizeof(tx)) != sizeof(tx)) {
+      m_logger.warning("Failed to wake up the user-plane thread");
+    }
+    wait_thread_finish();
+  }
+}
+
+void gtpu_data_path::publish_tunnels(std::shared_ptr<const gtpu_tunnel_table> table)
+{
+  std::atomic_store_explicit(&tunnels, std::move(table), std::memory_order_release);
+}
+
+/// The receive buffers are reused from batch to batch, only those handed to the slow path are allocated again
+srsran::byte_buffer_t* gtpu_data_path::get_rx_buffer(uint32_t idx)
+{
+  if (rx_buffers[idx] == nullptr) {
+    rx_buffers[idx] = srsran::make_byte_buffer("gtpu_data_path::rx");
+    if (rx_buffers[idx] == nullptr) {
+      m_logger.error("Couldn't allocate user-plane buffer");
+      return nullptr;
+    }
+  }
+  rx_buffers[idx]->clear();
+  return rx_buffers[idx].get();
+}
+
+void gtpu_data_path::get_slow_path_pdus(std::vector<srsran::unique_byte_buffer_t>& pdus)
+{
+  uint64_t rx;
+  if (read(slow_path_fd, &rx, sizeof(rx)) < 0 and errno != EAGAIN) {
+    m_logger.warning("Failed to read the slow path eventfd");
+  }
+
+  pdus.clear();
+  std::lock_guard<std::mutex> lock(slow_path_mutex);
+  while (not slow_path_queue.empty()) {
+    pdus.push_back(std::move(slow_path_queue.front()));
+    slow_path_queue.pop_front();
+  }
+}
+
+void gtpu_data_path::push_slow_path(srsran::unique_byte_buffer_t pdu)
+{
+  {
+    std::lock_guard<std::mutex> lock(slow_path_mutex);
+    slow_path_queue.push_back(std::move(pdu));
+  }
+  uint64_t tx = 1;
+  if (write(slow_path_fd, &tx, sizeof(tx)) != sizeof(tx)) {
+    m_logger.warning("Failed to signal the slow path eventfd");
+  }
+}
+
+gtpu_data_path::metrics_t gtpu_data_path::get_metrics() const
+{
+  metrics_t m;
+  m.dl_pkts        = dl_pkts.load(std::memory_order_relaxed);
+  m.dl_bytes       = dl_bytes.load(std::memory_order_relaxed);
+  m.ul_pkts        = ul_pkts.load(std::memory_order_relaxed);
+  m.ul_bytes       = ul_bytes.load(std::memory_order_relaxed);
+  m.dropped_pkts   = dropped_pkts.load(std::memory_order_relaxed);
+  m.slow_path_pkts = slow_path_pkts.load(std::memory_order_relaxed);
+  return m;
+}
+
+void gtpu_data_path::run_thread()
+{
+  struct pollfd fds[3] = {};
+  fds[0].fd            = sgi_fd;
+  fds[0].events        = POLLIN;
+  fds[1].fd            = s1u_fd;
+  fds[1].events        = POLLIN;
+  fds[2].fd            = stop_fd;
+  fds[2].events        = POLLIN;
+
+  while (running) {
+    int n = poll(fds, 3, -1);
+    if (n < 0) {
+      if (errno != EINTR) {
+        m_logger.error("Error from poll: %s", strerror(errno));
+      }
+      continue;
+    }
+
+    // One tunnel table for the whole batch, tables published meanwhile are used from the next one
+    std::shared_ptr<const gtpu_tunnel_table> table =
+        std::atomic_load_explicit(&tunnels, std::memory_order_acquire);
+    if (fds[0].revents & POLLIN) {
+      handle_sgi_batch(table.get());
+    }
+    if (fds[1].revents & POLLIN) {
+      handle_s1u_batch(table.get());
+    }
+  }
+}
+
+/*
+ * SGi -> S1-U. Looks up the UE IP, prepends the GTP-U header in the buffer headroom and sends the whole batch with
+ * one sendmmsg() call.
+ */
+void gtpu_data_path::handle_sgi_batch(const gtpu_tunnel_table* table)
+{
+  struct mmsghdr     msgs[batch_size] = {};
+  struct iovec       iov[batch_size];
+  struct sockaddr_in enb_addr[batch_size];
+  uint32_t           nof_tx = 0, nof_dropped = 0, nof_slow = 0;
+  uint64_t           nof_bytes = 0;
+
+  for (uint32_t i = 0; i < batch_size; i++) {
+    srsran::byte_buffer_t* pdu = get_rx_buffer(i);
+    if (pdu == nullptr) {
+      break;
+    }
+    ssize_t n = read(sgi_fd, pdu->msg, pdu->get_tailroom());
+    if (n <= 0) {
+      break;
+    }
+    pdu->N_bytes = n;
+
+    struct iphdr* iph = (struct iphdr*)pdu->msg;
+    if (pdu->N_bytes < sizeof(struct iphdr) or iph->version != 4) {
+      nof_dropped++;
+      continue;
+    }
+    const gtpu_tunnel_t* tunnel = table->find_by_ip(iph->daddr);
+    if (tunnel == nullptr or tunnel->up_ctrl_teid == 0) {
+      // Unknown UE, or user-plane tunnel without a control tunnel
+      nof_dropped++;
+      continue;
+    }
+    if (not tunnel->dw_user_active) {
+      // UE not ECM connected, the GTP-C thread queues the packet and triggers paging
+      push_slow_path(std::move(rx_buffers[i]));
+      nof_slow++;
+      continue;
+    }
+
+    srsran::gtpu_header_t header;
+    header.flags        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+    header.message_type = GTPU_MSG_DATA_PDU;
+    header.length       = pdu->N_bytes;
+    header.teid         = tunnel->dw_user_fteid.teid;
+    if (not srsran::gtpu_write_header(&header, pdu, m_logger)) {
+      nof_dropped++;
+      continue;
+    }
+
+    enb_addr[nof_tx].sin_family      = AF_INET;
+    enb_addr[nof_tx].sin_port        = htons(GTPU_RX_PORT);
+    enb_addr[nof_tx].sin_addr.s_addr = tunnel->dw_user_fteid.ipv4;
+    iov[nof_tx].iov_base             = pdu->msg;
+    iov[nof_tx].iov_len              = pdu->N_bytes;
+    msgs[nof_tx].msg_hdr.msg_name    = &enb_addr[nof_tx];
+    msgs[nof_tx].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    msgs[nof_tx].msg_hdr.msg_iov     = &iov[nof_tx];
+    msgs[nof_tx].msg_hdr.msg_iovlen  = 1;
+    nof_bytes += pdu->N_bytes;
+    nof_tx++;
+  }
+
+  uint32_t nof_sent = 0;
+  while (nof_sent < nof_tx) {
+    int n = sendmmsg(s1u_fd, &msgs[nof_sent], nof_tx - nof_sent, 0);
+    if (n <= 0) {
+      m_logger.error("Error sending packets to eNB: %s", strerror(errno));
+      nof_dropped += nof_tx - nof_sent;
+      break;
+    }
+    nof_sent += n;
+  }
+
+  slow_path_pkts.fetch_add(nof_slow, std::memory_order_relaxed);
+  dl_pkts.fetch_add(nof_sent, std::memory_order_relaxed);
+  dl_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
+  dropped_pkts.fetch_add(nof_dropped, std::memory_order_relaxed);
+}
+
+/*
+ * S1-U -> SGi. Receives a batch with one recvmmsg() call, checks the S-GW TEID of each packet and writes the inner
+ * IP packet to the SGi interface.
+ */
+void gtpu_data_path::handle_s1u_batch(const gtpu_tunnel_table* table)
+{
+  struct mmsghdr msgs[batch_size] = {};
+  struct iovec   iov[batch_size];
+  uint32_t       nof_rx = 0;
+  for (; nof_rx < batch_size; nof_rx++) {
+    srsran::byte_buffer_t* pdu = get_rx_buffer(nof_rx);
+    if (pdu == nullptr) {
+      break;
+    }
+    iov[nof_rx].iov_base            = pdu->msg;
+    iov[nof_rx].iov_len             = pdu->get_tailroom();
+    msgs[nof_rx].msg_hdr.msg_iov    = &iov[nof_rx];
+    msgs[nof_rx].msg_hdr.msg_iovlen = 1;
+  }
+
+  int n = recvmmsg(s1u_fd, msgs, nof_rx, MSG_DONTWAIT, nullptr);
+  if (n <= 0) {
+    return;
+  }
+
+  uint32_t nof_fwd = 0, nof_dropped = 0;
+  uint64_t nof_bytes = 0;
+  for (int i = 0; i < n; i++) {
+    srsran::byte_buffer_t* pdu = rx_buffers[i].get();
+    pdu->N_bytes               = msgs[i].msg_len;
+
+    srsran::gtpu_header_t header;
+    if (pdu->N_bytes < GTPU_BASE_HEADER_LEN or not srsran::gtpu_read_header(pdu, &header, m_logger) or
+        header.message_type != GTPU_MSG_DATA_PDU or table->find_by_teid(header.teid) == nullptr) {
+      nof_dropped++;
+      continue;
+    }
+    if (write(sgi_fd, pdu->msg, pdu->N_bytes) < 0) {
+      m_logger.error("Could not write to TUN interface.");
+      nof_dropped++;
+      continue;
+    }
+    nof_bytes += pdu->N_bytes;
+    nof_fwd++;
+  }
+
+  ul_pkts.fetch_add(nof_fwd, std::memory_order_relaxed);
+  ul_bytes.fetch_add(nof_bytes, std::memory_order_relaxed);
+  dropped_pkts.fetch_add(nof_dropped, std::memory_order_relaxed);
+}
+
+} // namespace srsepc
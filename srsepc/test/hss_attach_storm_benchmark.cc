@@ -0,0 +1,236 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/security.h"
+#include "srsran/common/test_common.h"
+#include <algorithm>
+#include <chrono>
+#include <inttypes.h>
+#include <poll.h>
+#include <random>
+#include <unistd.h>
+
+/*
+ * Attach storm against the HSS: every UE of the database asks for an authentication vector at the same time, as after
+ * an eNB restart. The vectors are generated one by one on the calling thread, as the MME did, and through the batched
+ * workers, collecting the answers from the notification fd like the MME thread. Every answer of the storm is then
+ * checked against the reference Milenage implementation.
+ */
+
+static const uint64_t imsi_base = 1010123456000000ULL;
+static const char*    op_hex    = "63bfa50ee6523365ff14c1f45f88737d";
+
+using bench_clock = std::chrono::steady_clock;
+
+static void get_key(uint32_t ue_idx, uint8_t key[16])
+{
+  memset(key, 0, 16);
+  for (uint32_t i = 0; i < 4; i++) {
+    key[15 - i] = (uint8_t)((ue_idx + 1) >> (8 * i));
+  }
+}
+
+static void write_user_db(const std::string& filename, uint32_t nof_ue)
+{
+  FILE* f = fopen(filename.c_str(), "w");
+  srsran_always_assert(f != nullptr, "Error opening %s", filename.c_str());
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    fprintf(f,
+            "ue%u,mil,%015" PRIu64 ",%032x,op,%s,8000,000000001234,7,dynamic\n",
+            i,
+            imsi_base + i,
+            i + 1,
+            op_hex);
+  }
+  fclose(f);
+}
+
+/// Checks an answer against the reference Milenage functions, using the RAND it carries
+static bool check_answer(const srsepc::hss_auth_info_answer_t& answer, const uint8_t op[16])
+{
+  uint8_t k[16], opc[16], res[8], ck[16], ik[16], ak[6], sqn[6], mac_a[8];
+  uint8_t rand[16], amf[2];
+  get_key(answer.imsi - imsi_base, k);
+  srsran::compute_opc(k, (uint8_t*)op, opc);
+  memcpy(rand, answer.rand, sizeof(rand));
+  srsran::security_milenage_f2345(k, opc, rand, res, ck, ik, ak);
+  for (uint32_t i = 0; i < 6; i++) {
+    sqn[i] = answer.autn[i] ^ ak[i];
+  }
+  memcpy(amf, &answer.autn[6], sizeof(amf));
+  srsran::security_milenage_f1(k, opc, rand, sqn, amf, mac_a);
+  return memcmp(res, answer.xres, sizeof(res)) == 0 and memcmp(mac_a, &answer.autn[8], sizeof(mac_a)) == 0;
+}
+
+void test_milenage_batch()
+{
+  std::mt19937                           rng(1234);
+  std::vector<srsepc::milenage_vector_t> vectors(37);
+  for (srsepc::milenage_vector_t& v : vectors) {
+    for (uint8_t* p = (uint8_t*)&v; p < v.mac_a; p++) {
+      *p = rng();
+    }
+  }
+  std::vector<srsepc::milenage_vector_t> reference = vectors;
+
+  srsepc::milenage_f12345(vectors.data(), vectors.size());
+  for (uint32_t i = 0; i < vectors.size(); i++) {
+    srsepc::milenage_vector_t& v = reference[i];
+    srsran::security_milenage_f2345(v.k, v.opc, v.rand, v.res, v.ck, v.ik, v.ak);
+    srsran::security_milenage_f1(v.k, v.opc, v.rand, v.sqn, v.amf, v.mac_a);
+    TESTASSERT(memcmp(&v, &vectors[i], sizeof(v)) == 0);
+  }
+
+  // Throughput of the Milenage functions alone
+  uint32_t nof_repetitions = 200;
+  auto     t_start         = bench_clock::now();
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    srsepc::milenage_f12345(vectors.data(), vectors.size());
+  }
+  auto t_batch = bench_clock::now() - t_start;
+  t_start      = bench_clock::now();
+  for (uint32_t r = 0; r < nof_repetitions; r++) {
+    for (srsepc::milenage_vector_t& v : reference) {
+      srsran::security_milenage_f2345(v.k, v.opc, v.rand, v.res, v.ck, v.ik, v.ak);
+      srsran::security_milenage_f1(v.k, v.opc, v.rand, v.sqn, v.amf, v.mac_a);
+    }
+  }
+  auto   t_ref = bench_clock::now() - t_start;
+  double n     = nof_repetitions * vectors.size();
+  fmt::print("milenage: batch {:.1f} ns/vector, reference {:.1f} ns/vector\n",
+             std::chrono::duration<double, std::nano>(t_batch).count() / n,
+             std::chrono::duration<double, std::nano>(t_ref).count() / n);
+}
+
+void run_sequential(srsepc::hss* hss, uint32_t nof_ue)
+{
+  uint8_t k_asme[32], autn[16], rand[16], xres[16];
+  auto    t_start = bench_clock::now();
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    bool found = hss->gen_auth_info_answer(imsi_base + i, k_asme, autn, rand, xres);
+    TESTASSERT(found);
+  }
+  double t = std::chrono::duration<double>(bench_clock::now() - t_start).count();
+  fmt::print("sequential: {} attaches in {:.3f} s, {:.1f} kAV/s\n", nof_ue, t, nof_ue / t / 1e3);
+}
+
+void run_storm(srsepc::hss* hss, uint32_t nof_ue, const uint8_t op[16])
+{
+  std::vector<bench_clock::time_point> t_request(nof_ue);
+  std::vector<double>                  latency_ms;
+  latency_ms.reserve(nof_ue);
+
+  // The whole burst arrives before the first vector is collected
+  auto t_start = bench_clock::now();
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    t_request[i] = bench_clock::now();
+    hss->request_auth_info(imsi_base + i, i);
+  }
+
+  std::vector<srsepc::hss_auth_info_answer_t> answers;
+  std::vector<srsepc::hss_auth_info_answer_t> all_answers;
+  all_answers.reserve(nof_ue);
+  while (all_answers.size() < nof_ue) {
+    struct pollfd pfd = {};
+    pfd.fd            = hss->get_auth_info_fd();
+    pfd.events        = POLLIN;
+    int ret           = poll(&pfd, 1, 5000);
+    TESTASSERT(ret > 0);
+
+    hss->get_auth_info_answers(answers);
+    auto t_answer = bench_clock::now();
+    for (const srsepc::hss_auth_info_answer_t& answer : answers) {
+      TESTASSERT(answer.mme_ue_s1ap_id < nof_ue);
+      auto latency = t_answer - t_request[answer.mme_ue_s1ap_id];
+      latency_ms.push_back(std::chrono::duration<double, std::milli>(latency).count());
+    }
+    all_answers.insert(all_answers.end(), answers.begin(), answers.end());
+  }
+  double t = std::chrono::duration<double>(bench_clock::now() - t_start).count();
+
+  for (const srsepc::hss_auth_info_answer_t& answer : all_answers) {
+    TESTASSERT(answer.found and answer.imsi == imsi_base + answer.mme_ue_s1ap_id);
+    TESTASSERT(check_answer(answer, op));
+  }
+
+  std::sort(latency_ms.begin(), latency_ms.end());
+  fmt::print("storm: {} attaches in {:.3f} s, {:.1f} kAV/s, latency p50 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms\n",
+             nof_ue,
+             t,
+             nof_ue / t / 1e3,
+             latency_ms[latency_ms.size() / 2],
+             latency_ms[latency_ms.size() * 99 / 100],
+             latency_ms.back());
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  // Keep logging out of the measurement
+  auto& logger = srslog::fetch_basic_logger("HSS", false);
+  logger.set_level(srslog::basic_levels::error);
+
+  uint32_t nof_ue      = 20000;
+  uint32_t nof_workers = 4;
+  if (argc > 1) {
+    nof_ue = std::strtoul(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    nof_workers = std::strtoul(argv[2], nullptr, 10);
+  }
+
+  test_milenage_batch();
+
+  char  dir_template[] = "/tmp/hss_stormXXXXXX";
+  char* dir            = mkdtemp(dir_template);
+  if (dir == nullptr) {
+    perror("mkdtemp");
+    return SRSRAN_ERROR;
+  }
+
+  srsepc::hss_args_t args = {};
+  args.db_file            = std::string(dir) + "/user_db.csv";
+  args.auth_workers       = nof_workers;
+  args.mcc                = 0xf001;
+  args.mnc                = 0xff01;
+  write_user_db(args.db_file, nof_ue);
+
+  uint8_t op[16];
+  for (uint32_t i = 0; i < 16; i++) {
+    op[i] = (uint8_t)std::stoul(std::string(&op_hex[2 * i], 2), nullptr, 16);
+  }
+
+  srsepc::hss* hss = srsepc::hss::get_instance();
+  int          ret = hss->init(&args);
+  TESTASSERT(ret == SRSRAN_SUCCESS);
+  fmt::print("{} UEs, {} workers\n", nof_ue, nof_workers);
+  run_sequential(hss, nof_ue);
+  run_storm(hss, nof_ue, op);
+  srsepc::hss::cleanup();
+
+  unlink(args.db_file.c_str());
+  rmdir(dir);
+  srslog::flush();
+
+  return SRSRAN_SUCCESS;
+}
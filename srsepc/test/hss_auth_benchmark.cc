@@ -0,0 +1,218 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/hss/hss.h"
+#include "srsran/common/test_common.h"
+#include <atomic>
+#include <chrono>
+#include <inttypes.h>
+#include <thread>
+#include <unistd.h>
+
+/*
+ * Benchmark of the HSS subscriber store: loading a large user database from the .csv file and from the binary
+ * snapshot, and the rate of authentication vectors generated by several threads for random users. It also checks
+ * that the SQN updates recorded in the journal survive an abrupt termination.
+ */
+
+static const uint64_t imsi_base = 1010123456000000ULL;
+
+/// The last user uses XOR, so the SQN can be recovered from the authentication vector
+static void write_user_db(const std::string& filename, uint32_t nof_ue)
+{
+  FILE* f = fopen(filename.c_str(), "w");
+  srsran_always_assert(f != nullptr, "Error opening %s", filename.c_str());
+  for (uint32_t i = 0; i <= nof_ue; i++) {
+    fprintf(f,
+            "ue%u,%s,%015" PRIu64 ",%032x,op,63bfa50ee6523365ff14c1f45f88737d,8000,000000001234,7,dynamic\n",
+            i,
+            (i == nof_ue) ? "xor" : "mil",
+            imsi_base + i,
+            i + 1);
+  }
+  fclose(f);
+}
+
+static uint64_t get_xor_sqn(srsepc::hss* hss, uint32_t nof_ue)
+{
+  uint8_t k_asme[32] = {};
+  uint8_t autn[16]   = {};
+  uint8_t rand[16]   = {};
+  uint8_t xres[16]   = {};
+  bool    found      = hss->gen_auth_info_answer(imsi_base + nof_ue, k_asme, autn, rand, xres);
+  TESTASSERT(found);
+
+  // The key of the XOR user is its index plus one, AK = (K xor RAND)[3..8]
+  uint8_t key[16] = {};
+  for (uint32_t i = 0; i < 4; i++) {
+    key[15 - i] = (uint8_t)((nof_ue + 1) >> (8 * i));
+  }
+  uint64_t sqn = 0;
+  for (uint32_t i = 0; i < 6; i++) {
+    sqn = (sqn << 8U) | (uint8_t)(autn[i] ^ key[i + 3] ^ rand[i + 3]);
+  }
+  return sqn;
+}
+
+template <typename F>
+static double elapsed_s(F&& f)
+{
+  auto t_start = std::chrono::steady_clock::now();
+  f();
+  auto t_end = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::duration<double> >(t_end - t_start).count();
+}
+
+static srsepc::hss* init_hss(srsepc::hss_args_t args)
+{
+  srsepc::hss* hss = srsepc::hss::get_instance();
+  int          ret = hss->init(&args);
+  TESTASSERT(ret == SRSRAN_SUCCESS);
+  return hss;
+}
+
+void run_load_benchmark(srsepc::hss_args_t args, uint32_t nof_ue)
+{
+  // Legacy .csv database, read on start and rewritten on exit
+  std::string snapshot = args.db_snapshot;
+  args.db_snapshot     = "";
+  srsepc::hss* hss     = nullptr;
+  double       t_read  = elapsed_s([&]() { hss = init_hss(args); });
+  double       t_write = elapsed_s([&]() { hss->stop(); });
+  srsepc::hss::cleanup();
+  fmt::print("csv: {} users, load {:.3f} s, save {:.3f} s\n", nof_ue, t_read, t_write);
+
+  // Snapshot, generated from the .csv file on the first start
+  args.db_snapshot  = snapshot;
+  double t_generate = elapsed_s([&]() { hss = init_hss(args); });
+  t_write           = elapsed_s([&]() { hss->stop(); });
+  srsepc::hss::cleanup();
+  t_read = elapsed_s([&]() { hss = init_hss(args); });
+  hss->stop();
+  srsepc::hss::cleanup();
+  fmt::print("snapshot: {} users, generate {:.3f} s, load {:.3f} s, save {:.3f} s\n",
+             nof_ue,
+             t_generate,
+             t_read,
+             t_write);
+}
+
+void run_auth_benchmark(const srsepc::hss_args_t& args, uint32_t nof_ue, uint32_t nof_threads, uint32_t nof_auth)
+{
+  srsepc::hss*          hss = init_hss(args);
+  std::atomic<uint32_t> nof_failed(0);
+
+  double t = elapsed_s([&]() {
+    std::vector<std::thread> threads;
+    for (uint32_t t_idx = 0; t_idx < nof_threads; t_idx++) {
+      threads.emplace_back([&, t_idx]() {
+        uint8_t k_asme[32], autn[16], rand[16], xres[16];
+        for (uint32_t i = t_idx; i < nof_auth; i += nof_threads) {
+          uint64_t imsi = imsi_base + (uint64_t)i * 7919 % nof_ue;
+          if (not hss->gen_auth_info_answer(imsi, k_asme, autn, rand, xres)) {
+            nof_failed++;
+          }
+        }
+      });
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+  });
+
+  hss->stop();
+  srsepc::hss::cleanup();
+  TESTASSERT(nof_failed == 0);
+
+  fmt::print(
+      "auth vectors: {} threads, {} vectors, {:.3f} s, {:.2f} kAV/s\n", nof_threads, nof_auth, t, nof_auth / t / 1e3);
+}
+
+void test_journal(const srsepc::hss_args_t& args, uint32_t nof_ue)
+{
+  srsepc::hss* hss = init_hss(args);
+  get_xor_sqn(hss, nof_ue);
+  uint64_t sqn = get_xor_sqn(hss, nof_ue);
+
+  // Terminate without saving the snapshot, the SQN must be restored from the journal
+  srsepc::hss::cleanup();
+  hss = init_hss(args);
+  uint64_t next_sqn = get_xor_sqn(hss, nof_ue);
+  TESTASSERT((next_sqn >> LTE_FDD_ENB_IND_HE_N_BITS) == (sqn >> LTE_FDD_ENB_IND_HE_N_BITS) + 1);
+  hss->stop();
+  srsepc::hss::cleanup();
+
+  // A change in the .csv file regenerates the snapshot keeping the SQN
+  write_user_db(args.db_file, nof_ue);
+  hss = init_hss(args);
+  sqn = get_xor_sqn(hss, nof_ue);
+  hss->stop();
+  srsepc::hss::cleanup();
+  TESTASSERT((sqn >> LTE_FDD_ENB_IND_HE_N_BITS) == (next_sqn >> LTE_FDD_ENB_IND_HE_N_BITS) + 1);
+
+  fmt::print("journal: SQN restored after an abrupt termination and a database change\n");
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+
+  // Keep logging out of the measurement
+  auto& logger = srslog::fetch_basic_logger("HSS", false);
+  logger.set_level(srslog::basic_levels::error);
+
+  uint32_t nof_ue      = 100000;
+  uint32_t nof_threads = 4;
+  if (argc > 1) {
+    nof_ue = std::strtoul(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    nof_threads = std::strtoul(argv[2], nullptr, 10);
+  }
+
+  char  dir_template[] = "/tmp/hss_benchmarkXXXXXX";
+  char* dir            = mkdtemp(dir_template);
+  if (dir == nullptr) {
+    perror("mkdtemp");
+    return SRSRAN_ERROR;
+  }
+
+  srsepc::hss_args_t args = {};
+  args.db_file            = std::string(dir) + "/user_db.csv";
+  args.db_snapshot        = std::string(dir) + "/user_db.snap";
+  args.mcc                = 0xf001;
+  args.mnc                = 0xff01;
+  write_user_db(args.db_file, nof_ue);
+
+  run_load_benchmark(args, nof_ue);
+  for (uint32_t n : {1U, nof_threads}) {
+    run_auth_benchmark(args, nof_ue, n, 10 * nof_ue);
+  }
+  test_journal(args, nof_ue);
+
+  unlink(args.db_file.c_str());
+  unlink(args.db_snapshot.c_str());
+  unlink(srsepc::hss_ue_db::journal_filename(args.db_snapshot).c_str());
+  rmdir(dir);
+  srslog::flush();
+
+  return SRSRAN_SUCCESS;
+}
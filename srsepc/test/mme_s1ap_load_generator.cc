@@ -0,0 +1,560 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsran/asn1/liblte_mme.h"
+#include "srsran/asn1/s1ap.h"
+#include "srsran/common/bcd_helpers.h"
+#include "srsran/common/security.h"
+#include "srsran/common/string_helpers.h"
+#include "srsran/config.h"
+#include "srsran/srslog/srslog.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <inttypes.h>
+#include <netinet/sctp.h>
+#include <poll.h>
+#include <unistd.h>
+#include <vector>
+
+/*
+ * Synthetic S1AP load generator. It connects to a running srsepc as an eNB and drives the initial attach of many
+ * emulated UEs concurrently: Attach Request, Authentication, NAS Security Mode and the ESM information request, then
+ * releases the UE with a UE Context Release Request. The ESM information transfer flag is set so the procedure does
+ * not depend on the S/P-GW. The UE side keys are derived from the same per-UE K and OP that are written to the HSS
+ * database by the "db" command.
+ *
+ * Usage:
+ *   mme_s1ap_load_generator db <user_db.csv> <nof_ue>
+ *   mme_s1ap_load_generator run <mme_addr> <nof_ue> <nof_concurrent_ue>
+ */
+
+using namespace asn1::s1ap;
+
+static const uint64_t imsi_base = 1010000000000ULL; // 001-01-0000000000
+static const char*    op_hex    = "63bfa50ee6523365ff14c1f45f88737d";
+static const char*    mcc_str   = "001";
+static const char*    mnc_str   = "01";
+static const uint16_t tac       = 7;
+static const uint32_t enb_id    = 0x19c;
+static const uint32_t s1ap_ppid = 18;
+
+using bench_clock = std::chrono::steady_clock;
+
+static void get_key(uint32_t ue_idx, uint8_t key[16])
+{
+  memset(key, 0, 16);
+  for (uint32_t i = 0; i < 4; i++) {
+    key[15 - i] = (uint8_t)((ue_idx + 1) >> (8 * i));
+  }
+}
+
+static int write_user_db(const char* filename, uint32_t nof_ue)
+{
+  FILE* f = fopen(filename, "w");
+  if (f == nullptr) {
+    perror("fopen");
+    return SRSRAN_ERROR;
+  }
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    fprintf(f,
+            "ue%u,mil,%015" PRIu64 ",%032x,op,%s,8000,000000001234,7,dynamic\n",
+            i,
+            imsi_base + i,
+            i + 1,
+            op_hex);
+  }
+  fclose(f);
+  return SRSRAN_SUCCESS;
+}
+
+enum class ue_state_t { idle, wait_auth, wait_smc, wait_esm_info, done, failed };
+
+struct emulated_ue_t {
+  uint32_t                    idx            = 0;
+  uint32_t                    mme_ue_s1ap_id = 0;
+  ue_state_t                  state          = ue_state_t::idle;
+  uint8_t                     k_asme[32]     = {};
+  uint8_t                     k_nas_enc[32]  = {};
+  uint8_t                     k_nas_int[32]  = {};
+  srsran::CIPHERING_ALGORITHM_ID_ENUM cipher_algo    = srsran::CIPHERING_ALGORITHM_ID_EEA0;
+  srsran::INTEGRITY_ALGORITHM_ID_ENUM integ_algo     = srsran::INTEGRITY_ALGORITHM_ID_EIA0;
+  bench_clock::time_point     t_start;
+};
+
+class load_generator
+{
+public:
+  load_generator(uint32_t nof_ue_, uint32_t nof_concurrent_) : nof_ue(nof_ue_), nof_concurrent(nof_concurrent_)
+  {
+    ues.resize(nof_ue);
+    for (uint32_t i = 0; i < nof_ue; i++) {
+      ues[i].idx = i;
+    }
+    srsran::string_to_mcc(mcc_str, &mcc);
+    srsran::string_to_mnc(mnc_str, &mnc);
+    srsran::s1ap_mccmnc_to_plmn(mcc, mnc, &plmn);
+    srsran::get_uint_vec_from_hex_str(op_hex, op, sizeof(op));
+  }
+  ~load_generator()
+  {
+    if (sock_fd >= 0) {
+      close(sock_fd);
+    }
+  }
+
+  bool connect_mme(const char* mme_addr);
+  bool s1_setup();
+  int  run();
+
+private:
+  bool send_pdu(const s1ap_pdu_c& pdu, uint16_t stream_id);
+  bool recv_pdu(s1ap_pdu_c& pdu, int timeout_ms);
+  void handle_dl_nas(const dl_nas_transport_s& dl_nas);
+  void handle_release_cmd(const ue_context_release_cmd_s& rel_cmd);
+
+  void start_ue(emulated_ue_t& ue);
+  void finish_ue(emulated_ue_t& ue, bool success);
+  void send_ul_nas(emulated_ue_t& ue, srsran::byte_buffer_t* nas_pdu);
+  void send_auth_response(emulated_ue_t& ue, LIBLTE_BYTE_MSG_STRUCT* nas_rx);
+  void send_security_mode_complete(emulated_ue_t& ue, LIBLTE_BYTE_MSG_STRUCT* nas_rx);
+  void send_release_request(emulated_ue_t& ue);
+  void nas_cipher(emulated_ue_t& ue, uint32_t count, uint8_t direction, srsran::byte_buffer_t* nas_pdu);
+
+  void fill_tai_cgi(tai_s& tai, eutran_cgi_s& cgi);
+
+  uint32_t nof_ue;
+  uint32_t nof_concurrent;
+  uint16_t mcc  = 0;
+  uint16_t mnc  = 0;
+  uint32_t plmn = 0;
+  uint8_t  op[16];
+  int      sock_fd = -1;
+
+  std::vector<emulated_ue_t> ues;
+  uint32_t                   next_ue     = 0;
+  uint32_t                   nof_active  = 0;
+  uint32_t                   nof_success = 0;
+  uint32_t                   nof_failed  = 0;
+  std::vector<double>        latency_ms;
+};
+
+bool load_generator::connect_mme(const char* mme_addr)
+{
+  sock_fd = socket(AF_INET, SOCK_SEQPACKET, IPPROTO_SCTP);
+  if (sock_fd < 0) {
+    perror("socket");
+    return false;
+  }
+
+  struct sctp_initmsg init_opts = {};
+  init_opts.sinit_num_ostreams  = 2;
+  init_opts.sinit_max_instreams = 2;
+  setsockopt(sock_fd, IPPROTO_SCTP, SCTP_INITMSG, &init_opts, sizeof(init_opts));
+
+  struct sctp_event_subscribe evnts = {};
+  evnts.sctp_data_io_event          = 1;
+  if (setsockopt(sock_fd, IPPROTO_SCTP, SCTP_EVENTS, &evnts, sizeof(evnts)) < 0) {
+    perror("setsockopt");
+    return false;
+  }
+
+  struct sockaddr_in addr = {};
+  addr.sin_family         = AF_INET;
+  addr.sin_port           = htons(36412);
+  if (inet_pton(AF_INET, mme_addr, &addr.sin_addr) != 1) {
+    fprintf(stderr, "Invalid MME address %s\n", mme_addr);
+    return false;
+  }
+  if (connect(sock_fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    perror("connect");
+    return false;
+  }
+  return true;
+}
+
+bool load_generator::send_pdu(const s1ap_pdu_c& pdu, uint16_t stream_id)
+{
+  uint8_t       buf[2048];
+  asn1::bit_ref bref(buf, sizeof(buf));
+  if (pdu.pack(bref) != asn1::SRSASN_SUCCESS) {
+    fprintf(stderr, "Error packing S1AP PDU\n");
+    return false;
+  }
+  ssize_t n_sent = sctp_sendmsg(sock_fd, buf, bref.distance_bytes(), nullptr, 0, htonl(s1ap_ppid), 0, stream_id, 0, 0);
+  if (n_sent < 0) {
+    perror("sctp_sendmsg");
+    return false;
+  }
+  return true;
+}
+
+bool load_generator::recv_pdu(s1ap_pdu_c& pdu, int timeout_ms)
+{
+  struct pollfd pfd = {};
+  pfd.fd            = sock_fd;
+  pfd.events        = POLLIN;
+  if (poll(&pfd, 1, timeout_ms) <= 0) {
+    return false;
+  }
+
+  uint8_t                buf[2048];
+  struct sctp_sndrcvinfo sri   = {};
+  int                    flags = 0;
+  ssize_t                n     = sctp_recvmsg(sock_fd, buf, sizeof(buf), nullptr, nullptr, &sri, &flags);
+  if (n <= 0 or (flags & MSG_NOTIFICATION)) {
+    return n > 0;
+  }
+  asn1::cbit_ref bref(buf, n);
+  if (pdu.unpack(bref) != asn1::SRSASN_SUCCESS) {
+    fprintf(stderr, "Error unpacking S1AP PDU\n");
+    return false;
+  }
+  return true;
+}
+
+void load_generator::fill_tai_cgi(tai_s& tai, eutran_cgi_s& cgi)
+{
+  tai.plm_nid.from_number(plmn);
+  tai.tac.from_number(tac);
+  cgi.plm_nid.from_number(plmn);
+  cgi.cell_id.from_number(enb_id << 8U);
+}
+
+bool load_generator::s1_setup()
+{
+  uint32_t plmn_be = htonl(plmn);
+  uint16_t tac_be  = htons(tac);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_S1_SETUP);
+  s1_setup_request_s& container             = pdu.init_msg().value.s1_setup_request();
+  container->global_enb_id.value.plm_nid[0] = ((uint8_t*)&plmn_be)[1];
+  container->global_enb_id.value.plm_nid[1] = ((uint8_t*)&plmn_be)[2];
+  container->global_enb_id.value.plm_nid[2] = ((uint8_t*)&plmn_be)[3];
+  container->global_enb_id.value.enb_id.set_macro_enb_id().from_number(enb_id);
+  container->enbname_present = true;
+  container->enbname.value.from_string("srsenb_loadgen");
+  container->supported_tas.value.resize(1);
+  memcpy(container->supported_tas.value[0].tac.data(), &tac_be, 2);
+  container->supported_tas.value[0].broadcast_plmns.resize(1);
+  container->supported_tas.value[0].broadcast_plmns[0][0] = ((uint8_t*)&plmn_be)[1];
+  container->supported_tas.value[0].broadcast_plmns[0][1] = ((uint8_t*)&plmn_be)[2];
+  container->supported_tas.value[0].broadcast_plmns[0][2] = ((uint8_t*)&plmn_be)[3];
+  container->default_paging_drx.value.value               = paging_drx_opts::v128;
+  if (not send_pdu(pdu, 0)) {
+    return false;
+  }
+
+  s1ap_pdu_c rx_pdu;
+  if (not recv_pdu(rx_pdu, 5000) or rx_pdu.type().value != s1ap_pdu_c::types_opts::successful_outcome) {
+    fprintf(stderr, "S1 Setup failed\n");
+    return false;
+  }
+  return true;
+}
+
+void load_generator::start_ue(emulated_ue_t& ue)
+{
+  LIBLTE_MME_ATTACH_REQUEST_MSG_STRUCT attach_req = {};
+  attach_req.eps_attach_type                      = LIBLTE_MME_EPS_ATTACH_TYPE_EPS_ATTACH;
+  for (uint32_t i = 0; i < 3; i++) {
+    attach_req.ue_network_cap.eea[i] = true;
+    attach_req.ue_network_cap.eia[i] = true;
+  }
+  attach_req.eps_mobile_id.type_of_id = LIBLTE_MME_EPS_MOBILE_ID_TYPE_IMSI;
+  uint64_t imsi                       = imsi_base + ue.idx;
+  for (int i = 14; i >= 0; i--) {
+    attach_req.eps_mobile_id.imsi[i] = imsi % 10;
+    imsi /= 10;
+  }
+  attach_req.nas_ksi.tsc_flag = LIBLTE_MME_TYPE_OF_SECURITY_CONTEXT_FLAG_NATIVE;
+  attach_req.nas_ksi.nas_ksi  = LIBLTE_MME_NAS_KEY_SET_IDENTIFIER_NO_KEY_AVAILABLE;
+
+  LIBLTE_MME_PDN_CONNECTIVITY_REQUEST_MSG_STRUCT pdn_con_req = {};
+  pdn_con_req.proc_transaction_id                            = 1;
+  pdn_con_req.request_type                                   = LIBLTE_MME_REQUEST_TYPE_INITIAL_REQUEST;
+  pdn_con_req.pdn_type                                       = LIBLTE_MME_PDN_TYPE_IPV4;
+  pdn_con_req.esm_info_transfer_flag_present                 = true;
+  pdn_con_req.esm_info_transfer_flag                         = LIBLTE_MME_ESM_INFO_TRANSFER_FLAG_REQUIRED;
+  liblte_mme_pack_pdn_connectivity_request_msg(&pdn_con_req, &attach_req.esm_msg);
+
+  srsran::byte_buffer_t nas_pdu;
+  liblte_mme_pack_attach_request_msg(&attach_req, (LIBLTE_BYTE_MSG_STRUCT*)&nas_pdu);
+
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_INIT_UE_MSG);
+  init_ue_msg_s& container        = pdu.init_msg().value.init_ue_msg();
+  container->enb_ue_s1ap_id.value = ue.idx + 1;
+  container->nas_pdu.value.resize(nas_pdu.N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas_pdu.msg, nas_pdu.N_bytes);
+  fill_tai_cgi(container->tai.value, container->eutran_cgi.value);
+  container->rrc_establishment_cause.value = rrc_establishment_cause_opts::mo_sig;
+
+  ue.state   = ue_state_t::wait_auth;
+  ue.t_start = bench_clock::now();
+  nof_active++;
+  if (not send_pdu(pdu, 1)) {
+    finish_ue(ue, false);
+  }
+}
+
+void load_generator::finish_ue(emulated_ue_t& ue, bool success)
+{
+  ue.state = success ? ue_state_t::done : ue_state_t::failed;
+  if (success) {
+    nof_success++;
+    latency_ms.push_back(std::chrono::duration<double, std::milli>(bench_clock::now() - ue.t_start).count());
+  } else {
+    nof_failed++;
+  }
+  nof_active--;
+
+  // Keep the number of UEs in the middle of a procedure constant
+  if (next_ue < nof_ue) {
+    start_ue(ues[next_ue++]);
+  }
+}
+
+void load_generator::send_ul_nas(emulated_ue_t& ue, srsran::byte_buffer_t* nas_pdu)
+{
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_UL_NAS_TRANSPORT);
+  ul_nas_transport_s& container   = pdu.init_msg().value.ul_nas_transport();
+  container->mme_ue_s1ap_id.value = ue.mme_ue_s1ap_id;
+  container->enb_ue_s1ap_id.value = ue.idx + 1;
+  container->nas_pdu.value.resize(nas_pdu->N_bytes);
+  memcpy(container->nas_pdu.value.data(), nas_pdu->msg, nas_pdu->N_bytes);
+  fill_tai_cgi(container->tai.value, container->eutran_cgi.value);
+  if (not send_pdu(pdu, 1)) {
+    finish_ue(ue, false);
+  }
+}
+
+void load_generator::send_auth_response(emulated_ue_t& ue, LIBLTE_BYTE_MSG_STRUCT* nas_rx)
+{
+  LIBLTE_MME_AUTHENTICATION_REQUEST_MSG_STRUCT auth_req = {};
+  if (liblte_mme_unpack_authentication_request_msg(nas_rx, &auth_req) != LIBLTE_SUCCESS) {
+    finish_ue(ue, false);
+    return;
+  }
+
+  uint8_t k[16], opc[16], ck[16], ik[16], ak[6], ak_xor_sqn[6];
+  get_key(ue.idx, k);
+  srsran::compute_opc(k, op, opc);
+
+  LIBLTE_MME_AUTHENTICATION_RESPONSE_MSG_STRUCT auth_resp = {};
+  srsran::security_milenage_f2345(k, opc, auth_req.rand, auth_resp.res, ck, ik, ak);
+  auth_resp.res_len = 8;
+  memcpy(ak_xor_sqn, auth_req.autn, sizeof(ak_xor_sqn));
+  srsran::security_generate_k_asme(ck, ik, ak_xor_sqn, mcc, mnc, ue.k_asme);
+
+  srsran::byte_buffer_t nas_pdu;
+  liblte_mme_pack_authentication_response_msg(
+      &auth_resp, LIBLTE_MME_SECURITY_HDR_TYPE_PLAIN_NAS, 0, (LIBLTE_BYTE_MSG_STRUCT*)&nas_pdu);
+  ue.state = ue_state_t::wait_smc;
+  send_ul_nas(ue, &nas_pdu);
+}
+
+void load_generator::send_security_mode_complete(emulated_ue_t& ue, LIBLTE_BYTE_MSG_STRUCT* nas_rx)
+{
+  LIBLTE_MME_SECURITY_MODE_COMMAND_MSG_STRUCT sec_mode_cmd = {};
+  if (liblte_mme_unpack_security_mode_command_msg(nas_rx, &sec_mode_cmd) != LIBLTE_SUCCESS) {
+    finish_ue(ue, false);
+    return;
+  }
+  ue.cipher_algo = (srsran::CIPHERING_ALGORITHM_ID_ENUM)sec_mode_cmd.selected_nas_sec_algs.type_of_eea;
+  ue.integ_algo  = (srsran::INTEGRITY_ALGORITHM_ID_ENUM)sec_mode_cmd.selected_nas_sec_algs.type_of_eia;
+  srsran::security_generate_k_nas(ue.k_asme, ue.cipher_algo, ue.integ_algo, ue.k_nas_enc, ue.k_nas_int);
+
+  // First message of the new security context, UL NAS COUNT 0
+  const uint8_t sec_hdr = LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED_WITH_NEW_EPS_SECURITY_CONTEXT;
+
+  LIBLTE_MME_SECURITY_MODE_COMPLETE_MSG_STRUCT sec_comp = {};
+  srsran::byte_buffer_t                        nas_pdu;
+  liblte_mme_pack_security_mode_complete_msg(&sec_comp, sec_hdr, 0, (LIBLTE_BYTE_MSG_STRUCT*)&nas_pdu);
+  nas_cipher(ue, 0, srsran::SECURITY_DIRECTION_UPLINK, &nas_pdu);
+
+  uint8_t* mac = &nas_pdu.msg[1];
+  if (ue.integ_algo == srsran::INTEGRITY_ALGORITHM_ID_128_EIA1) {
+    srsran::security_128_eia1(
+        &ue.k_nas_int[16], 0, 0, srsran::SECURITY_DIRECTION_UPLINK, &nas_pdu.msg[5], nas_pdu.N_bytes - 5, mac);
+  } else if (ue.integ_algo == srsran::INTEGRITY_ALGORITHM_ID_128_EIA2) {
+    srsran::security_128_eia2(
+        &ue.k_nas_int[16], 0, 0, srsran::SECURITY_DIRECTION_UPLINK, &nas_pdu.msg[5], nas_pdu.N_bytes - 5, mac);
+  }
+  ue.state = ue_state_t::wait_esm_info;
+  send_ul_nas(ue, &nas_pdu);
+}
+
+/// Ciphers or deciphers in place the payload of a security protected NAS message
+void load_generator::nas_cipher(emulated_ue_t& ue, uint32_t count, uint8_t direction, srsran::byte_buffer_t* nas_pdu)
+{
+  uint8_t* payload = &nas_pdu->msg[6];
+  uint32_t len     = nas_pdu->N_bytes - 6;
+  if (ue.cipher_algo == srsran::CIPHERING_ALGORITHM_ID_128_EEA1) {
+    srsran::security_128_eea1(&ue.k_nas_enc[16], count, 0, direction, payload, len, payload);
+  } else if (ue.cipher_algo == srsran::CIPHERING_ALGORITHM_ID_128_EEA2) {
+    srsran::security_128_eea2(&ue.k_nas_enc[16], count, 0, direction, payload, len, payload);
+  }
+}
+
+void load_generator::send_release_request(emulated_ue_t& ue)
+{
+  s1ap_pdu_c pdu;
+  pdu.set_init_msg().load_info_obj(ASN1_S1AP_ID_UE_CONTEXT_RELEASE_REQUEST);
+  ue_context_release_request_s& container          = pdu.init_msg().value.ue_context_release_request();
+  container->mme_ue_s1ap_id.value                  = ue.mme_ue_s1ap_id;
+  container->enb_ue_s1ap_id.value                  = ue.idx + 1;
+  container->cause.value.set_radio_network().value = cause_radio_network_opts::user_inactivity;
+  send_pdu(pdu, 1);
+}
+
+void load_generator::handle_dl_nas(const dl_nas_transport_s& dl_nas)
+{
+  uint32_t enb_ue_s1ap_id = dl_nas->enb_ue_s1ap_id.value.value;
+  if (enb_ue_s1ap_id == 0 or enb_ue_s1ap_id > nof_ue) {
+    return;
+  }
+  emulated_ue_t& ue = ues[enb_ue_s1ap_id - 1];
+  ue.mme_ue_s1ap_id = dl_nas->mme_ue_s1ap_id.value.value;
+
+  srsran::byte_buffer_t nas_rx;
+  if (dl_nas->nas_pdu.value.size() > nas_rx.get_tailroom()) {
+    finish_ue(ue, false);
+    return;
+  }
+  memcpy(nas_rx.msg, dl_nas->nas_pdu.value.data(), dl_nas->nas_pdu.value.size());
+  nas_rx.N_bytes = dl_nas->nas_pdu.value.size();
+
+  // Messages after the Security Mode Command are ciphered with the DL NAS COUNT carried in the header
+  uint8_t sec_hdr = nas_rx.msg[0] >> 4U;
+  if (nas_rx.N_bytes > 6 and sec_hdr == LIBLTE_MME_SECURITY_HDR_TYPE_INTEGRITY_AND_CIPHERED) {
+    nas_cipher(ue, nas_rx.msg[5], srsran::SECURITY_DIRECTION_DOWNLINK, &nas_rx);
+  }
+
+  uint8_t pd = 0, msg_type = 0;
+  liblte_mme_parse_msg_header((LIBLTE_BYTE_MSG_STRUCT*)&nas_rx, &pd, &msg_type);
+  if (ue.state == ue_state_t::wait_auth and msg_type == LIBLTE_MME_MSG_TYPE_AUTHENTICATION_REQUEST) {
+    send_auth_response(ue, (LIBLTE_BYTE_MSG_STRUCT*)&nas_rx);
+  } else if (ue.state == ue_state_t::wait_smc and msg_type == LIBLTE_MME_MSG_TYPE_SECURITY_MODE_COMMAND) {
+    send_security_mode_complete(ue, (LIBLTE_BYTE_MSG_STRUCT*)&nas_rx);
+  } else if (ue.state == ue_state_t::wait_esm_info and msg_type == LIBLTE_MME_MSG_TYPE_ESM_INFORMATION_REQUEST) {
+    send_release_request(ue);
+    finish_ue(ue, true);
+  } else if (ue.state != ue_state_t::done and ue.state != ue_state_t::failed) {
+    // Attach/Authentication Reject or any unexpected message
+    finish_ue(ue, false);
+  }
+}
+
+void load_generator::handle_release_cmd(const ue_context_release_cmd_s& rel_cmd)
+{
+  if (rel_cmd->ue_s1ap_ids.value.type().value != ue_s1ap_ids_c::types_opts::ue_s1ap_id_pair) {
+    return;
+  }
+  s1ap_pdu_c pdu;
+  pdu.set_successful_outcome().load_info_obj(ASN1_S1AP_ID_UE_CONTEXT_RELEASE);
+  ue_context_release_complete_s& container = pdu.successful_outcome().value.ue_context_release_complete();
+  container->mme_ue_s1ap_id.value          = rel_cmd->ue_s1ap_ids.value.ue_s1ap_id_pair().mme_ue_s1ap_id;
+  container->enb_ue_s1ap_id.value          = rel_cmd->ue_s1ap_ids.value.ue_s1ap_id_pair().enb_ue_s1ap_id;
+  send_pdu(pdu, 1);
+}
+
+int load_generator::run()
+{
+  auto t_start = bench_clock::now();
+  while (next_ue < std::min(nof_ue, nof_concurrent)) {
+    start_ue(ues[next_ue++]);
+  }
+
+  while (nof_active > 0) {
+    s1ap_pdu_c pdu;
+    if (not recv_pdu(pdu, 5000)) {
+      fprintf(stderr, "Timeout with %d procedures in progress\n", nof_active);
+      break;
+    }
+    if (pdu.type().value != s1ap_pdu_c::types_opts::init_msg) {
+      continue;
+    }
+    switch (pdu.init_msg().value.type().value) {
+      case s1ap_elem_procs_o::init_msg_c::types_opts::dl_nas_transport:
+        handle_dl_nas(pdu.init_msg().value.dl_nas_transport());
+        break;
+      case s1ap_elem_procs_o::init_msg_c::types_opts::ue_context_release_cmd:
+        handle_release_cmd(pdu.init_msg().value.ue_context_release_cmd());
+        break;
+      default:
+        break;
+    }
+  }
+  double t = std::chrono::duration<double>(bench_clock::now() - t_start).count();
+
+  std::sort(latency_ms.begin(), latency_ms.end());
+  fmt::print("{} attach procedures ({} failed) in {:.3f} s, {:.1f} procedures/s",
+             nof_success,
+             nof_failed,
+             t,
+             nof_success / t);
+  if (not latency_ms.empty()) {
+    fmt::print(", latency p50 {:.2f} ms, p99 {:.2f} ms, max {:.2f} ms",
+               latency_ms[latency_ms.size() / 2],
+               latency_ms[latency_ms.size() * 99 / 100],
+               latency_ms.back());
+  }
+  fmt::print("\n");
+  return (nof_failed == 0 and nof_success == nof_ue) ? SRSRAN_SUCCESS : SRSRAN_ERROR;
+}
+
+static void usage(const char* prog)
+{
+  fprintf(stderr,
+          "Usage:\n"
+          "  %s db <user_db.csv> <nof_ue>\n"
+          "  %s run <mme_addr> <nof_ue> <nof_concurrent_ue>\n",
+          prog,
+          prog);
+}
+
+int main(int argc, char** argv)
+{
+  if (argc < 4) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+  uint32_t nof_ue = std::strtoul(argv[3], nullptr, 10);
+
+  if (strcmp(argv[1], "db") == 0) {
+    return write_user_db(argv[2], nof_ue);
+  }
+  if (strcmp(argv[1], "run") != 0) {
+    usage(argv[0]);
+    return SRSRAN_ERROR;
+  }
+
+  srslog::init();
+  uint32_t       nof_concurrent = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 64;
+  load_generator gen(nof_ue, std::max(nof_concurrent, 1U));
+  if (not gen.connect_mme(argv[2]) or not gen.s1_setup()) {
+    return SRSRAN_ERROR;
+  }
+  return gen.run();
+}
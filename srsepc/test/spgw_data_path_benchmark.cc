@@ -0,0 +1,338 @@
+/**
+ * Copyright 2013-2023 Software Radio Systems Limited
+ *
+ * This file is part of srsRAN.
+ *
+ * srsRAN is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Affero General Public License as
+ * published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * srsRAN is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Affero General Public License for more details.
+ *
+ * A copy of the GNU Affero General Public License can be found in
+ * the LICENSE file in the top-level directory of this distribution
+ * and at http://www.gnu.org/licenses/.
+ *
+ */
+
+#include "srsepc/hdr/spgw/gtpu_data_path.h"
+#include "srsepc/hdr/spgw/spgw.h"
+#include "srsran/common/test_common.h"
+#include "srsran/upper/gtpu.h"
+#include <arpa/inet.h>
+#include <chrono>
+#include <linux/ip.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+
+/*
+ * Packet generator for the SP-GW user-plane thread. A datagram socketpair stands in for the SGi TUN interface and
+ * two loopback UDP sockets for the S-GW and eNB S1-U endpoints. The generator pushes IP packets for many UEs through
+ * SGi -> S1-U and GTP-U packets through S1-U -> SGi, and reports the forwarded packet rate of each direction.
+ */
+
+using bench_clock = std::chrono::steady_clock;
+
+static const char*    sgw_addr     = "127.0.0.2";
+static const char*    enb_addr     = "127.0.0.3";
+static const uint32_t ue_ip_base   = 0xac100002; // 172.16.0.2
+static const uint32_t ul_teid_base = 0x1000;
+static const uint32_t dw_teid_base = 0x80000;
+
+static int open_udp(const char* addr_str)
+{
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  int buf_size = 8 * 1024 * 1024;
+  setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buf_size, sizeof(buf_size));
+  setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buf_size, sizeof(buf_size));
+
+  struct sockaddr_in addr = {};
+  addr.sin_family         = AF_INET;
+  addr.sin_port           = htons(srsepc::GTPU_RX_PORT);
+  inet_pton(AF_INET, addr_str, &addr.sin_addr);
+  if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+    perror("bind");
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+static std::vector<srsepc::gtpu_tunnel_t> make_tunnels(uint32_t nof_ue)
+{
+  std::vector<srsepc::gtpu_tunnel_t> tunnels(nof_ue);
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    tunnels[i].ue_ipv4            = htonl(ue_ip_base + i);
+    tunnels[i].up_user_teid       = ul_teid_base + i;
+    tunnels[i].up_ctrl_teid       = i + 1;
+    tunnels[i].dw_user_active     = true;
+    tunnels[i].dw_user_fteid.teid = dw_teid_base + i;
+    inet_pton(AF_INET, enb_addr, &tunnels[i].dw_user_fteid.ipv4);
+  }
+  return tunnels;
+}
+
+static void fill_ip_packet(uint8_t* pkt, uint32_t pkt_size, uint32_t ue_idx)
+{
+  memset(pkt, 0, pkt_size);
+  struct iphdr* iph = (struct iphdr*)pkt;
+  iph->version      = 4;
+  iph->ihl          = 5;
+  iph->tot_len      = htons(pkt_size);
+  iph->ttl          = 64;
+  iph->protocol     = IPPROTO_UDP;
+  iph->saddr        = htonl(0x08080808);
+  iph->daddr        = htonl(ue_ip_base + ue_idx);
+}
+
+int test_tunnel_table()
+{
+  uint32_t                  nof_ue = 1000;
+  srsepc::gtpu_tunnel_table table(make_tunnels(nof_ue));
+  TESTASSERT(table.size() == nof_ue);
+  for (uint32_t i = 0; i < nof_ue; i++) {
+    const srsepc::gtpu_tunnel_t* by_ip   = table.find_by_ip(htonl(ue_ip_base + i));
+    const srsepc::gtpu_tunnel_t* by_teid = table.find_by_teid(ul_teid_base + i);
+    TESTASSERT(by_ip != nullptr and by_ip == by_teid);
+    TESTASSERT(by_ip->dw_user_fteid.teid == dw_teid_base + i);
+  }
+  TESTASSERT(table.find_by_ip(htonl(ue_ip_base + nof_ue)) == nullptr);
+  TESTASSERT(table.find_by_teid(ul_teid_base + nof_ue) == nullptr);
+  TESTASSERT(table.find_by_teid(0) == nullptr);
+
+  srsepc::gtpu_tunnel_table empty({});
+  TESTASSERT(empty.find_by_ip(htonl(ue_ip_base)) == nullptr);
+  return SRSRAN_SUCCESS;
+}
+
+struct bench_setup {
+  int sgi_fds[2] = {-1, -1}; // [0] is used by the data path, [1] by the generator
+  int s1u_fd     = -1;
+  int enb_fd     = -1;
+
+  bool init()
+  {
+    if (socketpair(AF_UNIX, SOCK_DGRAM, 0, sgi_fds) < 0) {
+      perror("socketpair");
+      return false;
+    }
+    int buf_size = 8 * 1024 * 1024;
+    for (int fd : sgi_fds) {
+      setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &buf_size, sizeof(buf_size));
+      setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &buf_size, sizeof(buf_size));
+    }
+    s1u_fd = open_udp(sgw_addr);
+    enb_fd = open_udp(enb_addr);
+    return s1u_fd >= 0 and enb_fd >= 0;
+  }
+  ~bench_setup()
+  {
+    for (int fd : {sgi_fds[0], sgi_fds[1], s1u_fd, enb_fd}) {
+      if (fd >= 0) {
+        close(fd);
+      }
+    }
+  }
+};
+
+/// Counts the datagrams received on fd until nof_pkts arrive or nothing arrives for 200 ms
+static uint32_t receive_all(int fd, uint32_t nof_pkts, uint32_t nof_ue, bool check_gtpu)
+{
+  const uint32_t  batch = 64;
+  static uint8_t  bufs[batch][2048];
+  struct iovec    iov[batch];
+  struct mmsghdr  msgs[batch] = {};
+  uint32_t        nof_rx      = 0;
+  for (uint32_t i = 0; i < batch; i++) {
+    iov[i].iov_base            = bufs[i];
+    iov[i].iov_len             = sizeof(bufs[i]);
+    msgs[i].msg_hdr.msg_iov    = &iov[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  while (nof_rx < nof_pkts) {
+    struct pollfd pfd = {};
+    pfd.fd            = fd;
+    pfd.events        = POLLIN;
+    if (poll(&pfd, 1, 200) <= 0) {
+      break;
+    }
+    int n = recvmmsg(fd, msgs, batch, MSG_DONTWAIT, nullptr);
+    for (int i = 0; i < n; i++) {
+      if (check_gtpu) {
+        // The TEID of the eNB matches the destination UE of the inner packet
+        uint32_t      teid = ntohl(*(uint32_t*)&bufs[i][4]);
+        struct iphdr* iph  = (struct iphdr*)&bufs[i][GTPU_BASE_HEADER_LEN];
+        TESTASSERT(bufs[i][1] == GTPU_MSG_DATA_PDU);
+        TESTASSERT(teid - dw_teid_base == ntohl(iph->daddr) - ue_ip_base and teid - dw_teid_base < nof_ue);
+      } else {
+        TESTASSERT(((struct iphdr*)bufs[i])->version == 4);
+      }
+    }
+    nof_rx += std::max(n, 0);
+  }
+  return nof_rx;
+}
+
+static void report(const char* name, uint32_t nof_tx, uint32_t nof_rx, double t, uint32_t pkt_size)
+{
+  fmt::print("{}: {}/{} packets of {} bytes in {:.3f} s, {:.3f} Mpps, {:.1f} Mbps\n",
+             name,
+             nof_rx,
+             nof_tx,
+             pkt_size,
+             t,
+             nof_rx / t / 1e6,
+             nof_rx * pkt_size * 8 / t / 1e6);
+}
+
+int bench_downlink(bench_setup& s, uint32_t nof_ue, uint32_t nof_pkts, uint32_t pkt_size)
+{
+  auto        t_start   = bench_clock::now();
+  std::thread generator = std::thread([&s, nof_ue, nof_pkts, pkt_size]() {
+    std::vector<uint8_t> pkt(pkt_size);
+    for (uint32_t i = 0; i < nof_pkts; i++) {
+      fill_ip_packet(pkt.data(), pkt_size, i % nof_ue);
+      if (write(s.sgi_fds[1], pkt.data(), pkt_size) < 0) {
+        perror("write");
+        return;
+      }
+    }
+  });
+  uint32_t nof_rx = receive_all(s.enb_fd, nof_pkts, nof_ue, true);
+  double   t      = std::chrono::duration<double>(bench_clock::now() - t_start).count();
+  generator.join();
+
+  report("SGi -> S1-U", nof_pkts, nof_rx, t, pkt_size);
+  TESTASSERT(nof_rx > 0);
+  return SRSRAN_SUCCESS;
+}
+
+int bench_uplink(bench_setup& s, uint32_t nof_ue, uint32_t nof_pkts, uint32_t pkt_size)
+{
+  struct sockaddr_in sgw = {};
+  sgw.sin_family         = AF_INET;
+  sgw.sin_port           = htons(srsepc::GTPU_RX_PORT);
+  inet_pton(AF_INET, sgw_addr, &sgw.sin_addr);
+
+  auto        t_start   = bench_clock::now();
+  std::thread generator = std::thread([&s, &sgw, nof_ue, nof_pkts, pkt_size]() {
+    const uint32_t       batch = 32;
+    std::vector<uint8_t> pkts(batch * (pkt_size + GTPU_BASE_HEADER_LEN));
+    struct iovec         iov[batch];
+    struct mmsghdr       msgs[batch] = {};
+    for (uint32_t i = 0; i < nof_pkts; i += batch) {
+      uint32_t nof_tx = std::min(batch, nof_pkts - i);
+      for (uint32_t j = 0; j < nof_tx; j++) {
+        uint8_t* pkt  = &pkts[j * (pkt_size + GTPU_BASE_HEADER_LEN)];
+        uint32_t ue   = (i + j) % nof_ue;
+        uint32_t teid = htonl(ul_teid_base + ue);
+        uint16_t len  = htons(pkt_size);
+        pkt[0]        = GTPU_FLAGS_VERSION_V1 | GTPU_FLAGS_GTP_PROTOCOL;
+        pkt[1]        = GTPU_MSG_DATA_PDU;
+        memcpy(&pkt[2], &len, sizeof(len));
+        memcpy(&pkt[4], &teid, sizeof(teid));
+        fill_ip_packet(&pkt[GTPU_BASE_HEADER_LEN], pkt_size, ue);
+        iov[j].iov_base             = pkt;
+        iov[j].iov_len              = pkt_size + GTPU_BASE_HEADER_LEN;
+        msgs[j].msg_hdr.msg_name    = &sgw;
+        msgs[j].msg_hdr.msg_namelen = sizeof(sgw);
+        msgs[j].msg_hdr.msg_iov     = &iov[j];
+        msgs[j].msg_hdr.msg_iovlen  = 1;
+      }
+      if (sendmmsg(s.enb_fd, msgs, nof_tx, 0) < 0) {
+        perror("sendmmsg");
+        return;
+      }
+    }
+  });
+  uint32_t nof_rx = receive_all(s.sgi_fds[1], nof_pkts, nof_ue, false);
+  double   t      = std::chrono::duration<double>(bench_clock::now() - t_start).count();
+  generator.join();
+
+  report("S1-U -> SGi", nof_pkts, nof_rx, t, pkt_size);
+  TESTASSERT(nof_rx > 0);
+  return SRSRAN_SUCCESS;
+}
+
+/// Packets for UEs that are not ECM connected are handed to the GTP-C thread, packets for unknown UEs are dropped
+int test_slow_path(bench_setup& s, srsepc::gtpu_data_path& data_path, uint32_t nof_ue)
+{
+  std::vector<srsepc::gtpu_tunnel_t> tunnels = make_tunnels(nof_ue);
+  tunnels[0].dw_user_active                  = false;
+  data_path.publish_tunnels(std::make_shared<const srsepc::gtpu_tunnel_table>(std::move(tunnels)));
+
+  uint64_t dropped = data_path.get_metrics().dropped_pkts;
+  uint8_t  pkt[100];
+  fill_ip_packet(pkt, sizeof(pkt), nof_ue);
+  TESTASSERT(write(s.sgi_fds[1], pkt, sizeof(pkt)) == sizeof(pkt));
+  fill_ip_packet(pkt, sizeof(pkt), 0);
+  TESTASSERT(write(s.sgi_fds[1], pkt, sizeof(pkt)) == sizeof(pkt));
+
+  struct pollfd pfd = {};
+  pfd.fd            = data_path.get_slow_path_fd();
+  pfd.events        = POLLIN;
+  TESTASSERT(poll(&pfd, 1, 1000) == 1);
+
+  std::vector<srsran::unique_byte_buffer_t> pdus;
+  data_path.get_slow_path_pdus(pdus);
+  TESTASSERT(pdus.size() == 1 and pdus[0]->N_bytes == sizeof(pkt));
+  TESTASSERT(((struct iphdr*)pdus[0]->msg)->daddr == htonl(ue_ip_base));
+  // The counters are updated at the end of the batch, after the slow path is signalled
+  for (uint32_t i = 0; i < 1000 and data_path.get_metrics().dropped_pkts == dropped; i++) {
+    usleep(1000);
+  }
+  TESTASSERT(data_path.get_metrics().dropped_pkts == dropped + 1);
+  return SRSRAN_SUCCESS;
+}
+
+int main(int argc, char** argv)
+{
+  srslog::init();
+  srslog::fetch_basic_logger("GTPU", false).set_level(srslog::basic_levels::error);
+
+  uint32_t nof_pkts = 1000000;
+  uint32_t nof_ue   = 1000;
+  uint32_t pkt_size = 64;
+  if (argc > 1) {
+    nof_pkts = std::strtoul(argv[1], nullptr, 10);
+  }
+  if (argc > 2) {
+    nof_ue = std::strtoul(argv[2], nullptr, 10);
+  }
+  if (argc > 3) {
+    pkt_size = std::max(std::strtoul(argv[3], nullptr, 10), 28UL);
+  }
+
+  TESTASSERT(test_tunnel_table() == SRSRAN_SUCCESS);
+
+  bench_setup s;
+  if (not s.init()) {
+    return SRSRAN_ERROR;
+  }
+  srsepc::gtpu_data_path data_path;
+  TESTASSERT(data_path.init(s.sgi_fds[0], s.s1u_fd) == SRSRAN_SUCCESS);
+  data_path.publish_tunnels(std::make_shared<const srsepc::gtpu_tunnel_table>(make_tunnels(nof_ue)));
+
+  TESTASSERT(bench_downlink(s, nof_ue, nof_pkts, pkt_size) == SRSRAN_SUCCESS);
+  TESTASSERT(bench_uplink(s, nof_ue, nof_pkts, pkt_size) == SRSRAN_SUCCESS);
+  TESTASSERT(test_slow_path(s, data_path, nof_ue) == SRSRAN_SUCCESS);
+
+  srsepc::gtpu_data_path::metrics_t m = data_path.get_metrics();
+  fmt::print("data path: DL {} packets, UL {} packets, dropped {}, slow path {}\n",
+             m.dl_pkts,
+             m.ul_pkts,
+             m.dropped_pkts,
+             m.slow_path_pkts);
+  data_path.stop();
+  return SRSRAN_SUCCESS;
+}
@@ -180,6 +180,7 @@ void ue_nr::metrics_read(mac_ue_metrics_t* metrics_)
   dl_cqi_valid_counter = 0;
   pucch_sinr_counter   = 0;
   pusch_sinr_counter   = 0;
+  fec_iters_counter    = 0;
   ue_metrics           = {};
 }
 
@@ -263,6 +264,16 @@ void ue_nr::metrics_pusch_sinr(float sinr)
   }
 }
 
+void ue_nr::metrics_ul_fec_iters(float fec_iters)
+{
+  std::lock_guard<std::mutex> lock(metrics_mutex);
+  // discard transport blocks without decoded code blocks
+  if (!std::isnan(fec_iters)) {
+    ue_metrics.fec_iters = SRSRAN_VEC_SAFE_CMA(fec_iters, ue_metrics.fec_iters, fec_iters_counter);
+    fec_iters_counter++;
+  }
+}
+
 // Called from Stack thread when demuxing UL PDUs
 void ue_nr::store_msg3(srsran::unique_byte_buffer_t pdu)
 {
@@ -33,7 +33,8 @@ class cell_search
 public:
   struct args_t {
     double                      max_srate_hz;
-    srsran_subcarrier_spacing_t ssb_min_scs = srsran_subcarrier_spacing_15kHz;
+    srsran_subcarrier_spacing_t ssb_min_scs     = srsran_subcarrier_spacing_15kHz;
+    uint32_t                    polar_list_size = 0; ///< PBCH polar list decoder size, 0 for the SSC decoder
   };
 
   struct cfg_t {
@@ -54,11 +54,13 @@ public:
     float                       pbch_dmrs_thr   = 0.0f; ///< PBCH DMRS correlation detection threshold (0 means auto)
     float                       cfo_alpha       = 0.0f; ///< CFO averaging alpha (0 means auto)
     int                         thread_priority = 1;
+    uint32_t                    polar_list_size = 0; ///< PBCH polar list decoder size, 0 for the SSC decoder
 
     cell_search::args_t get_cell_search() const
     {
       cell_search::args_t ret = {};
       ret.max_srate_hz        = srate_hz;
+      ret.polar_list_size     = polar_list_size;
       return ret;
     }
 
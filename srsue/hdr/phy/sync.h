@@ -22,6 +22,7 @@
 #ifndef SRSUE_PHCH_RECV_H
 #define SRSUE_PHCH_RECV_H
 
+#include <chrono>
 #include <condition_variable>
 #include <map>
 #include <mutex>
@@ -146,6 +147,16 @@ private:
    */
   void run_cell_search_state();
 
+  /**
+   * Accounts the time taken by the cell search of the current EARFCN in the scan time of its band
+   */
+  void cell_search_add_scan_time(std::chrono::steady_clock::duration scan_time);
+
+  /**
+   * Logs the scan time of the band searched last and resets it
+   */
+  void cell_search_report_band_scan_time();
+
   /**
    * SFN synchronization using MIB. run_subframe() receives and processes 1 subframe
    * and returns
@@ -367,6 +378,11 @@ private:
   int      current_earfcn          = 0;
   uint32_t cellsearch_earfcn_index = 0;
 
+  // Cell search scan time of the current band
+  uint32_t                            cellsearch_band            = 0;
+  uint32_t                            cellsearch_band_nof_earfcn = 0;
+  std::chrono::steady_clock::duration cellsearch_band_scan_time  = {};
+
   float dl_freq = -1;
   float ul_freq = -1;
 
@@ -220,6 +220,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("channel.dl.awgn.signal_power", bpo::value<float>(&args->phy.dl_channel_args.awgn_signal_power_dBfs)->default_value(0.0f), "Received signal power in decibels full scale (dBfs)")
     ("channel.dl.fading.enable",     bpo::value<bool>(&args->phy.dl_channel_args.fading_enable)->default_value(false),          "Enable/Disable Fading model")
     ("channel.dl.fading.model",      bpo::value<std::string>(&args->phy.dl_channel_args.fading_model)->default_value("none"),   "Fading model + maximum doppler (E.g. none, epa5, eva70, etu300, etc)")
+    ("channel.dl.fading.per_symbol", bpo::value<bool>(&args->phy.dl_channel_args.fading_per_symbol)->default_value(false),      "Hold the fading response for an OFDM symbol instead of updating it every filter segment (N/2 samples)")
+    ("channel.dl.fading.threaded",   bpo::value<bool>(&args->phy.dl_channel_args.fading_multithread)->default_value(false),     "Filter every antenna path in its own thread")
     ("channel.dl.delay.enable",      bpo::value<bool>(&args->phy.dl_channel_args.delay_enable)->default_value(false),           "Enable/Disable Delay simulator")
     ("channel.dl.delay.period_s",    bpo::value<float>(&args->phy.dl_channel_args.delay_period_s)->default_value(3600),         "Delay period in seconds (integer)")
     ("channel.dl.delay.init_time_s", bpo::value<float>(&args->phy.dl_channel_args.delay_init_time_s)->default_value(0),         "Initial time in seconds")
@@ -240,6 +242,8 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
     ("channel.ul.awgn.signal_power", bpo::value<float>(&args->phy.ul_channel_args.awgn_signal_power_dBfs)->default_value(30.0f), "Transmitted signal power in decibels full scale (dBfs)")
     ("channel.ul.fading.enable",     bpo::value<bool>(&args->phy.ul_channel_args.fading_enable)->default_value(false),           "Enable/Disable Fading model")
     ("channel.ul.fading.model",      bpo::value<std::string>(&args->phy.ul_channel_args.fading_model)->default_value("none"),    "Fading model + maximum doppler (E.g. none, epa5, eva70, etu300, etc)")
+    ("channel.ul.fading.per_symbol", bpo::value<bool>(&args->phy.ul_channel_args.fading_per_symbol)->default_value(false),       "Hold the fading response for an OFDM symbol instead of updating it every filter segment (N/2 samples)")
+    ("channel.ul.fading.threaded",   bpo::value<bool>(&args->phy.ul_channel_args.fading_multithread)->default_value(false),      "Filter every antenna path in its own thread")
     ("channel.ul.delay.enable",      bpo::value<bool>(&args->phy.ul_channel_args.delay_enable)->default_value(false),            "Enable/Disable Delay simulator")
     ("channel.ul.delay.period_s",    bpo::value<float>(&args->phy.ul_channel_args.delay_period_s)->default_value(3600),          "Delay period in seconds (integer)")
     ("channel.ul.delay.init_time_s", bpo::value<float>(&args->phy.ul_channel_args.delay_init_time_s)->default_value(0),          "Initial time in seconds")
@@ -413,6 +417,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
       bpo::value<bool>(&args->phy.detect_cp)->default_value(false),
       "enable CP length detection")
 
+    ("phy.cell_search_parallel",
+      bpo::value<bool>(&args->phy.cell_search_parallel)->default_value(false),
+      "Search the 3 PSS in parallel threads on the same samples during cell search")
+
     ("phy.in_sync_rsrp_dbm_th",
      bpo::value<float>(&args->phy.in_sync_rsrp_dbm_th)->default_value(-130.0f),
      "RSRP threshold (in dBm) above which the UE considers to be in-sync")
@@ -446,6 +454,10 @@ static int parse_args(all_args_t* args, int argc, char* argv[])
       bpo::value<bool>(&args->phy.nr_store_pdsch_ko)->default_value(false),
       "Dumps the PDSCH baseband samples into a file on KO reception.")
 
+    ("phy.nr.polar_list_size",
+      bpo::value<uint32_t>(&args->phy.nr_polar_list_size)->default_value(0),
+      "Polar list decoder size for PDCCH and PBCH (2, 4 or 8), 0 for the SSC decoder.")
+
     // UE simulation args
     ("sim.airplane_t_on_ms",
      bpo::value<int>(&args->stack.nas.sim.airplane_t_on_ms)->default_value(-1),
@@ -186,6 +186,11 @@ void metrics_stdout::set_metrics(const ue_metrics_t& metrics, const uint32_t per
     fmt::print("RF status: O={}, U={}, L={}\n", metrics.rf.rf_o, metrics.rf.rf_u, metrics.rf.rf_l);
   }
 
+  // Only unpaced virtual radios run faster than real time
+  if (metrics.rf.rf_speedup > 1.1f) {
+    fmt::print("RF speed-up: {:.1f}x\n", metrics.rf.rf_speedup);
+  }
+
   if (!do_print) {
     return;
   }
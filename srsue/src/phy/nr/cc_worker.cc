@@ -55,6 +55,7 @@ cc_worker::cc_worker(uint32_t cc_idx_, srslog::basic_logger& log, state& phy_sta
   ssb_args.enable_measure    = true;
   ssb_args.enable_decode     = true;
   ssb_args.enable_search     = true;
+  ssb_args.polar_list_size   = phy.args.polar_list_size;
   if (srsran_ssb_init(&ssb, &ssb_args) < SRSRAN_SUCCESS) {
     ERROR("Error initiating SSB");
     return;
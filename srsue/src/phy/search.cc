@@ -82,6 +82,24 @@ void search::set_cp_en(bool enable)
   srsran_set_detect_cp(&cs, enable);
 }
 
+void search::set_parallel(bool enable)
+{
+  if (not enable) {
+    srsran_ue_cellsearch_disable_parallel(&cs);
+    return;
+  }
+
+  if (srsran_ue_cellsearch_enable_parallel(&cs)) {
+    Error("SYNC:  Enabling parallel cell search");
+    return;
+  }
+
+  // Set options defined in expert section in the synchronization object of every PSS
+  for (uint32_t N_id_2 = 0; N_id_2 < SRSRAN_NOF_NID_2; N_id_2++) {
+    p->set_ue_sync_opts(srsran_ue_cellsearch_get_parallel_ue_sync(&cs, N_id_2), 0);
+  }
+}
+
 void search::reset()
 {
   srsran_ue_sync_reset(&ue_mib_sync.ue_sync);
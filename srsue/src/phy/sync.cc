@@ -93,6 +93,7 @@ void sync::init(srsran::radio_interface_phy* _radio,
   // Initialize cell searcher
   search_p.init(sf_buffer, nof_rf_channels, this, worker_com->args->force_N_id_2, worker_com->args->force_N_id_1);
   search_p.set_cp_en(worker_com->args->detect_cp);
+  search_p.set_parallel(worker_com->args->cell_search_parallel);
   // Initialize SFN synchronizer, it uses only pcell buffer
   sfn_p.init(&ue_sync, worker_com->args, sf_buffer, sf_buffer.size());
 
@@ -258,12 +259,15 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
     current_earfcn = earfcn;
   }
   Info("Cell Search: changing frequency to EARFCN=%d", current_earfcn);
+  auto search_start = std::chrono::steady_clock::now();
   set_frequency();
 
   // Move to CELL SEARCH and wait to finish
   Info("Cell Search: Setting Cell search state");
   phy_state.run_cell_search();
 
+  cell_search_add_scan_time(std::chrono::steady_clock::now() - search_start);
+
   // Check return state
   switch (cell_search_ret) {
     case search::CELL_FOUND:
@@ -290,6 +294,7 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
     Info("Cell Search: No more frequencies in the current EARFCN set");
     cellsearch_earfcn_index = 0;
     ret.last_freq           = rrc_interface_phy_lte::cell_search_ret_t::NO_MORE_FREQS;
+    cell_search_report_band_scan_time();
   } else {
     ret.last_freq = rrc_interface_phy_lte::cell_search_ret_t::MORE_FREQS;
   }
@@ -299,6 +304,38 @@ rrc_interface_phy_lte::cell_search_ret_t sync::cell_search_start(phy_cell_t* fou
   return ret;
 }
 
+void sync::cell_search_add_scan_time(std::chrono::steady_clock::duration scan_time)
+{
+  uint32_t band = srsran_band_get_band(current_earfcn);
+  if (band != cellsearch_band) {
+    cell_search_report_band_scan_time();
+    cellsearch_band = band;
+  }
+  cellsearch_band_nof_earfcn++;
+  cellsearch_band_scan_time += scan_time;
+
+  Info("Cell Search: EARFCN=%d scanned in %.1f ms",
+       current_earfcn,
+       std::chrono::duration<double, std::milli>(scan_time).count());
+}
+
+void sync::cell_search_report_band_scan_time()
+{
+  if (cellsearch_band_nof_earfcn == 0) {
+    return;
+  }
+
+  double scan_time_ms = std::chrono::duration<double, std::milli>(cellsearch_band_scan_time).count();
+  Info("Cell Search: Scanned %d EARFCNs of band %d in %.1f ms (%.1f ms per EARFCN)",
+       cellsearch_band_nof_earfcn,
+       cellsearch_band,
+       scan_time_ms,
+       scan_time_ms / cellsearch_band_nof_earfcn);
+
+  cellsearch_band_nof_earfcn = 0;
+  cellsearch_band_scan_time  = {};
+}
+
 /* Cell select synchronizes to a new cell (e.g. during HO or during cell reselection on IDLE) or
  * re-synchronizes with the current cell if cell argument is NULL
  * The first phase of the procedure verifies the validity of the input parameters and switches the